@@ -3,15 +3,25 @@
 /// @file userver/cache/expirable_lru_cache.hpp
 /// @brief @copybrief cache::ExpirableLruCache
 
+#include <cmath>
+#include <exception>
 #include <optional>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
-#include <userver/concurrent/mutex_set.hpp>
+#include <userver/cache/sharded_clock_cache.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/utils/scope_guard.hpp>
 
 // TODO remove
 #include <userver/logging/log.hpp>
@@ -20,10 +30,61 @@ USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
+namespace impl {
+
+// cache::NWayLRU or cache::ShardedClockCache, chosen at runtime
+template <typename Key, typename Value, typename Hash, typename Equal>
+class LruStorage final {
+ public:
+  LruStorage(EvictionPolicy eviction_policy, size_t ways, size_t way_size,
+             const Hash& hash, const Equal& equal)
+      : impl_(eviction_policy == EvictionPolicy::kTinyLfu
+                  ? Impl{std::in_place_index<1>, ways, way_size, hash, equal}
+                  : Impl{std::in_place_index<0>, ways, way_size, hash,
+                         equal}) {}
+
+  void Put(const Key& key, Value value) {
+    std::visit([&](auto& lru) { lru.Put(key, std::move(value)); }, impl_);
+  }
+
+  std::optional<Value> Get(const Key& key) {
+    return std::visit([&](auto& lru) { return lru.Get(key); }, impl_);
+  }
+
+  void Invalidate() {
+    std::visit([](auto& lru) { lru.Invalidate(); }, impl_);
+  }
+
+  void InvalidateByKey(const Key& key) {
+    std::visit([&](auto& lru) { lru.InvalidateByKey(key); }, impl_);
+  }
+
+  size_t GetSize() const {
+    return std::visit([](const auto& lru) { return lru.GetSize(); }, impl_);
+  }
+
+  void UpdateWaySize(size_t way_size) {
+    std::visit([&](auto& lru) { lru.UpdateWaySize(way_size); }, impl_);
+  }
+
+ private:
+  using Impl = std::variant<NWayLRU<Key, Value, Hash, Equal>,
+                            ShardedClockCache<Key, Value, Hash, Equal>>;
+
+  Impl impl_;
+};
+
+}  // namespace impl
+
 /// @ingroup userver_containers
 /// @brief Class for expirable LRU cache. Use cache::LruMap for not expirable
 /// LRU Cache.
 ///
+/// Concurrent misses of the same key are coalesced: only one of them calls
+/// the update function, the others wait for its result. A background update
+/// of the key is joined by the misses in the same way. If the updating task is
+/// cancelled, the waiters retry and one of them becomes the updating one.
+///
 /// Example usage:
 ///
 /// @snippet cache/expirable_lru_cache_test.cpp Sample ExpirableLruCache
@@ -42,6 +103,12 @@ class ExpirableLruCache final {
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
                     const Equal& equal = Equal());
 
+  /// @param eviction_policy selects the underlying cache engine, see
+  /// cache::EvictionPolicy
+  ExpirableLruCache(size_t ways, size_t way_size,
+                    EvictionPolicy eviction_policy, const Hash& hash = Hash(),
+                    const Equal& equal = Equal());
+
   ~ExpirableLruCache();
 
   void SetWaySize(size_t way_size);
@@ -57,6 +124,23 @@ class ExpirableLruCache final {
    */
   void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
+  /// Sets how long after the expiration a value is still returned by Get()
+  /// and GetOptional(). Such a value is updated in background. 0 (the
+  /// default) disables serving of the expired values.
+  void SetStaleWhileRevalidate(std::chrono::milliseconds period);
+
+  /// Enables probabilistic early update of the values in background
+  /// ("XFetch"). A hit updates the value with a probability that grows as
+  /// the expiration approaches, faster for the values that took longer to
+  /// get from the update function. Bigger `beta` makes the updates
+  /// earlier, 0 (the default) disables them.
+  ///
+  /// Unlike BackgroundUpdateMode::kEnabled that updates every hot key after a
+  /// half of its lifetime, the early updates of the different keys are spread
+  /// in time and happen only for the keys that are requested near their
+  /// expiration.
+  void SetEarlyRefreshBeta(double beta);
+
   /**
    * @returns GetOptional("key", update_func) if it is not std::nullopt.
    * Otherwise the result of update_func(key) is returned, and additionally
@@ -108,36 +192,78 @@ class ExpirableLruCache final {
   /// Erase key from cache
   void InvalidateByKey(const Key& key);
 
-  /// Add async task for updating value by update_func(key)
+  /// Add async task for updating value by update_func(key), unless the key
+  /// is being updated already
   void UpdateInBackground(const Key& key, UpdateValueFunc update_func);
 
  private:
+  struct MapValue {
+    Value value;
+    std::chrono::steady_clock::time_point update_time;
+    // how long the update function took, used for the early updates
+    std::chrono::steady_clock::duration update_duration{};
+  };
+
+  // Promises of the misses waiting for an update of the key, std::nullopt
+  // makes a waiter retry
+  using Waiters = std::vector<engine::Promise<std::optional<Value>>>;
+
   bool IsExpired(std::chrono::steady_clock::time_point update_time,
                  std::chrono::steady_clock::time_point now) const;
 
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
-  struct MapValue {
-    Value value;
-    std::chrono::steady_clock::time_point update_time;
-  };
+  bool ShouldUpdateEarly(const MapValue& value,
+                         std::chrono::steady_clock::time_point now) const;
+
+  bool IsStaleUsable(std::chrono::steady_clock::time_point update_time,
+                     std::chrono::steady_clock::time_point now) const;
+
+  // Calls update_func(key) unless the key is being updated already, in which
+  // case waits for the result of the concurrent update
+  Value UpdateOrWait(const Key& key, const UpdateValueFunc& update_func,
+                     ReadMode read_mode);
 
-  cache::NWayLRU<Key, MapValue, Hash, Equal> lru_;
+  // Returns false if the key is being updated already
+  bool TryUpdateInBackground(const Key& key, UpdateValueFunc update_func);
+
+  MapValue Update(const Key& key, const UpdateValueFunc& update_func);
+
+  // Ends the update of the key, the waiters get `value` or `exception`
+  void NotifyWaiters(const Key& key, const Value& value);
+  void NotifyWaiters(const Key& key, std::exception_ptr exception);
+
+  // Ends the update of the key without a result, the waiters retry
+  void RetryWaiters(const Key& key);
+
+  Waiters ExtractWaiters(const Key& key);
+
+  impl::LruStorage<Key, MapValue, Hash, Equal> lru_;
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
   std::atomic<BackgroundUpdateMode> background_update_mode_{
       BackgroundUpdateMode::kDisabled};
+  std::atomic<std::chrono::milliseconds> stale_while_revalidate_{
+      std::chrono::milliseconds(0)};
+  std::atomic<double> early_refresh_beta_{0};
   impl::ExpirableLruCacheStatistics stats_;
-  concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
+  concurrent::Variable<std::unordered_map<Key, Waiters, Hash, Equal>>
+      updates_in_progress_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
     size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
-      mutex_set_{ways, way_size, hash, equal} {}
+    : ExpirableLruCache(ways, way_size, EvictionPolicy::kLru, hash, equal) {}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
+    size_t ways, size_t way_size, EvictionPolicy eviction_policy,
+    const Hash& hash, const Equal& equal)
+    : lru_(eviction_policy, ways, way_size, hash, equal),
+      updates_in_progress_(0, hash, equal) {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
@@ -167,29 +293,27 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(
   background_update_mode_ = background_update;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetStaleWhileRevalidate(
+    std::chrono::milliseconds period) {
+  stale_while_revalidate_ = period;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetEarlyRefreshBeta(
+    double beta) {
+  early_refresh_beta_ = beta;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
-  auto now = utils::datetime::SteadyNow();
   auto opt_old_value = GetOptional(key, update_func);
   if (opt_old_value) {
     return std::move(*opt_old_value);
   }
 
-  auto mutex = mutex_set_.GetMutexForKey(key);
-  std::lock_guard lock(mutex);
-  // Test one more time - concurrent ExpirableLruCache::Get()
-  // might have put the value
-  auto old_value = lru_.Get(key);
-  if (old_value && !IsExpired(old_value->update_time, now)) {
-    return std::move(old_value->value);
-  }
-
-  auto value = update_func(key);
-  if (read_mode == ReadMode::kUseCache) {
-    lru_.Put(key, {value, now});
-  }
-  return value;
+  return UpdateOrWait(key, update_func, read_mode);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -204,11 +328,20 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
 
       if (ShouldUpdate(old_value->update_time, now)) {
         UpdateInBackground(key, update_func);
+      } else if (ShouldUpdateEarly(*old_value, now) &&
+                 TryUpdateInBackground(key, update_func)) {
+        impl::CacheEarlyUpdate(stats_);
       }
 
       return std::move(old_value->value);
     } else {
       impl::CacheStale(stats_);
+
+      if (IsStaleUsable(old_value->update_time, now)) {
+        impl::CacheStaleHit(stats_);
+        UpdateInBackground(key, update_func);
+        return std::move(old_value->value);
+      }
     }
   }
   impl::CacheMiss(stats_);
@@ -310,23 +443,139 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::InvalidateByKey(
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(
     const Key& key, UpdateValueFunc update_func) {
-  stats_.total.background_updates++;
-  stats_.recent.GetCurrentCounter().background_updates++;
+  TryUpdateInBackground(key, std::move(update_func));
+}
 
-  // cache will wait for all detached tasks in ~ExpirableLruCache()
-  engine::AsyncNoSpan([token = wait_token_storage_.GetToken(), this, key,
-                       update_func = std::move(update_func)] {
-    auto mutex = mutex_set_.GetMutexForKey(key);
-    std::unique_lock lock(mutex, std::try_to_lock);
-    if (!lock) {
+template <typename Key, typename Value, typename Hash, typename Equal>
+Value ExpirableLruCache<Key, Value, Hash, Equal>::UpdateOrWait(
+    const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
+  while (true) {
+    std::optional<engine::Future<std::optional<Value>>> concurrent_update;
+    {
+      auto updates = updates_in_progress_.UniqueLock();
+      auto [it, inserted] = updates->try_emplace(key);
+      if (!inserted) {
+        concurrent_update.emplace(it->second.emplace_back().get_future());
+      }
+    }
+    if (!concurrent_update) break;
+
+    impl::CacheCoalescedMiss(stats_);
+    auto value = concurrent_update->get();
+    if (value) return std::move(*value);
+    // the updating task was cancelled, try to become the updating one
+  }
+
+  // a cancellation of this task is not an error of the update, the waiters
+  // retry it
+  utils::ScopeGuard waiters_guard([this, &key] { RetryWaiters(key); });
+
+  std::optional<Value> value;
+  try {
+    // Test one more time - a concurrent update might have put the value
+    // before this task became the updating one
+    auto old_value = lru_.Get(key);
+    if (old_value &&
+        !IsExpired(old_value->update_time, utils::datetime::SteadyNow())) {
+      value.emplace(std::move(old_value->value));
+    } else {
+      auto new_value = Update(key, update_func);
+      if (read_mode == ReadMode::kUseCache) lru_.Put(key, new_value);
+      value.emplace(std::move(new_value.value));
+    }
+  } catch (const std::exception&) {
+    if (!engine::current_task::ShouldCancel()) {
+      waiters_guard.Release();
+      NotifyWaiters(key, std::current_exception());
+    }
+    throw;
+  }
+
+  waiters_guard.Release();
+  NotifyWaiters(key, *value);
+  return std::move(*value);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::TryUpdateInBackground(
+    const Key& key, UpdateValueFunc update_func) {
+  {
+    auto updates = updates_in_progress_.UniqueLock();
+    if (!updates->try_emplace(key).second) {
       // someone is updating the key right now
-      return;
+      return false;
     }
+  }
+
+  stats_.total.background_updates++;
+  stats_.recent.GetCurrentCounter().background_updates++;
 
-    auto now = utils::datetime::SteadyNow();
-    auto value = update_func(key);
-    lru_.Put(key, {value, now});
-  }).Detach();
+  try {
+    // cache will wait for all detached tasks in ~ExpirableLruCache()
+    engine::AsyncNoSpan([token = wait_token_storage_.GetToken(), this, key,
+                         update_func = std::move(update_func)] {
+      utils::ScopeGuard waiters_guard([this, &key] { RetryWaiters(key); });
+
+      std::optional<MapValue> value;
+      try {
+        value.emplace(Update(key, update_func));
+        lru_.Put(key, *value);
+      } catch (const std::exception& ex) {
+        LOG_WARNING() << "Background update of the cache failed: " << ex;
+        if (!engine::current_task::ShouldCancel()) {
+          waiters_guard.Release();
+          NotifyWaiters(key, std::current_exception());
+        }
+        return;
+      }
+
+      waiters_guard.Release();
+      NotifyWaiters(key, value->value);
+    }).Detach();
+  } catch (const std::exception&) {
+    // the update has not started, the waiters do it themselves
+    RetryWaiters(key);
+    throw;
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename ExpirableLruCache<Key, Value, Hash, Equal>::MapValue
+ExpirableLruCache<Key, Value, Hash, Equal>::Update(
+    const Key& key, const UpdateValueFunc& update_func) {
+  const auto start = utils::datetime::SteadyNow();
+  auto value = update_func(key);
+  return {std::move(value), start, utils::datetime::SteadyNow() - start};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::NotifyWaiters(
+    const Key& key, const Value& value) {
+  for (auto& waiter : ExtractWaiters(key)) waiter.set_value(value);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::NotifyWaiters(
+    const Key& key, std::exception_ptr exception) {
+  for (auto& waiter : ExtractWaiters(key)) waiter.set_exception(exception);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::RetryWaiters(const Key& key) {
+  for (auto& waiter : ExtractWaiters(key)) waiter.set_value(std::nullopt);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename ExpirableLruCache<Key, Value, Hash, Equal>::Waiters
+ExpirableLruCache<Key, Value, Hash, Equal>::ExtractWaiters(const Key& key) {
+  auto updates = updates_in_progress_.UniqueLock();
+  const auto it = updates->find(key);
+  UASSERT(it != updates->end());
+
+  auto waiters = std::move(it->second);
+  updates->erase(it);
+  return waiters;
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -346,6 +595,42 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
          max_lifetime.count() != 0 && update_time + max_lifetime / 2 < now;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdateEarly(
+    const MapValue& value, std::chrono::steady_clock::time_point now) const {
+  // The probability of an update is exp(-time_left / (beta * duration)),
+  // see "Optimal Probabilistic Cache Stampede Prevention" by Vattani et al.
+  // Beyond kMaxExponent the probability is negligible and the random number
+  // is not generated.
+  constexpr double kMaxExponent = 30;
+
+  const auto max_lifetime = max_lifetime_.load();
+  const auto beta = early_refresh_beta_.load();
+  if (max_lifetime.count() == 0 || beta <= 0 ||
+      value.update_duration.count() <= 0) {
+    return false;
+  }
+
+  const std::chrono::duration<double> time_left =
+      value.update_time + max_lifetime - now;
+  const auto exponent =
+      time_left / (beta * std::chrono::duration<double>(value.update_duration));
+  if (exponent > kMaxExponent) return false;
+
+  // 1 - [0, 1) is (0, 1], the logarithm is finite
+  return -std::log(1.0 - utils::RandRange(1.0)) >= exponent;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::IsStaleUsable(
+    std::chrono::steady_clock::time_point update_time,
+    std::chrono::steady_clock::time_point now) const {
+  const auto max_lifetime = max_lifetime_.load();
+  const auto stale_while_revalidate = stale_while_revalidate_.load();
+  return max_lifetime.count() != 0 && stale_while_revalidate.count() != 0 &&
+         update_time + max_lifetime + stale_while_revalidate >= now;
+}
+
 template <typename Key, typename Value, typename Hash = std::hash<Key>,
           typename Equal = std::equal_to<Key>>
 class LruCacheWrapper final {
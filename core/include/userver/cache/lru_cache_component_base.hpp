@@ -62,7 +62,11 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// background-update | update the entries in background after a half of their lifetime | false
+/// stale-while-revalidate | how long after the expiration a value is still served while being updated in background | 0
+/// early-refresh-beta | probabilistic early update of the values before their expiration, see cache::ExpirableLruCache::SetEarlyRefreshBeta | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
+/// eviction-policy | `lru` for cache::NWayLRU or `tinylfu` for cache::ShardedClockCache with lock-free reads, see cache::EvictionPolicy | lru
 ///
 /// ## Example usage:
 ///
@@ -123,9 +127,12 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+                                     static_config_.GetWaySize(),
+                                     static_config_.eviction_policy)) {
   cache_->SetMaxLifetime(static_config_.config.lifetime);
   cache_->SetBackgroundUpdate(static_config_.config.background_update);
+  cache_->SetStaleWhileRevalidate(static_config_.config.stale_while_revalidate);
+  cache_->SetEarlyRefreshBeta(static_config_.config.early_refresh_beta);
 
   if (static_config_.use_dynamic_config) {
     LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -192,6 +199,8 @@ void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(
   cache_->SetWaySize(config.GetWaySize(static_config_.ways));
   cache_->SetMaxLifetime(config.lifetime);
   cache_->SetBackgroundUpdate(config.background_update);
+  cache_->SetStaleWhileRevalidate(config.stale_while_revalidate);
+  cache_->SetEarlyRefreshBeta(config.early_refresh_beta);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -19,6 +19,18 @@ enum class BackgroundUpdateMode {
   kDisabled,
 };
 
+/// Cache engine of cache::ExpirableLruCache
+enum class EvictionPolicy {
+  /// cache::NWayLRU, the exact LRU order within each way
+  kLru,
+  /// cache::ShardedClockCache, lock-free reads, CLOCK eviction and TinyLFU
+  /// admission
+  kTinyLfu,
+};
+
+EvictionPolicy Parse(const yaml_config::YamlConfig& config,
+                     formats::parse::To<EvictionPolicy>);
+
 struct LruCacheConfig final {
   explicit LruCacheConfig(const yaml_config::YamlConfig& config);
   explicit LruCacheConfig(const components::ComponentConfig& config);
@@ -30,6 +42,8 @@ struct LruCacheConfig final {
   std::size_t size;
   std::chrono::milliseconds lifetime;
   BackgroundUpdateMode background_update;
+  std::chrono::milliseconds stale_while_revalidate;
+  double early_refresh_beta;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value,
@@ -44,6 +58,7 @@ struct LruCacheConfigStatic final {
   LruCacheConfig config;
   std::size_t ways;
   bool use_dynamic_config;
+  EvictionPolicy eviction_policy;
 };
 
 std::unordered_map<std::string, LruCacheConfig> ParseLruCacheConfigSet(
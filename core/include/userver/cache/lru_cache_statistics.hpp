@@ -15,6 +15,12 @@ struct ExpirableLruCacheStatisticsBase final {
   std::atomic<std::size_t> misses{0};
   std::atomic<std::size_t> stale{0};
   std::atomic<std::size_t> background_updates{0};
+  // misses that waited for a concurrent update of the same key
+  std::atomic<std::size_t> coalesced_misses{0};
+  // expired values served while being updated in background
+  std::atomic<std::size_t> stale_hits{0};
+  // probabilistic updates of the values before their expiration
+  std::atomic<std::size_t> early_updates{0};
 
   ExpirableLruCacheStatisticsBase();
 
@@ -39,6 +45,12 @@ void CacheMiss(ExpirableLruCacheStatistics& stats);
 
 void CacheStale(ExpirableLruCacheStatistics& stats);
 
+void CacheCoalescedMiss(ExpirableLruCacheStatistics& stats);
+
+void CacheStaleHit(ExpirableLruCacheStatistics& stats);
+
+void CacheEarlyUpdate(ExpirableLruCacheStatistics& stats);
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
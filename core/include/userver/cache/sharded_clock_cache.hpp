@@ -0,0 +1,361 @@
+#pragma once
+
+/// @file userver/cache/sharded_clock_cache.hpp
+/// @brief @copybrief cache::ShardedClockCache
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Concurrent cache with lock-free reads, a drop-in replacement for
+/// cache::NWayLRU.
+///
+/// The keys are spread over `shards` independent shards of `shard_size`
+/// elements. Each shard is a utils::PersistentHashMap published via
+/// rcu::Variable, so Get() takes no locks and does not write to shared cache
+/// lines. Writers of the same shard are serialized.
+///
+/// Instead of reordering a list on every read, a read sets a "referenced" bit
+/// of the element. On insertion into a full shard the CLOCK hand looks for an
+/// element that was not referenced since the previous pass.
+///
+/// The insertion of a new key into a full shard is subject to TinyLFU
+/// admission: the key replaces the CLOCK victim only if the key was accessed
+/// more often than the victim recently or the victim was not accessed at all.
+/// A scan over many one-time keys does not wash the frequently used keys out
+/// of the cache. As a consequence, Put() of a new rarely accessed key into a
+/// full cache may be ignored.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class ShardedClockCache final {
+ public:
+  ShardedClockCache(std::size_t shards, std::size_t shard_size,
+                    const Hash& hash = Hash(), const Equal& equal = Equal());
+
+  void Put(const T& key, U value);
+
+  template <typename Validator>
+  std::optional<U> Get(const T& key, Validator validator);
+
+  std::optional<U> Get(const T& key) {
+    return Get(key, [](const U&) { return true; });
+  }
+
+  U GetOr(const T& key, const U& default_value);
+
+  void Invalidate();
+
+  void InvalidateByKey(const T& key);
+
+  /// Iterates over all items. May be slow for big caches.
+  template <typename Function>
+  void VisitAll(Function func) const;
+
+  std::size_t GetSize() const;
+
+  void UpdateWaySize(std::size_t shard_size);
+
+ private:
+  struct Entry final {
+    Entry(std::size_t hash, const T& key, U&& value)
+        : hash(hash), key(key), value(std::move(value)) {}
+
+    void MarkReferenced() noexcept {
+      // avoid writing to the cache line of a hot element on each read
+      if (!referenced.load(std::memory_order_relaxed)) {
+        referenced.store(true, std::memory_order_relaxed);
+      }
+    }
+
+    const std::size_t hash;
+    const T key;
+    const U value;
+    std::atomic<bool> referenced{false};
+
+    // Accessed by writers only
+    std::size_t clock_index{0};
+  };
+  using EntryPtr = std::shared_ptr<Entry>;
+  using Map = utils::PersistentHashMap<T, EntryPtr, Hash, Equal>;
+
+  struct Snapshot final {
+    Snapshot(std::size_t shard_size, const Hash& hash, const Equal& equal)
+        : map(hash, equal),
+          sketch(std::make_shared<impl::FrequencySketch>(shard_size)) {}
+
+    Map map;
+    std::shared_ptr<impl::FrequencySketch> sketch;
+  };
+  using SnapshotPtr = rcu::WritablePtr<Snapshot, rcu::ReadScalableRcuTraits>;
+
+  struct Shard final {
+    Shard(std::size_t shard_size, const Hash& hash, const Equal& equal)
+        : snapshot(shard_size, hash, equal), max_size(shard_size) {}
+
+    rcu::Variable<Snapshot, rcu::ReadScalableRcuTraits> snapshot;
+
+    // The rest is accessed only with a WritablePtr to `snapshot` held
+
+    // CLOCK ring of the elements, nullptr for the free slots
+    std::vector<EntryPtr> clock;
+    std::vector<std::size_t> free_slots;
+    std::size_t hand{0};
+    std::size_t max_size;
+  };
+
+  Shard& GetShard(std::size_t hash);
+
+  // Makes room for an element with `hash`, returns false if the element is
+  // not admitted
+  bool MakeRoom(Shard& shard, Snapshot& snapshot, std::size_t hash);
+
+  std::size_t FindVictim(Shard& shard);
+
+  void Erase(Shard& shard, Snapshot& snapshot, const Entry& entry);
+
+  void Compact(Shard& shard);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  Hash hash_fn_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+ShardedClockCache<T, U, Hash, Equal>::ShardedClockCache(std::size_t shards,
+                                                        std::size_t shard_size,
+                                                        const Hash& hash,
+                                                        const Equal& equal)
+    : hash_fn_(hash) {
+  if (shards == 0) throw std::logic_error("Shards must be positive");
+  if (shard_size == 0) throw std::logic_error("Shard size must be positive");
+
+  shards_.reserve(shards);
+  for (std::size_t i = 0; i < shards; ++i) {
+    shards_.push_back(std::make_unique<Shard>(shard_size, hash, equal));
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ShardedClockCache<T, U, Hash, Equal>::Put(const T& key, U value) {
+  const auto hash = hash_fn_(key);
+  auto& shard = GetShard(hash);
+  auto entry = std::make_shared<Entry>(hash, key, std::move(value));
+
+  SnapshotPtr snapshot = shard.snapshot.StartWrite();
+  const auto it = snapshot->map.find(key);
+  if (it != snapshot->map.end()) {
+    // the new value inherits the slot and the recency of the old one
+    entry->clock_index = it->second->clock_index;
+    entry->referenced.store(true, std::memory_order_relaxed);
+    shard.clock[entry->clock_index] = entry;
+  } else {
+    if (!MakeRoom(shard, *snapshot, hash)) return;
+
+    if (!shard.free_slots.empty()) {
+      entry->clock_index = shard.free_slots.back();
+      shard.free_slots.pop_back();
+      shard.clock[entry->clock_index] = entry;
+    } else {
+      entry->clock_index = shard.clock.size();
+      shard.clock.push_back(entry);
+    }
+  }
+
+  snapshot->map.insert_or_assign(key, std::move(entry));
+  snapshot.Commit();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Validator>
+std::optional<U> ShardedClockCache<T, U, Hash, Equal>::Get(
+    const T& key, Validator validator) {
+  const auto hash = hash_fn_(key);
+  auto& shard = GetShard(hash);
+
+  {
+    const auto snapshot = shard.snapshot.Read();
+    snapshot->sketch->Increment(hash);
+
+    const auto it = snapshot->map.find(key);
+    if (it == snapshot->map.end()) return std::nullopt;
+
+    auto& entry = *it->second;
+    if (validator(entry.value)) {
+      entry.MarkReferenced();
+      return entry.value;
+    }
+  }
+
+  SnapshotPtr snapshot = shard.snapshot.StartWrite();
+  const auto it = snapshot->map.find(key);
+  if (it != snapshot->map.end()) {
+    Erase(shard, *snapshot, *it->second);
+    snapshot.Commit();
+  }
+  return std::nullopt;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U ShardedClockCache<T, U, Hash, Equal>::GetOr(const T& key,
+                                              const U& default_value) {
+  auto value = Get(key);
+  return value ? std::move(*value) : default_value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ShardedClockCache<T, U, Hash, Equal>::Invalidate() {
+  for (auto& shard : shards_) {
+    SnapshotPtr snapshot = shard->snapshot.StartWrite();
+    snapshot->map.clear();
+    shard->clock.clear();
+    shard->free_slots.clear();
+    shard->hand = 0;
+    snapshot.Commit();
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ShardedClockCache<T, U, Hash, Equal>::InvalidateByKey(const T& key) {
+  auto& shard = GetShard(hash_fn_(key));
+
+  SnapshotPtr snapshot = shard.snapshot.StartWrite();
+  const auto it = snapshot->map.find(key);
+  if (it == snapshot->map.end()) return;
+
+  Erase(shard, *snapshot, *it->second);
+  snapshot.Commit();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void ShardedClockCache<T, U, Hash, Equal>::VisitAll(Function func) const {
+  for (const auto& shard : shards_) {
+    const auto snapshot = shard->snapshot.Read();
+    for (const auto& [key, entry] : snapshot->map) func(key, entry->value);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ShardedClockCache<T, U, Hash, Equal>::GetSize() const {
+  std::size_t size{0};
+  for (const auto& shard : shards_) {
+    const auto snapshot = shard->snapshot.Read();
+    size += snapshot->map.size();
+  }
+  return size;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ShardedClockCache<T, U, Hash, Equal>::UpdateWaySize(
+    std::size_t shard_size) {
+  if (shard_size == 0) throw std::logic_error("Shard size must be positive");
+
+  for (auto& shard : shards_) {
+    SnapshotPtr snapshot = shard->snapshot.StartWrite();
+    if (shard->max_size == shard_size) continue;
+
+    shard->max_size = shard_size;
+    while (snapshot->map.size() > shard_size) {
+      Erase(*shard, *snapshot, *shard->clock[FindVictim(*shard)]);
+    }
+    Compact(*shard);
+    snapshot->sketch = std::make_shared<impl::FrequencySketch>(shard_size);
+    snapshot.Commit();
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename ShardedClockCache<T, U, Hash, Equal>::Shard&
+ShardedClockCache<T, U, Hash, Equal>::GetShard(std::size_t hash) {
+  // the low bits of the hash are used by the map inside the shard
+  const auto mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+  return *shards_[(mixed >> 32) % shards_.size()];
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool ShardedClockCache<T, U, Hash, Equal>::MakeRoom(Shard& shard,
+                                                    Snapshot& snapshot,
+                                                    std::size_t hash) {
+  if (snapshot.map.size() < shard.max_size) return true;
+
+  const auto victim_index = FindVictim(shard);
+  const auto& victim = *shard.clock[victim_index];
+
+  // TinyLFU admission: a victim that was requested since the last aging is
+  // replaced only by a more frequently requested key
+  const auto victim_frequency = snapshot.sketch->Estimate(victim.hash);
+  if (victim_frequency != 0 &&
+      snapshot.sketch->Estimate(hash) <= victim_frequency) {
+    return false;
+  }
+
+  Erase(shard, snapshot, victim);
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ShardedClockCache<T, U, Hash, Equal>::FindVictim(Shard& shard) {
+  UASSERT(shard.clock.size() > shard.free_slots.size());
+
+  // Terminates after a single pass over the clock at most: all the
+  // "referenced" bits are cleared on the way
+  while (true) {
+    const auto index = shard.hand;
+    if (++shard.hand == shard.clock.size()) shard.hand = 0;
+
+    auto& entry = shard.clock[index];
+    if (!entry) continue;
+    if (entry->referenced.load(std::memory_order_relaxed)) {
+      entry->referenced.store(false, std::memory_order_relaxed);
+      continue;
+    }
+    return index;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ShardedClockCache<T, U, Hash, Equal>::Erase(Shard& shard,
+                                                 Snapshot& snapshot,
+                                                 const Entry& entry) {
+  const auto index = entry.clock_index;
+  UASSERT(shard.clock[index].get() == &entry);
+
+  // `entry` is kept alive by the clock until the end of the function
+  snapshot.map.erase(entry.key);
+  shard.free_slots.push_back(index);
+  shard.clock[index] = nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ShardedClockCache<T, U, Hash, Equal>::Compact(Shard& shard) {
+  std::vector<EntryPtr> clock;
+  clock.reserve(shard.max_size);
+  for (auto& entry : shard.clock) {
+    if (!entry) continue;
+    entry->clock_index = clock.size();
+    clock.push_back(std::move(entry));
+  }
+
+  shard.clock = std::move(clock);
+  shard.free_slots.clear();
+  shard.hand = 0;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
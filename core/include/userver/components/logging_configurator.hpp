@@ -20,6 +20,7 @@ namespace components {
 ///
 /// ## Dynamic config
 /// * @ref USERVER_NO_LOG_SPANS
+/// * @ref USERVER_TRACING_SAMPLING
 ///
 /// ## Static options:
 /// Name | Description | Default value
@@ -34,6 +34,9 @@ class Manager;
 /// coro_pool.max_size | max amount of coroutines to keep preallocated | -
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | -
+/// event_thread_pool.cpu-affinity | list of CPUs to pin the event threads to, e.g. '0-7,16-23' | no pinning
+/// event_thread_pool.numa-node | NUMA node to pin the event threads to, intersected with event_thread_pool.cpu-affinity if both are set | no pinning
+/// event_thread_pool.io-backend | 'libev' or 'io_uring'; with 'io_uring' the blocked socket and pipe operations are submitted to a per event thread io_uring instance, libev is used if the kernel does not support it | libev
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
@@ -45,6 +48,9 @@ class Manager;
 /// thread_name | set OS thread name to this value | -
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest pririty. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
+/// task-queue-type | 'global-task-queue' for a single queue shared by all the workers; 'work-stealing-task-queue' for per-worker queues with work stealing, that usually scale better with the count of worker_threads | global-task-queue
+/// cpu-affinity | list of CPUs to pin the worker threads to, e.g. '0-7,16-23' | no pinning
+/// numa-node | NUMA node to pin the worker threads to, intersected with cpu-affinity if both are set. Coroutine stacks for the task processor are allocated on that node | no pinning
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
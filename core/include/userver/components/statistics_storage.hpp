@@ -53,6 +53,8 @@ class StatisticsStorage final : public LoggableComponentBase {
   utils::statistics::Storage storage_;
   utils::statistics::MetricsStoragePtr metrics_storage_;
   std::vector<utils::statistics::Entry> metrics_storage_registration_;
+  utils::statistics::Entry logging_statistics_holder_;
+  utils::statistics::Entry span_exporter_statistics_holder_;
 };
 
 template <>
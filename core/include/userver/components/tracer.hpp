@@ -5,6 +5,7 @@
 
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/impl/component_base.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -26,6 +27,17 @@ namespace components {
 /// ---- | ----------- | -------------
 /// service-name | name of the service to write in traces | -
 /// tracer | type of the tracer to trace, currently supported only 'native' | 'native'
+/// span-exporter.file-path | write the finished spans to this file or named pipe in a compact binary format in the background instead of the default logger | -
+/// span-exporter.thread-buffer-size | size of the per-thread buffer of spans in bytes, must be a power of 2; the spans are dropped if the buffer is full | 262144
+///
+/// The sampling of the written spans is configured by the
+/// @ref USERVER_TRACING_SAMPLING dynamic config.
+///
+/// The file of the exported spans is reopened by components::Logging on
+/// SIGUSR1 along with the log files. The statistics of the exporter (`total`,
+/// `dropped` spans, `written_bytes`, `write_calls` and `write_errors`) are
+/// reported by components::StatisticsStorage at the `tracing.span-exporter`
+/// path.
 ///
 /// ## Static configuration example:
 ///
@@ -38,6 +50,13 @@ class Tracer final : public impl::ComponentBase {
 
   Tracer(const ComponentConfig& config, const ComponentContext& context);
 
+  ~Tracer() override;
+
+  /// @cond
+  // Writes the statistics of the span exporter, for internal use only
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+  /// @endcond
+
   static yaml_config::Schema GetStaticConfigSchema();
 };
 
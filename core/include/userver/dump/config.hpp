@@ -6,6 +6,7 @@
 #include <string_view>
 #include <unordered_map>
 
+#include <userver/dump/operations.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -46,6 +47,8 @@ struct Config final {
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  bool dump_is_mapped;
+  ParallelConfig parallel;
 
   bool dumps_enabled;
   std::chrono::milliseconds min_dump_interval;
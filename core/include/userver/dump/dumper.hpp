@@ -84,6 +84,9 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `mmap` | `boolean` | Whether to read the dump via `mmap`, allows dump::FlatMap to use the dump in place. Incompatible with `encrypted` | `false`
+/// `parallel-tasks` | `integer` | The maximum number of tasks that serialize or parse the chunks of dump::WriteParallel | `1`
+/// `compression-level` | `integer` | zstd compression level of the chunks of dump::WriteParallel, `0` disables compression | `0`
 /// `first-update-mode` | `string` | specifies whether required or best-effort first update will be used | skip
 /// `first-update-type` | `string` | specifies whether incremental and/or full first update will be used | full
 ///
@@ -0,0 +1,344 @@
+#pragma once
+
+/// @file userver/dump/flat_map.hpp
+/// @brief @copybrief dump::FlatMap
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+// The layout of a flat buffer:
+// - FlatHeader
+// - `count` entries sorted by key, `key_size + value_size` bytes each
+// - the string pool, `strings_size` bytes
+// The entries are accessed via memcpy, so the buffer has no alignment
+// requirements and can be used in place at any offset of a dump file.
+struct FlatHeader final {
+  std::uint64_t magic;
+  std::uint32_t format_version;
+  std::uint32_t key_size;
+  std::uint32_t value_size;
+  std::uint32_t reserved;
+  std::uint64_t count;
+  std::uint64_t strings_size;
+  // of everything after the header
+  std::uint64_t checksum;
+};
+
+inline constexpr std::size_t kFlatHeaderSize = sizeof(FlatHeader);
+
+struct FlatBuffer final {
+  std::shared_ptr<const char> data;
+  std::size_t size{0};
+  std::size_t count{0};
+};
+
+// Allocates a buffer of `size` bytes, including the header
+std::shared_ptr<char[]> AllocateFlatBuffer(std::size_t size);
+
+// Fills the header of a buffer, the entries and the strings must be in place
+void FinishFlatBuffer(char* data, std::size_t size, FlatHeader header);
+
+void WriteFlatBuffer(Writer& writer, const FlatBuffer& buffer);
+
+// @throws dump::Error if the buffer is corrupted or has another layout
+FlatBuffer ReadFlatBuffer(Reader& reader, std::uint32_t key_size,
+                          std::uint32_t value_size);
+
+template <typename T>
+struct FlatTraits final {
+  static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>,
+                "dump::FlatMap only supports trivially copyable types without "
+                "pointers and std::string_view");
+
+  static constexpr std::size_t kSize = sizeof(T);
+
+  static std::size_t GetStringsSize(const T&) noexcept { return 0; }
+
+  static void Store(char* entry, const T& value, char* /*strings*/,
+                    std::size_t& /*strings_offset*/) noexcept {
+    std::memcpy(entry, &value, sizeof(T));
+  }
+
+  static T Load(const char* entry, const char* /*strings*/) noexcept {
+    T value;
+    std::memcpy(&value, entry, sizeof(T));
+    return value;
+  }
+};
+
+// The strings are stored as offsets into the string pool
+template <>
+struct FlatTraits<std::string_view> final {
+  static constexpr std::size_t kSize = 2 * sizeof(std::uint64_t);
+
+  static std::size_t GetStringsSize(std::string_view value) noexcept {
+    return value.size();
+  }
+
+  static void Store(char* entry, std::string_view value, char* strings,
+                    std::size_t& strings_offset) noexcept {
+    const std::uint64_t location[] = {strings_offset, value.size()};
+    std::memcpy(entry, location, sizeof(location));
+    value.copy(strings + strings_offset, value.size());
+    strings_offset += value.size();
+  }
+
+  static std::string_view Load(const char* entry,
+                               const char* strings) noexcept {
+    std::uint64_t location[2];
+    std::memcpy(location, entry, sizeof(location));
+    return {strings + location[0], static_cast<std::size_t>(location[1])};
+  }
+};
+
+}  // namespace impl
+
+/// @ingroup userver_containers userver_dump_read_write
+///
+/// @brief An immutable sorted map that is dumped and loaded without
+/// serialization of the elements
+///
+/// The elements are stored in a single flat buffer: a versioned header with a
+/// checksum, the entries sorted by key and a pool of strings. Writing a dump
+/// is a single write of the buffer. If the dump is read via
+/// dump::MappedFileReader (the `mmap` option of dump::Dumper), the loaded map
+/// uses the memory-mapped dump file in place: loading takes the time of the
+/// checksum verification, and the pages of the file are shared with the page
+/// cache. Otherwise the buffer is copied from the dump in one piece.
+///
+/// `Key` and `Value` must be trivially copyable types without pointers or
+/// `std::string_view`. The string views point into the buffer of the map and
+/// stay valid for as long as the map or any of its copies are alive. The
+/// copies of the map are cheap and share the buffer.
+///
+/// The elements are returned by value. The lookup is a binary search.
+///
+/// @warning The buffer is dumped in the native byte order and layout of the
+/// types, so the dumps can only be read on the same architecture.
+///
+/// ## Example usage:
+///
+/// @snippet core/src/dump/flat_map_test.cpp  Sample FlatMap usage
+template <typename Key, typename Value>
+class FlatMap final {
+  using KeyTraits = impl::FlatTraits<Key>;
+  using ValueTraits = impl::FlatTraits<Value>;
+
+  static constexpr std::size_t kEntrySize =
+      KeyTraits::kSize + ValueTraits::kSize;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+
+  class const_iterator final {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = FlatMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+    using pointer = void;
+
+    const_iterator() = default;
+
+    value_type operator*() const { return map_->GetElement(index_); }
+
+    const_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto copy = *this;
+      ++index_;
+      return copy;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return index_ == other.index_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    friend class FlatMap;
+
+    const_iterator(const FlatMap* map, std::size_t index)
+        : map_(map), index_(index) {}
+
+    const FlatMap* map_{nullptr};
+    std::size_t index_{0};
+  };
+
+  using iterator = const_iterator;
+
+  /// Creates an empty map
+  FlatMap() : FlatMap(std::vector<value_type>{}) {}
+
+  /// @brief Creates a map of `elements`
+  /// @details The elements are pairs of values convertible to `Key` and
+  /// `Value`. If there are several elements with the same key, the first one
+  /// is kept.
+  template <typename Range>
+  explicit FlatMap(const Range& elements);
+
+  FlatMap(std::initializer_list<value_type> elements)
+      : FlatMap(std::vector<value_type>(elements)) {}
+
+  std::size_t size() const noexcept { return buffer_.count; }
+
+  bool empty() const noexcept { return buffer_.count == 0; }
+
+  const_iterator begin() const noexcept { return {this, 0}; }
+
+  const_iterator end() const noexcept { return {this, buffer_.count}; }
+
+  const_iterator find(const Key& key) const;
+
+  bool contains(const Key& key) const { return find(key) != end(); }
+
+  bool operator==(const FlatMap& other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  bool operator!=(const FlatMap& other) const { return !(*this == other); }
+
+ private:
+  template <typename K, typename V>
+  friend void Write(Writer& writer, const FlatMap<K, V>& map);
+
+  template <typename K, typename V>
+  friend FlatMap<K, V> Read(Reader& reader, To<FlatMap<K, V>>);
+
+  explicit FlatMap(impl::FlatBuffer buffer);
+
+  const char* GetEntry(std::size_t index) const noexcept {
+    return entries_ + index * kEntrySize;
+  }
+
+  Key GetKey(std::size_t index) const noexcept {
+    return KeyTraits::Load(GetEntry(index), strings_);
+  }
+
+  value_type GetElement(std::size_t index) const noexcept {
+    const char* entry = GetEntry(index);
+    return {KeyTraits::Load(entry, strings_),
+            ValueTraits::Load(entry + KeyTraits::kSize, strings_)};
+  }
+
+  impl::FlatBuffer buffer_;
+  const char* entries_{nullptr};
+  const char* strings_{nullptr};
+};
+
+template <typename Key, typename Value>
+template <typename Range>
+FlatMap<Key, Value>::FlatMap(const Range& elements) {
+  // the views of the keys and the values point into `elements`
+  std::vector<value_type> sorted;
+  for (const auto& [key, value] : elements) sorted.emplace_back(key, value);
+
+  std::stable_sort(
+      sorted.begin(), sorted.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                           [](const auto& lhs, const auto& rhs) {
+                             return lhs.first == rhs.first;
+                           }),
+               sorted.end());
+
+  std::size_t strings_size = 0;
+  for (const auto& [key, value] : sorted) {
+    strings_size +=
+        KeyTraits::GetStringsSize(key) + ValueTraits::GetStringsSize(value);
+  }
+
+  const auto size =
+      impl::kFlatHeaderSize + sorted.size() * kEntrySize + strings_size;
+  auto data = impl::AllocateFlatBuffer(size);
+
+  char* entry = data.get() + impl::kFlatHeaderSize;
+  char* strings = entry + sorted.size() * kEntrySize;
+  std::size_t strings_offset = 0;
+  for (const auto& [key, value] : sorted) {
+    KeyTraits::Store(entry, key, strings, strings_offset);
+    ValueTraits::Store(entry + KeyTraits::kSize, value, strings,
+                       strings_offset);
+    entry += kEntrySize;
+  }
+
+  impl::FlatHeader header{};
+  header.key_size = KeyTraits::kSize;
+  header.value_size = ValueTraits::kSize;
+  header.count = sorted.size();
+  header.strings_size = strings_size;
+  impl::FinishFlatBuffer(data.get(), size, header);
+
+  const char* buffer_data = data.get();
+  *this = FlatMap(impl::FlatBuffer{
+      std::shared_ptr<const char>(data, buffer_data), size,
+      sorted.size()});
+}
+
+template <typename Key, typename Value>
+FlatMap<Key, Value>::FlatMap(impl::FlatBuffer buffer)
+    : buffer_(std::move(buffer)),
+      entries_(buffer_.data.get() + impl::kFlatHeaderSize),
+      strings_(entries_ + buffer_.count * kEntrySize) {}
+
+template <typename Key, typename Value>
+typename FlatMap<Key, Value>::const_iterator FlatMap<Key, Value>::find(
+    const Key& key) const {
+  std::size_t first = 0;
+  std::size_t count = buffer_.count;
+  while (count > 0) {
+    const auto step = count / 2;
+    if (GetKey(first + step) < key) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  if (first == buffer_.count || !(GetKey(first) == key)) return end();
+  return {this, first};
+}
+
+/// @brief dump::FlatMap serialization support
+template <typename Key, typename Value>
+void Write(Writer& writer, const FlatMap<Key, Value>& map) {
+  impl::WriteFlatBuffer(writer, map.buffer_);
+}
+
+/// @brief dump::FlatMap deserialization support
+template <typename Key, typename Value>
+FlatMap<Key, Value> Read(Reader& reader, To<FlatMap<Key, Value>>) {
+  using Map = FlatMap<Key, Value>;
+  return Map(impl::ReadFlatBuffer(reader, Map::KeyTraits::kSize,
+                                  Map::ValueTraits::kSize));
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -19,6 +22,20 @@ class Error final : public std::runtime_error {
   explicit Error(std::string message) : std::runtime_error(message) {}
 };
 
+/// Settings of dump::WriteParallel and dump::ReadParallel, see the
+/// `parallel-tasks` and `compression-level` options of dump::Dumper
+struct ParallelConfig final {
+  /// The maximum number of tasks that process the chunks of a dump at once
+  std::size_t tasks{1};
+
+  /// zstd compression level of the chunks, 0 disables compression
+  int compression_level{0};
+};
+
+/// @cond
+struct ParallelStatistics;
+/// @endcond
+
 /// A general interface for binary data output
 class Writer {
  public:
@@ -35,6 +52,23 @@ class Writer {
   /// @throws `Error` on write operation failure
   virtual void Finish() = 0;
 
+  /// @cond
+  // Set by dump::Dumper, used by dump::WriteParallel
+  void SetParallelConfig(const ParallelConfig& config,
+                         ParallelStatistics* statistics) noexcept {
+    parallel_config_ = config;
+    parallel_statistics_ = statistics;
+  }
+
+  const ParallelConfig& GetParallelConfig() const noexcept {
+    return parallel_config_;
+  }
+
+  ParallelStatistics* GetParallelStatistics() const noexcept {
+    return parallel_statistics_;
+  }
+  /// @endcond
+
  protected:
   /// @brief Writes binary data
   /// @details Unlike `Write`, doesn't write the size of `data`
@@ -42,6 +76,10 @@ class Writer {
   virtual void WriteRaw(std::string_view data) = 0;
 
   friend void WriteStringViewUnsafe(Writer& writer, std::string_view value);
+
+ private:
+  ParallelConfig parallel_config_;
+  ParallelStatistics* parallel_statistics_{nullptr};
 };
 
 /// A general interface for binary data input
@@ -60,6 +98,29 @@ class Reader {
   /// @throws `Error` on read operation failure or if there is leftover data
   virtual void Finish() = 0;
 
+  /// @cond
+  // Set by dump::Dumper, used by dump::ReadParallel
+  void SetParallelConfig(const ParallelConfig& config,
+                         ParallelStatistics* statistics) noexcept {
+    parallel_config_ = config;
+    parallel_statistics_ = statistics;
+  }
+
+  const ParallelConfig& GetParallelConfig() const noexcept {
+    return parallel_config_;
+  }
+
+  ParallelStatistics* GetParallelStatistics() const noexcept {
+    return parallel_statistics_;
+  }
+
+  // Used by dump::ReadParallel to validate the sizes stored in the dump,
+  // std::nullopt if the size of the unread data is not known
+  virtual std::optional<std::size_t> GetRemainingSize() const {
+    return std::nullopt;
+  }
+  /// @endcond
+
  protected:
   /// @brief Reads binary data
   /// @note Invalidates the memory returned by the previous call of `ReadRaw`
@@ -68,7 +129,23 @@ class Reader {
   /// @throws `Error` on read operation failure
   virtual std::string_view ReadRaw(std::size_t max_size) = 0;
 
+  /// @brief Reads exactly `size` bytes without copying them. The bytes stay
+  /// valid for as long as the returned pointer is alive.
+  /// @returns `nullptr` if the reader does not support such reads, e.g. if the
+  /// dump is not memory-mapped. Nothing is read in this case.
+  /// @throws `Error` on read operation failure
+  virtual std::shared_ptr<const char> ReadMappedRaw(std::size_t /*size*/) {
+    return nullptr;
+  }
+
   friend std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t size);
+
+  friend std::shared_ptr<const char> ReadMappedUnsafe(Reader& reader,
+                                                      std::size_t size);
+
+ private:
+  ParallelConfig parallel_config_;
+  ParallelStatistics* parallel_statistics_{nullptr};
 };
 
 namespace impl {
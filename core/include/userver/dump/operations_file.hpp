@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
+#include <optional>
 
 #include <boost/filesystem/operations.hpp>
 
@@ -44,6 +46,8 @@ class FileReader final : public Reader {
 
   void Finish() override;
 
+  std::optional<std::size_t> GetRemainingSize() const override;
+
  private:
   std::string_view ReadRaw(std::size_t max_size) override;
 
@@ -52,6 +56,33 @@ class FileReader final : public Reader {
   std::string curr_chunk_;
 };
 
+/// @brief A handle to a memory-mapped dump file. File operations block the
+/// thread.
+///
+/// Unlike FileReader, the data is not copied on reads. The types that support
+/// it (see dump::FlatMap) use the contents of the dump in place, the file stays
+/// mapped for as long as they are alive.
+class MappedFileReader final : public Reader {
+ public:
+  /// @brief Opens an existing dump file and maps it into memory
+  /// @throws `Error` on a filesystem error
+  explicit MappedFileReader(std::string path);
+
+  void Finish() override;
+
+  std::optional<std::size_t> GetRemainingSize() const override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  std::shared_ptr<const char> ReadMappedRaw(std::size_t size) override;
+
+  std::string path_;
+  std::shared_ptr<const char> data_;
+  std::size_t size_{0};
+  std::size_t position_{0};
+};
+
 class FileOperationsFactory final : public OperationsFactory {
  public:
   explicit FileOperationsFactory(boost::filesystem::perms perms);
@@ -65,6 +96,20 @@ class FileOperationsFactory final : public OperationsFactory {
   const boost::filesystem::perms perms_;
 };
 
+/// Writes dumps as FileOperationsFactory does, reads them via MappedFileReader
+class MappedFileOperationsFactory final : public OperationsFactory {
+ public:
+  explicit MappedFileOperationsFactory(boost::filesystem::perms perms);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const boost::filesystem::perms perms_;
+};
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,159 @@
+#pragma once
+
+/// @file userver/dump/parallel.hpp
+/// @brief Parallel serialization of large containers in dumps
+///
+/// @ingroup userver_dump_read_write
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/meta.hpp>
+#include <userver/dump/meta_containers.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+// Returns the number of chunks to split `size` elements into
+std::size_t GetParallelChunkCount(const Writer& writer, std::size_t size);
+
+// Writes the chunks, `write_chunk(chunk_writer, index)` is called in parallel
+// for different chunks
+void WriteChunks(Writer& writer, const std::vector<std::size_t>& chunk_sizes,
+                 const std::function<void(Writer&, std::size_t)>& write_chunk);
+
+struct ChunksCallbacks final {
+  // Called once with the total size and the number of chunks
+  std::function<void(std::size_t, std::size_t)> start;
+  // Called in parallel for different chunks with the chunk index and size
+  std::function<void(Reader&, std::size_t, std::size_t)> read_chunk;
+  // Called in the order of the chunks, as soon as a chunk has been read
+  std::function<void(std::size_t)> merge_chunk;
+};
+
+void ReadChunks(Reader& reader, const ChunksCallbacks& callbacks);
+
+template <typename T>
+using MergeResult = decltype(std::declval<T&>().merge(std::declval<T&>()));
+
+template <typename T>
+void MergeInto(T& result, T& part) {
+  if constexpr (meta::kIsDetected<MergeResult, T>) {
+    // relinks the nodes without copying or moving the elements
+    result.merge(part);
+  } else {
+    for (auto& item : part) dump::Insert(result, std::move(item));
+  }
+  part = T{};
+}
+
+}  // namespace impl
+
+/// @brief Writes a container as independent chunks that are serialized and
+/// compressed in parallel
+///
+/// The chunks are serialized by up to `parallel-tasks` tasks (see
+/// dump::Dumper) on the current task processor, while the dump file is written
+/// and encrypted in the current task. Reading the container back requires
+/// dump::ReadParallel, which is not compatible with dump::Read.
+///
+/// To dump a cache in parallel, override `WriteContents` and `ReadContents`
+/// of components::CachingComponentBase:
+/// @code
+/// void WriteContents(dump::Writer& writer,
+///                    const Data& contents) const override {
+///   dump::WriteParallel(writer, contents);
+/// }
+///
+/// std::unique_ptr<const Data> ReadContents(
+///     dump::Reader& reader) const override {
+///   return std::make_unique<const Data>(
+///       dump::ReadParallel(reader, dump::To<Data>{}));
+/// }
+/// @endcode
+///
+/// Dump format of the container:
+/// - total size
+/// - the number of chunks
+/// - for each chunk: its encoding, the number of elements and the serialized
+///   elements as a string, compressed if the encoding is zstd
+template <typename T>
+std::enable_if_t<kIsContainer<T> && kIsWritable<meta::RangeValueType<T>>>
+WriteParallel(Writer& writer, const T& value) {
+  const std::size_t size = std::size(value);
+  const std::size_t chunk_count = impl::GetParallelChunkCount(writer, size);
+
+  std::vector<std::size_t> chunk_sizes;
+  std::vector<decltype(std::begin(value))> chunk_begins;
+  chunk_sizes.reserve(chunk_count);
+  chunk_begins.reserve(chunk_count);
+
+  auto it = std::begin(value);
+  for (std::size_t i = 0; i < chunk_count; ++i) {
+    const auto chunk_size = size / chunk_count + (i < size % chunk_count);
+    chunk_sizes.push_back(chunk_size);
+    chunk_begins.push_back(it);
+    std::advance(it, chunk_size);
+  }
+
+  impl::WriteChunks(
+      writer, chunk_sizes, [&](Writer& chunk_writer, std::size_t index) {
+        auto item = chunk_begins[index];
+        for (std::size_t i = 0; i < chunk_sizes[index]; ++i, ++item) {
+          // explicit cast for vector<bool> shenanigans
+          chunk_writer.Write(
+              static_cast<const meta::RangeValueType<T>&>(*item));
+        }
+      });
+}
+
+/// @brief Reads a container written by dump::WriteParallel
+///
+/// The chunks are decompressed and parsed by up to `parallel-tasks` tasks
+/// (see dump::Dumper) on the current task processor. The parsed chunks are
+/// merged into the resulting container in the current task while the
+/// following chunks are still being parsed. Node-based containers are merged
+/// without copying or moving the elements.
+template <typename T>
+std::enable_if_t<kIsContainer<T> && kIsReadable<meta::RangeValueType<T>>, T>
+ReadParallel(Reader& reader, To<T>) {
+  T result{};
+  std::vector<T> parts;
+
+  impl::ChunksCallbacks callbacks;
+  callbacks.start = [&](std::size_t size, std::size_t chunk_count) {
+    if constexpr (meta::kIsReservable<T>) {
+      result.reserve(size);
+    }
+    parts.resize(chunk_count);
+  };
+  callbacks.read_chunk = [&](Reader& chunk_reader, std::size_t index,
+                             std::size_t size) {
+    auto& part = parts[index];
+    if constexpr (meta::kIsReservable<T>) {
+      part.reserve(size);
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      dump::Insert(part, chunk_reader.Read<meta::RangeValueType<T>>());
+    }
+  };
+  callbacks.merge_chunk = [&](std::size_t index) {
+    impl::MergeInto(result, parts[index]);
+  };
+
+  impl::ReadChunks(reader, callbacks);
+  return result;
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
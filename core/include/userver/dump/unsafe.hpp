@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string_view>
 
 #include <userver/dump/operations.hpp>
@@ -27,6 +28,12 @@ std::string_view ReadStringViewUnsafe(Reader& reader, std::size_t size);
 /// @warning The `string_view` will be invalidated on the next `Read` operation
 std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size);
 
+/// @brief Reads `size` bytes that stay valid for as long as the returned
+/// pointer is alive
+/// @note The bytes are used in place if the dump is memory-mapped (see
+/// dump::MappedFileReader), otherwise they are copied into a new buffer.
+std::shared_ptr<const char> ReadMappedUnsafe(Reader& reader, std::size_t size);
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
@@ -15,6 +15,12 @@ namespace engine::io {
 /// File descriptor of an invalid pipe end.
 static constexpr int kInvalidFd = -1;
 
+/// A contiguous chunk of data for vectored (scatter-gather) I/O
+struct IoData final {
+  const void* data;
+  size_t len;
+};
+
 /// Interface for readable streams
 class ReadableBase {
  public:
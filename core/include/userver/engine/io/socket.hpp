@@ -5,6 +5,8 @@
 
 #include <sys/socket.h>
 
+#include <initializer_list>
+
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/common.hpp>
 #include <userver/engine/io/exception.hpp>
@@ -79,6 +81,17 @@ class USERVER_NODISCARD Socket final : public ReadableBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends all the buffers of the list to the socket in order, using
+  /// as few system calls as possible (scatter-gather I/O).
+  /// @returns total bytes sent
+  /// @note Can return less than the total size if socket is closed by peer.
+  [[nodiscard]] size_t SendAll(std::initializer_list<IoData> list,
+                               Deadline deadline);
+
+  /// @overload
+  [[nodiscard]] size_t SendAll(const IoData* list, size_t list_size,
+                               Deadline deadline);
+
   /// @brief Accepts a connection from a listening socket.
   /// @see engine::io::Listen
   [[nodiscard]] Socket Accept(Deadline);
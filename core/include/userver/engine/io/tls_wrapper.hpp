@@ -3,6 +3,7 @@
 /// @file userver/engine/io/tls_wrapper.hpp
 /// @brief TLS socket wrappers
 
+#include <initializer_list>
 #include <string>
 #include <vector>
 
@@ -26,16 +27,21 @@ namespace engine::io {
 /// @snippet src/engine/io/tls_wrapper_test.cpp TLS wrapper usage
 class USERVER_NODISCARD TlsWrapper final : public ReadableBase {
  public:
-  /// Starts a TLS client on an opened socket
-  static TlsWrapper StartTlsClient(Socket&& socket,
-                                   const std::string& server_name,
-                                   Deadline deadline);
-
-  /// Starts a TLS server on an opened socket
+  /// @brief Starts a TLS client on an opened socket
+  /// @param alpn_protocols application protocols to offer to the server in
+  /// the order of preference, e.g. "h2", "http/1.1"
+  static TlsWrapper StartTlsClient(
+      Socket&& socket, const std::string& server_name, Deadline deadline,
+      const std::vector<std::string>& alpn_protocols = {});
+
+  /// @brief Starts a TLS server on an opened socket
+  /// @param alpn_protocols application protocols supported by the server in
+  /// the order of preference, the first one offered by the client is selected
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& cert_authorities = {});
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      const std::vector<std::string>& alpn_protocols = {});
 
   ~TlsWrapper() override;
 
@@ -48,6 +54,10 @@ class USERVER_NODISCARD TlsWrapper final : public ReadableBase {
   /// Whether the socket is valid.
   bool IsValid() const override;
 
+  /// @brief Application protocol negotiated with ALPN during the handshake.
+  /// @returns an empty string if no protocol was negotiated
+  std::string GetAlpnProtocol() const;
+
   /// Suspends current task until the socket has data available.
   [[nodiscard]] bool WaitReadable(Deadline) override;
 
@@ -67,6 +77,17 @@ class USERVER_NODISCARD TlsWrapper final : public ReadableBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends all the buffers of the list to the socket in order.
+  /// Small buffers are coalesced to avoid producing a TLS record per buffer.
+  /// @returns total bytes sent
+  /// @note Can return less than the total size if socket is closed by peer.
+  [[nodiscard]] size_t SendAll(std::initializer_list<IoData> list,
+                               Deadline deadline);
+
+  /// @overload
+  [[nodiscard]] size_t SendAll(const IoData* list, size_t list_size,
+                               Deadline deadline);
+
   /// @brief Finishes TLS session and returns the socket.
   /// @warning Wrapper becomes invalid on entry and can only be used to retry
   ///   socket extraction if interrupted.
@@ -20,6 +20,9 @@ struct TaskProcessorPoolsConfig final {
   std::string ev_thread_name = "ev";
   bool ev_default_loop_disabled = false;
   bool defer_events = true;
+  /// Submit the blocked socket and pipe operations to io_uring, falls back
+  /// to libev if the kernel does not support it
+  bool ev_io_uring = false;
 };
 
 /// @brief Runs a payload in a temporary coroutine engine instance.
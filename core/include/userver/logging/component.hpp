@@ -10,6 +10,7 @@
 #include <userver/components/impl/component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/os_signals/component.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 #include <userver/utils/periodic_task.hpp>
 
@@ -39,8 +40,8 @@ namespace components {
 /// level | log verbosity | info
 /// format | log output format, either `tskv` or `ltsv` | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
-/// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
-/// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// thread_buffer_size | the size of the message buffer of each logging thread in bytes, must be a power of 2 | 262144
+/// overflow_behavior | message handling policy while the buffer of a thread is full: `discard` drops messages, `block` waits until message gets into the buffer | discard
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 ///
 /// ### testsuite-capture options:
@@ -54,6 +55,21 @@ namespace components {
 /// @snippet components/common_component_list_test.cpp Sample logging component config
 ///
 /// `default` section configures the default logger for LOG_*.
+///
+/// The messages of the file loggers are formatted in the logging thread and
+/// put into a lock-free buffer of that thread. A dedicated thread per logger
+/// writes the buffers of all the threads to the file in batches. The messages
+/// of a single thread keep their order, the messages of different threads
+/// may be reordered within a write interval of about 10ms.
+///
+/// @warning A task may be resumed on another thread of its task processor, so
+/// the messages of a single task that are logged before and after a context
+/// switch (e.g. a wait on a mutex or on I/O) may also appear out of order in
+/// the file. Use the timestamps of the messages to restore the order.
+///
+/// The statistics of the file loggers (`total`, `dropped`, `blocked` messages,
+/// `written_bytes`, `write_calls` and `write_errors`) are reported by
+/// components::StatisticsStorage at the `logger` path with the `logger` label.
 
 // clang-format on
 
@@ -80,9 +96,14 @@ class Logging final : public impl::ComponentBase {
   void StartSocketLoggingDebug();
   void StopSocketLoggingDebug();
 
-  /// Reopens log files after rotation
+  /// Reopens log files and the file of the exported spans after rotation
   void OnLogRotate();
 
+  /// @cond
+  // Writes the statistics of the file loggers, for internal use only
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+  /// @endcond
+
   class TestsuiteCaptureSink;
 
   static yaml_config::Schema GetStaticConfigSchema();
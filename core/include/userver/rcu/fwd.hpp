@@ -0,0 +1,23 @@
+#pragma once
+
+/// @file userver/rcu/fwd.hpp
+/// @brief Forward declarations of rcu::Variable and rcu::ReadablePtr
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+struct DefaultRcuTraits;
+
+template <typename T, typename RcuTraits = DefaultRcuTraits>
+class Variable;
+
+template <typename T, typename RcuTraits = DefaultRcuTraits>
+class ReadablePtr;
+
+template <typename T, typename RcuTraits = DefaultRcuTraits>
+class WritablePtr;
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
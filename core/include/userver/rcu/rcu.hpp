@@ -3,14 +3,17 @@
 /// @file userver/rcu/rcu.hpp
 /// @brief Implementation of hazard pointer
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
 #include <cstdlib>
-#include <list>
-#include <unordered_set>
+#include <memory>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/fwd.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
@@ -24,11 +27,43 @@ USERVER_NAMESPACE_BEGIN
 /// with modified API
 namespace rcu {
 
-template <typename T>
-class Variable;
+/// @brief Default rcu::Variable traits.
+///
+/// Hazard pointers are allocated one by one on demand, old values are checked
+/// for readers and freed on every write. Suitable for most of the variables.
+struct DefaultRcuTraits {
+  /// Whether to preallocate a hazard pointer per CPU, each one in its own
+  /// cache line
+  static constexpr bool kPerCpuHazardPointers = false;
+
+  /// Old values are checked for readers and destroyed once that many of them
+  /// are retired
+  static constexpr std::size_t kRetireBatchSize = 1;
+};
+
+/// @brief rcu::Variable traits for variables that are read by all the threads
+/// on every request, e.g. dynamic config.
+///
+/// Readers on different CPUs work with their own cache lines and do not
+/// interfere with each other. Writers retire old values in batches, so up to
+/// `kRetireBatchSize - 1` old values may be kept alive until the next writes
+/// or rcu::Variable::Cleanup.
+struct ReadScalableRcuTraits {
+  static constexpr bool kPerCpuHazardPointers = true;
+  static constexpr std::size_t kRetireBatchSize = 16;
+};
 
 namespace impl {
 
+// Minimum offset between two objects to avoid false sharing
+// TODO: replace with std::hardware_destructive_interference_size
+inline constexpr std::size_t kInterferenceSize = 64;
+
+template <typename RcuTraits>
+inline constexpr std::size_t kHazardPointerAlignment =
+    RcuTraits::kPerCpuHazardPointers ? kInterferenceSize
+                                     : alignof(std::atomic<void*>);
+
 // Hazard pointer implementation. Pointers form a linked list. \p ptr points
 // to the data they 'hold', next - to the next element in a list.
 // kUsed is a filler value to show that hazard pointer is not free. Please see
@@ -37,8 +72,8 @@ namespace impl {
 // std::atomic<HazardPointerRecord*> global_head' Every rcu::Variable has its
 // own list of hazard pointers. Thus, move-assignment on hazard pointers is
 // difficult to implement.
-template <typename T>
-struct HazardPointerRecord final {
+template <typename T, typename RcuTraits>
+struct alignas(kHazardPointerAlignment<RcuTraits>) HazardPointerRecord final {
   // You see, objects are created 'filled', that is for the purposes of hazard
   // pointer list, they contain value. This eliminates some race conditions,
   // because these algorithms checks for ptr != nullptr (And kUsed is not
@@ -46,29 +81,40 @@ struct HazardPointerRecord final {
   // somewhere into kernel space and will cause SEGFAULT
   static inline T* const kUsed = reinterpret_cast<T*>(1);
 
-  explicit HazardPointerRecord(const Variable<T>& owner) : owner(owner) {}
+  explicit HazardPointerRecord(const Variable<T, RcuTraits>& owner)
+      : owner(owner) {}
+
+  HazardPointerRecord(const Variable<T, RcuTraits>& owner, std::nullptr_t)
+      : ptr(nullptr), owner(owner) {}
 
   std::atomic<T*> ptr = kUsed;
-  const Variable<T>& owner;
+  const Variable<T, RcuTraits>& owner;
   std::atomic<HazardPointerRecord*> next{nullptr};
 
   // Simple operation that marks this hazard pointer as no longer used.
   void Release() { ptr = nullptr; }
 };
 
-template <typename T>
+template <typename T, typename RcuTraits>
 struct CachedData {
-  impl::HazardPointerRecord<T>* hp{nullptr};
-  const Variable<T>* variable{nullptr};
+  impl::HazardPointerRecord<T, RcuTraits>* hp{nullptr};
+  const Variable<T, RcuTraits>* variable{nullptr};
   // ensures that `variable` points to the instance that filled the cache
   uint64_t variable_epoch{0};
 };
 
-template <typename T>
-thread_local CachedData<T> cache;
+template <typename T, typename RcuTraits>
+thread_local CachedData<T, RcuTraits> cache;
 
 uint64_t GetNextEpoch() noexcept;
 
+// Number of the per-CPU hazard pointers of a rcu::Variable
+std::size_t GetPerCpuHazardPointersCount() noexcept;
+
+// Index of the current thread, the threads of the same process are numbered
+// sequentially. Used to spread the readers over the per-CPU hazard pointers.
+std::size_t GetThreadIndex() noexcept;
+
 }  // namespace impl
 
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
@@ -76,10 +122,10 @@ uint64_t GetNextEpoch() noexcept;
 /// ReadablePtr references the same immutable value: if Variable's value is
 /// changed during ReadablePtr lifetime, it will not affect value referenced by
 /// ReadablePtr.
-template <typename T>
+template <typename T, typename RcuTraits>
 class USERVER_NODISCARD ReadablePtr final {
  public:
-  explicit ReadablePtr(const Variable<T>& ptr)
+  explicit ReadablePtr(const Variable<T, RcuTraits>& ptr)
       : hp_record_(&ptr.MakeHazardPointer()) {
     // This cycle guarantees that at the end of it both t_ptr_ and
     // hp_record_->ptr will both be set to
@@ -93,12 +139,12 @@ class USERVER_NODISCARD ReadablePtr final {
     } while (t_ptr_ != ptr.GetCurrent());
   }
 
-  ReadablePtr(ReadablePtr<T>&& other) noexcept
+  ReadablePtr(ReadablePtr&& other) noexcept
       : t_ptr_(other.t_ptr_), hp_record_(other.hp_record_) {
     other.t_ptr_ = nullptr;
   }
 
-  ReadablePtr& operator=(ReadablePtr<T>&& other) noexcept {
+  ReadablePtr& operator=(ReadablePtr&& other) noexcept {
     // What do we have here?
     // 1. 'other' may point to the same variable - or to a different one.
     // 2. therefore, its hazard pointer may belong to the same list,
@@ -141,11 +187,11 @@ class USERVER_NODISCARD ReadablePtr final {
     return *this;
   }
 
-  ReadablePtr(const ReadablePtr<T>& other)
+  ReadablePtr(const ReadablePtr& other)
       : ReadablePtr(other.hp_record_->owner) {}
 
-  ReadablePtr& operator=(const ReadablePtr<T>& other) {
-    if (this != &other) *this = ReadablePtr<T>{other};
+  ReadablePtr& operator=(const ReadablePtr& other) {
+    if (this != &other) *this = ReadablePtr{other};
     return *this;
   }
 
@@ -183,7 +229,7 @@ class USERVER_NODISCARD ReadablePtr final {
   // Invariant is this: if t_ptr_ is not nullptr, then hp_record_ is also
   // not nullptr and points to hazard pointer containing same T*.
   // Thus, if t_ptr_ is nullptr, then hp_record_ is undefined.
-  impl::HazardPointerRecord<T>* hp_record_;
+  impl::HazardPointerRecord<T, RcuTraits>* hp_record_;
 };
 
 /// Smart pointer for rcu::Variable<T> for changing RCU value. It stores a
@@ -196,11 +242,11 @@ class USERVER_NODISCARD ReadablePtr final {
 /// @note you may not pass WritablePtr between coroutines as it owns
 /// engine::Mutex, which must be unlocked in the same coroutine that was used to
 /// lock the mutex.
-template <typename T>
+template <typename T, typename RcuTraits>
 class USERVER_NODISCARD WritablePtr final {
  public:
   /// For internal use only. Use `var.StartWrite()` instead
-  explicit WritablePtr(Variable<T>& var)
+  explicit WritablePtr(Variable<T, RcuTraits>& var)
       : var_(var),
         lock_(var.mutex_),
         ptr_(std::make_unique<T>(*var_.GetCurrent())) {
@@ -209,7 +255,8 @@ class USERVER_NODISCARD WritablePtr final {
 
   /// For internal use only. Use `var.Emplace(args...)` instead
   template <typename... Args>
-  WritablePtr(Variable<T>& var, std::in_place_t, Args&&... initial_value_args)
+  WritablePtr(Variable<T, RcuTraits>& var, std::in_place_t,
+              Args&&... initial_value_args)
       : var_(var),
         lock_(var.mutex_),
         ptr_(std::make_unique<T>(std::forward<Args>(initial_value_args)...)) {
@@ -217,7 +264,7 @@ class USERVER_NODISCARD WritablePtr final {
                 << " with custom initial value";
   }
 
-  WritablePtr(WritablePtr<T>&& other) noexcept
+  WritablePtr(WritablePtr&& other) noexcept
       : var_(other.var_),
         lock_(std::move(other.lock_)),
         ptr_(std::move(other.ptr_)) {
@@ -262,7 +309,7 @@ class USERVER_NODISCARD WritablePtr final {
     std::abort();
   }
 
-  Variable<T>& var_;
+  Variable<T, RcuTraits>& var_;
   std::unique_lock<engine::Mutex> lock_;
   std::unique_ptr<T> ptr_;
 };
@@ -288,6 +335,9 @@ enum class DestructionType { kSync, kAsync };
 /// be eventually freed when a subsequent writer identifies that nobody works
 /// with this version.
 ///
+/// The hazard pointer layout and the reclamation of old values are customized
+/// by `RcuTraits`, see rcu::DefaultRcuTraits and rcu::ReadScalableRcuTraits.
+///
 /// @note There is no way to create a "null" `Variable`.
 ///
 /// ## Example usage:
@@ -295,8 +345,10 @@ enum class DestructionType { kSync, kAsync };
 /// @snippet rcu/rcu_test.cpp  Sample rcu::Variable usage
 ///
 /// @see @ref md_en_userver_synchronization
-template <typename T>
+template <typename T, typename RcuTraits>
 class Variable final {
+  using HazardPointerRecord = impl::HazardPointerRecord<T, RcuTraits>;
+
  public:
   /// Create a new `Variable` with an in-place constructed initial value.
   /// Asynchronous destruction is enabled by default.
@@ -309,7 +361,9 @@ class Variable final {
                               ? DestructionType::kSync
                               : DestructionType::kAsync),
         epoch_(impl::GetNextEpoch()),
-        current_(new T(std::forward<Args>(initial_value_args)...)) {}
+        current_(new T(std::forward<Args>(initial_value_args)...)) {
+    InitPerCpuHazardPointers();
+  }
 
   /// Create a new `Variable` with an in-place constructed initial value.
   /// @param destruction_type controls whether destruction of old values should
@@ -320,7 +374,9 @@ class Variable final {
   Variable(DestructionType destruction_type, Args&&... initial_value_args)
       : destruction_type_(destruction_type),
         epoch_(impl::GetNextEpoch()),
-        current_(new T(std::forward<Args>(initial_value_args)...)) {}
+        current_(new T(std::forward<Args>(initial_value_args)...)) {
+    InitPerCpuHazardPointers();
+  }
 
   Variable(const Variable&) = delete;
   Variable(Variable&&) = delete;
@@ -330,6 +386,17 @@ class Variable final {
   ~Variable() {
     delete current_.load();
 
+    if (per_cpu_hp_records_) {
+      const auto count = GetPerCpuHazardPointersCount();
+      for (std::size_t i = 0; i < count; ++i) {
+        UASSERT_MSG(per_cpu_hp_records_[i].ptr == nullptr,
+                    "RCU variable is destroyed while being used");
+        per_cpu_hp_records_[i].~HazardPointerRecord();
+      }
+      std::allocator<HazardPointerRecord>{}.deallocate(per_cpu_hp_records_,
+                                                       count);
+    }
+
     auto* hp = hp_record_head_.load();
     while (hp) {
       auto* next = hp->next.load();
@@ -339,6 +406,9 @@ class Variable final {
       hp = next;
     }
 
+    // Retired values are not used by anyone at this point
+    retire_list_.clear();
+
     // Make sure all data is deleted after return from dtr
     if (destruction_type_ == DestructionType::kAsync) {
       wait_token_storage_.WaitForAllTokens();
@@ -346,7 +416,9 @@ class Variable final {
   }
 
   /// Obtain a smart pointer which can be used to read the current value.
-  ReadablePtr<T> Read() const { return ReadablePtr<T>(*this); }
+  ReadablePtr<T, RcuTraits> Read() const {
+    return ReadablePtr<T, RcuTraits>(*this);
+  }
 
   /// Obtain a copy of contained value.
   T ReadCopy() const {
@@ -357,26 +429,33 @@ class Variable final {
   /// Obtain a smart pointer that will *copy* the current value. The pointer can
   /// be used to make changes to the value and to set the `Variable` to the
   /// changed value.
-  WritablePtr<T> StartWrite() { return WritablePtr<T>(*this); }
+  WritablePtr<T, RcuTraits> StartWrite() {
+    return WritablePtr<T, RcuTraits>(*this);
+  }
 
   /// Obtain a smart pointer to a newly in-place constructed value, but does
   /// not replace the current one yet (in contrast with regular `Emplace`).
   template <typename... Args>
-  WritablePtr<T> StartWriteEmplace(Args&&... args) {
-    return WritablePtr<T>(*this, std::in_place, std::forward<Args>(args)...);
+  WritablePtr<T, RcuTraits> StartWriteEmplace(Args&&... args) {
+    return WritablePtr<T, RcuTraits>(*this, std::in_place,
+                                     std::forward<Args>(args)...);
   }
 
   /// Replaces the `Variable`'s value with the provided one.
   void Assign(T new_value) {
-    WritablePtr<T>(*this, std::in_place, std::move(new_value)).Commit();
+    WritablePtr<T, RcuTraits>(*this, std::in_place, std::move(new_value))
+        .Commit();
   }
 
   /// Replaces the `Variable`'s value with an in-place constructed one.
   template <typename... Args>
   void Emplace(Args&&... args) {
-    WritablePtr<T>(*this, std::in_place, std::forward<Args>(args)...).Commit();
+    WritablePtr<T, RcuTraits>(*this, std::in_place, std::forward<Args>(args)...)
+        .Commit();
   }
 
+  /// Destroys the old values that are not used by readers anymore, including
+  /// the ones that wait for a batch to be collected.
   void Cleanup() {
     std::unique_lock lock(mutex_, std::try_to_lock);
     if (!lock.owns_lock()) {
@@ -391,46 +470,76 @@ class Variable final {
  private:
   T* GetCurrent() const { return current_.load(); }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerCached() const {
-    auto& cache = impl::cache<T>;
-    auto* hp = cache.hp;
+  static std::size_t GetPerCpuHazardPointersCount() noexcept {
+    if constexpr (RcuTraits::kPerCpuHazardPointers) {
+      return impl::GetPerCpuHazardPointersCount();
+    } else {
+      return 0;
+    }
+  }
+
+  void InitPerCpuHazardPointers() {
+    if constexpr (RcuTraits::kPerCpuHazardPointers) {
+      const auto count = GetPerCpuHazardPointersCount();
+      per_cpu_hp_records_ =
+          std::allocator<HazardPointerRecord>{}.allocate(count);
+      for (std::size_t i = 0; i < count; ++i) {
+        new (per_cpu_hp_records_ + i) HazardPointerRecord(*this, nullptr);
+      }
+    }
+  }
+
+  static bool TryAcquire(HazardPointerRecord& hp) {
     T* ptr = nullptr;
+    return hp.ptr.load() == nullptr &&
+           hp.ptr.compare_exchange_strong(ptr, HazardPointerRecord::kUsed);
+  }
+
+  HazardPointerRecord* MakeHazardPointerCached() const {
+    auto& cache = impl::cache<T, RcuTraits>;
+    auto* hp = cache.hp;
     if (hp && cache.variable == this && cache.variable_epoch == epoch_) {
-      if (hp->ptr.load() == nullptr &&
-          hp->ptr.compare_exchange_strong(
-              ptr, impl::HazardPointerRecord<T>::kUsed)) {
-        return hp;
-      }
+      if (TryAcquire(*hp)) return hp;
     }
 
     return nullptr;
   }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerFast() const {
+  HazardPointerRecord* MakeHazardPointerPerCpu() const {
+    // Start from the slot of the current thread, so that the readers on
+    // different threads do not compete for the same cache lines
+    const auto count = GetPerCpuHazardPointersCount();
+    const auto start = impl::GetThreadIndex() % count;
+    for (std::size_t i = 0; i < count; ++i) {
+      auto& hp = per_cpu_hp_records_[(start + i) % count];
+      if (TryAcquire(hp)) return &hp;
+    }
+    return nullptr;
+  }
+
+  HazardPointerRecord* MakeHazardPointerFast() const {
     // Look for any hazard pointer with nullptr data ptr.
     // Mark it with kUsed (to reserve it for ourselves) and return it.
     auto* hp = hp_record_head_.load();
     while (hp) {
-      T* t_ptr = nullptr;
-      if (hp->ptr.load() == nullptr &&
-          hp->ptr.compare_exchange_strong(
-              t_ptr, impl::HazardPointerRecord<T>::kUsed)) {
-        return hp;
-      }
+      if (TryAcquire(*hp)) return hp;
 
       hp = hp->next;
     }
     return nullptr;
   }
 
-  impl::HazardPointerRecord<T>& MakeHazardPointer() const {
+  HazardPointerRecord& MakeHazardPointer() const {
     auto* hp = MakeHazardPointerCached();
     if (!hp) {
-      hp = MakeHazardPointerFast();
+      if constexpr (RcuTraits::kPerCpuHazardPointers) {
+        hp = MakeHazardPointerPerCpu();
+      }
+      if (!hp) hp = MakeHazardPointerFast();
       // all buckets are full, create a new one
       if (!hp) hp = MakeHazardPointerSlow();
 
-      auto& cache = impl::cache<T>;
+      auto& cache = impl::cache<T, RcuTraits>;
       cache.hp = hp;
       cache.variable = this;
       cache.variable_epoch = epoch_;
@@ -439,10 +548,10 @@ class Variable final {
     return *hp;
   }
 
-  impl::HazardPointerRecord<T>* MakeHazardPointerSlow() const {
+  HazardPointerRecord* MakeHazardPointerSlow() const {
     // allocate new pointer, and add it to the list (atomically)
-    auto hp = new impl::HazardPointerRecord<T>(*this);
-    impl::HazardPointerRecord<T>* old_hp = nullptr;
+    auto hp = new HazardPointerRecord(*this);
+    HazardPointerRecord* old_hp = nullptr;
     do {
       old_hp = hp_record_head_.load();
       hp->next = old_hp;
@@ -453,57 +562,64 @@ class Variable final {
   void Retire(std::unique_ptr<T> old_ptr,
               std::unique_lock<engine::Mutex>& lock) {
     LOG_TRACE() << "Retiring ptr=" << old_ptr.get();
-    auto hazard_ptrs = CollectHazardPtrs(lock);
-
-    if (hazard_ptrs.count(old_ptr.get()) > 0) {
-      // old_ptr is being used now, we may not delete it, delay deletion
-      LOG_TRACE() << "Not retire, still used ptr=" << old_ptr.get();
-      retire_list_head_.push_back(std::move(old_ptr));
-    } else {
-      LOG_TRACE() << "Retire, not used ptr=" << old_ptr.get();
-      DeleteAsync(std::move(old_ptr));
-    }
+    retire_list_.push_back(std::move(old_ptr));
+    if (retire_list_.size() < RcuTraits::kRetireBatchSize) return;
 
-    ScanRetiredList(hazard_ptrs);
+    ScanRetiredList(CollectHazardPtrs(lock));
   }
 
-  // Scan retired list and for every object that has no more hazard_ptrs
-  // pointing at it, destroy it (asynchronously)
-  void ScanRetiredList(const std::unordered_set<T*>& hazard_ptrs) {
-    for (auto rit = retire_list_head_.begin();
-         rit != retire_list_head_.end();) {
-      auto current = rit++;
-      if (hazard_ptrs.count(current->get()) == 0) {
-        // *current is not used by anyone, may delete it
-        DeleteAsync(std::move(*current));
-        retire_list_head_.erase(current);
-      }
+  // Scan retired list and destroy every object that has no more hazard_ptrs
+  // pointing at it (asynchronously, in a single batch)
+  void ScanRetiredList(const std::vector<T*>& hazard_ptrs) {
+    const auto unused_begin = std::partition(
+        retire_list_.begin(), retire_list_.end(), [&](const auto& ptr) {
+          return std::binary_search(hazard_ptrs.begin(), hazard_ptrs.end(),
+                                    ptr.get());
+        });
+    if (unused_begin == retire_list_.end()) {
+      LOG_TRACE() << "Not retire, all the retired values are still used";
+      return;
     }
+
+    std::vector<std::unique_ptr<T>> unused;
+    unused.reserve(retire_list_.end() - unused_begin);
+    std::move(unused_begin, retire_list_.end(), std::back_inserter(unused));
+    retire_list_.erase(unused_begin, retire_list_.end());
+
+    LOG_TRACE() << "Retire, not used " << unused.size() << " values";
+    DeleteAsync(std::move(unused));
   }
 
-  // Returns all T*, that have hazard ptr pointing at them. Occasionally nullptr
-  // might be in result as well.
-  std::unordered_set<T*> CollectHazardPtrs(std::unique_lock<engine::Mutex>&) {
-    std::unordered_set<T*> hazard_ptrs;
+  // Returns all T*, that have hazard ptr pointing at them, sorted.
+  // Occasionally nullptr might be in result as well.
+  std::vector<T*> CollectHazardPtrs(std::unique_lock<engine::Mutex>&) {
+    std::vector<T*> hazard_ptrs;
+    const auto per_cpu_count = GetPerCpuHazardPointersCount();
+    hazard_ptrs.reserve(per_cpu_count);
 
     // Learn all currently used hazard pointers
+    for (std::size_t i = 0; i < per_cpu_count; ++i) {
+      hazard_ptrs.push_back(per_cpu_hp_records_[i].ptr.load());
+    }
     for (auto* hp = hp_record_head_.load(); hp; hp = hp->next) {
-      hazard_ptrs.insert(hp->ptr.load());
+      hazard_ptrs.push_back(hp->ptr.load());
     }
+
+    std::sort(hazard_ptrs.begin(), hazard_ptrs.end());
     return hazard_ptrs;
   }
 
-  void DeleteAsync(std::unique_ptr<T> ptr) {
+  void DeleteAsync(std::vector<std::unique_ptr<T>> ptrs) {
     switch (destruction_type_) {
       case DestructionType::kSync:
-        ptr.reset();
+        ptrs.clear();
         break;
       case DestructionType::kAsync:
-        engine::CriticalAsyncNoSpan([ptr = std::move(ptr),
+        engine::CriticalAsyncNoSpan([ptrs = std::move(ptrs),
                                      token = wait_token_storage_
                                                  .GetToken()]() mutable {
-          // Make sure *ptr is deleted before token is destroyed
-          ptr.reset();
+          // Make sure *ptrs are deleted before token is destroyed
+          ptrs.clear();
         }).Detach();
         break;
     }
@@ -512,16 +628,20 @@ class Variable final {
   const DestructionType destruction_type_;
   const uint64_t epoch_;
 
-  mutable std::atomic<impl::HazardPointerRecord<T>*> hp_record_head_{{nullptr}};
+  // Preallocated hazard pointers, used before the ones from the list.
+  // Empty unless RcuTraits::kPerCpuHazardPointers.
+  HazardPointerRecord* per_cpu_hp_records_{nullptr};
+
+  mutable std::atomic<HazardPointerRecord*> hp_record_head_{{nullptr}};
 
-  engine::Mutex mutex_;  // for current_ changes and retire_list_head_ access
+  engine::Mutex mutex_;  // for current_ changes and retire_list_ access
   // may be read without mutex_ locked, but must be changed with held mutex_
   std::atomic<T*> current_;
-  std::list<std::unique_ptr<T>> retire_list_head_;
+  std::vector<std::unique_ptr<T>> retire_list_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 
-  friend class ReadablePtr<T>;
-  friend class WritablePtr<T>;
+  friend class ReadablePtr<T, RcuTraits>;
+  friend class WritablePtr<T, RcuTraits>;
 };
 
 }  // namespace rcu
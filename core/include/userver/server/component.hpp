@@ -61,9 +61,13 @@ namespace components {
 /// max_connections | max connections count to keep | 32768
 /// task_processor | task processor to process incomming requests | -
 /// backlog | max count of new coneections pending acceptance | 1024
-/// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
+/// connection.in_buffer_size | size of the pooled buffers for request receive, idle keep-alive connections hold no buffers: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow trottling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
+/// connection.http_version | '1.1' to serve HTTP/1.1 only, '2' to also serve HTTP/2 connections that start with the HTTP/2 connection preface (h2c with prior knowledge) | '1.1'
+/// connection.http2_session.max_concurrent_streams | max count of streams processed concurrently within a connection | 100
+/// connection.http2_session.max_frame_size | max size of a frame payload the server is willing to receive | 16 * 1024
+/// connection.http2_session.initial_window_size | initial flow control window of a stream for the data sent by client | 64 * 1024 - 1
 /// connection.request.type | type of the request, only 'http' supported at the moment | 'http'
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
 
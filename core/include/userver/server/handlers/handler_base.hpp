@@ -40,6 +40,12 @@ namespace server::handlers {
 /// decompress_request | allow decompression of the requests | false
 /// throttling_enabled | allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options | true
 /// set-response-server-hostname | set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header | <takes the value from components::Server config>
+/// response_compression.encodings | content codings to compress the responses with in the order of preference: 'gzip', 'zstd', 'br'. The coding is negotiated with the `Accept-Encoding` request header | [zstd, gzip]
+/// response_compression.min_size | do not compress responses smaller than this size, streamed responses are always compressed | 1024
+/// response_compression.gzip_level | gzip compression level, 1..9 | 6
+/// response_compression.zstd_level | zstd compression level, 1..19 | 3
+/// response_compression.brotli_level | brotli compression level, 0..11 | 4
+/// response_compression.task_processor | task processor to compress on | <the handler task processor>
 
 // clang-format on
 class HandlerBase : public components::LoggableComponentBase {
@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include <userver/server/handlers/auth/handler_auth_config.hpp>
 #include <userver/server/handlers/fallback_handlers.hpp>
@@ -19,6 +20,19 @@ enum class UrlTrailingSlashOption {
   kDefault = kBoth,
 };
 
+/// Negotiated compression of the response bodies
+struct ResponseCompressionConfig {
+  /// Content codings ("gzip", "zstd", "br") in the order of preference
+  std::vector<std::string> encodings;
+  /// Smaller responses are sent as is, the size is not known for streams
+  size_t min_size{1024};
+  int gzip_level{6};
+  int zstd_level{3};
+  int brotli_level{4};
+  /// Task processor to compress on, the handler one is used if not set
+  std::optional<std::string> task_processor;
+};
+
 struct HandlerConfig {
   std::variant<std::string, FallbackHandler> path;
   std::string task_processor;
@@ -36,9 +50,13 @@ struct HandlerConfig {
   bool decompress_request{false};
   bool throttling_enabled{true};
   bool response_body_stream{false};
+  std::optional<ResponseCompressionConfig> response_compression;
   std::optional<bool> set_response_server_hostname;
 };
 
+ResponseCompressionConfig Parse(const yaml_config::YamlConfig& value,
+                                formats::parse::To<ResponseCompressionConfig>);
+
 HandlerConfig Parse(const yaml_config::YamlConfig& value,
                     formats::parse::To<HandlerConfig>);
 
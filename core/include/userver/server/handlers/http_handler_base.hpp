@@ -23,6 +23,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace server::http::impl {
+struct ResponseCompressionSettings;
+}  // namespace server::http::impl
+
 /// @brief Most common \ref userver_http_handlers "userver HTTP handlers"
 namespace server::handlers {
 
@@ -160,6 +164,8 @@ class HttpHandlerBase : public HandlerBase {
   bool set_response_server_hostname_;
   mutable utils::TokenBucket rate_limit_;
   bool is_body_streamed_;
+  std::unique_ptr<http::impl::ResponseCompressionSettings>
+      response_compression_;
 };
 
 }  // namespace server::handlers
@@ -24,8 +24,20 @@ namespace server::handlers {
 /// @snippet components/common_server_component_list_test.cpp  Sample handler server monitor component config
 ///
 /// ## Scheme
-/// Accepts a path argument `prefix` and pass it to
-/// utils::statistics::Storage::GetAsJson()
+/// Accepts a path argument `prefix` and returns only the metrics with paths
+/// that start with it.
+///
+/// The optional argument `format` selects the output format:
+/// Format        | Description
+/// ------------- | -----------
+/// json          | (default) JSON of utils::statistics::Storage::GetAsJson()
+/// prometheus    | Prometheus text exposition format
+/// openmetrics   | OpenMetrics text format
+/// graphite      | Graphite plaintext protocol with tags
+///
+/// All the formats except `json` are streamed via
+/// utils::statistics::Storage::VisitMetrics() without building a JSON of all
+/// the metrics.
 
 // clang-format on
 class ServerMonitor final : public HttpHandlerBase {
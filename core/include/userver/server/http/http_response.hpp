@@ -24,6 +24,8 @@ namespace impl {
 
 void OutputHeader(std::string& os, std::string_view key, std::string_view val);
 
+class Http2StreamWriter;
+
 }
 
 class HttpRequestImpl;
@@ -95,6 +97,12 @@ class HttpResponse final : public request::ResponseBase {
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::Socket& socket) override;
+
+  // Sends the response to the HTTP/2 stream of the request
+  void SendResponse(impl::Http2StreamWriter& writer);
+
+  // true for HEAD requests and 1xx/204/304 statuses
+  bool IsBodyForbidden() const;
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -148,10 +148,10 @@ class Secdist final {
 
   class Impl;
 #ifdef _LIBCPP_VERSION
-  static constexpr size_t kImplSize = 1032;
+  static constexpr size_t kImplSize = 1040;
   static constexpr size_t kImplAlign = 16;
 #else
-  static constexpr size_t kImplSize = 928;
+  static constexpr size_t kImplSize = 936;
   static constexpr size_t kImplAlign = 8;
 #endif
   utils::FastPimpl<Impl, kImplSize, kImplAlign> impl_;
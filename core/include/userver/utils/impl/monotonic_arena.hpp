@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+/// @brief Bump pointer memory arena that releases all the memory at once on
+/// destruction.
+///
+/// Allocations are served from the optional initial buffer first, then from
+/// heap blocks of growing size. Deallocation of a separate allocation is a
+/// no-op. Not thread-safe.
+class MonotonicArena final {
+ public:
+  MonotonicArena() noexcept = default;
+  MonotonicArena(void* initial_buffer, std::size_t size) noexcept;
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  ~MonotonicArena();
+
+  void* Allocate(std::size_t size, std::size_t alignment) {
+    void* ptr = current_;
+    auto space = static_cast<std::size_t>(end_ - current_);
+    if (size && std::align(alignment, size, ptr, space)) {
+      current_ = static_cast<char*>(ptr) + size;
+      return ptr;
+    }
+    return AllocateSlow(size, alignment);
+  }
+
+ private:
+  static constexpr std::size_t kMinBlockSize = 4 * 1024;
+  static constexpr std::size_t kMaxBlockSize = 64 * 1024;
+
+  struct BlockHeader {
+    BlockHeader* next;
+  };
+
+  void* AllocateSlow(std::size_t size, std::size_t alignment);
+
+  char* current_{nullptr};
+  char* end_{nullptr};
+  BlockHeader* blocks_{nullptr};
+  std::size_t next_block_size_{kMinBlockSize};
+};
+
+/// @brief Standard-compatible allocator that takes memory from a
+/// MonotonicArena, or from the heap if default constructed.
+///
+/// Copies of containers get a heap allocator, so that they may safely outlive
+/// the arena. Moved-to containers keep the arena of the source container.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  ArenaAllocator() noexcept = default;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(other.GetArena()) {}
+
+  T* allocate(std::size_t n) {
+    if (!arena_) return std::allocator<T>{}.allocate(n);
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    if (!arena_) std::allocator<T>{}.deallocate(ptr, n);
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const noexcept {
+    return {};
+  }
+
+  MonotonicArena* GetArena() const noexcept { return arena_; }
+
+ private:
+  MonotonicArena* arena_{nullptr};
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs,
+                const ArenaAllocator<U>& rhs) noexcept {
+  return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs,
+                const ArenaAllocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
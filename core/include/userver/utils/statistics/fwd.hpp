@@ -12,6 +12,7 @@ namespace utils::statistics {
 class Storage;
 class Entry;
 struct StatisticsRequest;
+class Writer;
 
 class MetricsStorage;
 using MetricsStoragePtr = std::shared_ptr<MetricsStorage>;
@@ -0,0 +1,25 @@
+#pragma once
+
+/// @file userver/utils/statistics/graphite.hpp
+/// @brief Statistics output in Graphite plaintext format
+
+#include <string>
+
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Returns the metrics of the `storage` in the Graphite plaintext
+/// format with tags: `path;label=value value timestamp`
+///
+/// The metrics are streamed from the `storage` via
+/// utils::statistics::Storage::VisitMetrics() without building a JSON of all
+/// the metrics.
+std::string ToGraphiteFormat(const Storage& storage,
+                             const StatisticsRequest& request = {});
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
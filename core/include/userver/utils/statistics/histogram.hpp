@@ -0,0 +1,224 @@
+#pragma once
+
+/// @file userver/utils/statistics/histogram.hpp
+/// @brief @copybrief utils::statistics::LogLinearHistogram
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+// Values below 2^PrecisionBits have a bucket each. Each following power of two
+// range is split into 2^(PrecisionBits - 1) buckets of the same width.
+template <std::size_t PrecisionBits, std::size_t MaxValueBits>
+struct LogLinearBuckets final {
+  static_assert(PrecisionBits >= 1 && PrecisionBits < MaxValueBits &&
+                MaxValueBits <= 63);
+
+  static constexpr std::uint64_t kLinearCount = std::uint64_t{1}
+                                                << PrecisionBits;
+  static constexpr std::uint64_t kHalfLinearCount = kLinearCount / 2;
+  static constexpr std::uint64_t kMaxValue =
+      (std::uint64_t{1} << MaxValueBits) - 1;
+  static constexpr std::size_t kCount =
+      kLinearCount + (MaxValueBits - PrecisionBits) * kHalfLinearCount;
+
+  static constexpr std::size_t ToBucket(std::uint64_t value) noexcept {
+    if (value > kMaxValue) value = kMaxValue;
+    if (value < kLinearCount) return value;
+
+    const std::size_t highest_bit = 63 - __builtin_clzll(value);
+    const std::size_t shift = highest_bit - PrecisionBits + 1;
+    const std::uint64_t mantissa = value >> shift;
+    return kLinearCount + (shift - 1) * kHalfLinearCount +
+           (mantissa - kHalfLinearCount);
+  }
+
+  // Returns the largest value of the bucket
+  static constexpr std::uint64_t ToValue(std::size_t bucket) noexcept {
+    if (bucket < kLinearCount) return bucket;
+
+    const std::size_t shift = (bucket - kLinearCount) / kHalfLinearCount + 1;
+    const std::uint64_t mantissa =
+        (bucket - kLinearCount) % kHalfLinearCount + kHalfLinearCount;
+    return ((mantissa + 1) << shift) - 1;
+  }
+};
+
+}  // namespace impl
+
+template <std::size_t PrecisionBits, std::size_t MaxValueBits>
+class ShardedHistogram;
+
+// clang-format off
+
+/// @brief Histogram with log-linear (HDR-style) buckets, calculates
+/// percentiles with a bounded relative error
+///
+/// Values below 2^PrecisionBits are accounted for precisely. Larger values
+/// fall into buckets, the width of which is proportional to the values, so the
+/// relative error of a percentile does not exceed 2^(1 - PrecisionBits), e.g.
+/// 3.1% for PrecisionBits = 6. Values of 2^MaxValueBits and more are
+/// accounted for as 2^MaxValueBits - 1. The histogram takes
+/// `(2 + MaxValueBits - PrecisionBits) * 2^(PrecisionBits - 1)` buckets,
+/// 512 buckets for `LogLinearHistogram<6, 20>` that covers values up to 10^6
+/// (more than 17 minutes in milliseconds).
+///
+/// The histogram is not thread-safe, it is the result of the aggregation of
+/// utils::statistics::ShardedHistogram, which is updated concurrently. It is a
+/// drop-in replacement for utils::statistics::Percentile for latencies.
+///
+/// ## Example usage:
+///
+/// @snippet core/src/utils/statistics/histogram_test.cpp  LogLinearHistogram sample
+///
+/// @tparam PrecisionBits the number of precise bits in the bucket boundaries
+/// @tparam MaxValueBits the number of bits of the maximum accounted value
+
+// clang-format on
+template <std::size_t PrecisionBits, std::size_t MaxValueBits>
+class LogLinearHistogram final {
+ public:
+  using Buckets = impl::LogLinearBuckets<PrecisionBits, MaxValueBits>;
+
+  /// @brief Account for another value
+  void Account(std::uint64_t value) noexcept {
+    ++buckets_[Buckets::ToBucket(value)];
+    ++count_;
+  }
+
+  /// @brief Get X percentile - the min value P so that the number of the
+  /// accounted values that are not greater than P is more than X percent
+  /// @param percent a value in [0..100]; if greater than 100, then the
+  /// largest accounted value is returned
+  /// @returns the largest value of the bucket of the percentile
+  std::uint64_t GetPercentile(double percent) const noexcept {
+    if (count_ == 0) return 0;
+
+    const auto want_sum = static_cast<double>(count_) * percent;
+    std::uint64_t sum = 0;
+    std::size_t max_bucket = 0;
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+      if (buckets_[i] == 0) continue;
+      sum += buckets_[i];
+      if (static_cast<double>(sum) * 100 > want_sum) {
+        return Buckets::ToValue(i);
+      }
+      max_bucket = i;
+    }
+    return Buckets::ToValue(max_bucket);
+  }
+
+  /// @brief Total number of the accounted values
+  std::uint64_t Count() const noexcept { return count_; }
+
+  void Add(const LogLinearHistogram& other) noexcept {
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+      buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+  }
+
+  LogLinearHistogram& operator+=(const LogLinearHistogram& other) noexcept {
+    Add(other);
+    return *this;
+  }
+
+  /// @brief Adds the current values of a ShardedHistogram
+  LogLinearHistogram& operator+=(
+      const ShardedHistogram<PrecisionBits, MaxValueBits>& other) noexcept;
+
+  void Reset() noexcept {
+    buckets_.fill(0);
+    count_ = 0;
+  }
+
+ private:
+  std::array<std::uint64_t, Buckets::kCount> buckets_{};
+  std::uint64_t count_{0};
+};
+
+/// @brief Log-linear histogram that is updated without contention from any
+/// number of threads, the buckets are aggregated only on read
+///
+/// Each thread accounts for values in the buckets of its own shard, see
+/// utils::statistics::ShardedCounter for the details on sharding. Memory for a
+/// shard is allocated on the first update from a thread of the shard. A shard
+/// takes `4 * Buckets::kCount` bytes, 2KB for `ShardedHistogram<6, 20>`, so a
+/// histogram that is updated from many threads takes up to 16 times more. The
+/// values are read by adding the histogram to a LogLinearHistogram.
+///
+/// Can be used as a Counter of utils::statistics::RecentPeriod with
+/// LogLinearHistogram as a Result:
+/// @code
+/// utils::statistics::RecentPeriod<ShardedHistogram<6, 20>,
+///                                 LogLinearHistogram<6, 20>> timings;
+/// @endcode
+template <std::size_t PrecisionBits, std::size_t MaxValueBits>
+class ShardedHistogram final {
+ public:
+  using Buckets = impl::LogLinearBuckets<PrecisionBits, MaxValueBits>;
+
+  ShardedHistogram() = default;
+
+  /// @brief Account for another value
+  void Account(std::uint64_t value) noexcept {
+    storage_.GetCurrent().buckets[Buckets::ToBucket(value)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+
+  /// @brief Clears the buckets, the concurrent updates may be lost
+  void Reset() noexcept {
+    storage_.ForEach([](Shard& shard) {
+      for (auto& bucket : shard.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    });
+  }
+
+ private:
+  friend class LogLinearHistogram<PrecisionBits, MaxValueBits>;
+
+  struct alignas(impl::kInterferenceSize) Shard final {
+    Shard() noexcept {
+      for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<std::uint32_t>, Buckets::kCount> buckets;
+  };
+
+  impl::ShardedStorage<Shard> storage_;
+};
+
+template <std::size_t PrecisionBits, std::size_t MaxValueBits>
+LogLinearHistogram<PrecisionBits, MaxValueBits>&
+LogLinearHistogram<PrecisionBits, MaxValueBits>::operator+=(
+    const ShardedHistogram<PrecisionBits, MaxValueBits>& other) noexcept {
+  other.storage_.ForEach([this](const auto& shard) {
+    for (std::size_t i = 0; i < buckets_.size(); ++i) {
+      const auto value = shard.buckets[i].load(std::memory_order_relaxed);
+      buckets_[i] += value;
+      count_ += value;
+    }
+  });
+  return *this;
+}
+
+/// @brief Latencies in milliseconds, up to 17 minutes with 3.1% relative
+/// error
+using LatencyHistogram = LogLinearHistogram<6, 20>;
+
+/// @brief utils::statistics::LatencyHistogram that is updated concurrently
+using ShardedLatencyHistogram = ShardedHistogram<6, 20>;
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
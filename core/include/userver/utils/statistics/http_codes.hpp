@@ -4,7 +4,7 @@
 #include <memory>
 #include <unordered_map>
 
-#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -23,21 +23,22 @@ class HttpCodes final {
 
   void Account(CodeType code);
 
-  std::size_t Codes1xx() const { return code_1xx; }
-  std::size_t Codes2xx() const { return code_2xx; }
-  std::size_t Codes3xx() const { return code_3xx; }
-  std::size_t Codes4xx() const { return code_4xx; }
-  std::size_t Codes5xx() const { return code_5xx; }
-  std::size_t CodesOther() const { return code_other; }
+  std::size_t Codes1xx() const { return code_1xx.Load(); }
+  std::size_t Codes2xx() const { return code_2xx.Load(); }
+  std::size_t Codes3xx() const { return code_3xx.Load(); }
+  std::size_t Codes4xx() const { return code_4xx.Load(); }
+  std::size_t Codes5xx() const { return code_5xx.Load(); }
+  std::size_t CodesOther() const { return code_other.Load(); }
   std::size_t SpecialInterestCode(CodeType code) const {
-    return particular_codes.at(code);
+    return particular_codes.at(code).Load();
   }
 
   formats::json::Value FormatReplyCodes() const;
 
  private:
   using ValueType = std::uint64_t;
-  using Counter = RelaxedCounter<ValueType>;
+  // updated on every request from all the threads
+  using Counter = ShardedCounter<ValueType>;
 
   Counter code_1xx;
   Counter code_2xx;
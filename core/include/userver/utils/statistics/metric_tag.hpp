@@ -16,8 +16,15 @@ namespace utils::statistics {
 /// be thread-safe (e.g. std::atomic<T>, rcu::Variable<T>, rcu::RcuMap<T>,
 /// concurrent::Variable<T>, etc.).
 ///
-/// For custom type of `Metric` you have to define method to dump your type to
-/// JSON:
+/// For custom type of `Metric` you have to define a function to dump your
+/// type, preferably via utils::statistics::Writer, which streams the metric
+/// into any output format without building a JSON:
+///
+/// ```
+/// void DumpMetric(utils::statistics::Writer& writer, const Metric& m);
+/// ```
+///
+/// or to JSON:
 ///
 /// ```
 /// formats::json::ValueBuilder DumpMetric(const Metric& m);
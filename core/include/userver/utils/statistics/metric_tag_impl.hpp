@@ -11,7 +11,9 @@
 
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/meta.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -35,6 +37,11 @@ using HasDumpMetric = decltype(DumpMetric(std::declval<Metric&>()));
 template <typename Metric>
 using HasResetMetric = decltype(ResetMetric(std::declval<Metric&>()));
 
+// Atomics are written directly, without a `DumpMetric` for them
+template <typename Metric>
+inline constexpr bool kUseWriter =
+    kHasWriterSupport<Metric> || meta::kIsInstantiationOf<std::atomic, Metric>;
+
 template <typename Metric>
 typename std::enable_if<std::is_integral<Metric>::value,
                         formats::json::ValueBuilder>::type
@@ -59,6 +66,11 @@ class MetricWrapperBase {
 
   virtual formats::json::ValueBuilder Dump() = 0;
 
+  // Whether the metric should be dumped via DumpToWriter()
+  virtual bool HasWriterSupport() const noexcept = 0;
+
+  virtual void DumpToWriter(Writer& writer) = 0;
+
   virtual void Reset() = 0;
 };
 
@@ -67,15 +79,36 @@ class MetricWrapper final : public MetricWrapperBase {
   static_assert(std::is_default_constructible_v<Metric>,
                 "Metrics must be default-constructible");
 
-  static_assert(meta::kIsDetected<HasDumpMetric, Metric>,
-                "There is no `DumpMetric(Metric& / const Metric&)` "
+  static_assert(meta::kIsDetected<HasDumpMetric, Metric> ||
+                    kHasWriterSupport<Metric>,
+                "There is no `DumpMetric(Metric& / const Metric&)` or "
+                "`DumpMetric(utils::statistics::Writer&, const Metric&)` "
                 "in namespace of `Metric`.  "
                 "You have not provided a `DumpMetric` function overload.");
 
  public:
   MetricWrapper() : data_() { InitializeAtomic(data_); }
 
-  formats::json::ValueBuilder Dump() override { return DumpMetric(data_); }
+  formats::json::ValueBuilder Dump() override {
+    if constexpr (meta::kIsDetected<HasDumpMetric, Metric>) {
+      return DumpMetric(data_);
+    } else {
+      UASSERT_MSG(false, "The metric is only dumped via DumpToWriter()");
+      return {};
+    }
+  }
+
+  bool HasWriterSupport() const noexcept override {
+    return kUseWriter<Metric>;
+  }
+
+  void DumpToWriter(Writer& writer) override {
+    if constexpr (kUseWriter<Metric>) {
+      writer = data_;
+    } else {
+      UASSERT_MSG(false, "The metric is only dumped via Dump()");
+    }
+  }
 
   void Reset() override {
     if constexpr (meta::kIsDetected<HasResetMetric, Metric>) {
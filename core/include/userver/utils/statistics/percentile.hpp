@@ -25,6 +25,12 @@ namespace utils::statistics {
  * @tparam ExtraBucketSize ExtraBuckets store values with this precision
  * @see GetPercentile
  * @see Account
+ * @see utils::statistics::LogLinearHistogram and
+ * utils::statistics::ShardedHistogram for latencies, they cover a wide range
+ * of values with a bounded relative error and are updated without contention.
+ * Note that a ShardedHistogram takes more memory than a Percentile: up to
+ * 16 shards of 2KB for ShardedHistogram<6, 20>, while Percentile<2048> takes
+ * 8KB
  *
  * Example:
  * Precisely count for first 500 milliseconds of execution using uint32_t
@@ -0,0 +1,31 @@
+#pragma once
+
+/// @file userver/utils/statistics/prometheus.hpp
+/// @brief Statistics output in Prometheus and OpenMetrics text formats
+
+#include <string>
+
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Returns the metrics of the `storage` in the Prometheus text
+/// exposition format
+///
+/// The metrics are streamed from the `storage` via
+/// utils::statistics::Storage::VisitMetrics() without building a JSON of all
+/// the metrics. Dots and other characters that are not allowed in Prometheus
+/// names are replaced with underscores. All the metrics are gauges.
+std::string ToPrometheusFormat(const Storage& storage,
+                               const StatisticsRequest& request = {});
+
+/// @brief Returns the metrics of the `storage` in the OpenMetrics text format
+/// @see utils::statistics::ToPrometheusFormat
+std::string ToOpenMetricsFormat(const Storage& storage,
+                                const StatisticsRequest& request = {});
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
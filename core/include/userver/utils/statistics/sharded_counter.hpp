@@ -0,0 +1,165 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded_counter.hpp
+/// @brief @copybrief utils::statistics::ShardedCounter
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+// Alignment of the shards, so that the updates of different shards do not
+// invalidate the cache lines of each other
+inline constexpr std::size_t kInterferenceSize = 64;
+
+// The number of shards of the sharded statistics, a power of two
+std::size_t GetShardCount() noexcept;
+
+// The shard of the current thread, less than GetShardCount()
+std::size_t GetCurrentShardIndex() noexcept;
+
+// The shards are allocated on the first update from a thread of the shard,
+// so the statistics that are never updated take little memory
+template <typename Shard>
+class ShardedStorage final {
+ public:
+  ShardedStorage() : shards_(new std::atomic<Shard*>[GetShardCount()]) {
+    for (std::size_t i = 0; i < GetShardCount(); ++i) {
+      shards_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  ShardedStorage(ShardedStorage&&) = delete;
+  ShardedStorage& operator=(ShardedStorage&&) = delete;
+
+  ~ShardedStorage() {
+    for (std::size_t i = 0; i < GetShardCount(); ++i) {
+      delete shards_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  Shard& GetCurrent() {
+    auto& slot = shards_[GetCurrentShardIndex()];
+    auto* shard = slot.load(std::memory_order_acquire);
+    if (!shard) shard = Allocate(slot);
+    return *shard;
+  }
+
+  template <typename Func>
+  void ForEach(Func&& func) const {
+    for (std::size_t i = 0; i < GetShardCount(); ++i) {
+      if (auto* shard = shards_[i].load(std::memory_order_acquire)) {
+        func(*shard);
+      }
+    }
+  }
+
+ private:
+  static Shard* Allocate(std::atomic<Shard*>& slot) {
+    auto shard = std::make_unique<Shard>();
+    Shard* expected = nullptr;
+    if (slot.compare_exchange_strong(expected, shard.get(),
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+      return shard.release();
+    }
+    return expected;
+  }
+
+  const std::unique_ptr<std::atomic<Shard*>[]> shards_;
+};
+
+}  // namespace impl
+
+/// @brief Counter that is updated without contention from any number of
+/// threads, the value is aggregated only on read
+///
+/// Each thread updates a counter of its own shard in a separate cache line, so
+/// the updates from different threads do not invalidate the caches of each
+/// other. Load() sums up all the shards. Prefer it over
+/// utils::statistics::RelaxedCounter for the counters that are updated on
+/// every request, and keep RelaxedCounter for rarely updated ones.
+///
+/// A shard is allocated on the first update from a thread of the shard. The
+/// number of shards depends on the number of CPUs and is at most 16.
+///
+/// Load() is not an atomic snapshot: updates that happen concurrently with it
+/// may or may not be accounted for.
+template <typename T>
+class ShardedCounter final {
+  static_assert(std::is_integral_v<T> && std::atomic<T>::is_always_lock_free);
+
+ public:
+  using ValueType = T;
+
+  ShardedCounter() = default;
+
+  void Add(T arg) noexcept {
+    storage_.GetCurrent().value.fetch_add(arg, std::memory_order_relaxed);
+  }
+
+  void Subtract(T arg) noexcept {
+    storage_.GetCurrent().value.fetch_sub(arg, std::memory_order_relaxed);
+  }
+
+  ShardedCounter& operator++() noexcept {
+    Add(1);
+    return *this;
+  }
+
+  ShardedCounter& operator--() noexcept {
+    Subtract(1);
+    return *this;
+  }
+
+  ShardedCounter& operator+=(T arg) noexcept {
+    Add(arg);
+    return *this;
+  }
+
+  ShardedCounter& operator-=(T arg) noexcept {
+    Subtract(arg);
+    return *this;
+  }
+
+  /// @brief Returns the sum of all the shards
+  T Load() const noexcept {
+    T result{};
+    storage_.ForEach([&result](const Shard& shard) {
+      result += shard.value.load(std::memory_order_relaxed);
+    });
+    return result;
+  }
+
+  /// @brief Sets the counter to zero, the concurrent updates may be lost
+  void Reset() noexcept {
+    storage_.ForEach([](Shard& shard) {
+      shard.value.store(T{}, std::memory_order_relaxed);
+    });
+  }
+
+ private:
+  struct alignas(impl::kInterferenceSize) Shard final {
+    std::atomic<T> value{T{}};
+  };
+
+  impl::ShardedStorage<Shard> storage_;
+};
+
+/// @brief utils::statistics::Writer support for ShardedCounter
+template <typename T>
+void DumpMetric(Writer& writer, const ShardedCounter<T>& counter) {
+  writer = counter.Load();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
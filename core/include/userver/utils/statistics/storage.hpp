@@ -11,6 +11,7 @@
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/utils/clang_format_workarounds.hpp>
 #include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -23,12 +24,17 @@ struct StatisticsRequest {
 using ExtenderFunc =
     std::function<formats::json::ValueBuilder(const StatisticsRequest&)>;
 
+using WriterFunc = std::function<void(Writer&)>;
+
 namespace impl {
 
 struct MetricsSource final {
   std::string prefix_path;
   std::vector<std::string> path_segments;
+  // Exactly one of `extender` and `writer` is set
   ExtenderFunc extender;
+  WriterFunc writer;
+  std::vector<Label> writer_labels;
 };
 
 using StorageData = std::list<MetricsSource>;
@@ -45,6 +51,15 @@ class Storage final {
   // Creates new Json::Value and calls every registered extender func over it.
   formats::json::ValueBuilder GetAsJson(const StatisticsRequest& request) const;
 
+  /// @brief Streams the metrics of all the registered writers and extenders
+  /// into `out` without building a JSON of all the metrics
+  ///
+  /// The JSON of an extender is converted into metrics one extender at a
+  /// time, Solomon metadata (see userver/utils/statistics/metadata.hpp) is
+  /// converted into labels.
+  void VisitMetrics(BaseFormatBuilder& out,
+                    const StatisticsRequest& request = {}) const;
+
   // Must be called from StatisticsStorage only. Don't call it from user
   // components.
   void StopRegisteringExtenders();
@@ -56,6 +71,13 @@ class Storage final {
   Entry RegisterExtender(std::initializer_list<std::string> prefix,
                          ExtenderFunc func);
 
+  /// @brief Registers a function that writes metrics via
+  /// utils::statistics::Writer
+  /// @param common_prefix the path of the root Writer, dot-separated
+  /// @param add_labels the labels added to all the written metrics
+  Entry RegisterWriter(std::string common_prefix, WriterFunc func,
+                       std::vector<Label> add_labels = {});
+
   void UnregisterExtender(impl::StorageIterator iterator) noexcept;
 
  private:
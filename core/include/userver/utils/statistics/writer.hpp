@@ -0,0 +1,220 @@
+#pragma once
+
+/// @file userver/utils/statistics/writer.hpp
+/// @brief @copybrief utils::statistics::Writer
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Non-owning name and value of a metric label
+class LabelView final {
+ public:
+  constexpr LabelView(std::string_view name, std::string_view value) noexcept
+      : name_(name), value_(value) {}
+
+  constexpr std::string_view Name() const noexcept { return name_; }
+  constexpr std::string_view Value() const noexcept { return value_; }
+
+ private:
+  std::string_view name_;
+  std::string_view value_;
+};
+
+/// @brief Name and value of a metric label
+class Label final {
+ public:
+  Label(std::string name, std::string value)
+      : name_(std::move(name)), value_(std::move(value)) {}
+
+  const std::string& Name() const noexcept { return name_; }
+  const std::string& Value() const noexcept { return value_; }
+
+  operator LabelView() const noexcept { return {name_, value_}; }
+
+ private:
+  std::string name_;
+  std::string value_;
+};
+
+/// @brief The value of a single metric
+using MetricValue = std::variant<std::int64_t, double>;
+
+/// @brief Receives the metrics written via utils::statistics::Writer,
+/// implemented by the output formats
+class BaseFormatBuilder {
+ public:
+  virtual ~BaseFormatBuilder();
+
+  /// @param path the path of the metric, the segments are separated by dots
+  /// @param labels the labels of the metric, the outer ones go first
+  virtual void HandleMetric(std::string_view path,
+                            const std::vector<LabelView>& labels,
+                            const MetricValue& value) = 0;
+};
+
+class Writer;
+
+namespace impl {
+
+struct WriterState;
+
+template <typename Metric>
+using HasWriterDumpMetric = decltype(DumpMetric(std::declval<Writer&>(),
+                                                std::declval<const Metric&>()));
+
+}  // namespace impl
+
+/// @brief Whether `DumpMetric(utils::statistics::Writer&, const Metric&)` is
+/// available for the type
+template <typename Metric>
+inline constexpr bool kHasWriterSupport =
+    meta::kIsDetected<impl::HasWriterDumpMetric, Metric>;
+
+// clang-format off
+
+/// @brief Streams metrics into an output format without building an
+/// intermediate JSON
+///
+/// The metrics are written by the functions registered via
+/// utils::statistics::Storage::RegisterWriter(). Each metric has a path and
+/// optional labels. Values are arithmetic types, `std::atomic` of them or
+/// types with a `void DumpMetric(utils::statistics::Writer&, const T&)`
+/// function in the namespace of `T`.
+///
+/// ## Example usage:
+///
+/// @snippet core/src/utils/statistics/writer_test.cpp  Writer basic sample
+///
+/// @warning Writer is only valid during the call of the function registered
+/// via utils::statistics::Storage::RegisterWriter().
+///
+/// @warning All the writers share a single path buffer, so only one child of
+/// a writer may be alive at a time, and the parent is not used while it is
+/// alive: `auto a = writer["a"]; auto b = writer["b"];` is a bug, use
+/// `writer["a"] = ...; writer["b"] = ...;` instead.
+
+// clang-format on
+class Writer final {
+ public:
+  Writer(Writer&&) = delete;
+  Writer& operator=(Writer&&) = delete;
+  ~Writer();
+
+  /// @brief Returns a writer of a child path, nested paths may be separated
+  /// by dots. The previous child must be destroyed by now.
+  [[nodiscard]] Writer operator[](std::string_view path);
+
+  /// @brief Writes the value at the current path
+  template <typename T>
+  void operator=(const T& value) {
+    Write(value);
+  }
+
+  /// @brief Writes the value at the current path with additional labels
+  template <typename T>
+  void ValueWithLabels(const T& value, std::initializer_list<LabelView> labels);
+
+  /// @overload
+  // `Labels` is deduced only from a std::vector, not from a braced list
+  template <typename T, typename Labels>
+  std::enable_if_t<std::is_same_v<Labels, std::vector<LabelView>>>
+  ValueWithLabels(const T& value, const Labels& labels);
+
+  /// @overload
+  template <typename T>
+  void ValueWithLabels(const T& value, LabelView label) {
+    ValueWithLabels(value, {label});
+  }
+
+  /// @cond
+  // For internal use only
+  explicit Writer(impl::WriterState& state) noexcept;
+  /// @endcond
+
+ private:
+  class LabelsScope final {
+   public:
+    LabelsScope(Writer& writer, const LabelView* begin, const LabelView* end);
+    LabelsScope(LabelsScope&&) = delete;
+    ~LabelsScope();
+
+   private:
+    impl::WriterState& state_;
+    const std::size_t initial_labels_size_;
+  };
+
+  Writer(impl::WriterState& state, std::string_view path);
+
+  template <typename T>
+  void Write(const T& value);
+
+  void WriteValue(std::int64_t value);
+  void WriteValue(double value);
+
+  // Checks that no child of this writer is alive
+  void AssertNoLiveChild() const noexcept;
+
+  impl::WriterState& state_;
+  const std::size_t initial_path_size_;
+  std::size_t path_size_;
+};
+
+template <typename T>
+void Writer::Write(const T& value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    WriteValue(std::int64_t{value});
+  } else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> &&
+                       sizeof(T) >= sizeof(std::int64_t)) {
+    // values over INT64_MAX lose precision instead of wrapping
+    if (value > static_cast<T>(INT64_MAX)) {
+      WriteValue(static_cast<double>(value));
+    } else {
+      WriteValue(static_cast<std::int64_t>(value));
+    }
+  } else if constexpr (std::is_integral_v<T>) {
+    WriteValue(static_cast<std::int64_t>(value));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    WriteValue(static_cast<double>(value));
+  } else if constexpr (std::is_enum_v<T>) {
+    static_assert(!sizeof(T), "Enums can not be written as metrics, cast them");
+  } else if constexpr (kHasWriterSupport<T>) {
+    DumpMetric(*this, value);
+  } else if constexpr (meta::kIsInstantiationOf<std::atomic, T>) {
+    Write(value.load(std::memory_order_relaxed));
+  } else {
+    static_assert(!sizeof(T),
+                  "There is no `DumpMetric(utils::statistics::Writer&, "
+                  "const Metric&)` in namespace of `Metric`");
+  }
+}
+
+template <typename T>
+void Writer::ValueWithLabels(const T& value,
+                             std::initializer_list<LabelView> labels) {
+  const LabelsScope scope(*this, labels.begin(), labels.end());
+  Write(value);
+}
+
+template <typename T, typename Labels>
+std::enable_if_t<std::is_same_v<Labels, std::vector<LabelView>>>
+Writer::ValueWithLabels(const T& value, const Labels& labels) {
+  const LabelsScope scope(*this, labels.data(), labels.data() + labels.size());
+  Write(value);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -89,6 +89,18 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            mmap:
+                type: boolean
+                description: Whether to read the dump via mmap, allows dump::FlatMap to use the dump in place
+                defaultDescription: false
+            parallel-tasks:
+                type: integer
+                description: the maximum number of tasks that serialize or parse the chunks of dump::WriteParallel
+                defaultDescription: 1
+            compression-level:
+                type: integer
+                description: zstd compression level of the chunks of dump::WriteParallel, 0 disables compression
+                defaultDescription: 0
             first-update-mode:
                 type: string
                 description: specifies whether required or best-effort first update will be used
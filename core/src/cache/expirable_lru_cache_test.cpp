@@ -1,8 +1,11 @@
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/mock_now.hpp>
 
@@ -272,6 +275,161 @@ UTEST(ExpirableLruCache, BackgroundUpdate) {
   EXPECT_EQ(2, cache.Get(key, UpdateNever()));
 }
 
+UTEST(ExpirableLruCache, CoalescedMisses) {
+  constexpr std::size_t kTasks = 10;
+  auto counter = std::make_shared<Counter>();
+  engine::SingleConsumerEvent update_allowed;
+
+  auto cache = CreateSimpleCache();
+  const auto update = [&](const SimpleCacheKey&) {
+    ++(*counter);
+    EXPECT_TRUE(update_allowed.WaitForEvent());
+    return 1;
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(
+        engine::AsyncNoSpan([&] { return cache.Get("key", update); }));
+  }
+  // let all the tasks miss the cache
+  engine::SleepFor(std::chrono::milliseconds(10));
+  update_allowed.Send();
+
+  for (auto& task : tasks) EXPECT_EQ(1, task.Get());
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(kTasks - 1, cache.GetStatistics().total.coalesced_misses.load());
+
+  EXPECT_EQ(1, cache.Get("key", UpdateNever()));
+}
+
+UTEST(ExpirableLruCache, CoalescedMissesException) {
+  engine::SingleConsumerEvent update_allowed;
+
+  auto cache = CreateSimpleCache();
+  const auto update = [&](const SimpleCacheKey&) -> SimpleCacheValue {
+    EXPECT_TRUE(update_allowed.WaitForEvent());
+    throw std::runtime_error("update failed");
+  };
+
+  auto first = engine::AsyncNoSpan([&] { return cache.Get("key", update); });
+  auto second = engine::AsyncNoSpan([&] { return cache.Get("key", update); });
+  engine::SleepFor(std::chrono::milliseconds(10));
+  update_allowed.Send();
+
+  UEXPECT_THROW(first.Get(), std::runtime_error);
+  UEXPECT_THROW(second.Get(), std::runtime_error);
+
+  // the failed update is not remembered
+  auto counter = std::make_shared<Counter>();
+  EXPECT_EQ(2, cache.Get("key", UpdateValue(counter, 2)));
+  EXPECT_EQ(Counter::One(), *counter);
+}
+
+UTEST(ExpirableLruCache, CoalescedMissesLeaderCancelled) {
+  constexpr std::size_t kWaiters = 3;
+  auto counter = std::make_shared<Counter>();
+  engine::SingleConsumerEvent update_started;
+  engine::SingleConsumerEvent update_never_allowed;
+  std::atomic<bool> is_first_update{true};
+
+  auto cache = CreateSimpleCache();
+  const auto update = [&](const SimpleCacheKey&) -> SimpleCacheValue {
+    ++(*counter);
+    if (is_first_update.exchange(false)) {
+      update_started.Send();
+      EXPECT_FALSE(update_never_allowed.WaitForEvent());
+      throw std::runtime_error("update cancelled");
+    }
+    return 1;
+  };
+
+  auto leader = engine::AsyncNoSpan([&] { return cache.Get("key", update); });
+  ASSERT_TRUE(update_started.WaitForEvent());
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> waiters;
+  for (std::size_t i = 0; i < kWaiters; ++i) {
+    waiters.push_back(
+        engine::AsyncNoSpan([&] { return cache.Get("key", update); }));
+  }
+  // let the waiters join the update of the leader
+  engine::SleepFor(std::chrono::milliseconds(10));
+  leader.SyncCancel();
+
+  // one of the waiters takes over the update, the others get its result
+  for (auto& task : waiters) EXPECT_EQ(1, task.Get());
+  EXPECT_EQ(Counter(2), *counter);
+}
+
+UTEST(ExpirableLruCache, StaleWhileRevalidate) {
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  cache.SetMaxLifetime(std::chrono::seconds(3));
+  cache.SetStaleWhileRevalidate(std::chrono::seconds(10));
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  utils::datetime::MockSleep(std::chrono::seconds(5));
+
+  // the stale value is returned and updated in background
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 2)));
+  EngineYield();
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(2, cache.Get(key, UpdateNever()));
+  EXPECT_EQ(1u, cache.GetStatistics().total.stale_hits.load());
+
+  // the value is too old to be returned
+  utils::datetime::MockSleep(std::chrono::seconds(20));
+  EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate(key));
+  counter->Flush();
+  EXPECT_EQ(3, cache.Get(key, UpdateValue(counter, 3)));
+  EXPECT_EQ(Counter::One(), *counter);
+}
+
+UTEST(ExpirableLruCache, EarlyRefresh) {
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  cache.SetMaxLifetime(std::chrono::seconds(10));
+  cache.SetEarlyRefreshBeta(1000);
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  const auto slow_update = [counter](const SimpleCacheKey&) {
+    ++(*counter);
+    utils::datetime::MockSleep(std::chrono::seconds(1));
+    return 2;
+  };
+
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+
+  // the update function took no time, the value is not updated early
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(1, cache.Get(key, slow_update));
+  }
+  EngineYield();
+  EXPECT_EQ(Counter::One(), *counter);
+
+  cache.InvalidateByKey(key);
+  EXPECT_EQ(2, cache.Get(key, slow_update));
+
+  // a huge beta makes an early update almost certain
+  for (int i = 0; i < 100 && cache.GetStatistics().total.early_updates == 0;
+       ++i) {
+    EXPECT_EQ(2, cache.Get(key, slow_update));
+  }
+  EngineYield();
+  EXPECT_EQ(1u, cache.GetStatistics().total.early_updates.load());
+}
+
 UTEST(ExpirableLruCache, Example) {
   /// [Sample ExpirableLruCache]
   using Key = std::string;
@@ -299,6 +457,28 @@ UTEST(ExpirableLruCache, Example) {
   /// [Sample ExpirableLruCache]
 }
 
+UTEST(ExpirableLruCache, TinyLfu) {
+  auto counter = std::make_shared<Counter>();
+
+  SimpleCache cache(1, 2, cache::EvictionPolicy::kTinyLfu);
+  cache.SetMaxLifetime(std::chrono::seconds(3));
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get("a", UpdateValue(counter, 1)));
+  EXPECT_EQ(2, cache.Get("b", UpdateValue(counter, 2)));
+  EXPECT_EQ(1, cache.Get("a", UpdateNever()));
+  EXPECT_EQ(2, cache.Get("b", UpdateNever()));
+  EXPECT_EQ(2, cache.GetSizeApproximate());
+
+  utils::datetime::MockSleep(std::chrono::seconds(4));
+  EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate("a"));
+
+  cache.InvalidateByKey("b");
+  EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate("b"));
+}
+
 UTEST(LruCacheWrapper, HitWrapper) {
   auto counter = std::make_shared<Counter>();
 
@@ -0,0 +1,129 @@
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/cache/sharded_clock_cache.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kKeys = 1 << 20;
+constexpr std::size_t kCacheSize = 1 << 16;
+constexpr std::size_t kWays = 16;
+constexpr double kZipfExponent = 0.99;
+
+// Keys of a Zipfian distribution, the key `i` is requested ~ 1 / i^s times
+class ZipfianKeys final {
+ public:
+  ZipfianKeys() : cdf_(kKeys) {
+    double sum = 0;
+    for (std::size_t i = 0; i < kKeys; ++i) {
+      sum += 1.0 / std::pow(static_cast<double>(i + 1), kZipfExponent);
+      cdf_[i] = sum;
+    }
+    for (auto& value : cdf_) value /= sum;
+  }
+
+  std::vector<std::uint64_t> Generate(std::size_t count,
+                                      std::uint64_t seed) const {
+    std::minstd_rand rng(seed);
+    std::uniform_real_distribution<double> uniform(0, 1);
+
+    std::vector<std::uint64_t> keys(count);
+    for (auto& key : keys) {
+      const auto it = std::lower_bound(cdf_.begin(), cdf_.end(), uniform(rng));
+      key = std::min<std::size_t>(it - cdf_.begin(), kKeys - 1);
+    }
+    return keys;
+  }
+
+ private:
+  std::vector<double> cdf_;
+};
+
+const ZipfianKeys& GetZipfianKeys() {
+  static const ZipfianKeys keys;
+  return keys;
+}
+
+template <typename Cache>
+bool GetOrPut(Cache& cache, std::uint64_t key) {
+  if (cache.Get(key)) return true;
+  cache.Put(key, key);
+  return false;
+}
+
+template <typename Cache>
+void CacheZipfianGetOrPut(benchmark::State& state) {
+  constexpr std::size_t kKeysPerThread = 1 << 16;
+  const std::size_t threads = state.range(0);
+
+  engine::RunStandalone(threads, [&] {
+    Cache cache(kWays, kCacheSize / kWays);
+    std::atomic<bool> keep_running{true};
+    std::atomic<std::uint64_t> total_hits{0};
+    std::atomic<std::uint64_t> total_requests{0};
+
+    const auto run = [&](std::uint64_t seed) {
+      const auto keys = GetZipfianKeys().Generate(kKeysPerThread, seed);
+      std::uint64_t hits = 0;
+      std::uint64_t requests = 0;
+      for (std::size_t i = 0; keep_running; i = (i + 1) % keys.size()) {
+        if (GetOrPut(cache, keys[i])) ++hits;
+        ++requests;
+      }
+      total_hits += hits;
+      total_requests += requests;
+    };
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) {
+      tasks.push_back(engine::AsyncNoSpan(run, i));
+    }
+
+    const auto keys = GetZipfianKeys().Generate(kKeysPerThread, 0);
+    std::size_t i = 0;
+    std::uint64_t hits = 0;
+    for (auto _ : state) {
+      if (GetOrPut(cache, keys[i])) ++hits;
+      if (++i == keys.size()) i = 0;
+    }
+
+    keep_running = false;
+    for (auto& task : tasks) task.Get();
+
+    state.counters["hit_ratio"] =
+        static_cast<double>(total_hits + hits) /
+        static_cast<double>(total_requests + state.iterations());
+  });
+}
+
+}  // namespace
+
+void nway_lru_zipfian(benchmark::State& state) {
+  CacheZipfianGetOrPut<cache::NWayLRU<std::uint64_t, std::uint64_t>>(state);
+}
+BENCHMARK(nway_lru_zipfian)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+
+void sharded_clock_zipfian(benchmark::State& state) {
+  CacheZipfianGetOrPut<cache::ShardedClockCache<std::uint64_t, std::uint64_t>>(
+      state);
+}
+BENCHMARK(sharded_clock_zipfian)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
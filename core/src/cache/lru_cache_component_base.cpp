@@ -17,6 +17,9 @@ constexpr const char* kStatisticsNameHits = "hits";
 constexpr const char* kStatisticsNameMisses = "misses";
 constexpr const char* kStatisticsNameStale = "stale";
 constexpr const char* kStatisticsNameBackground = "background-updates";
+constexpr const char* kStatisticsNameCoalescedMisses = "coalesced-misses";
+constexpr const char* kStatisticsNameStaleHits = "stale-hits";
+constexpr const char* kStatisticsNameEarlyUpdates = "early-updates";
 constexpr const char* kStatisticsNameHitRatio = "hit_ratio";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
@@ -33,6 +36,10 @@ formats::json::Value GetCacheStatisticsAsJson(
   builder[kStatisticsNameMisses] = stats.total.misses.load();
   builder[kStatisticsNameStale] = stats.total.stale.load();
   builder[kStatisticsNameBackground] = stats.total.background_updates.load();
+  builder[kStatisticsNameCoalescedMisses] =
+      stats.total.coalesced_misses.load();
+  builder[kStatisticsNameStaleHits] = stats.total.stale_hits.load();
+  builder[kStatisticsNameEarlyUpdates] = stats.total.early_updates.load();
 
   auto s1min = stats.recent.GetStatsForPeriod();
   double s1min_hits = s1min.hits.load();
@@ -74,10 +81,29 @@ properties:
         type: string
         description: TTL for cache entries (0 is unlimited)
         defaultDescription: 0
+    background-update:
+        type: boolean
+        description: update the entries in background after a half of their lifetime
+        defaultDescription: false
+    stale-while-revalidate:
+        type: string
+        description: how long after the expiration a value is still served while being updated in background
+        defaultDescription: 0
+    early-refresh-beta:
+        type: number
+        description: probabilistic early update of the values before their expiration, bigger values update earlier (0 disables)
+        defaultDescription: 0
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
         defaultDescription: true
+    eviction-policy:
+        type: string
+        description: cache engine, lru (exact LRU per way) or tinylfu (lock-free reads, CLOCK eviction and TinyLFU admission)
+        defaultDescription: lru
+        enum:
+          - lru
+          - tinylfu
 )");
 }
 
@@ -2,10 +2,13 @@
 
 #include <stdexcept>
 
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,18 +21,44 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kEvictionPolicy = "eviction-policy";
+constexpr std::string_view kStaleWhileRevalidate = "stale-while-revalidate";
+constexpr std::string_view kStaleWhileRevalidateMs =
+    "stale-while-revalidate-ms";
+constexpr std::string_view kEarlyRefreshBeta = "early-refresh-beta";
+
+void ValidateLruCacheConfig(const LruCacheConfig& config) {
+  if (config.size == 0) throw std::runtime_error("cache-size is non-positive");
+  if (config.early_refresh_beta < 0) {
+    throw std::runtime_error("early-refresh-beta is negative");
+  }
+}
 
 }  // namespace
 
 using dump::impl::ParseMs;
 
+EvictionPolicy Parse(const yaml_config::YamlConfig& config,
+                     formats::parse::To<EvictionPolicy>) {
+  const auto as_string = config.As<std::string>();
+
+  if (as_string == "lru") return EvictionPolicy::kLru;
+  if (as_string == "tinylfu") return EvictionPolicy::kTinyLfu;
+
+  throw yaml_config::ParseException(fmt::format(
+      "Invalid eviction policy '{}' at '{}'", as_string, config.GetPath()));
+}
+
 LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
     : size(config[kSize].As<std::size_t>()),
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(config[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
-  if (size == 0) throw std::runtime_error("cache-size is non-positive");
+                            : BackgroundUpdateMode::kDisabled),
+      stale_while_revalidate(
+          config[kStaleWhileRevalidate].As<std::chrono::milliseconds>(0)),
+      early_refresh_beta(config[kEarlyRefreshBeta].As<double>(0)) {
+  ValidateLruCacheConfig(*this);
 }
 
 LruCacheConfig::LruCacheConfig(const components::ComponentConfig& config)
@@ -40,8 +69,11 @@ LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(value[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
-  if (size == 0) throw std::runtime_error("cache-size is non-positive");
+                            : BackgroundUpdateMode::kDisabled),
+      stale_while_revalidate(ParseMs(value[kStaleWhileRevalidateMs],
+                                     std::chrono::milliseconds::zero())),
+      early_refresh_beta(value[kEarlyRefreshBeta].As<double>(0)) {
+  ValidateLruCacheConfig(*this);
 }
 
 std::size_t LruCacheConfig::GetWaySize(std::size_t ways) const {
@@ -58,7 +90,9 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
-      use_dynamic_config(config["config-settings"].As<bool>(true)) {
+      use_dynamic_config(config["config-settings"].As<bool>(true)),
+      eviction_policy(config[kEvictionPolicy].As<EvictionPolicy>(
+          EvictionPolicy::kLru)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
 
@@ -13,13 +13,19 @@ ExpirableLruCacheStatisticsBase::ExpirableLruCacheStatisticsBase(
     : hits(other.hits.load()),
       misses(other.misses.load()),
       stale(other.stale.load()),
-      background_updates(other.background_updates.load()) {}
+      background_updates(other.background_updates.load()),
+      coalesced_misses(other.coalesced_misses.load()),
+      stale_hits(other.stale_hits.load()),
+      early_updates(other.early_updates.load()) {}
 
 void ExpirableLruCacheStatisticsBase::Reset() {
   hits = 0;
   misses = 0;
   stale = 0;
   background_updates = 0;
+  coalesced_misses = 0;
+  stale_hits = 0;
+  early_updates = 0;
 }
 
 ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
@@ -28,6 +34,9 @@ ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
   misses += other.misses.load();
   stale += other.stale.load();
   background_updates += other.background_updates.load();
+  coalesced_misses += other.coalesced_misses.load();
+  stale_hits += other.stale_hits.load();
+  early_updates += other.early_updates.load();
   return *this;
 }
 
@@ -49,6 +58,24 @@ void CacheStale(ExpirableLruCacheStatistics& stats) {
   LOG_TRACE() << "stale cache";
 }
 
+void CacheCoalescedMiss(ExpirableLruCacheStatistics& stats) {
+  ++stats.total.coalesced_misses;
+  ++stats.recent.GetCurrentCounter().coalesced_misses;
+  LOG_TRACE() << "cache miss waits for a concurrent update";
+}
+
+void CacheStaleHit(ExpirableLruCacheStatistics& stats) {
+  ++stats.total.stale_hits;
+  ++stats.recent.GetCurrentCounter().stale_hits;
+  LOG_TRACE() << "stale cache hit, revalidating";
+}
+
+void CacheEarlyUpdate(ExpirableLruCacheStatistics& stats) {
+  ++stats.total.early_updates;
+  ++stats.recent.GetCurrentCounter().early_updates;
+  LOG_TRACE() << "early cache update";
+}
+
 }  // namespace cache::impl
 
 USERVER_NAMESPACE_END
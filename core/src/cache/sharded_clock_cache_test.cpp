@@ -0,0 +1,195 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <userver/cache/sharded_clock_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Cache = cache::ShardedClockCache<int, int>;
+
+UTEST(ShardedClockCache, Ctr) {
+  UEXPECT_NO_THROW(Cache(1, 10));
+  UEXPECT_NO_THROW(Cache(10, 10));
+  UEXPECT_THROW(Cache(0, 10), std::logic_error);
+  UEXPECT_THROW(Cache(1, 0), std::logic_error);
+}
+
+UTEST(ShardedClockCache, Set) {
+  Cache cache(1, 1);
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(1, 1);
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_EQ(1, cache.Get(1));
+
+  cache.Put(1, 10);
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_EQ(10, cache.Get(1));
+  EXPECT_EQ(10, cache.GetOr(1, -1));
+  EXPECT_EQ(-1, cache.GetOr(2, -1));
+}
+
+UTEST(ShardedClockCache, GetExpired) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(2, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_EQ(1, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(2, [](int) { return false; }).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(3, 3);
+  EXPECT_EQ(3, cache.Get(3));
+}
+
+UTEST(ShardedClockCache, ClockEviction) {
+  Cache cache(1, 3);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // 1 and 3 get a second chance, 2 is evicted
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(3, cache.Get(3));
+  EXPECT_FALSE(cache.Get(4).has_value());
+  cache.Put(4, 4);
+
+  EXPECT_EQ(3, cache.GetSize());
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(3, cache.Get(3));
+  EXPECT_EQ(4, cache.Get(4));
+}
+
+UTEST(ShardedClockCache, AdmissionProtectsHotKeys) {
+  constexpr int kHotKeys = 50;
+  constexpr int kScanKeys = 10000;
+  Cache cache(1, 64);
+
+  const auto get_or_put = [&cache](int key) {
+    if (cache.Get(key)) return true;
+    cache.Put(key, key);
+    return false;
+  };
+
+  for (int key = 0; key < kHotKeys; ++key) get_or_put(key);
+
+  // hot keys keep being requested while a scan over one-time keys goes on
+  int hot_hits = 0;
+  for (int i = 0; i < kScanKeys; ++i) {
+    get_or_put(kHotKeys + i);
+    if (get_or_put(i % kHotKeys)) ++hot_hits;
+  }
+
+  EXPECT_GT(hot_hits, kScanKeys * 9 / 10);
+}
+
+UTEST(ShardedClockCache, AdmissionAgesOnReads) {
+  constexpr int kResidentKeys = 16;
+  constexpr int kNewKey = kResidentKeys;
+  Cache cache(1, kResidentKeys);
+
+  // the counters of the resident keys saturate
+  for (int key = 0; key < kResidentKeys; ++key) cache.Put(key, key);
+  for (int round = 0; round < 100; ++round) {
+    for (int key = 0; key < kResidentKeys; ++key) cache.Get(key);
+  }
+
+  // the new key is requested more often than any resident one, but is put
+  // only once per round
+  bool is_admitted = false;
+  for (int round = 0; round < 50 && !is_admitted; ++round) {
+    for (int key = 0; key < kResidentKeys; ++key) cache.Get(key);
+    for (int i = 0; i < 3; ++i) cache.Get(kNewKey);
+    if (cache.Get(kNewKey)) {
+      is_admitted = true;
+    } else {
+      cache.Put(kNewKey, kNewKey);
+    }
+  }
+
+  EXPECT_TRUE(is_admitted);
+}
+
+UTEST(ShardedClockCache, InvalidateByKey) {
+  Cache cache(2, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  cache.InvalidateByKey(1);
+  cache.InvalidateByKey(3);
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(2, cache.Get(2));
+  EXPECT_EQ(1, cache.GetSize());
+
+  cache.Invalidate();
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(ShardedClockCache, UpdateWaySize) {
+  Cache cache(1, 10);
+  for (int key = 0; key < 10; ++key) cache.Put(key, key);
+  EXPECT_EQ(10, cache.GetSize());
+
+  cache.UpdateWaySize(3);
+  EXPECT_EQ(3, cache.GetSize());
+
+  int visited = 0;
+  cache.VisitAll([&](int key, int value) {
+    EXPECT_EQ(key, value);
+    EXPECT_EQ(value, cache.Get(key));
+    ++visited;
+  });
+  EXPECT_EQ(3, visited);
+
+  cache.UpdateWaySize(5);
+  for (int key = 10; key < 20; ++key) cache.Put(key, key);
+  EXPECT_EQ(5, cache.GetSize());
+}
+
+UTEST_MT(ShardedClockCache, ConcurrentAccess, 4) {
+  cache::ShardedClockCache<int, std::string> cache(4, 16);
+  std::atomic<bool> keep_running{true};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 3; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&, i] {
+      int key = i;
+      while (keep_running) {
+        key = (key * 7 + 1) % 100;
+        const auto value = cache.Get(key);
+        if (value) {
+          ASSERT_EQ(*value, std::to_string(key));
+        } else {
+          cache.Put(key, std::to_string(key));
+        }
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{50});
+  cache.UpdateWaySize(8);
+  engine::SleepFor(std::chrono::milliseconds{50});
+  cache.Invalidate();
+  engine::SleepFor(std::chrono::milliseconds{50});
+  keep_running = false;
+
+  for (auto& task : tasks) task.Get();
+  EXPECT_LE(cache.GetSize(), 4 * 8);
+}
+
+USERVER_NAMESPACE_END
@@ -7,7 +7,7 @@
 
 #include <userver/formats/json/value.hpp>
 #include <userver/utils/datetime.hpp>
-#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -54,11 +54,6 @@ struct MultiStats {
   }
 };
 
-using Percentile =
-    utils::statistics::Percentile</*buckets =*/2000, unsigned int,
-                                  /*extra_buckets=*/1180,
-                                  /*extra_bucket_size=*/100>;
-
 class Statistics {
  public:
   Statistics();
@@ -91,7 +86,8 @@ class Statistics {
  private:
   std::atomic<uint64_t> easy_handles_{0};
   std::atomic<uint64_t> last_time_to_start_us_{0};
-  utils::statistics::RecentPeriod<Percentile, Percentile,
+  utils::statistics::RecentPeriod<utils::statistics::ShardedLatencyHistogram,
+                                  utils::statistics::LatencyHistogram,
                                   utils::datetime::SteadyClock>
       timings_percentile_;
   std::array<std::atomic<uint64_t>, kErrorGroupCount> error_count_{
@@ -128,7 +124,7 @@ struct InstanceStatistics {
 
   uint64_t easy_handles{0};
   uint64_t last_time_to_start_us{0};
-  Percentile timings_percentile;
+  utils::statistics::LatencyHistogram timings_percentile;
   std::array<uint64_t, Statistics::kErrorGroupCount> error_count{
       {0, 0, 0, 0, 0, 0, 0}};
   std::unordered_map<int, uint64_t> reply_status;
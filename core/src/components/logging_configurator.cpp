@@ -1,6 +1,7 @@
 #include <userver/components/logging_configurator.hpp>
 
 #include <tracing/no_log_spans.hpp>
+#include <tracing/sampling.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
@@ -23,6 +24,13 @@ tracing::NoLogSpans ParseNoLogSpans(const dynamic_config::DocsMap& docs_map) {
 constexpr dynamic_config::Key<ParseNoLogSpans> kNoLogSpans{};
 /// [key]
 
+tracing::SamplingConfig ParseSampling(const dynamic_config::DocsMap& docs_map) {
+  return docs_map.Get("USERVER_TRACING_SAMPLING")
+      .As<tracing::SamplingConfig>();
+}
+
+constexpr dynamic_config::Key<ParseSampling> kSampling{};
+
 }  // namespace
 
 LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
@@ -46,6 +54,7 @@ void LoggingConfigurator::OnConfigUpdate(
     const dynamic_config::Snapshot& config) {
   (void)this;  // silence clang-tidy
   tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans{config[kNoLogSpans]});
+  tracing::impl::SetSamplingConfig(tracing::SamplingConfig{config[kSampling]});
 }
 
 yaml_config::Schema LoggingConfigurator::GetStaticConfigSchema() {
@@ -120,7 +120,7 @@ void Manager::TaskProcessorsStorage::Reset() noexcept {
     task_processor->InitiateShutdown();
   }
   LOG_TRACE() << "Waiting for all coroutines to become idle";
-  while (task_processor_pools_->GetCoroPool().GetStats().active_coroutines) {
+  while (task_processor_pools_->GetCoroPoolStats().active_coroutines) {
     std::this_thread::sleep_for(std::chrono::milliseconds{10});
   }
   LOG_TRACE() << "Stopping task processors";
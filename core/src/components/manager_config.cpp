@@ -107,6 +107,28 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            cpu-affinity:
+                type: string
+                description: >
+                    list of CPUs to pin the event threads to, in the Linux
+                    cpulist format, e.g. '0-7,16-23'
+                defaultDescription: no pinning
+            numa-node:
+                type: integer
+                description: >
+                    NUMA node to pin the event threads to; intersected with
+                    cpu-affinity if both are set
+                defaultDescription: no pinning
+            io-backend:
+                type: string
+                description: >
+                    mechanism the sockets and pipes wait for I/O with; io_uring
+                    submits the blocked operations to the kernel and falls back
+                    to libev if the kernel does not support it
+                defaultDescription: libev
+                enum:
+                  - libev
+                  - io_uring
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -142,6 +164,32 @@ properties:
                       - normal
                       - low-priority
                       - idle
+                task-queue-type:
+                    type: string
+                    description: |
+                        Type of the task queue of the task processor.
+                        `global-task-queue` is a single queue shared by all
+                        the worker threads.
+                        `work-stealing-task-queue` gives each worker thread its
+                        own queue and lets idle workers steal tasks from the
+                        busy ones.
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                cpu-affinity:
+                    type: string
+                    description: |
+                        List of CPUs to pin the worker threads to, in the Linux
+                        cpulist format, e.g. '0-7,16-23'.
+                    defaultDescription: no pinning
+                numa-node:
+                    type: integer
+                    description: |
+                        NUMA node to pin the worker threads to; intersected
+                        with `cpu-affinity` if both are set. Coroutine stacks
+                        for such task processors are allocated on that node.
+                    defaultDescription: no pinning
                 task-trace:
                     type: object
                     description: .
@@ -1,5 +1,7 @@
 #include <userver/components/manager_controller_component.hpp>
 
+#include <map>
+
 #include <components/manager_config.hpp>
 #include <components/manager_controller_component_config.hpp>
 #include <engine/task/task_processor.hpp>
@@ -57,6 +59,19 @@ formats::json::ValueBuilder GetTaskProcessorStats(
 
   json_task_processor["worker-threads"] = task_processor.GetWorkerCount();
 
+  std::map<int, std::size_t> workers_by_numa_node;
+  for (const auto numa_node : task_processor.GetWorkersNumaNodes()) {
+    if (numa_node >= 0) ++workers_by_numa_node[numa_node];
+  }
+  formats::json::ValueBuilder json_numa_nodes(formats::json::Type::kObject);
+  for (const auto& [numa_node, workers] : workers_by_numa_node) {
+    json_numa_nodes[std::to_string(numa_node)] = workers;
+  }
+  utils::statistics::SolomonChildrenAreLabelValues(json_numa_nodes,
+                                                   "numa_node");
+  json_task_processor["worker-threads-by-numa-node"] =
+      std::move(json_numa_nodes);
+
   return json_task_processor;
 }
 
@@ -111,7 +126,7 @@ formats::json::Value ManagerControllerComponent::ExtendStatistics(
   engine_data["task-processors"]["by-name"] = std::move(json_task_processors);
 
   auto coro_stats =
-      components_manager_.GetTaskProcessorPools()->GetCoroPool().GetStats();
+      components_manager_.GetTaskProcessorPools()->GetCoroPoolStats();
   {
     formats::json::ValueBuilder json_coro_pool(formats::json::Type::kObject);
 
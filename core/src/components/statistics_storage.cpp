@@ -1,5 +1,8 @@
 #include <userver/components/statistics_storage.hpp>
 
+#include <userver/components/component.hpp>
+#include <userver/components/tracer.hpp>
+#include <userver/logging/component.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -10,7 +13,26 @@ StatisticsStorage::StatisticsStorage(const ComponentConfig& config,
                                      const ComponentContext& context)
     : LoggableComponentBase(config, context),
       metrics_storage_(std::make_shared<utils::statistics::MetricsStorage>()),
-      metrics_storage_registration_(metrics_storage_->RegisterIn(storage_)) {}
+      metrics_storage_registration_(metrics_storage_->RegisterIn(storage_)) {
+  // components::Logging and components::Tracer can not register their
+  // statistics themselves, because this component depends on them. Neither
+  // is required to be present in the component list.
+  if (auto* logging_component =
+          context.FindComponentOptional<components::Logging>()) {
+    logging_statistics_holder_ = storage_.RegisterWriter(
+        "logger", [logging_component](utils::statistics::Writer& writer) {
+          logging_component->WriteStatistics(writer);
+        });
+  }
+  if (auto* tracer_component =
+          context.FindComponentOptional<components::Tracer>()) {
+    span_exporter_statistics_holder_ = storage_.RegisterWriter(
+        "tracing.span-exporter",
+        [tracer_component](utils::statistics::Writer& writer) {
+          tracer_component->WriteStatistics(writer);
+        });
+  }
+}
 
 StatisticsStorage::~StatisticsStorage() = default;
 
@@ -1,10 +1,12 @@
 #include <userver/components/tracer.hpp>
 
+#include <tracing/span_exporter.hpp>
 #include <userver/components/component.hpp>
 #include <userver/logging/component.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
 #include <userver/tracing/tracer.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -37,6 +39,26 @@ Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
   }
 
   tracing::Tracer::SetTracer(std::move(tracer));
+
+  const auto span_exporter = config["span-exporter"];
+  if (!span_exporter.IsMissing()) {
+    tracing::impl::SpanExporterConfig exporter_config;
+    exporter_config.file_path = span_exporter["file-path"].As<std::string>();
+    exporter_config.thread_buffer_size =
+        span_exporter["thread-buffer-size"].As<std::size_t>(
+            exporter_config.thread_buffer_size);
+    tracing::impl::SetSpanExporter(
+        std::make_shared<tracing::impl::SpanExporter>(exporter_config));
+    LOG_INFO() << "Spans are exported to " << exporter_config.file_path;
+  }
+}
+
+Tracer::~Tracer() { tracing::impl::SetSpanExporter({}); }
+
+void Tracer::WriteStatistics(utils::statistics::Writer& writer) const {
+  if (const auto span_exporter = tracing::impl::GetSpanExporter()) {
+    writer = span_exporter->GetStatistics();
+  }
 }
 
 yaml_config::Schema Tracer::GetStaticConfigSchema() {
@@ -52,6 +74,20 @@ properties:
         type: string
         description: type of the tracer to trace, currently supported only 'native'
         defaultDescription: 'native'
+    span-exporter:
+        type: object
+        description: |
+            write the finished spans to a file in a compact binary format
+            in the background instead of the default logger
+        additionalProperties: false
+        properties:
+            file-path:
+                type: string
+                description: path to the file or named pipe to write to
+            thread-buffer-size:
+                type: integer
+                description: size of the per-thread buffer of spans in bytes, must be a power of 2
+                defaultDescription: 262144
 )");
 }
 
@@ -0,0 +1,82 @@
+#include <compression/brotli.hpp>
+
+#include <stdexcept>
+
+#include <brotli/encode.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::brotli {
+
+namespace {
+
+// brotli windows are far bigger by default and are not needed for responses
+constexpr int kWindowBits = 18;
+
+constexpr size_t kOutputChunkSize = 16 * 1024;
+
+class BrotliCompressor final : public Compressor {
+ public:
+  explicit BrotliCompressor(int level)
+      : state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr)) {
+    UASSERT(kMinLevel <= level && level <= kMaxLevel);
+    if (!state_) {
+      throw std::runtime_error("BrotliEncoderCreateInstance() failed");
+    }
+    BrotliEncoderSetParameter(state_, BROTLI_PARAM_QUALITY, level);
+    BrotliEncoderSetParameter(state_, BROTLI_PARAM_LGWIN, kWindowBits);
+  }
+
+  ~BrotliCompressor() override { BrotliEncoderDestroyInstance(state_); }
+
+  void Compress(std::string_view data, std::string& output) override {
+    CompressStream(data, BROTLI_OPERATION_PROCESS, output);
+  }
+
+  void Flush(std::string& output) override {
+    CompressStream({}, BROTLI_OPERATION_FLUSH, output);
+  }
+
+  void Finish(std::string& output) override {
+    CompressStream({}, BROTLI_OPERATION_FINISH, output);
+  }
+
+ private:
+  void CompressStream(std::string_view data, BrotliEncoderOperation operation,
+                      std::string& output) {
+    size_t available_in = data.size();
+    const auto* next_in = reinterpret_cast<const uint8_t*>(data.data());
+
+    do {
+      const auto offset = output.size();
+      output.resize(offset + kOutputChunkSize);
+      size_t available_out = kOutputChunkSize;
+      auto* next_out = reinterpret_cast<uint8_t*>(output.data() + offset);
+
+      const auto is_ok =
+          BrotliEncoderCompressStream(state_, operation, &available_in,
+                                      &next_in, &available_out, &next_out,
+                                      nullptr);
+      output.resize(offset + kOutputChunkSize - available_out);
+      if (!is_ok) {
+        throw std::runtime_error("BrotliEncoderCompressStream() failed");
+      }
+    } while (available_in || BrotliEncoderHasMoreOutput(state_) ||
+             (operation == BROTLI_OPERATION_FINISH &&
+              !BrotliEncoderIsFinished(state_)));
+  }
+
+  BrotliEncoderState* state_;
+};
+
+}  // namespace
+
+std::unique_ptr<Compressor> MakeCompressor(int level) {
+  return std::make_unique<BrotliCompressor>(level);
+}
+
+}  // namespace compression::brotli
+
+USERVER_NAMESPACE_END
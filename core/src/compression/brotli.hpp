@@ -0,0 +1,19 @@
+#pragma once
+
+#include <memory>
+
+#include <compression/compressor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::brotli {
+
+inline constexpr int kMinLevel = 0;
+inline constexpr int kMaxLevel = 11;
+
+/// Creates a streaming compressor of brotli format
+std::unique_ptr<Compressor> MakeCompressor(int level);
+
+}  // namespace compression::brotli
+
+USERVER_NAMESPACE_END
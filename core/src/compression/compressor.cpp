@@ -0,0 +1,79 @@
+#include <compression/compressor.hpp>
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <compression/brotli.hpp>
+#include <compression/gzip.hpp>
+#include <compression/zstd.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+
+std::string_view ToString(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::kGzip:
+      return "gzip";
+    case Encoding::kZstd:
+      return "zstd";
+    case Encoding::kBrotli:
+      return "br";
+  }
+  UINVARIANT(false, "Unexpected encoding");
+}
+
+std::optional<Encoding> EncodingFromString(std::string_view name) {
+  for (const auto encoding : {Encoding::kGzip, Encoding::kZstd,
+                              Encoding::kBrotli}) {
+    if (ToString(encoding) != name) continue;
+    if (encoding == Encoding::kZstd && !zstd::IsSupported()) break;
+    return encoding;
+  }
+  return std::nullopt;
+}
+
+std::pair<int, int> GetLevelRange(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::kGzip:
+      return {gzip::kMinLevel, gzip::kMaxLevel};
+    case Encoding::kZstd:
+      return {zstd::kMinLevel, zstd::kMaxLevel};
+    case Encoding::kBrotli:
+      return {brotli::kMinLevel, brotli::kMaxLevel};
+  }
+  UINVARIANT(false, "Unexpected encoding");
+}
+
+std::unique_ptr<Compressor> MakeCompressor(Encoding encoding, int level) {
+  const auto [min_level, max_level] = GetLevelRange(encoding);
+  if (level < min_level || level > max_level) {
+    throw std::runtime_error(fmt::format(
+        "{} compression level must be in [{}, {}], got {}", ToString(encoding),
+        min_level, max_level, level));
+  }
+
+  switch (encoding) {
+    case Encoding::kGzip:
+      return gzip::MakeCompressor(level);
+    case Encoding::kZstd:
+      return zstd::MakeCompressor(level);
+    case Encoding::kBrotli:
+      return brotli::MakeCompressor(level);
+  }
+  UINVARIANT(false, "Unexpected encoding");
+}
+
+std::string Compress(Encoding encoding, std::string_view data, int level) {
+  std::string result;
+  auto compressor = MakeCompressor(encoding, level);
+  compressor->Compress(data, result);
+  compressor->Finish(result);
+  return result;
+}
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+
+/// Content codings of HTTP (RFC 9110, 8.4.1) supported for compression
+enum class Encoding {
+  kGzip,
+  kZstd,
+  kBrotli,
+};
+
+/// Name of the encoding as in `Content-Encoding` HTTP header
+std::string_view ToString(Encoding encoding);
+
+/// Parses the `Content-Encoding` token, returns nullopt for unknown codings
+/// and for the codings that are not supported by the build, see
+/// compression::zstd::IsSupported()
+std::optional<Encoding> EncodingFromString(std::string_view name);
+
+/// Min and max compression level of the encoding
+std::pair<int, int> GetLevelRange(Encoding encoding);
+
+/// @brief Streaming compressor, appends the compressed data to the output.
+///
+/// Not thread safe.
+class Compressor {
+ public:
+  virtual ~Compressor() = default;
+
+  /// Compresses the data, the output may be buffered by the compressor
+  virtual void Compress(std::string_view data, std::string& output) = 0;
+
+  /// Outputs all the data compressed so far, so that the peer could
+  /// decompress it without waiting for the rest of the stream
+  virtual void Flush(std::string& output) = 0;
+
+  /// Finishes the stream, the compressor may not be used afterwards
+  virtual void Finish(std::string& output) = 0;
+};
+
+/// @brief Creates a streaming compressor.
+/// @throws std::runtime_error on initialization failures
+std::unique_ptr<Compressor> MakeCompressor(Encoding encoding, int level);
+
+/// Compresses the whole data at once
+std::string Compress(Encoding encoding, std::string_view data, int level);
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
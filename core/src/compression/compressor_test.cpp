@@ -0,0 +1,125 @@
+#include <compression/compressor.hpp>
+
+#include <string>
+#include <vector>
+
+#include <brotli/decode.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <zstd.h>
+
+#include <compression/gzip.hpp>
+#include <compression/zstd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// zstd compression is compiled out with old versions of the library
+std::vector<compression::Encoding> GetEncodings() {
+  std::vector<compression::Encoding> result{compression::Encoding::kGzip,
+                                            compression::Encoding::kBrotli};
+  if (compression::zstd::IsSupported()) {
+    result.push_back(compression::Encoding::kZstd);
+  }
+  return result;
+}
+
+std::string MakeData(std::size_t size) {
+  std::string data;
+  data.reserve(size);
+  for (std::size_t i = 0; data.size() < size; ++i) {
+    data += R"({"id":)" + std::to_string(i * 7919 % 100003) + R"(,"ok":true})";
+  }
+  data.resize(size);
+  return data;
+}
+
+std::string Decompress(compression::Encoding encoding,
+                       std::string_view compressed) {
+  constexpr std::size_t kMaxSize = 16 * 1024 * 1024;
+  switch (encoding) {
+    case compression::Encoding::kGzip:
+      return compression::gzip::Decompress(compressed, kMaxSize);
+    case compression::Encoding::kZstd: {
+      // streamed frames do not store the content size
+      std::string result(kMaxSize, '\0');
+      const auto size = ZSTD_decompress(result.data(), result.size(),
+                                        compressed.data(), compressed.size());
+      EXPECT_FALSE(ZSTD_isError(size)) << ZSTD_getErrorName(size);
+      result.resize(ZSTD_isError(size) ? 0 : size);
+      return result;
+    }
+    case compression::Encoding::kBrotli: {
+      std::string result(kMaxSize, '\0');
+      std::size_t size = result.size();
+      EXPECT_EQ(BrotliDecoderDecompress(
+                    compressed.size(),
+                    reinterpret_cast<const uint8_t*>(compressed.data()), &size,
+                    reinterpret_cast<uint8_t*>(result.data())),
+                BROTLI_DECODER_RESULT_SUCCESS);
+      result.resize(size);
+      return result;
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+TEST(Compressor, EncodingNames) {
+  for (const auto encoding : GetEncodings()) {
+    EXPECT_EQ(compression::EncodingFromString(compression::ToString(encoding)),
+              encoding);
+  }
+  EXPECT_EQ(compression::EncodingFromString("identity"), std::nullopt);
+  EXPECT_EQ(compression::EncodingFromString("GZIP"), std::nullopt);
+}
+
+TEST(Compressor, RoundTrip) {
+  for (const auto encoding : GetEncodings()) {
+    const auto [min_level, max_level] = compression::GetLevelRange(encoding);
+    for (const auto level : {min_level, max_level}) {
+      for (const std::size_t size : {0, 1, 1000, 100 * 1000}) {
+        const auto data = MakeData(size);
+        const auto compressed = compression::Compress(encoding, data, level);
+        EXPECT_EQ(Decompress(encoding, compressed), data)
+            << compression::ToString(encoding) << ", level " << level
+            << ", size " << size;
+        if (size >= 1000) EXPECT_LT(compressed.size(), data.size());
+      }
+    }
+  }
+}
+
+TEST(Compressor, StreamWithFlushes) {
+  const auto data = MakeData(300 * 1000);
+  for (const auto encoding : GetEncodings()) {
+    auto compressor = compression::MakeCompressor(encoding, 3);
+    std::string compressed;
+    std::size_t prev_size = 0;
+    for (std::size_t pos = 0; pos < data.size(); pos += 7777) {
+      compressor->Compress(std::string_view{data}.substr(pos, 7777),
+                           compressed);
+      compressor->Flush(compressed);
+      // each flush produces output decodable without the rest of the stream
+      EXPECT_GT(compressed.size(), prev_size);
+      prev_size = compressed.size();
+    }
+    compressor->Finish(compressed);
+    EXPECT_EQ(Decompress(encoding, compressed), data)
+        << compression::ToString(encoding);
+  }
+}
+
+TEST(Compressor, InvalidLevel) {
+  for (const auto encoding : GetEncodings()) {
+    const auto [min_level, max_level] = compression::GetLevelRange(encoding);
+    EXPECT_THROW(compression::MakeCompressor(encoding, min_level - 1),
+                 std::runtime_error);
+    EXPECT_THROW(compression::MakeCompressor(encoding, max_level + 1),
+                 std::runtime_error);
+  }
+}
+
+USERVER_NAMESPACE_END
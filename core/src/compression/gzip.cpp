@@ -1,15 +1,85 @@
 #include <compression/gzip.hpp>
 
+#include <stdexcept>
+
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
+#include <fmt/format.h>
+#include <zlib.h>
+
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
 namespace {
+
 constexpr auto kDecompressBufferSize = 1024;
-}
+
+// 15 bits window with gzip header and trailer, see deflateInit2()
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+
+class GzipCompressor final : public Compressor {
+ public:
+  explicit GzipCompressor(int level) {
+    UASSERT(kMinLevel <= level && level <= kMaxLevel);
+    const auto result = deflateInit2(&stream_, level, Z_DEFLATED,
+                                     kGzipWindowBits, kMemLevel,
+                                     Z_DEFAULT_STRATEGY);
+    if (result != Z_OK) {
+      throw std::runtime_error(
+          fmt::format("deflateInit2() failed with code {}", result));
+    }
+  }
+
+  ~GzipCompressor() override { deflateEnd(&stream_); }
+
+  void Compress(std::string_view data, std::string& output) override {
+    Deflate(data, Z_NO_FLUSH, output);
+  }
+
+  void Flush(std::string& output) override {
+    Deflate({}, Z_SYNC_FLUSH, output);
+  }
+
+  void Finish(std::string& output) override { Deflate({}, Z_FINISH, output); }
+
+ private:
+  void Deflate(std::string_view data, int flush, std::string& output) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream_.avail_in = data.size();
+
+    // The output is extended until the input is consumed and everything
+    // requested by the flush mode is written
+    int result = Z_OK;
+    do {
+      const auto offset = output.size();
+      const auto capacity =
+          deflateBound(&stream_, stream_.avail_in) + kFlushMarkerSize;
+      output.resize(offset + capacity);
+      stream_.next_out = reinterpret_cast<Bytef*>(output.data() + offset);
+      stream_.avail_out = capacity;
+
+      result = deflate(&stream_, flush);
+      output.resize(offset + capacity - stream_.avail_out);
+      if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+        throw std::runtime_error(
+            fmt::format("deflate() failed with code {}", result));
+      }
+    } while (stream_.avail_in || stream_.avail_out == 0 ||
+             (flush == Z_FINISH && result != Z_STREAM_END));
+  }
+
+  // sync flush marker and gzip trailer are not accounted by deflateBound()
+  static constexpr size_t kFlushMarkerSize = 16;
+
+  z_stream stream_{};
+};
+
+}  // namespace
 
 std::string Decompress(std::string_view compressed, size_t max_size) {
   std::string decompressed;
@@ -38,6 +108,10 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
   return decompressed;
 }
 
+std::unique_ptr<Compressor> MakeCompressor(int level) {
+  return std::make_unique<GzipCompressor>(level);
+}
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
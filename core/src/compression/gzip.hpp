@@ -1,7 +1,9 @@
 #pragma once
 
+#include <memory>
 #include <string_view>
 
+#include <compression/compressor.hpp>
 #include <compression/error.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -12,6 +14,12 @@ namespace compression::gzip {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+inline constexpr int kMinLevel = 1;
+inline constexpr int kMaxLevel = 9;
+
+/// Creates a streaming compressor of gzip format
+std::unique_ptr<Compressor> MakeCompressor(int level);
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
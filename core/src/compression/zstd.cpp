@@ -0,0 +1,100 @@
+#include <compression/zstd.hpp>
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <zstd.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::zstd {
+
+// ZSTD_compressStream2() and the parameters API are stable since 1.4.0
+#if ZSTD_VERSION_NUMBER >= 10400
+
+namespace {
+
+class ZstdCompressor final : public Compressor {
+ public:
+  explicit ZstdCompressor(int level) : context_(ZSTD_createCCtx()) {
+    UASSERT(kMinLevel <= level && level <= kMaxLevel);
+    if (!context_) throw std::runtime_error("ZSTD_createCCtx() failed");
+    const auto result =
+        ZSTD_CCtx_setParameter(context_, ZSTD_c_compressionLevel, level);
+    if (ZSTD_isError(result)) {
+      ZSTD_freeCCtx(context_);
+      throw std::runtime_error(
+          fmt::format("ZSTD_CCtx_setParameter() failed: {}",
+                      ZSTD_getErrorName(result)));
+    }
+  }
+
+  ~ZstdCompressor() override { ZSTD_freeCCtx(context_); }
+
+  void Compress(std::string_view data, std::string& output) override {
+    CompressStream(data, ZSTD_e_continue, output);
+  }
+
+  void Flush(std::string& output) override {
+    CompressStream({}, ZSTD_e_flush, output);
+  }
+
+  void Finish(std::string& output) override {
+    CompressStream({}, ZSTD_e_end, output);
+  }
+
+ private:
+  void CompressStream(std::string_view data, ZSTD_EndDirective directive,
+                      std::string& output) {
+    ZSTD_inBuffer input{data.data(), data.size(), 0};
+
+    // For flush and end the remaining size is returned, 0 means done. For
+    // ZSTD_e_continue the input is consumed in full.
+    size_t remaining = 0;
+    do {
+      const auto offset = output.size();
+      const auto capacity = ZSTD_compressBound(input.size - input.pos) +
+                            ZSTD_CStreamOutSize();
+      output.resize(offset + capacity);
+      ZSTD_outBuffer out{output.data() + offset, capacity, 0};
+
+      remaining = ZSTD_compressStream2(context_, &out, &input, directive);
+      output.resize(offset + out.pos);
+      if (ZSTD_isError(remaining)) {
+        throw std::runtime_error(
+            fmt::format("ZSTD_compressStream2() failed: {}",
+                        ZSTD_getErrorName(remaining)));
+      }
+    } while (input.pos < input.size ||
+             (directive != ZSTD_e_continue && remaining != 0));
+  }
+
+  ZSTD_CCtx* context_;
+};
+
+}  // namespace
+
+bool IsSupported() noexcept { return true; }
+
+std::unique_ptr<Compressor> MakeCompressor(int level) {
+  return std::make_unique<ZstdCompressor>(level);
+}
+
+#else
+
+bool IsSupported() noexcept { return false; }
+
+std::unique_ptr<Compressor> MakeCompressor(int) {
+  throw std::runtime_error(fmt::format(
+      "zstd compression requires zstd 1.4.0 or newer, the service is built "
+      "with {}",
+      ZSTD_versionString()));
+}
+
+#endif
+
+}  // namespace compression::zstd
+
+USERVER_NAMESPACE_END
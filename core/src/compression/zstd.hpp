@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+
+#include <compression/compressor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::zstd {
+
+inline constexpr int kMinLevel = 1;
+inline constexpr int kMaxLevel = 19;
+
+/// Whether the compression is available. It needs zstd 1.4.0+ and is
+/// compiled out with older versions of the library.
+bool IsSupported() noexcept;
+
+/// Creates a streaming compressor of zstd format
+/// @throws std::runtime_error if the compression is not supported
+std::unique_ptr<Compressor> MakeCompressor(int level);
+
+}  // namespace compression::zstd
+
+USERVER_NAMESPACE_END
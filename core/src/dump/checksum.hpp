@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+/// @brief A fast non-cryptographic checksum of the dump data (XXH64)
+std::uint64_t Checksum(std::string_view data) noexcept;
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
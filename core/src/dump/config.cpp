@@ -4,6 +4,7 @@
 
 #include <fmt/format.h>
 
+#include <compression/zstd.hpp>
 #include <userver/dynamic_config/value.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +20,9 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kMapped = "mmap";
+constexpr std::string_view kParallelTasks = "parallel-tasks";
+constexpr std::string_view kCompressionLevel = "compression-level";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
@@ -67,6 +71,9 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      dump_is_mapped(config[kMapped].As<bool>(false)),
+      parallel{config[kParallelTasks].As<std::size_t>(1),
+               config[kCompressionLevel].As<int>(0)},
       dumps_enabled(config[kDumpsEnabled].As<bool>()),
       min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
@@ -78,6 +85,26 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
     throw std::logic_error(
         fmt::format("{}: {} must not be 0", this->name, kMaxDumpCount));
   }
+  if (parallel.tasks == 0) {
+    throw std::logic_error(
+        fmt::format("{}: {} must not be 0", this->name, kParallelTasks));
+  }
+  if (parallel.compression_level != 0 && !compression::zstd::IsSupported()) {
+    throw std::logic_error(
+        fmt::format("{}: {} requires zstd 1.4.0 or newer, it must be 0",
+                    this->name, kCompressionLevel));
+  }
+  if (parallel.compression_level != 0 &&
+      (parallel.compression_level < compression::zstd::kMinLevel ||
+       parallel.compression_level > compression::zstd::kMaxLevel)) {
+    throw std::logic_error(fmt::format(
+        "{}: {} must be 0 or in [{}, {}]", this->name, kCompressionLevel,
+        compression::zstd::kMinLevel, compression::zstd::kMaxLevel));
+  }
+  if (dump_is_encrypted && dump_is_mapped) {
+    throw std::logic_error(fmt::format("{}: {} and {} are mutually exclusive",
+                                       this->name, kEncrypted, kMapped));
+  }
 }
 
 Config Config::MergeWith(const ConfigPatch& patch) const {
@@ -314,6 +314,7 @@ void Dumper::Impl::DoDump(TimePoint update_time, tracing::ScopeTime& scope,
     auto dump_stats = dump_data.locator.RegisterNewDump(update_time, config);
     const auto& dump_path = dump_stats.full_path;
     auto writer = dump_data.rw_factory->CreateWriter(dump_path, scope);
+    writer->SetParallelConfig(config.parallel, &statistics_.parallel);
     dump_data.dumpable.GetAndWrite(*writer);
     writer->Finish();
     dump_size = boost::filesystem::file_size(dump_path);
@@ -442,6 +443,7 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(DumpData& dump_data,
 
           auto reader =
               dump_data.rw_factory->CreateReader(dump_stats->full_path);
+          reader->SetParallelConfig(config.parallel, &statistics_.parallel);
           dump_data.dumpable.ReadAndSet(*reader);
           reader->Finish();
 
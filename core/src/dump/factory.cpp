@@ -30,6 +30,8 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
     auto secret_key = secdist.Get<dump::Secdist>().GetSecretKey(config.name);
     return std::make_unique<dump::EncryptedOperationsFactory>(
         std::move(secret_key), dump_perms);
+  } else if (config.dump_is_mapped) {
+    return std::make_unique<dump::MappedFileOperationsFactory>(dump_perms);
   } else {
     return std::make_unique<dump::FileOperationsFactory>(dump_perms);
   }
@@ -38,6 +40,9 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(
     const Config& config) {
   auto dump_perms = GetPerms(config);
+  if (config.dump_is_mapped) {
+    return std::make_unique<dump::MappedFileOperationsFactory>(dump_perms);
+  }
   return std::make_unique<dump::FileOperationsFactory>(dump_perms);
 }
 
@@ -0,0 +1,89 @@
+#include <userver/dump/flat_map.hpp>
+
+#include <fmt/format.h>
+
+#include <dump/checksum.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+// "uflatmap" in the native byte order
+constexpr std::uint64_t kFlatMagic = 0x70616d74616c6675ULL;
+
+// Must be incremented on any change of the layout
+constexpr std::uint32_t kFlatFormatVersion = 1;
+
+std::uint64_t GetChecksum(const char* data, std::size_t size) noexcept {
+  return Checksum({data + kFlatHeaderSize, size - kFlatHeaderSize});
+}
+
+}  // namespace
+
+std::shared_ptr<char[]> AllocateFlatBuffer(std::size_t size) {
+  UASSERT(size >= kFlatHeaderSize);
+  return std::shared_ptr<char[]>(new char[size]);
+}
+
+void FinishFlatBuffer(char* data, std::size_t size, FlatHeader header) {
+  header.magic = kFlatMagic;
+  header.format_version = kFlatFormatVersion;
+  header.checksum = GetChecksum(data, size);
+  std::memcpy(data, &header, sizeof(header));
+}
+
+void WriteFlatBuffer(Writer& writer, const FlatBuffer& buffer) {
+  writer.Write(buffer.size);
+  WriteStringViewUnsafe(writer, {buffer.data.get(), buffer.size});
+}
+
+FlatBuffer ReadFlatBuffer(Reader& reader, std::uint32_t key_size,
+                          std::uint32_t value_size) {
+  const auto size = reader.Read<std::size_t>();
+  if (size < kFlatHeaderSize) {
+    throw Error(fmt::format("Flat buffer of {} bytes is too small", size));
+  }
+
+  auto data = ReadMappedUnsafe(reader, size);
+
+  FlatHeader header{};
+  std::memcpy(&header, data.get(), sizeof(header));
+
+  if (header.magic != kFlatMagic) {
+    throw Error("Flat buffer has an invalid magic number");
+  }
+  if (header.format_version != kFlatFormatVersion) {
+    throw Error(fmt::format(
+        "Flat buffer has an unsupported format version {}, expected {}",
+        header.format_version, kFlatFormatVersion));
+  }
+  if (header.key_size != key_size || header.value_size != value_size) {
+    throw Error(fmt::format(
+        "Flat buffer has entries of key-size={} value-size={}, expected "
+        "key-size={} value-size={}",
+        header.key_size, header.value_size, key_size, value_size));
+  }
+
+  const auto max_count = (size - kFlatHeaderSize) / (key_size + value_size);
+  if (header.count > max_count ||
+      header.strings_size != size - kFlatHeaderSize -
+                                 header.count * (key_size + value_size)) {
+    throw Error(fmt::format(
+        "Flat buffer size {} does not match count={} strings-size={}", size,
+        header.count, header.strings_size));
+  }
+  if (header.checksum != GetChecksum(data.get(), size)) {
+    throw Error("Flat buffer checksum mismatch");
+  }
+
+  return {std::move(data), size, static_cast<std::size_t>(header.count)};
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
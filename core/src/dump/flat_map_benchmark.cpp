@@ -0,0 +1,95 @@
+#include <userver/dump/flat_map.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::vector<std::pair<std::uint64_t, std::uint64_t>> MakeElements(
+    std::size_t count) {
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> elements;
+  elements.reserve(count);
+  for (std::uint64_t i = 0; i < count; ++i) {
+    elements.emplace_back(i * 0x9e3779b97f4a7c15, i);
+  }
+  return elements;
+}
+
+template <typename T>
+void WriteDump(const std::string& path, const T& value) {
+  tracing::Span span("dump_benchmark");
+  auto scope_time = span.CreateScopeTime("write");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  writer.Write(value);
+  writer.Finish();
+}
+
+template <typename T, typename Reader>
+void ReadDump(benchmark::State& state, const std::string& path) {
+  for (auto _ : state) {
+    Reader reader(path);
+    auto value = reader.template Read<T>();
+    reader.Finish();
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+void dump_unordered_map_read(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    using Map = std::unordered_map<std::uint64_t, std::uint64_t>;
+    const auto elements = MakeElements(state.range(0));
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+
+    WriteDump(path, Map(elements.begin(), elements.end()));
+    ReadDump<Map, dump::FileReader>(state, path);
+  });
+}
+BENCHMARK(dump_unordered_map_read)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+template <typename Reader>
+void dump_flat_map_read(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    using Map = dump::FlatMap<std::uint64_t, std::uint64_t>;
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+
+    WriteDump(path, Map(MakeElements(state.range(0))));
+    ReadDump<Map, Reader>(state, path);
+  });
+}
+BENCHMARK_TEMPLATE(dump_flat_map_read, dump::FileReader)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(dump_flat_map_read, dump::MappedFileReader)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20);
+
+void dump_flat_map_find(benchmark::State& state) {
+  const auto elements = MakeElements(state.range(0));
+  const dump::FlatMap<std::uint64_t, std::uint64_t> map(elements);
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(elements[i].first));
+    if (++i == elements.size()) i = 0;
+  }
+}
+BENCHMARK(dump_flat_map_find)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,132 @@
+#include <userver/dump/flat_map.hpp>
+
+#include <map>
+#include <string>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/test_helpers.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Point {
+  double x;
+  double y;
+};
+
+}  // namespace
+
+TEST(DumpFlatMap, Sample) {
+  /// [Sample FlatMap usage]
+  const std::map<std::string, int> source{{"b", 2}, {"a", 1}, {"c", 3}};
+  const dump::FlatMap<std::string_view, int> map(source);
+
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_EQ((*map.find("b")).second, 2);
+  EXPECT_FALSE(map.contains("d"));
+
+  // the same map after a dump write and read
+  const auto loaded =
+      dump::FromBinary<dump::FlatMap<std::string_view, int>>(
+          dump::ToBinary(map));
+  EXPECT_EQ(loaded, map);
+  /// [Sample FlatMap usage]
+}
+
+TEST(DumpFlatMap, Empty) {
+  const dump::FlatMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  dump::TestWriteReadCycle(map);
+}
+
+TEST(DumpFlatMap, SortedAndUnique) {
+  const dump::FlatMap<int, Point> map{{3, {3, 3}}, {1, {1, 1}}, {3, {0, 0}}};
+  ASSERT_EQ(map.size(), 2u);
+
+  int expected_key = 1;
+  for (const auto& [key, point] : map) {
+    EXPECT_EQ(key, expected_key);
+    EXPECT_EQ(point.x, key);
+    expected_key += 2;
+  }
+}
+
+TEST(DumpFlatMap, Lookup) {
+  std::map<std::uint64_t, std::string> source;
+  for (std::uint64_t i = 0; i < 1000; ++i) {
+    source.emplace(i * 2, std::string(i % 17, 'a' + i % 26));
+  }
+  const dump::FlatMap<std::uint64_t, std::string_view> map(source);
+  dump::TestWriteReadCycle(map);
+
+  for (std::uint64_t i = 0; i < 2000; ++i) {
+    const auto it = map.find(i);
+    if (i % 2 == 0) {
+      ASSERT_NE(it, map.end());
+      EXPECT_EQ((*it).second, source.at(i));
+    } else {
+      EXPECT_EQ(it, map.end());
+    }
+  }
+}
+
+TEST(DumpFlatMap, Corrupted) {
+  using Map = dump::FlatMap<int, int>;
+  const auto binary = dump::ToBinary(Map{{1, 1}, {2, 2}});
+
+  auto corrupted = binary;
+  corrupted.back() ^= 1;
+  EXPECT_THROW(dump::FromBinary<Map>(corrupted), dump::Error);
+
+  // another layout of the entries
+  EXPECT_THROW((dump::FromBinary<dump::FlatMap<int, std::int64_t>>(binary)),
+               dump::Error);
+
+  EXPECT_THROW(dump::FromBinary<Map>(binary.substr(0, binary.size() - 1)),
+               dump::Error);
+}
+
+UTEST(DumpFlatMap, MappedFile) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/dump";
+
+  std::map<std::string, std::string> source;
+  for (int i = 0; i < 100; ++i) {
+    source.emplace(std::to_string(i), std::string(i, 'x'));
+  }
+  using Map = dump::FlatMap<std::string_view, std::string_view>;
+
+  {
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                            scope_time);
+    writer.Write(42);
+    writer.Write(Map(source));
+    writer.Finish();
+  }
+
+  Map map;
+  {
+    dump::MappedFileReader reader(path);
+    EXPECT_EQ(reader.Read<int>(), 42);
+    map = reader.Read<Map>();
+    reader.Finish();
+  }
+
+  // the map keeps the file mapped after the reader is destroyed
+  ASSERT_EQ(map.size(), source.size());
+  for (const auto& [key, value] : source) {
+    const auto it = map.find(key);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ((*it).second, value);
+  }
+}
+
+USERVER_NAMESPACE_END
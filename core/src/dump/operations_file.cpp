@@ -1,20 +1,57 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <sys/mman.h>
+
 #include <algorithm>
 #include <stdexcept>
 #include <utility>
 
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
 namespace {
+
 constexpr std::size_t kCheckTimeAfterBytes{1 << 15};
-}
+
+class FileMapping final {
+ public:
+  explicit FileMapping(const std::string& path) {
+    auto fd =
+        fs::blocking::FileDescriptor::Open(path, fs::blocking::OpenFlag::kRead);
+    size_ = fd.GetSize();
+    if (size_ == 0) return;  // mmap fails on empty files
+
+    data_ = utils::CheckSyscallNotEquals(
+        ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd.GetNative(), 0),
+        MAP_FAILED, "mapping the file");
+    // the data is mostly read once, from the beginning to the end
+    ::madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+
+  ~FileMapping() {
+    if (data_) ::munmap(data_, size_);
+  }
+
+  const char* GetData() const { return static_cast<const char*>(data_); }
+
+  std::size_t GetSize() const { return size_; }
+
+ private:
+  void* data_{nullptr};
+  std::size_t size_{0};
+};
+
+}  // namespace
 
 FileWriter::FileWriter(std::string path, boost::filesystem::perms perms,
                        tracing::ScopeTime& scope)
@@ -115,6 +152,64 @@ void FileReader::Finish() {
   }
 }
 
+std::optional<std::size_t> FileReader::GetRemainingSize() const {
+  try {
+    return file_.GetSize() - file_.GetPosition();
+  } catch (const std::exception& ex) {
+    throw Error(
+        fmt::format("Failed to get the size of the dump file \"{}\": {}",
+                    path_, ex.what()));
+  }
+}
+
+MappedFileReader::MappedFileReader(std::string path) : path_(std::move(path)) {
+  try {
+    auto mapping = std::make_shared<const FileMapping>(path_);
+    size_ = mapping->GetSize();
+    data_ = std::shared_ptr<const char>(mapping, mapping->GetData());
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format(
+        "Failed to map the dump file for reading \"{}\". Reason: {}", path_,
+        ex.what()));
+  }
+}
+
+std::string_view MappedFileReader::ReadRaw(std::size_t max_size) {
+  const auto size = std::min(max_size, size_ - position_);
+  const std::string_view result{data_.get() + position_, size};
+  position_ += size;
+  return result;
+}
+
+std::shared_ptr<const char> MappedFileReader::ReadMappedRaw(std::size_t size) {
+  if (size > size_ - position_) {
+    throw Error(
+        fmt::format("Unexpected end-of-file while trying to read from the dump "
+                    "file \"{}\": requested-size={}, unread-size={}",
+                    path_, size, size_ - position_));
+  }
+
+  std::shared_ptr<const char> result{data_, data_.get() + position_};
+  position_ += size;
+  return result;
+}
+
+std::optional<std::size_t> MappedFileReader::GetRemainingSize() const {
+  return size_ - position_;
+}
+
+void MappedFileReader::Finish() {
+  if (position_ != size_) {
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "file-size={}, position={}, unread-size={}",
+                    path_, size_, position_, size_ - position_));
+  }
+
+  // the data read via ReadMappedRaw keeps the file mapped
+  data_.reset();
+}
+
 FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms)
     : perms_(perms) {}
 
@@ -128,6 +223,20 @@ std::unique_ptr<Writer> FileOperationsFactory::CreateWriter(
   return std::make_unique<FileWriter>(std::move(full_path), perms_, scope);
 }
 
+MappedFileOperationsFactory::MappedFileOperationsFactory(
+    boost::filesystem::perms perms)
+    : perms_(perms) {}
+
+std::unique_ptr<Reader> MappedFileOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<MappedFileReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> MappedFileOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<FileWriter>(std::move(full_path), perms_, scope);
+}
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
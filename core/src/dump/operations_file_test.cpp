@@ -113,4 +113,51 @@ TEST(DumpOperationsFile, Underread) {
   FAIL();
 }
 
+UTEST(DumpOperationsFile, MappedWriteReadRaw) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  WriteStringViewUnsafe(writer, "abc");
+  WriteStringViewUnsafe(writer, "defgh");
+  writer.Finish();
+
+  std::shared_ptr<const char> mapped;
+  {
+    dump::MappedFileReader reader(path);
+    EXPECT_EQ(ReadStringViewUnsafe(reader, 3), "abc");
+    mapped = ReadMappedUnsafe(reader, 5);
+    UEXPECT_THROW(ReadMappedUnsafe(reader, 1), dump::Error);
+    reader.Finish();
+  }
+
+  // the mapping outlives the reader
+  EXPECT_EQ(std::string_view(mapped.get(), 5), "defgh");
+}
+
+UTEST(DumpOperationsFile, MappedEmptyDump) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  writer.Finish();
+
+  dump::MappedFileReader reader(path);
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 0), "");
+  reader.Finish();
+}
+
+TEST(DumpOperationsFile, MappedUnderread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+  dump::MappedFileReader reader(file.GetPath());
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 9), std::string(9, 'a'));
+  EXPECT_THROW(reader.Finish(), dump::Error);
+}
+
 USERVER_NAMESPACE_END
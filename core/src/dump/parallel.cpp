@@ -0,0 +1,312 @@
+#include <userver/dump/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <zstd.h>
+
+#include <dump/statistics.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+// Smaller chunks make the overhead of the tasks noticeable
+constexpr std::size_t kMinChunkSize = 4096;
+
+// More chunks than tasks even out the load of the tasks
+constexpr std::size_t kChunksPerTask = 4;
+
+// Bounds the memory allocated for the chunks of a corrupted dump
+constexpr std::size_t kMaxChunkCount = 1 << 16;
+
+// Each of the chunk header fields takes at least a byte
+constexpr std::size_t kMinChunkHeaderSize = 4;
+
+enum class ChunkEncoding : std::uint8_t {
+  kRaw = 0,
+  kZstd = 1,
+};
+
+using Clock = std::chrono::steady_clock;
+
+class DurationCounter final {
+ public:
+  void Add(Clock::time_point start) noexcept {
+    total_ += (Clock::now() - start).count();
+  }
+
+  std::chrono::milliseconds Get() const noexcept {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::duration{total_.load()});
+  }
+
+ private:
+  std::atomic<Clock::duration::rep> total_{0};
+};
+
+class StringWriter final : public Writer {
+ public:
+  void Finish() override {}
+
+  std::string Extract() && { return std::move(data_); }
+
+ private:
+  void WriteRaw(std::string_view data) override { data_.append(data); }
+
+  std::string data_;
+};
+
+class StringViewReader final : public Reader {
+ public:
+  explicit StringViewReader(std::string_view data) : data_(data) {}
+
+  void Finish() override {
+    if (!data_.empty()) {
+      throw Error(fmt::format(
+          "Unexpected extra data at the end of a dump chunk: unread-size={}",
+          data_.size()));
+    }
+  }
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override {
+    const auto result = data_.substr(0, max_size);
+    data_.remove_prefix(result.size());
+    return result;
+  }
+
+  std::string_view data_;
+};
+
+struct EncodedChunk final {
+  ChunkEncoding encoding{ChunkEncoding::kRaw};
+  std::size_t raw_size{0};
+  std::string data;
+};
+
+EncodedChunk EncodeChunk(std::string&& raw, int compression_level) {
+  if (compression_level == 0) {
+    return {ChunkEncoding::kRaw, raw.size(), std::move(raw)};
+  }
+
+#if ZSTD_VERSION_NUMBER >= 10400
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(
+      ZSTD_createCCtx(), &ZSTD_freeCCtx);
+  if (!context) throw Error("ZSTD_createCCtx() failed");
+  ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel,
+                         compression_level);
+  // Detects corrupted chunks on decompression
+  ZSTD_CCtx_setParameter(context.get(), ZSTD_c_checksumFlag, 1);
+
+  std::string compressed(ZSTD_compressBound(raw.size()), '\0');
+  const auto result = ZSTD_compress2(context.get(), compressed.data(),
+                                     compressed.size(), raw.data(), raw.size());
+  if (ZSTD_isError(result)) {
+    throw Error(fmt::format("Failed to compress a dump chunk: {}",
+                            ZSTD_getErrorName(result)));
+  }
+  compressed.resize(result);
+  return {ChunkEncoding::kZstd, raw.size(), std::move(compressed)};
+#else
+  // rejected by dump::Config, see compression::zstd::IsSupported()
+  throw Error("Compression of dumps requires zstd 1.4.0 or newer");
+#endif
+}
+
+std::string DecompressChunk(std::string_view data, std::size_t raw_size) {
+  if (ZSTD_getFrameContentSize(data.data(), data.size()) != raw_size) {
+    throw Error(
+        fmt::format("Corrupted compressed dump chunk: expected-size={}",
+                    raw_size));
+  }
+
+  std::string raw(raw_size, '\0');
+  const auto result =
+      ZSTD_decompress(raw.data(), raw.size(), data.data(), data.size());
+  if (ZSTD_isError(result) || result != raw_size) {
+    throw Error(fmt::format(
+        "Failed to decompress a dump chunk: {}",
+        ZSTD_isError(result) ? ZSTD_getErrorName(result) : "size mismatch"));
+  }
+  return raw;
+}
+
+}  // namespace
+
+std::size_t GetParallelChunkCount(const Writer& writer, std::size_t size) {
+  const auto tasks = std::max<std::size_t>(writer.GetParallelConfig().tasks, 1);
+  if (tasks == 1) return 1;
+  return std::clamp<std::size_t>(
+      size / kMinChunkSize, 1,
+      std::min(tasks * kChunksPerTask, kMaxChunkCount));
+}
+
+void WriteChunks(Writer& writer, const std::vector<std::size_t>& chunk_sizes,
+                 const std::function<void(Writer&, std::size_t)>& write_chunk) {
+  const auto config = writer.GetParallelConfig();
+  const auto tasks = std::max<std::size_t>(config.tasks, 1);
+
+  std::size_t size = 0;
+  for (const auto chunk_size : chunk_sizes) size += chunk_size;
+  writer.Write(size);
+  writer.Write(chunk_sizes.size());
+
+  DurationCounter tasks_duration;
+  const auto encode_chunk = [&](std::size_t index) {
+    const auto start = Clock::now();
+    StringWriter chunk_writer;
+    write_chunk(chunk_writer, index);
+    auto chunk = EncodeChunk(std::move(chunk_writer).Extract(),
+                             config.compression_level);
+    tasks_duration.Add(start);
+    return chunk;
+  };
+
+  std::size_t raw_size = 0;
+  std::size_t compressed_size = 0;
+  const auto write_encoded = [&](std::size_t index, EncodedChunk&& chunk) {
+    writer.Write(chunk.encoding);
+    writer.Write(chunk_sizes[index]);
+    writer.Write(chunk.raw_size);
+    writer.Write(chunk.data);
+    raw_size += chunk.raw_size;
+    compressed_size += chunk.data.size();
+  };
+
+  // The chunks are encoded by up to `tasks` tasks and written in order, so
+  // that the output (and encryption) of a chunk overlaps with the encoding of
+  // the following ones
+  std::deque<engine::TaskWithResult<EncodedChunk>> in_flight;
+  std::size_t next_write = 0;
+  for (std::size_t index = 0; index < chunk_sizes.size(); ++index) {
+    if (tasks == 1) {
+      write_encoded(index, encode_chunk(index));
+      continue;
+    }
+    if (in_flight.size() == tasks) {
+      write_encoded(next_write++, in_flight.front().Get());
+      in_flight.pop_front();
+    }
+    in_flight.push_back(engine::AsyncNoSpan(
+        [&encode_chunk, index] { return encode_chunk(index); }));
+  }
+  for (auto& task : in_flight) write_encoded(next_write++, task.Get());
+
+  if (auto* statistics = writer.GetParallelStatistics()) {
+    statistics->last_write_chunks = chunk_sizes.size();
+    statistics->last_write_tasks = tasks;
+    statistics->last_write_raw_size = raw_size;
+    statistics->last_write_compressed_size = compressed_size;
+    statistics->last_write_tasks_duration = tasks_duration.Get();
+  }
+}
+
+void ReadChunks(Reader& reader, const ChunksCallbacks& callbacks) {
+  const auto tasks = std::max<std::size_t>(reader.GetParallelConfig().tasks, 1);
+
+  const auto size = reader.Read<std::size_t>();
+  const auto chunk_count = reader.Read<std::size_t>();
+  const auto remaining_size = reader.GetRemainingSize();
+  if (chunk_count > kMaxChunkCount ||
+      (remaining_size &&
+       chunk_count > *remaining_size / kMinChunkHeaderSize)) {
+    throw Error(fmt::format(
+        "Corrupted dump: chunk-count={}, max-chunk-count={}, unread-size={}",
+        chunk_count, kMaxChunkCount,
+        remaining_size ? std::to_string(*remaining_size) : "unknown"));
+  }
+  callbacks.start(size, chunk_count);
+
+  DurationCounter tasks_duration;
+  const auto decode_chunk = [&](std::size_t index, ChunkEncoding encoding,
+                                std::size_t chunk_size, std::size_t raw_size,
+                                std::string_view data) {
+    const auto start = Clock::now();
+    std::string decompressed;
+    if (encoding == ChunkEncoding::kZstd) {
+      decompressed = DecompressChunk(data, raw_size);
+      data = decompressed;
+    }
+    StringViewReader chunk_reader(data);
+    callbacks.read_chunk(chunk_reader, index, chunk_size);
+    chunk_reader.Finish();
+    tasks_duration.Add(start);
+  };
+
+  DurationCounter merge_duration;
+  const auto merge_chunk = [&](std::size_t index) {
+    const auto start = Clock::now();
+    callbacks.merge_chunk(index);
+    merge_duration.Add(start);
+  };
+
+  // The chunks are decoded by up to `tasks` tasks and merged in order, so
+  // that the merge of a chunk overlaps with the decoding of the following ones
+  std::deque<engine::TaskWithResult<void>> in_flight;
+  std::size_t next_merge = 0;
+  for (std::size_t index = 0; index < chunk_count; ++index) {
+    const auto encoding = reader.Read<ChunkEncoding>();
+    if (encoding != ChunkEncoding::kRaw && encoding != ChunkEncoding::kZstd) {
+      throw Error(fmt::format("Unknown dump chunk encoding: {}",
+                              static_cast<int>(encoding)));
+    }
+    const auto chunk_size = reader.Read<std::size_t>();
+    const auto raw_size = reader.Read<std::size_t>();
+    const auto data_size = reader.Read<std::size_t>();
+    if (const auto remaining = reader.GetRemainingSize();
+        remaining && data_size > *remaining) {
+      throw Error(fmt::format(
+          "Corrupted dump: chunk-data-size={}, unread-size={}", data_size,
+          *remaining));
+    }
+    // Used in place if the dump is memory-mapped
+    auto data = ReadMappedUnsafe(reader, data_size);
+
+    if (tasks == 1) {
+      decode_chunk(index, encoding, chunk_size, raw_size,
+                   {data.get(), data_size});
+      merge_chunk(index);
+      continue;
+    }
+    if (in_flight.size() == tasks) {
+      in_flight.front().Get();
+      in_flight.pop_front();
+      merge_chunk(next_merge++);
+    }
+    in_flight.push_back(engine::AsyncNoSpan(
+        [&decode_chunk, index, encoding, chunk_size, raw_size,
+         data = std::move(data), data_size] {
+          decode_chunk(index, encoding, chunk_size, raw_size,
+                       {data.get(), data_size});
+        }));
+  }
+  for (auto& task : in_flight) {
+    task.Get();
+    merge_chunk(next_merge++);
+  }
+
+  if (auto* statistics = reader.GetParallelStatistics()) {
+    statistics->load_chunks = chunk_count;
+    statistics->load_tasks = tasks;
+    statistics->load_tasks_duration = tasks_duration.Get();
+    statistics->load_merge_duration = merge_duration.Get();
+  }
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
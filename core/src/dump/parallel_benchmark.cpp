@@ -0,0 +1,117 @@
+#include <userver/dump/parallel.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/engine/run_standalone.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = std::unordered_map<std::uint64_t, std::string>;
+
+class StringWriter final : public dump::Writer {
+ public:
+  void Finish() override {}
+
+  std::string Extract() && { return std::move(data_); }
+
+ private:
+  void WriteRaw(std::string_view data) override { data_.append(data); }
+
+  std::string data_;
+};
+
+class StringViewReader final : public dump::Reader {
+ public:
+  explicit StringViewReader(std::string_view data) : data_(data) {}
+
+  void Finish() override {}
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override {
+    const auto result = data_.substr(0, max_size);
+    data_.remove_prefix(result.size());
+    return result;
+  }
+
+  std::string_view data_;
+};
+
+constexpr std::size_t kMapSize = 1 << 20;
+
+const Map& GetMap() {
+  static const Map map = [] {
+    Map result;
+    result.reserve(kMapSize);
+    for (std::uint64_t i = 0; i < kMapSize; ++i) {
+      result.emplace(i * 0x9e3779b97f4a7c15, std::string(32, 'a' + i % 26));
+    }
+    return result;
+  }();
+  return map;
+}
+
+}  // namespace
+
+void dump_map_read_sequential(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    StringWriter writer;
+    writer.Write(GetMap());
+    const auto data = std::move(writer).Extract();
+
+    for (auto _ : state) {
+      StringViewReader reader(data);
+      benchmark::DoNotOptimize(reader.Read<Map>());
+      reader.Finish();
+    }
+  });
+}
+BENCHMARK(dump_map_read_sequential)->UseRealTime();
+
+void dump_map_write_parallel(benchmark::State& state) {
+  const std::size_t tasks = state.range(0);
+  const int compression_level = state.range(1);
+
+  engine::RunStandalone(tasks, [&] {
+    for (auto _ : state) {
+      StringWriter writer;
+      writer.SetParallelConfig({tasks, compression_level}, nullptr);
+      dump::WriteParallel(writer, GetMap());
+      benchmark::DoNotOptimize(std::move(writer).Extract());
+    }
+  });
+}
+BENCHMARK(dump_map_write_parallel)
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {0, 1}})
+    ->UseRealTime();
+
+void dump_map_read_parallel(benchmark::State& state) {
+  const std::size_t tasks = state.range(0);
+  const int compression_level = state.range(1);
+
+  engine::RunStandalone(tasks, [&] {
+    StringWriter writer;
+    writer.SetParallelConfig({tasks, compression_level}, nullptr);
+    dump::WriteParallel(writer, GetMap());
+    const auto data = std::move(writer).Extract();
+
+    for (auto _ : state) {
+      StringViewReader reader(data);
+      reader.SetParallelConfig({tasks, 0}, nullptr);
+      benchmark::DoNotOptimize(dump::ReadParallel(reader, dump::To<Map>{}));
+      reader.Finish();
+    }
+  });
+}
+BENCHMARK(dump_map_read_parallel)
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {0, 1}})
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
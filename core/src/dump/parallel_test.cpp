@@ -0,0 +1,134 @@
+#include <userver/dump/parallel.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <compression/zstd.hpp>
+#include <dump/statistics.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/operations_mock.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename T>
+std::string WriteParallel(const T& value, dump::ParallelConfig config,
+                          dump::ParallelStatistics* statistics = nullptr) {
+  // the compression is compiled out with old versions of zstd
+  if (!compression::zstd::IsSupported()) config.compression_level = 0;
+
+  dump::MockWriter writer;
+  writer.SetParallelConfig(config, statistics);
+  dump::WriteParallel(writer, value);
+  return std::move(writer).Extract();
+}
+
+template <typename T>
+T ReadParallel(std::string data, dump::ParallelConfig config,
+               dump::ParallelStatistics* statistics = nullptr) {
+  dump::MockReader reader(std::move(data));
+  reader.SetParallelConfig(config, statistics);
+  auto result = dump::ReadParallel(reader, dump::To<T>{});
+  reader.Finish();
+  return result;
+}
+
+std::unordered_map<std::string, int> MakeMap(int size) {
+  std::unordered_map<std::string, int> result;
+  for (int i = 0; i < size; ++i) result.emplace(std::to_string(i), i);
+  return result;
+}
+
+}  // namespace
+
+UTEST_MT(DumpParallel, Vector, 4) {
+  std::vector<int> value(100'000);
+  for (int i = 0; i < 100'000; ++i) value[i] = i * 7;
+
+  for (const int compression_level : {0, 3}) {
+    const auto data = WriteParallel(value, {4, compression_level});
+    EXPECT_EQ(ReadParallel<std::vector<int>>(data, {4, 0}), value);
+    EXPECT_EQ(ReadParallel<std::vector<int>>(data, {1, 0}), value);
+  }
+}
+
+UTEST_MT(DumpParallel, NodeContainers, 4) {
+  const auto map = MakeMap(50'000);
+  const auto data = WriteParallel(map, {4, 1});
+  EXPECT_EQ((ReadParallel<std::unordered_map<std::string, int>>(data, {4, 0})),
+            map);
+
+  const std::map<std::string, int> ordered_map(map.begin(), map.end());
+  EXPECT_EQ((ReadParallel<std::map<std::string, int>>(
+                WriteParallel(ordered_map, {3, 0}), {2, 0})),
+            ordered_map);
+
+  std::set<int> set;
+  for (int i = 0; i < 30'000; ++i) set.insert(i * 3);
+  EXPECT_EQ(ReadParallel<std::set<int>>(WriteParallel(set, {4, 0}), {4, 0}),
+            set);
+}
+
+UTEST_MT(DumpParallel, SmallContainers, 2) {
+  const std::vector<std::string> empty;
+  EXPECT_EQ(ReadParallel<std::vector<std::string>>(WriteParallel(empty, {2, 1}),
+                                                   {2, 0}),
+            empty);
+
+  const std::vector<std::string> small{"a", "b", "c"};
+  EXPECT_EQ(ReadParallel<std::vector<std::string>>(WriteParallel(small, {2, 0}),
+                                                   {2, 0}),
+            small);
+}
+
+UTEST_MT(DumpParallel, Statistics, 4) {
+  if (!compression::zstd::IsSupported()) GTEST_SKIP() << "zstd is too old";
+  const auto map = MakeMap(100'000);
+
+  dump::ParallelStatistics statistics;
+  const auto data = WriteParallel(map, {4, 3}, &statistics);
+  EXPECT_EQ(statistics.last_write_chunks, 16u);
+  EXPECT_EQ(statistics.last_write_tasks, 4u);
+  EXPECT_LT(statistics.last_write_compressed_size.load(),
+            statistics.last_write_raw_size.load());
+
+  ReadParallel<std::unordered_map<std::string, int>>(data, {2, 0},
+                                                     &statistics);
+  EXPECT_EQ(statistics.load_chunks, 16u);
+  EXPECT_EQ(statistics.load_tasks, 2u);
+}
+
+UTEST_MT(DumpParallel, Corrupted, 2) {
+  if (!compression::zstd::IsSupported()) GTEST_SKIP() << "zstd is too old";
+  using Map = std::unordered_map<std::string, int>;
+  const auto data = WriteParallel(MakeMap(10'000), {2, 3});
+
+  auto corrupted = data;
+  corrupted[corrupted.size() / 2] ^= 0x55;
+  UEXPECT_THROW(ReadParallel<Map>(corrupted, {2, 0}), dump::Error);
+
+  UEXPECT_THROW(ReadParallel<Map>(data.substr(0, data.size() - 1), {2, 0}),
+                dump::Error);
+}
+
+UTEST(DumpParallel, CorruptedChunkCount) {
+  using Map = std::unordered_map<std::string, int>;
+  const auto make_header = [](std::size_t chunk_count) {
+    dump::MockWriter writer;
+    writer.Write(std::size_t{10});
+    writer.Write(chunk_count);
+    writer.Write(std::string(100, 'x'));
+    return std::move(writer).Extract();
+  };
+
+  UEXPECT_THROW(ReadParallel<Map>(make_header(std::size_t{1} << 40), {2, 0}),
+                dump::Error);
+  UEXPECT_THROW(ReadParallel<Map>(make_header(1000), {2, 0}), dump::Error);
+}
+
+USERVER_NAMESPACE_END
@@ -31,6 +31,32 @@ formats::json::Value Serialize(const Statistics& stats,
     result["last-nontrivial-write"] = write.ExtractValue();
   }
 
+  const auto& parallel = stats.parallel;
+  if (parallel.last_write_chunks.load() != 0 ||
+      parallel.load_chunks.load() != 0) {
+    formats::json::ValueBuilder parallel_write(formats::json::Type::kObject);
+    parallel_write["chunks"] = parallel.last_write_chunks.load();
+    parallel_write["tasks"] = parallel.last_write_tasks.load();
+    parallel_write["raw-size-kb"] = parallel.last_write_raw_size.load() / 1024;
+    parallel_write["compressed-size-kb"] =
+        parallel.last_write_compressed_size.load() / 1024;
+    parallel_write["tasks-duration-ms"] =
+        parallel.last_write_tasks_duration.load().count();
+
+    formats::json::ValueBuilder parallel_load(formats::json::Type::kObject);
+    parallel_load["chunks"] = parallel.load_chunks.load();
+    parallel_load["tasks"] = parallel.load_tasks.load();
+    parallel_load["tasks-duration-ms"] =
+        parallel.load_tasks_duration.load().count();
+    parallel_load["merge-duration-ms"] =
+        parallel.load_merge_duration.load().count();
+
+    formats::json::ValueBuilder parallel_stats(formats::json::Type::kObject);
+    parallel_stats["last-nontrivial-write"] = parallel_write.ExtractValue();
+    parallel_stats["load"] = parallel_load.ExtractValue();
+    result["parallel"] = parallel_stats.ExtractValue();
+  }
+
   return result.ExtractValue();
 }
 
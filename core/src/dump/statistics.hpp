@@ -11,6 +11,21 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+// Filled by dump::WriteParallel and dump::ReadParallel
+struct ParallelStatistics {
+  std::atomic<std::size_t> last_write_chunks{0};
+  std::atomic<std::size_t> last_write_tasks{0};
+  std::atomic<std::size_t> last_write_raw_size{0};
+  std::atomic<std::size_t> last_write_compressed_size{0};
+  // Summed over the tasks, compare with the wall time to see the speedup
+  std::atomic<std::chrono::milliseconds> last_write_tasks_duration{{}};
+
+  std::atomic<std::size_t> load_chunks{0};
+  std::atomic<std::size_t> load_tasks{0};
+  std::atomic<std::chrono::milliseconds> load_tasks_duration{{}};
+  std::atomic<std::chrono::milliseconds> load_merge_duration{{}};
+};
+
 struct Statistics {
   std::atomic<bool> is_loaded{false};
   std::atomic<bool> is_current_from_dump{false};
@@ -20,6 +35,8 @@ struct Statistics {
       last_nontrivial_write_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_nontrivial_write_duration{{}};
   std::atomic<std::size_t> last_written_size{0};
+
+  ParallelStatistics parallel;
 };
 
 formats::json::Value Serialize(const Statistics& stats,
@@ -1,5 +1,7 @@
 #include <userver/dump/unsafe.hpp>
 
+#include <algorithm>
+
 #include <fmt/format.h>
 
 #include <userver/dump/common.hpp>
@@ -9,6 +11,11 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
+namespace {
+// Limits the size of the intermediate buffers of the readers on copying
+constexpr std::size_t kMappedCopyChunkSize = 1 << 20;
+}  // namespace
+
 void WriteStringViewUnsafe(Writer& writer, std::string_view value) {
   writer.WriteRaw(value);
 }
@@ -37,6 +44,20 @@ std::string_view ReadUnsafeAtMost(Reader& reader, std::size_t max_size) {
   return result;
 }
 
+std::shared_ptr<const char> ReadMappedUnsafe(Reader& reader, std::size_t size) {
+  auto mapped = reader.ReadMappedRaw(size);
+  if (mapped) return mapped;
+
+  const std::shared_ptr<char[]> buffer(new char[size]);
+  for (std::size_t offset = 0; offset < size;) {
+    const auto chunk = ReadStringViewUnsafe(
+        reader, std::min(size - offset, kMappedCopyChunkSize));
+    chunk.copy(buffer.get() + offset, chunk.size());
+    offset += chunk.size();
+  }
+  return {buffer, buffer.get()};
+}
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
@@ -12,7 +12,7 @@ struct Snapshot::Impl final {
   explicit Impl(const impl::StorageData& storage)
       : data_ptr(storage.config.Read()) {}
 
-  rcu::ReadablePtr<impl::SnapshotData> data_ptr;
+  rcu::ReadablePtr<impl::SnapshotData, rcu::ReadScalableRcuTraits> data_ptr;
 };
 
 Snapshot::Snapshot(const Snapshot&) = default;
@@ -10,7 +10,7 @@ USERVER_NAMESPACE_BEGIN
 namespace dynamic_config::impl {
 
 struct StorageData final {
-  rcu::Variable<SnapshotData> config;
+  rcu::Variable<SnapshotData, rcu::ReadScalableRcuTraits> config;
   concurrent::AsyncEventChannel<const Snapshot&> channel{"dynamic-config"};
 };
 
@@ -1,7 +1,10 @@
 #include <benchmark/benchmark.h>
 
 #include <chrono>
+#include <memory>
+#include <vector>
 
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -47,6 +50,49 @@ void deadline_100s_interval_reached(benchmark::State& state) {
   deadline_is_reached(state, std::chrono::seconds{100});
 }
 
+struct BenchmarkTimer final : engine::ev::TimerWheel::Entry {
+  BenchmarkTimer() : Entry(&OnExpired) {}
+
+  static void OnExpired(Entry&) noexcept {}
+};
+
+// A task that is woken up before its deadline and sleeps again, moving the
+// deadline forward
+void deadline_timer_wheel_rearm(benchmark::State& state) {
+  const auto now = engine::Deadline::Clock::now();
+  engine::ev::TimerWheel wheel{now};
+  BenchmarkTimer timer;
+  auto tick = engine::ev::TimerWheel::ToTick(now);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(wheel.Link(timer, tick + 20'000));
+    ++tick;
+  }
+  wheel.Unlink(timer);
+}
+
+// Expiration of a batch of timers on a single wheel tick
+void deadline_timer_wheel_expire(benchmark::State& state) {
+  const auto batch_size = static_cast<std::size_t>(state.range(0));
+  std::vector<std::unique_ptr<BenchmarkTimer>> timers;
+  for (std::size_t i = 0; i < batch_size; ++i) {
+    timers.push_back(std::make_unique<BenchmarkTimer>());
+  }
+
+  auto now = engine::Deadline::Clock::now();
+  engine::ev::TimerWheel wheel{now};
+  for (auto _ : state) {
+    state.PauseTiming();
+    const auto tick = wheel.GetCurrentTick() + 100;
+    for (auto& timer : timers) wheel.Link(*timer, tick);
+    now += std::chrono::milliseconds{100};
+    state.ResumeTiming();
+
+    wheel.Advance(now);
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
 }  // namespace
 
 BENCHMARK(deadline_1us_interval_construction);
@@ -56,4 +102,7 @@ BENCHMARK(deadline_1us_interval_reached);
 BENCHMARK(deadline_20ms_interval_reached);
 BENCHMARK(deadline_100s_interval_reached);
 
+BENCHMARK(deadline_timer_wheel_rearm);
+BENCHMARK(deadline_timer_wheel_expire)->RangeMultiplier(8)->Range(1, 4096);
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,473 @@
+#include "io_uring.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <system_error>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
+
+// MAC_COMPAT: io_uring is Linux only, IsSupported() is false elsewhere
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+// Kernel headers older than 5.6 (e.g. 5.4 of Ubuntu 20.04) lack the probe
+// API and the operations used below, the stub is built with them.
+// IORING_REGISTER_PROBE is an enumerator in newer headers, so the macros
+// introduced along with it are checked instead.
+#if defined(IO_URING_OP_SUPPORTED) && defined(IORING_FEAT_RW_CUR_POS) && \
+    defined(IORING_SETUP_CLAMP) && defined(IORING_SQ_CQ_OVERFLOW)
+#define USERVER_IMPL_HAS_IO_URING
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+#ifdef USERVER_IMPL_HAS_IO_URING
+
+namespace {
+
+// Completions of cancellation requests are not reported to anyone
+constexpr std::uint64_t kIgnoredUserData = 0;
+
+constexpr unsigned kRequiredFeatures =
+    IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_RW_CUR_POS;
+
+constexpr std::uint8_t kRequiredOps[] = {
+    IORING_OP_RECV,       IORING_OP_SEND,        IORING_OP_SENDMSG,
+    IORING_OP_ACCEPT,     IORING_OP_READ,        IORING_OP_WRITE,
+    IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED, IORING_OP_ASYNC_CANCEL,
+};
+
+int IoUringSetup(unsigned entries, struct io_uring_params& params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete,
+                 unsigned flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, const void* arg,
+                    unsigned nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+template <typename T>
+T LoadAcquire(const T* ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+void StoreRelease(T* ptr, T value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+template <typename T>
+T* At(void* base, std::uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+bool ProbeSupport() {
+  struct io_uring_params params {};
+  const int fd = IoUringSetup(4, params);
+  if (fd == -1) {
+    const auto err_value = errno;
+    LOG_INFO() << "io_uring is not available: "
+               << std::error_code(err_value, std::system_category()).message();
+    return false;
+  }
+
+  bool is_supported =
+      (params.features & kRequiredFeatures) == kRequiredFeatures;
+
+  constexpr unsigned kProbeOps = 256;
+  std::vector<char> probe_storage(sizeof(struct io_uring_probe) +
+                                  kProbeOps * sizeof(struct io_uring_probe_op));
+  auto* probe = reinterpret_cast<struct io_uring_probe*>(probe_storage.data());
+  if (IoUringRegister(fd, IORING_REGISTER_PROBE, probe, kProbeOps) == -1) {
+    is_supported = false;
+  } else {
+    for (const auto op : kRequiredOps) {
+      if (op > probe->last_op ||
+          !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+        is_supported = false;
+      }
+    }
+  }
+  ::close(fd);
+
+  if (!is_supported) {
+    LOG_INFO() << "io_uring of the kernel lacks the required features";
+  }
+  return is_supported;
+}
+
+}  // namespace
+
+struct IoUring::Queues final {
+  void* ring{nullptr};
+  std::size_t ring_size{0};
+  struct io_uring_sqe* sqes{nullptr};
+  std::size_t sqes_size{0};
+
+  unsigned* sq_head{nullptr};
+  unsigned* sq_tail{nullptr};
+  unsigned* sq_flags{nullptr};
+  unsigned* sq_array{nullptr};
+  unsigned sq_mask{0};
+  unsigned sq_entries{0};
+
+  unsigned* cq_head{nullptr};
+  unsigned* cq_tail{nullptr};
+  struct io_uring_cqe* cqes{nullptr};
+  unsigned cq_mask{0};
+
+  ~Queues() {
+    if (sqes) ::munmap(sqes, sqes_size);
+    if (ring) ::munmap(ring, ring_size);
+  }
+};
+
+bool IoUring::IsSupported() {
+  static const bool is_supported = ProbeSupport();
+  return is_supported;
+}
+
+IoUring::IoUring(unsigned entries) : queues_(std::make_unique<Queues>()) {
+  struct io_uring_params params {};
+  params.flags = IORING_SETUP_CLAMP;
+  ring_fd_ = utils::CheckSyscall(IoUringSetup(entries, params),
+                                 "setting up io_uring, entries={}", entries);
+
+  try {
+    UINVARIANT(params.features & IORING_FEAT_SINGLE_MMAP,
+               "io_uring without IORING_FEAT_SINGLE_MMAP is not supported");
+
+    auto& q = *queues_;
+    q.ring_size =
+        std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                 params.cq_off.cqes +
+                     params.cq_entries * sizeof(struct io_uring_cqe));
+    q.ring = ::mmap(nullptr, q.ring_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (q.ring == MAP_FAILED) {
+      q.ring = nullptr;
+      utils::CheckSyscall(-1, "mapping io_uring queues");
+    }
+
+    q.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = ::mmap(nullptr, q.sqes_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      utils::CheckSyscall(-1, "mapping io_uring submission entries");
+    }
+    q.sqes = static_cast<struct io_uring_sqe*>(sqes);
+
+    q.sq_head = At<unsigned>(q.ring, params.sq_off.head);
+    q.sq_tail = At<unsigned>(q.ring, params.sq_off.tail);
+    q.sq_flags = At<unsigned>(q.ring, params.sq_off.flags);
+    q.sq_array = At<unsigned>(q.ring, params.sq_off.array);
+    q.sq_mask = *At<unsigned>(q.ring, params.sq_off.ring_mask);
+    q.sq_entries = params.sq_entries;
+
+    q.cq_head = At<unsigned>(q.ring, params.cq_off.head);
+    q.cq_tail = At<unsigned>(q.ring, params.cq_off.tail);
+    q.cqes = At<struct io_uring_cqe>(q.ring, params.cq_off.cqes);
+    q.cq_mask = *At<unsigned>(q.ring, params.cq_off.ring_mask);
+
+    event_fd_ = utils::CheckSyscall(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC),
+                                    "creating eventfd for io_uring");
+    utils::CheckSyscall(
+        IoUringRegister(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1),
+        "registering eventfd in io_uring");
+  } catch (const std::exception&) {
+    queues_.reset();
+    if (event_fd_ != -1) ::close(event_fd_);
+    ::close(ring_fd_);
+    throw;
+  }
+}
+
+IoUring::~IoUring() {
+  if (inflight_) {
+    LOG_ERROR() << "Destroying io_uring with " << inflight_
+                << " requests in flight";
+  }
+  queues_.reset();
+  ::close(event_fd_);
+  ::close(ring_fd_);
+}
+
+void IoUring::Prepare(Request& request) {
+  auto* sqe = GetSqe();
+  if (!sqe) {
+    // The caller falls back to waiting for readiness
+    request.on_complete(request, -EAGAIN);
+    return;
+  }
+
+  const auto size = static_cast<std::uint32_t>(
+      std::min(request.size, static_cast<std::size_t>(INT_MAX)));
+  sqe->fd = request.fd;
+  sqe->user_data = reinterpret_cast<std::uintptr_t>(&request);
+  switch (request.op) {
+    case Op::kRecv:
+      sqe->opcode = IORING_OP_RECV;
+      sqe->addr = reinterpret_cast<std::uintptr_t>(request.data);
+      sqe->len = size;
+      break;
+    case Op::kSend:
+      sqe->opcode = IORING_OP_SEND;
+      sqe->addr = reinterpret_cast<std::uintptr_t>(request.data);
+      sqe->len = size;
+      sqe->msg_flags = MSG_NOSIGNAL;
+      break;
+    case Op::kSendMsg:
+      sqe->opcode = IORING_OP_SENDMSG;
+      sqe->addr = reinterpret_cast<std::uintptr_t>(request.msg);
+      sqe->len = 1;
+      sqe->msg_flags = MSG_NOSIGNAL;
+      break;
+    case Op::kAccept:
+      sqe->opcode = IORING_OP_ACCEPT;
+      sqe->addr = reinterpret_cast<std::uintptr_t>(request.addr);
+      sqe->addr2 = reinterpret_cast<std::uintptr_t>(request.addrlen);
+      sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+      break;
+    case Op::kRead:
+    case Op::kWrite:
+      sqe->opcode =
+          request.op == Op::kRead ? IORING_OP_READ : IORING_OP_WRITE;
+      sqe->addr = reinterpret_cast<std::uintptr_t>(request.data);
+      sqe->len = size;
+      sqe->off = static_cast<std::uint64_t>(request.offset);
+      break;
+    case Op::kReadFixed:
+    case Op::kWriteFixed:
+      UASSERT_MSG(has_buffers_, "No buffers are registered in io_uring");
+      sqe->opcode = request.op == Op::kReadFixed ? IORING_OP_READ_FIXED
+                                                 : IORING_OP_WRITE_FIXED;
+      sqe->addr = reinterpret_cast<std::uintptr_t>(request.data);
+      sqe->len = size;
+      sqe->off = static_cast<std::uint64_t>(request.offset);
+      sqe->buf_index = static_cast<std::uint16_t>(request.buffer_index);
+      break;
+  }
+  ++inflight_;
+}
+
+void IoUring::PrepareCancel(Request& request) {
+  auto* sqe = GetSqe();
+  if (!sqe) {
+    LOG_LIMITED_WARNING() << "io_uring submission queue is full, the "
+                             "cancellation of a request is deferred";
+    pending_cancels_.push_back(&request);
+    return;
+  }
+  FillCancel(*sqe, request);
+}
+
+void IoUring::FillCancel(::io_uring_sqe& sqe, Request& request) {
+  sqe.opcode = IORING_OP_ASYNC_CANCEL;
+  sqe.fd = -1;
+  sqe.addr = reinterpret_cast<std::uintptr_t>(&request);
+  sqe.user_data = kIgnoredUserData;
+}
+
+void IoUring::PreparePendingCancels() {
+  std::size_t prepared = 0;
+  for (; prepared < pending_cancels_.size(); ++prepared) {
+    auto* sqe = TryGetSqe();
+    if (!sqe) break;
+    FillCancel(*sqe, *pending_cancels_[prepared]);
+  }
+  pending_cancels_.erase(pending_cancels_.begin(),
+                         pending_cancels_.begin() + prepared);
+}
+
+::io_uring_sqe* IoUring::GetSqe() {
+  if (prepared_ == queues_->sq_entries) SubmitPrepared();
+  return TryGetSqe();
+}
+
+::io_uring_sqe* IoUring::TryGetSqe() {
+  auto& q = *queues_;
+  if (prepared_ == q.sq_entries) return nullptr;
+
+  const auto tail = *q.sq_tail + prepared_;
+  const auto index = tail & q.sq_mask;
+  q.sq_array[index] = index;
+  ++prepared_;
+
+  auto* sqe = &q.sqes[index];
+  *sqe = {};
+  return sqe;
+}
+
+std::size_t IoUring::Submit() {
+  auto submitted = SubmitPrepared();
+  if (!pending_cancels_.empty()) {
+    PreparePendingCancels();
+    submitted += SubmitPrepared();
+  }
+  return submitted;
+}
+
+std::size_t IoUring::SubmitPrepared() {
+  if (!prepared_) return 0;
+
+  auto& q = *queues_;
+  StoreRelease(q.sq_tail, *q.sq_tail + prepared_);
+
+  int submitted = -1;
+  for (int attempt = 0; attempt < 2 && submitted == -1; ++attempt) {
+    submitted = Enter(prepared_, 0, 0);
+    if (submitted == -1 && (errno == EBUSY || errno == EAGAIN)) {
+      // completion queue overflow, make some room and retry
+      ReapCompletions();
+    } else if (submitted == -1) {
+      break;
+    }
+  }
+
+  if (submitted == -1) {
+    // The requests are left in the queue, the next Submit() retries them
+    const auto err_value = errno;
+    LOG_LIMITED_ERROR()
+        << "io_uring submission failed: "
+        << std::error_code(err_value, std::system_category()).message();
+    StoreRelease(q.sq_tail, *q.sq_tail - prepared_);
+    return 0;
+  }
+
+  // The kernel consumes the entries synchronously, unsubmitted ones stay
+  // before the tail
+  const auto unsubmitted = prepared_ - static_cast<unsigned>(submitted);
+  StoreRelease(q.sq_tail, *q.sq_tail - unsubmitted);
+  prepared_ = unsubmitted;
+  return static_cast<std::size_t>(submitted);
+}
+
+std::size_t IoUring::ReapCompletions() {
+  auto& q = *queues_;
+
+  std::uint64_t counter = 0;
+  [[maybe_unused]] const auto res =
+      ::read(event_fd_, &counter, sizeof(counter));
+
+  std::size_t reaped = 0;
+  while (true) {
+    auto head = *q.cq_head;
+    const auto tail = LoadAcquire(q.cq_tail);
+    if (head == tail) {
+      if (!(LoadAcquire(q.sq_flags) & IORING_SQ_CQ_OVERFLOW)) break;
+      // the kernel has kept the completions that did not fit, flush them
+      Enter(0, 0, IORING_ENTER_GETEVENTS);
+      continue;
+    }
+
+    for (; head != tail; ++head) {
+      const auto& cqe = q.cqes[head & q.cq_mask];
+      const auto user_data = cqe.user_data;
+      const auto result = cqe.res;
+      StoreRelease(q.cq_head, head + 1);
+
+      if (user_data == kIgnoredUserData) continue;
+      UASSERT(inflight_ > 0);
+      --inflight_;
+      ++reaped;
+
+      auto* request = reinterpret_cast<Request*>(user_data);
+      if (!pending_cancels_.empty()) {
+        // the request may be released by on_complete
+        pending_cancels_.erase(std::remove(pending_cancels_.begin(),
+                                           pending_cancels_.end(), request),
+                               pending_cancels_.end());
+      }
+      request->on_complete(*request, result);
+    }
+  }
+  return reaped;
+}
+
+void IoUring::RegisterBuffers(const std::vector<struct iovec>& buffers) {
+  UnregisterBuffers();
+  utils::CheckSyscall(
+      IoUringRegister(ring_fd_, IORING_REGISTER_BUFFERS, buffers.data(),
+                      static_cast<unsigned>(buffers.size())),
+      "registering {} buffers in io_uring", buffers.size());
+  has_buffers_ = true;
+}
+
+void IoUring::UnregisterBuffers() {
+  if (!has_buffers_) return;
+  utils::CheckSyscall(
+      IoUringRegister(ring_fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0),
+      "unregistering io_uring buffers");
+  has_buffers_ = false;
+}
+
+int IoUring::Enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+  int res = -1;
+  do {
+    res = IoUringEnter(ring_fd_, to_submit, min_complete, flags);
+  } while (res == -1 && errno == EINTR);
+  return res;
+}
+
+#else  // USERVER_IMPL_HAS_IO_URING
+
+struct IoUring::Queues final {};
+
+bool IoUring::IsSupported() { return false; }
+
+IoUring::IoUring(unsigned) {
+  throw std::runtime_error("io_uring is not supported on this platform");
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::Prepare(Request&) { UINVARIANT(false, "Unreachable"); }
+
+void IoUring::PrepareCancel(Request&) { UINVARIANT(false, "Unreachable"); }
+
+void IoUring::FillCancel(::io_uring_sqe&, Request&) {
+  UINVARIANT(false, "Unreachable");
+}
+
+void IoUring::PreparePendingCancels() {}
+
+std::size_t IoUring::Submit() { return 0; }
+
+std::size_t IoUring::SubmitPrepared() { return 0; }
+
+std::size_t IoUring::ReapCompletions() { return 0; }
+
+void IoUring::RegisterBuffers(const std::vector<struct iovec>&) {
+  UINVARIANT(false, "Unreachable");
+}
+
+void IoUring::UnregisterBuffers() {}
+
+::io_uring_sqe* IoUring::GetSqe() { return nullptr; }
+
+::io_uring_sqe* IoUring::TryGetSqe() { return nullptr; }
+
+int IoUring::Enter(unsigned, unsigned, unsigned) { return -1; }
+
+#endif  // USERVER_IMPL_HAS_IO_URING
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
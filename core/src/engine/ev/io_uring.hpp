@@ -0,0 +1,128 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct io_uring_sqe;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// @brief io_uring instance of an ev thread.
+///
+/// Requests are put into the submission queue by Prepare() and are passed to
+/// the kernel in batches by Submit(), once per ev loop iteration. The kernel
+/// signals completions through an eventfd that is watched by the ev loop,
+/// ReapCompletions() then invokes the callbacks of the completed requests.
+///
+/// Except for IsSupported() and GetEventFd(), the methods must be called from
+/// the owning ev thread only.
+class IoUring final {
+ public:
+  enum class Op {
+    kRecv,
+    kSend,
+    kSendMsg,
+    kAccept,
+    kRead,
+    kWrite,
+    kReadFixed,
+    kWriteFixed,
+  };
+
+  /// Operation in flight, must stay alive until `on_complete` is called
+  struct Request {
+    /// @param result transferred size or a new fd on success, -errno on error
+    using OnComplete = void (*)(Request&, int result) noexcept;
+
+    Op op{Op::kRecv};
+    int fd{-1};
+    void* data{nullptr};
+    std::size_t size{0};
+
+    /// message for kSendMsg
+    struct msghdr* msg{nullptr};
+
+    /// peer address storage for kAccept, optional
+    struct sockaddr* addr{nullptr};
+    socklen_t* addrlen{nullptr};
+
+    /// file offset for kRead, kWrite and the fixed operations, -1 to use and
+    /// advance the current file position
+    std::int64_t offset{-1};
+
+    /// index of a registered buffer for kReadFixed and kWriteFixed
+    unsigned buffer_index{0};
+
+    OnComplete on_complete{nullptr};
+  };
+
+  /// Whether the kernel supports io_uring with all the operations used by
+  /// the backend, checked once per process
+  static bool IsSupported();
+
+  explicit IoUring(unsigned entries);
+  ~IoUring();
+
+  IoUring(IoUring&&) = delete;
+  IoUring& operator=(IoUring&&) = delete;
+
+  /// Becomes readable when there are completions to reap
+  int GetEventFd() const { return event_fd_; }
+
+  /// Queues the request for submission. Flushes the submission queue to the
+  /// kernel if it is full.
+  void Prepare(Request& request);
+
+  /// Queues cancellation of a request in flight, `on_complete` of the request
+  /// is still called, with -ECANCELED if the operation was interrupted.
+  /// If the submission queue stays full even after flushing it, the
+  /// cancellation is kept pending and retried by the following Submit() calls
+  /// until the request completes.
+  void PrepareCancel(Request& request);
+
+  /// Passes all the prepared requests to the kernel
+  /// @returns the number of requests submitted
+  std::size_t Submit();
+
+  /// Invokes the callbacks of the completed requests
+  /// @returns the number of completions
+  std::size_t ReapCompletions();
+
+  /// Registers buffers for kReadFixed and kWriteFixed, replacing the
+  /// previously registered ones.
+  void RegisterBuffers(const std::vector<struct iovec>& buffers);
+  void UnregisterBuffers();
+
+  /// Number of requests that were prepared but have not completed yet
+  std::size_t GetInflightCount() const { return inflight_; }
+
+ private:
+  struct Queues;
+
+  ::io_uring_sqe* GetSqe();
+  ::io_uring_sqe* TryGetSqe();
+  void FillCancel(::io_uring_sqe& sqe, Request& request);
+  void PreparePendingCancels();
+  std::size_t SubmitPrepared();
+  int Enter(unsigned to_submit, unsigned min_complete, unsigned flags);
+
+  int ring_fd_{-1};
+  int event_fd_{-1};
+  std::unique_ptr<Queues> queues_;
+  unsigned prepared_{0};
+  std::size_t inflight_{0};
+  bool has_buffers_{false};
+  // cancellations that did not fit into the submission queue
+  std::vector<Request*> pending_cancels_;
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,295 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using IoUring = engine::ev::IoUring;
+
+constexpr unsigned kEntries = 16;
+constexpr int kMaxWaitMs = 5000;
+
+struct TestRequest : IoUring::Request {
+  TestRequest() {
+    on_complete = [](IoUring::Request& request, int result) noexcept {
+      auto& self = static_cast<TestRequest&>(request);
+      self.result = result;
+      self.is_completed = true;
+    };
+  }
+
+  int result{0};
+  bool is_completed{false};
+};
+
+class Fds final {
+ public:
+  Fds(int first, int second) : fds_{first, second} {}
+  ~Fds() {
+    for (const auto fd : fds_) {
+      if (fd != -1) ::close(fd);
+    }
+  }
+
+  int operator[](std::size_t i) const { return fds_[i]; }
+
+ private:
+  std::array<int, 2> fds_;
+};
+
+Fds MakePipe() {
+  int fds[2];
+  EXPECT_EQ(::pipe(fds), 0);
+  return {fds[0], fds[1]};
+}
+
+Fds MakeSocketPair() {
+  int fds[2];
+  EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  return {fds[0], fds[1]};
+}
+
+void WaitCompleted(IoUring& ring, const TestRequest& request) {
+  while (!request.is_completed) {
+    struct pollfd pfd {};
+    pfd.fd = ring.GetEventFd();
+    pfd.events = POLLIN;
+    ASSERT_EQ(::poll(&pfd, 1, kMaxWaitMs), 1);
+    ring.ReapCompletions();
+  }
+}
+
+}  // namespace
+
+TEST(IoUring, ReadWrite) {
+  if (!IoUring::IsSupported()) GTEST_SKIP() << "io_uring is not supported";
+  IoUring ring{kEntries};
+  const auto pipe = MakePipe();
+
+  constexpr std::string_view kData = "hello";
+  TestRequest write;
+  write.op = IoUring::Op::kWrite;
+  write.fd = pipe[1];
+  write.data = const_cast<char*>(kData.data());
+  write.size = kData.size();
+
+  std::array<char, 16> buffer{};
+  TestRequest read;
+  read.op = IoUring::Op::kRead;
+  read.fd = pipe[0];
+  read.data = buffer.data();
+  read.size = buffer.size();
+
+  // both are submitted with a single system call
+  ring.Prepare(read);
+  ring.Prepare(write);
+  EXPECT_EQ(ring.GetInflightCount(), std::size_t{2});
+  EXPECT_EQ(ring.Submit(), std::size_t{2});
+
+  ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, write));
+  ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, read));
+  EXPECT_EQ(write.result, static_cast<int>(kData.size()));
+  EXPECT_EQ(read.result, static_cast<int>(kData.size()));
+  EXPECT_EQ(std::string_view(buffer.data(), read.result), kData);
+  EXPECT_EQ(ring.GetInflightCount(), std::size_t{0});
+}
+
+TEST(IoUring, SendRecv) {
+  if (!IoUring::IsSupported()) GTEST_SKIP() << "io_uring is not supported";
+  IoUring ring{kEntries};
+  const auto sockets = MakeSocketPair();
+
+  std::array<char, 16> buffer{};
+  TestRequest recv;
+  recv.op = IoUring::Op::kRecv;
+  recv.fd = sockets[0];
+  recv.data = buffer.data();
+  recv.size = buffer.size();
+  ring.Prepare(recv);
+  ring.Submit();
+  EXPECT_FALSE(recv.is_completed);
+
+  std::string first = "abc";
+  std::string second = "def";
+  std::array<struct iovec, 2> iov{{{first.data(), first.size()},
+                                    {second.data(), second.size()}}};
+  struct msghdr msg {};
+  msg.msg_iov = iov.data();
+  msg.msg_iovlen = iov.size();
+  TestRequest send;
+  send.op = IoUring::Op::kSendMsg;
+  send.fd = sockets[1];
+  send.msg = &msg;
+  ring.Prepare(send);
+  ring.Submit();
+
+  ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, send));
+  ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, recv));
+  EXPECT_EQ(send.result, 6);
+  ASSERT_GT(recv.result, 0);
+  EXPECT_EQ(std::string_view("abcdef").substr(0, recv.result),
+            std::string_view(buffer.data(), recv.result));
+}
+
+TEST(IoUring, Accept) {
+  if (!IoUring::IsSupported()) GTEST_SKIP() << "io_uring is not supported";
+  IoUring ring{kEntries};
+
+  const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_NE(listener, -1);
+  const Fds listener_guard{listener, -1};
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addr_len = sizeof(addr);
+  ASSERT_EQ(::bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_len), 0);
+  ASSERT_EQ(::listen(listener, 1), 0);
+  ASSERT_EQ(
+      ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len),
+      0);
+
+  struct sockaddr_in peer {};
+  socklen_t peer_len = sizeof(peer);
+  TestRequest accept;
+  accept.op = IoUring::Op::kAccept;
+  accept.fd = listener;
+  accept.addr = reinterpret_cast<sockaddr*>(&peer);
+  accept.addrlen = &peer_len;
+  ring.Prepare(accept);
+  ring.Submit();
+
+  const int client = ::socket(AF_INET, SOCK_STREAM, 0);
+  const Fds client_guard{client, -1};
+  ASSERT_EQ(::connect(client, reinterpret_cast<sockaddr*>(&addr), addr_len),
+            0);
+
+  ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, accept));
+  ASSERT_GE(accept.result, 0);
+  const Fds accepted_guard{accept.result, -1};
+  EXPECT_EQ(peer.sin_family, AF_INET);
+}
+
+TEST(IoUring, Cancel) {
+  if (!IoUring::IsSupported()) GTEST_SKIP() << "io_uring is not supported";
+  IoUring ring{kEntries};
+  const auto sockets = MakeSocketPair();
+
+  std::array<char, 16> buffer{};
+  TestRequest recv;
+  recv.op = IoUring::Op::kRecv;
+  recv.fd = sockets[0];
+  recv.data = buffer.data();
+  recv.size = buffer.size();
+  ring.Prepare(recv);
+  ring.Submit();
+
+  ring.PrepareCancel(recv);
+  ring.Submit();
+  ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, recv));
+  EXPECT_EQ(recv.result, -ECANCELED);
+  EXPECT_EQ(ring.GetInflightCount(), std::size_t{0});
+}
+
+TEST(IoUring, CancelWithFullQueue) {
+  if (!IoUring::IsSupported()) GTEST_SKIP() << "io_uring is not supported";
+  IoUring ring{kEntries};
+  const auto sockets = MakeSocketPair();
+
+  // Fills the submission queue without submitting it
+  std::array<char, 16> buffer{};
+  std::vector<TestRequest> recvs(kEntries);
+  for (auto& recv : recvs) {
+    recv.op = IoUring::Op::kRecv;
+    recv.fd = sockets[0];
+    recv.data = buffer.data();
+    recv.size = buffer.size();
+    ring.Prepare(recv);
+  }
+
+  for (auto& recv : recvs) {
+    ring.PrepareCancel(recv);
+  }
+  ring.Submit();
+  for (const auto& recv : recvs) {
+    ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, recv));
+    EXPECT_EQ(recv.result, -ECANCELED);
+  }
+  EXPECT_EQ(ring.GetInflightCount(), std::size_t{0});
+}
+
+TEST(IoUring, FullQueueIsFlushed) {
+  if (!IoUring::IsSupported()) GTEST_SKIP() << "io_uring is not supported";
+  IoUring ring{kEntries};
+  const auto sockets = MakeSocketPair();
+
+  constexpr std::size_t kRequests = kEntries * 3;
+  std::vector<TestRequest> sends(kRequests);
+  const char data = 'x';
+  for (auto& send : sends) {
+    send.op = IoUring::Op::kSend;
+    send.fd = sockets[1];
+    send.data = const_cast<char*>(&data);
+    send.size = 1;
+    ring.Prepare(send);
+  }
+  ring.Submit();
+
+  for (const auto& send : sends) {
+    ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, send));
+    EXPECT_EQ(send.result, 1);
+  }
+
+  std::array<char, kRequests> buffer{};
+  EXPECT_EQ(::recv(sockets[0], buffer.data(), buffer.size(), MSG_WAITALL),
+            static_cast<ssize_t>(kRequests));
+}
+
+TEST(IoUring, RegisteredBuffers) {
+  if (!IoUring::IsSupported()) GTEST_SKIP() << "io_uring is not supported";
+  IoUring ring{kEntries};
+  const auto pipe = MakePipe();
+
+  std::array<char, 64> out{};
+  std::array<char, 64> in{};
+  std::memcpy(out.data(), "fixed", 5);
+  ring.RegisterBuffers({{out.data(), out.size()}, {in.data(), in.size()}});
+
+  TestRequest write;
+  write.op = IoUring::Op::kWriteFixed;
+  write.fd = pipe[1];
+  write.data = out.data();
+  write.size = 5;
+  write.buffer_index = 0;
+  ring.Prepare(write);
+
+  TestRequest read;
+  read.op = IoUring::Op::kReadFixed;
+  read.fd = pipe[0];
+  read.data = in.data();
+  read.size = in.size();
+  read.buffer_index = 1;
+  ring.Prepare(read);
+  ring.Submit();
+
+  ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, write));
+  ASSERT_NO_FATAL_FAILURE(WaitCompleted(ring, read));
+  EXPECT_EQ(write.result, 5);
+  EXPECT_EQ(std::string_view(in.data(), read.result), "fixed");
+
+  ring.UnregisterBuffers();
+}
+
+USERVER_NAMESPACE_END
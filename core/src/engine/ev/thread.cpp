@@ -11,8 +11,11 @@
 #include <userver/utils/thread_name.hpp>
 #include <utils/check_syscall.hpp>
 #include <utils/impl/assert_extra.hpp>
+#include <utils/threads.hpp>
 
 #include "child_process_map.hpp"
+#include "io_uring.hpp"
+#include "timer_wheel.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -21,6 +24,10 @@ namespace {
 
 const size_t kInitFuncQueueCapacity = 128;
 
+// Submission queue size, completion queue is twice as large. Submissions are
+// flushed to the kernel once the queue is full, so this only bounds the batch.
+constexpr unsigned kIoUringEntries = 256;
+
 // We approach libev/OS timer resolution here
 constexpr std::chrono::milliseconds kPeriodicEventsDriverInterval{1};
 
@@ -56,17 +63,24 @@ void ReleaseEvDefaultLoop() {
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               std::vector<std::size_t> cpu_affinity, IoBackend io_backend)
+    : Thread(thread_name, false, register_event_mode, std::move(cpu_affinity),
+             io_backend) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               std::vector<std::size_t> cpu_affinity, IoBackend io_backend)
+    : Thread(thread_name, true, register_event_mode, std::move(cpu_affinity),
+             io_backend) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode,
+               std::vector<std::size_t> cpu_affinity, IoBackend io_backend)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
+      cpu_affinity_(std::move(cpu_affinity)),
+      io_backend_(io_backend),
       func_queue_(kInitFuncQueueCapacity),
       loop_(nullptr),
       lock_(loop_mutex_, std::defer_lock),
@@ -148,6 +162,8 @@ void Thread::Start(const std::string& name) {
   ev_async_start(loop_, &watch_break_);
 
   if (register_event_mode_ == RegisterEventMode::kDeferred) {
+    timer_wheel_ = std::make_unique<TimerWheel>(Deadline::Clock::now());
+
     using LibEvDuration = std::chrono::duration<double>;
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
     ev_timer_init(
@@ -163,9 +179,24 @@ void Thread::Start(const std::string& name) {
     ev_child_start(loop_, &watch_child_);
   }
 
+  if (io_backend_ == IoBackend::kIoUring) {
+    if (IoUring::IsSupported()) {
+      io_uring_ = std::make_unique<IoUring>(kIoUringEntries);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+      ev_io_init(&watch_io_uring_, IoUringWatcher, io_uring_->GetEventFd(),
+                 EV_READ);
+      ev_io_start(loop_, &watch_io_uring_);
+    } else {
+      LOG_WARNING() << "io_uring is not supported by the kernel, falling back "
+                       "to libev for I/O, thread_name="
+                    << name;
+    }
+  }
+
   is_running_ = true;
   thread_ = std::thread([this, name] {
     utils::SetCurrentThreadName(name);
+    utils::SetCurrentThreadCpuAffinity(cpu_affinity_);
     RunEvLoop();
   });
 }
@@ -187,6 +218,8 @@ void Thread::RunEvLoop() {
     AcquireImpl();
     ev_run(loop_, EVRUN_ONCE);
     UpdateLoopWatcherImpl();
+    // requests prepared during the iteration are passed to the kernel at once
+    if (io_uring_) io_uring_->Submit();
     ReleaseImpl();
   }
 
@@ -196,6 +229,7 @@ void Thread::RunEvLoop() {
     ev_timer_stop(loop_, &timers_driver_);
   }
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
+  if (io_uring_) ev_io_stop(loop_, &watch_io_uring_);
 }
 
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -209,6 +243,9 @@ void Thread::UpdateTimersWatcher(struct ev_loop* loop, ev_timer*,
   auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
   UASSERT(ev_thread != nullptr);
   ev_thread->UpdateLoopWatcherImpl();
+  // all the timers that expired since the last run are fired in one batch
+  UASSERT(ev_thread->timer_wheel_);
+  ev_thread->timer_wheel_->Advance(Deadline::Clock::now());
 }
 
 void Thread::UpdateLoopWatcherImpl() {
@@ -288,6 +325,13 @@ void Thread::ChildWatcherImpl(ev_child* w) {
   }
 }
 
+void Thread::IoUringWatcher(struct ev_loop* loop, ev_io*, int) noexcept {
+  auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+  UASSERT(ev_thread != nullptr);
+  UASSERT(ev_thread->io_uring_);
+  ev_thread->io_uring_->ReapCompletions();
+}
+
 void Thread::Acquire(struct ev_loop* loop) noexcept {
   auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
   UASSERT(ev_thread != nullptr);
@@ -5,18 +5,23 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <ev.h>
 #include <boost/lockfree/queue.hpp>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/thread_pool_config.hpp>
 #include <userver/engine/deadline.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+class IoUring;
+class TimerWheel;
+
 class Thread final {
  public:
   struct UseDefaultEvLoop {};
@@ -33,8 +38,12 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  Thread(const std::string& thread_name, RegisterEventMode,
+         std::vector<std::size_t> cpu_affinity = {},
+         IoBackend io_backend = IoBackend::kLibev);
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         std::vector<std::size_t> cpu_affinity = {},
+         IoBackend io_backend = IoBackend::kLibev);
   ~Thread();
 
   struct ev_loop* GetEvLoop() const {
@@ -53,9 +62,20 @@ class Thread final {
 
   bool IsInEvThread() const;
 
+  // io_uring of the thread, null with the libev backend. Requests may only
+  // be prepared from the ev thread, they are submitted once per loop
+  // iteration.
+  IoUring* GetIoUring() const { return io_uring_.get(); }
+
+  // Timer wheel of the thread, null with RegisterEventMode::kImmediate. It is
+  // advanced by the periodic timer with the ~1ms resolution and may only be
+  // used from the ev thread.
+  TimerWheel* GetTimerWheel() const { return timer_wheel_.get(); }
+
  private:
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode,
+         std::vector<std::size_t> cpu_affinity, IoBackend io_backend);
 
   void RegisterInEvLoop(OnAsyncPayload* func, AsyncPayloadPtr&& data);
 
@@ -71,6 +91,7 @@ class Thread final {
   void BreakLoopWatcherImpl();
   static void ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept;
   static void ChildWatcherImpl(ev_child* w);
+  static void IoUringWatcher(struct ev_loop*, ev_io* w, int) noexcept;
 
   static void Acquire(struct ev_loop* loop) noexcept;
   static void Release(struct ev_loop* loop) noexcept;
@@ -79,6 +100,8 @@ class Thread final {
 
   bool use_ev_default_loop_;
   RegisterEventMode register_event_mode_;
+  const std::vector<std::size_t> cpu_affinity_;
+  const IoBackend io_backend_;
 
   struct QueueData {
     OnAsyncPayload* func;
@@ -93,10 +116,14 @@ class Thread final {
   std::unique_lock<std::mutex> lock_;
 
   ev_timer timers_driver_{};
+  std::unique_ptr<TimerWheel> timer_wheel_;
   ev_async watch_update_{};
   ev_async watch_break_{};
   ev_child watch_child_{};
 
+  std::unique_ptr<IoUring> io_uring_;
+  ev_io watch_io_uring_{};
+
   bool is_running_;
 };
 
@@ -75,6 +75,14 @@ bool ThreadControl::IsInEvThread() const noexcept {
   return thread_.IsInEvThread();
 }
 
+IoUring* ThreadControl::GetIoUring() const noexcept {
+  return thread_.GetIoUring();
+}
+
+TimerWheel* ThreadControl::GetTimerWheel() const noexcept {
+  return thread_.GetTimerWheel();
+}
+
 }  // namespace engine::ev
 
 USERVER_NAMESPACE_END
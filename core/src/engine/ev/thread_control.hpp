@@ -98,6 +98,8 @@ class CallerOwnedPayloadBlocking final : public AsyncPayloadBase {
 }  // namespace impl
 
 class Thread;
+class IoUring;
+class TimerWheel;
 
 class ThreadControl final {
  public:
@@ -147,6 +149,12 @@ class ThreadControl final {
 
   bool IsInEvThread() const noexcept;
 
+  /// io_uring of the thread, null if the thread uses libev for I/O
+  IoUring* GetIoUring() const noexcept;
+
+  /// Timer wheel of the thread, null if the thread does not defer events
+  TimerWheel* GetTimerWheel() const noexcept;
+
  private:
   Thread& thread_;
 };
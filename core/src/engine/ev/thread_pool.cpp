@@ -3,6 +3,7 @@
 #include <fmt/format.h>
 
 #include <userver/utils/assert.hpp>
+#include <utils/threads.hpp>
 
 #include "thread.hpp"
 #include "thread_control.hpp"
@@ -31,13 +32,18 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
   threads_.reserve(config.threads);
   const auto register_timer_event_mode =
       GetRegisterEventMode(config.defer_events);
+  const auto cpu_affinity =
+      utils::ResolveCpuAffinity(config.cpu_affinity, config.numa_node);
   for (size_t i = 0; i < config.threads; i++) {
     const auto thread_name = fmt::format("{}_{}", config.thread_name, i);
-    threads_.push_back(
-        use_ev_default_loop_ && !i
-            ? std::make_unique<Thread>(thread_name, Thread::kUseDefaultEvLoop,
-                                       register_timer_event_mode)
-            : std::make_unique<Thread>(thread_name, register_timer_event_mode));
+    threads_.push_back(use_ev_default_loop_ && !i
+                           ? std::make_unique<Thread>(
+                                 thread_name, Thread::kUseDefaultEvLoop,
+                                 register_timer_event_mode, cpu_affinity,
+                                 config.io_backend)
+                           : std::make_unique<Thread>(
+                                 thread_name, register_timer_event_mode,
+                                 cpu_affinity, config.io_backend));
   }
 
   thread_controls_.reserve(threads_.size());
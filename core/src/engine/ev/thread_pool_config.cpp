@@ -1,15 +1,34 @@
 #include "thread_pool_config.hpp"
 
+#include <userver/utils/assert.hpp>
+#include <utils/threads.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+IoBackend Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<IoBackend>) {
+  const auto str = value.As<std::string>();
+  if (str == "libev") {
+    return IoBackend::kLibev;
+  } else if (str == "io_uring") {
+    return IoBackend::kIoUring;
+  }
+
+  UINVARIANT(false, "Unknown I/O backend: " + str);
+}
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>) {
   ThreadPoolConfig config;
   config.threads = value["threads"].As<size_t>(config.threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.cpu_affinity =
+      utils::ParseCpuList(value["cpu-affinity"].As<std::string>(""));
+  config.numa_node = value["numa-node"].As<std::optional<std::size_t>>();
+  config.io_backend = value["io-backend"].As<IoBackend>(config.io_backend);
   return config;
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -9,11 +11,23 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+/// Mechanism the engine::io sockets and pipes wait for I/O with
+enum class IoBackend {
+  kLibev,    ///< readiness notifications of the ev loop
+  kIoUring,  ///< completions of io_uring, kLibev if the kernel lacks support
+};
+
+IoBackend Parse(const yaml_config::YamlConfig& value,
+                formats::parse::To<IoBackend>);
+
 struct ThreadPoolConfig {
   size_t threads = 2;
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  std::vector<std::size_t> cpu_affinity;
+  std::optional<std::size_t> numa_node;
+  IoBackend io_backend = IoBackend::kLibev;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -0,0 +1,148 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+namespace {
+
+// ticks are counted in milliseconds since the steady clock epoch
+static_assert(TimerWheel::kResolution == std::chrono::milliseconds{1});
+
+TimerWheel::Tick FloorTick(Deadline::TimePoint time_point) noexcept {
+  return std::chrono::floor<std::chrono::milliseconds>(
+             time_point.time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+TimerWheel::Entry::~Entry() { UASSERT(!IsLinked()); }
+
+TimerWheel::Tick TimerWheel::ToTick(Deadline::TimePoint time_point) noexcept {
+  UASSERT(time_point.time_since_epoch().count() >= 0);
+  return std::chrono::ceil<std::chrono::milliseconds>(
+             time_point.time_since_epoch())
+      .count();
+}
+
+TimerWheel::Tick TimerWheel::ToTick(Deadline deadline) noexcept {
+  UASSERT(deadline.IsReachable());
+  const auto now = Deadline::Clock::now();
+  return ToTick(now + std::max(deadline.TimeLeft(), Deadline::Duration{0}));
+}
+
+Deadline TimerWheel::ToDeadline(Tick tick) noexcept {
+  return Deadline::FromTimePoint(Deadline::TimePoint{
+      std::chrono::milliseconds{static_cast<std::int64_t>(tick)}});
+}
+
+TimerWheel::TimerWheel(Deadline::TimePoint now) : current_(FloorTick(now)) {}
+
+TimerWheel::~TimerWheel() {
+  // entries must not point into a destroyed wheel
+  for (auto& level : slots_) {
+    for (auto& slot : level) {
+      while (slot) Unlink(*slot);
+    }
+  }
+}
+
+TimerWheel::Tick TimerWheel::Link(Entry& entry, Tick tick) noexcept {
+  Unlink(entry);
+  entry.tick_ = std::max(tick, current_ + 1);
+  Insert(entry);
+  return entry.tick_;
+}
+
+void TimerWheel::Unlink(Entry& entry) noexcept {
+  if (!entry.IsLinked()) return;
+
+  *entry.pprev_ = entry.next_;
+  if (entry.next_) entry.next_->pprev_ = entry.pprev_;
+  entry.next_ = nullptr;
+  entry.pprev_ = nullptr;
+
+  UASSERT(size_ > 0);
+  --size_;
+}
+
+void TimerWheel::Advance(Deadline::TimePoint now) noexcept {
+  // the tick in progress must not expire yet
+  const auto now_tick = FloorTick(now);
+
+  while (current_ < now_tick) {
+    if (size_ == 0) {
+      current_ = now_tick;
+      return;
+    }
+
+    ++current_;
+    // upper levels go first, they may cascade into the current lower slots
+    for (std::size_t level = kLevels - 1; level > 0; --level) {
+      const auto mask = (Tick{1} << (kSlotBits * level)) - 1;
+      if ((current_ & mask) == 0) Cascade(level);
+    }
+    Expire();
+  }
+}
+
+void TimerWheel::Insert(Entry& entry) noexcept {
+  UASSERT(!entry.IsLinked());
+  // Cascade brings the entries of the current tick when it falls on a slot
+  // boundary of an upper level. They get into the current slot of level 0
+  // that is expired right after the cascade.
+  UASSERT(entry.tick_ >= current_);
+
+  // The level is the highest group of slot bits where the tick differs from
+  // the current one. Ticks that are too far away wait in the top level and
+  // get relinked each time the wheel passes their slot.
+  const auto diff = entry.tick_ ^ current_;
+  std::size_t level = 0;
+  while (level + 1 < kLevels && (diff >> (kSlotBits * (level + 1))) != 0) {
+    ++level;
+  }
+  const auto index = (entry.tick_ >> (kSlotBits * level)) & (kSlots - 1);
+
+  auto& head = slots_[level][index];
+  entry.next_ = head;
+  if (head) head->pprev_ = &entry.next_;
+  head = &entry;
+  entry.pprev_ = &head;
+  ++size_;
+}
+
+void TimerWheel::Cascade(std::size_t level) noexcept {
+  const auto index = (current_ >> (kSlotBits * level)) & (kSlots - 1);
+  // Too far away entries of the top level return into the same slot
+  Slot cascaded = std::exchange(slots_[level][index], nullptr);
+  if (cascaded) cascaded->pprev_ = &cascaded;
+
+  while (cascaded) {
+    auto& entry = *cascaded;
+    Unlink(entry);
+    Insert(entry);
+  }
+}
+
+void TimerWheel::Expire() noexcept {
+  // Detach the slot first, the callbacks may unlink the other entries of it
+  Slot expired = std::exchange(slots_[0][current_ & (kSlots - 1)], nullptr);
+  if (expired) expired->pprev_ = &expired;
+
+  while (expired) {
+    auto& entry = *expired;
+    UASSERT(entry.tick_ == current_);
+    Unlink(entry);
+    entry.on_expired_(entry);
+  }
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// @brief Hierarchical timing wheel of an ev thread.
+///
+/// Time is split into ticks of kResolution. Entries are linked into the slot
+/// of their expiration tick in O(1), entries of the far future are kept in
+/// coarse upper levels and cascade down as the wheel turns. Advance() expires
+/// all the entries of the passed ticks in a single batch.
+///
+/// Linking an entry does not look at its previous position, so rearming a
+/// timer is as cheap as arming a new one.
+///
+/// Not thread-safe, all the methods must be called from the owning ev thread.
+class TimerWheel final {
+ public:
+  using Tick = std::uint64_t;
+
+  static constexpr std::chrono::milliseconds kResolution{1};
+
+  /// Base class of the timers, the callback gets the entry to downcast
+  class Entry {
+   public:
+    using OnExpired = void (*)(Entry&) noexcept;
+
+    Entry(Entry&&) = delete;
+    Entry& operator=(Entry&&) = delete;
+
+    bool IsLinked() const noexcept { return pprev_ != nullptr; }
+
+    /// The tick the entry expires at, valid while IsLinked()
+    Tick GetTick() const noexcept { return tick_; }
+
+   protected:
+    explicit Entry(OnExpired on_expired) noexcept : on_expired_(on_expired) {}
+    ~Entry();
+
+   private:
+    friend class TimerWheel;
+
+    const OnExpired on_expired_;
+    Entry* next_{nullptr};
+    Entry** pprev_{nullptr};
+    Tick tick_{0};
+  };
+
+  /// The first tick that does not precede the time point
+  static Tick ToTick(Deadline::TimePoint time_point) noexcept;
+
+  /// The first tick that does not precede the reachable deadline
+  static Tick ToTick(Deadline deadline) noexcept;
+
+  /// Start of the tick as a deadline
+  static Deadline ToDeadline(Tick tick) noexcept;
+
+  explicit TimerWheel(Deadline::TimePoint now);
+  ~TimerWheel();
+
+  TimerWheel(TimerWheel&&) = delete;
+  TimerWheel& operator=(TimerWheel&&) = delete;
+
+  /// Links the entry to expire at the tick, relinking it if it is already
+  /// linked. Ticks that have already passed are moved to the next one.
+  /// @returns the tick the entry will expire at
+  Tick Link(Entry& entry, Tick tick) noexcept;
+
+  /// Does nothing for an entry that is not linked
+  void Unlink(Entry& entry) noexcept;
+
+  /// Expires the entries of all the ticks up to `now` inclusive, in tick
+  /// order. Callbacks may link and unlink any entries.
+  void Advance(Deadline::TimePoint now) noexcept;
+
+  /// The last expired tick
+  Tick GetCurrentTick() const noexcept { return current_; }
+
+  std::size_t GetSize() const noexcept { return size_; }
+
+ private:
+  static constexpr std::size_t kSlotBits = 6;
+  static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+  static constexpr std::size_t kLevels = 4;
+
+  using Slot = Entry*;
+
+  void Insert(Entry& entry) noexcept;
+  void Cascade(std::size_t level) noexcept;
+  void Expire() noexcept;
+
+  std::array<std::array<Slot, kSlots>, kLevels> slots_{};
+  Tick current_;
+  std::size_t size_{0};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
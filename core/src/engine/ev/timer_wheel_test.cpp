@@ -0,0 +1,188 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using TimerWheel = engine::ev::TimerWheel;
+using TimePoint = engine::Deadline::TimePoint;
+
+// an arbitrary start that is not aligned to any level of the wheel
+constexpr TimerWheel::Tick kStart = 1'000'000'007;
+
+TimePoint ToTimePoint(TimerWheel::Tick tick) {
+  return TimePoint{std::chrono::milliseconds{static_cast<std::int64_t>(tick)}};
+}
+
+struct TestEntry final : TimerWheel::Entry {
+  TestEntry() : Entry(&OnExpired) {}
+
+  static void OnExpired(Entry& entry) noexcept {
+    auto& self = static_cast<TestEntry&>(entry);
+    self.expirations.push_back(self.wheel->GetCurrentTick());
+    if (self.period) {
+      self.wheel->Link(self, self.wheel->GetCurrentTick() + self.period);
+    }
+  }
+
+  TimerWheel* wheel{nullptr};
+  TimerWheel::Tick period{0};
+  std::vector<TimerWheel::Tick> expirations;
+};
+
+}  // namespace
+
+TEST(TimerWheel, Ticks) {
+  const auto start = ToTimePoint(kStart);
+  EXPECT_EQ(TimerWheel::ToTick(start), kStart);
+  EXPECT_EQ(TimerWheel::ToTick(start + std::chrono::nanoseconds{1}),
+            kStart + 1);
+  EXPECT_EQ(TimerWheel::ToTick(start - std::chrono::nanoseconds{1}), kStart);
+  const auto deadline = engine::Deadline::FromTimePoint(start);
+  EXPECT_FALSE(TimerWheel::ToDeadline(kStart) < deadline);
+  EXPECT_FALSE(deadline < TimerWheel::ToDeadline(kStart));
+}
+
+TEST(TimerWheel, ExpiresAtTick) {
+  TimerWheel wheel{ToTimePoint(kStart)};
+  // the boundaries of the levels and the ticks beyond the last one
+  const std::vector<TimerWheel::Tick> delays{
+      1,       2,       63,      64,        65,         4095,
+      4096,    4097,    100'000, 262'143,   262'144,    262'145,
+      1'000'000, 16'777'215, 16'777'216, 20'000'000};
+
+  std::vector<std::unique_ptr<TestEntry>> entries;
+  for (const auto delay : delays) {
+    auto& entry = *entries.emplace_back(std::make_unique<TestEntry>());
+    entry.wheel = &wheel;
+    EXPECT_EQ(wheel.Link(entry, kStart + delay), kStart + delay);
+    EXPECT_TRUE(entry.IsLinked());
+  }
+  EXPECT_EQ(wheel.GetSize(), delays.size());
+
+  // advance in uneven steps, like a busy ev loop would
+  auto now = kStart;
+  const auto end = kStart + delays.back() + 1;
+  for (TimerWheel::Tick step = 1; now < end; step = step % 977 + 1) {
+    now = std::min(now + step, end);
+    wheel.Advance(ToTimePoint(now) + std::chrono::microseconds{500});
+    EXPECT_EQ(wheel.GetCurrentTick(), now);
+  }
+
+  for (std::size_t i = 0; i < delays.size(); ++i) {
+    EXPECT_FALSE(entries[i]->IsLinked());
+    EXPECT_EQ(entries[i]->expirations,
+              std::vector<TimerWheel::Tick>{kStart + delays[i]})
+        << "delay=" << delays[i];
+  }
+  EXPECT_EQ(wheel.GetSize(), std::size_t{0});
+}
+
+TEST(TimerWheel, PassedTickExpiresNext) {
+  TimerWheel wheel{ToTimePoint(kStart)};
+  TestEntry entry;
+  entry.wheel = &wheel;
+
+  EXPECT_EQ(wheel.Link(entry, kStart - 10), kStart + 1);
+  wheel.Advance(ToTimePoint(kStart) + std::chrono::microseconds{999});
+  EXPECT_TRUE(entry.expirations.empty());
+  wheel.Advance(ToTimePoint(kStart + 1));
+  EXPECT_EQ(entry.expirations, std::vector<TimerWheel::Tick>{kStart + 1});
+}
+
+TEST(TimerWheel, ExpiresAtLevelBoundary) {
+  // an upper level slot boundary: a multiple of 64 * 64 ticks
+  constexpr TimerWheel::Tick kAligned = kStart - kStart % 4096;
+  TimerWheel wheel{ToTimePoint(kAligned - 1)};
+
+  const std::vector<TimerWheel::Tick> ticks{kAligned, kAligned + 64,
+                                            kAligned + 4096,
+                                            kAligned + 64 * 4096};
+  std::vector<std::unique_ptr<TestEntry>> entries;
+  for (const auto tick : ticks) {
+    entries.push_back(std::make_unique<TestEntry>());
+    entries.back()->wheel = &wheel;
+    wheel.Link(*entries.back(), tick);
+  }
+
+  for (auto tick = kAligned; tick <= ticks.back(); tick += 16) {
+    wheel.Advance(ToTimePoint(tick));
+  }
+
+  for (std::size_t i = 0; i < ticks.size(); ++i) {
+    EXPECT_EQ(entries[i]->expirations, std::vector<TimerWheel::Tick>{ticks[i]})
+        << "tick=" << ticks[i];
+  }
+  EXPECT_EQ(wheel.GetSize(), std::size_t{0});
+}
+
+TEST(TimerWheel, RelinkAndUnlink) {
+  TimerWheel wheel{ToTimePoint(kStart)};
+  TestEntry relinked;
+  relinked.wheel = &wheel;
+  TestEntry unlinked;
+  unlinked.wheel = &wheel;
+
+  wheel.Link(relinked, kStart + 10);
+  wheel.Link(unlinked, kStart + 10);
+  wheel.Link(relinked, kStart + 5000);
+  EXPECT_EQ(relinked.GetTick(), kStart + 5000);
+  EXPECT_EQ(wheel.GetSize(), std::size_t{2});
+
+  wheel.Unlink(unlinked);
+  wheel.Unlink(unlinked);
+  EXPECT_FALSE(unlinked.IsLinked());
+  EXPECT_EQ(wheel.GetSize(), std::size_t{1});
+
+  wheel.Advance(ToTimePoint(kStart + 4999));
+  EXPECT_TRUE(relinked.expirations.empty());
+  wheel.Advance(ToTimePoint(kStart + 6000));
+  EXPECT_EQ(relinked.expirations,
+            std::vector<TimerWheel::Tick>{kStart + 5000});
+  EXPECT_TRUE(unlinked.expirations.empty());
+}
+
+TEST(TimerWheel, CallbackRelinks) {
+  TimerWheel wheel{ToTimePoint(kStart)};
+  TestEntry entry;
+  entry.wheel = &wheel;
+  entry.period = 100;
+
+  wheel.Link(entry, kStart + 100);
+  wheel.Advance(ToTimePoint(kStart + 350));
+  EXPECT_EQ(entry.expirations,
+            (std::vector<TimerWheel::Tick>{kStart + 100, kStart + 200,
+                                           kStart + 300}));
+  EXPECT_EQ(entry.GetTick(), kStart + 400);
+  wheel.Unlink(entry);
+}
+
+TEST(TimerWheel, EmptyWheelSkipsTicks) {
+  TimerWheel wheel{ToTimePoint(kStart)};
+  wheel.Advance(ToTimePoint(kStart + 1'000'000'000));
+  EXPECT_EQ(wheel.GetCurrentTick(), kStart + 1'000'000'000);
+
+  TestEntry entry;
+  entry.wheel = &wheel;
+  wheel.Link(entry, kStart + 1'000'000'005);
+  wheel.Advance(ToTimePoint(kStart + 1'000'000'010));
+  EXPECT_EQ(entry.expirations,
+            std::vector<TimerWheel::Tick>{kStart + 1'000'000'005});
+}
+
+TEST(TimerWheel, DestructionUnlinks) {
+  TestEntry entry;
+  {
+    TimerWheel wheel{ToTimePoint(kStart)};
+    wheel.Link(entry, kStart + 100'000);
+  }
+  EXPECT_FALSE(entry.IsLinked());
+}
+
+USERVER_NAMESPACE_END
@@ -6,18 +6,98 @@
 
 #include <memory>
 #include <stdexcept>
+#include <system_error>
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
 
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/thread_control.hpp>
 #include <engine/impl/wait_list.hpp>
+#include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
 #include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io::impl {
+
+// Shared by the waiting task and the ev thread, the ev thread holds a
+// reference while the request is queued or in flight.
+class IoUringRequest final
+    : public ev::IoUring::Request,
+      public ev::AsyncPayloadBase,
+      public boost::intrusive_ref_counter<IoUringRequest> {
+ public:
+  IoUringRequest(const ev::IoUring::Request& request, ev::IoUring& ring)
+      : ev::IoUring::Request(request),
+        ev::AsyncPayloadBase(&Release),
+        ring_(ring) {
+    on_complete = &OnComplete;
+  }
+
+  void Submit(ev::ThreadControl& ev_thread) {
+    intrusive_ptr_add_ref(this);
+    ev_thread.RunInEvLoopAsync(&PrepareInEvLoop, ev::AsyncPayloadPtr(this));
+  }
+
+  // may be called by any task
+  void Cancel(ev::ThreadControl& ev_thread) {
+    is_cancel_requested_ = true;
+    intrusive_ptr_add_ref(this);
+    ev_thread.RunInEvLoopAsync(&CancelInEvLoop, ev::AsyncPayloadPtr(this));
+  }
+
+  bool IsCompleted() const { return is_completed_; }
+  int GetResult() const { return result_; }
+
+  engine::impl::WaitListLight& GetWaiters() { return waiters_; }
+
+ private:
+  static void Release(ev::AsyncPayloadBase& payload) noexcept {
+    intrusive_ptr_release(&static_cast<IoUringRequest&>(payload));
+  }
+
+  static void PrepareInEvLoop(ev::AsyncPayloadPtr&& payload) {
+    auto& self = static_cast<IoUringRequest&>(*payload);
+    // the reference of the ring, released in OnComplete
+    intrusive_ptr_add_ref(&self);
+    if (self.is_cancel_requested_) {
+      OnComplete(self, -ECANCELED);
+      return;
+    }
+    self.is_prepared_ = true;
+    self.ring_.Prepare(self);
+  }
+
+  static void CancelInEvLoop(ev::AsyncPayloadPtr&& payload) {
+    auto& self = static_cast<IoUringRequest&>(*payload);
+    // the ring holds a reference until completion, so no other request may
+    // reuse the address while the cancellation is pending
+    if (!self.is_prepared_ || self.is_completed_) return;
+    self.ring_.PrepareCancel(self);
+  }
+
+  static void OnComplete(ev::IoUring::Request& request, int result) noexcept {
+    auto& self = static_cast<IoUringRequest&>(request);
+    self.result_ = result;
+    self.is_completed_ = true;
+    self.waiters_.WakeupOne();
+    intrusive_ptr_release(&self);
+  }
+
+  ev::IoUring& ring_;
+  int result_{0};
+  std::atomic<bool> is_completed_{false};
+  std::atomic<bool> is_cancel_requested_{false};
+  // accessed from the ev thread only
+  bool is_prepared_{false};
+  engine::impl::WaitListLight waiters_;
+};
+
 namespace {
 
 int SetNonblock(int fd) {
@@ -85,12 +165,32 @@ class DirectionWaitStrategy final : public engine::impl::WaitStrategy {
   engine::impl::TaskContext& current_;
 };
 
+class IoUringWaitStrategy final : public engine::impl::WaitStrategy {
+ public:
+  IoUringWaitStrategy(Deadline deadline, IoUringRequest& request,
+                      engine::impl::TaskContext& current)
+      : WaitStrategy(deadline), request_(request), current_(current) {}
+
+  void SetupWakeups() override {
+    request_.GetWaiters().Append(&current_);
+    if (request_.IsCompleted()) request_.GetWaiters().WakeupOne();
+  }
+
+  void DisableWakeups() override { request_.GetWaiters().Remove(current_); }
+
+ private:
+  IoUringRequest& request_;
+  engine::impl::TaskContext& current_;
+};
+
 }  // namespace
 
 Direction::Direction(Kind kind)
     : kind_(kind),
       is_valid_(false),
-      watcher_(current_task::GetEventThread(), this) {
+      ev_thread_(current_task::GetEventThread()),
+      io_uring_(ev_thread_.GetIoUring()),
+      watcher_(ev_thread_, this) {
   watcher_.Init(&IoWatcherCb);
 }
 
@@ -114,6 +214,49 @@ engine::impl::TaskContext::WakeupSource Direction::DoWait(Deadline deadline) {
   return current.Sleep(wait_manager);
 }
 
+Direction::IoUringResult Direction::DoIoUring(
+    const ev::IoUring::Request& request_data, Deadline deadline) {
+  UASSERT(io_uring_);
+  auto& current = current_task::GetCurrentTaskContext();
+  const boost::intrusive_ptr<IoUringRequest> request{
+      new IoUringRequest(request_data, *io_uring_)};
+
+  {
+    engine::impl::WaitList::Lock lock(*waiters_);
+    UASSERT(!io_uring_request_);
+    io_uring_request_ = request.get();
+  }
+  request->Submit(ev_thread_);
+
+  auto wakeup_source = engine::impl::TaskContext::WakeupSource::kNone;
+  {
+    IoUringWaitStrategy wait_strategy(deadline, *request, current);
+    while (!request->IsCompleted()) {
+      wakeup_source = current.Sleep(wait_strategy);
+      if (wakeup_source != engine::impl::TaskContext::WakeupSource::kWaitList) {
+        break;
+      }
+    }
+  }
+
+  if (!request->IsCompleted()) {
+    // The kernel may still use the buffers, the operation must be over
+    // before returning
+    request->Cancel(ev_thread_);
+    TaskCancellationBlocker block_cancel;
+    IoUringWaitStrategy wait_strategy({}, *request, current);
+    while (!request->IsCompleted()) {
+      current.Sleep(wait_strategy);
+    }
+  }
+
+  {
+    engine::impl::WaitList::Lock lock(*waiters_);
+    io_uring_request_ = nullptr;
+  }
+  return {request->GetResult(), wakeup_source};
+}
+
 void Direction::Reset(int fd) {
   UASSERT(!IsValid());
   UASSERT(fd_ == fd || fd_ == -1);
@@ -129,6 +272,8 @@ void Direction::StopWatcher() {
 
 void Direction::WakeupWaiters() {
   engine::impl::WaitList::Lock lock(*waiters_);
+  // closing the fd does not interrupt the io_uring operations on it
+  if (io_uring_request_) io_uring_request_->Cancel(ev_thread_);
   waiters_->WakeupAll(lock);
 }
 
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <sys/uio.h>
+
+#include <algorithm>
 #include <atomic>
 #include <cerrno>
+#include <climits>
+#include <type_traits>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/exception.hpp>
@@ -11,6 +16,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/io_uring.hpp>
 #include <engine/ev/watcher.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
@@ -27,7 +33,17 @@ enum class TransferMode {
   kOnce,     ///< operation will complete after the first successful transfer
 };
 
+/// IoFunc wrappers declare `static constexpr ev::IoUring::Op kIoUringOp` to
+/// have the blocked operations submitted to io_uring, if the ev thread has one
+template <typename IoFunc, typename = void>
+inline constexpr bool kHasIoUringOp = false;
+
+template <typename IoFunc>
+inline constexpr bool
+    kHasIoUringOp<IoFunc, std::void_t<decltype(IoFunc::kIoUringOp)>> = true;
+
 class FdControl;
+class IoUringRequest;
 
 class Direction final {
  public:
@@ -54,18 +70,42 @@ class Direction final {
 
   [[nodiscard]] bool Wait(Deadline);
 
+  /// Whether the ev thread of the direction submits I/O to io_uring
+  bool HasIoUring() const { return io_uring_ != nullptr; }
+
+  /// @brief Submits the operation to io_uring and waits for its completion.
+  /// @returns the result of the operation, or -1 with errno set on errors
+  /// @throws IoTimeout, IoCancelled or IoException if the operation was
+  /// interrupted by the deadline, task cancellation or the fd close
+  template <typename... Context>
+  ssize_t PerformIoUring(ev::IoUring::Request& request, Deadline deadline,
+                         size_t bytes_transferred, const Context&... context);
+
   // (IoFunc*)(int, void*, size_t), e.g. read
   template <typename IoFunc, typename... Context>
   size_t PerformIo(Lock& lock, IoFunc&& io_func, void* buf, size_t len,
                    TransferMode mode, Deadline deadline,
                    const Context&... context);
 
+  // (IoFunc*)(int, struct iovec*, size_t), e.g. writev
+  // Contents of the `list` are modified to track partial transfers.
+  template <typename IoFunc, typename... Context>
+  size_t PerformIoV(Lock& lock, IoFunc&& io_func, struct iovec* list,
+                    size_t list_size, TransferMode mode, Deadline deadline,
+                    const Context&... context);
+
  private:
   friend class FdControl;
   explicit Direction(Kind kind);
 
   engine::impl::TaskContext::WakeupSource DoWait(Deadline);
 
+  struct IoUringResult {
+    int result;
+    engine::impl::TaskContext::WakeupSource wakeup_source;
+  };
+  IoUringResult DoIoUring(const ev::IoUring::Request& request, Deadline);
+
   void Reset(int fd);
   void StopWatcher();
   void WakeupWaiters();
@@ -80,7 +120,11 @@ class Direction final {
   std::atomic<bool> is_valid_;
   Mutex mutex_;
   engine::impl::FastPimplWaitList waiters_;
+  ev::ThreadControl ev_thread_;
+  ev::IoUring* const io_uring_;
   ev::Watcher<ev_io> watcher_;
+  // the request in flight, guarded by the lock of waiters_
+  IoUringRequest* io_uring_request_{nullptr};
 };
 
 class FdControl final {
@@ -115,6 +159,29 @@ class FdControl final {
   Direction write_;
 };
 
+template <typename... Context>
+ssize_t Direction::PerformIoUring(ev::IoUring::Request& request,
+                                  Deadline deadline, size_t bytes_transferred,
+                                  const Context&... context) {
+  UASSERT(io_uring_);
+  const auto [result, wakeup_source] = DoIoUring(request, deadline);
+  if (result >= 0) return result;
+
+  if (result == -ECANCELED) {
+    if (!IsValid()) {
+      throw((IoException() << "Fd closed during ") << ... << context);
+    }
+    if (wakeup_source ==
+        engine::impl::TaskContext::WakeupSource::kDeadlineTimer) {
+      throw(IoTimeout(bytes_transferred) << ... << context);
+    }
+    throw(IoCancelled(bytes_transferred) << ... << context);
+  }
+
+  errno = -result;
+  return -1;
+}
+
 template <typename IoFunc, typename... Context>
 size_t Direction::PerformIo(Lock&, IoFunc&& io_func, void* buf, size_t len,
                             TransferMode mode, Deadline deadline,
@@ -127,6 +194,22 @@ size_t Direction::PerformIo(Lock&, IoFunc&& io_func, void* buf, size_t len,
   while (pos < end) {
     auto chunk_size = io_func(fd_, pos, end - pos);
 
+    if constexpr (kHasIoUringOp<std::decay_t<IoFunc>>) {
+      if (chunk_size == -1 && (errno == EWOULDBLOCK || errno == EAGAIN) &&
+          io_uring_ && (pos == begin || mode == TransferMode::kWhole)) {
+        if (current_task::ShouldCancel()) {
+          throw(IoCancelled(/*bytes_transferred =*/pos - begin)
+                << ... << context);
+        }
+        ev::IoUring::Request request;
+        request.op = std::decay_t<IoFunc>::kIoUringOp;
+        request.fd = fd_;
+        request.data = pos;
+        request.size = end - pos;
+        chunk_size = PerformIoUring(request, deadline, pos - begin, context...);
+      }
+    }
+
     if (chunk_size > 0) {
       pos += chunk_size;
       if (mode == TransferMode::kOnce) {
@@ -171,6 +254,102 @@ size_t Direction::PerformIo(Lock&, IoFunc&& io_func, void* buf, size_t len,
   return pos - begin;
 }
 
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformIoV(Lock&, IoFunc&& io_func, struct iovec* list,
+                             size_t list_size, TransferMode mode,
+                             Deadline deadline, const Context&... context) {
+  // MAC_COMPAT: IOV_MAX may be missing
+#ifdef IOV_MAX
+  static constexpr size_t kMaxIovCount = IOV_MAX;
+#else
+  static constexpr size_t kMaxIovCount = 1024;
+#endif
+
+  struct iovec* pos = list;
+  struct iovec* const end = list + list_size;
+  size_t transferred = 0;
+
+  const auto skip_transferred = [&pos, end](size_t chunk_size) {
+    while (pos < end && chunk_size >= pos->iov_len) {
+      chunk_size -= pos->iov_len;
+      ++pos;
+    }
+    if (chunk_size) {
+      UASSERT(pos < end);
+      pos->iov_base = static_cast<char*>(pos->iov_base) + chunk_size;
+      pos->iov_len -= chunk_size;
+    }
+  };
+
+  skip_transferred(0);
+  while (pos < end) {
+    const auto iov_count =
+        std::min(static_cast<size_t>(end - pos), kMaxIovCount);
+    auto chunk_size = io_func(fd_, pos, iov_count);
+
+    if constexpr (kHasIoUringOp<std::decay_t<IoFunc>>) {
+      if (chunk_size == -1 && (errno == EWOULDBLOCK || errno == EAGAIN) &&
+          io_uring_ && (!transferred || mode == TransferMode::kWhole)) {
+        if (current_task::ShouldCancel()) {
+          throw(IoCancelled(/*bytes_transferred =*/transferred) << ... <<
+                context);
+        }
+        struct msghdr msg {};
+        msg.msg_iov = pos;
+        msg.msg_iovlen = iov_count;
+        ev::IoUring::Request request;
+        request.op = std::decay_t<IoFunc>::kIoUringOp;
+        request.fd = fd_;
+        request.msg = &msg;
+        chunk_size = PerformIoUring(request, deadline, transferred, context...);
+      }
+    }
+
+    if (chunk_size > 0) {
+      transferred += chunk_size;
+      skip_transferred(chunk_size);
+      if (mode == TransferMode::kOnce) {
+        break;
+      }
+    } else if (!chunk_size) {
+      break;
+    } else if (errno == EINTR) {
+      continue;
+    } else if (errno == EWOULDBLOCK || errno == EAGAIN) {
+      if (transferred && mode != TransferMode::kWhole) {
+        break;
+      }
+      if (current_task::ShouldCancel()) {
+        throw(IoCancelled(/*bytes_transferred =*/transferred) << ... <<
+              context);
+      }
+      if (DoWait(deadline) ==
+          engine::impl::TaskContext::WakeupSource::kDeadlineTimer) {
+        throw(IoTimeout(/*bytes_transferred =*/transferred) << ... << context);
+      }
+      if (!IsValid()) {
+        throw((IoException() << "Fd closed during ") << ... << context);
+      }
+    } else {
+      const auto err_value = errno;
+      IoSystemError ex(err_value, "Direction::PerformIoV");
+      ex << "Error while ";
+      (ex << ... << context);
+      ex << ", fd=" << fd_;
+      auto log_level = logging::Level::kError;
+      if (err_value == ECONNRESET || err_value == EPIPE) {
+        log_level = logging::Level::kWarning;
+      }
+      LOG(log_level) << ex;
+      if (transferred) {
+        break;
+      }
+      throw std::move(ex);
+    }
+  }
+  return transferred;
+}
+
 }  // namespace engine::io::impl
 
 USERVER_NAMESPACE_END
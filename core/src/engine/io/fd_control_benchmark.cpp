@@ -1,7 +1,12 @@
 #include <benchmark/benchmark.h>
 
+#include <sys/socket.h>
 #include <unistd.h>
 
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/io/pipe.hpp>
+#include <userver/engine/io/socket.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -94,4 +99,81 @@ void fd_control_construct_wait_destroy(benchmark::State& state) {
 }
 BENCHMARK(fd_control_construct_wait_destroy);
 
+namespace {
+
+engine::TaskProcessorPoolsConfig MakeConfig(const benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_io_uring = state.range(0);
+  return config;
+}
+
+template <typename Reader, typename Writer>
+void Echo(Reader& reader, Writer& writer) {
+  char c = 0;
+  try {
+    while (true) {
+      reader(&c, 1);
+      writer(&c, 1);
+    }
+  } catch (const io::IoException&) {
+    // cancelled
+  }
+}
+
+}  // namespace
+
+// A byte is bounced between two tasks, each read has to wait for the data.
+// Arg is whether the blocked operations are submitted to io_uring.
+void fd_control_pipe_ping_pong(benchmark::State& state) {
+  engine::RunStandalone(2, MakeConfig(state), [&] {
+    io::Pipe ping;
+    io::Pipe pong;
+
+    auto read_ping = [&](char* c, size_t len) {
+      return ping.reader.ReadAll(c, len, {});
+    };
+    auto write_pong = [&](char* c, size_t len) {
+      return pong.writer.WriteAll(c, len, {});
+    };
+    auto echo_task =
+        engine::AsyncNoSpan([&] { Echo(read_ping, write_pong); });
+
+    char c = 'x';
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(ping.writer.WriteAll(&c, 1, {}));
+      benchmark::DoNotOptimize(pong.reader.ReadAll(&c, 1, {}));
+    }
+
+    echo_task.SyncCancel();
+  });
+}
+BENCHMARK(fd_control_pipe_ping_pong)->Arg(false)->Arg(true);
+
+void fd_control_socket_ping_pong(benchmark::State& state) {
+  engine::RunStandalone(2, MakeConfig(state), [&] {
+    int fds[2];
+    utils::CheckSyscall(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds),
+                        "creating socket pair");
+    io::Socket first{fds[0]};
+    io::Socket second{fds[1]};
+
+    auto recv = [&](char* c, size_t len) {
+      return second.RecvAll(c, len, {});
+    };
+    auto send = [&](char* c, size_t len) {
+      return second.SendAll(c, len, {});
+    };
+    auto echo_task = engine::AsyncNoSpan([&] { Echo(recv, send); });
+
+    char c = 'x';
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(first.SendAll(&c, 1, {}));
+      benchmark::DoNotOptimize(first.RecvAll(&c, 1, {}));
+    }
+
+    echo_task.SyncCancel();
+  });
+}
+BENCHMARK(fd_control_socket_ping_pong)->Arg(false)->Arg(true);
+
 USERVER_NAMESPACE_END
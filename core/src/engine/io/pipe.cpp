@@ -16,6 +16,27 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
+namespace {
+
+// IoFunc wrappers for Direction::PerformIo
+
+struct ReadWrapper final {
+  static constexpr auto kIoUringOp = ev::IoUring::Op::kRead;
+
+  [[nodiscard]] ssize_t operator()(int fd, void* buf, size_t len) const {
+    return ::read(fd, buf, len);
+  }
+};
+
+struct WriteWrapper final {
+  static constexpr auto kIoUringOp = ev::IoUring::Op::kWrite;
+
+  [[nodiscard]] ssize_t operator()(int fd, const void* buf, size_t len) const {
+    return ::write(fd, buf, len);
+  }
+};
+
+}  // namespace
 
 Pipe::Pipe() {
   std::array<int, 2> pipefd{-1, -1};
@@ -53,8 +74,9 @@ size_t PipeReader::ReadSome(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::Lock lock(dir);
-  return dir.PerformIo(lock, &::read, buf, len, impl::TransferMode::kPartial,
-                       deadline, "ReadSome from pipe");
+  return dir.PerformIo(lock, ReadWrapper{}, buf, len,
+                       impl::TransferMode::kPartial, deadline,
+                       "ReadSome from pipe");
 }
 
 size_t PipeReader::ReadAll(void* buf, size_t len, Deadline deadline) {
@@ -63,8 +85,9 @@ size_t PipeReader::ReadAll(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::Lock lock(dir);
-  return dir.PerformIo(lock, &::read, buf, len, impl::TransferMode::kWhole,
-                       deadline, "ReadAll from pipe");
+  return dir.PerformIo(lock, ReadWrapper{}, buf, len,
+                       impl::TransferMode::kWhole, deadline,
+                       "ReadAll from pipe");
 }
 
 int PipeReader::Fd() const {
@@ -98,7 +121,7 @@ size_t PipeWriter::WriteAll(const void* buf, size_t len, Deadline deadline) {
   auto& dir = fd_control_->Write();
   impl::Direction::Lock lock(dir);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return dir.PerformIo(lock, &::write, const_cast<void*>(buf), len,
+  return dir.PerformIo(lock, WriteWrapper{}, const_cast<void*>(buf), len,
                        impl::TransferMode::kWhole, deadline,
                        "WriteAll to pipe");
 }
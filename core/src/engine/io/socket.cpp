@@ -7,6 +7,8 @@
 #include <cerrno>
 #include <string>
 
+#include <boost/container/small_vector.hpp>
+
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
@@ -52,18 +54,43 @@ Sockaddr& MemoizeAddr(Sockaddr& addr, decltype(&::getpeername) getter,
 
 // IoFunc wrappers for Direction::PerformIo
 
-[[nodiscard]] ssize_t RecvWrapper(int fd, void* buf, size_t len) {
-  return ::recv(fd, buf, len, 0);
-}
+struct RecvWrapper final {
+  static constexpr auto kIoUringOp = ev::IoUring::Op::kRecv;
+
+  [[nodiscard]] ssize_t operator()(int fd, void* buf, size_t len) const {
+    return ::recv(fd, buf, len, 0);
+  }
+};
 
-[[nodiscard]] ssize_t SendWrapper(int fd, const void* buf, size_t len) {
-  return ::send(fd, buf, len,
+struct SendWrapper final {
+  static constexpr auto kIoUringOp = ev::IoUring::Op::kSend;
+
+  [[nodiscard]] ssize_t operator()(int fd, const void* buf, size_t len) const {
+    return ::send(fd, buf, len,
 // MAC_COMPAT: does not support MSG_NOSIGNAL
 #ifdef MSG_NOSIGNAL
-                MSG_NOSIGNAL |
+                  MSG_NOSIGNAL |
 #endif
-                    0);
-}
+                      0);
+  }
+};
+
+struct SendMsgWrapper final {
+  static constexpr auto kIoUringOp = ev::IoUring::Op::kSendMsg;
+
+  [[nodiscard]] ssize_t operator()(int fd, struct iovec* list,
+                                   size_t list_size) const {
+    struct msghdr msg {};
+    msg.msg_iov = list;
+    msg.msg_iovlen = list_size;
+    return ::sendmsg(fd, &msg,
+// MAC_COMPAT: does not support MSG_NOSIGNAL
+#ifdef MSG_NOSIGNAL
+                     MSG_NOSIGNAL |
+#endif
+                         0);
+  }
+};
 
 class RecvFromWrapper {
  public:
@@ -206,7 +233,7 @@ size_t Socket::RecvSome(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::Lock lock(dir);
-  return dir.PerformIo(lock, &RecvWrapper, buf, len,
+  return dir.PerformIo(lock, RecvWrapper{}, buf, len,
                        impl::TransferMode::kPartial, deadline, "RecvSome from ",
                        peername_);
 }
@@ -217,8 +244,9 @@ size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::Lock lock(dir);
-  return dir.PerformIo(lock, &RecvWrapper, buf, len, impl::TransferMode::kWhole,
-                       deadline, "RecvAll from ", peername_);
+  return dir.PerformIo(lock, RecvWrapper{}, buf, len,
+                       impl::TransferMode::kWhole, deadline, "RecvAll from ",
+                       peername_);
 }
 
 size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
@@ -228,11 +256,37 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
   auto& dir = fd_control_->Write();
   impl::Direction::Lock lock(dir);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return dir.PerformIo(lock, &SendWrapper, const_cast<void*>(buf), len,
+  return dir.PerformIo(lock, SendWrapper{}, const_cast<void*>(buf), len,
                        impl::TransferMode::kWhole, deadline, "SendAll to ",
                        peername_);
 }
 
+size_t Socket::SendAll(std::initializer_list<IoData> list,
+                       Deadline deadline) {
+  return SendAll(list.begin(), list.size(), deadline);
+}
+
+size_t Socket::SendAll(const IoData* list, size_t list_size,
+                       Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to SendAll to closed socket");
+  }
+
+  static constexpr size_t kTypicalIovCount = 8;
+  boost::container::small_vector<struct iovec, kTypicalIovCount> iov;
+  iov.reserve(list_size);
+  for (size_t i = 0; i < list_size; ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    iov.push_back({const_cast<void*>(list[i].data), list[i].len});
+  }
+
+  auto& dir = fd_control_->Write();
+  impl::Direction::Lock lock(dir);
+  return dir.PerformIoV(lock, SendMsgWrapper{}, iov.data(), iov.size(),
+                        impl::TransferMode::kWhole, deadline, "SendAll to ",
+                        peername_);
+}
+
 Socket::RecvFromResult Socket::RecvSomeFrom(void* buf, size_t len,
                                             Deadline deadline) {
   if (!IsValid()) {
@@ -300,6 +354,26 @@ Socket Socket::Accept(Deadline deadline) {
 #if EAGAIN != EWOULDBLOCK
       case EWOULDBLOCK:
 #endif
+        if (dir.HasIoUring()) {
+          if (current_task::ShouldCancel()) {
+            throw IoCancelled() << "Accept";
+          }
+          ev::IoUring::Request request;
+          request.op = ev::IoUring::Op::kAccept;
+          request.fd = dir.Fd();
+          request.addr = buf.Data();
+          len = buf.Capacity();
+          request.addrlen = &len;
+          fd = dir.PerformIoUring(request, deadline, 0, "Accept");
+          if (fd != -1) {
+            UASSERT(len <= buf.Capacity());
+            auto peersock = Socket(fd);
+            peersock.peername_ = buf;
+            return peersock;
+          }
+          // other errors are handled by the next accept() call
+          if (errno != EAGAIN) break;
+        }
         if (!WaitReadable(deadline)) {
           if (current_task::ShouldCancel()) {
             throw IoCancelled() << "Accept";
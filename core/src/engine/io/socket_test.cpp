@@ -6,6 +6,7 @@
 
 #include <cerrno>
 #include <cstdlib>
+#include <string>
 #include <string_view>
 
 #include <userver/engine/async.hpp>
@@ -13,6 +14,7 @@
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utest/net_listener.hpp>
@@ -26,6 +28,13 @@ using Deadline = engine::Deadline;
 using TcpListener = utest::TcpListener;
 using UdpListener = utest::UdpListener;
 
+// Falls back to libev if the kernel does not support io_uring
+void RunWithIoUring(std::function<void()> payload) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_io_uring = true;
+  engine::RunStandalone(2, config, std::move(payload));
+}
+
 }  // namespace
 
 UTEST(Socket, ConnectFail) {
@@ -198,6 +207,33 @@ UTEST(Socket, Cancel) {
   });
 }
 
+UTEST(Socket, SendAllVectored) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener listener;
+  auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+  // Larger than the socket buffers, so that partial writes do happen
+  const std::string head = "head";
+  const std::string body(client.GetOption(SOL_SOCKET, SO_RCVBUF) * 4, 'b');
+  const std::string tail = "tail";
+  const auto total_size = head.size() + body.size() + tail.size();
+
+  auto send_task = engine::AsyncNoSpan([&, &server = server] {
+    return server.SendAll({{head.data(), head.size()},
+                           {nullptr, 0},
+                           {body.data(), body.size()},
+                           {tail.data(), tail.size()}},
+                          test_deadline);
+  });
+
+  std::string received(total_size, '\0');
+  EXPECT_EQ(total_size,
+            client.RecvAll(received.data(), received.size(), test_deadline));
+  EXPECT_EQ(total_size, send_task.Get());
+  EXPECT_EQ(head + body + tail, received);
+}
+
 UTEST(Socket, ErrorPeername) {
   const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
@@ -326,4 +362,94 @@ UTEST(Socket, DgramUnbound) {
   listen_task.Get();
 }
 
+TEST(SocketIoUring, SendRecv) {
+  RunWithIoUring([] {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+    // The receiver blocks before the data is sent
+    auto recv_task = engine::AsyncNoSpan([&, &client = client] {
+      std::string received(4, '\0');
+      const auto size =
+          client.RecvAll(received.data(), received.size(), test_deadline);
+      received.resize(size);
+      return received;
+    });
+    engine::Yield();
+    EXPECT_EQ(4, server.SendAll("ping", 4, test_deadline));
+    EXPECT_EQ("ping", recv_task.Get());
+
+    // Larger than the socket buffers, so that the sender blocks
+    const std::string body(client.GetOption(SOL_SOCKET, SO_RCVBUF) * 4, 'b');
+    auto send_task = engine::AsyncNoSpan([&, &server = server] {
+      return server.SendAll({{"head", 4}, {body.data(), body.size()}},
+                            test_deadline);
+    });
+    std::string received(body.size() + 4, '\0');
+    EXPECT_EQ(received.size(),
+              client.RecvAll(received.data(), received.size(), test_deadline));
+    EXPECT_EQ(received.size(), send_task.Get());
+    EXPECT_EQ("head" + body, received);
+  });
+}
+
+TEST(SocketIoUring, Accept) {
+  RunWithIoUring([] {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener listener;
+    auto accept_task = engine::AsyncNoSpan(
+        [&] { return listener.socket.Accept(test_deadline); });
+    engine::Yield();
+
+    io::Socket client{listener.addr.Domain(), listener.type};
+    client.Connect(listener.addr, test_deadline);
+    auto server = accept_task.Get();
+    EXPECT_EQ(client.Getsockname().Port(), server.Getpeername().Port());
+  });
+}
+
+TEST(SocketIoUring, Timeout) {
+  RunWithIoUring([] {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+    char c = 0;
+    const auto short_deadline =
+        Deadline::FromDuration(std::chrono::milliseconds(10));
+    UEXPECT_THROW([[maybe_unused]] auto received =
+                      client.RecvSome(&c, 1, short_deadline),
+                  io::IoTimeout);
+
+    // No data is lost with the interrupted operation
+    EXPECT_EQ(1, server.SendAll("x", 1, test_deadline));
+    EXPECT_EQ(1, client.RecvSome(&c, 1, test_deadline));
+    EXPECT_EQ('x', c);
+  });
+}
+
+TEST(SocketIoUring, Cancel) {
+  RunWithIoUring([] {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+    engine::SingleConsumerEvent has_started_event;
+    auto recv_task = engine::AsyncNoSpan([&, &client = client] {
+      has_started_event.Send();
+      char c = 0;
+      [[maybe_unused]] auto received = client.RecvSome(&c, 1, test_deadline);
+    });
+    ASSERT_TRUE(has_started_event.WaitForEvent());
+    engine::Yield();
+    recv_task.RequestCancel();
+    UEXPECT_THROW(recv_task.Get(), io::IoCancelled);
+  });
+}
+
 USERVER_NAMESPACE_END
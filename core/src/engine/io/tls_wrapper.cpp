@@ -232,6 +232,41 @@ SslCtx MakeSslCtx() {
   return ssl_ctx;
 }
 
+// Encodes the protocol list into the ALPN wire format: each name is prefixed
+// with its length
+std::string MakeAlpnProtocolList(const std::vector<std::string>& protocols) {
+  std::string result;
+  for (const auto& protocol : protocols) {
+    if (protocol.empty() || protocol.size() > 255) {
+      throw TlsException(
+          fmt::format("Invalid ALPN protocol name '{}'", protocol));
+    }
+    result += static_cast<char>(protocol.size());
+    result += protocol;
+  }
+  return result;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+int AlpnSelectCallback(SSL*, const unsigned char** out, unsigned char* outlen,
+                       const unsigned char* in, unsigned int inlen,
+                       void* arg) noexcept {
+  const auto* server_protocols = static_cast<const std::string*>(arg);
+  UASSERT(server_protocols);
+
+  unsigned char* selected = nullptr;
+  if (OPENSSL_NPN_NEGOTIATED !=
+      SSL_select_next_proto(
+          &selected, outlen,
+          reinterpret_cast<const unsigned char*>(server_protocols->data()),
+          server_protocols->size(), in, inlen)) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  *out = selected;
+  return SSL_TLSEXT_ERR_OK;
+}
+#endif
+
 enum InterruptAction {
   kPass,
   kFail,
@@ -341,11 +376,27 @@ class TlsWrapper::Impl {
 
 TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {}
 
-TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
-                                      const std::string& server_name,
-                                      Deadline deadline) {
+TlsWrapper TlsWrapper::StartTlsClient(
+    Socket&& socket, const std::string& server_name, Deadline deadline,
+    const std::vector<std::string>& alpn_protocols) {
   auto ssl_ctx = MakeSslCtx();
 
+  if (!alpn_protocols.empty()) {
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+    const auto protocol_list = MakeAlpnProtocolList(alpn_protocols);
+    // returns 0 on success, unlike most of the openssl functions
+    if (0 != SSL_CTX_set_alpn_protos(
+                 ssl_ctx.get(),
+                 reinterpret_cast<const unsigned char*>(protocol_list.data()),
+                 protocol_list.size())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to set up client TLS wrapper: SSL_CTX_set_alpn_protos"));
+    }
+#else
+    throw TlsException("ALPN is not supported by this openssl version");
+#endif
+  }
+
   if (!server_name.empty()) {
     X509_VERIFY_PARAM* verify_param = SSL_CTX_get0_param(ssl_ctx.get());
     if (!verify_param) {
@@ -390,9 +441,23 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& cert_authorities) {
+    const std::vector<crypto::Certificate>& cert_authorities,
+    const std::vector<std::string>& alpn_protocols) {
   auto ssl_ctx = MakeSslCtx();
 
+  // must outlive the handshake, the callback is reset right after it
+  const auto alpn_protocol_list = MakeAlpnProtocolList(alpn_protocols);
+  if (!alpn_protocol_list.empty()) {
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+    SSL_CTX_set_alpn_select_cb(
+        ssl_ctx.get(), &AlpnSelectCallback,
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        const_cast<std::string*>(&alpn_protocol_list));
+#else
+    throw TlsException("ALPN is not supported by this openssl version");
+#endif
+  }
+
   if (!cert_authorities.empty()) {
     auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
     for (const auto& ca : cert_authorities) {
@@ -418,6 +483,13 @@ TlsWrapper TlsWrapper::StartTlsServer(
   wrapper.impl_->bio_data.current_deadline = deadline;
 
   auto ret = SSL_accept(wrapper.impl_->ssl.get());
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+  if (!alpn_protocol_list.empty()) {
+    // renegotiation is disabled, the protocol list is not needed any more
+    SSL_CTX_set_alpn_select_cb(SSL_get_SSL_CTX(wrapper.impl_->ssl.get()),
+                               nullptr, nullptr);
+  }
+#endif
   if (1 != ret) {
     if (wrapper.impl_->bio_data.last_exception) {
       std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
@@ -444,6 +516,19 @@ bool TlsWrapper::IsValid() const {
   return impl_->ssl && !impl_->is_in_shutdown;
 }
 
+std::string TlsWrapper::GetAlpnProtocol() const {
+  impl_->CheckAlive();
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+  const unsigned char* data = nullptr;
+  unsigned int len = 0;
+  SSL_get0_alpn_selected(impl_->ssl.get(), &data, &len);
+  if (!data) return {};
+  return std::string(reinterpret_cast<const char*>(data), len);
+#else
+  return {};
+#endif
+}
+
 bool TlsWrapper::WaitReadable(Deadline deadline) {
   impl_->CheckAlive();
   char buf = 0;
@@ -477,6 +562,42 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
                              deadline, "SendAll");
 }
 
+size_t TlsWrapper::SendAll(std::initializer_list<IoData> list,
+                           Deadline deadline) {
+  return SendAll(list.begin(), list.size(), deadline);
+}
+
+size_t TlsWrapper::SendAll(const IoData* list, size_t list_size,
+                           Deadline deadline) {
+  impl_->CheckAlive();
+
+  // There is no vectored SSL_write, so small buffers are coalesced up to the
+  // maximum TLS record size and the large ones are written directly.
+  static constexpr size_t kMaxTlsRecordSize = 16 * 1024;
+
+  std::string pending;
+  size_t sent_bytes = 0;
+  const auto flush_pending = [&] {
+    if (pending.empty()) return;
+    sent_bytes += SendAll(pending.data(), pending.size(), deadline);
+    pending.clear();
+  };
+
+  for (size_t i = 0; i < list_size; ++i) {
+    const auto& io_data = list[i];
+    if (pending.size() + io_data.len > kMaxTlsRecordSize) flush_pending();
+
+    if (io_data.len < kMaxTlsRecordSize) {
+      if (pending.empty()) pending.reserve(kMaxTlsRecordSize);
+      pending.append(static_cast<const char*>(io_data.data), io_data.len);
+    } else {
+      sent_bytes += SendAll(io_data.data, io_data.len, deadline);
+    }
+  }
+  flush_pending();
+  return sent_bytes;
+}
+
 Socket TlsWrapper::StopTls(Deadline deadline) {
   if (impl_->ssl) {
     impl_->is_in_shutdown = true;
@@ -181,6 +181,58 @@ UTEST_MT(TlsWrapper, Smoke, 2) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, Alpn, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [test_deadline](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::move(server), crypto::Certificate::LoadFromString(cert),
+            crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+            {"h2", "http/1.1"});
+        EXPECT_EQ("h2", tls_server.GetAlpnProtocol());
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+      },
+      std::move(server));
+
+  auto tls_client = io::TlsWrapper::StartTlsClient(
+      std::move(client), {}, test_deadline, {"http/1.1", "h2"});
+  char c = 0;
+  EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+  EXPECT_EQ("h2", tls_client.GetAlpnProtocol());
+
+  server_task.Get();
+}
+
+UTEST_MT(TlsWrapper, AlpnMismatch, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [test_deadline](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::move(server), crypto::Certificate::LoadFromString(cert),
+            crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+            {"h2"});
+        EXPECT_EQ("", tls_server.GetAlpnProtocol());
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+      },
+      std::move(server));
+
+  auto tls_client = io::TlsWrapper::StartTlsClient(
+      std::move(client), {}, test_deadline, {"http/1.1"});
+  char c = 0;
+  EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+  EXPECT_EQ("", tls_client.GetAlpnProtocol());
+
+  server_task.Get();
+}
+
 UTEST_MT(TlsWrapper, DocTest, 2) {
   static constexpr std::string_view kData = "hello world";
   const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
@@ -3,6 +3,7 @@
 #include <engine/ev/thread_control.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 
 using namespace std::chrono_literals;
@@ -45,6 +46,26 @@ BENCHMARK(run_in_ev_loop_benchmark);
 }
 BENCHMARK(successful_wait_for_benchmark);
 
+// Both tasks rearm their deadline timers on each wakeup, the deadlines are
+// never reached
+void wakeup_before_deadline_benchmark(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    engine::SingleConsumerEvent ping;
+    engine::SingleConsumerEvent pong;
+
+    auto task = engine::AsyncNoSpan([&] {
+      while (ping.WaitForEventFor(20s)) pong.Send();
+    });
+
+    for (auto _ : state) {
+      ping.Send();
+      if (!pong.WaitForEventFor(20s)) abort();
+    }
+    task.SyncCancel();
+  });
+}
+BENCHMARK(wakeup_before_deadline_benchmark);
+
 void unreached_task_deadline_benchmark(benchmark::State& state,
                                        bool has_task_deadline) {
   engine::RunStandalone([&] {
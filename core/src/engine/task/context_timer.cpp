@@ -1,19 +1,32 @@
 #include <engine/task/context_timer.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <utility>
 
 #include <engine/ev/async_payload_base.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <engine/ev/data_pipe_to_ev.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::impl {
 
-class ContextTimer::Impl final : public ev::AsyncPayloadBase {
+namespace {
+
+// The wheel fires up to a tick late, timers that are about to expire are
+// served by libev to keep the short sleeps precise
+constexpr std::chrono::milliseconds kTimerWheelMinTimeLeft{10};
+
+}  // namespace
+
+class ContextTimer::Impl final : public ev::AsyncPayloadBase,
+                                 private ev::TimerWheel::Entry {
  public:
   Impl();
   ~Impl();
@@ -33,10 +46,12 @@ class ContextTimer::Impl final : public ev::AsyncPayloadBase {
 
   ev::AsyncPayloadPtr SelfAsPayload() noexcept;
 
+  void UpdateInEvThread();
   void ArmTimerInEvThread();
   void StopTimerInEvThread() noexcept;
 
   static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void OnTimerWheel(ev::TimerWheel::Entry& entry) noexcept;
   void DoOnTimer();
 
   struct Params {
@@ -46,14 +61,25 @@ class ContextTimer::Impl final : public ev::AsyncPayloadBase {
 
   boost::intrusive_ptr<TaskContext> context_;
   std::optional<ev::ThreadControl> thread_control_;
+  ev::TimerWheel* timer_wheel_{nullptr};
   Params params_;
   ev_timer timer_{};
 
   using ParamsPipe = ev::DataPipeToEv<Params>;
   ParamsPipe params_pipe_to_ev_;
+
+  // Restart() bumps the version after pushing the params, the ev thread
+  // rechecks it after publishing `wheel_wakeup_`
+  std::atomic<std::uint64_t> params_version_{0};
+
+  // The ev thread is going to look at the params from the pipe no later than
+  // the tick after this deadline. Restart() with a later deadline does not
+  // have to notify it. Unreachable while the timer is not in the wheel.
+  std::atomic<Deadline> wheel_wakeup_{Deadline{}};
 };
 
-ContextTimer::Impl::Impl() : ev::AsyncPayloadBase(&Release) {
+ContextTimer::Impl::Impl()
+    : ev::AsyncPayloadBase(&Release), ev::TimerWheel::Entry(&OnTimerWheel) {
   timer_.data = this;
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
   ev_init(&timer_, OnTimer);
@@ -75,13 +101,14 @@ void ContextTimer::Impl::Start(boost::intrusive_ptr<TaskContext>&& context,
   UASSERT(!thread_control_);
   context_ = std::move(context);
   thread_control_.emplace(thread_control);
+  timer_wheel_ = thread_control.GetTimerWheel();
   params_ = {std::move(on_timer_func), deadline};
 
   thread_control_->RunInEvLoopDeferred(
       [](ev::AsyncPayloadPtr&& data) {
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
         auto& self = static_cast<Impl&>(*data);
-        self.ArmTimerInEvThread();
+        self.UpdateInEvThread();
       },
       SelfAsPayload(), params_.deadline);
 }
@@ -89,18 +116,19 @@ void ContextTimer::Impl::Start(boost::intrusive_ptr<TaskContext>&& context,
 void ContextTimer::Impl::Restart(Func&& on_timer_func, Deadline deadline) {
   UASSERT(WasStarted());
   params_pipe_to_ev_.Push({std::move(on_timer_func), deadline});
+  params_version_.fetch_add(1);
+
+  // The common case of a task that is woken up before its deadline and then
+  // sleeps again with a later one: the timer is still in the wheel and the ev
+  // thread picks up the new params once the old tick is reached, no round
+  // trip to the ev thread is needed.
+  if (wheel_wakeup_.load() < deadline) return;
 
   thread_control_->RunInEvLoopDeferred(
       [](ev::AsyncPayloadPtr&& data) {
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
         auto& self = static_cast<Impl&>(*data);
-        auto params = self.params_pipe_to_ev_.TryPop();
-        if (!params) {
-          return;
-        }
-
-        self.params_ = std::move(*params);
-        self.ArmTimerInEvThread();
+        self.UpdateInEvThread();
       },
       SelfAsPayload(), deadline);
 }
@@ -138,42 +166,89 @@ ev::AsyncPayloadPtr ContextTimer::Impl::SelfAsPayload() noexcept {
   return ev::AsyncPayloadPtr{this};
 }
 
+void ContextTimer::Impl::UpdateInEvThread() {
+  while (true) {
+    const auto version = params_version_.load();
+    auto params = params_pipe_to_ev_.TryPop();
+    if (params) params_ = std::move(*params);
+
+    ArmTimerInEvThread();
+
+    // A concurrent Restart() may have seen the old `wheel_wakeup_` and relied
+    // on us to pick up its params
+    if (params_version_.load() == version) return;
+  }
+}
+
 void ContextTimer::Impl::ArmTimerInEvThread() {
+  if (!params_.on_timer_func) {
+    // the timer has already fired for these params
+    StopTimerInEvThread();
+    return;
+  }
+
   using LibEvDuration = std::chrono::duration<double>;
-  const auto time_left =
-      std::chrono::duration_cast<LibEvDuration>(params_.deadline.TimeLeft())
-          .count();
+  const auto time_left = params_.deadline.TimeLeft();
+  const auto time_left_seconds =
+      std::chrono::duration_cast<LibEvDuration>(time_left).count();
 
-  LOG_TRACE() << "time_left=" << time_left;
-  if (time_left <= 0.0) {
+  LOG_TRACE() << "time_left=" << time_left_seconds;
+  if (time_left_seconds <= 0.0) {
     // Optimization for for small deadlines or high load
     DoOnTimer();
     return;
   }
 
-  timer_.repeat = time_left;
+  if (timer_wheel_ && time_left >= kTimerWheelMinTimeLeft) {
+    thread_control_->Stop(timer_);
+    const auto tick = timer_wheel_->Link(
+        *this, ev::TimerWheel::ToTick(params_.deadline));
+    wheel_wakeup_.store(ev::TimerWheel::ToDeadline(tick - 1));
+    return;
+  }
+
+  if (timer_wheel_) timer_wheel_->Unlink(*this);
+  wheel_wakeup_.store({});
+
+  timer_.repeat = time_left_seconds;
   thread_control_->Again(timer_);
 }
 
 void ContextTimer::Impl::StopTimerInEvThread() noexcept {
   thread_control_->Stop(timer_);
+  if (timer_wheel_) timer_wheel_->Unlink(*this);
+  wheel_wakeup_.store({});
 }
 
 void ContextTimer::Impl::OnTimer(struct ev_loop*, ev_timer* w, int) noexcept {
   auto* ev_timer = static_cast<Impl*>(w->data);
   UASSERT(ev_timer != nullptr);
-  ev_timer->DoOnTimer();
+  try {
+    ev_timer->UpdateInEvThread();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "exception in timer update: " << ex;
+  }
+}
+
+void ContextTimer::Impl::OnTimerWheel(ev::TimerWheel::Entry& entry) noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+  auto& self = static_cast<Impl&>(entry);
+  try {
+    self.UpdateInEvThread();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "exception in timer update: " << ex;
+  }
 }
 
 void ContextTimer::Impl::DoOnTimer() {
+  StopTimerInEvThread();
   try {
     // do not keep the function object around for much longer
-    const auto on_timer_func = std::move(params_.on_timer_func);
+    const auto on_timer_func = std::exchange(params_.on_timer_func, {});
     on_timer_func(*context_);  // called in event loop
   } catch (const std::exception& ex) {
     LOG_ERROR() << "exception in on_timer_func: " << ex;
   }
-  StopTimerInEvThread();
 }
 
 ContextTimer::ContextTimer() = default;
@@ -39,6 +39,10 @@ class ContextTimer final {
 
   /// Restarts a running timer with specified params. More efficient than
   /// calling Stop() + Start().
+  ///
+  /// If the timer waits in the timer wheel of the ev thread for a tick that
+  /// is not after the new deadline, the new params are just handed over to the
+  /// ev thread, it picks them up when the tick is reached.
   void Restart(Func&& on_timer_func, Deadline deadline);
 
   /// Asynchronously stops the timer and destroys all held resources.
@@ -49,7 +53,7 @@ class ContextTimer final {
 
  private:
   class Impl;
-  utils::FastPimpl<Impl, 288, 16> impl_;
+  utils::FastPimpl<Impl, 320, 16> impl_;
 };
 
 }  // namespace engine::impl
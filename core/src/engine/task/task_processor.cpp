@@ -51,6 +51,16 @@ void EmitMagicNanosleep() {
   nanosleep(&ts, nullptr);
 }
 
+// Workers may migrate between CPUs if not pinned, so their NUMA node is
+// refreshed periodically
+constexpr std::size_t kNumaNodeUpdateInterval = 1024;
+
+impl::TaskProcessorPools::CoroPool& SelectCoroPool(
+    impl::TaskProcessorPools& pools, const TaskProcessorConfig& config) {
+  if (config.numa_node) return pools.GetNumaLocalCoroPool(*config.numa_node);
+  return pools.GetCoroPool();
+}
+
 void TaskProcessorThreadStartedHook() {
   utils::impl::AssertStaticRegistrationFinished();
   (void)utils::DefaultRandom();
@@ -68,6 +78,9 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
       task_profiler_threshold_{std::chrono::microseconds(0)},
       profiler_force_stacktrace_{false},
       pools_(std::move(pools)),
+      cpu_affinity_(
+          utils::ResolveCpuAffinity(config_.cpu_affinity, config_.numa_node)),
+      coro_pool_(SelectCoroPool(*pools_, config_)),
       is_shutting_down_(false),
       detached_contexts_(impl::DetachedTasksSyncBlock::StopMode::kCancel),
       max_task_queue_wait_time_(std::chrono::microseconds(0)),
@@ -77,10 +90,26 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
   try {
     LOG_INFO() << "creating task_processor " << Name() << " "
                << "worker_threads=" << config_.worker_threads
-               << " thread_name=" << config_.thread_name;
+               << " thread_name=" << config_.thread_name << " task_queue="
+               << (config_.task_queue == TaskQueueType::kWorkStealingTaskQueue
+                       ? "work-stealing"
+                       : "global")
+               << " cpu_affinity=["
+               << fmt::to_string(fmt::join(cpu_affinity_, ",")) << ']';
+    if (config_.task_queue == TaskQueueType::kWorkStealingTaskQueue) {
+      work_stealing_task_queue_ =
+          std::make_unique<impl::WorkStealingTaskQueue>(config_.worker_threads);
+    }
+    workers_numa_nodes_ =
+        std::make_unique<std::atomic<int>[]>(config_.worker_threads);
+    for (size_t i = 0; i < config_.worker_threads; ++i) {
+      workers_numa_nodes_[i] = -1;
+    }
+
     workers_.reserve(config_.worker_threads);
     for (size_t i = 0; i < config_.worker_threads; ++i) {
       workers_.emplace_back([this, i] {
+        utils::SetCurrentThreadCpuAffinity(cpu_affinity_);
         switch (config_.os_scheduling) {
           case OsScheduling::kNormal:
             break;
@@ -94,7 +123,7 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
 
         utils::SetCurrentThreadName(
             fmt::format("{}_{}", config_.thread_name, i));
-        ProcessTasks();
+        ProcessTasks(i);
       });
     }
   } catch (...) {
@@ -111,7 +140,11 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion(std::chrono::milliseconds(10));
 
-  task_queue_.enqueue(nullptr);
+  if (work_stealing_task_queue_) {
+    work_stealing_task_queue_->StopProcessing();
+  } else {
+    task_queue_.enqueue(nullptr);
+  }
 
   for (auto& w : workers_) {
     w.join();
@@ -146,10 +179,21 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
   // but oh well
   intrusive_ptr_add_ref(context);
 
-  task_queue_.enqueue(context);
+  if (work_stealing_task_queue_) {
+    work_stealing_task_queue_->Push(context);
+  } else {
+    task_queue_.enqueue(context);
+  }
   // NOTE: task may be executed at this point
 }
 
+size_t TaskProcessor::GetTaskQueueSize() const {
+  if (work_stealing_task_queue_) {
+    return work_stealing_task_queue_->GetSizeApproximate();
+  }
+  return task_queue_.size_approx();
+}
+
 void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_.Add(context);
 }
@@ -159,7 +203,7 @@ ev::ThreadPool& TaskProcessor::EventThreadPool() {
 }
 
 impl::CountedCoroutinePtr TaskProcessor::GetCoroutine() {
-  return {pools_->GetCoroPool().GetCoroutine(), *this};
+  return {coro_pool_.GetCoroutine(), *this};
 }
 
 void TaskProcessor::SetSettings(const TaskProcessorSettings& settings) {
@@ -228,6 +272,12 @@ logging::LoggerPtr TaskProcessor::GetTaskTraceLogger() const {
 }
 
 impl::TaskContext* TaskProcessor::DequeueTask() {
+  if (work_stealing_task_queue_) {
+    auto* context = work_stealing_task_queue_->PopBlocking();
+    GetTaskCounter().AccountTaskSwitchSlow();
+    return context;
+  }
+
   impl::TaskContext* buf = nullptr;
 
   /* Current thread handles only a single TaskProcessor, so it's safe to store
@@ -252,10 +302,26 @@ void RegisterThreadStartedHook(std::function<void()> func) {
   ThreadStartedHooks().push_back(std::move(func));
 }
 
-void TaskProcessor::ProcessTasks() noexcept {
+std::vector<int> TaskProcessor::GetWorkersNumaNodes() const {
+  std::vector<int> result;
+  result.reserve(workers_.size());
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    result.push_back(workers_numa_nodes_[i].load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+void TaskProcessor::ProcessTasks(std::size_t worker_index) noexcept {
   TaskProcessorThreadStartedHook();
 
+  auto& numa_node = workers_numa_nodes_[worker_index];
+  std::size_t tasks_processed = 0;
   while (true) {
+    if (tasks_processed++ % kNumaNodeUpdateInterval == 0) {
+      numa_node.store(utils::GetCurrentThreadNumaNode(),
+                      std::memory_order_relaxed);
+    }
+
     // wrapping instance referenced in EnqueueTask
     boost::intrusive_ptr<impl::TaskContext> context(DequeueTask(),
                                                     /* add_ref =*/false);
@@ -15,6 +15,7 @@
 #include <engine/task/counted_coroutine_ptr.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -55,10 +56,14 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.size_approx(); }
+  size_t GetTaskQueueSize() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
+  /// Returns the NUMA node each worker thread has been seen running on, -1 if
+  /// unknown
+  std::vector<int> GetWorkersNumaNodes() const;
+
   void SetSettings(const TaskProcessorSettings& settings);
 
   std::chrono::microseconds GetProfilerThreshold() const;
@@ -78,7 +83,7 @@ class TaskProcessor final {
 
   impl::TaskContext* DequeueTask();
 
-  void ProcessTasks() noexcept;
+  void ProcessTasks(std::size_t worker_index) noexcept;
 
   void CheckWaitTime(impl::TaskContext& context);
 
@@ -89,11 +94,15 @@ class TaskProcessor final {
   std::atomic<bool> profiler_force_stacktrace_{false};
 
   std::shared_ptr<impl::TaskProcessorPools> pools_;
+  const std::vector<std::size_t> cpu_affinity_;
+  coro::Pool<impl::TaskContext>& coro_pool_;
 
   std::atomic<bool> is_shutting_down_;
   impl::DetachedTasksSyncBlock detached_contexts_;
 
   moodycamel::BlockingConcurrentQueue<impl::TaskContext*> task_queue_;
+  // Used instead of task_queue_ for TaskQueueType::kWorkStealingTaskQueue
+  std::unique_ptr<impl::WorkStealingTaskQueue> work_stealing_task_queue_;
 
   std::atomic<std::chrono::microseconds> sensor_task_queue_wait_time_{};
   std::atomic<std::chrono::microseconds> max_task_queue_wait_time_{};
@@ -103,6 +112,7 @@ class TaskProcessor final {
   bool task_queue_wait_time_overloaded_{false};
 
   std::vector<std::thread> workers_;
+  std::unique_ptr<std::atomic<int>[]> workers_numa_nodes_;
   impl::TaskCounter task_counter_;
   std::atomic<bool> task_trace_logger_set_{false};
   logging::LoggerPtr task_trace_logger_{nullptr};
@@ -2,7 +2,9 @@
 
 #include <chrono>
 #include <cstddef>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
@@ -17,6 +19,11 @@ enum class OsScheduling {
   kIdle,
 };
 
+enum class TaskQueueType {
+  kGlobalTaskQueue,
+  kWorkStealingTaskQueue,
+};
+
 struct TaskProcessorConfig {
   std::string name;
 
@@ -24,6 +31,12 @@ struct TaskProcessorConfig {
   std::size_t worker_threads{6};
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
+  TaskQueueType task_queue{TaskQueueType::kGlobalTaskQueue};
+
+  // Worker threads are pinned to these CPUs, if not empty
+  std::vector<std::size_t> cpu_affinity;
+  // Worker threads are pinned to the CPUs of this NUMA node, if set
+  std::optional<std::size_t> numa_node;
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
@@ -1,6 +1,9 @@
 #include <engine/task/task_processor_pools.hpp>
 
+#include <algorithm>
+
 #include <engine/task/task_context.hpp>
+#include <utils/threads.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -8,10 +11,36 @@ namespace engine::impl {
 
 TaskProcessorPools::TaskProcessorPools(coro::PoolConfig coro_pool_config,
                                        ev::ThreadPoolConfig ev_pool_config)
-    : coro_pool_(std::move(coro_pool_config), &TaskContext::CoroFunc),
+    : coro_pool_config_(coro_pool_config),
+      coro_pool_(std::move(coro_pool_config), &TaskContext::CoroFunc),
       event_thread_pool_(std::move(ev_pool_config),
                          ev::ThreadPool::kUseDefaultEvLoop) {}
 
+TaskProcessorPools::CoroPool& TaskProcessorPools::GetNumaLocalCoroPool(
+    std::size_t numa_node) {
+  std::lock_guard lock(numa_local_coro_pools_mutex_);
+  auto& pool = numa_local_coro_pools_[numa_node];
+  if (!pool) {
+    // The nodes share the coroutines limit
+    auto config = coro_pool_config_;
+    config.initial_size = 0;
+    config.max_size = std::max(
+        std::size_t{1}, coro_pool_config_.max_size / utils::GetNumaNodesCount());
+    pool =
+        std::make_unique<CoroPool>(std::move(config), &TaskContext::CoroFunc);
+  }
+  return *pool;
+}
+
+coro::PoolStats TaskProcessorPools::GetCoroPoolStats() const {
+  auto stats = coro_pool_.GetStats();
+  std::lock_guard lock(numa_local_coro_pools_mutex_);
+  for (const auto& [numa_node, pool] : numa_local_coro_pools_) {
+    stats += pool->GetStats();
+  }
+  return stats;
+}
+
 }  // namespace engine::impl
 
 USERVER_NAMESPACE_END
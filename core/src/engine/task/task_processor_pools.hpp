@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include <engine/coro/pool.hpp>
 #include <engine/ev/thread_pool.hpp>
 
@@ -19,8 +24,22 @@ class TaskProcessorPools final {
   CoroPool& GetCoroPool() { return coro_pool_; }
   ev::ThreadPool& EventThreadPool() { return event_thread_pool_; }
 
+  /// Returns a coroutine pool for task processors pinned to the `numa_node`.
+  /// Its coroutines are created lazily by the worker threads that run them,
+  /// so with the default first-touch policy the stacks are allocated on the
+  /// local NUMA node.
+  CoroPool& GetNumaLocalCoroPool(std::size_t numa_node);
+
+  /// Returns the summary stats of all the coroutine pools
+  coro::PoolStats GetCoroPoolStats() const;
+
  private:
+  const coro::PoolConfig coro_pool_config_;
   CoroPool coro_pool_;
+
+  mutable std::mutex numa_local_coro_pools_mutex_;
+  std::map<std::size_t, std::unique_ptr<CoroPool>> numa_local_coro_pools_;
+
   ev::ThreadPool event_thread_pool_;
 };
 
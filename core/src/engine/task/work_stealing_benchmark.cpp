@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// range(0) - task queue type, range(1) - worker threads count
+template <typename Func>
+void RunInTaskProcessor(const benchmark::State& state, Func func) {
+  engine::TaskProcessorConfig config;
+  config.name = "benchmark";
+  config.thread_name = "bench-worker";
+  config.worker_threads = state.range(1);
+  config.task_queue = state.range(0)
+                          ? engine::TaskQueueType::kWorkStealingTaskQueue
+                          : engine::TaskQueueType::kGlobalTaskQueue;
+
+  engine::impl::TaskProcessorHolder task_processor{
+      std::make_unique<engine::TaskProcessor>(
+          std::move(config), engine::impl::MakeTaskProcessorPools({}))};
+  engine::impl::RunOnTaskProcessorSync(*task_processor, std::move(func));
+}
+
+struct PingPongPair final {
+  engine::SingleConsumerEvent ping;
+  engine::SingleConsumerEvent pong;
+};
+
+engine::TaskWithResult<void> StartPonger(PingPongPair& pair) {
+  return engine::AsyncNoSpan([&pair] {
+    while (pair.ping.WaitForEvent()) pair.pong.Send();
+  });
+}
+
+void RunPingPong(PingPongPair& pair) {
+  pair.ping.Send();
+  [[maybe_unused]] const bool ok = pair.pong.WaitForEvent();
+}
+
+void ApplyQueueTypesAndThreads(benchmark::internal::Benchmark* b) {
+  for (int queue_type : {0, 1}) {
+    for (int threads = 1; threads <= 64; threads *= 2) {
+      b->Args({queue_type, threads});
+    }
+  }
+}
+
+}  // namespace
+
+// A task wakes up another task and waits for the reply. Other worker threads
+// are busy with the same workload, so the scheduler is under contention.
+void task_processor_ping_pong(benchmark::State& state) {
+  RunInTaskProcessor(state, [&] {
+    const auto background_pairs_count = state.range(1) - 1;
+    std::vector<PingPongPair> pairs(background_pairs_count + 1);
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(pairs.size() * 2);
+
+    for (auto& pair : pairs) tasks.push_back(StartPonger(pair));
+    for (std::int64_t i = 0; i < background_pairs_count; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&pair = pairs[i + 1]] {
+        while (!engine::current_task::ShouldCancel()) RunPingPong(pair);
+      }));
+    }
+
+    for (auto _ : state) RunPingPong(pairs[0]);
+
+    for (auto& task : tasks) task.RequestCancel();
+  });
+}
+BENCHMARK(task_processor_ping_pong)->Apply(ApplyQueueTypesAndThreads);
+
+// A task spawns a batch of short tasks and waits for all of them
+void task_processor_fan_out(benchmark::State& state) {
+  RunInTaskProcessor(state, [&] {
+    const auto fan_out = state.range(1) * 4;
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(fan_out);
+
+    for (auto _ : state) {
+      for (std::int64_t i = 0; i < fan_out; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([] {}));
+      }
+      for (auto& task : tasks) task.Wait();
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * fan_out);
+  });
+}
+BENCHMARK(task_processor_fan_out)->Apply(ApplyQueueTypesAndThreads);
+
+USERVER_NAMESPACE_END
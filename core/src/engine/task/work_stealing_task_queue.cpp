@@ -0,0 +1,218 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+namespace {
+
+// Limits the count of consecutive LIFO slot pops, so that a pair of tasks
+// waking up each other does not starve the rest of the local queue.
+constexpr std::size_t kMaxLifoInARow = 3;
+
+// Every Nth pop checks the global queue first, so that tasks scheduled from
+// outside of the task processor are not starved by the local ones.
+constexpr std::size_t kGlobalQueueCheckInterval = 61;
+
+constexpr std::size_t kMaxBatchSize = 32;
+
+struct CurrentWorker final {
+  const WorkStealingTaskQueue* queue{nullptr};
+  void* worker{nullptr};
+  TaskContext* running{nullptr};
+};
+
+thread_local CurrentWorker current_worker;
+
+}  // namespace
+
+WorkStealingTaskQueue::Worker::Worker() : local_token(local_queue) {}
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(std::size_t worker_count)
+    : worker_count_(worker_count),
+      workers_(std::make_unique<Worker[]>(worker_count)) {
+  UINVARIANT(worker_count_ > 0, "Unable to run anything using 0 threads");
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+void WorkStealingTaskQueue::Push(TaskContext* context) {
+  UASSERT(context);
+  auto* self = GetCurrentWorker();
+  if (!self) {
+    global_queue_.enqueue(context);
+    NotifyIdleWorker();
+    return;
+  }
+
+  if (context == current_worker.running) {
+    // The task has yielded, let the others run first
+    PushToLocal(*self, context);
+    NotifyIdleWorker();
+    return;
+  }
+
+  auto* displaced =
+      self->lifo_slot.exchange(context, std::memory_order_acq_rel);
+  if (displaced) {
+    PushToLocal(*self, displaced);
+    NotifyIdleWorker();
+  }
+}
+
+TaskContext* WorkStealingTaskQueue::PopBlocking() {
+  auto& self = AcquireCurrentWorker();
+  auto* context = TryPopOrSleep(self);
+  current_worker.running = context;
+  return context;
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  is_stopped_ = true;
+  sleep_semaphore_.signal(static_cast<int>(worker_count_));
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size = global_queue_.size_approx();
+  for (std::size_t i = 0; i < worker_count_; ++i) {
+    const auto& worker = workers_[i];
+    size += worker.local_queue.size_approx();
+    if (worker.lifo_slot.load(std::memory_order_relaxed)) ++size;
+  }
+  return size;
+}
+
+WorkStealingTaskQueue::Worker*
+WorkStealingTaskQueue::GetCurrentWorker() noexcept {
+  if (current_worker.queue != this) return nullptr;
+  return static_cast<Worker*>(current_worker.worker);
+}
+
+WorkStealingTaskQueue::Worker& WorkStealingTaskQueue::AcquireCurrentWorker() {
+  if (auto* self = GetCurrentWorker()) return *self;
+
+  const auto index = registered_workers_.fetch_add(1);
+  UINVARIANT(index < worker_count_,
+             "Too many worker threads for the work stealing task queue");
+  current_worker.queue = this;
+  current_worker.worker = &workers_[index];
+  return workers_[index];
+}
+
+TaskContext* WorkStealingTaskQueue::TryPop(Worker& self) {
+  if (++self.pops_count % kGlobalQueueCheckInterval == 0) {
+    if (auto* context = TryPopFromGlobal(self)) return context;
+  }
+
+  if (self.lifo_in_a_row < kMaxLifoInARow) {
+    auto* context = self.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) {
+      ++self.lifo_in_a_row;
+      return context;
+    }
+  }
+  self.lifo_in_a_row = 0;
+
+  TaskContext* context = nullptr;
+  if (self.local_queue.try_dequeue_from_producer(self.local_token, context)) {
+    return context;
+  }
+
+  context = self.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+  if (context) return context;
+
+  if (auto* global_context = TryPopFromGlobal(self)) return global_context;
+
+  return TrySteal(self);
+}
+
+TaskContext* WorkStealingTaskQueue::TryPopFromGlobal(Worker& self) {
+  // Take a fair share of the global queue to avoid hammering it
+  const auto batch_size = std::clamp<std::size_t>(
+      global_queue_.size_approx() / worker_count_, 1, kMaxBatchSize);
+
+  std::array<TaskContext*, kMaxBatchSize> batch{};
+  const auto count = global_queue_.try_dequeue_bulk(batch.data(), batch_size);
+  if (count == 0) return nullptr;
+
+  if (count > 1) {
+    self.local_queue.enqueue_bulk(self.local_token, batch.data() + 1,
+                                  count - 1);
+    NotifyIdleWorker();
+  }
+  return batch[0];
+}
+
+TaskContext* WorkStealingTaskQueue::TrySteal(Worker& self) {
+  if (worker_count_ == 1) return nullptr;
+
+  std::array<TaskContext*, kMaxBatchSize> batch{};
+  const auto start = utils::RandRange(worker_count_);
+  for (std::size_t i = 0; i < worker_count_; ++i) {
+    auto& victim = workers_[(start + i) % worker_count_];
+    if (&victim == &self) continue;
+
+    // Steal half of the victim's queue
+    const auto batch_size = std::clamp<std::size_t>(
+        victim.local_queue.size_approx() / 2, 1, kMaxBatchSize);
+    const auto count =
+        victim.local_queue.try_dequeue_bulk(batch.data(), batch_size);
+    if (count > 0) {
+      if (count > 1) {
+        self.local_queue.enqueue_bulk(self.local_token, batch.data() + 1,
+                                      count - 1);
+      }
+      return batch[0];
+    }
+
+    // The victim may be stuck in a long running task, do not let the task in
+    // its LIFO slot wait for it
+    auto* context =
+        victim.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) return context;
+  }
+  return nullptr;
+}
+
+TaskContext* WorkStealingTaskQueue::TryPopOrSleep(Worker& self) {
+  while (true) {
+    if (auto* context = TryPop(self)) return context;
+
+    sleeping_workers_.fetch_add(1, std::memory_order_seq_cst);
+    // Pairs with the fence in NotifyIdleWorker(): either the pusher sees us
+    // sleeping and signals the semaphore, or we see the pushed task here.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (auto* context = TryPop(self)) {
+      sleeping_workers_.fetch_sub(1, std::memory_order_relaxed);
+      return context;
+    }
+    if (is_stopped_.load()) {
+      sleeping_workers_.fetch_sub(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    sleep_semaphore_.wait();
+    sleeping_workers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void WorkStealingTaskQueue::PushToLocal(Worker& self, TaskContext* context) {
+  self.local_queue.enqueue(self.local_token, context);
+}
+
+void WorkStealingTaskQueue::NotifyIdleWorker() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_workers_.load(std::memory_order_relaxed) > 0) {
+    sleep_semaphore_.signal();
+  }
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+class TaskContext;
+
+/// Task queue with per-worker local queues, a LIFO slot for the most recently
+/// woken task and work stealing between workers.
+///
+/// Tasks scheduled from a worker thread of the owning TaskProcessor go into
+/// that worker's LIFO slot (the previous occupant is moved into the worker's
+/// local queue), so that a task woken up by the current task resumes on the
+/// same core, with hot caches. Tasks scheduled from any other thread go into
+/// the shared injection queue. An idle worker drains its LIFO slot, its local
+/// queue and the injection queue, then steals half of a victim's local queue,
+/// and only then goes to sleep.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(std::size_t worker_count);
+  ~WorkStealingTaskQueue();
+
+  WorkStealingTaskQueue(const WorkStealingTaskQueue&) = delete;
+  WorkStealingTaskQueue& operator=(const WorkStealingTaskQueue&) = delete;
+
+  void Push(TaskContext* context);
+
+  /// Blocks until a task is available. Returns nullptr after StopProcessing()
+  /// once there is nothing left to run. Must be called from worker threads
+  /// only, each worker thread is assigned to a local queue on the first call.
+  TaskContext* PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  // Minimum offset between two objects to avoid false sharing
+  // TODO: replace with std::hardware_destructive_interference_size
+  static constexpr std::size_t kInterferenceSize = 64;
+
+  struct alignas(kInterferenceSize) Worker final {
+    Worker();
+
+    // Written by the owner, exchanged with nullptr by the thieves
+    std::atomic<TaskContext*> lifo_slot{nullptr};
+
+    // Single producer (the owner), multiple consumers (owner and thieves)
+    moodycamel::ConcurrentQueue<TaskContext*> local_queue;
+    moodycamel::ProducerToken local_token;
+
+    // Accessed by the owner only
+    std::size_t lifo_in_a_row{0};
+    std::size_t pops_count{0};
+  };
+
+  Worker* GetCurrentWorker() noexcept;
+  Worker& AcquireCurrentWorker();
+
+  TaskContext* TryPop(Worker& self);
+  TaskContext* TryPopFromGlobal(Worker& self);
+  TaskContext* TrySteal(Worker& self);
+  TaskContext* TryPopOrSleep(Worker& self);
+
+  void PushToLocal(Worker& self, TaskContext* context);
+  void NotifyIdleWorker();
+
+  const std::size_t worker_count_;
+  std::unique_ptr<Worker[]> workers_;
+  std::atomic<std::size_t> registered_workers_{0};
+
+  moodycamel::ConcurrentQueue<TaskContext*> global_queue_;
+
+  alignas(kInterferenceSize) std::atomic<std::size_t> sleeping_workers_{0};
+  std::atomic<bool> is_stopped_{false};
+  moodycamel::LightweightSemaphore sleep_semaphore_;
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
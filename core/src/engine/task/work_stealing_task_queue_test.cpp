@@ -0,0 +1,92 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWorkerThreads = 4;
+
+std::unique_ptr<engine::TaskProcessor> MakeWorkStealingTaskProcessor() {
+  engine::TaskProcessorConfig config;
+  config.name = "work-stealing";
+  config.thread_name = "ws-worker";
+  config.worker_threads = kWorkerThreads;
+  config.task_queue = engine::TaskQueueType::kWorkStealingTaskQueue;
+
+  return std::make_unique<engine::TaskProcessor>(
+      std::move(config),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+}
+
+}  // namespace
+
+UTEST(WorkStealingTaskQueue, FanOut) {
+  auto task_processor = MakeWorkStealingTaskProcessor();
+  constexpr std::size_t kTasksCount = 1000;
+
+  std::atomic<std::size_t> counter{0};
+  auto parent = engine::AsyncNoSpan(*task_processor, [&counter] {
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasksCount);
+    for (std::size_t i = 0; i < kTasksCount; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&counter] { ++counter; }));
+    }
+    for (auto& task : tasks) task.Get();
+  });
+  parent.Get();
+
+  EXPECT_EQ(counter.load(), kTasksCount);
+  EXPECT_EQ(task_processor->GetTaskQueueSize(), std::size_t{0});
+}
+
+UTEST(WorkStealingTaskQueue, PingPong) {
+  auto task_processor = MakeWorkStealingTaskProcessor();
+  constexpr std::size_t kRoundTrips = 1000;
+
+  engine::SingleConsumerEvent ping;
+  engine::SingleConsumerEvent pong;
+  auto ponger = engine::AsyncNoSpan(*task_processor, [&] {
+    for (std::size_t i = 0; i < kRoundTrips; ++i) {
+      ASSERT_TRUE(ping.WaitForEvent());
+      pong.Send();
+    }
+  });
+  auto pinger = engine::AsyncNoSpan(*task_processor, [&] {
+    for (std::size_t i = 0; i < kRoundTrips; ++i) {
+      ping.Send();
+      ASSERT_TRUE(pong.WaitForEvent());
+    }
+  });
+
+  pinger.Get();
+  ponger.Get();
+}
+
+UTEST(WorkStealingTaskQueue, YieldingTasksDoNotStarveOthers) {
+  auto task_processor = MakeWorkStealingTaskProcessor();
+
+  std::vector<engine::TaskWithResult<void>> spinners;
+  for (std::size_t i = 0; i < kWorkerThreads * 2; ++i) {
+    spinners.push_back(engine::AsyncNoSpan(*task_processor, [] {
+      while (!engine::current_task::ShouldCancel()) engine::Yield();
+    }));
+  }
+
+  auto task = engine::AsyncNoSpan(*task_processor, [] { return 42; });
+  EXPECT_EQ(task.Get(), 42);
+
+  for (auto& spinner : spinners) spinner.SyncCancel();
+}
+
+USERVER_NAMESPACE_END
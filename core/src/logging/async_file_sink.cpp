@@ -0,0 +1,360 @@
+#include <logging/async_file_sink.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <spdlog/pattern_formatter.h>
+
+#include <logging/logger_with_info.hpp>
+#include <logging/ring_buffer.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/utils/thread_name.hpp>
+#include <utils/strerror.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+// The writer thread wakes up at least this often, and earlier if a buffer of
+// a thread gets half full or on flush()
+constexpr std::chrono::milliseconds kWriteInterval{10};
+
+#ifdef IOV_MAX
+constexpr std::size_t kMaxBatchIovecs = IOV_MAX;
+#else
+constexpr std::size_t kMaxBatchIovecs = 1024;
+#endif
+
+std::atomic<std::uint64_t> next_sink_id{1};
+
+// Must only be called by the only writer of the counter
+void IncrementOwned(std::atomic<std::uint64_t>& counter) noexcept {
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+int OpenFile(const std::string& file_path, bool truncate) {
+  const int fd = ::open(file_path.c_str(),
+                        O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC |
+                            (truncate ? O_TRUNC : 0),
+                        0644);
+  if (fd == -1) {
+    throw std::runtime_error("Failed to open log file '" + file_path +
+                             "': " + utils::strerror(errno));
+  }
+  return fd;
+}
+
+}  // namespace
+
+struct AsyncFileSink::Producer final {
+  explicit Producer(std::size_t buffer_size) : buffer(buffer_size) {}
+
+  RingBuffer buffer;
+  std::atomic<bool> is_thread_exited{false};
+
+  // written only by the thread of the producer
+  std::atomic<std::uint64_t> total{0};
+  std::atomic<std::uint64_t> dropped{0};
+  std::atomic<std::uint64_t> blocked{0};
+
+  // accessed only by the thread of the producer
+  std::unique_ptr<spdlog::formatter> formatter;
+  std::uint64_t formatter_version{0};
+  spdlog::memory_buf_t formatted;
+};
+
+AsyncFileSink::AsyncFileSink(const std::string& logger_name,
+                             const LoggerConfig& config)
+    : id_(next_sink_id.fetch_add(1)),
+      file_path_(config.file_path),
+      buffer_size_(config.thread_buffer_size),
+      overflow_behavior_(config.queue_overflow_behavior),
+      formatter_(std::make_unique<spdlog::pattern_formatter>()),
+      fd_(OpenFile(file_path_, false)) {
+  // separates the records of the previous run, as ReopeningFileSink does
+  struct ::stat file_stat {};
+  if (::fstat(fd_, &file_stat) == 0 && file_stat.st_size > 0) {
+    [[maybe_unused]] const auto result = ::write(fd_, "\n", 1);
+  }
+
+  writer_thread_ = std::thread([this, thread_name = "log/" + logger_name] {
+    utils::SetCurrentThreadName(thread_name);
+    RunWriter();
+  });
+}
+
+AsyncFileSink::~AsyncFileSink() {
+  {
+    std::lock_guard lock(wake_mutex_);
+    is_stopping_ = true;
+  }
+  wake_cv_.notify_one();
+  writer_thread_.join();
+  ::close(fd_);
+}
+
+void AsyncFileSink::log(const spdlog::details::log_msg& msg) {
+  auto& producer = GetProducer();
+  if (producer.formatter_version !=
+      formatter_version_.load(std::memory_order_acquire)) {
+    UpdateFormatter(producer);
+  }
+
+  producer.formatted.clear();
+  producer.formatter->format(msg, producer.formatted);
+  Push(producer, {producer.formatted.data(), producer.formatted.size()});
+}
+
+void AsyncFileSink::Write(std::string_view record) {
+  Push(GetProducer(), record);
+}
+
+void AsyncFileSink::flush() { Wake(); }
+
+void AsyncFileSink::set_pattern(const std::string& pattern) {
+  set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+}
+
+void AsyncFileSink::set_formatter(
+    std::unique_ptr<spdlog::formatter> formatter) {
+  std::lock_guard lock(formatter_mutex_);
+  formatter_ = std::move(formatter);
+  formatter_version_.fetch_add(1, std::memory_order_release);
+}
+
+void AsyncFileSink::Reopen(bool truncate) {
+  const int new_fd = OpenFile(file_path_, truncate);
+  std::lock_guard lock(file_mutex_);
+  ::close(std::exchange(fd_, new_fd));
+}
+
+AsyncFileSinkStatistics AsyncFileSink::GetStatistics() const {
+  AsyncFileSinkStatistics result;
+  {
+    std::lock_guard lock(producers_mutex_);
+    result = retired_stats_;
+    for (const auto& producer : producers_) {
+      result.total += producer->total.load(std::memory_order_relaxed);
+      result.dropped += producer->dropped.load(std::memory_order_relaxed);
+      result.blocked += producer->blocked.load(std::memory_order_relaxed);
+    }
+  }
+  result.written_bytes = written_bytes_.load(std::memory_order_relaxed);
+  result.write_calls = write_calls_.load(std::memory_order_relaxed);
+  result.write_errors = write_errors_.load(std::memory_order_relaxed);
+  return result;
+}
+
+AsyncFileSink::Producer& AsyncFileSink::GetProducer() {
+  // The producers are owned by the sinks. The sink removes the producer of an
+  // exited thread after writing out its buffer.
+  struct ThreadProducers final {
+    ~ThreadProducers() {
+      for (const auto& [sink_id, weak_producer] : producers) {
+        if (auto producer = weak_producer.lock()) {
+          producer->is_thread_exited.store(true, std::memory_order_release);
+        }
+      }
+    }
+
+    std::uint64_t last_sink_id{0};
+    Producer* last_producer{nullptr};
+    std::unordered_map<std::uint64_t, std::weak_ptr<Producer>> producers;
+  };
+  thread_local ThreadProducers thread_producers;
+
+  if (thread_producers.last_sink_id == id_) {
+    return *thread_producers.last_producer;
+  }
+
+  auto& producers = thread_producers.producers;
+  const auto it = producers.find(id_);
+  auto producer = it != producers.end() ? it->second.lock() : nullptr;
+  if (!producer) {
+    // A new sink for this thread, the entries of the destroyed sinks are
+    // removed here so the map does not grow as the loggers are recreated
+    for (auto prune_it = producers.begin(); prune_it != producers.end();) {
+      if (prune_it->second.expired()) {
+        prune_it = producers.erase(prune_it);
+      } else {
+        ++prune_it;
+      }
+    }
+
+    producer = std::make_shared<Producer>(buffer_size_);
+    producers.emplace(id_, producer);
+    std::lock_guard lock(producers_mutex_);
+    producers_.push_back(producer);
+  }
+
+  // the sink outlives the logging into it
+  thread_producers.last_sink_id = id_;
+  thread_producers.last_producer = producer.get();
+  return *producer;
+}
+
+void AsyncFileSink::Push(Producer& producer, std::string_view record) {
+  IncrementOwned(producer.total);
+
+  if (record.size() > buffer_size_) {
+    IncrementOwned(producer.dropped);
+    return;
+  }
+
+  auto used = producer.buffer.TryPush(record);
+  if (used == buffer_size_ &&
+      overflow_behavior_ == LoggerConfig::QueueOveflowBehavior::kBlock) {
+    IncrementOwned(producer.blocked);
+    while (used == buffer_size_) {
+      Wake();
+      std::this_thread::yield();
+      used = producer.buffer.TryPush(record);
+    }
+  }
+
+  if (used == buffer_size_) {
+    IncrementOwned(producer.dropped);
+  } else if (used < buffer_size_ / 2 &&
+             used + record.size() >= buffer_size_ / 2) {
+    Wake();
+  }
+}
+
+void AsyncFileSink::UpdateFormatter(Producer& producer) {
+  std::lock_guard lock(formatter_mutex_);
+  producer.formatter = formatter_->clone();
+  producer.formatter_version =
+      formatter_version_.load(std::memory_order_relaxed);
+}
+
+void AsyncFileSink::Wake() {
+  {
+    std::lock_guard lock(wake_mutex_);
+    is_wake_requested_ = true;
+  }
+  wake_cv_.notify_one();
+}
+
+void AsyncFileSink::RunWriter() {
+  std::unique_lock lock(wake_mutex_);
+  while (!is_stopping_) {
+    wake_cv_.wait_for(lock, kWriteInterval,
+                      [this] { return is_stopping_ || is_wake_requested_; });
+    is_wake_requested_ = false;
+
+    lock.unlock();
+    WriteBuffers();
+    lock.lock();
+  }
+  lock.unlock();
+
+  // the records logged before the destruction of the sink
+  WriteBuffers();
+}
+
+void AsyncFileSink::WriteBuffers() {
+  {
+    std::lock_guard lock(producers_mutex_);
+    const auto is_retired = [this](const std::shared_ptr<Producer>& producer) {
+      if (!producer->is_thread_exited.load(std::memory_order_acquire) ||
+          !producer->buffer.IsEmpty()) {
+        return false;
+      }
+      retired_stats_.total += producer->total.load();
+      retired_stats_.dropped += producer->dropped.load();
+      retired_stats_.blocked += producer->blocked.load();
+      return true;
+    };
+    producers_.erase(
+        std::remove_if(producers_.begin(), producers_.end(), is_retired),
+        producers_.end());
+    producers_snapshot_ = producers_;
+  }
+
+  std::lock_guard lock(file_mutex_);
+  for (const auto& producer : producers_snapshot_) {
+    const auto [first, second] = producer->buffer.Peek();
+    if (first.empty()) continue;
+
+    if (batch_iovecs_.size() + 2 > kMaxBatchIovecs) WriteBatch();
+    batch_iovecs_.push_back({const_cast<char*>(first.data()), first.size()});
+    if (!second.empty()) {
+      batch_iovecs_.push_back(
+          {const_cast<char*>(second.data()), second.size()});
+    }
+    batch_sizes_.emplace_back(producer.get(), first.size() + second.size());
+  }
+  WriteBatch();
+
+  producers_snapshot_.clear();
+}
+
+void AsyncFileSink::WriteBatch() {
+  std::size_t index = 0;
+  while (index < batch_iovecs_.size()) {
+    const auto written = ::writev(fd_, batch_iovecs_.data() + index,
+                                  batch_iovecs_.size() - index);
+    if (written < 0 && errno == EINTR) continue;
+    if (written <= 0) {
+      // the records are dropped, there is no better place to report the error
+      write_errors_.fetch_add(1, std::memory_order_relaxed);
+      break;
+    }
+    write_calls_.fetch_add(1, std::memory_order_relaxed);
+    written_bytes_.fetch_add(written, std::memory_order_relaxed);
+
+    // skips the written data after a partial write
+    auto rest = static_cast<std::size_t>(written);
+    while (index < batch_iovecs_.size() &&
+           rest >= batch_iovecs_[index].iov_len) {
+      rest -= batch_iovecs_[index].iov_len;
+      ++index;
+    }
+    if (rest > 0) {
+      auto& iovec = batch_iovecs_[index];
+      iovec.iov_base = static_cast<char*>(iovec.iov_base) + rest;
+      iovec.iov_len -= rest;
+    }
+  }
+
+  for (const auto& [producer, size] : batch_sizes_) {
+    producer->buffer.Consume(size);
+  }
+  batch_iovecs_.clear();
+  batch_sizes_.clear();
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AsyncFileSinkStatistics& stats) {
+  writer["total"] = stats.total;
+  writer["dropped"] = stats.dropped;
+  writer["blocked"] = stats.blocked;
+  writer["written_bytes"] = stats.written_bytes;
+  writer["write_calls"] = stats.write_calls;
+  writer["write_errors"] = stats.write_errors;
+}
+
+LoggerPtr MakeAsyncFileLogger(const std::string& name,
+                              const LoggerConfig& config) {
+  auto sink = std::make_shared<AsyncFileSink>(name, config);
+  return std::make_shared<LoggerWithInfo>(
+      config.format,
+      utils::MakeSharedRef<spdlog::logger>(name, std::move(sink)));
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
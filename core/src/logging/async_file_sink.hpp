@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/formatter.h>
+#include <spdlog/sinks/sink.h>
+
+#include <logging/config.hpp>
+#include <userver/logging/logger.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+struct AsyncFileSinkStatistics final {
+  // records passed to the sink
+  std::uint64_t total{0};
+  // records dropped because the buffer of the thread was full
+  std::uint64_t dropped{0};
+  // records that waited for free space in the buffer of the thread
+  std::uint64_t blocked{0};
+  std::uint64_t written_bytes{0};
+  std::uint64_t write_calls{0};
+  std::uint64_t write_errors{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AsyncFileSinkStatistics& stats);
+
+// Asynchronous file sink without locks on the logging path.
+//
+// The records are formatted in the logging thread and appended to a
+// single-producer single-consumer buffer of that thread. A dedicated writer
+// thread gathers the buffers of all the threads and writes them to the file
+// with writev. If the buffer of a thread is full, the record is either dropped
+// or the thread waits for the writer, depending on
+// LoggerConfig::queue_overflow_behavior.
+//
+// The records of a single thread keep their order in the file, the records of
+// different threads may be reordered within a write interval. That includes
+// the records of a coroutine that migrated between the worker threads, they
+// are not merged by timestamps.
+class AsyncFileSink final : public spdlog::sinks::sink {
+ public:
+  AsyncFileSink(const std::string& logger_name, const LoggerConfig& config);
+  ~AsyncFileSink() override;
+
+  void log(const spdlog::details::log_msg& msg) override;
+
+  // Writes the preformatted record as is, bypassing the formatter
+  void Write(std::string_view record);
+
+  // Wakes up the writer thread, does not wait for the write
+  void flush() override;
+
+  void set_pattern(const std::string& pattern) override;
+  void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+  // @throws std::runtime_error if the file can not be opened
+  void Reopen(bool truncate);
+
+  AsyncFileSinkStatistics GetStatistics() const;
+
+ private:
+  struct Producer;
+
+  Producer& GetProducer();
+  void Push(Producer& producer, std::string_view record);
+  void UpdateFormatter(Producer& producer);
+
+  void Wake();
+  void RunWriter();
+  void WriteBuffers();
+  void WriteBatch();
+
+  const std::uint64_t id_;
+  const std::string file_path_;
+  const std::size_t buffer_size_;
+  const LoggerConfig::QueueOveflowBehavior overflow_behavior_;
+
+  mutable std::mutex formatter_mutex_;
+  std::unique_ptr<spdlog::formatter> formatter_;
+  std::atomic<std::uint64_t> formatter_version_{1};
+
+  mutable std::mutex producers_mutex_;
+  std::vector<std::shared_ptr<Producer>> producers_;
+  // statistics of the removed producers of exited threads
+  AsyncFileSinkStatistics retired_stats_;
+
+  // accessed only by the writer thread
+  std::vector<std::shared_ptr<Producer>> producers_snapshot_;
+  std::vector<::iovec> batch_iovecs_;
+  std::vector<std::pair<Producer*, std::size_t>> batch_sizes_;
+
+  // protects the file descriptor from the concurrent Reopen
+  std::mutex file_mutex_;
+  int fd_{-1};
+
+  std::atomic<std::uint64_t> written_bytes_{0};
+  std::atomic<std::uint64_t> write_calls_{0};
+  std::atomic<std::uint64_t> write_errors_{0};
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  bool is_wake_requested_{false};
+  bool is_stopping_{false};
+
+  std::thread writer_thread_;
+};
+
+// Creates a logger that writes to the file via AsyncFileSink
+LoggerPtr MakeAsyncFileLogger(const std::string& name,
+                              const LoggerConfig& config);
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,175 @@
+#include <logging/async_file_sink.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <fmt/format.h>
+
+#include <logging/logger_with_info.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kThreads = 4;
+constexpr std::size_t kMessagesPerThread = 10'000;
+
+logging::LoggerConfig MakeConfig(const std::string& file_path,
+                                 std::size_t thread_buffer_size) {
+  logging::LoggerConfig config;
+  config.file_path = file_path;
+  config.thread_buffer_size = thread_buffer_size;
+  return config;
+}
+
+logging::LoggerPtr MakeLogger(const logging::LoggerConfig& config) {
+  auto logger = logging::impl::MakeAsyncFileLogger("test", config);
+  logger->ptr->set_pattern("%v");
+  return logger;
+}
+
+const logging::impl::AsyncFileSink& GetSink(
+    const logging::impl::LoggerWithInfo& logger) {
+  return dynamic_cast<const logging::impl::AsyncFileSink&>(
+      *logger.ptr->sinks().at(0));
+}
+
+void LogFromThreads(const logging::LoggerPtr& logger) {
+  std::vector<std::thread> threads;
+  for (std::size_t thread = 0; thread < kThreads; ++thread) {
+    threads.emplace_back([&logger, thread] {
+      for (std::size_t i = 0; i < kMessagesPerThread; ++i) {
+        logger->ptr->info(fmt::format("{} {}", thread, i));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+// Returns the number of messages of each thread, checks their order
+std::vector<std::size_t> CountMessages(const std::string& contents) {
+  std::vector<std::size_t> counts(kThreads);
+  std::vector<long> last_index(kThreads, -1);
+  std::size_t thread = 0;
+  long index = 0;
+  const char* line = contents.c_str();
+  while (std::sscanf(line, "%zu %ld\n", &thread, &index) == 2) {
+    EXPECT_LT(thread, kThreads);
+    EXPECT_LT(last_index[thread], index);
+    last_index[thread] = index;
+    ++counts[thread];
+    line = std::strchr(line, '\n') + 1;
+  }
+  EXPECT_EQ(*line, '\0');
+  return counts;
+}
+
+void WaitForFileSize(const std::string& path, std::size_t size) {
+  for (int i = 0; i < 1000; ++i) {
+    if (fs::blocking::ReadFileContents(path).size() >= size) return;
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+  }
+  FAIL() << "The messages were not written to " << path;
+}
+
+}  // namespace
+
+TEST(AsyncFileSink, WritesAllMessages) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log.txt";
+
+  logging::impl::AsyncFileSinkStatistics stats;
+  {
+    const auto logger = MakeLogger(MakeConfig(path, 1 << 20));
+    LogFromThreads(logger);
+    logger->ptr->info("last");
+    stats = GetSink(*logger).GetStatistics();
+  }
+
+  auto contents = fs::blocking::ReadFileContents(path);
+  ASSERT_GE(contents.size(), 5);
+  EXPECT_EQ(contents.substr(contents.size() - 5), "last\n");
+  contents.resize(contents.size() - 5);
+
+  for (const auto count : CountMessages(contents)) {
+    EXPECT_EQ(count, kMessagesPerThread);
+  }
+  EXPECT_EQ(stats.total, kThreads * kMessagesPerThread + 1);
+  EXPECT_EQ(stats.dropped, 0);
+}
+
+TEST(AsyncFileSink, Overflow) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log.txt";
+
+  logging::impl::AsyncFileSinkStatistics stats;
+  {
+    const auto logger = MakeLogger(MakeConfig(path, 256));
+    LogFromThreads(logger);
+    // does not fit into the buffer
+    logger->ptr->info(std::string(1000, 'x'));
+    stats = GetSink(*logger).GetStatistics();
+  }
+
+  std::size_t written = 0;
+  for (const auto count :
+       CountMessages(fs::blocking::ReadFileContents(path))) {
+    written += count;
+  }
+  EXPECT_EQ(stats.total, kThreads * kMessagesPerThread + 1);
+  EXPECT_GE(stats.dropped, 1);
+  EXPECT_EQ(written + stats.dropped, stats.total);
+}
+
+TEST(AsyncFileSink, OverflowBlock) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log.txt";
+
+  auto config = MakeConfig(path, 256);
+  config.queue_overflow_behavior =
+      logging::LoggerConfig::QueueOveflowBehavior::kBlock;
+
+  logging::impl::AsyncFileSinkStatistics stats;
+  {
+    const auto logger = MakeLogger(config);
+    LogFromThreads(logger);
+    stats = GetSink(*logger).GetStatistics();
+  }
+
+  for (const auto count :
+       CountMessages(fs::blocking::ReadFileContents(path))) {
+    EXPECT_EQ(count, kMessagesPerThread);
+  }
+  EXPECT_EQ(stats.dropped, 0);
+}
+
+TEST(AsyncFileSink, Reopen) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/log.txt";
+  const auto rotated_path = dir.GetPath() + "/log.txt.1";
+
+  {
+    const auto logger = MakeLogger(MakeConfig(path, 1 << 16));
+    logger->ptr->info("before");
+    logger->ptr->flush();
+    WaitForFileSize(path, 7);
+
+    ASSERT_EQ(std::rename(path.c_str(), rotated_path.c_str()), 0);
+    auto& sink = dynamic_cast<logging::impl::AsyncFileSink&>(
+        *logger->ptr->sinks().at(0));
+    sink.Reopen(false);
+    logger->ptr->info("after");
+  }
+
+  EXPECT_EQ(fs::blocking::ReadFileContents(rotated_path), "before\n");
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), "after\n");
+}
+
+USERVER_NAMESPACE_END
@@ -11,12 +11,11 @@
 
 #include <fmt/format.h>
 
-#include <spdlog/async.h>
-#include <spdlog/sinks/stdout_sinks.h>
-
+#include <logging/async_file_sink.hpp>
 #include <logging/logger_with_info.hpp>
 #include <logging/reopening_file_sink.hpp>
 #include <logging/spdlog_helpers.hpp>
+#include <tracing/span_exporter.hpp>
 #include <userver/components/component.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
@@ -25,7 +24,7 @@
 #include <userver/logging/logger.hpp>
 #include <userver/os_signals/component.hpp>
 #include <userver/utils/algo.hpp>
-#include <userver/utils/thread_name.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include "config.hpp"
@@ -64,20 +63,29 @@ std::optional<TestsuiteCaptureConfig> GetTestsuiteCaptureConfig(
 
 void ReopenAll(std::vector<spdlog::sink_ptr>& sinks) {
   for (const auto& s : sinks) {
-    auto reop = std::dynamic_pointer_cast<logging::ReopeningFileSinkMT>(s);
-    if (!reop) {
-      continue;
-    }
-
     try {
       bool should_truncate = false;
-      reop->Reopen(should_truncate);
+      if (auto reop =
+              std::dynamic_pointer_cast<logging::ReopeningFileSinkMT>(s)) {
+        reop->Reopen(should_truncate);
+      } else if (auto async_sink = std::dynamic_pointer_cast<
+                     logging::impl::AsyncFileSink>(s)) {
+        async_sink->Reopen(should_truncate);
+      }
     } catch (const std::exception& e) {
       LOG_ERROR() << "Exception on log reopen: " << e;
     }
   }
 }
 
+void ReopenSpanExporter(tracing::impl::SpanExporter& exporter) {
+  try {
+    exporter.Reopen();
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Exception on span exporter file reopen: " << e;
+  }
+}
+
 void CreateLogDirectory(const std::string& logger_name,
                         const std::string& file_path) {
   try {
@@ -91,7 +99,7 @@ void CreateLogDirectory(const std::string& logger_name,
   }
 }
 
-std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
+logging::LoggerPtr CreateAsyncLogger(
     const std::string& logger_name,
     const logging::LoggerConfig& logger_config) {
   if (logger_config.file_path == "@null")
@@ -103,28 +111,22 @@ std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
     return logging::MakeStdoutLogger(logger_name, logger_config.format,
                                      logger_config.level);
 
-  auto overflow_policy = spdlog::async_overflow_policy::overrun_oldest;
-  if (logger_config.queue_overflow_behavior ==
-      logging::LoggerConfig::QueueOveflowBehavior::kBlock) {
-    overflow_policy = spdlog::async_overflow_policy::block;
-  }
-
   CreateLogDirectory(logger_name, logger_config.file_path);
 
-  auto file_sink =
-      std::make_shared<logging::ReopeningFileSinkMT>(logger_config.file_path);
-  auto tp = std::make_shared<spdlog::details::thread_pool>(
-      logger_config.message_queue_size, logger_config.thread_pool_size);
-
-  auto old_thread_name = utils::GetCurrentThreadName();
-  utils::SetCurrentThreadName("log/" + logger_name);
-
-  utils::SetCurrentThreadName(old_thread_name);
+  return logging::impl::MakeAsyncFileLogger(logger_name, logger_config);
+}
 
-  return std::make_shared<logging::impl::LoggerWithInfo>(
-      logger_config.format, tp,
-      utils::MakeSharedRef<spdlog::async_logger>(
-          logger_name, std::move(file_sink), tp, overflow_policy));
+void WriteLoggerStatistics(utils::statistics::Writer& writer,
+                           std::string_view logger_name,
+                           const logging::impl::LoggerWithInfo& logger) {
+  for (const auto& sink : logger.ptr->sinks()) {
+    const auto* async_sink =
+        dynamic_cast<const logging::impl::AsyncFileSink*>(sink.get());
+    if (async_sink) {
+      writer.ValueWithLabels(async_sink->GetStatistics(),
+                             {"logger", logger_name});
+    }
+  }
 }
 
 }  // namespace
@@ -267,7 +269,7 @@ void Logging::StopSocketLoggingDebug() {
 
 void Logging::OnLogRotate() {
   std::vector<engine::TaskWithResult<void>> tasks;
-  tasks.reserve(loggers_.size() + 1);
+  tasks.reserve(loggers_.size() + 2);
 
   // this must be a copy as the default logger may change
   auto default_logger = logging::DefaultLogger();
@@ -279,6 +281,14 @@ void Logging::OnLogRotate() {
         *fs_task_processor_, ReopenAll, std::ref(item.second->ptr->sinks())));
   }
 
+  // the exported spans file is rotated along with the logs
+  if (auto span_exporter = tracing::impl::GetSpanExporter()) {
+    tasks.push_back(engine::CriticalAsyncNoSpan(
+        *fs_task_processor_, [span_exporter = std::move(span_exporter)] {
+          ReopenSpanExporter(*span_exporter);
+        }));
+  }
+
   for (auto& task : tasks) {
     try {
       task.Get();
@@ -289,6 +299,13 @@ void Logging::OnLogRotate() {
   LOG_INFO() << "Log rotated";
 }
 
+void Logging::WriteStatistics(utils::statistics::Writer& writer) const {
+  WriteLoggerStatistics(writer, "default", *logging::DefaultLogger());
+  for (const auto& [name, logger] : loggers_) {
+    WriteLoggerStatistics(writer, name, *logger);
+  }
+}
+
 void Logging::FlushLogs() {
   logging::DefaultLogger()->ptr->flush();
   for (auto& item : loggers_) {
@@ -338,11 +355,14 @@ properties:
                     defaultDescription: warning
                 message_queue_size:
                     type: integer
-                    description: the size of internal message queue, must be a power of 2
-                    defaultDescription: 65536
+                    description: deprecated option, ignored, use thread_buffer_size
+                thread_buffer_size:
+                    type: integer
+                    description: the size of the message buffer of each logging thread in bytes, must be a power of 2
+                    defaultDescription: 262144
                 overflow_behavior:
                     type: string
-                    description: "message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue"
+                    description: "message handling policy while the buffer of a thread is full: `discard` drops messages, `block` waits until message gets into the buffer"
                     defaultDescription: discard
                     enum:
                       - discard
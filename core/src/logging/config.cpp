@@ -42,19 +42,17 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
 
   config.flush_level = value["flush_level"].As<logging::Level>(Level::kWarning);
 
-  config.message_queue_size = value["message_queue_size"].As<size_t>(
-      LoggerConfig::kDefaultMessageQueueSize);
-  if (config.message_queue_size & (config.message_queue_size - 1)) {
-    throw std::runtime_error("log message queue size must be a power of 2");
+  config.thread_buffer_size = value["thread_buffer_size"].As<size_t>(
+      LoggerConfig::kDefaultThreadBufferSize);
+  if (config.thread_buffer_size == 0 ||
+      (config.thread_buffer_size & (config.thread_buffer_size - 1))) {
+    throw std::runtime_error("log thread buffer size must be a power of 2");
   }
 
   config.queue_overflow_behavior =
       value["overflow_behavior"].As<LoggerConfig::QueueOveflowBehavior>(
           LoggerConfig::QueueOveflowBehavior::kDiscard);
 
-  config.thread_pool_size = value["thread_pool_size"].As<size_t>(
-      LoggerConfig::kDefaultThreadPoolSize);
-
   return config;
 }
 
@@ -1,5 +1,15 @@
 #include <benchmark/benchmark.h>
 
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/async.h>
+
+#include <logging/async_file_sink.hpp>
+#include <logging/logger_with_info.hpp>
+#include <logging/reopening_file_sink.hpp>
+#include <logging/spdlog_helpers.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
 
@@ -98,4 +108,58 @@ BENCHMARK_REGISTER_F(LogHelperBenchmark, LogStruct)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+namespace {
+
+constexpr auto kFileLoggerPath = "/dev/null";
+
+// spdlog::async_logger on a thread pool with a single thread, the previous
+// backend of components::Logging
+const logging::LoggerPtr& GetSpdlogAsyncLogger() {
+  static const auto thread_pool =
+      std::make_shared<spdlog::details::thread_pool>(1 << 16, 1);
+  static const auto logger = [] {
+    auto result = std::make_shared<logging::impl::LoggerWithInfo>(
+        logging::Format::kTskv,
+        utils::MakeSharedRef<spdlog::async_logger>(
+            "spdlog_async",
+            std::make_shared<logging::ReopeningFileSinkMT>(kFileLoggerPath),
+            thread_pool, spdlog::async_overflow_policy::overrun_oldest));
+    result->ptr->set_pattern(
+        logging::GetSpdlogPattern(logging::Format::kTskv));
+    return result;
+  }();
+  return logger;
+}
+
+const logging::LoggerPtr& GetAsyncFileLogger() {
+  static const auto logger = [] {
+    logging::LoggerConfig config;
+    config.file_path = kFileLoggerPath;
+    auto result = logging::impl::MakeAsyncFileLogger("async_file", config);
+    result->ptr->set_pattern(
+        logging::GetSpdlogPattern(logging::Format::kTskv));
+    return result;
+  }();
+  return logger;
+}
+
+void LogToLogger(benchmark::State& state, const logging::LoggerPtr& logger) {
+  const std::string msg(state.range(0), '*');
+  for (auto _ : state) {
+    LOG_INFO_TO(logger) << msg;
+  }
+}
+
+}  // namespace
+
+void log_spdlog_async_logger(benchmark::State& state) {
+  LogToLogger(state, GetSpdlogAsyncLogger());
+}
+BENCHMARK(log_spdlog_async_logger)->Arg(64)->Arg(1024)->ThreadRange(1, 8);
+
+void log_async_file_logger(benchmark::State& state) {
+  LogToLogger(state, GetAsyncFileLogger());
+}
+BENCHMARK(log_async_file_logger)->Arg(64)->Arg(1024)->ThreadRange(1, 8);
+
 USERVER_NAMESPACE_END
@@ -17,8 +17,7 @@ inline logging::LoggerPtr MakeNamedStreamLogger(const std::string& logger_name,
                                                 logging::Format format) {
   auto sink = std::make_shared<spdlog::sinks::ostream_sink_st>(stream);
   return std::make_shared<logging::impl::LoggerWithInfo>(
-      format, std::shared_ptr<spdlog::details::thread_pool>{},
-      utils::MakeSharedRef<spdlog::logger>(logger_name, sink));
+      format, utils::MakeSharedRef<spdlog::logger>(logger_name, sink));
 }
 
 class LoggingTest : public ::testing::Test {
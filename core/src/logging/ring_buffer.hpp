@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+// Single-producer single-consumer ring buffer of bytes.
+//
+// The producer appends whole records, the consumer reads everything appended
+// so far as at most two contiguous spans (the data may wrap around the end of
+// the buffer) and releases the space after the data has been written out.
+class RingBuffer final {
+ public:
+  // `capacity` must be a power of 2
+  explicit RingBuffer(std::size_t capacity)
+      : capacity_(capacity), data_(std::make_unique<char[]>(capacity)) {
+    UASSERT_MSG(capacity_ > 0 && (capacity_ & (capacity_ - 1)) == 0,
+                "RingBuffer capacity must be a power of 2");
+  }
+
+  RingBuffer(RingBuffer&&) = delete;
+  RingBuffer& operator=(RingBuffer&&) = delete;
+
+  std::size_t Capacity() const noexcept { return capacity_; }
+
+  // Producer side. Returns the number of bytes in the buffer before the push,
+  // or `capacity_` if there is not enough free space for `data`.
+  std::size_t TryPush(std::string_view data) noexcept {
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto used =
+        static_cast<std::size_t>(head - tail_.load(std::memory_order_acquire));
+    if (capacity_ - used < data.size()) return capacity_;
+
+    const auto offset = static_cast<std::size_t>(head) & (capacity_ - 1);
+    const auto first_part = std::min(data.size(), capacity_ - offset);
+    std::memcpy(data_.get() + offset, data.data(), first_part);
+    std::memcpy(data_.get(), data.data() + first_part,
+                data.size() - first_part);
+
+    head_.store(head + data.size(), std::memory_order_release);
+    return used;
+  }
+
+  // Consumer side. Returns the readable data, the second part is non-empty if
+  // the data wraps around the end of the buffer.
+  std::pair<std::string_view, std::string_view> Peek() const noexcept {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto size =
+        static_cast<std::size_t>(head_.load(std::memory_order_acquire) - tail);
+
+    const auto offset = static_cast<std::size_t>(tail) & (capacity_ - 1);
+    const auto first_part = std::min(size, capacity_ - offset);
+    return {{data_.get() + offset, first_part},
+            {data_.get(), size - first_part}};
+  }
+
+  // Consumer side. Releases the first `size` bytes returned by Peek().
+  void Consume(std::size_t size) noexcept {
+    tail_.store(tail_.load(std::memory_order_relaxed) + size,
+                std::memory_order_release);
+  }
+
+  bool IsEmpty() const noexcept {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // head_ and tail_ are on different cache lines, so the producer and the
+  // consumer do not invalidate the caches of each other
+  static constexpr std::size_t kInterferenceSize = 64;
+
+  const std::size_t capacity_;
+  const std::unique_ptr<char[]> data_;
+
+  // written by the producer
+  alignas(kInterferenceSize) std::atomic<std::uint64_t> head_{0};
+  // written by the consumer
+  alignas(kInterferenceSize) std::atomic<std::uint64_t> tail_{0};
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
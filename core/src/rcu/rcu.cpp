@@ -1,6 +1,8 @@
 #include <userver/rcu/rcu.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <thread>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -11,6 +13,18 @@ uint64_t GetNextEpoch() noexcept {
   return counter++;
 }
 
+std::size_t GetPerCpuHazardPointersCount() noexcept {
+  static const std::size_t count =
+      std::max(std::thread::hardware_concurrency(), 1U);
+  return count;
+}
+
+std::size_t GetThreadIndex() noexcept {
+  static std::atomic<std::size_t> counter{0};
+  thread_local const std::size_t index = counter++;
+  return index;
+}
+
 }  // namespace rcu::impl
 
 USERVER_NAMESPACE_END
@@ -150,4 +150,64 @@ void rcu_of_shared_ptr(benchmark::State& state) {
 }
 BENCHMARK(rcu_of_shared_ptr)->RangeMultiplier(2)->Range(1, 32);
 
+template <typename RcuTraits>
+void rcu_read_scaling(benchmark::State& state) {
+  const std::size_t readers_count = state.range(0);
+  const std::size_t writers_count = state.range(1);
+
+  engine::RunStandalone(readers_count + writers_count, [&] {
+    std::atomic<bool> run{true};
+    std::atomic<std::uint64_t> total_reads{0};
+    rcu::Variable<std::uint64_t, RcuTraits> var{0};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(readers_count - 1 + writers_count);
+
+    for (std::size_t i = 0; i < readers_count - 1; i++) {
+      tasks.push_back(utils::Async("reader", [&] {
+        std::uint64_t reads = 0;
+        while (run) {
+          auto reader = var.Read();
+          benchmark::DoNotOptimize(*reader);
+          ++reads;
+        }
+        total_reads += reads;
+      }));
+    }
+
+    for (std::size_t i = 0; i < writers_count; i++) {
+      tasks.push_back(utils::Async("writer", [&] {
+        std::uint64_t i = 0;
+        while (run) {
+          var.Assign(++i);
+          engine::Yield();
+        }
+      }));
+    }
+
+    for (auto _ : state) {
+      auto reader = var.Read();
+      benchmark::DoNotOptimize(*reader);
+    }
+
+    run = false;
+    for (auto& task : tasks) {
+      task.Get();
+    }
+
+    // reads of all the readers, not only the measured one
+    state.counters["reads"] = benchmark::Counter(
+        static_cast<double>(total_reads + state.iterations()),
+        benchmark::Counter::kIsRate);
+  });
+}
+BENCHMARK_TEMPLATE(rcu_read_scaling, rcu::DefaultRcuTraits)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 64}, {0, 2}})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(rcu_read_scaling, rcu::ReadScalableRcuTraits)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 64}, {0, 2}})
+    ->UseRealTime();
+
 USERVER_NAMESPACE_END
@@ -1,6 +1,8 @@
 #include <userver/utest/utest.hpp>
 
 #include <atomic>
+#include <thread>
+#include <vector>
 
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task_with_result.hpp>
@@ -568,4 +570,107 @@ UTEST_MT(Rcu, Core, 3) {
   }
 }
 
+namespace {
+
+using ReadScalableVariable =
+    rcu::Variable<DestructionTracker, rcu::ReadScalableRcuTraits>;
+
+}  // namespace
+
+UTEST(RcuReadScalable, ReadWrite) {
+  rcu::Variable<X, rcu::ReadScalableRcuTraits> ptr(1, 2);
+
+  auto old_reader = ptr.Read();
+  ptr.Assign({3, 4});
+
+  auto reader = ptr.Read();
+  EXPECT_EQ(std::make_pair(1, 2), *old_reader);
+  EXPECT_EQ(std::make_pair(3, 4), *reader);
+
+  auto reader_copy = reader;
+  EXPECT_EQ(std::make_pair(3, 4), *reader_copy);
+}
+
+UTEST(RcuReadScalable, MoreReadersThanCpus) {
+  rcu::Variable<int, rcu::ReadScalableRcuTraits> ptr(42);
+
+  // exhausts the per-CPU hazard pointers
+  std::vector<rcu::ReadablePtr<int, rcu::ReadScalableRcuTraits>> readers;
+  for (std::size_t i = 0; i < std::thread::hardware_concurrency() * 2 + 1;
+       ++i) {
+    readers.push_back(ptr.Read());
+    ptr.Assign(static_cast<int>(i));
+  }
+
+  for (std::size_t i = 1; i < readers.size(); ++i) {
+    EXPECT_EQ(*readers[i], static_cast<int>(i - 1));
+  }
+}
+
+UTEST(RcuReadScalable, BatchedRetire) {
+  constexpr auto kBatchSize = rcu::ReadScalableRcuTraits::kRetireBatchSize;
+
+  std::atomic<bool> destroyed[kBatchSize + 1]{};
+  ReadScalableVariable var{rcu::DestructionType::kSync, destroyed[0]};
+
+  for (std::size_t i = 1; i < kBatchSize; ++i) {
+    var.Emplace(destroyed[i]);
+    EXPECT_FALSE(destroyed[i - 1]) << "the batch is not collected yet";
+  }
+
+  var.Emplace(destroyed[kBatchSize]);
+  for (std::size_t i = 0; i < kBatchSize; ++i) EXPECT_TRUE(destroyed[i]);
+  EXPECT_FALSE(destroyed[kBatchSize]);
+}
+
+UTEST(RcuReadScalable, CleanupCollectsIncompleteBatch) {
+  std::atomic<bool> destroyed[3]{false, false, false};
+  ReadScalableVariable var{rcu::DestructionType::kSync, destroyed[0]};
+
+  {
+    const auto reader = var.Read();
+    var.Emplace(destroyed[1]);
+    var.Emplace(destroyed[2]);
+
+    var.Cleanup();
+    EXPECT_FALSE(destroyed[0]) << "the value is still being read";
+    EXPECT_TRUE(destroyed[1]);
+  }
+
+  var.Cleanup();
+  EXPECT_TRUE(destroyed[0]);
+  EXPECT_FALSE(destroyed[2]);
+}
+
+UTEST_MT(RcuReadScalable, TortureTest, kTotalTasks) {
+  rcu::Variable<CleaningUpInt, rcu::ReadScalableRcuTraits> data{1};
+  std::atomic<bool> keep_running{true};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+
+  for (std::size_t i = 0; i < kTotalTasks - kWritingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto local_ptr = data.Read();
+        auto copy = local_ptr;
+        engine::Yield();
+        ASSERT_GT(copy->value, 0);
+        ASSERT_GT(local_ptr->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kWritingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto old = data.Read();
+        data.Assign(CleaningUpInt{old->value + 1});
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{100});
+  keep_running = false;
+}
+
 USERVER_NAMESPACE_END
@@ -104,7 +104,7 @@ properties:
                 properties:
                     in_buffer_size:
                         type: integer
-                        description: "size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU"
+                        description: "size of the pooled buffers for request receive, idle keep-alive connections hold no buffers: bigger values use more RAM and less CPU"
                         defaultDescription: 32 * 1024
                     requests_queue_size_threshold:
                         type: integer
@@ -114,6 +114,30 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    http_version:
+                        type: string
+                        description: "'1.1' to serve HTTP/1.1 only, '2' to also serve HTTP/2 connections that start with the HTTP/2 connection preface, i.e. h2c with prior knowledge"
+                        defaultDescription: '1.1'
+                        enum:
+                          - '1.1'
+                          - '2'
+                    http2_session:
+                        type: object
+                        description: HTTP/2 session options
+                        additionalProperties: false
+                        properties:
+                            max_concurrent_streams:
+                                type: integer
+                                description: max count of streams processed concurrently within a connection
+                                defaultDescription: 100
+                            max_frame_size:
+                                type: integer
+                                description: max size of a frame payload the server is willing to receive
+                                defaultDescription: 16 * 1024
+                            initial_window_size:
+                                type: integer
+                                description: initial flow control window of a stream for the data sent by client
+                                defaultDescription: 64 * 1024 - 1
                     request:
                         type: object
                         description: request options
@@ -159,7 +183,7 @@ properties:
                 properties:
                     in_buffer_size:
                         type: integer
-                        description: "size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU"
+                        description: "size of the pooled buffers for request receive, idle keep-alive connections hold no buffers: bigger values use more RAM and less CPU"
                         defaultDescription: 32 * 1024
                     requests_queue_size_threshold:
                         type: integer
@@ -169,6 +193,30 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    http_version:
+                        type: string
+                        description: "'1.1' to serve HTTP/1.1 only, '2' to also serve HTTP/2 connections that start with the HTTP/2 connection preface, i.e. h2c with prior knowledge"
+                        defaultDescription: '1.1'
+                        enum:
+                          - '1.1'
+                          - '2'
+                    http2_session:
+                        type: object
+                        description: HTTP/2 session options
+                        additionalProperties: false
+                        properties:
+                            max_concurrent_streams:
+                                type: integer
+                                description: max count of streams processed concurrently within a connection
+                                defaultDescription: 100
+                            max_frame_size:
+                                type: integer
+                                description: max size of a frame payload the server is willing to receive
+                                defaultDescription: 16 * 1024
+                            initial_window_size:
+                                type: integer
+                                description: initial flow control window of a stream for the data sent by client
+                                defaultDescription: 64 * 1024 - 1
                     request:
                         type: object
                         description: request options
@@ -26,6 +26,25 @@ FallbackHandler Parse(const yaml_config::YamlConfig& yaml,
   return FallbackHandlerFromString(value);
 }
 
+ResponseCompressionConfig Parse(const yaml_config::YamlConfig& value,
+                                formats::parse::To<ResponseCompressionConfig>) {
+  ResponseCompressionConfig config;
+  config.encodings = value["encodings"].As<std::vector<std::string>>(
+      std::vector<std::string>{"zstd", "gzip"});
+  config.min_size = value["min_size"].As<size_t>(config.min_size);
+  config.gzip_level = value["gzip_level"].As<int>(config.gzip_level);
+  config.zstd_level = value["zstd_level"].As<int>(config.zstd_level);
+  config.brotli_level = value["brotli_level"].As<int>(config.brotli_level);
+  config.task_processor =
+      value["task_processor"].As<std::optional<std::string>>();
+
+  if (config.encodings.empty()) {
+    throw std::runtime_error(fmt::format(
+        "Expected non-empty 'encodings' list at {}", value.GetPath()));
+  }
+  return config;
+}
+
 HandlerConfig Parse(const yaml_config::YamlConfig& value,
                     formats::parse::To<HandlerConfig>) {
   HandlerConfig config;
@@ -74,6 +93,9 @@ HandlerConfig Parse(const yaml_config::YamlConfig& value,
       value["set-response-server-hostname"].As<std::optional<bool>>();
 
   config.response_body_stream = value["response-body-stream"].As<bool>(false);
+  config.response_compression =
+      value["response_compression"]
+          .As<std::optional<ResponseCompressionConfig>>();
 
   if (config.max_requests_per_second &&
       config.max_requests_per_second.value() <= 0) {
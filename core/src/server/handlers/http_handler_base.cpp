@@ -7,6 +7,7 @@
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/handlers/http_server_settings.hpp>
 #include <server/http/http_request_impl.hpp>
+#include <server/http/response_compressor.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
@@ -35,6 +36,7 @@
 #include <userver/utils/log.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/scope_guard.hpp>
+#include <userver/utils/str_icase.hpp>
 #include <userver/utils/statistics/metadata.hpp>
 #include <userver/utils/text.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
@@ -311,6 +313,79 @@ logging::LogExtra LogRequestExtra(bool need_log_request_headers,
   return log_extra;
 }
 
+std::unique_ptr<http::impl::ResponseCompressionSettings>
+MakeResponseCompressionSettings(const HandlerConfig& config,
+                                const components::ComponentContext& context) {
+  if (!config.response_compression) return {};
+
+  const auto& compression_config = *config.response_compression;
+  engine::TaskProcessor* task_processor = nullptr;
+  if (compression_config.task_processor) {
+    task_processor =
+        &context.GetTaskProcessor(*compression_config.task_processor);
+  }
+  return std::make_unique<http::impl::ResponseCompressionSettings>(
+      compression_config, task_processor);
+}
+
+void AddVaryAcceptEncoding(http::HttpResponse& response) {
+  const auto& vary =
+      response.GetHeader(USERVER_NAMESPACE::http::headers::kVary);
+  if (vary.empty()) {
+    response.SetHeader(USERVER_NAMESPACE::http::headers::kVary,
+                       USERVER_NAMESPACE::http::headers::kAcceptEncoding);
+    return;
+  }
+
+  if (vary == "*" ||
+      utils::StrIcaseEqual{}(
+          vary, USERVER_NAMESPACE::http::headers::kAcceptEncoding)) {
+    return;
+  }
+  response.SetHeader(
+      USERVER_NAMESPACE::http::headers::kVary,
+      fmt::format("{}, {}", vary,
+                  USERVER_NAMESPACE::http::headers::kAcceptEncoding));
+}
+
+// Returns nullptr if the client does not accept any of the codings
+std::unique_ptr<http::impl::ResponseCompressor> MakeResponseCompressor(
+    const http::impl::ResponseCompressionSettings& settings,
+    const http::HttpRequest& http_request, http::HttpResponse& response) {
+  AddVaryAcceptEncoding(response);
+
+  const auto* coding = http::impl::NegotiateEncoding(
+      http_request.GetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding),
+      settings);
+  if (!coding) return {};
+  return std::make_unique<http::impl::ResponseCompressor>(
+      *coding, settings.task_processor);
+}
+
+void CompressResponseData(
+    const http::impl::ResponseCompressionSettings& settings,
+    const http::HttpRequest& http_request, http::HttpResponse& response) {
+  // the body is encoded by the handler
+  if (response.HasHeader(USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+    return;
+  }
+
+  const auto status = static_cast<int>(response.GetStatus());
+  if (status < 200 || status == 204 || status == 304) return;
+
+  try {
+    auto compressor = MakeResponseCompressor(settings, http_request, response);
+    if (!compressor || response.GetData().size() < settings.min_size) return;
+
+    response.SetData(compressor->Compress(response.GetData()));
+    response.SetContentEncoding(
+        std::string{compression::ToString(compressor->GetEncoding())});
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to compress the response, sending it as is: "
+                << ex;
+  }
+}
+
 }  // namespace
 
 HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
@@ -328,7 +403,9 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
           context.FindComponent<components::AuthCheckerSettings>().Get())),
       log_level_(config["log-level"].As<std::optional<logging::Level>>()),
       rate_limit_(utils::TokenBucket::MakeUnbounded()),
-      is_body_streamed_(config["response-body-stream"].As<bool>(false)) {
+      is_body_streamed_(config["response-body-stream"].As<bool>(false)),
+      response_compression_(
+          MakeResponseCompressionSettings(GetConfig(), context)) {
   if (allowed_methods_.empty()) {
     LOG_WARNING() << "empty allowed methods list in " << config.Name();
   }
@@ -478,10 +555,16 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
             auto& response = http_request.GetHttpResponse();
             utils::ScopeGuard scope([&response] { response.SetHeadersEnd(); });
 
+            auto compressor =
+                response_compression_
+                    ? MakeResponseCompressor(*response_compression_,
+                                             http_request, response)
+                    : nullptr;
             HandleStreamRequest(
                 http_request, context,
                 http::ResponseBodyStream{response.GetBodyProducer(),
-                                         http_request.GetHttpResponse()});
+                                         http_request.GetHttpResponse(),
+                                         std::move(compressor)});
             // BodyProducer is dead
           } else {
             // !IsBodyStreamed()
@@ -492,6 +575,11 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
     LOG_ERROR() << "unable to handle request: " << ex;
   }
 
+  // After the response is logged, the logs should not contain compressed data
+  if (response_compression_ && !response.IsBodyStreamed()) {
+    CompressResponseData(*response_compression_, http_request, response);
+  }
+
   SetResponseAcceptEncoding(response);
   SetResponseServerHostname(response);
 }
@@ -11,9 +11,10 @@
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_status.hpp>
 #include <userver/utils/statistics/aggregated_values.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 #include <userver/utils/statistics/http_codes.hpp>
-#include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/sharded_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -36,9 +37,9 @@ class HttpHandlerMethodStatistics final {
     return reply_codes_.FormatReplyCodes();
   }
 
-  using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
-
-  Percentile GetTimings() const { return timings_.GetStatsForPeriod(); }
+  utils::statistics::LatencyHistogram GetTimings() const {
+    return timings_.GetStatsForPeriod();
+  }
 
   size_t GetInFlight() const noexcept { return in_flight_; }
 
@@ -59,23 +60,26 @@ class HttpHandlerMethodStatistics final {
   size_t GetRateLimitReached() const noexcept { return rate_limit_reached_; }
 
   std::uint64_t GetDeadlineReceived() const noexcept {
-    return deadline_received_.load();
+    return deadline_received_.Load();
   }
 
   std::uint64_t GetCancelledByDeadline() const noexcept {
-    return cancelled_by_deadline_.load();
+    return cancelled_by_deadline_.Load();
   }
 
  private:
-  utils::statistics::RecentPeriod<Percentile, Percentile,
+  utils::statistics::RecentPeriod<utils::statistics::ShardedLatencyHistogram,
+                                  utils::statistics::LatencyHistogram,
                                   utils::datetime::SteadyClock>
       timings_;
   utils::statistics::HttpCodes reply_codes_{400, 401, 499, 500};
+  // not sharded, as it is read on every request to limit the requests in
+  // flight
   std::atomic<size_t> in_flight_{0};
   std::atomic<size_t> too_many_requests_in_flight_{0};
   std::atomic<size_t> rate_limit_reached_{0};
-  std::atomic<std::uint64_t> deadline_received_{0};
-  std::atomic<std::uint64_t> cancelled_by_deadline_{0};
+  utils::statistics::ShardedCounter<std::uint64_t> deadline_received_;
+  utils::statistics::ShardedCounter<std::uint64_t> cancelled_by_deadline_;
 };
 
 formats::json::Value Serialize(const HttpHandlerMethodStatistics& stats,
@@ -91,12 +95,13 @@ class HttpRequestMethodStatistics final {
  public:
   void Account(const HttpRequestStatisticsEntry& stats) noexcept;
 
-  using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
-
-  Percentile GetTimings() const { return timings_.GetStatsForPeriod(); }
+  utils::statistics::LatencyHistogram GetTimings() const {
+    return timings_.GetStatsForPeriod();
+  }
 
  private:
-  utils::statistics::RecentPeriod<Percentile, Percentile,
+  utils::statistics::RecentPeriod<utils::statistics::ShardedLatencyHistogram,
+                                  utils::statistics::LatencyHistogram,
                                   utils::datetime::SteadyClock>
       timings_;
 };
@@ -104,6 +104,42 @@ properties:
         type: boolean
         description: TODO
         defaultDescription: false
+    response_compression:
+        type: object
+        description: compress response bodies with a coding negotiated by the Accept-Encoding request header
+        additionalProperties: false
+        properties:
+            encodings:
+                type: array
+                description: content codings in the order of preference
+                defaultDescription: '[zstd, gzip]'
+                items:
+                    type: string
+                    description: content coding
+                    enum:
+                      - gzip
+                      - zstd
+                      - br
+            min_size:
+                type: integer
+                description: do not compress responses smaller than this size, streamed responses are always compressed
+                defaultDescription: 1024
+            gzip_level:
+                type: integer
+                description: gzip compression level, 1..9
+                defaultDescription: 6
+            zstd_level:
+                type: integer
+                description: zstd compression level, 1..19
+                defaultDescription: 3
+            brotli_level:
+                type: integer
+                description: brotli compression level, 0..11
+                defaultDescription: 4
+            task_processor:
+                type: string
+                description: task processor to compress on
+                defaultDescription: <the handler task processor>
 )");
 }
 
@@ -0,0 +1,514 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <nghttp2/nghttp2.h>
+
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kHostHeader = "Host";
+
+std::string_view ToStringView(const uint8_t* data, size_t size) {
+  return {reinterpret_cast<const char*>(data), size};
+}
+
+nghttp2_nv MakeNv(std::string_view name, std::string_view value) {
+  nghttp2_nv nv{};
+  nv.name = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(name.data()));
+  nv.namelen = name.size();
+  nv.value =
+      const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(value.data()));
+  nv.valuelen = value.size();
+  nv.flags = NGHTTP2_NV_FLAG_NONE;
+  return nv;
+}
+
+HttpMethod ParseHttpMethod(std::string_view method) {
+  try {
+    return HttpMethodFromString(std::string{method});
+  } catch (const std::exception&) {
+    return HttpMethod::kUnknown;
+  }
+}
+
+bool IsRequestHeaders(const nghttp2_frame& frame) {
+  return frame.hd.type == NGHTTP2_HEADERS &&
+         frame.headers.cat == NGHTTP2_HCAT_REQUEST;
+}
+
+}  // namespace
+
+struct Http2Session::Callbacks {
+  static int OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                            void* user_data) {
+    if (!IsRequestHeaders(*frame)) return 0;
+    auto& self = *static_cast<Http2Session*>(user_data);
+    try {
+      const auto stream_id = frame->hd.stream_id;
+      auto stream = std::make_shared<Stream>(stream_id);
+      stream->request_constructor = std::make_unique<HttpRequestConstructor>(
+          self.request_constructor_config_, self.handler_info_index_,
+          self.data_accounter_);
+      stream->request_constructor->SetHttpMajor(2);
+      stream->request_constructor->SetHttpMinor(0);
+      stream->request_constructor->SetHttp2StreamId(stream_id);
+      self.streams_.emplace(stream_id, std::move(stream));
+      ++self.stats_.parsing_request_count;
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to start HTTP/2 stream: " << ex;
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+    return 0;
+  }
+
+  static int OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                      const uint8_t* name, size_t name_size,
+                      const uint8_t* value, size_t value_size, uint8_t,
+                      void* user_data) {
+    // Trailers are ignored, like chunked encoding trailers in HTTP/1.1
+    if (!IsRequestHeaders(*frame)) return 0;
+    auto& self = *static_cast<Http2Session*>(user_data);
+    const auto stream = self.FindStream(frame->hd.stream_id);
+    if (!stream || !stream->request_constructor || stream->is_request_failed) {
+      return 0;
+    }
+
+    const auto name_view = ToStringView(name, name_size);
+    const auto value_view = ToStringView(value, value_size);
+    LOG_TRACE() << "stream " << stream->id << " header: '" << name_view
+                << "': '" << value_view << '\'';
+    auto& constructor = *stream->request_constructor;
+    try {
+      if (name_view == ":method") {
+        constructor.SetMethod(ParseHttpMethod(value_view));
+      } else if (name_view == ":path") {
+        constructor.AppendUrl(value_view.data(), value_view.size());
+      } else if (name_view == ":authority") {
+        stream->authority = value_view;
+      } else if (name_view.empty() || name_view.front() != ':') {
+        // nghttp2 guarantees that pseudo headers go first
+        self.ParseUrl(*stream);
+        constructor.AppendHeaderField(name_view.data(), name_view.size());
+        constructor.AppendHeaderValue(value_view.data(), value_view.size());
+      }
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't process header of stream " << stream->id << ": "
+                    << ex;
+      stream->is_request_failed = true;
+    }
+    return 0;
+  }
+
+  static int OnDataChunkRecv(nghttp2_session*, uint8_t, int32_t stream_id,
+                             const uint8_t* data, size_t size,
+                             void* user_data) {
+    auto& self = *static_cast<Http2Session*>(user_data);
+    const auto stream = self.FindStream(stream_id);
+    if (!stream || !stream->request_constructor || stream->is_request_failed) {
+      return 0;
+    }
+
+    try {
+      stream->request_constructor->AppendBody(
+          reinterpret_cast<const char*>(data), size);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append body of stream " << stream->id << ": "
+                    << ex;
+      stream->is_request_failed = true;
+    }
+    return 0;
+  }
+
+  static int OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                         void* user_data) {
+    if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA) {
+      return 0;
+    }
+    auto& self = *static_cast<Http2Session*>(user_data);
+    const auto stream = self.FindStream(frame->hd.stream_id);
+    if (!stream || !stream->request_constructor) return 0;
+
+    try {
+      if (IsRequestHeaders(*frame) && !stream->is_request_failed) {
+        try {
+          self.ParseUrl(*stream);
+          // flushes the last header
+          stream->request_constructor->AppendHeaderField("", 0);
+        } catch (const std::exception& ex) {
+          LOG_WARNING() << "can't process headers of stream " << stream->id
+                        << ": " << ex;
+          stream->is_request_failed = true;
+        }
+      }
+      if (frame->hd.flags & NGHTTP2_FLAG_END_STREAM) {
+        self.FinishRequest(*stream);
+      }
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to finish request of stream " << stream->id
+                  << ": " << ex;
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+    return 0;
+  }
+
+  static int OnStreamClose(nghttp2_session*, int32_t stream_id, uint32_t,
+                           void* user_data) {
+    auto& self = *static_cast<Http2Session*>(user_data);
+    const auto it = self.streams_.find(stream_id);
+    if (it == self.streams_.end()) return 0;
+
+    auto& stream = *it->second;
+    if (stream.request_constructor) {
+      // the peer has reset the stream before sending the whole request
+      stream.request_constructor.reset();
+      --self.stats_.parsing_request_count;
+    }
+    stream.is_closed = true;
+    self.streams_.erase(it);
+    self.cv_.NotifyAll();
+    return 0;
+  }
+
+  static ssize_t ReadData(nghttp2_session*, int32_t, uint8_t* buf,
+                          size_t length, uint32_t* data_flags,
+                          nghttp2_data_source* source, void* user_data) {
+    auto& self = *static_cast<Http2Session*>(user_data);
+    auto& stream = *static_cast<Stream*>(source->ptr);
+    if (stream.pending_data.empty() && !stream.is_data_end) {
+      stream.is_data_deferred = true;
+      return NGHTTP2_ERR_DEFERRED;
+    }
+
+    const auto size = std::min(length, stream.pending_data.size());
+    if (size) std::memcpy(buf, stream.pending_data.data(), size);
+    stream.pending_data.remove_prefix(size);
+
+    if (stream.pending_data.empty()) {
+      if (stream.is_data_end) {
+        *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+        stream.is_eof_sent = true;
+      }
+      self.cv_.NotifyAll();
+    }
+    return static_cast<ssize_t>(size);
+  }
+};
+
+Http2Session::Http2Session(const HandlerInfoIndex& handler_info_index,
+                           const request::RequestConfig& request_config,
+                           const net::Http2SessionConfig& session_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter,
+                           engine::io::Socket& socket)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config.GetHttpConfig()},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter),
+      socket_(socket) {
+  nghttp2_session_callbacks* callbacks = nullptr;
+  if (nghttp2_session_callbacks_new(&callbacks) != 0) {
+    throw std::runtime_error("nghttp2_session_callbacks_new() failed");
+  }
+  utils::ScopeGuard callbacks_guard(
+      [callbacks] { nghttp2_session_callbacks_del(callbacks); });
+
+  nghttp2_session_callbacks_set_on_begin_headers_callback(
+      callbacks, &Callbacks::OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks,
+                                                   &Callbacks::OnHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+      callbacks, &Callbacks::OnDataChunkRecv);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(
+      callbacks, &Callbacks::OnFrameRecv);
+  nghttp2_session_callbacks_set_on_stream_close_callback(
+      callbacks, &Callbacks::OnStreamClose);
+
+  if (nghttp2_session_server_new(&session_, callbacks, this) != 0) {
+    throw std::runtime_error("nghttp2_session_server_new() failed");
+  }
+
+  const std::array<nghttp2_settings_entry, 3> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+       session_config.max_concurrent_streams},
+      {NGHTTP2_SETTINGS_MAX_FRAME_SIZE, session_config.max_frame_size},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE,
+       session_config.initial_window_size},
+  }};
+  const auto result = nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE,
+                                              settings.data(), settings.size());
+  if (result != 0) {
+    nghttp2_session_del(session_);
+    throw std::runtime_error(fmt::format("nghttp2_submit_settings() failed: {}",
+                                         nghttp2_strerror(result)));
+  }
+}
+
+Http2Session::~Http2Session() { nghttp2_session_del(session_); }
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  std::vector<std::shared_ptr<request::RequestBase>> new_requests;
+  bool is_ok = true;
+  {
+    std::unique_lock lock(mutex_);
+    const auto result = nghttp2_session_mem_recv(
+        session_, reinterpret_cast<const uint8_t*>(data), size);
+    if (result < 0) {
+      LOG_WARNING() << "HTTP/2 session error: "
+                    << nghttp2_strerror(static_cast<int>(result));
+      is_ok = false;
+    }
+
+    // Settings acknowledgements, window updates and the data that was waiting
+    // for them
+    Flush(lock);
+
+    is_ok = is_ok && (nghttp2_session_want_read(session_) ||
+                      nghttp2_session_want_write(session_));
+    new_requests.swap(new_requests_);
+  }
+
+  // Starting a request may block, the session is not locked for that time
+  for (auto& request : new_requests) on_new_request_cb_(std::move(request));
+  return is_ok;
+}
+
+bool Http2Session::HasOpenStreams() {
+  std::unique_lock lock(mutex_);
+  return !streams_.empty();
+}
+
+void Http2Session::Close() noexcept {
+  std::unique_lock lock(mutex_);
+  is_closed_ = true;
+  cv_.NotifyAll();
+}
+
+std::shared_ptr<Http2Session::Stream> Http2Session::FindStream(
+    std::int32_t stream_id) const {
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return {};
+  return it->second;
+}
+
+void Http2Session::ParseUrl(Stream& stream) {
+  if (stream.is_url_parsed) return;
+  stream.is_url_parsed = true;
+
+  auto& constructor = *stream.request_constructor;
+  constructor.ParseUrl();
+  if (!stream.authority.empty()) {
+    constructor.AppendHeaderField(kHostHeader.data(), kHostHeader.size());
+    constructor.AppendHeaderValue(stream.authority.data(),
+                                  stream.authority.size());
+  }
+}
+
+void Http2Session::FinishRequest(Stream& stream) {
+  auto request_constructor = std::move(stream.request_constructor);
+  UASSERT(request_constructor);
+  --stats_.parsing_request_count;
+
+  if (auto request = request_constructor->Finalize()) {
+    new_requests_.push_back(std::move(request));
+  } else {
+    LOG_ERROR() << "request is null after Finalize()";
+  }
+}
+
+void Http2Session::SubmitResponse(
+    std::unique_lock<engine::Mutex>& lock, Stream& stream, HttpStatus status,
+    const std::vector<std::pair<std::string, std::string>>& headers,
+    bool end_stream) {
+  const auto status_string = std::to_string(static_cast<int>(status));
+
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(headers.size() + 1);
+  nva.push_back(MakeNv(":status", status_string));
+  for (const auto& [name, value] : headers) nva.push_back(MakeNv(name, value));
+
+  nghttp2_data_provider data_provider{};
+  data_provider.source.ptr = &stream;
+  data_provider.read_callback = &Callbacks::ReadData;
+
+  const auto result =
+      nghttp2_submit_response(session_, stream.id, nva.data(), nva.size(),
+                              end_stream ? nullptr : &data_provider);
+  if (result != 0) {
+    throw std::runtime_error(
+        fmt::format("nghttp2_submit_response() failed for stream {}: {}",
+                    stream.id, nghttp2_strerror(result)));
+  }
+  Flush(lock);
+}
+
+void Http2Session::SubmitData(std::unique_lock<engine::Mutex>& lock,
+                              Stream& stream, std::string_view data,
+                              bool end_stream) {
+  UASSERT(!stream.is_data_end);
+
+  // nghttp2 must not read the data once this function exits
+  utils::ScopeGuard pending_data_guard([&stream] { stream.pending_data = {}; });
+
+  stream.pending_data = data;
+  stream.is_data_end = end_stream;
+  if (stream.is_data_deferred) {
+    stream.is_data_deferred = false;
+    nghttp2_session_resume_data(session_, stream.id);
+  }
+  Flush(lock);
+
+  // Waits for the window updates from the peer, they are received by Parse()
+  const bool is_written = cv_.Wait(lock, [this, &stream] {
+    return stream.is_closed || is_closed_ ||
+           (stream.pending_data.empty() && (!stream.is_data_end ||
+                                            stream.is_eof_sent));
+  });
+  if (!is_written || stream.is_closed || is_closed_) {
+    throw std::runtime_error(
+        fmt::format("HTTP/2 stream {} was closed before the response was "
+                    "sent",
+                    stream.id));
+  }
+}
+
+void Http2Session::ResetStream(std::unique_lock<engine::Mutex>& lock,
+                               Stream& stream) noexcept {
+  if (stream.is_closed || is_closed_) return;
+  try {
+    nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream.id,
+                              NGHTTP2_INTERNAL_ERROR);
+    Flush(lock);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to reset HTTP/2 stream " << stream.id << ": "
+                  << ex;
+  }
+}
+
+void Http2Session::Flush(std::unique_lock<engine::Mutex>& lock) {
+  UASSERT(lock.owns_lock());
+  if (is_closed_) return;
+
+  {
+    utils::ScopeGuard close_guard([this] {
+      // the connection is broken, nothing is going to be sent
+      is_closed_ = true;
+      cv_.NotifyAll();
+    });
+
+    while (true) {
+      const uint8_t* data = nullptr;
+      const auto size = nghttp2_session_mem_send(session_, &data);
+      if (size < 0) {
+        throw std::runtime_error(
+            fmt::format("nghttp2_session_mem_send() failed: {}",
+                        nghttp2_strerror(static_cast<int>(size))));
+      }
+      if (size == 0) break;
+      send_buffer_.append(reinterpret_cast<const char*>(data), size);
+    }
+
+    close_guard.Release();
+  }
+
+  SendPending(lock);
+}
+
+void Http2Session::SendPending(std::unique_lock<engine::Mutex>& lock) {
+  if (send_buffer_.empty()) return;
+
+  lock.unlock();
+  // The frames serialized so far are either taken by this writer or by the
+  // one holding the send lock, in both cases they are sent in order
+  std::lock_guard send_lock(send_mutex_);
+  lock.lock();
+  std::string buffer;
+  buffer.swap(send_buffer_);
+  if (buffer.empty() || is_closed_) return;
+  lock.unlock();
+
+  try {
+    Send(buffer.data(), buffer.size());
+  } catch (const std::exception&) {
+    lock.lock();
+    // the connection is broken, nothing is going to be sent
+    is_closed_ = true;
+    cv_.NotifyAll();
+    throw;
+  }
+
+  lock.lock();
+  // keeps the capacity for the next frames
+  if (send_buffer_.empty()) {
+    buffer.clear();
+    send_buffer_.swap(buffer);
+  }
+}
+
+void Http2Session::Send(const char* data, size_t size) {
+  LOG_TRACE() << "Sending " << size << " byte(s) of HTTP/2 frames on fd "
+              << socket_.Fd();
+  if (socket_.SendAll(data, size, {}) != size) {
+    throw std::runtime_error("connection was closed by peer");
+  }
+}
+
+namespace impl {
+
+Http2StreamWriter::Http2StreamWriter(Http2Session& session,
+                                     std::int32_t stream_id)
+    : session_(session) {
+  std::unique_lock lock(session_.mutex_);
+  stream_ = session_.FindStream(stream_id);
+}
+
+Http2StreamWriter::~Http2StreamWriter() {
+  if (is_finished_ || !stream_) return;
+
+  // The response was not sent in full, the peer must not wait for the rest
+  std::unique_lock lock(session_.mutex_);
+  session_.ResetStream(lock, *stream_);
+}
+
+void Http2StreamWriter::WriteHeaders(HttpStatus status, const Headers& headers,
+                                     bool end_stream) {
+  std::unique_lock lock(session_.mutex_);
+  if (!stream_ || stream_->is_closed || session_.is_closed_) {
+    throw std::runtime_error("HTTP/2 stream was closed before the response");
+  }
+
+  session_.SubmitResponse(lock, *stream_, status, headers, end_stream);
+  for (const auto& [name, value] : headers) {
+    bytes_written_ += name.size() + value.size();
+  }
+  is_finished_ = end_stream;
+}
+
+void Http2StreamWriter::WriteData(std::string_view data, bool end_stream) {
+  UASSERT(stream_);
+  std::unique_lock lock(session_.mutex_);
+  session_.SubmitData(lock, *stream_, data, end_stream);
+  bytes_written_ += data.size();
+  is_finished_ = end_stream;
+}
+
+}  // namespace impl
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
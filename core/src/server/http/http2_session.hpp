@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/server/http/http_status.hpp>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_config.hpp>
+#include <server/request/request_parser.hpp>
+
+#include "http_request_constructor.hpp"
+
+struct nghttp2_session;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace impl {
+class Http2StreamWriter;
+}  // namespace impl
+
+/// @brief Server side of an HTTP/2 connection on top of nghttp2.
+///
+/// Frames received from the peer are passed to Parse(), requests are produced
+/// by a HttpRequestConstructor per stream and handed to the callback once the
+/// stream is half-closed by the peer. Responses are sent with
+/// impl::Http2StreamWriter from any task. Frames are serialized under the
+/// session lock and written to the socket after releasing it, so that the
+/// other streams are not blocked by the network. HPACK and flow control are
+/// handled by nghttp2.
+class Http2Session final : public request::RequestParser {
+ public:
+  using OnNewRequestCb =
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>;
+
+  /// The client connection preface, starts every HTTP/2 connection
+  static constexpr std::string_view kConnectionPreface =
+      "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+  Http2Session(const HandlerInfoIndex& handler_info_index,
+               const request::RequestConfig& request_config,
+               const net::Http2SessionConfig& session_config,
+               OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter,
+               engine::io::Socket& socket);
+
+  ~Http2Session() override;
+
+  /// @brief Processes the received data and sends the frames produced in
+  /// reply.
+  /// @returns false on protocol errors and when the session is over
+  bool Parse(const char* data, size_t size) override;
+
+  /// Whether there are streams that are not closed yet
+  bool HasOpenStreams();
+
+  /// @brief Fails all the pending and future sends, to be called once no
+  /// more data can be received from the peer.
+  void Close() noexcept;
+
+ private:
+  friend class impl::Http2StreamWriter;
+
+  struct Callbacks;
+
+  struct Stream {
+    explicit Stream(std::int32_t id) : id(id) {}
+
+    const std::int32_t id;
+
+    // request
+    std::unique_ptr<HttpRequestConstructor> request_constructor;
+    std::string authority;
+    bool is_url_parsed{false};
+    bool is_request_failed{false};
+
+    // response body not yet taken by nghttp2
+    std::string_view pending_data;
+    bool is_data_end{false};
+    bool is_data_deferred{false};
+    bool is_eof_sent{false};
+    bool is_closed{false};
+  };
+
+  // All the methods below must be called with the mutex held, the ones that
+  // take the lock release it while writing to the socket
+  std::shared_ptr<Stream> FindStream(std::int32_t stream_id) const;
+  void ParseUrl(Stream& stream);
+  void FinishRequest(Stream& stream);
+
+  void SubmitResponse(std::unique_lock<engine::Mutex>& lock, Stream& stream,
+                      HttpStatus status,
+                      const std::vector<std::pair<std::string, std::string>>&
+                          headers,
+                      bool end_stream);
+  void SubmitData(std::unique_lock<engine::Mutex>& lock, Stream& stream,
+                  std::string_view data, bool end_stream);
+  void ResetStream(std::unique_lock<engine::Mutex>& lock,
+                   Stream& stream) noexcept;
+  void Flush(std::unique_lock<engine::Mutex>& lock);
+  void SendPending(std::unique_lock<engine::Mutex>& lock);
+  void Send(const char* data, size_t size);
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+  OnNewRequestCb on_new_request_cb_;
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+  engine::io::Socket& socket_;
+
+  engine::Mutex mutex_;
+  // Orders the writes of the frames serialized into send_buffer_, taken
+  // before mutex_
+  engine::Mutex send_mutex_;
+  engine::ConditionVariable cv_;
+  nghttp2_session* session_{nullptr};
+  std::unordered_map<std::int32_t, std::shared_ptr<Stream>> streams_;
+  std::vector<std::shared_ptr<request::RequestBase>> new_requests_;
+  std::string send_buffer_;
+  bool is_closed_{false};
+};
+
+namespace impl {
+
+/// @brief Sends a response to the stream of a request, blocks while the data
+/// does not fit into the flow control window of the peer.
+class Http2StreamWriter final {
+ public:
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  Http2StreamWriter(Http2Session& session, std::int32_t stream_id);
+  ~Http2StreamWriter();
+
+  Http2StreamWriter(Http2StreamWriter&&) = delete;
+  Http2StreamWriter& operator=(Http2StreamWriter&&) = delete;
+
+  /// @param headers names must be in lowercase
+  void WriteHeaders(HttpStatus status, const Headers& headers,
+                    bool end_stream);
+
+  /// @brief Sends the data, returns once the data is taken by the session.
+  /// @throws std::runtime_error if the stream was closed
+  void WriteData(std::string_view data, bool end_stream);
+
+  size_t GetBytesWritten() const { return bytes_written_; }
+
+ private:
+  Http2Session& session_;
+  std::shared_ptr<Http2Session::Stream> stream_;
+  size_t bytes_written_{0};
+  bool is_finished_{false};
+};
+
+}  // namespace impl
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,325 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/http/http2_session.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <userver/utest/net_listener.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+const server::http::HandlerInfoIndex kTestHandlerInfoIndex;
+constexpr server::request::RequestConfig kTestRequestConfig(
+    server::request::HttpRequestConfig{
+        /*.max_url_size = */ 8192,
+        /*.max_request_size = */ 1024 * 1024,
+        /*.max_headers_size = */ 65536,
+        /*.parse_args_from_body = */ false,
+        /*.testing_mode = */ true,
+        /*.decompress_request = */ false,
+    });
+
+nghttp2_nv MakeNv(const std::string& name, const std::string& value) {
+  return {reinterpret_cast<uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+}
+
+// Minimal HTTP/2 client on top of nghttp2, frames are passed around by hand
+class TestClient final {
+ public:
+  TestClient() {
+    nghttp2_session_callbacks* callbacks = nullptr;
+    nghttp2_session_callbacks_new(&callbacks);
+    nghttp2_session_callbacks_set_on_header_callback(callbacks, &OnHeader);
+    nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+        callbacks, &OnDataChunkRecv);
+    nghttp2_session_callbacks_set_on_stream_close_callback(callbacks,
+                                                           &OnStreamClose);
+    nghttp2_session_client_new(&session_, callbacks, this);
+    nghttp2_session_callbacks_del(callbacks);
+    nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, nullptr, 0);
+  }
+
+  ~TestClient() { nghttp2_session_del(session_); }
+
+  std::int32_t SubmitRequest(
+      const std::vector<std::pair<std::string, std::string>>& headers,
+      std::string_view body = {}) {
+    std::vector<nghttp2_nv> nva;
+    for (const auto& [name, value] : headers) {
+      nva.push_back(MakeNv(name, value));
+    }
+
+    pending_body_ = body;
+    nghttp2_data_provider data_provider{};
+    data_provider.read_callback = &ReadBody;
+    return nghttp2_submit_request(session_, nullptr, nva.data(), nva.size(),
+                                  body.empty() ? nullptr : &data_provider,
+                                  nullptr);
+  }
+
+  std::string Send() {
+    std::string result;
+    const uint8_t* data = nullptr;
+    while (const auto size = nghttp2_session_mem_send(session_, &data)) {
+      EXPECT_GT(size, 0);
+      if (size < 0) break;
+      result.append(reinterpret_cast<const char*>(data), size);
+    }
+    return result;
+  }
+
+  void RecvSome(engine::io::Socket& socket) {
+    std::array<char, 4096> buffer{};
+    const auto size = socket.RecvSome(
+        buffer.data(), buffer.size(),
+        engine::Deadline::FromDuration(utest::kMaxTestWaitTime));
+    ASSERT_GT(size, std::size_t{0});
+    ASSERT_EQ(nghttp2_session_mem_recv(
+                  session_, reinterpret_cast<const uint8_t*>(buffer.data()),
+                  size),
+              static_cast<ssize_t>(size));
+  }
+
+  void RecvResponse(engine::io::Socket& socket) {
+    while (!is_stream_closed_) {
+      ASSERT_NO_FATAL_FAILURE(RecvSome(socket));
+    }
+  }
+
+  const std::string& GetStatus() const { return status_; }
+  const std::string& GetBody() const { return body_; }
+  std::uint32_t GetErrorCode() const { return error_code_; }
+
+ private:
+  static ssize_t ReadBody(nghttp2_session*, int32_t, uint8_t* buf,
+                          size_t length, uint32_t* data_flags,
+                          nghttp2_data_source*, void* user_data) {
+    auto& self = *static_cast<TestClient*>(user_data);
+    const auto size = std::min(length, self.pending_body_.size());
+    std::memcpy(buf, self.pending_body_.data(), size);
+    self.pending_body_.remove_prefix(size);
+    if (self.pending_body_.empty()) *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    return static_cast<ssize_t>(size);
+  }
+
+  static int OnHeader(nghttp2_session*, const nghttp2_frame*,
+                      const uint8_t* name, size_t namelen,
+                      const uint8_t* value, size_t valuelen, uint8_t,
+                      void* user_data) {
+    auto& self = *static_cast<TestClient*>(user_data);
+    if (std::string_view(reinterpret_cast<const char*>(name), namelen) ==
+        ":status") {
+      self.status_.assign(reinterpret_cast<const char*>(value), valuelen);
+    }
+    return 0;
+  }
+
+  static int OnDataChunkRecv(nghttp2_session*, uint8_t, int32_t,
+                             const uint8_t* data, size_t len,
+                             void* user_data) {
+    auto& self = *static_cast<TestClient*>(user_data);
+    self.body_.append(reinterpret_cast<const char*>(data), len);
+    return 0;
+  }
+
+  static int OnStreamClose(nghttp2_session*, int32_t, uint32_t error_code,
+                           void* user_data) {
+    auto& self = *static_cast<TestClient*>(user_data);
+    self.is_stream_closed_ = true;
+    self.error_code_ = error_code;
+    return 0;
+  }
+
+  nghttp2_session* session_{nullptr};
+  std::string_view pending_body_;
+  std::string status_;
+  std::string body_;
+  std::uint32_t error_code_{0};
+  bool is_stream_closed_{false};
+};
+
+struct SessionFixture {
+  SessionFixture() {
+    auto sockets = listener.MakeSocketPair(
+        engine::Deadline::FromDuration(utest::kMaxTestWaitTime));
+    server_socket = std::move(sockets.first);
+    client_socket = std::move(sockets.second);
+  }
+
+  server::http::Http2Session MakeSession() {
+    return server::http::Http2Session(
+        kTestHandlerInfoIndex, kTestRequestConfig, {},
+        [this](std::shared_ptr<server::request::RequestBase>&& request) {
+          requests.push_back(
+              std::dynamic_pointer_cast<server::http::HttpRequestImpl>(
+                  request));
+        },
+        stats, accounter, server_socket);
+  }
+
+  utest::TcpListener listener;
+  engine::io::Socket server_socket;
+  engine::io::Socket client_socket;
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter accounter;
+  std::vector<std::shared_ptr<server::http::HttpRequestImpl>> requests;
+};
+
+}  // namespace
+
+UTEST(Http2Session, RequestIsParsed) {
+  SessionFixture fixture;
+  auto session = fixture.MakeSession();
+
+  TestClient client;
+  const auto stream_id = client.SubmitRequest({
+      {":method", "PUT"},
+      {":scheme", "http"},
+      {":authority", "example.com"},
+      {":path", "/path?arg=value"},
+      {"x-test", "test"},
+  });
+  const auto data = client.Send();
+  ASSERT_EQ(std::string_view{data}.substr(
+                0, server::http::Http2Session::kConnectionPreface.size()),
+            server::http::Http2Session::kConnectionPreface);
+  ASSERT_TRUE(session.Parse(data.data(), data.size()));
+
+  ASSERT_EQ(fixture.requests.size(), std::size_t{1});
+  const auto& request = *fixture.requests.front();
+  EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kPut);
+  EXPECT_EQ(request.GetRequestPath(), "/path");
+  EXPECT_EQ(request.GetArg("arg"), "value");
+  EXPECT_EQ(request.GetHeader("Host"), "example.com");
+  EXPECT_EQ(request.GetHeader("X-Test"), "test");
+  EXPECT_EQ(request.GetHttpMajor(), 2);
+  EXPECT_EQ(request.GetHttp2StreamId(), stream_id);
+  EXPECT_TRUE(session.HasOpenStreams());
+}
+
+UTEST(Http2Session, RequestBody) {
+  SessionFixture fixture;
+  auto session = fixture.MakeSession();
+
+  // The body does not fit into the initial window of the stream, the rest is
+  // sent once the window updates are received from the server
+  const std::string body(200 * 1000, 'a');
+  TestClient client;
+  client.SubmitRequest(
+      {
+          {":method", "POST"},
+          {":scheme", "http"},
+          {":path", "/"},
+          {"content-length", std::to_string(body.size())},
+      },
+      body);
+
+  while (true) {
+    const auto data = client.Send();
+    if (!data.empty()) {
+      ASSERT_TRUE(session.Parse(data.data(), data.size()));
+    }
+    if (!fixture.requests.empty()) break;
+    ASSERT_NO_FATAL_FAILURE(client.RecvSome(fixture.client_socket));
+  }
+
+  ASSERT_EQ(fixture.requests.size(), std::size_t{1});
+  EXPECT_EQ(fixture.requests.front()->RequestBody(), body);
+}
+
+UTEST(Http2Session, ResponseIsSent) {
+  SessionFixture fixture;
+  auto session = fixture.MakeSession();
+
+  TestClient client;
+  client.SubmitRequest({
+      {":method", "GET"},
+      {":scheme", "http"},
+      {":path", "/"},
+  });
+  const auto data = client.Send();
+  ASSERT_TRUE(session.Parse(data.data(), data.size()));
+  ASSERT_EQ(fixture.requests.size(), std::size_t{1});
+
+  {
+    server::http::impl::Http2StreamWriter writer{
+        session, fixture.requests.front()->GetHttp2StreamId()};
+    writer.WriteHeaders(server::http::HttpStatus::kCreated,
+                        {{"content-type", "text/plain"}}, false);
+    writer.WriteData("hello, ", false);
+    writer.WriteData("world", true);
+  }
+
+  client.RecvResponse(fixture.client_socket);
+  EXPECT_EQ(client.GetStatus(), "201");
+  EXPECT_EQ(client.GetBody(), "hello, world");
+  EXPECT_EQ(client.GetErrorCode(), NGHTTP2_NO_ERROR);
+}
+
+UTEST(Http2Session, UnfinishedResponseResetsStream) {
+  SessionFixture fixture;
+  auto session = fixture.MakeSession();
+
+  TestClient client;
+  client.SubmitRequest({
+      {":method", "GET"},
+      {":scheme", "http"},
+      {":path", "/"},
+  });
+  const auto data = client.Send();
+  ASSERT_TRUE(session.Parse(data.data(), data.size()));
+  ASSERT_EQ(fixture.requests.size(), std::size_t{1});
+
+  {
+    server::http::impl::Http2StreamWriter writer{
+        session, fixture.requests.front()->GetHttp2StreamId()};
+    writer.WriteHeaders(server::http::HttpStatus::kOk, {}, false);
+  }
+
+  client.RecvResponse(fixture.client_socket);
+  EXPECT_EQ(client.GetStatus(), "200");
+  EXPECT_EQ(client.GetErrorCode(), NGHTTP2_INTERNAL_ERROR);
+}
+
+UTEST(Http2Session, ClosedSessionFailsWrites) {
+  SessionFixture fixture;
+  auto session = fixture.MakeSession();
+
+  TestClient client;
+  client.SubmitRequest({
+      {":method", "GET"},
+      {":scheme", "http"},
+      {":path", "/"},
+  });
+  const auto data = client.Send();
+  ASSERT_TRUE(session.Parse(data.data(), data.size()));
+  ASSERT_EQ(fixture.requests.size(), std::size_t{1});
+
+  session.Close();
+  server::http::impl::Http2StreamWriter writer{
+      session, fixture.requests.front()->GetHttp2StreamId()};
+  UEXPECT_THROW(
+      writer.WriteHeaders(server::http::HttpStatus::kOk, {}, false),
+      std::runtime_error);
+}
+
+UTEST(Http2Session, GarbageIsRejected) {
+  SessionFixture fixture;
+  auto session = fixture.MakeSession();
+
+  const std::string_view garbage = "GET / HTTP/1.1\r\n\r\n";
+  EXPECT_FALSE(session.Parse(garbage.data(), garbage.size()));
+  EXPECT_TRUE(fixture.requests.empty());
+}
+
+USERVER_NAMESPACE_END
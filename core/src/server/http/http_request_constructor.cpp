@@ -1,6 +1,7 @@
 #include "http_request_constructor.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 #include <userver/http/common_headers.hpp>
 #include <userver/logging/log.hpp>
@@ -19,6 +20,11 @@ namespace {
 
 const std::string kCookieHeader = "Cookie";
 
+// Smaller bodies usually arrive along with the headers, receiving them in
+// place is not worth it. It is also the size of the first in-place window of
+// larger bodies, the next windows grow with the received body.
+constexpr size_t kMinInPlaceBodySize = 16 * 1024;
+
 inline void Strip(const char*& begin, const char*& end) {
   while (begin < end && isspace(*begin)) ++begin;
   while (begin < end && isspace(end[-1])) --end;
@@ -63,6 +69,10 @@ void HttpRequestConstructor::SetHttpMinor(unsigned short http_minor) {
   request_->http_minor_ = http_minor;
 }
 
+void HttpRequestConstructor::SetHttp2StreamId(std::int32_t stream_id) {
+  request_->http2_stream_id_ = stream_id;
+}
+
 void HttpRequestConstructor::AppendUrl(const char* data, size_t size) {
   // using common limits in checks
   AccountUrlSize(size);
@@ -164,7 +174,56 @@ void HttpRequestConstructor::AppendHeaderValue(const char* data, size_t size) {
 
 void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
   AccountRequestSize(size);
-  request_->request_body_.append(data, size);
+
+  auto& body = request_->request_body_;
+  if (!is_body_in_place_) {
+    body.append(data, size);
+    return;
+  }
+
+  UINVARIANT(body_size_ + size <= expected_body_size_,
+             "Request body is larger than its Content-Length");
+  // Data received via GetBodyBuffer() is already in place
+  if (body_size_ + size > body.size() || data != body.data() + body_size_) {
+    body.resize(std::max(body.size(), body_size_ + size));
+    std::memcpy(body.data() + body_size_, data, size);
+  }
+  body_size_ += size;
+}
+
+void HttpRequestConstructor::ReserveBody(size_t content_length) {
+  UASSERT(!is_body_in_place_);
+  UASSERT(request_->request_body_.empty());
+
+  // Too large bodies are rejected by AccountRequestSize() on arrival
+  if (content_length > config_.max_request_size ||
+      request_size_ + content_length > config_.max_request_size) {
+    return;
+  }
+
+  // Content-Length alone must not make the server commit memory that the
+  // client does not send, the storage grows as the body arrives
+  request_->request_body_.reserve(
+      std::min(content_length, kMinInPlaceBodySize));
+  if (content_length < kMinInPlaceBodySize) return;
+
+  expected_body_size_ = content_length;
+  is_body_in_place_ = true;
+}
+
+HttpRequestConstructor::BodyBuffer HttpRequestConstructor::GetBodyBuffer() {
+  if (!is_body_in_place_) return {};
+
+  auto& body = request_->request_body_;
+  if (body.size() == body_size_) {
+    // The window is at most as large as the already received part of the
+    // body, so the memory grows geometrically with the received data
+    const auto window =
+        std::min(expected_body_size_ - body_size_,
+                 std::max(body_size_, kMinInPlaceBodySize));
+    body.resize(body_size_ + window);
+  }
+  return {body.data() + body_size_, body.size() - body_size_};
 }
 
 void HttpRequestConstructor::SetIsFinal(bool is_final) {
@@ -175,6 +234,9 @@ std::shared_ptr<request::RequestBase> HttpRequestConstructor::Finalize() {
   LOG_TRACE() << "method=" << request_->GetMethodStr()
               << " orig_method=" << request_->GetOrigMethodStr();
 
+  // The body may be incomplete if the request is malformed
+  if (is_body_in_place_) request_->request_body_.resize(body_size_);
+
   FinalizeImpl();
 
   CheckStatus();
@@ -243,8 +305,11 @@ void HttpRequestConstructor::ParseArgs(const http_parser_url& url) {
 }
 
 void HttpRequestConstructor::ParseArgs(const char* data, size_t size) {
-  return USERVER_NAMESPACE::http::parser::ParseArgs(
-      std::string_view(data, size), request_->request_args_);
+  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgs(
+      std::string_view(data, size),
+      [this](std::string&& key, std::string&& value) {
+        request_->request_args_[std::move(key)].push_back(std::move(value));
+      });
 }
 
 void HttpRequestConstructor::AddHeader() {
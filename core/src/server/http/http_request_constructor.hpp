@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include <http_parser.h>
@@ -34,6 +35,12 @@ class HttpRequestConstructor final : public request::RequestConstructor {
 
   using Config = server::request::HttpRequestConfig;
 
+  /// Unfilled part of a preallocated request body
+  struct BodyBuffer {
+    char* data{nullptr};
+    size_t size{0};
+  };
+
   HttpRequestConstructor(Config config,
                          const HandlerInfoIndex& handler_info_index,
                          request::ResponseDataAccounter& data_accounter);
@@ -44,6 +51,7 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void SetMethod(HttpMethod method);
   void SetHttpMajor(unsigned short http_major);
   void SetHttpMinor(unsigned short http_minor);
+  void SetHttp2StreamId(std::int32_t stream_id);
 
   void AppendUrl(const char* data, size_t size);
   void ParseUrl();
@@ -51,6 +59,12 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void AppendHeaderValue(const char* data, size_t size);
   void AppendBody(const char* data, size_t size);
 
+  /// Reserves the storage for a body of known size. Large bodies are
+  /// received in place in the windows of GetBodyBuffer(), the storage grows
+  /// as the body arrives.
+  void ReserveBody(size_t content_length);
+  BodyBuffer GetBodyBuffer();
+
   void SetIsFinal(bool is_final);
 
   std::shared_ptr<request::RequestBase> Finalize() override;
@@ -83,6 +97,9 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   size_t url_size_ = 0;
   size_t headers_size_ = 0;
   bool url_parsed_ = false;
+  bool is_body_in_place_ = false;
+  size_t body_size_ = 0;
+  size_t expected_body_size_ = 0;
   Status status_ = Status::kOk;
 
   std::shared_ptr<HttpRequestImpl> request_;
@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include <server/http/http_request_constructor.hpp>
+#include <server/http/http_request_parser.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,9 +17,65 @@ void http_request_constructor_url_decode(benchmark::State& state) {
   for (auto _ : state)
     benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
 }
+
+constexpr std::string_view kTypicalRequest =
+    "POST /v1/orders/search?order_id=0123456789abcdef&lang=en&limit=100 "
+    "HTTP/1.1\r\n"
+    "Host: orders.example.com\r\n"
+    "User-Agent: benchmark-client/1.0\r\n"
+    "Accept: application/json\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "Content-Type: application/x-www-form-urlencoded\r\n"
+    "X-Request-Id: 4f7a0a2c6f8e4c4e9b1d2f3a4b5c6d7e\r\n"
+    "X-YaSpanId: 0123456789abcdef\r\n"
+    "X-YaTraceId: 0123456789abcdef0123456789abcdef\r\n"
+    "X-YaRequestId: 0123456789abcdef0123456789abcdef\r\n"
+    "X-Forwarded-For: 192.0.2.1, 198.51.100.2\r\n"
+    "Cookie: session=0123456789abcdef; theme=dark; locale=en_US\r\n"
+    "Content-Length: 33\r\n"
+    "\r\n"
+    "page=1&sort=date&filter=completed";
+
+// Parses a typical request with headers, cookies and arguments into
+// HttpRequestImpl, the allocations of the parsing state are the main cost
+void http_request_parse_typical(benchmark::State& state) {
+  static const server::http::HandlerInfoIndex kHandlerInfoIndex;
+  static constexpr server::request::RequestConfig kRequestConfig(
+      server::request::HttpRequestConfig{
+          /*.max_url_size = */ 8192,
+          /*.max_request_size = */ 1024 * 1024,
+          /*.max_headers_size = */ 65536,
+          /*.parse_args_from_body = */ true,
+          /*.testing_mode = */ true,
+          /*.decompress_request = */ false,
+      });
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter accounter;
+
+  std::size_t parsed = 0;
+  server::http::HttpRequestParser parser(
+      kHandlerInfoIndex, kRequestConfig,
+      [&parsed](std::shared_ptr<server::request::RequestBase>&& request) {
+        benchmark::DoNotOptimize(request);
+        ++parsed;
+      },
+      stats, accounter);
+
+  for (auto _ : state) {
+    if (!parser.Parse(kTypicalRequest.data(), kTypicalRequest.size())) {
+      state.SkipWithError("Failed to parse the request");
+      break;
+    }
+  }
+  state.SetItemsProcessed(parsed);
+}
+
 }  // namespace
+
 BENCHMARK(http_request_constructor_url_decode)
     ->RangeMultiplier(2)
     ->Range(1, 1024);
+BENCHMARK(http_request_parse_typical);
 
 USERVER_NAMESPACE_END
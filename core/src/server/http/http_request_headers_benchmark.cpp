@@ -1,6 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <array>
+#include <cstddef>
+
 #include <server/http/http_request_constructor.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -29,6 +33,20 @@ void http_request_headers_insert(benchmark::State& state) {
   }
 }
 
+void http_request_headers_insert_arena(benchmark::State& state) {
+  alignas(std::max_align_t) std::array<char, 4 * 1024> buffer;
+
+  for (auto _ : state) {
+    utils::impl::MonotonicArena arena{buffer.data(), buffer.size()};
+    server::http::HttpRequest::HeadersMap map{
+        server::http::HttpRequest::HeadersMap::allocator_type{arena}};
+
+    for (int i = 0; i < state.range(0); i++) map[kHeadersArray[i]] = "1";
+
+    benchmark::DoNotOptimize(map);
+  }
+}
+
 void http_request_headers_get(benchmark::State& state) {
   server::http::HttpRequest::HeadersMap map;
   for (std::size_t i = 0; i < kHeadersCount; i++) map[kHeadersArray[i]] = "1";
@@ -45,6 +63,10 @@ BENCHMARK(http_request_headers_insert)
     ->RangeMultiplier(2)
     ->Range(1, kHeadersCount);
 
+BENCHMARK(http_request_headers_insert_arena)
+    ->RangeMultiplier(2)
+    ->Range(1, kHeadersCount);
+
 BENCHMARK(http_request_headers_get);
 
 USERVER_NAMESPACE_END
@@ -68,7 +68,15 @@ const std::vector<std::string> kEmptyVector{};
 namespace server::http {
 
 HttpRequestImpl::HttpRequestImpl(request::ResponseDataAccounter& data_accounter)
-    : response_(*this, data_accounter) {}
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+    : arena_(arena_buffer_.data(), arena_buffer_.size()),
+      request_args_(ArgsMap::allocator_type{arena_}),
+      form_data_args_(FormDataArgs::allocator_type{arena_}),
+      path_args_(decltype(path_args_)::allocator_type{arena_}),
+      path_args_by_name_index_(PathArgsIndex::allocator_type{arena_}),
+      headers_(HttpRequest::HeadersMap::allocator_type{arena_}),
+      cookies_(HttpRequest::CookiesMap::allocator_type{arena_}),
+      response_(*this, data_accounter) {}
 
 HttpRequestImpl::~HttpRequestImpl() = default;
 
@@ -208,7 +216,10 @@ void HttpRequestImpl::SetRequestBody(std::string body) {
 }
 
 void HttpRequestImpl::ParseArgsFromBody() {
-  USERVER_NAMESPACE::http::parser::ParseArgs(request_body_, request_args_);
+  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgs(
+      request_body_, [this](std::string&& key, std::string&& value) {
+        request_args_[std::move(key)].push_back(std::move(value));
+      });
 }
 
 bool HttpRequestImpl::IsBodyCompressed() const {
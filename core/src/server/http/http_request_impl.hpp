@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -12,6 +15,9 @@
 #include <userver/server/http/http_request.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_base.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
+
+#include "multipart_form_data_parser.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -34,6 +40,8 @@ class HttpRequestImpl final : public request::RequestBase {
   const std::string& GetOrigMethodStr() const { return ToString(orig_method_); }
   int GetHttpMajor() const { return http_major_; }
   int GetHttpMinor() const { return http_minor_; }
+  /// Identifier of the HTTP/2 stream of the request, 0 for HTTP/1.x
+  std::int32_t GetHttp2StreamId() const { return http2_stream_id_; }
   const std::string& GetUrl() const { return url_; }
   const std::string& GetRequestPath() const override { return request_path_; }
   const std::string& GetPathSuffix() const { return path_suffix_; }
@@ -115,19 +123,41 @@ class HttpRequestImpl final : public request::RequestBase {
   friend class HttpRequestConstructor;
 
  private:
+  template <typename T>
+  using ArenaAllocator = utils::impl::ArenaAllocator<T>;
+
+  using ArgsMap = std::unordered_map<
+      std::string, std::vector<std::string>, std::hash<std::string>,
+      std::equal_to<std::string>,
+      ArenaAllocator<std::pair<const std::string, std::vector<std::string>>>>;
+
+  using PathArgsIndex = std::unordered_map<
+      std::string, size_t, std::hash<std::string>, std::equal_to<std::string>,
+      ArenaAllocator<std::pair<const std::string, size_t>>>;
+
+  // Enough for the parsing state of a typical request
+  static constexpr size_t kArenaInitialBufferSize = 4 * 1024;
+
+  // Backs the containers of the parsing state, that are released all at once
+  // with the request. Must be declared before them.
+  alignas(std::max_align_t) std::array<char, kArenaInitialBufferSize>
+      arena_buffer_;
+  utils::impl::MonotonicArena arena_;
+
   // method_ = (orig_method_ == kHead ? kGet : orig_method_)
   HttpMethod method_{HttpMethod::kUnknown};
   HttpMethod orig_method_{HttpMethod::kUnknown};
   unsigned short http_major_{1};
   unsigned short http_minor_{1};
+  std::int32_t http2_stream_id_{0};
   std::string url_;
   std::string request_path_;
   std::string request_body_;
   std::string path_suffix_;
-  std::unordered_map<std::string, std::vector<std::string>> request_args_;
-  std::unordered_map<std::string, std::vector<FormDataArg>> form_data_args_;
-  std::vector<std::string> path_args_;
-  std::unordered_map<std::string, size_t> path_args_by_name_index_;
+  ArgsMap request_args_;
+  FormDataArgs form_data_args_;
+  std::vector<std::string, ArenaAllocator<std::string>> path_args_;
+  PathArgsIndex path_args_by_name_index_;
   HttpRequest::HeadersMap headers_;
   HttpRequest::CookiesMap cookies_;
   bool is_final_{false};
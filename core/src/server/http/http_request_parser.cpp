@@ -1,5 +1,7 @@
 #include "http_request_parser.hpp"
 
+#include <climits>
+
 #include <userver/logging/log.hpp>
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/request/request_base.hpp>
@@ -79,6 +81,11 @@ bool HttpRequestParser::Parse(const char* data, size_t size) {
   return true;
 }
 
+HttpRequestConstructor::BodyBuffer HttpRequestParser::GetBodyBuffer() {
+  if (!request_constructor_) return {};
+  return request_constructor_->GetBodyBuffer();
+}
+
 int HttpRequestParser::OnMessageBegin(http_parser* p) {
   auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
   UASSERT(http_request_parser != nullptr);
@@ -177,6 +184,10 @@ int HttpRequestParser::OnHeadersCompleteImpl(http_parser* p) {
   if (!CheckUrlComplete(p)) return -1;
   try {
     request_constructor_->AppendHeaderField("", 0);
+    // content_length is ULLONG_MAX for bodies of unknown size
+    if (p->content_length > 0 && p->content_length != ULLONG_MAX) {
+      request_constructor_->ReserveBody(p->content_length);
+    }
   } catch (const std::exception& ex) {
     LOG_WARNING() << "can't append header value: " << ex;
     return -1;
@@ -32,6 +32,13 @@ class HttpRequestParser final : public request::RequestParser {
 
   bool Parse(const char* data, size_t size) override;
 
+  /// @brief Returns the storage for the not yet received part of the body of
+  /// the request being parsed, empty if the body is not preallocated.
+  ///
+  /// Data received into the buffer must be passed to Parse() right away, it
+  /// is not copied once again then.
+  HttpRequestConstructor::BodyBuffer GetBodyBuffer();
+
  private:
   static int OnMessageBegin(http_parser* p);
   static int OnUrl(http_parser* p, const char* data, size_t size);
@@ -0,0 +1,137 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <server/http/http_request_impl.hpp>
+#include <server/http/http_request_parser.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string MakeBody(std::size_t size) {
+  std::string body(size, '\0');
+  for (std::size_t i = 0; i < size; ++i) body[i] = 'a' + i % 26;
+  return body;
+}
+
+}  // namespace
+
+TEST(HttpRequestParser, BodyReceivedInPlace) {
+  const auto body = MakeBody(100 * 1024);
+  std::string parsed_body;
+  auto parser = server::CreateTestParser(
+      [&](std::shared_ptr<server::request::RequestBase>&& request) {
+        auto& http_request =
+            dynamic_cast<server::http::HttpRequestImpl&>(*request);
+        parsed_body = http_request.RequestBody();
+      });
+
+  EXPECT_EQ(parser.GetBodyBuffer().size, std::size_t{0});
+
+  const auto headers = fmt::format(
+      "POST / HTTP/1.1\r\nContent-Length: {}\r\n\r\n", body.size());
+  const auto head = headers + body.substr(0, 1000);
+  ASSERT_TRUE(parser.Parse(head.data(), head.size()));
+
+  std::size_t offset = 1000;
+  while (offset < body.size()) {
+    const auto buffer = parser.GetBodyBuffer();
+    ASSERT_GT(buffer.size, std::size_t{0});
+    ASSERT_LE(buffer.size, body.size() - offset);
+
+    const auto chunk_size = std::min<std::size_t>(buffer.size, 30000);
+    std::memcpy(buffer.data, body.data() + offset, chunk_size);
+    ASSERT_TRUE(parser.Parse(buffer.data, chunk_size));
+    offset += chunk_size;
+  }
+
+  EXPECT_EQ(parser.GetBodyBuffer().size, std::size_t{0});
+  EXPECT_EQ(parsed_body, body);
+}
+
+TEST(HttpRequestParser, SmallBodyIsNotPreallocated) {
+  const auto body = MakeBody(100);
+  std::string parsed_body;
+  auto parser = server::CreateTestParser(
+      [&](std::shared_ptr<server::request::RequestBase>&& request) {
+        auto& http_request =
+            dynamic_cast<server::http::HttpRequestImpl&>(*request);
+        parsed_body = http_request.RequestBody();
+      });
+
+  const auto headers = fmt::format(
+      "POST / HTTP/1.1\r\nContent-Length: {}\r\n\r\n", body.size());
+  ASSERT_TRUE(parser.Parse(headers.data(), headers.size()));
+  EXPECT_EQ(parser.GetBodyBuffer().size, std::size_t{0});
+
+  ASSERT_TRUE(parser.Parse(body.data(), body.size()));
+  EXPECT_EQ(parsed_body, body);
+}
+
+TEST(HttpRequestParser, ChunkedBodyIsNotPreallocated) {
+  std::string parsed_body;
+  auto parser = server::CreateTestParser(
+      [&](std::shared_ptr<server::request::RequestBase>&& request) {
+        auto& http_request =
+            dynamic_cast<server::http::HttpRequestImpl&>(*request);
+        parsed_body = http_request.RequestBody();
+      });
+
+  const std::string headers =
+      "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n";
+  ASSERT_TRUE(parser.Parse(headers.data(), headers.size()));
+  EXPECT_EQ(parser.GetBodyBuffer().size, std::size_t{0});
+
+  const std::string chunks = "5\r\nhello\r\n0\r\n\r\n";
+  ASSERT_TRUE(parser.Parse(chunks.data(), chunks.size()));
+  EXPECT_EQ(parsed_body, "hello");
+}
+
+TEST(HttpRequestParser, BodyIsNotPreallocatedBeforeArrival) {
+  const auto body = MakeBody(1000 * 1000);
+  std::string parsed_body;
+  auto parser = server::CreateTestParser(
+      [&](std::shared_ptr<server::request::RequestBase>&& request) {
+        auto& http_request =
+            dynamic_cast<server::http::HttpRequestImpl&>(*request);
+        parsed_body = http_request.RequestBody();
+      });
+
+  const auto headers = fmt::format(
+      "POST / HTTP/1.1\r\nContent-Length: {}\r\n\r\n", body.size());
+  ASSERT_TRUE(parser.Parse(headers.data(), headers.size()));
+  // only a small window is allocated until the body arrives
+  EXPECT_LE(parser.GetBodyBuffer().size, std::size_t{16 * 1024});
+
+  // the data that does not come through the window is appended as well
+  ASSERT_TRUE(parser.Parse(body.data(), body.size() / 2));
+  std::size_t offset = body.size() / 2;
+  while (offset < body.size()) {
+    const auto buffer = parser.GetBodyBuffer();
+    ASSERT_GT(buffer.size, std::size_t{0});
+    std::memcpy(buffer.data, body.data() + offset, buffer.size);
+    ASSERT_TRUE(parser.Parse(buffer.data, buffer.size));
+    offset += buffer.size;
+  }
+  EXPECT_EQ(parsed_body, body);
+}
+
+TEST(HttpRequestParser, TooLargeBodyIsNotPreallocated) {
+  auto parser = server::CreateTestParser(
+      [](std::shared_ptr<server::request::RequestBase>&&) {});
+
+  // max_request_size of the test parser is 1MB
+  const std::string headers =
+      "POST / HTTP/1.1\r\nContent-Length: 100000000\r\n\r\n";
+  ASSERT_TRUE(parser.Parse(headers.data(), headers.size()));
+  EXPECT_EQ(parser.GetBodyBuffer().size, std::size_t{0});
+}
+
+USERVER_NAMESPACE_END
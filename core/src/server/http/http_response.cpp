@@ -16,6 +16,7 @@
 #include <userver/utils/assert.hpp>
 #include <userver/utils/userver_info.hpp>
 
+#include "http2_session.hpp"
 #include "http_request_impl.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -64,6 +65,27 @@ void CheckHeaderValue(std::string_view value) {
   }
 }
 
+// Connection-specific headers are forbidden in HTTP/2
+bool IsHttp2ForbiddenHeader(std::string_view lowercase_name) {
+  return lowercase_name == "connection" || lowercase_name == "keep-alive" ||
+         lowercase_name == "proxy-connection" ||
+         lowercase_name == "transfer-encoding" || lowercase_name == "upgrade";
+}
+
+std::string ToLowerAscii(std::string_view str) {
+  std::string result{str};
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+  }
+  return result;
+}
+
+std::string FormatDate() {
+  static const std::string kFormatString = "%a, %d %b %Y %H:%M:%S %Z";
+  static const auto tz = cctz::utc_time_zone();
+  return cctz::format(kFormatString, std::chrono::system_clock::now(), tz);
+}
+
 bool IsBodyForbiddenForStatus(server::http::HttpStatus status) {
   return status == server::http::HttpStatus::kNoContent ||
          status == server::http::HttpStatus::kNotModified ||
@@ -165,24 +187,13 @@ void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
 void HttpResponse::SendResponse(engine::io::Socket& socket) {
-  const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
-  const auto& data = GetData();
-  const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
-
-  static constexpr auto kMinSeparateDataSize = 50000;  //  50KB
-  bool separate_data_send = data.size() > kMinSeparateDataSize;
-
   // According to https://www.chromium.org/spdy/spdy-whitepaper/
   // "typical header sizes of 700-800 bytes is common"
   // Adjusting it to 1KiB to fit jemalloc size class
   static constexpr auto kTypicalHeadersSize = 1024;
 
   std::string os;
-  if (!is_body_forbidden && !separate_data_send && !is_head_request) {
-    os.reserve(kTypicalHeadersSize + data.size());
-  } else {
-    os.reserve(kTypicalHeadersSize);
-  }
+  os.reserve(kTypicalHeadersSize);
 
   os.append("HTTP/");
   fmt::format_to(std::back_inserter(os), FMT_COMPILE("{}.{} {} "),
@@ -194,12 +205,8 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
   headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
   const auto end = headers_.cend();
   if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
-    static const std::string kFormatString = "%a, %d %b %Y %H:%M:%S %Z";
-    static const auto tz = cctz::utc_time_zone();
-    const auto& time_str =
-        cctz::format(kFormatString, std::chrono::system_clock::now(), tz);
-
-    impl::OutputHeader(os, USERVER_NAMESPACE::http::headers::kDate, time_str);
+    impl::OutputHeader(os, USERVER_NAMESPACE::http::headers::kDate,
+                       FormatDate());
   }
   if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
     impl::OutputHeader(os, USERVER_NAMESPACE::http::headers::kContentType,
@@ -225,44 +232,104 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
     SetBodyNotstreamed(socket, os);
 }
 
-void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
-                                      std::string& os) {
+bool HttpResponse::IsBodyForbidden() const {
+  return IsBodyForbiddenForStatus(status_) ||
+         request_.GetOrigMethod() == HttpMethod::kHead;
+}
+
+void HttpResponse::SendResponse(impl::Http2StreamWriter& writer) {
   const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
   const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
+  const bool is_streamed = IsBodyStreamed();
   const auto& data = GetData();
 
-  static constexpr auto kMinSeparateDataSize = 50000;  //  50KB
-  bool separate_data_send = data.size() > kMinSeparateDataSize;
+  impl::Http2StreamWriter::Headers headers;
+  headers.reserve(headers_.size() + cookies_.size() + 3);
 
-  if (!is_body_forbidden) {
-    impl::OutputHeader(os, USERVER_NAMESPACE::http::headers::kContentLength,
-                       fmt::format(FMT_COMPILE("{}"), data.size()));
+  headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
+  const auto end = headers_.cend();
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
+    headers.emplace_back("date", FormatDate());
+  }
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
+    headers.emplace_back("content-type", kDefaultContentTypeString);
+  }
+  for (const auto& [name, value] : headers_) {
+    auto lowercase_name = ToLowerAscii(name);
+    if (IsHttp2ForbiddenHeader(lowercase_name)) continue;
+    headers.emplace_back(std::move(lowercase_name), value);
+  }
+  for (const auto& cookie : cookies_) {
+    std::string value;
+    cookie.second.AppendToString(value);
+    headers.emplace_back("set-cookie", std::move(value));
+  }
+  if (!is_streamed && !is_body_forbidden) {
+    headers.emplace_back("content-length",
+                         fmt::format(FMT_COMPILE("{}"), data.size()));
   }
-  os.append(kCrlf);
 
-  // Transmit HTTP response body
-  if (!is_body_forbidden) {
-    if (!separate_data_send && !is_head_request) {
-      os.append(data);
+  if (is_streamed) {
+    writer.WriteHeaders(status_, headers, false);
+    impl::Http2StreamWriter::Headers().swap(headers);
+
+    // Every chunk of the body is sent as one or more DATA frames
+    std::unique_ptr<std::string> body_part;
+    while (body_stream_->Pop(body_part)) {
+      if (body_part->empty()) continue;
+      writer.WriteData(*body_part, false);
     }
+    writer.WriteData({}, true);
+
+    body_stream_producer_.reset();
+    body_stream_.reset();
+    body_queue_.reset();
   } else {
-    separate_data_send = false;
-    if (!data.empty()) {
+    const bool send_body = !is_body_forbidden && !is_head_request;
+    if (is_body_forbidden && !data.empty()) {
       LOG_LIMITED_WARNING()
           << "Non-empty body provided for response with HTTP code "
           << static_cast<int>(status_)
           << " which does not allow one, it will be dropped";
     }
+
+    const bool has_data = send_body && !data.empty();
+    writer.WriteHeaders(status_, headers, !has_data);
+    if (has_data) writer.WriteData(data, true);
   }
 
-  // send HTTP headers + (maybe) HTTP body
-  size_t sent_bytes = socket.SendAll(os.data(), os.size(), {});
+  SetSentTime(std::chrono::steady_clock::now());
+  SetSent(writer.GetBytesWritten());
+}
+
+void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
+                                      std::string& os) {
+  const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
+  const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
+  const auto& data = GetData();
+
+  if (!is_body_forbidden) {
+    impl::OutputHeader(os, USERVER_NAMESPACE::http::headers::kContentLength,
+                       fmt::format(FMT_COMPILE("{}"), data.size()));
+  }
+  os.append(kCrlf);
 
-  if (separate_data_send && sent_bytes == os.size() && !is_head_request) {
-    std::string().swap(os);  // free memory before time consuming operation
+  const bool send_body = !is_body_forbidden && !is_head_request;
+  if (is_body_forbidden && !data.empty()) {
+    LOG_LIMITED_WARNING()
+        << "Non-empty body provided for response with HTTP code "
+        << static_cast<int>(status_)
+        << " which does not allow one, it will be dropped";
+  }
 
-    // If response is too big, copying is more expensive than +1 syscall
-    sent_bytes += socket.SendAll(data.data(), data.size(), {});
+  // send HTTP headers + (maybe) HTTP body in a single system call without
+  // copying the body
+  size_t sent_bytes = 0;
+  if (send_body && !data.empty()) {
+    sent_bytes = socket.SendAll(
+        {{os.data(), os.size()}, {data.data(), data.size()}}, {});
+  } else {
+    sent_bytes = socket.SendAll(os.data(), os.size(), {});
   }
 
   SetSentTime(std::chrono::steady_clock::now());
@@ -279,18 +346,40 @@ void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
 
   std::string().swap(os);  // free memory before time consuming operation
 
-  // Transmit HTTP response body
+  // Transmit HTTP response body. Chunks that are already in the queue are sent
+  // together with a single system call.
+  static constexpr std::size_t kMaxChunksPerSend = 16;
+  // "\r\n" + 16 hex digits + "\r\n"
+  static constexpr std::size_t kMaxChunkHeaderSize = 20;
+
+  std::array<std::unique_ptr<std::string>, kMaxChunksPerSend> body_parts;
+  std::array<std::array<char, kMaxChunkHeaderSize>, kMaxChunksPerSend>
+      chunk_headers{};
+  std::array<engine::io::IoData, kMaxChunksPerSend * 2> io_data{};
   std::unique_ptr<std::string> body_part;
 
   while (body_stream_->Pop(body_part)) {
-    if (body_part->empty()) {
-      LOG_DEBUG() << "Zero size body_part in http_response.cpp";
-      continue;
-    }
-
-    auto size = fmt::format("\r\n{:x}\r\n", body_part->size());
-    sent_bytes += socket.SendAll(size.data(), size.size(), {});
-    sent_bytes += socket.SendAll(body_part->data(), body_part->size(), {});
+    std::size_t chunks_count = 0;
+    do {
+      if (body_part->empty()) {
+        LOG_DEBUG() << "Zero size body_part in http_response.cpp";
+        continue;
+      }
+
+      auto& chunk_header = chunk_headers[chunks_count];
+      const auto chunk_header_size =
+          fmt::format_to_n(chunk_header.data(), chunk_header.size(),
+                           FMT_COMPILE("\r\n{:x}\r\n"), body_part->size())
+              .size;
+      io_data[chunks_count * 2] = {chunk_header.data(), chunk_header_size};
+      io_data[chunks_count * 2 + 1] = {body_part->data(), body_part->size()};
+      body_parts[chunks_count++] = std::move(body_part);
+    } while (chunks_count < kMaxChunksPerSend &&
+             body_stream_->PopNoblock(body_part));
+
+    if (chunks_count == 0) continue;
+    sent_bytes += socket.SendAll(io_data.data(), chunks_count * 2, {});
+    for (std::size_t i = 0; i < chunks_count; ++i) body_parts[i].reset();
   }
 
   const constexpr std::string_view terminating_chunk{"\r\n0\r\n\r\n"};
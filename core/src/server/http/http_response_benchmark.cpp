@@ -1,12 +1,61 @@
 #include <benchmark/benchmark.h>
 
+#include <dlfcn.h>
+#include <sys/socket.h>
+
 #include <fmt/compile.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <sstream>
-
+#include <string>
+
+#include <server/http/http_request_impl.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/http/http_status.hpp>
 
+#include <utils/check_syscall.hpp>
+
+namespace {
+
+// The send calls to this fd are counted by the wrappers below
+std::atomic<int> counted_send_fd{-1};
+std::atomic<std::uint64_t> counted_send_calls{0};
+
+template <typename Func>
+Func* FindNextSymbol(const char* name) {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return reinterpret_cast<Func*>(::dlsym(RTLD_NEXT, name));
+}
+
+void CountSendCall(int fd) noexcept {
+  if (fd == counted_send_fd.load(std::memory_order_relaxed)) {
+    counted_send_calls.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+// The libc functions are wrapped to count the syscalls that engine::io::Socket
+// makes, the calls are forwarded to libc as is
+extern "C" ssize_t send(int fd, const void* buf, size_t len, int flags) {
+  static auto* const next = FindNextSymbol<decltype(send)>("send");
+  CountSendCall(fd);
+  return next(fd, buf, len, flags);
+}
+
+extern "C" ssize_t sendmsg(int fd, const struct msghdr* msg, int flags) {
+  static auto* const next = FindNextSymbol<decltype(sendmsg)>("sendmsg");
+  CountSendCall(fd);
+  return next(fd, msg, flags);
+}
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -65,9 +114,111 @@ void http_headers_serialization_ostreams(benchmark::State& state) {
   }
 }
 
+std::pair<engine::io::Socket, engine::io::Socket> MakeUnixSocketPair() {
+  std::array<int, 2> fds{};
+  utils::CheckSyscall(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()),
+                      "creating socket pair");
+  return {engine::io::Socket{fds[0]}, engine::io::Socket{fds[1]}};
+}
+
+// Counts the send syscalls of the socket while alive
+class SendCallsCounter final {
+ public:
+  explicit SendCallsCounter(const engine::io::Socket& socket) {
+    counted_send_calls = 0;
+    counted_send_fd = socket.Fd();
+  }
+
+  ~SendCallsCounter() { counted_send_fd = -1; }
+
+  std::uint64_t GetCalls() const { return counted_send_calls.load(); }
+};
+
+// Drains the socket until cancelled, so that the writer never blocks for long
+engine::TaskWithResult<void> StartReader(engine::io::Socket& socket) {
+  return engine::AsyncNoSpan([&socket] {
+    std::array<char, 64 * 1024> buffer{};
+    while (!engine::current_task::ShouldCancel()) {
+      try {
+        if (!socket.RecvSome(buffer.data(), buffer.size(), {})) break;
+      } catch (const engine::io::IoException&) {
+        break;
+      }
+    }
+  });
+}
+
+// range(0) - body size, range(1) - 1 to send headers and body with a single
+// vectored write, 0 to send them with two separate writes
+void http_response_send_syscalls(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    auto [server, client] = MakeUnixSocketPair();
+    auto reader = StartReader(client);
+
+    const std::string headers(256, 'h');
+    const std::string body(state.range(0), 'b');
+    const bool vectored = state.range(1);
+
+    const SendCallsCounter counter{server};
+    for (auto _ : state) {
+      if (vectored) {
+        [[maybe_unused]] const auto sent = server.SendAll(
+            {{headers.data(), headers.size()}, {body.data(), body.size()}},
+            {});
+      } else {
+        [[maybe_unused]] auto sent =
+            server.SendAll(headers.data(), headers.size(), {});
+        sent = server.SendAll(body.data(), body.size(), {});
+      }
+    }
+
+    state.counters["syscalls_per_response"] = benchmark::Counter(
+        counter.GetCalls(), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() *
+                            (headers.size() + body.size()));
+
+    reader.RequestCancel();
+    server.Close();
+  });
+}
+
+// range(0) - body size
+void http_response_send_response(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    auto [server, client] = MakeUnixSocketPair();
+    auto reader = StartReader(client);
+
+    server::request::ResponseDataAccounter accounter;
+    server::http::HttpRequestImpl request{accounter};
+    const std::string body(state.range(0), 'b');
+
+    const SendCallsCounter counter{server};
+    for (auto _ : state) {
+      server::http::HttpResponse response{request, accounter};
+      for (const auto& [name, value] : kHeaders) {
+        response.SetHeader(name, value);
+      }
+      response.SetData(body);
+      response.SendResponse(server);
+    }
+
+    state.counters["syscalls_per_response"] = benchmark::Counter(
+        counter.GetCalls(), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * body.size());
+
+    reader.RequestCancel();
+    server.Close();
+  });
+}
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
+BENCHMARK(http_response_send_syscalls)
+    ->ArgsProduct({{0, 128, 4 * 1024, 64 * 1024, 1024 * 1024}, {0, 1}});
+BENCHMARK(http_response_send_response)
+    ->RangeMultiplier(8)
+    ->Range(128, 1024 * 1024);
 
 USERVER_NAMESPACE_END
@@ -1,18 +1,46 @@
 #include <userver/server/http/http_response_body_stream.hpp>
 
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+
+#include <server/http/response_compressor.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
 ResponseBodyStream::ResponseBodyStream(
     server::http::HttpResponse::Queue::Producer&& queue_producer,
-    server::http::HttpResponse& http_response)
+    server::http::HttpResponse& http_response,
+    std::unique_ptr<impl::ResponseCompressor> compressor)
     : queue_producer_(std::move(queue_producer)),
-      http_response_(http_response) {}
+      http_response_(http_response),
+      compressor_(std::move(compressor)) {}
+
+ResponseBodyStream::ResponseBodyStream(ResponseBodyStream&&) noexcept =
+    default;
+
+ResponseBodyStream::~ResponseBodyStream() {
+  if (!compressor_ || !headers_ended_) return;
+
+  // The compressed stream must be finished before the body ends
+  try {
+    auto tail = compressor_->Finish();
+    if (!tail.empty()) {
+      queue_producer_.Push(std::make_unique<std::string>(std::move(tail)));
+    }
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to finish the compressed response body: " << ex;
+  }
+}
 
 void ResponseBodyStream::PushBodyChunk(std::string&& chunk) {
   UASSERT_MSG(headers_ended_,
               "SetEndOfHeaders() was not called before PushBodyChunk()");
+  if (compressor_) {
+    if (chunk.empty()) return;
+    chunk = compressor_->CompressChunk(chunk);
+  }
   // TODO: -1 level of indirection
   queue_producer_.Push(std::make_unique<std::string>(std::move(chunk)));
 }
@@ -23,7 +51,22 @@ void ResponseBodyStream::SetHeader(const std::string& name,
   http_response_.SetHeader(name, value);
 }
 
-void ResponseBodyStream::SetEndOfHeaders() { headers_ended_ = true; }
+void ResponseBodyStream::SetEndOfHeaders() {
+  if (compressor_ && !headers_ended_) {
+    if (http_response_.IsBodyForbidden()) {
+      // no body means no compressed stream and no trailer to finish it
+      compressor_.reset();
+    } else if (http_response_.HasHeader(
+                   USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+      // the handler produces an already encoded body
+      compressor_.reset();
+    } else {
+      http_response_.SetContentEncoding(
+          std::string{compression::ToString(compressor_->GetEncoding())});
+    }
+  }
+  headers_ended_ = true;
+}
 
 void ResponseBodyStream::SetStatusCode(int status_code) {
   UINVARIANT(
@@ -6,12 +6,17 @@
 #include <vector>
 
 #include <userver/server/http/form_data_arg.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
-using FormDataArgs = std::unordered_map<std::string, std::vector<FormDataArg>>;
+using FormDataArgs = std::unordered_map<
+    std::string, std::vector<FormDataArg>, std::hash<std::string>,
+    std::equal_to<std::string>,
+    utils::impl::ArenaAllocator<
+        std::pair<const std::string, std::vector<FormDataArg>>>>;
 
 bool IsMultipartFormDataContentType(std::string_view content_type);
 bool ParseMultipartFormData(const std::string& content_type,
@@ -0,0 +1,167 @@
+#include <server/http/path_trie.hpp>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+namespace {
+
+constexpr std::string_view kAnySuffixMark{"*"};
+
+constexpr char kWildcardStart = '{';
+constexpr char kWildcardFinish = '}';
+
+bool IsWildcard(std::string_view segment) {
+  if (segment.find(kWildcardStart) == std::string_view::npos &&
+      segment.find(kWildcardFinish) == std::string_view::npos) {
+    return false;
+  }
+  if (segment.size() < 2 || segment.front() != kWildcardStart ||
+      segment.back() != kWildcardFinish) {
+    throw std::runtime_error(fmt::format("Incorrect wildcard '{}'", segment));
+  }
+  return true;
+}
+
+}  // namespace
+
+struct PathTrie::BuilderNode {
+  std::map<std::string, BuilderNode, std::less<>> fixed;
+  std::unique_ptr<BuilderNode> wildcard;
+  std::size_t route_id{kNone};
+  std::size_t any_suffix_route_id{kNone};
+
+  bool IsPassThrough() const {
+    return fixed.size() == 1 && !wildcard && route_id == kNone &&
+           any_suffix_route_id == kNone;
+  }
+};
+
+PathTrie::PathTrie() : root_builder_(std::make_unique<BuilderNode>()) {
+  Compile();
+}
+
+PathTrie::~PathTrie() = default;
+
+PathTrie::PathTrie(PathTrie&&) noexcept = default;
+
+PathTrie& PathTrie::operator=(PathTrie&&) noexcept = default;
+
+PathTrie::RouteId PathTrie::AddRoute(std::string_view path) {
+  UASSERT(root_builder_);
+  auto* node = root_builder_.get();
+  auto* route_id = &node->route_id;
+
+  std::size_t pos = 0;
+  while (true) {
+    auto segment_end = path.find('/', pos);
+    const bool is_last = segment_end == std::string_view::npos;
+    if (is_last) segment_end = path.size();
+    const auto segment = path.substr(pos, segment_end - pos);
+
+    if (is_last && segment == kAnySuffixMark) {
+      route_id = &node->any_suffix_route_id;
+      break;
+    }
+
+    if (IsWildcard(segment)) {
+      if (!node->wildcard) node->wildcard = std::make_unique<BuilderNode>();
+      node = node->wildcard.get();
+    } else {
+      auto it = node->fixed.find(segment);
+      if (it == node->fixed.end()) {
+        it = node->fixed.emplace(std::string{segment}, BuilderNode{}).first;
+      }
+      node = &it->second;
+    }
+
+    if (is_last) {
+      route_id = &node->route_id;
+      break;
+    }
+    pos = segment_end + 1;
+  }
+
+  if (*route_id == kNone) {
+    *route_id = routes_count_++;
+    Compile();
+  }
+  return *route_id;
+}
+
+const PathTrie::Edge* PathTrie::FindEdge(const Node& node,
+                                         std::string_view segment) const {
+  const auto* begin = edges_.data() + node.edges_begin;
+  const auto* end = edges_.data() + node.edges_end;
+  const auto* it = std::lower_bound(
+      begin, end, segment, [this](const Edge& edge, std::string_view value) {
+        return GetFirstSegment(edge) < value;
+      });
+  if (it == end || GetFirstSegment(*it) != segment) return nullptr;
+  return it;
+}
+
+void PathTrie::Compile() {
+  nodes_.clear();
+  edges_.clear();
+  labels_.clear();
+  CompileNode(*root_builder_);
+}
+
+std::size_t PathTrie::CompileNode(const BuilderNode& builder_node) {
+  const auto node_index = nodes_.size();
+  nodes_.emplace_back();
+  nodes_[node_index].route_id = builder_node.route_id;
+  nodes_[node_index].any_suffix_route_id = builder_node.any_suffix_route_id;
+
+  // edges of a node are stored contiguously, so they are collected before
+  // compiling the child nodes
+  std::vector<Edge> edges;
+  edges.reserve(builder_node.fixed.size());
+  std::vector<const BuilderNode*> targets;
+  targets.reserve(builder_node.fixed.size());
+
+  for (const auto& [segment, child] : builder_node.fixed) {
+    Edge edge;
+    edge.label_offset = labels_.size();
+    edge.first_segment_size = segment.size();
+    labels_ += segment;
+
+    const auto* target = &child;
+    while (target->IsPassThrough()) {
+      const auto& [next_segment, next_child] = *target->fixed.begin();
+      labels_ += '/';
+      labels_ += next_segment;
+      target = &next_child;
+    }
+    edge.label_size = labels_.size() - edge.label_offset;
+
+    edges.push_back(edge);
+    targets.push_back(target);
+  }
+
+  for (std::size_t i = 0; i < edges.size(); ++i) {
+    edges[i].target = CompileNode(*targets[i]);
+  }
+  if (builder_node.wildcard) {
+    const auto wildcard_target = CompileNode(*builder_node.wildcard);
+    nodes_[node_index].wildcard_target = wildcard_target;
+  }
+
+  nodes_[node_index].edges_begin = edges_.size();
+  edges_.insert(edges_.end(), edges.begin(), edges.end());
+  nodes_[node_index].edges_end = edges_.size();
+
+  return node_index;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
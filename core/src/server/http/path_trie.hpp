@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// @brief Radix trie of URL paths split by '/' into segments.
+///
+/// Route segments are either fixed strings, wildcards ("{name}" or "{}") that
+/// match any single segment, or a trailing '*' that matches any non-empty
+/// sequence of segments. Routes are added one by one, after each addition the
+/// trie is compiled into flat arrays with chains of fixed segments collapsed
+/// into single edges, so that matching walks the path by std::string_view
+/// segments and does not allocate.
+///
+/// At every segment fixed edges take priority over the wildcard edge, then
+/// the route ending at the path end, then the trailing '*' of the current
+/// node. The first matching route accepted by the caller wins; a rejected
+/// route makes the matching backtrack.
+class PathTrie final {
+ public:
+  using RouteId = std::size_t;
+
+  /// Path segments matched by wildcards, in path order
+  using Captures = boost::container::small_vector<std::string_view, 8>;
+
+  struct Match {
+    RouteId route_id{0};
+    /// Length of the path prefix before the segments matched by '*', or the
+    /// whole path length for routes without '*'
+    std::size_t matched_path_length{0};
+    /// Non-empty for routes ending with '*'
+    std::string_view any_suffix;
+  };
+
+  PathTrie();
+  ~PathTrie();
+
+  PathTrie(PathTrie&&) noexcept;
+  PathTrie& operator=(PathTrie&&) noexcept;
+
+  /// @brief Adds a route and returns its id. Routes that differ in wildcard
+  /// names only share the same id.
+  /// @throws std::runtime_error on malformed wildcards
+  RouteId AddRoute(std::string_view path);
+
+  std::size_t GetRoutesCount() const noexcept { return routes_count_; }
+
+  /// @brief Finds the first route that matches the path and is accepted by
+  /// `accept(route_id)`.
+  /// @returns false if there is no such route
+  template <typename Accept>
+  bool MatchPath(std::string_view path, Accept&& accept, Match& match,
+                 Captures& captures) const;
+
+ private:
+  static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+  struct BuilderNode;
+
+  struct Edge {
+    // offset and sizes of the label in labels_, the label is one or more
+    // segments joined with '/'
+    std::size_t label_offset{0};
+    std::size_t label_size{0};
+    std::size_t first_segment_size{0};
+    std::size_t target{kNone};
+  };
+
+  struct Node {
+    // fixed edges sorted by their first segments
+    std::size_t edges_begin{0};
+    std::size_t edges_end{0};
+    std::size_t wildcard_target{kNone};
+    std::size_t route_id{kNone};
+    std::size_t any_suffix_route_id{kNone};
+  };
+
+  void Compile();
+  std::size_t CompileNode(const BuilderNode& builder_node);
+
+  std::string_view GetLabel(const Edge& edge) const noexcept {
+    return std::string_view{labels_}.substr(edge.label_offset, edge.label_size);
+  }
+
+  std::string_view GetFirstSegment(const Edge& edge) const noexcept {
+    return std::string_view{labels_}.substr(edge.label_offset,
+                                            edge.first_segment_size);
+  }
+
+  const Edge* FindEdge(const Node& node, std::string_view segment) const;
+
+  template <typename Accept>
+  bool MatchNode(std::size_t node_index, std::string_view path,
+                 std::size_t pos, Accept& accept, Match& match,
+                 Captures& captures) const;
+
+  std::unique_ptr<BuilderNode> root_builder_;
+  std::size_t routes_count_{0};
+
+  std::vector<Node> nodes_;
+  std::vector<Edge> edges_;
+  std::string labels_;
+};
+
+template <typename Accept>
+bool PathTrie::MatchPath(std::string_view path, Accept&& accept, Match& match,
+                         Captures& captures) const {
+  captures.clear();
+  return MatchNode(0, path, 0, accept, match, captures);
+}
+
+// `pos` is the start of the current segment, kNone if there are no segments
+// left
+template <typename Accept>
+bool PathTrie::MatchNode(std::size_t node_index, std::string_view path,
+                         std::size_t pos, Accept& accept, Match& match,
+                         Captures& captures) const {
+  const auto& node = nodes_[node_index];
+
+  if (pos == kNone) {
+    if (node.route_id != kNone && accept(node.route_id)) {
+      match.route_id = node.route_id;
+      match.matched_path_length = path.size();
+      match.any_suffix = {};
+      return true;
+    }
+    return false;
+  }
+
+  auto segment_end = path.find('/', pos);
+  if (segment_end == std::string_view::npos) segment_end = path.size();
+  const auto segment = path.substr(pos, segment_end - pos);
+
+  if (const auto* edge = FindEdge(node, segment)) {
+    const auto label = GetLabel(*edge);
+    const auto label_end = pos + label.size();
+    if (path.substr(pos, label.size()) == label &&
+        (label_end == path.size() || path[label_end] == '/')) {
+      const auto next_pos = label_end == path.size() ? kNone : label_end + 1;
+      if (MatchNode(edge->target, path, next_pos, accept, match, captures)) {
+        return true;
+      }
+    }
+  }
+
+  if (node.wildcard_target != kNone) {
+    const auto next_pos =
+        segment_end == path.size() ? kNone : segment_end + 1;
+    captures.push_back(segment);
+    if (MatchNode(node.wildcard_target, path, next_pos, accept, match,
+                  captures)) {
+      return true;
+    }
+    captures.pop_back();
+  }
+
+  if (node.any_suffix_route_id != kNone && accept(node.any_suffix_route_id)) {
+    match.route_id = node.any_suffix_route_id;
+    match.matched_path_length = pos;
+    match.any_suffix = path.substr(pos);
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <server/http/path_trie.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kServicesCount = 10;
+constexpr std::size_t kResourcesCount = 25;
+
+// 1000 routes of a typical API: fixed paths, paths with wildcards and
+// trailing '*'
+server::http::impl::PathTrie MakeRoutes() {
+  server::http::impl::PathTrie trie;
+  for (std::size_t service = 0; service < kServicesCount; ++service) {
+    for (std::size_t resource = 0; resource < kResourcesCount; ++resource) {
+      const auto prefix =
+          fmt::format("/service{}/v1/resource{}", service, resource);
+      trie.AddRoute(prefix + "/list");
+      trie.AddRoute(prefix + "/{id}");
+      trie.AddRoute(prefix + "/{id}/items/{item_id}");
+      trie.AddRoute(fmt::format("/static/service{}/resource{}/*", service,
+                                resource));
+    }
+  }
+  return trie;
+}
+
+std::vector<std::string> MakeRequests() {
+  std::vector<std::string> requests;
+  for (std::size_t service = 0; service < kServicesCount; ++service) {
+    for (std::size_t resource = 0; resource < kResourcesCount; ++resource) {
+      const auto prefix =
+          fmt::format("/service{}/v1/resource{}", service, resource);
+      requests.push_back(prefix + "/list");
+      requests.push_back(prefix + "/0123456789abcdef");
+      requests.push_back(prefix + "/0123456789abcdef/items/42");
+      requests.push_back(fmt::format(
+          "/static/service{}/resource{}/js/app.js", service, resource));
+      requests.push_back(prefix + "/0123456789abcdef/unknown");
+    }
+  }
+  return requests;
+}
+
+void path_trie_match_1k_routes(benchmark::State& state) {
+  const auto trie = MakeRoutes();
+  const auto requests = MakeRequests();
+
+  server::http::impl::PathTrie::Match match;
+  server::http::impl::PathTrie::Captures captures;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const auto& path = requests[i++ % requests.size()];
+    benchmark::DoNotOptimize(trie.MatchPath(
+        path, [](auto) { return true; }, match, captures));
+  }
+}
+BENCHMARK(path_trie_match_1k_routes);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
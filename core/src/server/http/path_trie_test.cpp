@@ -0,0 +1,143 @@
+#include <server/http/path_trie.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::PathTrie;
+
+struct MatchResult {
+  PathTrie::RouteId route_id;
+  std::size_t matched_path_length;
+  std::string any_suffix;
+  std::vector<std::string> captures;
+};
+
+std::optional<MatchResult> Match(const PathTrie& trie, std::string_view path,
+                                 std::optional<PathTrie::RouteId> rejected =
+                                     std::nullopt) {
+  PathTrie::Match match;
+  PathTrie::Captures captures;
+  const auto accept = [rejected](PathTrie::RouteId route_id) {
+    return route_id != rejected;
+  };
+  if (!trie.MatchPath(path, accept, match, captures)) return std::nullopt;
+  return MatchResult{match.route_id, match.matched_path_length,
+                     std::string{match.any_suffix},
+                     std::vector<std::string>(captures.begin(),
+                                              captures.end())};
+}
+
+}  // namespace
+
+TEST(PathTrie, Fixed) {
+  PathTrie trie;
+  const auto a = trie.AddRoute("/a/b/c");
+  const auto b = trie.AddRoute("/a/b/d");
+  const auto c = trie.AddRoute("/a");
+  EXPECT_EQ(trie.GetRoutesCount(), std::size_t{3});
+  EXPECT_EQ(trie.AddRoute("/a/b/c"), a);
+
+  EXPECT_EQ(Match(trie, "/a/b/c")->route_id, a);
+  EXPECT_EQ(Match(trie, "/a/b/d")->route_id, b);
+  EXPECT_EQ(Match(trie, "/a")->route_id, c);
+  EXPECT_EQ(Match(trie, "/a")->matched_path_length, std::size_t{2});
+  EXPECT_FALSE(Match(trie, "/a/b"));
+  EXPECT_FALSE(Match(trie, "/a/b/"));
+  EXPECT_FALSE(Match(trie, "/a/bb/c"));
+  EXPECT_FALSE(Match(trie, "/a/b/c/d"));
+  EXPECT_FALSE(Match(trie, "/a/b/cd"));
+  EXPECT_FALSE(Match(trie, ""));
+}
+
+TEST(PathTrie, Wildcards) {
+  PathTrie trie;
+  const auto one = trie.AddRoute("/v1/{id}");
+  const auto two = trie.AddRoute("/v1/{id}/items/{item}");
+  EXPECT_EQ(trie.AddRoute("/v1/{other}"), one);
+
+  auto match = Match(trie, "/v1/42");
+  ASSERT_TRUE(match);
+  EXPECT_EQ(match->route_id, one);
+  EXPECT_EQ(match->captures, (std::vector<std::string>{"42"}));
+
+  match = Match(trie, "/v1/42/items/abc");
+  ASSERT_TRUE(match);
+  EXPECT_EQ(match->route_id, two);
+  EXPECT_EQ(match->captures, (std::vector<std::string>{"42", "abc"}));
+
+  match = Match(trie, "/v1/");
+  ASSERT_TRUE(match);
+  EXPECT_EQ(match->captures, (std::vector<std::string>{""}));
+
+  EXPECT_FALSE(Match(trie, "/v1/42/items"));
+  EXPECT_FALSE(Match(trie, "/v1/42/other/abc"));
+}
+
+TEST(PathTrie, FixedBeforeWildcard) {
+  PathTrie trie;
+  const auto wildcard = trie.AddRoute("/v1/{id}/info");
+  const auto fixed = trie.AddRoute("/v1/me/info");
+  const auto other = trie.AddRoute("/v1/me/other");
+
+  EXPECT_EQ(Match(trie, "/v1/me/info")->route_id, fixed);
+  EXPECT_EQ(Match(trie, "/v1/me/other")->route_id, other);
+  EXPECT_EQ(Match(trie, "/v1/42/info")->route_id, wildcard);
+
+  // backtracks from the fixed edge to the wildcard one
+  auto match = Match(trie, "/v1/me/info", fixed);
+  ASSERT_TRUE(match);
+  EXPECT_EQ(match->route_id, wildcard);
+  EXPECT_EQ(match->captures, (std::vector<std::string>{"me"}));
+}
+
+TEST(PathTrie, AnySuffix) {
+  PathTrie trie;
+  const auto short_suffix = trie.AddRoute("/static/*");
+  const auto long_suffix = trie.AddRoute("/static/js/*");
+  const auto exact = trie.AddRoute("/static/js/app.js");
+  const auto literal = trie.AddRoute("/a/*/b");
+
+  EXPECT_EQ(Match(trie, "/static/js/app.js")->route_id, exact);
+
+  auto match = Match(trie, "/static/js/lib/x.js");
+  ASSERT_TRUE(match);
+  EXPECT_EQ(match->route_id, long_suffix);
+  EXPECT_EQ(match->matched_path_length, std::string_view{"/static/js/"}.size());
+  EXPECT_EQ(match->any_suffix, "lib/x.js");
+
+  match = Match(trie, "/static/css/x.css");
+  ASSERT_TRUE(match);
+  EXPECT_EQ(match->route_id, short_suffix);
+  EXPECT_EQ(match->any_suffix, "css/x.css");
+
+  match = Match(trie, "/static/js/lib/x.js", long_suffix);
+  ASSERT_TRUE(match);
+  EXPECT_EQ(match->route_id, short_suffix);
+  EXPECT_EQ(match->any_suffix, "js/lib/x.js");
+
+  // '*' matches at least one segment
+  EXPECT_FALSE(Match(trie, "/static"));
+  EXPECT_EQ(Match(trie, "/static/")->route_id, short_suffix);
+
+  // '*' in the middle is a fixed segment
+  EXPECT_EQ(Match(trie, "/a/*/b")->route_id, literal);
+  EXPECT_FALSE(Match(trie, "/a/x/b"));
+}
+
+TEST(PathTrie, IncorrectWildcard) {
+  PathTrie trie;
+  EXPECT_THROW(trie.AddRoute("/v1/{id"), std::runtime_error);
+  EXPECT_THROW(trie.AddRoute("/v1/id}"), std::runtime_error);
+  EXPECT_THROW(trie.AddRoute("/v1/x{id}"), std::runtime_error);
+  EXPECT_EQ(trie.GetRoutesCount(), std::size_t{0});
+}
+
+USERVER_NAMESPACE_END
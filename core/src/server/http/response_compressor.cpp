@@ -0,0 +1,203 @@
+#include <server/http/response_compressor.hpp>
+
+#include <optional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr int kMaxQvalue = 1000;
+constexpr std::string_view kWhitespace = " \t";
+
+std::string_view TrimWhitespace(std::string_view str) {
+  const auto begin = str.find_first_not_of(kWhitespace);
+  if (begin == std::string_view::npos) return {};
+  const auto end = str.find_last_not_of(kWhitespace);
+  return str.substr(begin, end - begin + 1);
+}
+
+// qvalue = ( "0" [ "." 0*3DIGIT ] ) / ( "1" [ "." 0*3("0") ] ), in
+// thousandths. Returns nullopt for the malformed values.
+std::optional<int> ParseQvalue(std::string_view value) {
+  if (value.empty() || value.size() > 5 || (value[0] != '0' && value[0] != '1'))
+    return std::nullopt;
+
+  int result = (value[0] - '0') * kMaxQvalue;
+  if (value.size() == 1) return result;
+  if (value[1] != '.') return std::nullopt;
+
+  int multiplier = kMaxQvalue / 10;
+  for (const char c : value.substr(2)) {
+    if (c < '0' || c > '9') return std::nullopt;
+    result += (c - '0') * multiplier;
+    multiplier /= 10;
+  }
+  if (result > kMaxQvalue) return std::nullopt;
+  return result;
+}
+
+// Returns the qvalue of the coding, or nullopt if the element is malformed
+std::optional<int> ParseCodingQvalue(std::string_view params) {
+  int qvalue = kMaxQvalue;
+  while (!params.empty()) {
+    const auto param_end = params.find(';');
+    const auto param = TrimWhitespace(params.substr(0, param_end));
+    params = param_end == std::string_view::npos ? std::string_view{}
+                                                 : params.substr(param_end + 1);
+
+    const auto eq_pos = param.find('=');
+    if (eq_pos == std::string_view::npos) continue;
+    const auto name = TrimWhitespace(param.substr(0, eq_pos));
+    if (name != "q" && name != "Q") continue;
+
+    const auto parsed = ParseQvalue(TrimWhitespace(param.substr(eq_pos + 1)));
+    if (!parsed) return std::nullopt;
+    qvalue = *parsed;
+  }
+  return qvalue;
+}
+
+bool IsCodingName(std::string_view name, compression::Encoding encoding) {
+  const utils::StrIcaseEqual equal;
+  if (equal(name, compression::ToString(encoding))) return true;
+  // RFC 9110, 8.4.1.3: "x-gzip" should be treated as "gzip"
+  return encoding == compression::Encoding::kGzip && equal(name, "x-gzip");
+}
+
+int GetLevel(const handlers::ResponseCompressionConfig& config,
+             compression::Encoding encoding) {
+  switch (encoding) {
+    case compression::Encoding::kGzip:
+      return config.gzip_level;
+    case compression::Encoding::kZstd:
+      return config.zstd_level;
+    case compression::Encoding::kBrotli:
+      return config.brotli_level;
+  }
+  UINVARIANT(false, "Unexpected encoding");
+}
+
+}  // namespace
+
+ResponseCompressionSettings::ResponseCompressionSettings(
+    const handlers::ResponseCompressionConfig& config,
+    engine::TaskProcessor* task_processor)
+    : min_size(config.min_size), task_processor(task_processor) {
+  for (const auto& name : config.encodings) {
+    const auto encoding = compression::EncodingFromString(name);
+    if (!encoding) {
+      throw std::runtime_error(
+          fmt::format("Unsupported response compression coding '{}'", name));
+    }
+
+    const auto level = GetLevel(config, *encoding);
+    const auto [min_level, max_level] = compression::GetLevelRange(*encoding);
+    if (level < min_level || level > max_level) {
+      throw std::runtime_error(fmt::format(
+          "Compression level of '{}' must be in [{}, {}], got {}", name,
+          min_level, max_level, level));
+    }
+    codings.push_back({*encoding, level});
+  }
+}
+
+const ResponseCompressionSettings::Coding* NegotiateEncoding(
+    std::string_view accept_encoding,
+    const ResponseCompressionSettings& settings) {
+  // Without the header any coding is acceptable, but clients that do not send
+  // it are rarely able to decompress anything
+  if (accept_encoding.empty()) return nullptr;
+
+  std::vector<int> qvalues(settings.codings.size(), -1);
+  int wildcard_qvalue = 0;
+
+  while (!accept_encoding.empty()) {
+    const auto element_end = accept_encoding.find(',');
+    const auto element = accept_encoding.substr(0, element_end);
+    accept_encoding = element_end == std::string_view::npos
+                          ? std::string_view{}
+                          : accept_encoding.substr(element_end + 1);
+
+    const auto params_pos = element.find(';');
+    const auto name = TrimWhitespace(element.substr(0, params_pos));
+    if (name.empty()) continue;
+
+    const auto qvalue =
+        params_pos == std::string_view::npos
+            ? std::optional<int>{kMaxQvalue}
+            : ParseCodingQvalue(element.substr(params_pos + 1));
+    if (!qvalue) continue;
+
+    if (name == "*") {
+      wildcard_qvalue = *qvalue;
+      continue;
+    }
+    for (size_t i = 0; i < settings.codings.size(); ++i) {
+      if (IsCodingName(name, settings.codings[i].encoding)) {
+        qvalues[i] = *qvalue;
+      }
+    }
+  }
+
+  const ResponseCompressionSettings::Coding* result = nullptr;
+  int best_qvalue = 0;
+  for (size_t i = 0; i < settings.codings.size(); ++i) {
+    // codings not listed explicitly are matched by the wildcard
+    const auto qvalue = qvalues[i] < 0 ? wildcard_qvalue : qvalues[i];
+    if (qvalue > best_qvalue) {
+      best_qvalue = qvalue;
+      result = &settings.codings[i];
+    }
+  }
+  return result;
+}
+
+ResponseCompressor::ResponseCompressor(
+    const ResponseCompressionSettings::Coding& coding,
+    engine::TaskProcessor* task_processor)
+    : encoding_(coding.encoding),
+      compressor_(compression::MakeCompressor(coding.encoding, coding.level)),
+      task_processor_(task_processor) {}
+
+std::string ResponseCompressor::Compress(std::string_view data) {
+  return Run([this, data] {
+    std::string result;
+    compressor_->Compress(data, result);
+    compressor_->Finish(result);
+    return result;
+  });
+}
+
+std::string ResponseCompressor::CompressChunk(std::string_view chunk) {
+  return Run([this, chunk] {
+    std::string result;
+    compressor_->Compress(chunk, result);
+    compressor_->Flush(result);
+    return result;
+  });
+}
+
+std::string ResponseCompressor::Finish() {
+  std::string result;
+  compressor_->Finish(result);
+  return result;
+}
+
+template <typename Func>
+std::string ResponseCompressor::Run(Func&& func) {
+  if (!task_processor_) return func();
+  return engine::AsyncNoSpan(*task_processor_, std::forward<Func>(func)).Get();
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <compression/compressor.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/server/handlers/handler_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Validated response compression options of a handler
+struct ResponseCompressionSettings {
+  struct Coding {
+    compression::Encoding encoding;
+    int level;
+  };
+
+  /// @throws std::runtime_error on unknown codings and invalid levels
+  ResponseCompressionSettings(const handlers::ResponseCompressionConfig& config,
+                              engine::TaskProcessor* task_processor);
+
+  std::vector<Coding> codings;  // in the order of preference
+  size_t min_size;
+  engine::TaskProcessor* task_processor;  // nullptr for the current one
+};
+
+/// @brief Selects the coding acceptable by the client according to the
+/// `Accept-Encoding` request header (RFC 9110, 12.5.3).
+///
+/// The coding with the highest qvalue is selected, ties are resolved by the
+/// order of the codings in the settings.
+/// @returns nullptr if the response should not be compressed
+const ResponseCompressionSettings::Coding* NegotiateEncoding(
+    std::string_view accept_encoding,
+    const ResponseCompressionSettings& settings);
+
+/// @brief Compresses a response, the heavy work is done on the configured
+/// task processor.
+class ResponseCompressor final {
+ public:
+  ResponseCompressor(const ResponseCompressionSettings::Coding& coding,
+                     engine::TaskProcessor* task_processor);
+
+  compression::Encoding GetEncoding() const { return encoding_; }
+
+  /// Compresses the whole response body
+  std::string Compress(std::string_view data);
+
+  /// Compresses a chunk of a streamed body, the returned data may be
+  /// decompressed by the client without waiting for the next chunks
+  std::string CompressChunk(std::string_view chunk);
+
+  /// Finishes the streamed body, cheap enough to be done in place
+  std::string Finish();
+
+ private:
+  template <typename Func>
+  std::string Run(Func&& func);
+
+  const compression::Encoding encoding_;
+  std::unique_ptr<compression::Compressor> compressor_;
+  engine::TaskProcessor* const task_processor_;
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,105 @@
+#include <server/http/response_compressor.hpp>
+
+#include <gtest/gtest.h>
+
+#include <compression/gzip.hpp>
+#include <compression/zstd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::NegotiateEncoding;
+using server::http::impl::ResponseCompressionSettings;
+
+ResponseCompressionSettings MakeSettings(std::vector<std::string> encodings) {
+  server::handlers::ResponseCompressionConfig config;
+  config.encodings = std::move(encodings);
+  return ResponseCompressionSettings{config, nullptr};
+}
+
+std::optional<compression::Encoding> Negotiate(
+    std::string_view accept_encoding,
+    const ResponseCompressionSettings& settings) {
+  const auto* coding = NegotiateEncoding(accept_encoding, settings);
+  if (!coding) return std::nullopt;
+  return coding->encoding;
+}
+
+}  // namespace
+
+TEST(ResponseCompressor, Settings) {
+  const auto settings = MakeSettings({"br", "gzip"});
+  ASSERT_EQ(settings.codings.size(), std::size_t{2});
+  EXPECT_EQ(settings.codings[0].encoding, compression::Encoding::kBrotli);
+  EXPECT_EQ(settings.codings[0].level, 4);
+  EXPECT_EQ(settings.codings[1].encoding, compression::Encoding::kGzip);
+  EXPECT_EQ(settings.codings[1].level, 6);
+  EXPECT_EQ(settings.min_size, std::size_t{1024});
+
+  EXPECT_THROW(MakeSettings({"deflate"}), std::runtime_error);
+
+  server::handlers::ResponseCompressionConfig config;
+  config.encodings = {"gzip"};
+  config.gzip_level = 10;
+  EXPECT_THROW((ResponseCompressionSettings{config, nullptr}),
+               std::runtime_error);
+}
+
+TEST(ResponseCompressor, Negotiate) {
+  if (!compression::zstd::IsSupported()) GTEST_SKIP() << "zstd is too old";
+  const auto settings = MakeSettings({"zstd", "gzip"});
+  using compression::Encoding;
+
+  EXPECT_EQ(Negotiate("", settings), std::nullopt);
+  EXPECT_EQ(Negotiate("identity", settings), std::nullopt);
+  EXPECT_EQ(Negotiate("deflate, br", settings), std::nullopt);
+
+  EXPECT_EQ(Negotiate("gzip", settings), Encoding::kGzip);
+  EXPECT_EQ(Negotiate("GZip", settings), Encoding::kGzip);
+  EXPECT_EQ(Negotiate("x-gzip", settings), Encoding::kGzip);
+  EXPECT_EQ(Negotiate("gzip, deflate, br, zstd", settings), Encoding::kZstd);
+  EXPECT_EQ(Negotiate(" gzip ;q=1 ,zstd; q=0.5", settings), Encoding::kGzip);
+  EXPECT_EQ(Negotiate("gzip;q=0.001, zstd;q=0", settings), Encoding::kGzip);
+  EXPECT_EQ(Negotiate("gzip;q=0, zstd;q=0", settings), std::nullopt);
+
+  EXPECT_EQ(Negotiate("*", settings), Encoding::kZstd);
+  EXPECT_EQ(Negotiate("*;q=0.5, gzip", settings), Encoding::kGzip);
+  EXPECT_EQ(Negotiate("*;q=0.5, zstd;q=0", settings), Encoding::kGzip);
+  EXPECT_EQ(Negotiate("*;q=0", settings), std::nullopt);
+
+  // malformed elements are ignored
+  EXPECT_EQ(Negotiate("zstd;q=2, gzip;q=0.1", settings), Encoding::kGzip);
+  EXPECT_EQ(Negotiate("zstd;q=0.0001, gzip;q=.5", settings), std::nullopt);
+  EXPECT_EQ(Negotiate(",,;, zstd;foo;q=0.9", settings), Encoding::kZstd);
+}
+
+TEST(ResponseCompressor, Compress) {
+  const auto settings = MakeSettings({"gzip"});
+  const std::string data(10000, 'a');
+
+  server::http::impl::ResponseCompressor compressor{settings.codings[0],
+                                                    nullptr};
+  const auto compressed = compressor.Compress(data);
+  EXPECT_LT(compressed.size(), data.size());
+  EXPECT_EQ(compression::gzip::Decompress(compressed, data.size()), data);
+}
+
+TEST(ResponseCompressor, CompressChunks) {
+  const auto settings = MakeSettings({"gzip"});
+  const std::string data(10000, 'a');
+
+  server::http::impl::ResponseCompressor compressor{settings.codings[0],
+                                                    nullptr};
+  std::string compressed;
+  for (int i = 0; i < 3; ++i) {
+    const auto chunk = compressor.CompressChunk(data);
+    EXPECT_FALSE(chunk.empty());
+    compressed += chunk;
+  }
+  compressed += compressor.Finish();
+  EXPECT_EQ(compression::gzip::Decompress(compressed, data.size() * 3),
+            data + data + data);
+}
+
+USERVER_NAMESPACE_END
@@ -2,75 +2,34 @@
 
 #include <stdexcept>
 
-#include <boost/algorithm/string/split.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http::impl {
 namespace {
 
-const std::string kAnySuffixMark{"*"};
-
 constexpr char kWildcardStart = '{';
 constexpr char kWildcardFinish = '}';
 
-std::vector<std::string> SplitBySlash(const std::string& path) {
-  std::vector<std::string> path_vec;
-  boost::split(path_vec, path, [](char c) { return c == '/'; });
-  return path_vec;
+bool HasWildcardSymbols(std::string_view path) {
+  return path.find(kWildcardStart) != std::string_view::npos ||
+         path.find(kWildcardFinish) != std::string_view::npos;
 }
 
-std::string ExtractWildcardName(const std::string& str) {
+std::string ExtractWildcardName(std::string_view str) {
   if (str.empty() || str.front() != kWildcardStart ||
       str.back() != kWildcardFinish) {
-    throw std::runtime_error("Incorrect wildcard '" + str + '\'');
-  }
-
-  return str.substr(1, str.size() - 2);
-}
-
-bool GetFromHandlerMethodIndex(const WildcardPathIndex::Node& node,
-                               HttpMethod method,
-                               const std::vector<std::string>& path,
-                               MatchRequestResult& match_result,
-                               bool limit_path_length) {
-  const auto& index_map = node.handler_method_index_map;
-  decltype(index_map.begin()) it;
-  if (limit_path_length) {
-    it = index_map.find(path.size());
-  } else {
-    it = index_map.upper_bound(path.size());
-    if (it == index_map.begin()) return false;
-    --it;
-  }
-  if (it == index_map.end()) return false;
-  const auto& handler_method_index = it->second;
-
-  const auto* handler_info_data =
-      handler_method_index.GetHandlerInfoData(method);
-  if (!handler_info_data) {
-    match_result.status = MatchRequestResult::Status::kMethodNotAllowed;
-    return false;
+    throw std::runtime_error("Incorrect wildcard '" + std::string{str} + '\'');
   }
 
-  match_result.handler_info = &handler_info_data->handler_info;
-  for (const auto& arg : handler_info_data->wildcards) {
-    if (arg.index > path.size())
-      throw std::logic_error(
-          "matched path from handler has length greater than path from "
-          "request");
-    match_result.args_from_path.emplace_back(
-        arg.name, arg.index == path.size() ? std::string{} : path[arg.index]);
-  }
-  match_result.status = MatchRequestResult::Status::kOk;
-  return true;
+  return std::string{str.substr(1, str.size() - 2)};
 }
 
 }  // namespace
 
 bool HasWildcardSpecificSymbols(const std::string& path) {
-  return path.find(kWildcardStart) != std::string::npos ||
-         path.find(kWildcardFinish) != std::string::npos;
+  return HasWildcardSymbols(path);
 }
 
 void WildcardPathIndex::AddHandler(const handlers::HttpHandlerBase& handler,
@@ -108,99 +67,83 @@ void WildcardPathIndex::AddHandler(const handlers::HttpHandlerBase& handler,
 
 bool WildcardPathIndex::MatchRequest(HttpMethod method, const std::string& path,
                                      MatchRequestResult& match_result) const {
-  return MatchRequest(root_, method, SplitBySlash(path), path.size(),
-                      match_result);
+  const HandlerMethodIndex::HandlerInfoData* handler_info_data = nullptr;
+  const auto accept = [&](PathTrie::RouteId route_id) {
+    handler_info_data =
+        handler_method_indices_[route_id].GetHandlerInfoData(method);
+    if (!handler_info_data) {
+      match_result.status = MatchRequestResult::Status::kMethodNotAllowed;
+      return false;
+    }
+    return true;
+  };
+
+  PathTrie::Match match;
+  PathTrie::Captures captures;
+  if (!path_trie_.MatchPath(path, accept, match, captures)) return false;
+
+  UASSERT(handler_info_data);
+  const auto& wildcards = handler_info_data->wildcards;
+  UINVARIANT(wildcards.size() == captures.size(),
+             "wildcards count of the handler differs from the matched one");
+
+  match_result.handler_info = &handler_info_data->handler_info;
+  match_result.matched_path_length = match.matched_path_length;
+  match_result.args_from_path.reserve(captures.size());
+  for (std::size_t i = 0; i < captures.size(); ++i) {
+    match_result.args_from_path.emplace_back(wildcards[i].name, captures[i]);
+  }
+  if (!match.any_suffix.empty()) {
+    std::size_t pos = 0;
+    while (true) {
+      const auto segment_end = match.any_suffix.find('/', pos);
+      match_result.args_from_path.emplace_back(
+          std::string{}, match.any_suffix.substr(pos, segment_end - pos));
+      if (segment_end == std::string_view::npos) break;
+      pos = segment_end + 1;
+    }
+  }
+  match_result.status = MatchRequestResult::Status::kOk;
+  return true;
 }
 
 void WildcardPathIndex::AddHandler(const std::string& path,
                                    const handlers::HttpHandlerBase& handler,
                                    engine::TaskProcessor& task_processor) {
-  auto path_vec = SplitBySlash(path);
-  std::vector<PathItem> path_fixed_items;
   std::vector<PathItem> path_wildcards;
   std::unordered_set<std::string> wildcard_names;
+  PathTrie::RouteId route_id{};
   try {
-    for (size_t i = 0; i < path_vec.size(); i++) {
-      if (!HasWildcardSpecificSymbols(path_vec[i])) {
-        path_fixed_items.emplace_back(
-            ExtractFixedPathItem(i, std::move(path_vec[i])));
-      } else {
+    std::size_t index = 0;
+    std::size_t pos = 0;
+    while (true) {
+      const auto segment_end = path.find('/', pos);
+      const auto segment =
+          std::string_view{path}.substr(pos, segment_end - pos);
+      if (HasWildcardSymbols(segment)) {
         path_wildcards.emplace_back(
-            ExtractWildcardPathItem(i, path_vec[i], wildcard_names));
+            ExtractWildcardPathItem(index, segment, wildcard_names));
       }
+      if (segment_end == std::string::npos) break;
+      pos = segment_end + 1;
+      ++index;
     }
+    route_id = path_trie_.AddRoute(path);
   } catch (const std::exception& ex) {
     throw std::runtime_error("Failed to process handler path '" + path +
                              "': " + ex.what());
   }
-  AddPath(handler, task_processor, std::move(path_fixed_items),
-          std::move(path_wildcards));
-}
-
-void WildcardPathIndex::AddPath(const handlers::HttpHandlerBase& handler,
-                                engine::TaskProcessor& task_processor,
-                                std::vector<PathItem>&& fixed_path,
-                                std::vector<PathItem> wildcards) {
-  size_t length = fixed_path.size() + wildcards.size();
-  Node* cur = &root_;
-  for (auto& path_item : std::move(fixed_path)) {
-    cur = &cur->next[path_item.index][std::move(path_item.name)];
-  }
-  cur->handler_method_index_map[length].AddHandler(handler, task_processor,
-                                                   std::move(wildcards));
-}
 
-bool WildcardPathIndex::MatchRequest(const Node& node, HttpMethod method,
-                                     const std::vector<std::string>& path,
-                                     size_t path_string_length,
-                                     MatchRequestResult& match_result) const {
-  for (const auto& next_item : node.next) {
-    if (next_item.first >= path.size()) break;
-    auto it = next_item.second.find(path[next_item.first]);
-    if (it != next_item.second.end()) {
-      if (MatchRequest(it->second, method, path, path_string_length,
-                       match_result))
-        return true;
-    }
+  UASSERT(route_id <= handler_method_indices_.size());
+  if (route_id == handler_method_indices_.size()) {
+    handler_method_indices_.emplace_back();
   }
-
-  // check for match without '*'
-  if (GetFromHandlerMethodIndex(node, method, path, match_result, true)) {
-    match_result.matched_path_length = path_string_length;
-    return true;
-  }
-
-  // check "/some/.../path/*"
-  auto node_next_it = node.next.lower_bound(path.size());
-  while (node_next_it != node.next.begin()) {
-    --node_next_it;
-    auto it = node_next_it->second.find(kAnySuffixMark);
-    if (it != node_next_it->second.end()) {
-      if (GetFromHandlerMethodIndex(it->second, method, path, match_result,
-                                    false)) {
-        size_t asterisk_pos = node_next_it->first;
-        match_result.matched_path_length = asterisk_pos;
-        for (size_t i = 0; i < asterisk_pos; i++) {
-          match_result.matched_path_length += path[i].size();
-        }
-        for (size_t i = asterisk_pos; i < path.size(); i++) {
-          match_result.args_from_path.emplace_back(std::string{}, path[i]);
-        }
-        return true;
-      }
-    }
-  }
-
-  return false;
-}
-
-PathItem WildcardPathIndex::ExtractFixedPathItem(size_t index,
-                                                 std::string&& path_elem) {
-  return PathItem{index, std::move(path_elem)};
+  handler_method_indices_[route_id].AddHandler(handler, task_processor,
+                                               std::move(path_wildcards));
 }
 
 PathItem WildcardPathIndex::ExtractWildcardPathItem(
-    size_t index, const std::string& path_elem,
+    size_t index, std::string_view path_elem,
     std::unordered_set<std::string>& wildcard_names) {
   auto wildcard_name = ExtractWildcardName(path_elem);
   if (!wildcard_name.empty()) {
@@ -0,0 +1,51 @@
+#include "buffer_pool.hpp"
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+BufferPool::Buffer::Buffer(BufferPool& pool,
+                           std::unique_ptr<char[]> data) noexcept
+    : pool_(&pool), data_(std::move(data)) {}
+
+BufferPool::Buffer::~Buffer() {
+  // data_ is empty in moved-from buffers
+  if (data_) pool_->Release(std::move(data_));
+}
+
+BufferPool::BufferPool(std::size_t buffer_size, std::size_t max_idle_buffers)
+    : buffer_size_(buffer_size), max_idle_buffers_(max_idle_buffers) {
+  UINVARIANT(buffer_size_ > 0, "Receive buffer size must be positive");
+}
+
+std::size_t BufferPool::GetIdleBuffersApprox() const noexcept {
+  return idle_buffers_count_.load(std::memory_order_relaxed);
+}
+
+BufferPool::Buffer BufferPool::Acquire() {
+  std::unique_ptr<char[]> data;
+  if (idle_buffers_.try_dequeue(data)) {
+    idle_buffers_count_.fetch_sub(1, std::memory_order_relaxed);
+  } else {
+    // Not value-initialized on purpose, the buffer is written by recv()
+    data.reset(new char[buffer_size_]);
+  }
+  return Buffer{*this, std::move(data)};
+}
+
+void BufferPool::Release(std::unique_ptr<char[]> data) noexcept {
+  // The limit is approximate, a few extra buffers may be kept under contention
+  if (idle_buffers_count_.load(std::memory_order_relaxed) >=
+      max_idle_buffers_) {
+    return;
+  }
+  if (idle_buffers_.enqueue(std::move(data))) {
+    idle_buffers_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
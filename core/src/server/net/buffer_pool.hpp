@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include <moodycamel/concurrentqueue.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+/// Pool of fixed size receive buffers shared by the connections of a listener.
+///
+/// A connection holds a buffer only while it has data to read and parse, so
+/// idle keep-alive connections hold no receive memory at all.
+class BufferPool final {
+ public:
+  /// Buffer that is returned into the pool on destruction
+  class Buffer final {
+   public:
+    Buffer(Buffer&&) noexcept = default;
+    Buffer& operator=(Buffer&&) = delete;
+    ~Buffer();
+
+    char* Data() noexcept { return data_.get(); }
+    std::size_t Size() const noexcept { return pool_->GetBufferSize(); }
+
+   private:
+    friend class BufferPool;
+
+    Buffer(BufferPool& pool, std::unique_ptr<char[]> data) noexcept;
+
+    BufferPool* pool_;
+    std::unique_ptr<char[]> data_;
+  };
+
+  BufferPool(std::size_t buffer_size, std::size_t max_idle_buffers);
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  std::size_t GetBufferSize() const noexcept { return buffer_size_; }
+  std::size_t GetIdleBuffersApprox() const noexcept;
+
+  /// Returns an idle buffer or allocates a new one. Buffers must not outlive
+  /// the pool.
+  Buffer Acquire();
+
+ private:
+  void Release(std::unique_ptr<char[]> data) noexcept;
+
+  const std::size_t buffer_size_;
+  const std::size_t max_idle_buffers_;
+  moodycamel::ConcurrentQueue<std::unique_ptr<char[]>> idle_buffers_;
+  std::atomic<std::size_t> idle_buffers_count_{0};
+};
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
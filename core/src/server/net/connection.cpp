@@ -6,6 +6,8 @@
 #include <system_error>
 #include <vector>
 
+#include <server/http/http2_session.hpp>
+#include <server/http/http_request_impl.hpp>
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/request/request_config.hpp>
@@ -26,11 +28,12 @@ std::shared_ptr<Connection> Connection::Create(
     engine::TaskProcessor& task_processor, const ConnectionConfig& config,
     engine::io::Socket peer_socket,
     const http::RequestHandlerBase& request_handler,
-    std::shared_ptr<Stats> stats,
+    std::shared_ptr<Stats> stats, std::shared_ptr<BufferPool> buffer_pool,
     request::ResponseDataAccounter& data_accounter) {
   return std::make_shared<Connection>(
       task_processor, config, std::move(peer_socket), request_handler,
-      std::move(stats), data_accounter, EmplaceEnabler{});
+      std::move(stats), std::move(buffer_pool), data_accounter,
+      EmplaceEnabler{});
 }
 
 Connection::Connection(engine::TaskProcessor& task_processor,
@@ -38,6 +41,7 @@ Connection::Connection(engine::TaskProcessor& task_processor,
                        engine::io::Socket peer_socket,
                        const http::RequestHandlerBase& request_handler,
                        std::shared_ptr<Stats> stats,
+                       std::shared_ptr<BufferPool> buffer_pool,
                        request::ResponseDataAccounter& data_accounter,
                        EmplaceEnabler)
     : task_processor_(task_processor),
@@ -45,9 +49,11 @@ Connection::Connection(engine::TaskProcessor& task_processor,
       peer_socket_(std::move(peer_socket)),
       request_handler_(request_handler),
       stats_(std::move(stats)),
+      buffer_pool_(std::move(buffer_pool)),
       data_accounter_(data_accounter),
       remote_address_(peer_socket_.Getpeername().PrimaryAddressString()),
       request_tasks_(Queue::Create()) {
+  UASSERT(buffer_pool_);
   LOG_DEBUG() << "Incoming connection from " << peer_socket_.Getpeername()
               << ", fd " << Fd();
 
@@ -87,6 +93,7 @@ void Connection::Start() {
 
         socket_listener.SyncCancel();
         self->ProcessResponses(consumer);  // Consume remaining requests
+        self->WaitHttp2Responses();
         self->Shutdown();
       },
       shared_from_this(), std::move(socket_listener));
@@ -135,6 +142,10 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
       response_sender_task_.RequestCancel();
     }
   });
+  utils::ScopeGuard http2_session_closer([this]() {
+    // nothing is received any more, window updates included
+    if (http2_session_) http2_session_->Close();
+  });
 
   try {
     request_tasks_->SetSoftMaxSize(config_.requests_queue_size_threshold);
@@ -148,11 +159,28 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
         },
         stats_->parser_stats, data_accounter_);
 
-    std::vector<char> buf(config_.in_buffer_size);
+    if (config_.http_version == HttpVersion::kHttp2) {
+      auto connection_start = RecvConnectionStart();
+      if (connection_start.empty()) {
+        LOG_TRACE() << "Peer " << peer_socket_.Getpeername() << " on fd "
+                    << Fd() << " closed connection";
+        return;
+      }
+
+      if (std::string_view{connection_start}.substr(
+              0, http::Http2Session::kConnectionPreface.size()) ==
+          http::Http2Session::kConnectionPreface) {
+        if (!ListenForHttp2Requests(std::move(connection_start), producer)) {
+          return;
+        }
+      } else {
+        Parse(request_parser, connection_start.data(),
+              connection_start.size());
+      }
+    }
+
     while (is_accepting_requests_) {
-      auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
-      const auto bytes_read =
-          peer_socket_.RecvSome(buf.data(), buf.size(), deadline);
+      const auto bytes_read = RecvAndParse(request_parser);
       if (!bytes_read) {
         LOG_TRACE() << "Peer " << peer_socket_.Getpeername() << " on fd "
                     << Fd() << " closed connection";
@@ -166,16 +194,6 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
         // processing and pending requests.
         return;
       }
-      LOG_TRACE() << "Received " << bytes_read << " byte(s) from "
-                  << peer_socket_.Getpeername() << " on fd " << Fd();
-
-      if (!request_parser.Parse(buf.data(), bytes_read)) {
-        LOG_DEBUG() << "Malformed request from " << peer_socket_.Getpeername()
-                    << " on fd " << Fd();
-
-        // Stop accepting new requests, send previous answers.
-        is_accepting_requests_ = false;
-      }
     }
 
     send_stopper.Release();
@@ -202,6 +220,112 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
   }
 }
 
+std::string Connection::RecvConnectionStart() {
+  constexpr auto kPreface = http::Http2Session::kConnectionPreface;
+  const auto deadline =
+      engine::Deadline::FromDuration(config_.keepalive_timeout);
+
+  // Usually the whole preface or the whole HTTP/1.1 request head arrives at
+  // once, otherwise the data is received until they could be told apart
+  std::string data;
+  while (data.size() < kPreface.size() &&
+         kPreface.substr(0, data.size()) == data) {
+    auto buffer = WaitReadableAndAcquireBuffer(deadline);
+    const auto bytes_read =
+        peer_socket_.RecvSome(buffer.Data(), buffer.Size(), deadline);
+    if (!bytes_read) break;
+    data.append(buffer.Data(), bytes_read);
+  }
+  return data;
+}
+
+bool Connection::ListenForHttp2Requests(std::string connection_start,
+                                        Queue::Producer& producer) {
+  using RequestBasePtr = std::shared_ptr<request::RequestBase>;
+
+  LOG_DEBUG() << "HTTP/2 connection from " << peer_socket_.Getpeername()
+              << " on fd " << Fd();
+
+  http2_session_ = std::make_unique<http::Http2Session>(
+      request_handler_.GetHandlerInfoIndex(), *config_.request,
+      config_.http2_session,
+      [this, &producer](RequestBasePtr&& request_ptr) {
+        if (!NewRequest(std::move(request_ptr), producer)) {
+          is_accepting_requests_ = false;
+        }
+      },
+      stats_->parser_stats, data_accounter_, peer_socket_);
+
+  Parse(*http2_session_, connection_start.data(), connection_start.size());
+  std::string().swap(connection_start);
+
+  while (is_accepting_requests_) {
+    try {
+      if (!RecvAndParse(*http2_session_)) {
+        LOG_TRACE() << "Peer " << peer_socket_.Getpeername() << " on fd "
+                    << Fd() << " closed connection";
+        return false;
+      }
+    } catch (const engine::io::IoTimeout&) {
+      // Streams may wait for their handlers for long, only the connections
+      // without streams are idle
+      if (!http2_session_->HasOpenStreams()) throw;
+    }
+  }
+  return true;
+}
+
+size_t Connection::RecvAndParse(http::HttpRequestParser& request_parser) {
+  // Large bodies of known size are received right into the request
+  const auto body_buffer = request_parser.GetBodyBuffer();
+  if (body_buffer.size) {
+    const auto deadline =
+        engine::Deadline::FromDuration(config_.keepalive_timeout);
+    const auto bytes_read =
+        peer_socket_.RecvSome(body_buffer.data, body_buffer.size, deadline);
+    if (bytes_read) Parse(request_parser, body_buffer.data, bytes_read);
+    return bytes_read;
+  }
+
+  return RecvAndParse(static_cast<request::RequestParser&>(request_parser));
+}
+
+size_t Connection::RecvAndParse(request::RequestParser& request_parser) {
+  const auto deadline =
+      engine::Deadline::FromDuration(config_.keepalive_timeout);
+
+  auto buffer = WaitReadableAndAcquireBuffer(deadline);
+  const auto bytes_read =
+      peer_socket_.RecvSome(buffer.Data(), buffer.Size(), deadline);
+  if (bytes_read) Parse(request_parser, buffer.Data(), bytes_read);
+  return bytes_read;
+}
+
+BufferPool::Buffer Connection::WaitReadableAndAcquireBuffer(
+    engine::Deadline deadline) {
+  // Do not hold a buffer while waiting, idle keep-alive connections should
+  // not consume memory
+  if (!peer_socket_.WaitReadable(deadline)) {
+    if (engine::current_task::ShouldCancel()) throw engine::io::IoCancelled();
+    throw engine::io::IoTimeout();
+  }
+  return buffer_pool_->Acquire();
+}
+
+void Connection::Parse(request::RequestParser& request_parser,
+                       const char* data, size_t size) {
+  LOG_TRACE() << "Received " << size << " byte(s) from "
+              << peer_socket_.Getpeername() << " on fd " << Fd();
+
+  if (!request_parser.Parse(data, size)) {
+    LOG_DEBUG() << "Malformed request from " << peer_socket_.Getpeername()
+                << " on fd " << Fd();
+
+    // Stop accepting new requests, send previous answers.
+    is_accepting_requests_ = false;
+  }
+}
+
 bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                             Queue::Producer& producer) {
   if (!is_accepting_requests_) {
@@ -225,7 +349,12 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   try {
     std::unique_ptr<QueueItem> item;
     while (consumer.Pop(item)) {
-      HandleQueueItem(*item);
+      if (http2_session_) {
+        StartHttp2Response(std::move(item));
+        continue;
+      }
+
+      if (!HandleQueueItem(*item)) is_response_chain_valid_ = false;
 
       // now we must complete processing
       engine::TaskCancellationBlocker block_cancel;
@@ -233,7 +362,7 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
       /* In stream case we don't want a user task to exit
        * until SendResponse() as the task produces body chunks.
        */
-      SendResponse(*item->first);
+      SendResponse(*item->first, is_response_chain_valid_);
       item.reset();
     }
   } catch (const std::exception& e) {
@@ -241,7 +370,47 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   }
 }
 
-void Connection::HandleQueueItem(QueueItem& item) {
+void Connection::StartHttp2Response(std::unique_ptr<QueueItem> item) {
+  // Streams are answered in the order their handlers finish. Tasks of the
+  // answered streams are dropped from time to time, so that long-living
+  // connections do not accumulate them.
+  const auto max_tasks =
+      std::max<size_t>(config_.http2_session.max_concurrent_streams * 2, 16);
+  if (http2_response_tasks_.size() >= max_tasks) {
+    http2_response_tasks_.erase(
+        std::remove_if(http2_response_tasks_.begin(),
+                       http2_response_tasks_.end(),
+                       [](const auto& task) { return task.IsFinished(); }),
+        http2_response_tasks_.end());
+  }
+
+  // Critical, as the stream must be answered or reset
+  http2_response_tasks_.push_back(engine::CriticalAsyncNoSpan(
+      task_processor_,
+      [this](std::unique_ptr<QueueItem> item) {
+        const bool is_response_valid = HandleQueueItem(*item);
+
+        engine::TaskCancellationBlocker block_cancel;
+        SendResponse(*item->first, is_response_valid);
+      },
+      std::move(item)));
+}
+
+void Connection::WaitHttp2Responses() noexcept {
+  for (auto& task : http2_response_tasks_) {
+    // On graceful stop the responses are sent, otherwise they are cancelled
+    if (!engine::current_task::IsCancelRequested()) {
+      try {
+        task.Wait();
+      } catch (const engine::WaitInterruptedException&) {
+      }
+    }
+    task.SyncCancel();
+  }
+  http2_response_tasks_.clear();
+}
+
+bool Connection::HandleQueueItem(QueueItem& item) {
   auto& request = *item.first;
 
   if (engine::current_task::IsCancelRequested()) {
@@ -250,8 +419,7 @@ void Connection::HandleQueueItem(QueueItem& item) {
     auto request_task = std::move(item.second);
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
-    is_response_chain_valid_ = false;
-    return;  // avoids throwing and catching exception down below
+    return false;  // avoids throwing and catching exception down below
   }
 
   try {
@@ -271,21 +439,30 @@ void Connection::HandleQueueItem(QueueItem& item) {
     }
   } catch (const engine::WaitInterruptedException&) {
     LOG_DEBUG() << "Request processing interrupted";
-    is_response_chain_valid_ = false;
+    return false;
   } catch (const std::exception& e) {
     LOG_WARNING() << "Request failed with unhandled exception: " << e;
     request.MarkAsInternalServerError();
   }
+  return true;
 }
 
-void Connection::SendResponse(request::RequestBase& request) {
+void Connection::SendResponse(request::RequestBase& request,
+                              bool is_response_valid) {
   auto& response = request.GetResponse();
   UASSERT(!response.IsSent());
   request.SetStartSendResponseTime();
-  if (is_response_chain_valid_ && peer_socket_) {
+  if (is_response_valid && peer_socket_) {
     try {
-      // Might be a stream reading or a fully constructed response
-      response.SendResponse(peer_socket_);
+      if (http2_session_) {
+        auto& http_request = dynamic_cast<http::HttpRequestImpl&>(request);
+        http::impl::Http2StreamWriter writer{*http2_session_,
+                                             http_request.GetHttp2StreamId()};
+        http_request.GetHttpResponse().SendResponse(writer);
+      } else {
+        // Might be a stream reading or a fully constructed response
+        response.SendResponse(peer_socket_);
+      }
     } catch (const engine::io::IoSystemError& ex) {
       // working with raw values because std::errc compares error_category
       // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
@@ -3,9 +3,12 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <userver/server/request/request_base.hpp>
 
+#include <server/http/http2_session.hpp>
+#include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/stats.hpp>
 #include <server/request/request_parser.hpp>
@@ -16,6 +19,7 @@
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 
+#include "buffer_pool.hpp"
 #include "connection_config.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -35,6 +39,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
       engine::io::Socket peer_socket,
       const http::RequestHandlerBase& request_handler,
       std::shared_ptr<Stats> stats,
+      std::shared_ptr<BufferPool> buffer_pool,
       request::ResponseDataAccounter& data_accounter);
 
   // Use Create instead of this constructor
@@ -42,6 +47,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
              const ConnectionConfig& config, engine::io::Socket peer_socket,
              const http::RequestHandlerBase& request_handler,
              std::shared_ptr<Stats> stats,
+             std::shared_ptr<BufferPool> buffer_pool,
              request::ResponseDataAccounter& data_accounter, EmplaceEnabler);
 
   void SetCloseCb(CloseCb close_cb);
@@ -62,18 +68,29 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   bool IsRequestTasksEmpty() const noexcept;
 
   void ListenForRequests(Queue::Producer) noexcept;
+  std::string RecvConnectionStart();
+  bool ListenForHttp2Requests(std::string connection_start,
+                              Queue::Producer& producer);
+  size_t RecvAndParse(http::HttpRequestParser& request_parser);
+  size_t RecvAndParse(request::RequestParser& request_parser);
+  BufferPool::Buffer WaitReadableAndAcquireBuffer(engine::Deadline deadline);
+  void Parse(request::RequestParser& request_parser, const char* data,
+             size_t size);
   bool NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                   Queue::Producer&);
 
   void ProcessResponses(Queue::Consumer&) noexcept;
-  void HandleQueueItem(QueueItem& item);
-  void SendResponse(request::RequestBase& request);
+  void StartHttp2Response(std::unique_ptr<QueueItem> item);
+  void WaitHttp2Responses() noexcept;
+  [[nodiscard]] bool HandleQueueItem(QueueItem& item);
+  void SendResponse(request::RequestBase& request, bool is_response_valid);
 
   engine::TaskProcessor& task_processor_;
   const ConnectionConfig& config_;
   engine::io::Socket peer_socket_;
   const http::RequestHandlerBase& request_handler_;
   const std::shared_ptr<Stats> stats_;
+  const std::shared_ptr<BufferPool> buffer_pool_;
   request::ResponseDataAccounter& data_accounter_;
   const std::string remote_address_;
 
@@ -82,6 +99,11 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   engine::SingleConsumerEvent response_sender_assigned_event_;
   engine::Task response_sender_task_;
 
+  // Set by the socket listener before the first request is pushed to the queue
+  std::unique_ptr<http::Http2Session> http2_session_;
+  // Owned by the response sender, each stream is answered by its own task
+  std::vector<engine::TaskWithResult<void>> http2_response_tasks_;
+
   bool is_accepting_requests_{true};
   bool is_response_chain_valid_{true};
   CloseCb close_cb_;
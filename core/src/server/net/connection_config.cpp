@@ -1,11 +1,37 @@
 #include "connection_config.hpp"
 
+#include <stdexcept>
+
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+HttpVersion Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<HttpVersion>) {
+  const auto str = value.As<std::string>();
+  if (str == "1.1") return HttpVersion::kHttp11;
+  if (str == "2") return HttpVersion::kHttp2;
+  throw std::runtime_error("unknown http_version '" + str + "' at " +
+                           value.GetPath() + ", expected '1.1' or '2'");
+}
+
+Http2SessionConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<Http2SessionConfig>) {
+  Http2SessionConfig config;
+
+  config.max_concurrent_streams =
+      value["max_concurrent_streams"].As<std::uint32_t>(
+          config.max_concurrent_streams);
+  config.max_frame_size =
+      value["max_frame_size"].As<std::uint32_t>(config.max_frame_size);
+  config.initial_window_size = value["initial_window_size"].As<std::uint32_t>(
+      config.initial_window_size);
+
+  return config;
+}
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>) {
   ConnectionConfig config;
@@ -18,6 +44,10 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.http_version =
+      value["http_version"].As<HttpVersion>(config.http_version);
+  config.http2_session =
+      value["http2_session"].As<Http2SessionConfig>(config.http2_session);
   config.request = value["request"].As<request::RequestConfig>();
 
   return config;
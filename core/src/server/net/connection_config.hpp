@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -11,15 +12,36 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+enum class HttpVersion {
+  kHttp11,
+  // HTTP/1.1 and HTTP/2 with prior knowledge, told apart by the HTTP/2
+  // connection preface
+  kHttp2,
+};
+
+struct Http2SessionConfig {
+  std::uint32_t max_concurrent_streams = 100;
+  std::uint32_t max_frame_size = 16 * 1024;
+  std::uint32_t initial_window_size = 64 * 1024 - 1;
+};
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  HttpVersion http_version = HttpVersion::kHttp11;
+  Http2SessionConfig http2_session;
 
   // Actually required, wrapped in an optional to simplify parsing
   std::optional<request::RequestConfig> request;
 };
 
+HttpVersion Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<HttpVersion>);
+
+Http2SessionConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<Http2SessionConfig>);
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>);
 
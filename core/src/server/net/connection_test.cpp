@@ -91,6 +91,12 @@ clients::http::ResponseFuture CreateRequest(
   return ret->async_perform();
 }
 
+std::shared_ptr<net::BufferPool> MakeBufferPool(
+    const net::ListenerConfig& config) {
+  return std::make_shared<net::BufferPool>(
+      config.connection_config.in_buffer_size, 1);
+}
+
 net::ListenerConfig CreateConfig() {
   net::ListenerConfig config;
   config.connection_config.request = server::request::RequestConfig{{}};
@@ -115,7 +121,7 @@ UTEST(ServerNetConnection, EarlyCancel) {
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      std::move(peer), handler, stats, data_accounter);
+      std::move(peer), handler, stats, MakeBufferPool(config), data_accounter);
 
   connection_ptr->Start();
   // Immediately canceling the `socket_listener_` task without giving it
@@ -155,7 +161,7 @@ UTEST(ServerNetConnection, EarlyTimeout) {
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      std::move(peer), handler, stats, data_accounter);
+      std::move(peer), handler, stats, MakeBufferPool(config), data_accounter);
 
   connection_ptr->Start();
   std::weak_ptr<net::Connection> weak = connection_ptr;
@@ -186,7 +192,7 @@ UTEST(ServerNetConnection, TimeoutWithTaskCancellation) {
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      std::move(peer), handler, stats, data_accounter);
+      std::move(peer), handler, stats, MakeBufferPool(config), data_accounter);
 
   connection_ptr->Start();
   std::weak_ptr<net::Connection> weak = connection_ptr;
@@ -236,7 +242,7 @@ UTEST(ServerNetConnection, RemoteClosed) {
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      std::move(peer), handler, stats, data_accounter);
+      std::move(peer), handler, stats, MakeBufferPool(config), data_accounter);
 
   connection_ptr->Start();
   std::weak_ptr<net::Connection> weak = connection_ptr;
@@ -269,7 +275,7 @@ UTEST(ServerNetConnection, KeepAlive) {
 
   auto connection_ptr = net::Connection::Create(
       engine::current_task::GetTaskProcessor(), config.connection_config,
-      std::move(peer), handler, stats, data_accounter);
+      std::move(peer), handler, stats, MakeBufferPool(config), data_accounter);
 
   connection_ptr->Start();
   EXPECT_EQ(request.Get()->status_code(), 404);
@@ -301,7 +307,8 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
 
     auto connection_ptr = net::Connection::Create(
         engine::current_task::GetTaskProcessor(), config.connection_config,
-        std::move(peer), handler, stats, data_accounter);
+        std::move(peer), handler, stats, MakeBufferPool(config),
+        data_accounter);
 
     connection_ptr->Start();
     res.Wait();
@@ -21,6 +21,13 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
+namespace {
+
+// Receive buffers are held only while parsing, so a few of them are enough
+// to serve lots of connections
+constexpr size_t kMaxIdleReceiveBuffers = 256;
+
+}  // namespace
 
 ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
                            std::shared_ptr<EndpointInfo> endpoint_info,
@@ -28,6 +35,9 @@ ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
     : task_processor_(task_processor),
       endpoint_info_(std::move(endpoint_info)),
       stats_(std::make_shared<Stats>()),
+      buffer_pool_(std::make_shared<BufferPool>(
+          endpoint_info_->listener_config.connection_config.in_buffer_size,
+          kMaxIdleReceiveBuffers)),
       data_accounter_(data_accounter),
       socket_listener_task_(engine::CriticalAsyncNoSpan(
           task_processor_,
@@ -92,7 +102,7 @@ void ListenerImpl::SetupConnection(engine::io::Socket peer_socket) {
   auto connection_ptr = Connection::Create(
       task_processor_, endpoint_info_->listener_config.connection_config,
       std::move(peer_socket), endpoint_info_->request_handler, stats_,
-      data_accounter_);
+      buffer_pool_, data_accounter_);
   connection_ptr->SetCloseCb([endpoint_info = endpoint_info_]() {
     --endpoint_info->connection_count;
   });
@@ -9,6 +9,7 @@
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 
+#include "buffer_pool.hpp"
 #include "connection.hpp"
 #include "endpoint_info.hpp"
 #include "stats.hpp"
@@ -41,6 +42,7 @@ class ListenerImpl final {
   std::shared_ptr<EndpointInfo> endpoint_info_;
 
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<BufferPool> buffer_pool_;
   request::ResponseDataAccounter& data_accounter_;
 
   engine::TaskWithResult<void> socket_listener_task_;
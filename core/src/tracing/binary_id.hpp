@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/utils/encoding/hex.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+// Trace or span id of `Size` bytes.
+//
+// Generated ids and the received ids in lowercase hex of the native length
+// are stored in binary, the hex string is formatted on the first request and
+// cached. Ids of other formats from other systems are kept as is.
+//
+// Spans that never log their ids (e.g. unsampled spans without logs inside)
+// do not allocate for the ids at all.
+template <std::size_t Size>
+class BinaryId final {
+ public:
+  using Bytes = std::array<std::uint8_t, Size>;
+
+  static_assert(Size % sizeof(std::uint64_t) == 0);
+
+  BinaryId() = default;
+
+  // The cached string of a binary id is not copied, the copy formats it anew
+  // if needed
+  BinaryId(const BinaryId& other)
+      : bytes_(other.bytes_), is_binary_(other.is_binary_) {
+    if (!is_binary_) string_ = other.string_;
+  }
+
+  BinaryId(BinaryId&&) noexcept = default;
+
+  BinaryId& operator=(const BinaryId& other) {
+    if (this == &other) return *this;
+    bytes_ = other.bytes_;
+    is_binary_ = other.is_binary_;
+    string_.clear();
+    if (!is_binary_) string_ = other.string_;
+    return *this;
+  }
+
+  BinaryId& operator=(BinaryId&&) noexcept = default;
+
+  static BinaryId Generate() {
+    std::uniform_int_distribution<std::uint64_t> dist;
+    BinaryId result;
+    for (std::size_t offset = 0; offset < Size; offset += 8) {
+      const auto value = dist(utils::DefaultRandom());
+      for (std::size_t i = 0; i < 8; ++i) {
+        result.bytes_[offset + i] =
+            static_cast<std::uint8_t>(value >> (8 * (7 - i)));
+      }
+    }
+    result.is_binary_ = true;
+    return result;
+  }
+
+  static BinaryId FromString(std::string&& id) {
+    BinaryId result;
+    if (id.size() == 2 * Size && ParseHex(id, result.bytes_)) {
+      result.is_binary_ = true;
+    } else {
+      result.string_ = std::move(id);
+    }
+    return result;
+  }
+
+  bool IsEmpty() const noexcept { return !is_binary_ && string_.empty(); }
+
+  bool IsBinary() const noexcept { return is_binary_; }
+
+  // Must only be called for the binary ids
+  const Bytes& GetBytes() const noexcept { return bytes_; }
+
+  // Formats the binary id on the first call. Not thread-safe for the binary
+  // ids, as the span the id belongs to.
+  const std::string& ToString() const {
+    if (is_binary_ && string_.empty()) {
+      string_.reserve(2 * Size);
+      utils::encoding::ToHex(
+          std::string_view{reinterpret_cast<const char*>(bytes_.data()), Size},
+          string_);
+    }
+    return string_;
+  }
+
+  std::string Release() && {
+    ToString();
+    return std::move(string_);
+  }
+
+  // Leading 8 bytes of the binary id as a big-endian number, hash of the
+  // string for the other ids
+  std::uint64_t GetPrefixHash() const noexcept {
+    if (!is_binary_) return std::hash<std::string_view>{}(string_);
+
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < 8; ++i) result = (result << 8) | bytes_[i];
+    return result;
+  }
+
+ private:
+  static bool ParseHex(std::string_view hex, Bytes& out) noexcept {
+    const auto digit = [](char c) -> int {
+      if (c >= '0' && c <= '9') return c - '0';
+      // uppercase digits would not survive the round-trip
+      if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+      return -1;
+    };
+    for (std::size_t i = 0; i < Size; ++i) {
+      const auto high = digit(hex[2 * i]);
+      const auto low = digit(hex[2 * i + 1]);
+      if (high < 0 || low < 0) return false;
+      out[i] = static_cast<std::uint8_t>((high << 4) | low);
+    }
+    return true;
+  }
+
+  Bytes bytes_{};
+  bool is_binary_{false};
+  // the string id for non-binary ids, cache of the hex for the binary ones
+  mutable std::string string_;
+};
+
+using TraceId = BinaryId<16>;
+using SpanId = BinaryId<8>;
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,65 @@
+#include <tracing/sampling.hpp>
+
+#include <limits>
+#include <stdexcept>
+
+#include <userver/formats/json/value.hpp>
+#include <userver/rcu/rcu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+namespace {
+
+auto& GlobalSamplingConfig() {
+  static rcu::Variable<SamplingConfig> config{};
+  return config;
+}
+
+}  // namespace
+
+SamplingConfig Parse(const formats::json::Value& value,
+                     formats::parse::To<SamplingConfig>) {
+  SamplingConfig result;
+  result.head_probability = value["head-probability"].As<double>(1.0);
+  if (result.head_probability < 0.0 || result.head_probability > 1.0) {
+    throw std::runtime_error(
+        "'head-probability' of USERVER_TRACING_SAMPLING must be in [0, 1]");
+  }
+  result.tail_min_duration =
+      std::chrono::milliseconds{value["tail-min-duration-ms"].As<int>(0)};
+  result.tail_errors = value["tail-errors"].As<bool>(true);
+  return result;
+}
+
+namespace impl {
+
+void SetSamplingConfig(SamplingConfig&& config) {
+  GlobalSamplingConfig().Assign(std::move(config));
+}
+
+bool IsTraceSampled(std::uint64_t trace_id_hash) {
+  const auto config = GlobalSamplingConfig().Read();
+  const auto probability = config->head_probability;
+  if (probability >= 1.0) return true;
+
+  // 2^64, the number of possible hashes
+  constexpr double kHashCount =
+      static_cast<double>(std::numeric_limits<std::uint64_t>::max()) + 1.0;
+  return static_cast<double>(trace_id_hash) < probability * kHashCount;
+}
+
+bool IsSpanTailSampled(std::chrono::steady_clock::duration duration,
+                       bool has_error) {
+  const auto config = GlobalSamplingConfig().Read();
+  if (has_error && config->tail_errors) return true;
+  return config->tail_min_duration.count() > 0 &&
+         duration >= config->tail_min_duration;
+}
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
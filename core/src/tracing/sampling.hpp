@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <userver/formats/parse/to.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+class Value;
+}
+
+namespace tracing {
+
+/// Sampling of the finished spans, see @ref USERVER_TRACING_SAMPLING
+struct SamplingConfig {
+  // Probability to write the spans of a trace, decided once per trace
+  double head_probability{1.0};
+  // Unsampled spans that took at least that long are written, 0 to disable
+  std::chrono::milliseconds tail_min_duration{0};
+  // Unsampled spans with the tracing::kErrorFlag tag are written
+  bool tail_errors{true};
+};
+
+SamplingConfig Parse(const formats::json::Value& value,
+                     formats::parse::To<SamplingConfig>);
+
+namespace impl {
+
+void SetSamplingConfig(SamplingConfig&& config);
+
+// Head sampling decision for the root span of a trace. The decision depends
+// only on the trace id, so the services of a trace agree on it.
+bool IsTraceSampled(std::uint64_t trace_id_hash);
+
+// Tail sampling decision for a span of an unsampled trace
+bool IsSpanTailSampled(std::chrono::steady_clock::duration duration,
+                       bool has_error);
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -1,17 +1,17 @@
 #include <tracing/span_impl.hpp>
 
-#include <random>
 #include <type_traits>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
+#include <tracing/sampling.hpp>
+#include <tracing/span_exporter.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/rand.hpp>
 #include <userver/utils/uuid4.hpp>
 #include <utils/internal_tag.hpp>
 
@@ -65,12 +65,6 @@ engine::TaskLocalVariable<boost::intrusive::list<
     Span::Impl, boost::intrusive::constant_time_size<false>>>
     task_local_spans;
 
-std::string GenerateSpanId() {
-  std::uniform_int_distribution<std::uint64_t> dist;
-  auto random_value = dist(utils::DefaultRandom());
-  return fmt::format(FMT_COMPILE("{:016x}"), random_value);
-}
-
 logging::LogHelper& operator<<(logging::LogHelper& lh,
                                tracing::Span::Impl&& span_impl) {
   std::move(span_impl).LogTo(lh);
@@ -99,11 +93,12 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
       tracer_(std::move(tracer)),
       start_system_time_(std::chrono::system_clock::now()),
       start_steady_time_(std::chrono::steady_clock::now()),
-      trace_id_(parent ? parent->GetTraceId()
-                       : utils::generators::GenerateUuid()),
-      span_id_(GenerateSpanId()),
+      trace_id_(parent ? parent->trace_id_ : impl::TraceId::Generate()),
+      span_id_(impl::SpanId::Generate()),
       parent_id_(GetParentIdForLogging(parent)),
-      reference_type_(reference_type) {
+      reference_type_(reference_type),
+      is_sampled_(parent ? parent->is_sampled_
+                         : impl::IsTraceSampled(trace_id_.GetPrefixHash())) {
   if (parent) {
     log_extra_inheritable_ = parent->log_extra_inheritable_;
     local_log_level_ = parent->local_log_level_;
@@ -117,6 +112,19 @@ Span::Impl::~Impl() {
 
   const auto steady_now = std::chrono::steady_clock::now();
   const auto duration = steady_now - start_steady_time_;
+
+  const bool is_tail_sampled =
+      !is_sampled_ && impl::IsSpanTailSampled(duration, HasErrorTag());
+  if (!is_sampled_ && !is_tail_sampled) {
+    return;
+  }
+
+  if (auto exporter = impl::GetSpanExporter()) {
+    LogOpenTracing();
+    Export(*exporter, duration, is_tail_sampled);
+    return;
+  }
+
   const auto total_time_ms =
       std::chrono::duration_cast<RealMilliseconds>(duration).count();
 
@@ -142,6 +150,13 @@ Span::Impl::~Impl() {
       << std::move(result) << std::move(*this);
 }
 
+void Span::Impl::SetTraceId(std::string&& id) {
+  trace_id_ = impl::TraceId::FromString(std::move(id));
+  // the sampling of a received trace is decided by its id, as in the other
+  // services of the trace
+  is_sampled_ = impl::IsTraceSampled(trace_id_.GetPrefixHash());
+}
+
 void Span::Impl::LogTo(logging::LogHelper& log_helper) const& {
   log_helper << log_extra_inheritable_;
   tracer_->LogSpanContextTo(*this, log_helper);
@@ -159,11 +174,11 @@ void Span::Impl::AttachToCoroStack() {
   task_local_spans->push_back(*this);
 }
 
-std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
+impl::SpanId Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   if (!parent) return {};
 
   if (!parent->is_linked()) {
-    return parent->GetSpanId();
+    return parent->span_id_;
   }
 
   const auto* spans_ptr = task_local_spans.GetOptional();
@@ -176,9 +191,9 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   // orphaned. It's still possible for chaining to break in case parent span
   // becomes non-loggable after child span is created, but that we can't control
   for (auto current = spans_ptr->iterator_to(*parent);; --current) {
-    if (current->GetParentId().empty() /* won't find better candidate */ ||
+    if (current->parent_id_.IsEmpty() /* won't find better candidate */ ||
         current->ShouldLog()) {
-      return current->GetSpanId();
+      return current->span_id_;
     }
     if (current == spans_ptr->begin()) break;
   };
@@ -231,7 +246,7 @@ Span::Span(std::string name, ReferenceType reference_type,
                           GetParentSpanImpl(), reference_type, log_level),
              Span::OptionalDeleter{OptionalDeleter::ShouldDelete()}) {
   AttachToCoroStack();
-  if (pimpl_->GetParentId().empty()) {
+  if (pimpl_->parent_id_.IsEmpty()) {
     SetLink(utils::generators::GenerateUuid());
   }
   pimpl_->span_ = this;
@@ -0,0 +1,160 @@
+#include "span_impl.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <variant>
+
+#include <boost/container/small_vector.hpp>
+
+#include <tracing/span_exporter.hpp>
+#include <userver/tracing/tags.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+namespace {
+
+using RealMilliseconds = std::chrono::duration<double, std::milli>;
+
+const std::string kTimerSuffix = "_time";
+
+template <std::size_t Size>
+void AppendId(std::string& out, const impl::BinaryId<Size>& id) {
+  using impl::span_record::IdKind;
+  if (id.IsEmpty()) {
+    impl::span_record::AppendNumber(out, IdKind::kEmpty);
+  } else if (id.IsBinary()) {
+    impl::span_record::AppendNumber(out, IdKind::kBinary);
+    impl::span_record::AppendNumber(out, static_cast<std::uint8_t>(Size));
+    const auto& bytes = id.GetBytes();
+    out.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  } else {
+    const std::string_view value = id.ToString().substr(
+        0, std::numeric_limits<std::uint8_t>::max());
+    impl::span_record::AppendNumber(out, IdKind::kString);
+    impl::span_record::AppendNumber(out,
+                                    static_cast<std::uint8_t>(value.size()));
+    out.append(value);
+  }
+}
+
+void AppendTagValue(std::string& out, const logging::LogExtra::Value& value) {
+  using impl::span_record::AppendNumber;
+  using impl::span_record::TagType;
+  std::visit(
+      [&out](const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          AppendNumber(out, TagType::kString);
+          impl::span_record::AppendString(out, value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+          AppendNumber(out, TagType::kDouble);
+          AppendNumber(out, static_cast<double>(value));
+        } else if constexpr (std::is_signed_v<T>) {
+          AppendNumber(out, TagType::kInt);
+          AppendNumber(out, static_cast<std::int64_t>(value));
+        } else {
+          AppendNumber(out, TagType::kUint);
+          AppendNumber(out, static_cast<std::uint64_t>(value));
+        }
+      },
+      value);
+}
+
+}  // namespace
+
+bool Span::Impl::HasErrorTag() const {
+  const auto is_set = [](const logging::LogExtra& log_extra) {
+    const auto* value = log_extra.Find(kErrorFlag);
+    if (!value) return false;
+    return std::visit(
+        [](const auto& value) {
+          if constexpr (std::is_same_v<std::decay_t<decltype(value)>,
+                                       std::string>) {
+            return false;
+          } else {
+            return value != 0;
+          }
+        },
+        value->second.GetValue());
+  };
+  return is_set(log_extra_inheritable_) ||
+         (log_extra_local_ && is_set(*log_extra_local_));
+}
+
+void Span::Impl::Export(impl::SpanExporter& exporter,
+                        std::chrono::steady_clock::duration duration,
+                        bool is_tail_sampled) const {
+  using impl::span_record::AppendNumber;
+  using impl::span_record::AppendString;
+
+  // reused by all the spans of the thread
+  thread_local std::string record;
+  record.clear();
+
+  // the size is written after the record is built
+  AppendNumber(record, std::uint32_t{0});
+  AppendNumber(record, impl::span_record::kVersion);
+  std::uint8_t flags = 0;
+  if (is_tail_sampled) flags |= impl::span_record::kTailSampled;
+  if (reference_type_ == ReferenceType::kReference) {
+    flags |= impl::span_record::kFollowsFrom;
+  }
+  AppendNumber(record, flags);
+
+  AppendId(record, trace_id_);
+  AppendId(record, span_id_);
+  AppendId(record, parent_id_);
+
+  AppendNumber(record,
+               static_cast<std::int64_t>(
+                   std::chrono::duration_cast<std::chrono::microseconds>(
+                       start_system_time_.time_since_epoch())
+                       .count()));
+  AppendNumber(record,
+               static_cast<std::int64_t>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       duration)
+                       .count()));
+  AppendString(record, name_);
+  AppendString(record, tracer_ ? tracer_->GetServiceName() : std::string{});
+
+  const auto& time_storage = time_storage_.GetAll();
+  std::size_t tags_count = log_extra_inheritable_.extra_->size() +
+                           time_storage.size() +
+                           (log_extra_local_ ? log_extra_local_->extra_->size()
+                                             : 0);
+  tags_count = std::min<std::size_t>(tags_count,
+                                     std::numeric_limits<std::uint16_t>::max());
+  AppendNumber(record, static_cast<std::uint16_t>(tags_count));
+
+  const auto append_tags = [&](const logging::LogExtra& log_extra) {
+    for (const auto& [key, value] : *log_extra.extra_) {
+      if (tags_count == 0) return;
+      --tags_count;
+      AppendString(record, key);
+      AppendTagValue(record, value.GetValue());
+    }
+  };
+  append_tags(log_extra_inheritable_);
+  if (log_extra_local_) append_tags(*log_extra_local_);
+  for (const auto& [key, value] : time_storage) {
+    if (tags_count == 0) break;
+    --tags_count;
+    AppendString(record, key + kTimerSuffix);
+    AppendNumber(record, impl::span_record::TagType::kDouble);
+    AppendNumber(record,
+                 std::chrono::duration_cast<RealMilliseconds>(value).count());
+  }
+
+  impl::span_record::StoreNumber(
+      record.data(), static_cast<std::uint32_t>(record.size() - 4));
+
+  exporter.Write(record);
+}
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,164 @@
+#include <tracing/span_exporter.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/encoding/hex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+auto& GlobalSpanExporter() {
+  static rcu::Variable<SpanExporterPtr> exporter;
+  return exporter;
+}
+
+logging::LoggerConfig MakeSinkConfig(const SpanExporterConfig& config) {
+  if (config.thread_buffer_size == 0 ||
+      (config.thread_buffer_size & (config.thread_buffer_size - 1))) {
+    throw std::runtime_error("span thread buffer size must be a power of 2");
+  }
+
+  logging::LoggerConfig result;
+  result.file_path = config.file_path;
+  result.thread_buffer_size = config.thread_buffer_size;
+  result.queue_overflow_behavior =
+      logging::LoggerConfig::QueueOveflowBehavior::kDiscard;
+  return result;
+}
+
+class RecordReader final {
+ public:
+  explicit RecordReader(std::string_view data) : data_(data) {}
+
+  bool IsEmpty() const noexcept { return data_.empty(); }
+
+  template <typename T>
+  T ReadNumber() {
+    const auto bytes = ReadBytes(sizeof(T));
+    char buffer[sizeof(T)];
+    std::copy(bytes.begin(), bytes.end(), buffer);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    std::reverse(std::begin(buffer), std::end(buffer));
+#endif
+    T result;
+    std::memcpy(&result, buffer, sizeof(T));
+    return result;
+  }
+
+  std::string_view ReadBytes(std::size_t size) {
+    if (data_.size() < size) {
+      throw std::runtime_error("Truncated span record");
+    }
+    const auto result = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return result;
+  }
+
+  std::string ReadString() {
+    return std::string{ReadBytes(ReadNumber<std::uint16_t>())};
+  }
+
+  std::string ReadId() {
+    using span_record::IdKind;
+    switch (static_cast<IdKind>(ReadNumber<std::uint8_t>())) {
+      case IdKind::kEmpty:
+        return {};
+      case IdKind::kBinary:
+        return utils::encoding::ToHex(ReadBytes(ReadNumber<std::uint8_t>()));
+      case IdKind::kString:
+        return std::string{ReadBytes(ReadNumber<std::uint8_t>())};
+    }
+    throw std::runtime_error("Unknown id kind in span record");
+  }
+
+  ExportedSpan::TagValue ReadTagValue() {
+    using span_record::TagType;
+    switch (static_cast<TagType>(ReadNumber<std::uint8_t>())) {
+      case TagType::kString:
+        return ReadString();
+      case TagType::kInt:
+        return ReadNumber<std::int64_t>();
+      case TagType::kUint:
+        return ReadNumber<std::uint64_t>();
+      case TagType::kDouble:
+        return ReadNumber<double>();
+    }
+    throw std::runtime_error("Unknown tag type in span record");
+  }
+
+ private:
+  std::string_view data_;
+};
+
+ExportedSpan ParseRecord(RecordReader& reader) {
+  if (reader.ReadNumber<std::uint8_t>() != span_record::kVersion) {
+    throw std::runtime_error("Unknown span record version");
+  }
+  const auto flags = reader.ReadNumber<std::uint8_t>();
+
+  ExportedSpan span;
+  span.is_tail_sampled = flags & span_record::kTailSampled;
+  span.reference_type = (flags & span_record::kFollowsFrom)
+                            ? ReferenceType::kReference
+                            : ReferenceType::kChild;
+  span.trace_id = reader.ReadId();
+  span.span_id = reader.ReadId();
+  span.parent_id = reader.ReadId();
+  span.start_time = std::chrono::system_clock::time_point{
+      std::chrono::microseconds{reader.ReadNumber<std::int64_t>()}};
+  span.duration = std::chrono::nanoseconds{reader.ReadNumber<std::int64_t>()};
+  span.name = reader.ReadString();
+  span.service_name = reader.ReadString();
+
+  const auto tags_count = reader.ReadNumber<std::uint16_t>();
+  span.tags.reserve(tags_count);
+  for (std::uint16_t i = 0; i < tags_count; ++i) {
+    auto key = reader.ReadString();
+    span.tags.emplace_back(std::move(key), reader.ReadTagValue());
+  }
+
+  if (!reader.IsEmpty()) {
+    throw std::runtime_error("Trailing data in span record");
+  }
+  return span;
+}
+
+}  // namespace
+
+void span_record::AppendString(std::string& out, std::string_view value) {
+  const auto size = std::min<std::size_t>(
+      value.size(), std::numeric_limits<std::uint16_t>::max());
+  AppendNumber(out, static_cast<std::uint16_t>(size));
+  out.append(value.data(), size);
+}
+
+std::vector<ExportedSpan> ParseExportedSpans(std::string_view data) {
+  std::vector<ExportedSpan> result;
+  RecordReader reader{data};
+  while (!reader.IsEmpty()) {
+    const auto size = reader.ReadNumber<std::uint32_t>();
+    RecordReader record_reader{reader.ReadBytes(size)};
+    result.push_back(ParseRecord(record_reader));
+  }
+  return result;
+}
+
+SpanExporter::SpanExporter(const SpanExporterConfig& config)
+    : sink_("spans", MakeSinkConfig(config)) {}
+
+SpanExporterPtr GetSpanExporter() { return GlobalSpanExporter().ReadCopy(); }
+
+void SetSpanExporter(SpanExporterPtr exporter) {
+  GlobalSpanExporter().Assign(std::move(exporter));
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
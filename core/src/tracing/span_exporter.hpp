@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <logging/async_file_sink.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+// Binary format of the exported spans. All the numbers are little-endian.
+//
+// record:  u32 size of the rest of the record
+//          u8  version, kSpanRecordVersion
+//          u8  flags, SpanRecordFlags
+//          id  trace id, id span id, id parent id
+//          i64 start time in microseconds since epoch
+//          i64 duration in nanoseconds
+//          str name, str service name
+//          u16 tags count, tag...
+// id:      u8 IdKind, then u8 size and the bytes for kBinary and kString
+// str:     u16 size and the bytes, longer strings are truncated
+// tag:     str key, u8 TagType, value: str for kString, i64 for kInt,
+//          u64 for kUint, IEEE 754 double for kDouble
+namespace span_record {
+
+inline constexpr std::uint8_t kVersion = 1;
+
+enum Flags : std::uint8_t {
+  kTailSampled = 1 << 0,
+  kFollowsFrom = 1 << 1,
+};
+
+enum class IdKind : std::uint8_t { kEmpty, kBinary, kString };
+
+enum class TagType : std::uint8_t { kString, kInt, kUint, kDouble };
+
+template <typename T>
+void StoreNumber(char* out, T value) noexcept {
+  static_assert(std::is_trivially_copyable_v<T>);
+  std::memcpy(out, &value, sizeof(T));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  std::reverse(out, out + sizeof(T));
+#endif
+}
+
+template <typename T>
+void AppendNumber(std::string& out, T value) {
+  char bytes[sizeof(T)];
+  StoreNumber(bytes, value);
+  out.append(bytes, sizeof(T));
+}
+
+void AppendString(std::string& out, std::string_view value);
+
+}  // namespace span_record
+
+// A span decoded from the binary format, used by tools and tests
+struct ExportedSpan {
+  using TagValue =
+      std::variant<std::string, std::int64_t, std::uint64_t, double>;
+
+  std::string trace_id;
+  std::string span_id;
+  std::string parent_id;
+  std::string name;
+  std::string service_name;
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::nanoseconds duration{0};
+  ReferenceType reference_type{ReferenceType::kChild};
+  bool is_tail_sampled{false};
+  std::vector<std::pair<std::string, TagValue>> tags;
+};
+
+// @throws std::runtime_error on malformed data
+std::vector<ExportedSpan> ParseExportedSpans(std::string_view data);
+
+struct SpanExporterConfig {
+  std::string file_path;
+  std::size_t thread_buffer_size{
+      logging::LoggerConfig::kDefaultThreadBufferSize};
+};
+
+// Writes the finished spans in the binary format in the background.
+//
+// The records are appended to a per-thread buffer without locks, a background
+// thread writes the buffers of all the threads to the file in batches. The
+// records are dropped if the buffer of a thread is full.
+class SpanExporter final {
+ public:
+  // @throws std::runtime_error if the file can not be opened or the buffer
+  // size is not a power of 2
+  explicit SpanExporter(const SpanExporterConfig& config);
+
+  void Write(std::string_view record) { sink_.Write(record); }
+
+  // Wakes up the background thread, does not wait for the write
+  void Flush() { sink_.flush(); }
+
+  // @throws std::runtime_error if the file can not be opened
+  void Reopen() { sink_.Reopen(false); }
+
+  logging::impl::AsyncFileSinkStatistics GetStatistics() const {
+    return sink_.GetStatistics();
+  }
+
+ private:
+  logging::impl::AsyncFileSink sink_;
+};
+
+using SpanExporterPtr = std::shared_ptr<SpanExporter>;
+
+// Finished spans are exported instead of being written to the default logger
+// while the exporter is set
+SpanExporterPtr GetSpanExporter();
+void SetSpanExporter(SpanExporterPtr exporter);
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
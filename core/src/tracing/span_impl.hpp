@@ -16,6 +16,7 @@
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tracer.hpp>
 
+#include <tracing/binary_id.hpp>
 #include <tracing/time_storage.hpp>
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
@@ -32,6 +33,10 @@ class ValueBuilder;
 
 namespace tracing {
 
+namespace impl {
+class SpanExporter;
+}  // namespace impl
+
 class Span::Impl
     : public boost::intrusive::list_base_hook<
           boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
@@ -54,16 +59,18 @@ class Span::Impl
 
   void LogTo(logging::LogHelper& log_helper) &&;
 
-  const std::string& GetTraceId() const& noexcept { return trace_id_; }
-  const std::string& GetSpanId() const& noexcept { return span_id_; }
-  const std::string& GetParentId() const& noexcept { return parent_id_; }
+  const std::string& GetTraceId() const& { return trace_id_.ToString(); }
+  const std::string& GetSpanId() const& { return span_id_.ToString(); }
+  const std::string& GetParentId() const& { return parent_id_.ToString(); }
 
-  std::string GetTraceId() && noexcept { return std::move(trace_id_); }
-  std::string GetSpanId() && noexcept { return std::move(span_id_); }
-  std::string GetParentId() && noexcept { return std::move(parent_id_); }
+  std::string GetTraceId() && { return std::move(trace_id_).Release(); }
+  std::string GetSpanId() && { return std::move(span_id_).Release(); }
+  std::string GetParentId() && { return std::move(parent_id_).Release(); }
 
-  void SetTraceId(std::string&& id) noexcept { trace_id_ = std::move(id); }
-  void SetParentId(std::string&& id) noexcept { parent_id_ = std::move(id); }
+  void SetTraceId(std::string&& id);
+  void SetParentId(std::string&& id) {
+    parent_id_ = impl::SpanId::FromString(std::move(id));
+  }
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
@@ -72,10 +79,14 @@ class Span::Impl
 
  private:
   void LogOpenTracing() const;
+  void Export(impl::SpanExporter& exporter,
+              std::chrono::steady_clock::duration duration,
+              bool is_tail_sampled) const;
+  bool HasErrorTag() const;
   static void AddOpentracingTags(formats::json::ValueBuilder& output,
                                  const logging::LogExtra& input);
 
-  static std::string GetParentIdForLogging(const Span::Impl* parent);
+  static impl::SpanId GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
 
   const std::string name_;
@@ -94,10 +105,12 @@ class Span::Impl
   const std::chrono::system_clock::time_point start_system_time_;
   const std::chrono::steady_clock::time_point start_steady_time_;
 
-  std::string trace_id_;
-  std::string span_id_;
-  std::string parent_id_;
+  impl::TraceId trace_id_;
+  impl::SpanId span_id_;
+  impl::SpanId parent_id_;
   const ReferenceType reference_type_;
+  // head sampling decision of the trace, see tracing::SamplingConfig
+  bool is_sampled_;
 
   friend class Span;
 };
@@ -86,9 +86,9 @@ void Span::Impl::LogOpenTracing() const {
   if (tracer_) {
     jaeger_span.Extend(jaeger::kServiceName, tracer_->GetServiceName());
   }
-  jaeger_span.Extend(jaeger::kTraceId, trace_id_);
-  jaeger_span.Extend(jaeger::kParentId, parent_id_);
-  jaeger_span.Extend(jaeger::kSpanId, span_id_);
+  jaeger_span.Extend(jaeger::kTraceId, trace_id_.ToString());
+  jaeger_span.Extend(jaeger::kParentId, parent_id_.ToString());
+  jaeger_span.Extend(jaeger::kSpanId, span_id_.ToString());
   jaeger_span.Extend(jaeger::kStartTime, start_time);
   jaeger_span.Extend(jaeger::kStartTimeMillis, start_time / 1000);
   jaeger_span.Extend(jaeger::kDuration, duration_microseconds);
@@ -3,11 +3,16 @@
 
 #include <logging/logging_test.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/sampling.hpp>
+#include <tracing/span_exporter.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -644,4 +649,169 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
   }
 }
 
+UTEST_F(Span, BinaryIds) {
+  tracing::Span root_span("root_span");
+  EXPECT_EQ(root_span.GetTraceId().size(), 32);
+  EXPECT_EQ(root_span.GetSpanId().size(), 16);
+  EXPECT_TRUE(root_span.GetParentId().empty());
+
+  tracing::Span child_span("child_span");
+  EXPECT_EQ(child_span.GetTraceId(), root_span.GetTraceId());
+  EXPECT_EQ(child_span.GetParentId(), root_span.GetSpanId());
+  EXPECT_NE(child_span.GetSpanId(), root_span.GetSpanId());
+
+  // hex ids of the native length are stored in binary and keep their value
+  const std::string trace_id = "0123456789abcdef0123456789abcdef";
+  const std::string parent_id = "fedcba9876543210";
+  auto span = tracing::Span::MakeSpan("span", trace_id, parent_id);
+  EXPECT_EQ(span.GetTraceId(), trace_id);
+  EXPECT_EQ(span.GetParentId(), parent_id);
+
+  // uppercase hex does not survive the conversion to binary
+  const std::string upper_trace_id = "0123456789ABCDEF0123456789ABCDEF";
+  auto upper_span = tracing::Span::MakeSpan("span", upper_trace_id, {});
+  EXPECT_EQ(upper_span.GetTraceId(), upper_trace_id);
+}
+
+class SampledSpan : public Span {
+ protected:
+  // head sampling is decided by the leading bytes of the trace id
+  static constexpr std::string_view kSampledTraceId =
+      "00000000000000000000000000000000";
+  static constexpr std::string_view kUnsampledTraceId =
+      "ffffffffffffffffffffffffffffffff";
+
+  void TearDown() override {
+    tracing::impl::SetSamplingConfig(tracing::SamplingConfig{});
+    Span::TearDown();
+  }
+
+  static void SetSampling(double head_probability,
+                          std::chrono::milliseconds tail_min_duration,
+                          bool tail_errors) {
+    tracing::SamplingConfig config;
+    config.head_probability = head_probability;
+    config.tail_min_duration = tail_min_duration;
+    config.tail_errors = tail_errors;
+    tracing::impl::SetSamplingConfig(std::move(config));
+  }
+};
+
+UTEST_F(SampledSpan, Head) {
+  SetSampling(0.5, std::chrono::milliseconds{0}, false);
+  {
+    auto sampled = tracing::Span::MakeSpan("sampled_span", kSampledTraceId, {});
+    auto child = sampled.CreateChild("sampled_child");
+  }
+  {
+    auto unsampled =
+        tracing::Span::MakeSpan("unsampled_span", kUnsampledTraceId, {});
+    auto child = unsampled.CreateChild("unsampled_child");
+    LOG_INFO() << "inside unsampled";
+  }
+  logging::LogFlush();
+
+  const auto logs = sstream.str();
+  EXPECT_NE(logs.find("stopwatch_name=sampled_span"), std::string::npos);
+  EXPECT_NE(logs.find("stopwatch_name=sampled_child"), std::string::npos);
+  EXPECT_EQ(logs.find("stopwatch_name=unsampled_span"), std::string::npos);
+  EXPECT_EQ(logs.find("stopwatch_name=unsampled_child"), std::string::npos);
+
+  // the logs inside unsampled spans keep the ids
+  EXPECT_NE(logs.find(fmt::format("trace_id={}", kUnsampledTraceId)),
+            std::string::npos);
+}
+
+UTEST_F(SampledSpan, TailErrors) {
+  SetSampling(0.0, std::chrono::milliseconds{0}, true);
+  {
+    tracing::Span ok_span("ok_span");
+  }
+  {
+    tracing::Span span("failed_span");
+    span.AddTag(tracing::kErrorFlag, true);
+  }
+  logging::LogFlush();
+
+  EXPECT_NE(sstream.str().find("stopwatch_name=failed_span"),
+            std::string::npos);
+  EXPECT_EQ(sstream.str().find("stopwatch_name=ok_span"), std::string::npos);
+}
+
+UTEST_F(SampledSpan, TailDuration) {
+  SetSampling(0.0, std::chrono::milliseconds{10}, false);
+  {
+    tracing::Span slow_span("slow_span");
+    {
+      tracing::Span fast_span("fast_span");
+    }
+    engine::SleepFor(std::chrono::milliseconds{20});
+  }
+  logging::LogFlush();
+
+  EXPECT_NE(sstream.str().find("stopwatch_name=slow_span"), std::string::npos);
+  EXPECT_EQ(sstream.str().find("stopwatch_name=fast_span"), std::string::npos);
+}
+
+UTEST_F(Span, Export) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/spans.bin";
+
+  std::string trace_id;
+  std::string root_span_id;
+  {
+    auto exporter = std::make_shared<tracing::impl::SpanExporter>(
+        tracing::impl::SpanExporterConfig{path});
+    tracing::impl::SetSpanExporter(exporter);
+    {
+      tracing::Span root_span("root_span");
+      root_span.AddTag("tag", "value");
+      root_span.AddNonInheritableTag("number", 42);
+      trace_id = root_span.GetTraceId();
+      root_span_id = root_span.GetSpanId();
+
+      auto follower = root_span.CreateFollower("follower_span");
+      follower.AddTag("ratio", 0.5);
+    }
+    tracing::impl::SetSpanExporter({});
+  }
+  logging::LogFlush();
+
+  // the spans are not logged while exported
+  EXPECT_EQ(sstream.str().find("stopwatch_name="), std::string::npos);
+
+  const auto spans = tracing::impl::ParseExportedSpans(
+      fs::blocking::ReadFileContents(path));
+  ASSERT_EQ(spans.size(), 2);
+
+  const auto& follower = spans[0];
+  EXPECT_EQ(follower.name, "follower_span");
+  EXPECT_EQ(follower.trace_id, trace_id);
+  EXPECT_EQ(follower.parent_id, root_span_id);
+  EXPECT_EQ(follower.reference_type, tracing::ReferenceType::kReference);
+
+  const auto& root = spans[1];
+  EXPECT_EQ(root.name, "root_span");
+  EXPECT_EQ(root.trace_id, trace_id);
+  EXPECT_EQ(root.span_id, root_span_id);
+  EXPECT_TRUE(root.parent_id.empty());
+  EXPECT_EQ(root.reference_type, tracing::ReferenceType::kChild);
+  EXPECT_FALSE(root.is_tail_sampled);
+  EXPECT_GT(root.duration.count(), 0);
+
+  using TagValue = tracing::impl::ExportedSpan::TagValue;
+  const auto has_tag = [](const tracing::impl::ExportedSpan& span,
+                          const std::string& key, const TagValue& value) {
+    for (const auto& tag : span.tags) {
+      if (tag.first == key) return tag.second == value;
+    }
+    return false;
+  };
+  EXPECT_TRUE(has_tag(root, "tag", TagValue{std::string{"value"}}));
+  EXPECT_TRUE(has_tag(root, "number", TagValue{std::int64_t{42}}));
+  EXPECT_TRUE(has_tag(follower, "tag", TagValue{std::string{"value"}}));
+  EXPECT_TRUE(has_tag(follower, "ratio", TagValue{0.5}));
+  EXPECT_FALSE(has_tag(follower, "number", TagValue{std::int64_t{42}}));
+}
+
 USERVER_NAMESPACE_END
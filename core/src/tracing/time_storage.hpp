@@ -28,6 +28,11 @@ class TimeStorage {
 
   void MergeInto(logging::LogExtra& result);
 
+  /// Accumulated times of all the keys
+  const std::unordered_map<std::string, Duration>& GetAll() const {
+    return data_;
+  }
+
  private:
   std::unordered_map<std::string, Duration> data_;
 };
@@ -1,6 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <tracing/sampling.hpp>
+#include <tracing/span_exporter.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/tracing/noop.hpp>
 #include <userver/tracing/opentracing.hpp>
 
@@ -39,6 +42,59 @@ void tracing_opentracing_ctr(benchmark::State& state) {
 }
 BENCHMARK(tracing_opentracing_ctr);
 
+constexpr std::size_t kFanOut = 16;
+
+// A handler span with kFanOut child spans, as for a handler with a number of
+// requests to the downstream services
+void RunFanOut(benchmark::State& state) {
+  auto old_logger =
+      logging::SetDefaultLogger(logging::MakeNullLogger("null_logger"));
+  logging::SetDefaultLoggerLevel(logging::Level::kInfo);
+
+  auto tracer = tracing::MakeNoopTracer("test_service");
+  for (auto _ : state) {
+    auto root = tracer->CreateSpanWithoutParent("handler");
+    root.AddTag("meta_code", 200);
+    for (std::size_t i = 0; i < kFanOut; ++i) {
+      auto child = root.CreateChild("request");
+      child.AddNonInheritableTag("http.url", "http://example.com/example");
+    }
+  }
+
+  logging::SetDefaultLogger(std::move(old_logger));
+}
+
+void SetHeadProbability(double probability) {
+  tracing::SamplingConfig config;
+  config.head_probability = probability;
+  tracing::impl::SetSamplingConfig(std::move(config));
+}
+
+void tracing_fanout_logged(benchmark::State& state) {
+  engine::RunStandalone([&] { RunFanOut(state); });
+}
+BENCHMARK(tracing_fanout_logged);
+
+void tracing_fanout_unsampled(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    SetHeadProbability(0.0);
+    RunFanOut(state);
+    SetHeadProbability(1.0);
+  });
+}
+BENCHMARK(tracing_fanout_unsampled);
+
+void tracing_fanout_exported(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    tracing::impl::SetSpanExporter(
+        std::make_shared<tracing::impl::SpanExporter>(
+            tracing::impl::SpanExporterConfig{"/dev/null"}));
+    RunFanOut(state);
+    tracing::impl::SetSpanExporter({});
+  });
+}
+BENCHMARK(tracing_fanout_exported);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
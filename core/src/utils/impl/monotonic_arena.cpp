@@ -0,0 +1,49 @@
+#include <userver/utils/impl/monotonic_arena.hpp>
+
+#include <algorithm>
+#include <new>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+MonotonicArena::MonotonicArena(void* initial_buffer, std::size_t size) noexcept
+    : current_(static_cast<char*>(initial_buffer)), end_(current_ + size) {}
+
+MonotonicArena::~MonotonicArena() {
+  while (blocks_) {
+    auto* next = blocks_->next;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* MonotonicArena::AllocateSlow(std::size_t size, std::size_t alignment) {
+  // Zero-sized allocations still have to return unique pointers
+  size = std::max<std::size_t>(size, 1);
+
+  const auto block_size = std::max(next_block_size_,
+                                   sizeof(BlockHeader) + size + alignment);
+  next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+
+  auto* block = static_cast<BlockHeader*>(::operator new(block_size));
+  block->next = blocks_;
+  blocks_ = block;
+
+  current_ = reinterpret_cast<char*>(block + 1);
+  end_ = reinterpret_cast<char*>(block) + block_size;
+
+  void* ptr = current_;
+  auto space = static_cast<std::size_t>(end_ - current_);
+  [[maybe_unused]] const auto* aligned =
+      std::align(alignment, size, ptr, space);
+  UASSERT(aligned);
+  current_ = static_cast<char*>(ptr) + size;
+  return ptr;
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,100 @@
+#include <userver/utils/impl/monotonic_arena.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename T>
+using ArenaVector = std::vector<T, utils::impl::ArenaAllocator<T>>;
+
+using ArenaMap = std::unordered_map<
+    std::string, std::string, std::hash<std::string>,
+    std::equal_to<std::string>,
+    utils::impl::ArenaAllocator<std::pair<const std::string, std::string>>>;
+
+bool IsInside(const void* ptr, const void* begin, std::size_t size) {
+  const auto* p = static_cast<const char*>(ptr);
+  const auto* b = static_cast<const char*>(begin);
+  return p >= b && p < b + size;
+}
+
+}  // namespace
+
+TEST(MonotonicArena, InitialBufferFirst) {
+  alignas(std::max_align_t) std::array<char, 256> buffer{};
+  utils::impl::MonotonicArena arena{buffer.data(), buffer.size()};
+
+  auto* first = arena.Allocate(10, 1);
+  auto* second = arena.Allocate(8, 8);
+  EXPECT_TRUE(IsInside(first, buffer.data(), buffer.size()));
+  EXPECT_TRUE(IsInside(second, buffer.data(), buffer.size()));
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 8, 0u);
+  EXPECT_NE(first, second);
+
+  auto* large = arena.Allocate(1024, 16);
+  EXPECT_FALSE(IsInside(large, buffer.data(), buffer.size()));
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 16, 0u);
+}
+
+TEST(MonotonicArena, ManyAllocations) {
+  utils::impl::MonotonicArena arena;
+
+  std::vector<std::uint64_t*> values;
+  for (std::uint64_t i = 0; i < 10000; ++i) {
+    auto* value = static_cast<std::uint64_t*>(
+        arena.Allocate(sizeof(std::uint64_t), alignof(std::uint64_t)));
+    *value = i;
+    values.push_back(value);
+  }
+  for (std::uint64_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(*values[i], i);
+  }
+
+  // Larger than the maximum block size
+  auto* huge = static_cast<char*>(arena.Allocate(1024 * 1024, 64));
+  huge[1024 * 1024 - 1] = 'x';
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(huge) % 64, 0u);
+}
+
+TEST(ArenaAllocator, Containers) {
+  alignas(std::max_align_t) std::array<char, 1024> buffer{};
+  utils::impl::MonotonicArena arena{buffer.data(), buffer.size()};
+
+  ArenaVector<int> vector{ArenaVector<int>::allocator_type{arena}};
+  for (int i = 0; i < 1000; ++i) vector.push_back(i);
+  EXPECT_EQ(vector.size(), std::size_t{1000});
+  EXPECT_EQ(vector.back(), 999);
+
+  ArenaMap map{ArenaMap::allocator_type{arena}};
+  map["key"] = "value";
+  map["long key that does not fit into SSO"] = "long value as well, really";
+  EXPECT_EQ(map.at("key"), "value");
+  EXPECT_EQ(map.get_allocator().GetArena(), &arena);
+}
+
+TEST(ArenaAllocator, CopyDoesNotShareArena) {
+  ArenaMap copy;
+  {
+    utils::impl::MonotonicArena arena;
+    ArenaMap map{ArenaMap::allocator_type{arena}};
+    map["key"] = "value";
+
+    copy = map;
+    ArenaMap copy_constructed{map};
+    EXPECT_EQ(copy_constructed.get_allocator().GetArena(), nullptr);
+  }
+
+  EXPECT_EQ(copy.get_allocator().GetArena(), nullptr);
+  EXPECT_EQ(copy.at("key"), "value");
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <variant>
+
+#include <fmt/format.h>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+// Appends the value the way Prometheus and Graphite parse it
+inline void AppendMetricValue(std::string& out, const MetricValue& value) {
+  if (const auto* integer = std::get_if<std::int64_t>(&value)) {
+    out += fmt::format_int(*integer).c_str();
+    return;
+  }
+
+  const auto number = std::get<double>(value);
+  if (std::isnan(number)) {
+    out += "NaN";
+  } else if (std::isinf(number)) {
+    out += number > 0 ? "+Inf" : "-Inf";
+  } else {
+    fmt::format_to(std::back_inserter(out), "{}", number);
+  }
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,74 @@
+#include <userver/utils/statistics/graphite.hpp>
+
+#include <chrono>
+
+#include <userver/utils/datetime.hpp>
+#include <utils/statistics/format_utils.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+void AppendTagPart(std::string& out, std::string_view value) {
+  for (const char c : value) {
+    switch (c) {
+      case ';':
+      case '=':
+      case '~':
+      case ' ':
+      case '\n':
+        out += '_';
+        break;
+      default:
+        out += c;
+    }
+  }
+}
+
+class GraphiteBuilder final : public BaseFormatBuilder {
+ public:
+  explicit GraphiteBuilder(std::string_view timestamp)
+      : timestamp_(timestamp) {}
+
+  void HandleMetric(std::string_view path, const std::vector<LabelView>& labels,
+                    const MetricValue& value) override {
+    AppendTagPart(result_, path);
+    for (const auto& label : labels) {
+      result_ += ';';
+      AppendTagPart(result_, label.Name());
+      result_ += '=';
+      AppendTagPart(result_, label.Value());
+    }
+    result_ += ' ';
+    impl::AppendMetricValue(result_, value);
+    result_ += ' ';
+    result_ += timestamp_;
+    result_ += '\n';
+  }
+
+  std::string Release() && { return std::move(result_); }
+
+ private:
+  const std::string_view timestamp_;
+  std::string result_;
+};
+
+}  // namespace
+
+std::string ToGraphiteFormat(const Storage& storage,
+                             const StatisticsRequest& request) {
+  const auto timestamp = std::to_string(
+      std::chrono::duration_cast<std::chrono::seconds>(
+          utils::datetime::Now().time_since_epoch())
+          .count());
+
+  GraphiteBuilder builder(timestamp);
+  storage.VisitMetrics(builder, request);
+  return std::move(builder).Release();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
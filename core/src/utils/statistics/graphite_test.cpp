@@ -0,0 +1,34 @@
+#include <userver/utils/statistics/graphite.hpp>
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(StatisticsGraphite, Format) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "foo",
+      [](utils::statistics::Writer& writer) {
+        writer["bar"] = 1;
+        writer["baz"].ValueWithLabels(2.5, {"kind", "a;b=c d"});
+      },
+      {{"host", "local"}});
+
+  const auto result = utils::statistics::ToGraphiteFormat(storage);
+  const auto first_line_end = result.find('\n');
+  ASSERT_NE(first_line_end, std::string::npos);
+  const auto timestamp_begin = result.rfind(' ', first_line_end) + 1;
+  const auto timestamp =
+      result.substr(timestamp_begin, first_line_end - timestamp_begin);
+
+  EXPECT_EQ(result, fmt::format("foo.bar;host=local 1 {0}\n"
+                                "foo.baz;host=local;kind=a_b_c_d 2.5 {0}\n",
+                                timestamp));
+}
+
+USERVER_NAMESPACE_END
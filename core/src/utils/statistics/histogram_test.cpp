@@ -0,0 +1,121 @@
+#include <userver/utils/statistics/histogram.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Histogram = utils::statistics::LogLinearHistogram<6, 20>;
+using ShardedHistogram = utils::statistics::ShardedHistogram<6, 20>;
+
+}  // namespace
+
+TEST(LogLinearHistogram, Buckets) {
+  using Buckets = Histogram::Buckets;
+  static_assert(Buckets::kCount == 512);
+
+  std::size_t previous_bucket = 0;
+  for (std::uint64_t value = 0; value <= Buckets::kMaxValue; ++value) {
+    const auto bucket = Buckets::ToBucket(value);
+    ASSERT_LT(bucket, Buckets::kCount);
+    ASSERT_LE(previous_bucket, bucket);
+    ASSERT_LE(bucket, previous_bucket + 1);
+    previous_bucket = bucket;
+
+    const auto bucket_value = Buckets::ToValue(bucket);
+    ASSERT_GE(bucket_value, value);
+    ASSERT_LE(bucket_value - value, value / 32) << value;
+  }
+  EXPECT_EQ(previous_bucket, Buckets::kCount - 1);
+  EXPECT_EQ(Buckets::ToBucket(UINT64_MAX), Buckets::kCount - 1);
+}
+
+TEST(LogLinearHistogram, Zero) {
+  Histogram histogram;
+
+  EXPECT_EQ(0u, histogram.GetPercentile(0));
+  EXPECT_EQ(0u, histogram.GetPercentile(50));
+  EXPECT_EQ(0u, histogram.GetPercentile(100));
+  EXPECT_EQ(0u, histogram.Count());
+}
+
+/// [LogLinearHistogram sample]
+TEST(LogLinearHistogram, Sample) {
+  Histogram histogram;
+  for (std::uint64_t i = 0; i < 100; ++i) histogram.Account(i);
+  histogram.Account(100'000);
+
+  // Values below 2^6 are precise
+  EXPECT_EQ(0u, histogram.GetPercentile(0));
+  EXPECT_EQ(50u, histogram.GetPercentile(50));
+  // 90 falls into the bucket [90, 91]
+  EXPECT_EQ(91u, histogram.GetPercentile(90));
+  // 100'000 falls into the bucket [98'304, 100'351]
+  EXPECT_EQ(100'351u, histogram.GetPercentile(100));
+  EXPECT_EQ(101u, histogram.Count());
+}
+/// [LogLinearHistogram sample]
+
+TEST(LogLinearHistogram, Add) {
+  Histogram first;
+  Histogram second;
+  for (std::uint64_t i = 0; i < 50; ++i) first.Account(i);
+  for (std::uint64_t i = 50; i < 100; ++i) second.Account(i);
+
+  first += second;
+  EXPECT_EQ(100u, first.Count());
+  EXPECT_EQ(25u, first.GetPercentile(25));
+  EXPECT_EQ(99u, first.GetPercentile(100));
+
+  first.Reset();
+  EXPECT_EQ(0u, first.Count());
+  EXPECT_EQ(0u, first.GetPercentile(100));
+}
+
+TEST(ShardedHistogram, Threads) {
+  constexpr std::uint64_t kThreads = 8;
+  constexpr std::uint64_t kValuesPerThread = 10'000;
+
+  ShardedHistogram sharded;
+  std::vector<std::thread> threads;
+  for (std::uint64_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&sharded, i] {
+      for (std::uint64_t value = 0; value < kValuesPerThread; ++value) {
+        sharded.Account(i * kValuesPerThread + value);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  Histogram histogram;
+  histogram += sharded;
+  EXPECT_EQ(kThreads * kValuesPerThread, histogram.Count());
+  EXPECT_EQ(0u, histogram.GetPercentile(0));
+  const auto median = histogram.GetPercentile(50);
+  EXPECT_GE(median, 40'000u);
+  EXPECT_LE(median, 40'000u + 40'000u / 32);
+
+  sharded.Reset();
+  Histogram empty;
+  empty += sharded;
+  EXPECT_EQ(0u, empty.Count());
+}
+
+TEST(ShardedHistogram, RecentPeriod) {
+  utils::statistics::RecentPeriod<ShardedHistogram, Histogram> timings;
+  timings.GetCurrentCounter().Account(42);
+
+  const auto histogram = timings.GetStatsForPeriod(
+      std::chrono::steady_clock::duration::min(), /*with_current_epoch=*/true);
+  EXPECT_EQ(1u, histogram.Count());
+  EXPECT_EQ(42u, histogram.GetPercentile(50));
+}
+
+USERVER_NAMESPACE_END
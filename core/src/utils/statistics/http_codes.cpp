@@ -13,7 +13,7 @@ namespace utils::statistics {
 HttpCodes::HttpCodes(std::initializer_list<unsigned short> codes) {
   particular_codes.reserve(codes.size());
   for (auto code : codes) {
-    [[maybe_unused]] auto [it, inserted] = particular_codes.emplace(code, 0);
+    [[maybe_unused]] auto [it, inserted] = particular_codes.try_emplace(code);
     UASSERT(inserted);
   }
 }
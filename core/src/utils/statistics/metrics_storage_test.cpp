@@ -5,6 +5,7 @@
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -13,6 +14,16 @@ namespace {
 
 utils::statistics::MetricTag<std::atomic<int>> kFooMetric{"foo-metric"};
 
+struct WriterMetric {
+  std::atomic<int> value{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const WriterMetric& metric) {
+  writer["value"].ValueWithLabels(metric.value, {"kind", "sample"});
+}
+
+utils::statistics::MetricTag<WriterMetric> kWriterMetric{"writer-metric"};
+
 }  // namespace
 
 UTEST(MetricsStorage, Smoke) {
@@ -31,4 +42,18 @@ UTEST(MetricsStorage, Smoke) {
   }
 }
 
+UTEST(MetricsStorage, Writer) {
+  utils::statistics::Storage storage;
+  utils::statistics::MetricsStorage metrics_storage;
+  const auto statistic_holders = metrics_storage.RegisterIn(storage);
+
+  metrics_storage.GetMetric(kWriterMetric).value = 42;
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage, {"writer-metric"}),
+            "# TYPE writer_metric_value gauge\n"
+            "writer_metric_value{kind=\"sample\"} 42\n");
+
+  const auto json = storage.GetAsJson({"writer-metric"}).ExtractValue();
+  EXPECT_EQ(json["writer-metric"]["sample"]["value"].As<int>(), 42);
+}
+
 USERVER_NAMESPACE_END
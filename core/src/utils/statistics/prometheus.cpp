@@ -0,0 +1,140 @@
+#include <userver/utils/statistics/prometheus.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+#include <utils/statistics/format_utils.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+bool IsNameChar(char c, bool allow_colon) {
+  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+         ('0' <= c && c <= '9') || c == '_' || (allow_colon && c == ':');
+}
+
+// Metric names match [a-zA-Z_:][a-zA-Z0-9_:]*, label names match
+// [a-zA-Z_][a-zA-Z0-9_]*
+void AppendName(std::string& out, std::string_view name, bool allow_colon) {
+  if (name.empty() || ('0' <= name[0] && name[0] <= '9')) out += '_';
+  for (const char c : name) out += IsNameChar(c, allow_colon) ? c : '_';
+}
+
+void AppendEscapedLabelValue(std::string& out, std::string_view value) {
+  for (const char c : value) {
+    switch (c) {
+      case '\\':
+        out += "\\\\";
+        break;
+      case '"':
+        out += "\\\"";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        out += c;
+    }
+  }
+}
+
+// Prometheus requires all the lines of a metric to go together after a single
+// TYPE line, while the same metric may be written by several writers (e.g.
+// with different labels). So the lines are grouped by the metric name.
+class PrometheusBuilder final : public BaseFormatBuilder {
+ public:
+  explicit PrometheusBuilder(bool is_open_metrics)
+      : is_open_metrics_(is_open_metrics) {}
+
+  void HandleMetric(std::string_view path, const std::vector<LabelView>& labels,
+                    const MetricValue& value) override {
+    name_.clear();
+    AppendName(name_, path, /*allow_colon=*/true);
+
+    auto it = group_indices_.find(name_);
+    if (it == group_indices_.end()) {
+      it = group_indices_.emplace(name_, groups_.size()).first;
+      groups_.push_back({name_, {}});
+    }
+    auto& out = groups_[it->second].lines;
+
+    out += name_;
+    if (!labels.empty()) {
+      out += '{';
+      bool is_first = true;
+      for (const auto& label : labels) {
+        if (!is_first) out += ',';
+        is_first = false;
+        AppendName(out, label.Name(), /*allow_colon=*/false);
+        out += "=\"";
+        AppendEscapedLabelValue(out, label.Value());
+        out += '"';
+      }
+      out += '}';
+    }
+    out += ' ';
+    impl::AppendMetricValue(out, value);
+    out += '\n';
+  }
+
+  std::string Release() && {
+    constexpr std::string_view kTypePrefix = "# TYPE ";
+    constexpr std::string_view kTypeSuffix = " gauge\n";
+    constexpr std::string_view kEof = "# EOF\n";
+
+    std::size_t size = kEof.size();
+    for (const auto& group : groups_) {
+      size += kTypePrefix.size() + group.name.size() + kTypeSuffix.size() +
+              group.lines.size();
+    }
+
+    std::string result;
+    result.reserve(size);
+    for (auto& group : groups_) {
+      result += kTypePrefix;
+      result += group.name;
+      result += kTypeSuffix;
+      result += group.lines;
+      group.lines = {};
+    }
+    if (is_open_metrics_) result += kEof;
+    return result;
+  }
+
+ private:
+  struct Group final {
+    std::string name;
+    std::string lines;
+  };
+
+  const bool is_open_metrics_;
+  std::string name_;
+  std::unordered_map<std::string, std::size_t> group_indices_;
+  std::vector<Group> groups_;
+};
+
+std::string ToFormat(const Storage& storage, const StatisticsRequest& request,
+                     bool is_open_metrics) {
+  PrometheusBuilder builder(is_open_metrics);
+  storage.VisitMetrics(builder, request);
+  return std::move(builder).Release();
+}
+
+}  // namespace
+
+std::string ToPrometheusFormat(const Storage& storage,
+                               const StatisticsRequest& request) {
+  return ToFormat(storage, request, /*is_open_metrics=*/false);
+}
+
+std::string ToOpenMetricsFormat(const Storage& storage,
+                                const StatisticsRequest& request) {
+  return ToFormat(storage, request, /*is_open_metrics=*/true);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
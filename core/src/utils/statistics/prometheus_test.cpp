@@ -0,0 +1,93 @@
+#include <userver/utils/statistics/prometheus.hpp>
+
+#include <limits>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(StatisticsPrometheus, GroupsByName) {
+  utils::statistics::Storage storage;
+  const auto first_holder = storage.RegisterWriter(
+      "requests",
+      [](utils::statistics::Writer& writer) {
+        writer = 1;
+        writer["errors"] = 2;
+      },
+      {{"handler", "a"}});
+  const auto second_holder = storage.RegisterWriter(
+      "requests", [](utils::statistics::Writer& writer) { writer = 3; },
+      {{"handler", "b"}});
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage),
+            "# TYPE requests gauge\n"
+            "requests{handler=\"a\"} 1\n"
+            "requests{handler=\"b\"} 3\n"
+            "# TYPE requests_errors gauge\n"
+            "requests_errors{handler=\"a\"} 2\n");
+}
+
+UTEST(StatisticsPrometheus, Escaping) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "1st-metric.name", [](utils::statistics::Writer& writer) {
+        writer.ValueWithLabels(
+            1, {{"label-name", "a\"b\\c\nd"}, {"le:le", "x"}});
+      });
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage),
+            "# TYPE _1st_metric_name gauge\n"
+            "_1st_metric_name{label_name=\"a\\\"b\\\\c\\nd\",le_le=\"x\"} 1\n");
+}
+
+UTEST(StatisticsPrometheus, Values) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "values", [](utils::statistics::Writer& writer) {
+        writer["int"] = -42;
+        writer["double"] = 0.5;
+        writer["nan"] = std::numeric_limits<double>::quiet_NaN();
+        writer["inf"] = std::numeric_limits<double>::infinity();
+        writer["minus-inf"] = -std::numeric_limits<double>::infinity();
+      });
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage),
+            "# TYPE values_int gauge\n"
+            "values_int -42\n"
+            "# TYPE values_double gauge\n"
+            "values_double 0.5\n"
+            "# TYPE values_nan gauge\n"
+            "values_nan NaN\n"
+            "# TYPE values_inf gauge\n"
+            "values_inf +Inf\n"
+            "# TYPE values_minus_inf gauge\n"
+            "values_minus_inf -Inf\n");
+}
+
+UTEST(StatisticsPrometheus, OpenMetrics) {
+  utils::statistics::Storage storage;
+  EXPECT_EQ(utils::statistics::ToOpenMetricsFormat(storage), "# EOF\n");
+
+  const auto holder = storage.RegisterWriter(
+      "foo", [](utils::statistics::Writer& writer) { writer = 1; });
+  EXPECT_EQ(utils::statistics::ToOpenMetricsFormat(storage),
+            "# TYPE foo gauge\n"
+            "foo 1\n"
+            "# EOF\n");
+}
+
+UTEST(StatisticsPrometheus, Prefix) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "foo", [](utils::statistics::Writer& writer) {
+        writer["bar"] = 1;
+        writer["baz"] = 2;
+      });
+
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage, {"foo.bar"}),
+            "# TYPE foo_bar gauge\n"
+            "foo_bar 1\n");
+}
+
+USERVER_NAMESPACE_END
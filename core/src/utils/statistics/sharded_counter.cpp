@@ -0,0 +1,42 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+#include <algorithm>
+#include <thread>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+namespace {
+
+// More shards take more memory and make the reads slower, while the
+// contention is already low enough
+constexpr std::size_t kMaxShardCount = 16;
+
+std::size_t CalculateShardCount() noexcept {
+  const std::size_t threads =
+      std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1,
+                              kMaxShardCount);
+  std::size_t result = 1;
+  while (result < threads) result *= 2;
+  return result;
+}
+
+}  // namespace
+
+std::size_t GetShardCount() noexcept {
+  static const std::size_t count = CalculateShardCount();
+  return count;
+}
+
+std::size_t GetCurrentShardIndex() noexcept {
+  static std::atomic<std::size_t> counter{0};
+  // consecutive threads get different shards
+  thread_local const std::size_t index =
+      counter.fetch_add(1, std::memory_order_relaxed) & (GetShardCount() - 1);
+  return index;
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
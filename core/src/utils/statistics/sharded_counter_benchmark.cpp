@@ -0,0 +1,61 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// The benchmarks run from several threads at once, updating the same object,
+// which is how the statistics of a handler are updated at high RPS
+utils::statistics::RelaxedCounter<std::uint64_t> relaxed_counter;
+utils::statistics::ShardedCounter<std::uint64_t> sharded_counter;
+
+utils::statistics::Percentile<2048, unsigned int, 120> percentile;
+utils::statistics::ShardedHistogram<6, 20> sharded_histogram;
+
+}  // namespace
+
+void statistics_relaxed_counter(benchmark::State& state) {
+  for (auto _ : state) ++relaxed_counter;
+  benchmark::DoNotOptimize(relaxed_counter.Load());
+}
+BENCHMARK(statistics_relaxed_counter)->ThreadRange(1, 16);
+
+void statistics_sharded_counter(benchmark::State& state) {
+  for (auto _ : state) ++sharded_counter;
+  benchmark::DoNotOptimize(sharded_counter.Load());
+}
+BENCHMARK(statistics_sharded_counter)->ThreadRange(1, 16);
+
+void statistics_percentile_account(benchmark::State& state) {
+  std::uint64_t value = 0;
+  for (auto _ : state) percentile.Account(value++ % 300);
+}
+BENCHMARK(statistics_percentile_account)->ThreadRange(1, 16);
+
+void statistics_sharded_histogram_account(benchmark::State& state) {
+  std::uint64_t value = 0;
+  for (auto _ : state) sharded_histogram.Account(value++ % 300);
+}
+BENCHMARK(statistics_sharded_histogram_account)->ThreadRange(1, 16);
+
+void statistics_sharded_histogram_read(benchmark::State& state) {
+  utils::statistics::ShardedHistogram<6, 20> histogram;
+  for (std::uint64_t i = 0; i < 1000; ++i) histogram.Account(i);
+
+  for (auto _ : state) {
+    utils::statistics::LogLinearHistogram<6, 20> result;
+    result += histogram;
+    benchmark::DoNotOptimize(result.GetPercentile(99));
+  }
+}
+BENCHMARK(statistics_sharded_histogram_read);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,52 @@
+#include <userver/utils/statistics/sharded_counter.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ShardedCounter, Basic) {
+  utils::statistics::ShardedCounter<std::int64_t> counter;
+  EXPECT_EQ(counter.Load(), 0);
+
+  ++counter;
+  counter += 10;
+  --counter;
+  counter -= 3;
+  EXPECT_EQ(counter.Load(), 7);
+
+  counter.Reset();
+  EXPECT_EQ(counter.Load(), 0);
+}
+
+TEST(ShardedCounter, Threads) {
+  constexpr std::uint64_t kThreads = 8;
+  constexpr std::uint64_t kIncrements = 100'000;
+
+  utils::statistics::ShardedCounter<std::uint64_t> counter;
+  std::vector<std::thread> threads;
+  for (std::uint64_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&counter] {
+      for (std::uint64_t j = 0; j < kIncrements; ++j) ++counter;
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(counter.Load(), kThreads * kIncrements);
+}
+
+TEST(ShardedCounter, ShardIndex) {
+  const auto count = utils::statistics::impl::GetShardCount();
+  EXPECT_GE(count, 1u);
+  EXPECT_LE(count, 16u);
+  EXPECT_EQ(count & (count - 1), 0u);
+
+  const auto index = utils::statistics::impl::GetCurrentShardIndex();
+  EXPECT_LT(index, count);
+  EXPECT_EQ(index, utils::statistics::impl::GetCurrentShardIndex());
+}
+
+USERVER_NAMESPACE_END
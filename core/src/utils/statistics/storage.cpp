@@ -1,12 +1,16 @@
 #include <userver/utils/statistics/storage.hpp>
 
+#include <optional>
 #include <utility>
 
+#include <userver/formats/common/transfer_tag.hpp>
 #include <userver/formats/common/utils.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/metadata.hpp>
 #include <userver/utils/text.hpp>
 #include <utils/statistics/value_builder_helpers.hpp>
+#include <utils/statistics/writer_state.hpp>
 
 #include <utils/statistics/entry_impl.hpp>
 
@@ -21,6 +25,150 @@ constexpr int kVersion = 2;
 
 namespace utils::statistics {
 
+namespace {
+
+const std::string kMetadata = "$meta";
+const std::string kMetadataSolomonSkip = "solomon_skip";
+const std::string kMetadataSolomonRename = "solomon_rename";
+const std::string kMetadataSolomonLabel = "solomon_label";
+const std::string kMetadataSolomonChildrenLabels = "solomon_children_labels";
+
+bool IsRequested(const impl::MetricsSource& source,
+                 const StatisticsRequest& request) {
+  return utils::text::StartsWith(source.prefix_path, request.prefix) ||
+         utils::text::StartsWith(request.prefix, source.prefix_path);
+}
+
+// Builds the legacy JSON from the metrics of writers, the labels are stored
+// as Solomon labels before the last path segment
+class JsonTreeBuilder final : public BaseFormatBuilder {
+ public:
+  explicit JsonTreeBuilder(formats::json::ValueBuilder& result)
+      : result_(result) {}
+
+  void HandleMetric(std::string_view path, const std::vector<LabelView>& labels,
+                    const MetricValue& value) override {
+    auto segments = formats::common::SplitPathString(path);
+    UASSERT_MSG(!segments.empty(), "Metrics must have a non-empty path");
+    auto json_value = std::visit(
+        [](auto number) { return formats::json::ValueBuilder(number); },
+        value);
+
+    if (labels.empty()) {
+      SetSubField(result_, std::move(segments), std::move(json_value));
+      return;
+    }
+
+    auto name = std::move(segments.back());
+    segments.pop_back();
+
+    std::optional<formats::json::ValueBuilder> node;
+    const auto enter = [this, &node](std::string key) {
+      node.emplace(formats::common::TransferTag(),
+                   node ? (*node)[std::move(key)] : result_[std::move(key)]);
+    };
+    for (auto& segment : segments) enter(std::move(segment));
+    for (const auto& label : labels) {
+      enter(std::string{label.Value()});
+      SolomonLabelValue(*node, std::string{label.Name()});
+    }
+    SetSubField(*node, {std::move(name)}, std::move(json_value));
+  }
+
+ private:
+  formats::json::ValueBuilder& result_;
+};
+
+// Converts the legacy JSON of an extender into metrics, Solomon metadata is
+// converted into labels
+class JsonMetricsVisitor final {
+ public:
+  JsonMetricsVisitor(BaseFormatBuilder& out, std::string_view path_prefix)
+      : out_(out), path_prefix_(path_prefix) {}
+
+  void Visit(const impl::MetricsSource& source,
+             const formats::json::Value& json) {
+    path_.clear();
+    labels_.clear();
+
+    const auto& segments = source.path_segments;
+    if (segments.empty()) {
+      VisitNode(json, std::nullopt, nullptr);
+      return;
+    }
+    for (std::size_t i = 0; i + 1 < segments.size(); ++i) {
+      AppendSegment(segments[i]);
+    }
+    VisitNode(json, segments.back(), nullptr);
+  }
+
+ private:
+  void AppendSegment(std::string_view segment) {
+    if (!path_.empty()) path_ += '.';
+    path_ += segment;
+  }
+
+  void VisitNode(const formats::json::Value& node,
+                 std::optional<std::string_view> name,
+                 const std::string* parent_children_label) {
+    const auto initial_path_size = path_.size();
+    const auto initial_labels_size = labels_.size();
+
+    const auto meta = node.IsObject() ? node[kMetadata]
+                                      : formats::json::Value{};
+    if (name) {
+      if (parent_children_label) {
+        labels_.emplace_back(*parent_children_label, std::string{*name});
+      } else if (meta.HasMember(kMetadataSolomonLabel)) {
+        labels_.emplace_back(meta[kMetadataSolomonLabel].As<std::string>(),
+                             std::string{*name});
+      } else if (meta.HasMember(kMetadataSolomonRename)) {
+        AppendSegment(meta[kMetadataSolomonRename].As<std::string>());
+      } else if (!meta.HasMember(kMetadataSolomonSkip)) {
+        AppendSegment(*name);
+      }
+    }
+
+    if (node.IsObject()) {
+      std::optional<std::string> children_label;
+      if (meta.HasMember(kMetadataSolomonChildrenLabels)) {
+        children_label =
+            meta[kMetadataSolomonChildrenLabels].As<std::string>();
+      }
+      for (const auto& [child_name, child] : Items(node)) {
+        if (child_name == kMetadata) continue;
+        VisitNode(child, child_name,
+                  children_label ? &*children_label : nullptr);
+      }
+    } else if (node.IsInt64()) {
+      HandleMetric(node.As<std::int64_t>());
+    } else if (node.IsUInt64()) {
+      HandleMetric(static_cast<double>(node.As<std::uint64_t>()));
+    } else if (node.IsDouble()) {
+      HandleMetric(node.As<double>());
+    }
+
+    path_.resize(initial_path_size);
+    labels_.erase(labels_.begin() + initial_labels_size, labels_.end());
+  }
+
+  void HandleMetric(MetricValue value) {
+    if (!utils::text::StartsWith(path_, path_prefix_)) return;
+
+    label_views_.clear();
+    for (const auto& label : labels_) label_views_.push_back(label);
+    out_.HandleMetric(path_, label_views_, value);
+  }
+
+  BaseFormatBuilder& out_;
+  const std::string_view path_prefix_;
+  std::string path_;
+  std::vector<Label> labels_;
+  std::vector<LabelView> label_views_;
+};
+
+}  // namespace
+
 Storage::Storage() : may_register_extenders_(true) {}
 
 formats::json::ValueBuilder Storage::GetAsJson(
@@ -31,30 +179,59 @@ formats::json::ValueBuilder Storage::GetAsJson(
   std::shared_lock lock(mutex_);
 
   for (const auto& entry : metrics_sources_) {
-    if (utils::text::StartsWith(entry.prefix_path, request.prefix) ||
-        utils::text::StartsWith(request.prefix, entry.prefix_path)) {
+    if (IsRequested(entry, request)) {
       LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
-      SetSubField(result, std::vector(entry.path_segments),
-                  entry.extender(request));
+      if (entry.writer) {
+        JsonTreeBuilder builder(result);
+        impl::WriterState state{builder, request.prefix, entry.prefix_path,
+                                {entry.writer_labels.begin(),
+                                 entry.writer_labels.end()}};
+        Writer writer(state);
+        entry.writer(writer);
+      } else {
+        SetSubField(result, std::vector(entry.path_segments),
+                    entry.extender(request));
+      }
     }
   }
 
   return result;
 }
 
+void Storage::VisitMetrics(BaseFormatBuilder& out,
+                           const StatisticsRequest& request) const {
+  JsonMetricsVisitor json_visitor(out, request.prefix);
+
+  std::shared_lock lock(mutex_);
+
+  for (const auto& entry : metrics_sources_) {
+    if (!IsRequested(entry, request)) continue;
+
+    if (entry.writer) {
+      impl::WriterState state{out, request.prefix, entry.prefix_path,
+                              {entry.writer_labels.begin(),
+                               entry.writer_labels.end()}};
+      Writer writer(state);
+      entry.writer(writer);
+    } else {
+      json_visitor.Visit(entry, entry.extender(request).ExtractValue());
+    }
+  }
+}
+
 void Storage::StopRegisteringExtenders() { may_register_extenders_ = false; }
 
 Entry Storage::RegisterExtender(std::string prefix, ExtenderFunc func) {
   auto prefix_split = formats::common::SplitPathString(prefix);
   return DoRegisterExtender(impl::MetricsSource{
-      std::move(prefix), std::move(prefix_split), std::move(func)});
+      std::move(prefix), std::move(prefix_split), std::move(func), {}, {}});
 }
 
 Entry Storage::RegisterExtender(std::vector<std::string> prefix,
                                 ExtenderFunc func) {
   auto prefix_joined = JoinPath(prefix);
   return DoRegisterExtender(impl::MetricsSource{
-      std::move(prefix_joined), std::move(prefix), std::move(func)});
+      std::move(prefix_joined), std::move(prefix), std::move(func), {}, {}});
 }
 
 Entry Storage::RegisterExtender(std::initializer_list<std::string> prefix,
@@ -62,6 +239,14 @@ Entry Storage::RegisterExtender(std::initializer_list<std::string> prefix,
   return RegisterExtender(std::vector(prefix), std::move(func));
 }
 
+Entry Storage::RegisterWriter(std::string common_prefix, WriterFunc func,
+                              std::vector<Label> add_labels) {
+  auto prefix_split = formats::common::SplitPathString(common_prefix);
+  return DoRegisterExtender(impl::MetricsSource{
+      std::move(common_prefix), std::move(prefix_split), {}, std::move(func),
+      std::move(add_labels)});
+}
+
 Entry Storage::DoRegisterExtender(impl::MetricsSource&& source) {
   UASSERT_MSG(may_register_extenders_.load(),
               "You may not register statistics extender outside of component "
@@ -0,0 +1,122 @@
+#include <userver/utils/statistics/storage.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utils/statistics/metadata.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Each source writes the metrics of a component: a few metrics per handler
+constexpr std::size_t kSeriesPerSource = 1000;
+constexpr std::size_t kMetricsPerHandler = 4;
+const std::string kMetricNames[kMetricsPerHandler] = {"ok", "error",
+                                                      "timeout", "cancelled"};
+
+std::vector<std::string> MakeHandlerNames() {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < kSeriesPerSource / kMetricsPerHandler; ++i) {
+    names.push_back("/v1/handler-" + std::to_string(i));
+  }
+  return names;
+}
+
+std::vector<utils::statistics::Entry> RegisterWriters(
+    utils::statistics::Storage& storage, std::size_t series,
+    const std::vector<std::string>& handlers) {
+  std::vector<utils::statistics::Entry> holders;
+  for (std::size_t i = 0; i < series / kSeriesPerSource; ++i) {
+    holders.push_back(storage.RegisterWriter(
+        "component-" + std::to_string(i) + ".requests",
+        [&handlers](utils::statistics::Writer& writer) {
+          std::int64_t value = 0;
+          for (const auto& handler : handlers) {
+            for (const auto& name : kMetricNames) {
+              writer[name].ValueWithLabels(++value, {"http_handler", handler});
+            }
+          }
+        }));
+  }
+  return holders;
+}
+
+// The same metrics as RegisterWriters() in the legacy JSON format
+std::vector<utils::statistics::Entry> RegisterExtenders(
+    utils::statistics::Storage& storage, std::size_t series,
+    const std::vector<std::string>& handlers) {
+  std::vector<utils::statistics::Entry> holders;
+  for (std::size_t i = 0; i < series / kSeriesPerSource; ++i) {
+    holders.push_back(storage.RegisterExtender(
+        "component-" + std::to_string(i) + ".requests",
+        [&handlers](const utils::statistics::StatisticsRequest&) {
+          formats::json::ValueBuilder result;
+          std::int64_t value = 0;
+          for (const auto& handler : handlers) {
+            auto handler_json = result[handler];
+            for (const auto& name : kMetricNames) handler_json[name] = ++value;
+          }
+          utils::statistics::SolomonChildrenAreLabelValues(result,
+                                                           "http_handler");
+          return result;
+        }));
+  }
+  return holders;
+}
+
+}  // namespace
+
+void statistics_scrape_json(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    utils::statistics::Storage storage;
+    const auto handlers = MakeHandlerNames();
+    const auto holders = RegisterExtenders(storage, state.range(0), handlers);
+
+    for (auto _ : state) {
+      const auto json = storage.GetAsJson({}).ExtractValue();
+      benchmark::DoNotOptimize(formats::json::ToString(json));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(statistics_scrape_json)->RangeMultiplier(4)->Range(1 << 10, 1 << 18);
+
+void statistics_scrape_prometheus_extenders(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    utils::statistics::Storage storage;
+    const auto handlers = MakeHandlerNames();
+    const auto holders = RegisterExtenders(storage, state.range(0), handlers);
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(utils::statistics::ToPrometheusFormat(storage));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(statistics_scrape_prometheus_extenders)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18);
+
+void statistics_scrape_prometheus_writers(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    utils::statistics::Storage storage;
+    const auto handlers = MakeHandlerNames();
+    const auto holders = RegisterWriters(storage, state.range(0), handlers);
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(utils::statistics::ToPrometheusFormat(storage));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(statistics_scrape_prometheus_writers)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18);
+
+USERVER_NAMESPACE_END
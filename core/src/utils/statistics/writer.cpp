@@ -0,0 +1,68 @@
+#include <userver/utils/statistics/writer.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text.hpp>
+#include <utils/statistics/writer_state.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+BaseFormatBuilder::~BaseFormatBuilder() = default;
+
+Writer::Writer(impl::WriterState& state) noexcept
+    : state_(state),
+      initial_path_size_(state.path.size()),
+      path_size_(initial_path_size_) {}
+
+Writer::Writer(impl::WriterState& state, std::string_view path)
+    : Writer(state) {
+  UASSERT_MSG(!path.empty(), "Metric path segments must not be empty");
+  if (!state_.path.empty()) state_.path += '.';
+  state_.path += path;
+  path_size_ = state_.path.size();
+}
+
+Writer::~Writer() {
+  AssertNoLiveChild();
+  state_.path.resize(initial_path_size_);
+}
+
+Writer Writer::operator[](std::string_view path) {
+  AssertNoLiveChild();
+  return Writer(state_, path);
+}
+
+void Writer::WriteValue(std::int64_t value) {
+  AssertNoLiveChild();
+  if (!utils::text::StartsWith(state_.path, state_.path_prefix)) return;
+  state_.builder.HandleMetric(state_.path, state_.labels, value);
+}
+
+void Writer::WriteValue(double value) {
+  AssertNoLiveChild();
+  if (!utils::text::StartsWith(state_.path, state_.path_prefix)) return;
+  state_.builder.HandleMetric(state_.path, state_.labels, value);
+}
+
+void Writer::AssertNoLiveChild() const noexcept {
+  UASSERT_MSG(state_.path.size() == path_size_,
+              "A child of the metrics writer is still alive, the path '" +
+                  state_.path + "' is wrong. Only one child of a Writer may "
+                  "be alive at a time");
+}
+
+Writer::LabelsScope::LabelsScope(Writer& writer, const LabelView* begin,
+                                 const LabelView* end)
+    : state_(writer.state_), initial_labels_size_(state_.labels.size()) {
+  state_.labels.insert(state_.labels.end(), begin, end);
+}
+
+Writer::LabelsScope::~LabelsScope() {
+  state_.labels.erase(state_.labels.begin() + initial_labels_size_,
+                      state_.labels.end());
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
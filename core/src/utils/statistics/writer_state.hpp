@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+struct WriterState final {
+  BaseFormatBuilder& builder;
+
+  // Only the metrics with paths that start with the prefix are written
+  std::string_view path_prefix;
+
+  std::string path;
+  std::vector<LabelView> labels;
+};
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
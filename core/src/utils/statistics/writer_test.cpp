@@ -0,0 +1,176 @@
+#include <userver/utils/statistics/writer.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/metadata.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Records the metrics as `path{label=value,...} value`
+class RecordingBuilder final : public utils::statistics::BaseFormatBuilder {
+ public:
+  void HandleMetric(std::string_view path,
+                    const std::vector<utils::statistics::LabelView>& labels,
+                    const utils::statistics::MetricValue& value) override {
+    std::string line{path};
+    if (!labels.empty()) {
+      line += '{';
+      for (const auto& label : labels) {
+        if (line.back() != '{') line += ',';
+        line += fmt::format("{}={}", label.Name(), label.Value());
+      }
+      line += '}';
+    }
+    std::visit([&](auto number) { line += fmt::format(" {}", number); },
+               value);
+    lines.push_back(std::move(line));
+  }
+
+  std::vector<std::string> lines;
+};
+
+std::vector<std::string> Visit(const utils::statistics::Storage& storage,
+                               const std::string& prefix = {}) {
+  RecordingBuilder builder;
+  storage.VisitMetrics(builder, {prefix});
+  return builder.lines;
+}
+
+}  // namespace
+
+/// [Writer basic sample]
+namespace samples {
+
+struct ComponentMetrics {
+  std::atomic<std::uint64_t> requests{0};
+  std::atomic<std::uint64_t> timeouts{0};
+  std::atomic<std::uint64_t> network_errors{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ComponentMetrics& metrics) {
+  writer["requests"] = metrics.requests;
+  writer["errors"].ValueWithLabels(metrics.timeouts, {"kind", "timeout"});
+  writer["errors"].ValueWithLabels(metrics.network_errors,
+                                   {"kind", "network"});
+}
+
+}  // namespace samples
+
+UTEST(StatisticsWriter, Sample) {
+  utils::statistics::Storage storage;
+  samples::ComponentMetrics metrics;
+
+  const auto holder = storage.RegisterWriter(
+      "sample", [&metrics](utils::statistics::Writer& writer) {
+        writer["component"] = metrics;
+      });
+
+  metrics.requests = 10;
+  metrics.timeouts = 2;
+  EXPECT_EQ(utils::statistics::ToPrometheusFormat(storage),
+            "# TYPE sample_component_requests gauge\n"
+            "sample_component_requests 10\n"
+            "# TYPE sample_component_errors gauge\n"
+            "sample_component_errors{kind=\"timeout\"} 2\n"
+            "sample_component_errors{kind=\"network\"} 0\n");
+}
+/// [Writer basic sample]
+
+UTEST(StatisticsWriter, PathsAndLabels) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "a.b",
+      [](utils::statistics::Writer& writer) {
+        writer = 1;
+        writer["c"]["d.e"] = 2.5;
+        {
+          auto child = writer["f"];
+          child.ValueWithLabels(3, {{"x", "1"}, {"y", "2"}});
+          child["g"] = true;
+        }
+        writer["h"] = std::numeric_limits<std::uint64_t>::max();
+      },
+      {{"common", "label"}});
+
+  EXPECT_EQ(Visit(storage),
+            (std::vector<std::string>{
+                "a.b{common=label} 1",
+                "a.b.c.d.e{common=label} 2.5",
+                "a.b.f{common=label,x=1,y=2} 3",
+                "a.b.f.g{common=label} 1",
+                fmt::format("a.b.h{{common=label}} {}",
+                            static_cast<double>(
+                                std::numeric_limits<std::uint64_t>::max())),
+            }));
+}
+
+UTEST(StatisticsWriter, Prefix) {
+  utils::statistics::Storage storage;
+  const auto writer_holder = storage.RegisterWriter(
+      "foo", [](utils::statistics::Writer& writer) {
+        writer["bar"] = 1;
+        writer["baz"] = 2;
+      });
+  const auto other_holder = storage.RegisterWriter(
+      "other", [](utils::statistics::Writer& writer) { writer = 3; });
+
+  EXPECT_EQ(Visit(storage, "foo.baz"), std::vector<std::string>{"foo.baz 2"});
+  EXPECT_EQ(Visit(storage, "other"), std::vector<std::string>{"other 3"});
+  EXPECT_EQ(Visit(storage, "foo").size(), 2u);
+}
+
+UTEST(StatisticsWriter, Json) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "foo", [](utils::statistics::Writer& writer) {
+        writer["bar"] = 1;
+        writer["baz"].ValueWithLabels(2, {"kind", "x"});
+      });
+
+  const auto json = storage.GetAsJson({}).ExtractValue();
+  EXPECT_EQ(json["foo"]["bar"].As<int>(), 1);
+  EXPECT_EQ(json["foo"]["x"]["baz"].As<int>(), 2);
+  EXPECT_EQ(json["foo"]["x"]["$meta"]["solomon_label"].As<std::string>(),
+            "kind");
+}
+
+UTEST(StatisticsWriter, LegacyExtenders) {
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterExtender(
+      "legacy", [](const utils::statistics::StatisticsRequest&) {
+        formats::json::ValueBuilder result;
+        result["a"] = 1;
+        result["by-kind"]["x"] = 2;
+        result["by-kind"]["y"] = 3.5;
+        utils::statistics::SolomonChildrenAreLabelValues(result["by-kind"],
+                                                         "kind");
+        result["renamed"]["b"] = 4;
+        utils::statistics::SolomonRename(result["renamed"], "new-name");
+        result["skipped"]["c"] = 5;
+        utils::statistics::SolomonSkip(result["skipped"]);
+        result["not-a-metric"] = "text";
+        return result;
+      });
+
+  EXPECT_EQ(Visit(storage), (std::vector<std::string>{
+                                "legacy.a 1",
+                                "legacy.by-kind{kind=x} 2",
+                                "legacy.by-kind{kind=y} 3.5",
+                                "legacy.new-name.b 4",
+                                "legacy.c 5",
+                            }));
+}
+
+USERVER_NAMESPACE_END
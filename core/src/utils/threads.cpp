@@ -12,9 +12,14 @@
 #endif
 
 #include <algorithm>
+#include <stdexcept>
 
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/read.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text.hpp>
 #include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -53,6 +58,35 @@ LowPriorityParams QueryLowPriorityParams() {
   return result;
 }
 
+std::vector<std::size_t> SortedUnique(std::vector<std::size_t> values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+void DoSetCurrentThreadCpuAffinity(const std::vector<std::size_t>& cpus) {
+#ifdef __APPLE__
+  (void)cpus;
+  throw std::runtime_error("CPU affinity is not supported on this platform");
+#else
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(
+          fmt::format("CPU {} is out of supported range", cpu));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  static constexpr ::pid_t kThisThreadPid = 0;
+  utils::CheckSyscall(
+      ::sched_setaffinity(kThisThreadPid, sizeof(cpu_set), &cpu_set),
+      "setting thread CPU affinity to [{}]",
+      fmt::to_string(fmt::join(cpus, ",")));
+#endif
+}
+
 }  // namespace
 
 bool IsMainThread() {
@@ -88,6 +122,93 @@ void SetCurrentThreadLowPriorityScheduling() {
       "setting thread scheduling parameters");
 }
 
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+  std::vector<std::size_t> result;
+  for (const auto& range : utils::text::Split(cpu_list, ",")) {
+    const auto trimmed = utils::text::Trim(range);
+    if (trimmed.empty()) continue;
+
+    const auto dash_pos = trimmed.find('-');
+    if (dash_pos == std::string::npos) {
+      result.push_back(utils::FromString<std::size_t>(trimmed));
+      continue;
+    }
+
+    const auto first =
+        utils::FromString<std::size_t>(trimmed.substr(0, dash_pos));
+    const auto last =
+        utils::FromString<std::size_t>(trimmed.substr(dash_pos + 1));
+    if (first > last) {
+      throw std::runtime_error(
+          fmt::format("Invalid CPU range '{}' in CPU list '{}'", trimmed,
+                      cpu_list));
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+
+  return SortedUnique(std::move(result));
+}
+
+std::vector<std::size_t> ResolveCpuAffinity(
+    const std::vector<std::size_t>& cpus,
+    const std::optional<std::size_t>& numa_node) {
+  if (!numa_node) return SortedUnique(cpus);
+
+  const auto node_cpus = ParseCpuList(fs::blocking::ReadFileContents(
+      fmt::format("/sys/devices/system/node/node{}/cpulist", *numa_node)));
+  if (cpus.empty()) return node_cpus;
+
+  const auto sorted_cpus = SortedUnique(cpus);
+  std::vector<std::size_t> result;
+  std::set_intersection(node_cpus.begin(), node_cpus.end(),
+                        sorted_cpus.begin(), sorted_cpus.end(),
+                        std::back_inserter(result));
+  if (result.empty()) {
+    throw std::runtime_error(fmt::format(
+        "None of the CPUs [{}] belong to NUMA node {}", fmt::join(cpus, ","),
+        *numa_node));
+  }
+  return result;
+}
+
+void SetCurrentThreadCpuAffinity(
+    const std::vector<std::size_t>& cpus) noexcept {
+  if (cpus.empty()) return;
+
+  // Called from the thread bodies, an exception would terminate the process
+  try {
+    DoSetCurrentThreadCpuAffinity(cpus);
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Thread is left unpinned: " << e;
+  }
+}
+
+std::size_t GetNumaNodesCount() {
+#ifdef __APPLE__
+  return 1;
+#else
+  try {
+    const auto nodes = ParseCpuList(
+        fs::blocking::ReadFileContents("/sys/devices/system/node/online"));
+    return std::max(nodes.size(), std::size_t{1});
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Failed to get the number of NUMA nodes: " << e;
+    return 1;
+  }
+#endif
+}
+
+int GetCurrentThreadNumaNode() noexcept {
+#ifdef __APPLE__
+  return -1;
+#else
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == -1) return -1;
+  return static_cast<int>(node);
+#endif
+}
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
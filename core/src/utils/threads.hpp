@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils {
@@ -10,6 +15,30 @@ void SetCurrentThreadIdleScheduling();
 
 void SetCurrentThreadLowPriorityScheduling();
 
+/// Parses a CPU list in the Linux format, e.g. "0-3,8,10-11"
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// Returns the CPUs to pin threads to: CPUs of the `numa_node` (if set)
+/// intersected with `cpus` (if not empty). Returns an empty vector if no
+/// pinning is requested. Does blocking file reads.
+std::vector<std::size_t> ResolveCpuAffinity(
+    const std::vector<std::size_t>& cpus,
+    const std::optional<std::size_t>& numa_node);
+
+/// Pins the current thread to the `cpus`, does nothing for an empty vector.
+/// Logs a warning and leaves the thread unpinned if that fails or is not
+/// supported by the platform.
+void SetCurrentThreadCpuAffinity(
+    const std::vector<std::size_t>& cpus) noexcept;
+
+/// Returns the number of the online NUMA nodes, 1 if unknown.
+/// Does blocking file reads.
+std::size_t GetNumaNodesCount();
+
+/// Returns the NUMA node of the CPU the current thread is running on, or -1 if
+/// unknown
+int GetCurrentThreadNumaNode() noexcept;
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
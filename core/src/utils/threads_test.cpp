@@ -0,0 +1,35 @@
+#include <utils/threads.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(CpuAffinity, ParseCpuList) {
+  using Cpus = std::vector<std::size_t>;
+
+  EXPECT_EQ(utils::ParseCpuList(""), Cpus{});
+  EXPECT_EQ(utils::ParseCpuList("3"), Cpus{3});
+  EXPECT_EQ(utils::ParseCpuList("0-3"), (Cpus{0, 1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList("0-1,8,10-11\n"), (Cpus{0, 1, 8, 10, 11}));
+  EXPECT_EQ(utils::ParseCpuList("4, 2-3 ,3"), (Cpus{2, 3, 4}));
+
+  EXPECT_ANY_THROW(utils::ParseCpuList("3-1"));
+  EXPECT_ANY_THROW(utils::ParseCpuList("a-b"));
+}
+
+TEST(CpuAffinity, ResolveWithoutNumaNode) {
+  using Cpus = std::vector<std::size_t>;
+
+  EXPECT_EQ(utils::ResolveCpuAffinity({}, std::nullopt), Cpus{});
+  EXPECT_EQ(utils::ResolveCpuAffinity({5, 1, 5}, std::nullopt), (Cpus{1, 5}));
+}
+
+TEST(CpuAffinity, FailureLeavesThreadUnpinned) {
+  // Out of the range of cpu_set_t, the pinning is skipped with a warning
+  constexpr std::size_t kNoSuchCpu = 1 << 20;
+  EXPECT_NO_THROW(utils::SetCurrentThreadCpuAffinity({kNoSuchCpu}));
+}
+
+TEST(CpuAffinity, NumaNodesCount) { EXPECT_GE(utils::GetNumaNodesCount(), 1u); }
+
+USERVER_NAMESPACE_END
@@ -32,6 +32,8 @@ class MockReader final : public Reader {
 
   void Finish() override;
 
+  std::optional<std::size_t> GetRemainingSize() const override;
+
  private:
   std::string_view ReadRaw(std::size_t max_size) override;
 
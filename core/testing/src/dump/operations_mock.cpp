@@ -38,6 +38,10 @@ void MockReader::Finish() {
   }
 }
 
+std::optional<std::size_t> MockReader::GetRemainingSize() const {
+  return unread_data_.size();
+}
+
 }  // namespace dump
 
 USERVER_NAMESPACE_END
@@ -62,6 +62,7 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL, 0 to fetch all rows in one request | 1000
+/// stream-chunks | fetch the chunks with a single statement out of transaction instead of a portal in a transaction, see @ref pg_result_stream | false
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -93,6 +94,15 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// On incremental updates the previous cache snapshot is copied before the
+/// new rows are applied, and for std::unordered_map and std::map that copy is
+/// O(cache size). For big caches with small updates consider
+/// utils::PersistentHashMap as the CacheContainer: its copy is O(1) and shares
+/// all the unchanged elements with the previous snapshot, so an update costs
+/// O(changed rows).
+///
+/// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Persistent Container Example
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
@@ -412,6 +422,7 @@ class PostgreCache final
   const std::chrono::milliseconds full_update_timeout_;
   const std::chrono::milliseconds incremental_update_timeout_;
   const std::size_t chunk_size_;
+  const bool stream_chunks_;
   std::size_t cpu_relax_iterations_parse_{0};
   std::size_t cpu_relax_iterations_copy_{0};
 };
@@ -431,7 +442,8 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
           config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
               pg_cache::detail::kDefaultIncrementalUpdateTimeout)},
       chunk_size_{config["chunk-size"].As<size_t>(
-          pg_cache::detail::kDefaultChunkSize)} {
+          pg_cache::detail::kDefaultChunkSize)},
+      stream_chunks_{config["stream-chunks"].As<bool>(false)} {
   if (this->GetAllowedUpdateTypes() ==
           cache::AllowedUpdateTypes::kFullAndIncremental &&
       !kIncrementalUpdates) {
@@ -553,7 +565,26 @@ void PostgreCache<PostgreCachePolicy>::Update(
   size_t changes = 0;
   // Iterate clusters
   for (auto& cluster : clusters_) {
-    if (chunk_size_ > 0) {
+    if (chunk_size_ > 0 && stream_chunks_) {
+      const pg::CommandControl cmd_ctl{timeout,
+                                       pg_cache::detail::kStatementTimeoutOff};
+      bool has_parameter = query.Statement().find('$') != std::string::npos;
+      auto stream =
+          has_parameter
+              ? cluster->Stream(kClusterHostTypeFlags, cmd_ctl, chunk_size_,
+                                query, GetLastUpdated(last_update, *data_cache))
+              : cluster->Stream(kClusterHostTypeFlags, cmd_ctl, chunk_size_,
+                                query);
+      while (stream) {
+        scope.Reset(std::string{pg_cache::detail::kFetchStage});
+        auto res = stream.Fetch();
+        stats_scope.IncreaseDocumentsReadCount(res.Size());
+
+        scope.Reset(std::string{pg_cache::detail::kParseStage});
+        CacheResults(res, data_cache, stats_scope, scope);
+        changes += res.Size();
+      }
+    } else if (chunk_size_ > 0) {
       auto trx = cluster->Begin(
           kClusterHostTypeFlags, pg::Transaction::RO,
           pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
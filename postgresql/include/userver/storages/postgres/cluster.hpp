@@ -15,6 +15,7 @@
 #include <userver/storages/postgres/detail/non_transaction.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
@@ -47,6 +48,33 @@
 /// Master host is queried about synchronous replication status. We use this
 /// info to identify synchronous slaves and to detect "quorum commit" presence.
 
+/// @page pg_multiplexing uPg: Multiplexed statements out of transactions
+///
+/// By default every Cluster::Execute takes a connection of the pool for the
+/// whole roundtrip of the statement, so the number of connections grows with
+/// the number of concurrent statements. With the `multiplexed_connections`
+/// option of the component the single statements out of transactions are
+/// instead executed over that many connections shared by all the tasks.
+///
+/// Each shared connection works in the pipeline mode. The statements queued
+/// while the connection waits for the previous results are sent in a single
+/// batch and their results are received in a single roundtrip, which reduces
+/// the number of connections and syscalls under a high load.
+///
+/// Every statement is still executed in a separate implicit transaction, an
+/// error fails only its own statement and does not affect the other
+/// statements of the batch. The statement timeout is set locally for each
+/// statement. The execute timeout includes the time in the queue, the
+/// statement may be executed by the server even if the caller has timed out.
+///
+/// Transactions use the connections of the pool as usual. The shared
+/// connections count toward the `max_pool_size`.
+///
+/// @warning The option requires libpq with the pipeline mode support
+/// (PostgreSQL 14+), otherwise it is ignored with a warning.
+///
+/// See also: @ref pg_run_queries
+
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
@@ -146,6 +174,7 @@ class Cluster {
   /// @}
 
   /// @name Single-statement query in an auto-commit transaction
+  /// @see @ref pg_multiplexing
   /// @{
 
   /// @brief Execute a statement at host of specified type.
@@ -183,6 +212,35 @@ class Cluster {
                     const Query& query, const ParameterStore& store);
   /// @}
 
+  /// @name Streaming of a large result set out of transaction
+  /// @see @ref pg_result_stream
+  /// @{
+
+  /// @brief Start a statement at host of specified type, its rows are
+  /// received in chunks of at most chunk_size rows.
+  /// @note You must specify at least one role from ClusterHostType here
+  ///
+  /// @warning Do NOT create a query string manually by embedding arguments!
+  /// It leads to vulnerabilities and bad performance. Either pass arguments
+  /// separately, or use storages::postgres::ParameterScope.
+  template <typename... Args>
+  ResultStream Stream(ClusterHostTypeFlags, std::size_t chunk_size,
+                      const Query& query, const Args&... args);
+
+  /// @brief Start a statement with specified host selection rules and command
+  /// control settings, its rows are received in chunks of at most chunk_size
+  /// rows.
+  /// @note You must specify at least one role from ClusterHostType here
+  ///
+  /// @warning Do NOT create a query string manually by embedding arguments!
+  /// It leads to vulnerabilities and bad performance. Either pass arguments
+  /// separately, or use storages::postgres::ParameterScope.
+  template <typename... Args>
+  ResultStream Stream(ClusterHostTypeFlags, OptionalCommandControl,
+                      std::size_t chunk_size, const Query& query,
+                      const Args&... args);
+  /// @}
+
   /// Replaces globally updated command control with a static user-provided one
   void SetDefaultCommandControl(CommandControl);
 
@@ -206,6 +264,8 @@ class Cluster {
 
  private:
   detail::NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
+  ResultStream MakeResultStream(ClusterHostTypeFlags, OptionalCommandControl,
+                                std::size_t chunk_size);
 
   OptionalCommandControl GetQueryCmdCtl(const std::string& query_name) const;
   OptionalCommandControl GetHandlersCmdCtl(
@@ -232,6 +292,26 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
   return ntrx.Execute(statement_cmd_ctl, query, args...);
 }
 
+template <typename... Args>
+ResultStream Cluster::Stream(ClusterHostTypeFlags flags, std::size_t chunk_size,
+                             const Query& query, const Args&... args) {
+  return Stream(flags, OptionalCommandControl{}, chunk_size, query, args...);
+}
+
+template <typename... Args>
+ResultStream Cluster::Stream(ClusterHostTypeFlags flags,
+                             OptionalCommandControl statement_cmd_ctl,
+                             std::size_t chunk_size, const Query& query,
+                             const Args&... args) {
+  if (!statement_cmd_ctl && query.GetName()) {
+    statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
+  }
+  statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  auto stream = MakeResultStream(flags, statement_cmd_ctl, chunk_size);
+  stream.Start(query, args...);
+  return stream;
+}
+
 }  // namespace storages::postgres
 
 USERVER_NAMESPACE_END
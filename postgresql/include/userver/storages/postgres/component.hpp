@@ -122,11 +122,13 @@ namespace components {
 /// ignore_unused_query_params| disable check for not-NULL query params that are not used in query| false
 /// monitoring-dbalias      | name of the database for monitorings                      | calculated from dbalias or dbconnection options
 /// max_prepared_cache_size | prepared statements cache size limit                      | 5000
+/// prepared_warmup_size    | number of the recently prepared statements to prepare on new connections (0 - disabled) | 0
 /// max_statement_metrics   | limit of exported metrics for named statements            | 0
 /// min_pool_size           | number of connections created initially                   | 4
 /// max_pool_size           | maximum number of created connections                     | 15
 /// max_queue_size          | maximum number of clients waiting for a connection        | 200
 /// pipeline_enabled        | turn on pipeline mode                                     | false
+/// multiplexed_connections | number of pipelined connections shared by the statements out of transactions (0 - disabled), see @ref pg_multiplexing | 0
 /// connecting_limit        | limit for concurrent establishing connections number per pool (0 - unlimited) | 0
 
 // clang-format on
@@ -0,0 +1,279 @@
+#pragma once
+
+/// @file userver/storages/postgres/copy.hpp
+/// @brief Binary COPY streams
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/supported_types.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @page pg_copy uPg: Bulk data transfer with COPY
+///
+/// `COPY ... FROM STDIN` and `COPY ... TO STDOUT` statements in the binary
+/// format transfer rows much faster than INSERT or SELECT statements, as
+/// the server does not parse, plan and execute a statement per row or per a
+/// batch of rows.
+///
+/// The rows are encoded and decoded with the same formatters and parsers as
+/// the query parameters and the result sets, so any type supported by uPg
+/// (see @ref pg_types) can be used for the columns, including arrays and
+/// composite types. A row can be passed as separate columns or as a tuple or
+/// a struct with the kRowTag.
+///
+/// The data is streamed over the connection of a transaction, the
+/// connection can not be used for other queries until the COPY is finished.
+/// The stream waits for the socket while the server is not keeping up with
+/// the data, so the memory usage does not depend on the size of the data.
+///
+/// The network timeout of the command control applies to each network
+/// operation of the COPY, the statement timeout applies to the whole COPY.
+///
+/// @par COPY FROM STDIN
+///
+/// @snippet storages/postgres/tests/copy_pgtest.cpp CopyIn
+///
+/// If the stream is destroyed without CopyInStream::Finish, the COPY is
+/// aborted and the transaction is failed.
+///
+/// @par COPY TO STDOUT
+///
+/// @snippet storages/postgres/tests/copy_pgtest.cpp CopyOut
+///
+/// If the stream is destroyed before reading all the rows, the COPY is
+/// cancelled and the rest of the data is skipped.
+///
+/// @warning COPY is not supported in the pipeline mode.
+///
+/// See also: @ref pg_run_queries
+
+namespace detail::copy {
+
+/// Signature of the binary COPY data
+inline constexpr std::string_view kSignature{"PGCOPY\n\377\r\n\0", 11};
+/// Field count of the trailer of the binary COPY data
+inline constexpr Smallint kTrailer = -1;
+
+}  // namespace detail::copy
+
+/// @brief Stream of rows for a binary `COPY ... FROM STDIN` statement.
+///
+/// Should be retrieved by calling storages::postgres::Transaction::CopyIn().
+/// The rows are buffered and sent to the server in chunks.
+///
+/// Non-copyable.
+class CopyInStream {
+ public:
+  /// Chunk of the data that is sent to the server at once
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+
+  CopyInStream(detail::Connection* conn, const Query& copy_statement,
+               OptionalCommandControl statement_cmd_ctl = {});
+
+  CopyInStream(CopyInStream&&) noexcept;
+  CopyInStream& operator=(CopyInStream&&) noexcept;
+
+  CopyInStream(const CopyInStream&) = delete;
+  CopyInStream& operator=(const CopyInStream&) = delete;
+
+  /// Aborts the COPY if it is not finished
+  ~CopyInStream();
+
+  /// Write a row of columns
+  template <typename... Columns>
+  void Write(const Columns&... columns);
+
+  /// Write a row from a tuple, an aggregate or a struct with Introspect()
+  template <typename Row>
+  void Write(RowTag, const Row& row);
+
+  /// Write all the rows of the container, each element is a row
+  template <typename Container>
+  void WriteRows(const Container& rows);
+
+  /// Send the rest of the rows and finish the COPY
+  /// @returns the number of rows copied
+  std::size_t Finish();
+
+  /// Number of the rows written so far
+  std::size_t RowsWritten() const { return rows_written_; }
+
+ private:
+  template <typename Tuple, std::size_t... Indexes>
+  void WriteTuple(const Tuple& tuple, std::index_sequence<Indexes...>);
+
+  const UserTypes& GetUserTypes() const;
+  void BeginRow(std::size_t field_count);
+  void EndRow();
+  void CheckActive() const;
+  void Abort() noexcept;
+
+  detail::Connection* conn_{nullptr};
+  OptionalCommandControl cmd_ctl_;
+  std::string buffer_;
+  std::size_t rows_written_{0};
+};
+
+/// @brief Stream of rows of a binary `COPY ... TO STDOUT` statement.
+///
+/// Should be retrieved by calling storages::postgres::Transaction::CopyOut().
+///
+/// Non-copyable.
+class CopyOutStream {
+ public:
+  CopyOutStream(detail::Connection* conn, const Query& copy_statement,
+                OptionalCommandControl statement_cmd_ctl = {});
+
+  CopyOutStream(CopyOutStream&&) noexcept;
+  CopyOutStream& operator=(CopyOutStream&&) noexcept;
+
+  CopyOutStream(const CopyOutStream&) = delete;
+  CopyOutStream& operator=(const CopyOutStream&) = delete;
+
+  /// Cancels the COPY if not all of the rows are read
+  ~CopyOutStream();
+
+  /// Read the next row into the columns
+  /// @returns false if there are no more rows
+  template <typename... Columns>
+  bool Read(Columns&... columns);
+
+  /// Read the next row into a tuple, an aggregate or a struct with
+  /// Introspect()
+  /// @returns false if there are no more rows
+  template <typename Row>
+  bool Read(RowTag, Row& row);
+
+  /// Read all the remaining rows into a container, each element is a row
+  template <typename Container>
+  Container AsContainer(RowTag);
+
+  /// Number of the rows read so far
+  std::size_t RowsRead() const { return rows_read_; }
+
+  /// True if all the rows are read
+  bool Done() const { return conn_ == nullptr; }
+
+ private:
+  template <typename Tuple, std::size_t... Indexes>
+  void ReadTuple(Tuple&& tuple, std::index_sequence<Indexes...>);
+
+  template <typename T>
+  void ReadField(const io::TypeBufferCategory& categories, std::size_t index,
+                 T& value);
+
+  const io::TypeBufferCategory& GetTypeBufferCategories() const;
+  /// Receives the next row and checks its field count, positions the buffer
+  /// at the first field
+  bool BeginRow(std::size_t field_count);
+  void EndRow();
+  void Abort() noexcept;
+
+  detail::Connection* conn_{nullptr};
+  OptionalCommandControl cmd_ctl_;
+  std::string message_;
+  io::FieldBuffer fields_;
+  std::size_t rows_read_{0};
+  bool is_header_read_{false};
+};
+
+template <typename... Columns>
+void CopyInStream::Write(const Columns&... columns) {
+  static_assert(sizeof...(Columns) > 0, "A row must have columns");
+  WriteTuple(std::forward_as_tuple(columns...),
+             std::index_sequence_for<Columns...>{});
+}
+
+template <typename Row>
+void CopyInStream::Write(RowTag, const Row& row) {
+  using RowType = io::RowType<Row>;
+  WriteTuple(RowType::GetTuple(row), typename RowType::IndexSequence{});
+}
+
+template <typename Container>
+void CopyInStream::WriteRows(const Container& rows) {
+  for (const auto& row : rows) {
+    Write(kRowTag, row);
+  }
+}
+
+template <typename Tuple, std::size_t... Indexes>
+void CopyInStream::WriteTuple(const Tuple& tuple,
+                              std::index_sequence<Indexes...>) {
+  const auto& types = GetUserTypes();
+  const auto row_start = buffer_.size();
+  BeginRow(sizeof...(Indexes));
+  try {
+    (io::WriteRawBinary(types, buffer_, std::get<Indexes>(tuple)), ...);
+  } catch (const std::exception&) {
+    // a partially written row would corrupt the data
+    buffer_.resize(row_start);
+    throw;
+  }
+  EndRow();
+}
+
+template <typename... Columns>
+bool CopyOutStream::Read(Columns&... columns) {
+  static_assert(sizeof...(Columns) > 0, "A row must have columns");
+  if (!BeginRow(sizeof...(Columns))) return false;
+  ReadTuple(std::forward_as_tuple(columns...),
+            std::index_sequence_for<Columns...>{});
+  EndRow();
+  return true;
+}
+
+template <typename Row>
+bool CopyOutStream::Read(RowTag, Row& row) {
+  using RowType = io::RowType<Row>;
+  if (!BeginRow(RowType::size)) return false;
+  ReadTuple(RowType::GetTuple(row), typename RowType::IndexSequence{});
+  EndRow();
+  return true;
+}
+
+template <typename Container>
+Container CopyOutStream::AsContainer(RowTag) {
+  Container result;
+  typename Container::value_type row;
+  while (Read(kRowTag, row)) {
+    io::traits::Inserter(result) = std::move(row);
+  }
+  return result;
+}
+
+template <typename Tuple, std::size_t... Indexes>
+void CopyOutStream::ReadTuple(Tuple&& tuple, std::index_sequence<Indexes...>) {
+  const auto& categories = GetTypeBufferCategories();
+  (ReadField(categories, Indexes, std::get<Indexes>(tuple)), ...);
+}
+
+template <typename T>
+void CopyOutStream::ReadField(const io::TypeBufferCategory& categories,
+                              std::size_t index, T& value) {
+  try {
+    fields_.ReadRaw(value, categories, io::traits::kTypeBufferCategory<T>);
+  } catch (ResultSetError& e) {
+    e.AddMsgSuffix(fmt::format(" (COPY row #{}, column #{})", rows_read_,
+                               index));
+    throw;
+  }
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
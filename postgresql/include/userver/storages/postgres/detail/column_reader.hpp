@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <boost/endian/conversion.hpp>
+
+#include <userver/compiler/demangle.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/floating_point_types.hpp>
+#include <userver/storages/postgres/io/integral_types.hpp>
+#include <userver/storages/postgres/io/traits.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// The cells of a column are gathered and decoded in blocks of this size, so
+/// that the buffers of a block fit into the stack
+inline constexpr std::size_t kColumnBlockRows = 256;
+
+/// Buffers of the cells of the rows [first_row, first_row + count) of the
+/// column, the format and the buffer category of the column are resolved once
+/// for all of them
+void GetColumnBuffers(const ResultWrapperPtr& res, std::size_t col,
+                      std::size_t first_row, std::size_t count,
+                      io::FieldBuffer* buffers);
+
+std::string_view GetColumnName(const ResultWrapperPtr& res, std::size_t col);
+
+const io::TypeBufferCategory& GetColumnTypeBufferCategories(
+    const ResultWrapperPtr& res);
+
+/// Fixed width types that are decoded a block at a time without their
+/// parsers: the big endian values of a block are copied into a contiguous
+/// array, then the byte order of the whole array is converted in a loop that
+/// the compiler can vectorize.
+template <typename T>
+struct FixedWidthColumn : std::false_type {};
+
+template <typename T>
+struct FixedWidthBitsColumn : std::true_type {
+  using WireType = typename io::detail::IntegralType<sizeof(T)>::type;
+
+  static void Decode(const WireType* wire, std::size_t count, T* values) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto native = boost::endian::big_to_native(wire[i]);
+      std::memcpy(values + i, &native, sizeof(T));
+    }
+  }
+};
+
+template <>
+struct FixedWidthColumn<Smallint> : FixedWidthBitsColumn<Smallint> {};
+template <>
+struct FixedWidthColumn<Integer> : FixedWidthBitsColumn<Integer> {};
+template <>
+struct FixedWidthColumn<Bigint> : FixedWidthBitsColumn<Bigint> {};
+template <>
+struct FixedWidthColumn<io::detail::AltInteger>
+    : FixedWidthBitsColumn<io::detail::AltInteger> {};
+template <>
+struct FixedWidthColumn<float> : FixedWidthBitsColumn<float> {};
+template <>
+struct FixedWidthColumn<double> : FixedWidthBitsColumn<double> {};
+
+template <typename T>
+struct FixedWidthTimestampColumn : std::true_type {
+  using WireType = Bigint;
+
+  static void Decode(const WireType* wire, std::size_t count, T* values) {
+    const auto pg_epoch = PostgresEpochTimePoint();
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto usec = boost::endian::big_to_native(wire[i]);
+      if (usec == std::numeric_limits<Bigint>::max()) {
+        values[i] = T{kTimestampPositiveInfinity};
+      } else if (usec == std::numeric_limits<Bigint>::min()) {
+        values[i] = T{kTimestampNegativeInfinity};
+      } else {
+        values[i] = T{pg_epoch + std::chrono::microseconds{usec}};
+      }
+    }
+  }
+};
+
+template <>
+struct FixedWidthColumn<TimePoint> : FixedWidthTimestampColumn<TimePoint> {};
+template <>
+struct FixedWidthColumn<TimePointTz>
+    : FixedWidthTimestampColumn<TimePointTz> {};
+
+template <typename T>
+struct FixedWidthValue {
+  using type = T;
+  static constexpr bool kIsOptional = false;
+};
+
+template <typename T>
+struct FixedWidthValue<std::optional<T>> {
+  using type = T;
+  static constexpr bool kIsOptional = true;
+};
+
+/// Decodes a column of a result set into a vector, the parser of the column
+/// is resolved once and the values are decoded a block at a time
+template <typename T>
+struct ColumnReader {
+  static void Read(const ResultWrapperPtr& res, std::size_t col,
+                   std::size_t rows, std::vector<T>& column) {
+    using ValueType = typename FixedWidthValue<T>::type;
+    column.resize(rows);
+    try {
+      if constexpr (FixedWidthColumn<ValueType>::value) {
+        if (ReadFixedWidth(res, col, rows, column.data())) return;
+      }
+      ReadParsed(res, col, rows, column.data());
+    } catch (ResultSetError& ex) {
+      ex.AddMsgSuffix(fmt::format(
+          " (column #{} name `{}` C++ type `{}`. Postgres ResultSet error)",
+          col, GetColumnName(res, col), compiler::GetTypeName<T>()));
+      throw;
+    }
+  }
+
+ private:
+  static void ReadParsed(const ResultWrapperPtr& res, std::size_t col,
+                         std::size_t rows, T* values) {
+    const auto& categories = GetColumnTypeBufferCategories(res);
+    std::array<io::FieldBuffer, kColumnBlockRows> buffers;
+    for (std::size_t first = 0; first < rows; first += kColumnBlockRows) {
+      const auto count = std::min(kColumnBlockRows, rows - first);
+      GetColumnBuffers(res, col, first, count, buffers.data());
+      for (std::size_t i = 0; i < count; ++i) {
+        auto& value = values[first + i];
+        if (buffers[i].is_null) {
+          if constexpr (io::traits::kIsNullable<T>) {
+            io::traits::GetSetNull<T>::SetNull(value);
+          } else {
+            throw FieldValueIsNull{col, GetColumnName(res, col), value};
+          }
+        } else {
+          io::ReadBuffer(buffers[i], value, categories);
+        }
+      }
+    }
+  }
+
+  /// @returns false if the values of the column are not of the width of the
+  /// type, e.g. for a smallint column read into integers, then the values are
+  /// to be parsed
+  static bool ReadFixedWidth(const ResultWrapperPtr& res, std::size_t col,
+                             std::size_t rows, T* values) {
+    using Value = FixedWidthValue<T>;
+    using ValueType = typename Value::type;
+    using Column = FixedWidthColumn<ValueType>;
+    using WireType = typename Column::WireType;
+    using ParserType = typename io::traits::IO<ValueType>::ParserType;
+
+    std::array<io::FieldBuffer, kColumnBlockRows> buffers;
+    std::array<WireType, kColumnBlockRows> wire;
+    for (std::size_t first = 0; first < rows; first += kColumnBlockRows) {
+      const auto count = std::min(kColumnBlockRows, rows - first);
+      GetColumnBuffers(res, col, first, count, buffers.data());
+      if (buffers[0].category !=
+          io::traits::kParserBufferCategory<ParserType>) {
+        return false;
+      }
+      bool has_nulls = false;
+      for (std::size_t i = 0; i < count; ++i) {
+        const auto& buffer = buffers[i];
+        if (buffer.is_null) {
+          if constexpr (Value::kIsOptional) {
+            has_nulls = true;
+            wire[i] = 0;
+            continue;
+          } else {
+            throw FieldValueIsNull{col, GetColumnName(res, col),
+                                   values[first + i]};
+          }
+        }
+        if (buffer.length != sizeof(WireType)) return false;
+        std::memcpy(&wire[i], buffer.buffer, sizeof(WireType));
+      }
+
+      if constexpr (Value::kIsOptional) {
+        std::array<ValueType, kColumnBlockRows> decoded;
+        Column::Decode(wire.data(), count, decoded.data());
+        for (std::size_t i = 0; i < count; ++i) {
+          if (has_nulls && buffers[i].is_null) {
+            values[first + i].reset();
+          } else {
+            values[first + i] = decoded[i];
+          }
+        }
+      } else {
+        Column::Decode(wire.data(), count, values + first);
+      }
+    }
+    return true;
+  }
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
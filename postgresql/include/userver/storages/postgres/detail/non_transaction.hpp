@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
 
 #include <userver/storages/postgres/options.hpp>
@@ -16,12 +18,20 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::detail {
 
+/// Writes the query parameters with the user types of the connection that
+/// executes the statement, the result is valid until the statement is executed
+using ParamsWriter = std::function<QueryParameters(const UserTypes&)>;
+
 class NonTransaction {
  public:
   explicit NonTransaction(
       ConnectionPtr&& conn,
       SteadyClock::time_point start_time = detail::SteadyClock::now());
 
+  /// The statements are multiplexed over the pipelined connections of the
+  /// pool, see @ref pg_multiplexing
+  explicit NonTransaction(std::shared_ptr<ConnectionPool> multiplexing_pool);
+
   NonTransaction(NonTransaction&&) noexcept;
   NonTransaction& operator=(NonTransaction&&) noexcept;
 
@@ -48,6 +58,14 @@ class NonTransaction {
   ResultSet Execute(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const Args&... args) {
     detail::StaticQueryParameters<sizeof...(args)> params;
+    if (multiplexing_pool_) {
+      auto writer = [&params, &args...](const UserTypes& types) {
+        params.Write(types, args...);
+        return detail::QueryParameters{params};
+      };
+      return DoExecuteMultiplexed(query, ParamsWriter{std::ref(writer)},
+                                  statement_cmd_ctl);
+    }
     params.Write(GetConnectionUserTypes(), args...);
     return DoExecute(query, detail::QueryParameters{params}, statement_cmd_ctl);
   }
@@ -68,9 +86,12 @@ class NonTransaction {
  private:
   ResultSet DoExecute(const Query& query, const detail::QueryParameters& params,
                       OptionalCommandControl statement_cmd_ctl);
+  ResultSet DoExecuteMultiplexed(const Query& query, const ParamsWriter& writer,
+                                 OptionalCommandControl statement_cmd_ctl);
   const UserTypes& GetConnectionUserTypes() const;
 
   detail::ConnectionPtr conn_;
+  std::shared_ptr<ConnectionPool> multiplexing_pool_;
 };
 
 }  // namespace storages::postgres::detail
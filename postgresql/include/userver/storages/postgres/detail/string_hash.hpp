@@ -12,6 +12,13 @@ inline std::size_t StrHash(const std::string_view& str) {
   return StrHash(str.data(), str.size());
 }
 
+/// Hash of a statement text that does not depend on the whitespace between
+/// the tokens, so that the statements that differ only in formatting share a
+/// prepared statement. Quoted literals and identifiers are hashed verbatim,
+/// as is the rest of the statement after a comment, a dollar quote or a
+/// backslash.
+std::size_t QueryTextHash(std::string_view statement);
+
 struct StringViewHash {
   std::size_t operator()(const std::string_view& str) const {
     return StrHash(str);
@@ -214,6 +214,13 @@ struct ConnectionSettings {
   CheckQueryParamsOptions ignore_unused_query_params = kCheckUnused;
   size_t max_prepared_cache_size = kDefaultMaxPreparedCacheSize;
   PipelineMode pipeline_mode = kPipelineDisabled;
+  /// Number of pipelined connections shared by the statements executed out of
+  /// transactions, 0 disables the multiplexing
+  size_t multiplexed_connections = 0;
+  /// Number of the statements most recently prepared by the connections of a
+  /// pool that are prepared on its new connections, 0 disables the warmup.
+  /// The connections in the pipeline mode are not warmed up.
+  size_t prepared_warmup_size = 0;
 };
 
 /// @brief PostgreSQL statements metrics options
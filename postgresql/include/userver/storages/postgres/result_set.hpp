@@ -8,6 +8,7 @@
 #include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -637,6 +638,26 @@ class ResultSet {
   template <typename T>
   auto AsSingleRow(FieldTag) const;
   //@}
+
+  //@{
+  /** @name Columnar results */
+  /// @brief Extract the columns in order of their appearance into vectors,
+  /// a vector per column.
+  /// For more information see @ref psql_typed_results
+  template <typename... T>
+  std::tuple<std::vector<T>...> AsColumns() const;
+  /// @brief Extract the columns into a row type with vector data members.
+  /// For more information see @ref psql_typed_results
+  template <typename Columns>
+  Columns AsColumns(RowTag) const;
+
+  /// @brief Extract the columns into the vectors, the vectors are resized to
+  /// the number of rows and their storage is reused.
+  template <typename... T>
+  void ToColumns(std::vector<T>&... columns) const;
+  template <typename Columns>
+  void ToColumns(Columns& columns, RowTag) const;
+  //@}
  private:
   friend class detail::ConnectionImpl;
   void FillBufferCategories(const UserTypes& types);
@@ -645,6 +666,10 @@ class ResultSet {
   template <typename T, typename Tag>
   friend class TypedResultSet;
 
+  template <std::size_t... Indexes, typename... T>
+  void ReadColumns(std::index_sequence<Indexes...>,
+                   std::vector<T>&... columns) const;
+
   std::shared_ptr<detail::ResultWrapper> pimpl_;
 };
 
@@ -692,6 +717,9 @@ struct RowDataExtractorBase<std::index_sequence<Indexes...>, T...> {
   }
 };
 
+template <typename T>
+struct ColumnReader;
+
 template <typename... T>
 struct RowDataExtractor
     : RowDataExtractorBase<std::index_sequence_for<T...>, T...> {};
@@ -882,8 +910,56 @@ auto ResultSet::AsSingleRow(FieldTag) const {
   return Front().As<T>(kFieldTag);
 }
 
+template <typename... T>
+std::tuple<std::vector<T>...> ResultSet::AsColumns() const {
+  std::tuple<std::vector<T>...> columns;
+  std::apply([this](auto&... column) { ToColumns(column...); }, columns);
+  return columns;
+}
+
+template <typename Columns>
+Columns ResultSet::AsColumns(RowTag) const {
+  Columns columns;
+  ToColumns(columns, kRowTag);
+  return columns;
+}
+
+template <typename... T>
+void ResultSet::ToColumns(std::vector<T>&... columns) const {
+  if (sizeof...(T) > FieldCount()) {
+    throw InvalidTupleSizeRequested(FieldCount(), sizeof...(T));
+  }
+  ReadColumns(std::index_sequence_for<T...>{}, columns...);
+}
+
+template <typename Columns>
+void ResultSet::ToColumns(Columns& columns, RowTag) const {
+  static_assert(io::traits::kIsRowType<Columns>,
+                "This type cannot be used as a row type");
+  using RowType = io::RowType<Columns>;
+  constexpr auto tuple_size = RowType::size;
+  if (tuple_size > FieldCount()) {
+    throw InvalidTupleSizeRequested(FieldCount(), tuple_size);
+  } else if (tuple_size < FieldCount()) {
+    LOG_LIMITED_WARNING()
+        << "Row size is greater that the number of data members in "
+           "C++ user datatype "
+        << compiler::GetTypeName<Columns>();
+  }
+  std::apply([this](auto&... column) { ToColumns(column...); },
+             RowType::GetTuple(columns));
+}
+
+template <std::size_t... Indexes, typename... T>
+void ResultSet::ReadColumns(std::index_sequence<Indexes...>,
+                            std::vector<T>&... columns) const {
+  const auto rows = Size();
+  (detail::ColumnReader<T>::Read(pimpl_, Indexes, rows, columns), ...);
+}
+
 }  // namespace storages::postgres
 
 USERVER_NAMESPACE_END
 
+#include <userver/storages/postgres/detail/column_reader.hpp>
 #include <userver/storages/postgres/typed_result_set.hpp>
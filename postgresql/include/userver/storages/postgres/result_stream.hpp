@@ -0,0 +1,104 @@
+#pragma once
+
+/// @file userver/storages/postgres/result_stream.hpp
+/// @brief Streaming of large result sets out of transactions
+
+#include <cstddef>
+
+#include <userver/storages/postgres/detail/connection_ptr.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/parameter_store.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @page pg_result_stream uPg: Streaming of large result sets
+///
+/// A ResultSet holds all the rows of a statement, so a large SELECT needs
+/// the memory for the whole result before the first row can be parsed, and
+/// the parsed values take as much memory again. A Portal fetches the rows in
+/// chunks, but requires a transaction and a roundtrip per chunk.
+///
+/// ResultStream executes a single statement out of a transaction and
+/// receives its rows in chunks of at most the requested size, as the server
+/// sends them. Each chunk is a ResultSet of its own, so the usual means of
+/// @ref pg_process_results apply to it, e.g. ResultSet::AsSetOf. Only the
+/// memory for a chunk is needed at a time, and the server keeps sending the
+/// next rows while a chunk is parsed.
+///
+/// @snippet storages/postgres/tests/result_stream_pgtest.cpp ResultStream
+///
+/// The rows are received in the chunked rows mode of libpq 17+, or are
+/// gathered from the single row mode with older libpq.
+///
+/// The network timeout of the command control applies to receiving each
+/// chunk, the statement timeout applies to the whole statement. The
+/// connection is busy until all the rows are received, if the stream is
+/// destroyed before that the statement is cancelled.
+///
+/// See also: @ref pg_run_queries
+
+/// @brief Chunks of the rows of a statement being received.
+///
+/// Should be retrieved by calling storages::postgres::Cluster::Stream().
+///
+/// Non-copyable.
+class ResultStream {
+ public:
+  ResultStream(ResultStream&&) noexcept;
+  ResultStream& operator=(ResultStream&&) noexcept;
+
+  ResultStream(const ResultStream&) = delete;
+  ResultStream& operator=(const ResultStream&) = delete;
+
+  /// Cancels the statement if not all of the rows are received
+  ~ResultStream();
+
+  /// Receive the next chunk of at most the chunk size rows, the last chunk
+  /// may have less rows or no rows at all
+  /// @throws RuntimeError if all the rows are already received
+  ResultSet Fetch();
+
+  /// Number of the rows received so far
+  std::size_t FetchedSoFar() const { return fetched_so_far_; }
+
+  /// True if all the rows are received
+  bool Done() const { return !conn_; }
+
+  explicit operator bool() const { return !Done(); }
+
+ private:
+  friend class Cluster;
+
+  ResultStream(detail::ConnectionPtr&& conn, std::size_t chunk_size,
+               OptionalCommandControl statement_cmd_ctl);
+
+  template <typename... Args>
+  void Start(const Query& query, const Args&... args) {
+    detail::StaticQueryParameters<sizeof...(args)> params;
+    params.Write(GetConnectionUserTypes(), args...);
+    DoStart(query, detail::QueryParameters{params});
+  }
+
+  void Start(const Query& query, const ParameterStore& store) {
+    DoStart(query, detail::QueryParameters{store.GetInternalData()});
+  }
+
+  void DoStart(const Query& query, const detail::QueryParameters& params);
+  const UserTypes& GetConnectionUserTypes() const;
+  void ReleaseConnection() noexcept;
+
+  detail::ConnectionPtr conn_;
+  std::size_t chunk_size_;
+  OptionalCommandControl cmd_ctl_;
+  std::size_t fetched_so_far_{0};
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
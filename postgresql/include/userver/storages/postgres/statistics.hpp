@@ -45,6 +45,12 @@ struct TransactionStatistics {
   /// to pretty uniqueness of names. Nevertheless we would like to see them to
   /// diagnose certain kinds of problems
   Counter duplicate_prepared_statements = 0;
+  /// Number of statements found in the prepared statements caches
+  Counter prepared_cache_hit = 0;
+  /// Number of statements missing in the prepared statements caches
+  Counter prepared_cache_miss = 0;
+  /// Number of prepared statements evicted to fit the cache size limit
+  Counter prepared_cache_evict = 0;
 
   // TODO pick reasonable resolution for transaction
   // execution times
@@ -168,6 +174,9 @@ struct InstanceStatisticsNonatomic : InstanceStatisticsNonatomicBase {
     transaction.execute_timeout = stats.transaction.execute_timeout;
     transaction.duplicate_prepared_statements =
         stats.transaction.duplicate_prepared_statements;
+    transaction.prepared_cache_hit = stats.transaction.prepared_cache_hit;
+    transaction.prepared_cache_miss = stats.transaction.prepared_cache_miss;
+    transaction.prepared_cache_evict = stats.transaction.prepared_cache_evict;
     transaction.total_percentile =
         stats.transaction.total_percentile.GetStatsForPeriod();
     transaction.busy_percentile =
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 
+#include <userver/storages/postgres/copy.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
@@ -246,6 +247,34 @@ class Transaction {
   Portal MakePortal(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// Start a binary `COPY ... FROM STDIN` statement and return the stream
+  /// for the rows. The transaction can not execute other statements until
+  /// the stream is finished.
+  ///
+  /// @see @ref pg_copy
+  CopyInStream CopyIn(const Query& copy_statement) {
+    return CopyIn(OptionalCommandControl{}, copy_statement);
+  }
+
+  /// Start a binary `COPY ... FROM STDIN` statement with per-statement
+  /// command control
+  CopyInStream CopyIn(OptionalCommandControl statement_cmd_ctl,
+                      const Query& copy_statement);
+
+  /// Start a binary `COPY ... TO STDOUT` statement and return the stream of
+  /// its rows. The transaction can not execute other statements until all
+  /// the rows are read or the stream is destroyed.
+  ///
+  /// @see @ref pg_copy
+  CopyOutStream CopyOut(const Query& copy_statement) {
+    return CopyOut(OptionalCommandControl{}, copy_statement);
+  }
+
+  /// Start a binary `COPY ... TO STDOUT` statement with per-statement
+  /// command control
+  CopyOutStream CopyOut(OptionalCommandControl statement_cmd_ctl,
+                        const Query& copy_statement);
+
   /// Set a connection parameter
   /// https://www.postgresql.org/docs/current/sql-set.html
   /// The parameter is set for this transaction only
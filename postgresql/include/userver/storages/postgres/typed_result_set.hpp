@@ -139,6 +139,29 @@ namespace storages::postgres {
 ///
 /// @endcode
 ///
+/// @par Columnar extraction
+///
+/// The result set can also be extracted column by column, into a vector per
+/// column. The parser of a column is resolved once for all of its values, and
+/// the values of fixed width types (integers, floating point numbers and
+/// timestamps) are copied and converted from network byte order in blocks
+/// of rows without calling their parsers. For results with many rows of a
+/// few columns this is considerably faster than extracting rows one by one.
+///
+/// The columns can be extracted into a tuple of vectors or into a row type
+/// with vector data members, struct-of-arrays style. std::optional elements
+/// accept null values.
+///
+/// @snippet storages/postgres/tests/columns_pgtest.cpp Columns
+/// @snippet storages/postgres/tests/columns_pgtest.cpp AsColumns
+///
+/// @code
+/// auto [ids, names] = generic_result.AsColumns<int, std::string>();
+///
+/// // Reuse the storage of the vectors, e.g. for each chunk of a portal
+/// generic_result.ToColumns(ids, names);
+/// @endcode
+///
 template <typename T, typename ExtractionTag>
 class TypedResultSet {
  public:
@@ -28,6 +28,10 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    stream-chunks:
+        type: boolean
+        description: fetch the chunks with a single statement out of transaction instead of a portal in a transaction
+        defaultDescription: false
     pgcomponent:
         type: string
         description: PostgreSQL component name
@@ -83,6 +83,13 @@ detail::NonTransaction Cluster::Start(ClusterHostTypeFlags flags,
   return pimpl_->Start(flags, cmd_ctl);
 }
 
+ResultStream Cluster::MakeResultStream(ClusterHostTypeFlags flags,
+                                       OptionalCommandControl cmd_ctl,
+                                       std::size_t chunk_size) {
+  return ResultStream{pimpl_->AcquireForStream(flags, cmd_ctl), chunk_size,
+                      cmd_ctl};
+}
+
 OptionalCommandControl Cluster::GetQueryCmdCtl(
     const std::string& query_name) const {
   return pimpl_->GetQueryCmdCtl(query_name);
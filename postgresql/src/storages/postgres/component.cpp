@@ -94,6 +94,10 @@ formats::json::ValueBuilder InstanceStatisticsToJson(
   errors["connection-timeout"] = stats.connection.error_timeout;
 
   instance["prepared-per-connection"] = stats.connection.prepared_statements;
+  auto prepared_cache = instance["prepared-cache"];
+  prepared_cache["hit"] = stats.transaction.prepared_cache_hit;
+  prepared_cache["miss"] = stats.transaction.prepared_cache_miss;
+  prepared_cache["evicted"] = stats.transaction.prepared_cache_evict;
   instance["roundtrip-time"] = stats.topology.roundtrip_time;
   instance["replication-lag"] = stats.topology.replication_lag;
 
@@ -236,6 +240,10 @@ Postgres::Postgres(const ComponentConfig& config,
   conn_settings.pipeline_mode = config["pipeline_enabled"].As<bool>(false)
                                     ? pg::ConnectionSettings::kPipelineEnabled
                                     : pg::ConnectionSettings::kPipelineDisabled;
+  conn_settings.multiplexed_connections =
+      config["multiplexed_connections"].As<size_t>(0);
+  conn_settings.prepared_warmup_size =
+      config["prepared_warmup_size"].As<size_t>(0);
 
   const auto task_processor_name =
       config["blocking_task_processor"].As<std::string>();
@@ -384,6 +392,10 @@ properties:
         type: integer
         description: prepared statements cache size limit
         defaultDescription: 5000
+    prepared_warmup_size:
+        type: integer
+        description: number of the recently prepared statements to prepare on new connections (0 - disabled)
+        defaultDescription: 0
     max_statement_metrics:
         type: integer
         description: limit of exported metrics for named statements
@@ -429,6 +441,10 @@ properties:
         type: boolean
         description: turns on pipeline connection mode
         defaultDescription: false
+    multiplexed_connections:
+        type: integer
+        description: number of pipelined connections shared by the statements out of transactions (0 - disabled)
+        defaultDescription: 0
     connecting_limit:
         type: integer
         description: limit for concurrent establishing connections number per pool (0 - unlimited)
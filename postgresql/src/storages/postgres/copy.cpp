@@ -0,0 +1,214 @@
+#include <userver/storages/postgres/copy.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+/// Flag of the binary COPY header denoting OIDs in the tuples
+constexpr Integer kHasOidsFlag = 1 << 16;
+
+}  // namespace
+
+CopyInStream::CopyInStream(detail::Connection* conn,
+                           const Query& copy_statement,
+                           OptionalCommandControl statement_cmd_ctl)
+    : conn_{conn}, cmd_ctl_{std::move(statement_cmd_ctl)} {
+  UASSERT(conn_);
+  if (!cmd_ctl_) {
+    cmd_ctl_ = conn_->GetQueryCmdCtl(copy_statement.GetName());
+  }
+  conn_->CopyStart(copy_statement, detail::Connection::CopyDirection::kIn,
+                   cmd_ctl_);
+
+  buffer_.reserve(kChunkSize * 2);
+  buffer_.append(detail::copy::kSignature);
+  const auto& types = conn_->GetUserTypes();
+  // flags
+  io::WriteBuffer(types, buffer_, Integer{0});
+  // header extension length
+  io::WriteBuffer(types, buffer_, Integer{0});
+}
+
+CopyInStream::CopyInStream(CopyInStream&& rhs) noexcept
+    : conn_{std::exchange(rhs.conn_, nullptr)},
+      cmd_ctl_{std::move(rhs.cmd_ctl_)},
+      buffer_{std::move(rhs.buffer_)},
+      rows_written_{rhs.rows_written_} {}
+
+CopyInStream& CopyInStream::operator=(CopyInStream&& rhs) noexcept {
+  if (this != &rhs) {
+    Abort();
+    conn_ = std::exchange(rhs.conn_, nullptr);
+    cmd_ctl_ = std::move(rhs.cmd_ctl_);
+    buffer_ = std::move(rhs.buffer_);
+    rows_written_ = rhs.rows_written_;
+  }
+  return *this;
+}
+
+CopyInStream::~CopyInStream() { Abort(); }
+
+std::size_t CopyInStream::Finish() {
+  CheckActive();
+  io::WriteBuffer(conn_->GetUserTypes(), buffer_, detail::copy::kTrailer);
+  conn_->CopyPutData(buffer_, cmd_ctl_);
+  buffer_.clear();
+  // the COPY data is over even if the server fails the COPY
+  auto* conn = std::exchange(conn_, nullptr);
+  return conn->CopyInFinish(cmd_ctl_);
+}
+
+const UserTypes& CopyInStream::GetUserTypes() const {
+  CheckActive();
+  return conn_->GetUserTypes();
+}
+
+void CopyInStream::BeginRow(std::size_t field_count) {
+  io::WriteBuffer(conn_->GetUserTypes(), buffer_,
+                  static_cast<Smallint>(field_count));
+}
+
+void CopyInStream::EndRow() {
+  ++rows_written_;
+  if (buffer_.size() >= kChunkSize) {
+    conn_->CopyPutData(buffer_, cmd_ctl_);
+    buffer_.clear();
+  }
+}
+
+void CopyInStream::CheckActive() const {
+  if (!conn_) {
+    throw LogicError{"COPY FROM STDIN stream is already finished"};
+  }
+}
+
+void CopyInStream::Abort() noexcept {
+  auto* conn = std::exchange(conn_, nullptr);
+  if (!conn) return;
+
+  LOG_INFO() << "COPY FROM STDIN stream is destroyed without an explicit "
+                "finish, aborting the COPY";
+  try {
+    conn->CopyAbort(detail::Connection::CopyDirection::kIn);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_ERROR() << "Exception when aborting COPY FROM STDIN: " << e;
+  }
+}
+
+CopyOutStream::CopyOutStream(detail::Connection* conn,
+                             const Query& copy_statement,
+                             OptionalCommandControl statement_cmd_ctl)
+    : conn_{conn}, cmd_ctl_{std::move(statement_cmd_ctl)} {
+  UASSERT(conn_);
+  if (!cmd_ctl_) {
+    cmd_ctl_ = conn_->GetQueryCmdCtl(copy_statement.GetName());
+  }
+  conn_->CopyStart(copy_statement, detail::Connection::CopyDirection::kOut,
+                   cmd_ctl_);
+}
+
+CopyOutStream::CopyOutStream(CopyOutStream&& rhs) noexcept
+    : conn_{std::exchange(rhs.conn_, nullptr)},
+      cmd_ctl_{std::move(rhs.cmd_ctl_)},
+      rows_read_{rhs.rows_read_},
+      is_header_read_{rhs.is_header_read_} {}
+
+CopyOutStream& CopyOutStream::operator=(CopyOutStream&& rhs) noexcept {
+  if (this != &rhs) {
+    Abort();
+    conn_ = std::exchange(rhs.conn_, nullptr);
+    cmd_ctl_ = std::move(rhs.cmd_ctl_);
+    rows_read_ = rhs.rows_read_;
+    is_header_read_ = rhs.is_header_read_;
+  }
+  return *this;
+}
+
+CopyOutStream::~CopyOutStream() { Abort(); }
+
+const io::TypeBufferCategory& CopyOutStream::GetTypeBufferCategories() const {
+  UASSERT(conn_);
+  return conn_->GetUserTypes().GetTypeBufferCategories();
+}
+
+bool CopyOutStream::BeginRow(std::size_t field_count) {
+  if (!conn_) return false;
+
+  // The server sends a row per message, the header comes with the first row
+  // and the trailer is sent separately
+  message_.clear();
+  if (!conn_->CopyGetData(message_, cmd_ctl_)) {
+    conn_ = nullptr;
+    throw InvalidBinaryBuffer{"COPY data ends without the trailer"};
+  }
+  fields_ = io::FieldBuffer{
+      false, io::BufferCategory::kPlainBuffer, message_.size(),
+      reinterpret_cast<const std::uint8_t*>(message_.data())};
+
+  if (!is_header_read_) {
+    if (message_.compare(0, detail::copy::kSignature.size(),
+                         detail::copy::kSignature) != 0) {
+      throw InvalidBinaryBuffer{"Invalid COPY data signature"};
+    }
+    fields_ = fields_.GetSubBuffer(detail::copy::kSignature.size());
+    Integer flags{0};
+    Integer extension_length{0};
+    fields_.Read(flags, io::BufferCategory::kPlainBuffer);
+    fields_.Read(extension_length, io::BufferCategory::kPlainBuffer);
+    if (flags & kHasOidsFlag) {
+      throw InvalidBinaryBuffer{"COPY data with OIDs is not supported"};
+    }
+    if (extension_length < 0) {
+      throw InvalidBinaryBuffer{"Negative COPY header extension length"};
+    }
+    fields_ = fields_.GetSubBuffer(extension_length);
+    is_header_read_ = true;
+  }
+
+  Smallint tuple_field_count{0};
+  fields_.Read(tuple_field_count, io::BufferCategory::kPlainBuffer);
+  if (tuple_field_count == detail::copy::kTrailer) {
+    // receives the result of the COPY, throws on errors
+    message_.clear();
+    if (conn_->CopyGetData(message_, cmd_ctl_)) {
+      throw InvalidBinaryBuffer{"COPY data after the trailer"};
+    }
+    conn_ = nullptr;
+    return false;
+  }
+  if (static_cast<std::size_t>(tuple_field_count) != field_count) {
+    throw FieldTupleMismatch{static_cast<std::size_t>(tuple_field_count),
+                             field_count};
+  }
+  return true;
+}
+
+void CopyOutStream::EndRow() {
+  if (fields_.length != 0) {
+    throw InvalidBinaryBuffer{"COPY row contains more data than its fields"};
+  }
+  ++rows_read_;
+}
+
+void CopyOutStream::Abort() noexcept {
+  auto* conn = std::exchange(conn_, nullptr);
+  if (!conn) return;
+
+  LOG_DEBUG() << "COPY TO STDOUT stream is destroyed before reading all the "
+                 "rows, cancelling the COPY";
+  try {
+    conn->CopyAbort(detail::Connection::CopyDirection::kOut);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_ERROR() << "Exception when cancelling COPY TO STDOUT: " << e;
+  }
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
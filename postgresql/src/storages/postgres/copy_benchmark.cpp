@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+// Loading of large batches takes longer than kBenchCmdCtl allows
+constexpr pg::CommandControl kLoadCmdCtl{std::chrono::seconds{30},
+                                         std::chrono::seconds{30}};
+
+struct Columns {
+  std::vector<pg::Bigint> ids;
+  std::vector<std::string> names;
+  std::vector<double> weights;
+};
+
+Columns MakeColumns(std::size_t rows) {
+  Columns columns;
+  for (std::size_t i = 0; i < rows; ++i) {
+    columns.ids.push_back(i);
+    columns.names.push_back("name " + std::to_string(i));
+    columns.weights.push_back(i * 0.5);
+  }
+  return columns;
+}
+
+void CreateTable(pg::detail::Connection& conn) {
+  conn.Execute(
+      "create temporary table copy_bench(id bigint, name text, "
+      "weight double precision)");
+}
+
+void BeginLoad(pg::detail::Connection& conn) {
+  conn.Begin({}, pg::detail::SteadyClock::now(), kLoadCmdCtl);
+}
+
+// The loaded rows are rolled back, so that each iteration loads into an empty
+// table
+void EndLoad(pg::detail::Connection& conn) { conn.Rollback(); }
+
+void CopyIn(benchmark::State& state, pg::detail::Connection& conn) {
+  const auto rows = static_cast<std::size_t>(state.range(0));
+  const auto columns = MakeColumns(rows);
+  CreateTable(conn);
+  for (auto _ : state) {
+    BeginLoad(conn);
+    pg::CopyInStream copy{
+        &conn, "copy copy_bench(id, name, weight) from stdin (format binary)",
+        kLoadCmdCtl};
+    for (std::size_t i = 0; i < rows; ++i) {
+      copy.Write(columns.ids[i], columns.names[i], columns.weights[i]);
+    }
+    benchmark::DoNotOptimize(copy.Finish());
+    EndLoad(conn);
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+void InsertUnnest(benchmark::State& state, pg::detail::Connection& conn) {
+  const auto rows = static_cast<std::size_t>(state.range(0));
+  const auto columns = MakeColumns(rows);
+  CreateTable(conn);
+  for (auto _ : state) {
+    BeginLoad(conn);
+    benchmark::DoNotOptimize(conn.Execute(
+        kLoadCmdCtl,
+        "insert into copy_bench(id, name, weight) "
+        "select * from unnest($1::bigint[], $2::text[], "
+        "$3::double precision[])",
+        columns.ids, columns.names, columns.weights));
+    EndLoad(conn);
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+void CopyOut(benchmark::State& state, pg::detail::Connection& conn) {
+  const auto rows = state.range(0);
+  for (auto _ : state) {
+    BeginLoad(conn);
+    pg::CopyOutStream copy{
+        &conn,
+        "copy (select i::bigint, 'name ' || i, i * 0.5::double precision "
+        "from generate_series(1, " +
+            std::to_string(rows) + ") i) to stdout (format binary)",
+        kLoadCmdCtl};
+    pg::Bigint id{0};
+    std::string name;
+    double weight{0};
+    while (copy.Read(id, name, weight)) {
+      benchmark::DoNotOptimize(id);
+    }
+    EndLoad(conn);
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+void SelectGenerated(benchmark::State& state, pg::detail::Connection& conn) {
+  const auto rows = state.range(0);
+  for (auto _ : state) {
+    BeginLoad(conn);
+    auto res = conn.Execute(
+        kLoadCmdCtl,
+        "select i::bigint, 'name ' || i, i * 0.5::double precision "
+        "from generate_series(1, $1) i",
+        rows);
+    pg::Bigint id{0};
+    std::string name;
+    double weight{0};
+    for (const auto& row : res) {
+      row.To(id, name, weight);
+      benchmark::DoNotOptimize(id);
+    }
+    EndLoad(conn);
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+BENCHMARK_DEFINE_F(PgConnection, CopyIn)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] { CopyIn(state, GetConnection()); });
+}
+BENCHMARK_REGISTER_F(PgConnection, CopyIn)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+BENCHMARK_DEFINE_F(PgConnection, InsertUnnest)(benchmark::State& state) {
+  RunStandalone(state,
+                [this, &state] { InsertUnnest(state, GetConnection()); });
+}
+BENCHMARK_REGISTER_F(PgConnection, InsertUnnest)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+BENCHMARK_DEFINE_F(PgConnection, CopyOut)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] { CopyOut(state, GetConnection()); });
+}
+BENCHMARK_REGISTER_F(PgConnection, CopyOut)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+BENCHMARK_DEFINE_F(PgConnection, SelectGenerated)(benchmark::State& state) {
+  RunStandalone(state,
+                [this, &state] { SelectGenerated(state, GetConnection()); });
+}
+BENCHMARK_REGISTER_F(PgConnection, SelectGenerated)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -263,6 +263,16 @@ NonTransaction ClusterImpl::Start(ClusterHostTypeFlags flags,
   return FindPool(flags)->Start(cmd_ctl);
 }
 
+ConnectionPtr ClusterImpl::AcquireForStream(ClusterHostTypeFlags flags,
+                                            OptionalCommandControl cmd_ctl) {
+  if (!(flags & kClusterHostRolesMask)) {
+    throw LogicError(
+        "Host role must be specified for execution of a single statement");
+  }
+  LOG_TRACE() << "Requested result stream on " << flags;
+  return FindPool(flags)->AcquireForStream(cmd_ctl);
+}
+
 void ClusterImpl::SetDefaultCommandControl(CommandControl cmd_ctl,
                                            DefaultCommandControlSource source) {
   default_cmd_ctls_.UpdateDefaultCmdCtl(cmd_ctl, source);
@@ -40,6 +40,8 @@ class ClusterImpl {
 
   NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  ConnectionPtr AcquireForStream(ClusterHostTypeFlags, OptionalCommandControl);
+
   void SetDefaultCommandControl(CommandControl, DefaultCommandControlSource);
   CommandControl GetDefaultCommandControl() const;
 
@@ -124,6 +124,66 @@ ResultSet Connection::PortalExecute(StatementId statement_id,
                                std::move(statement_cmd_ctl));
 }
 
+void Connection::CopyStart(const Query& query, CopyDirection direction,
+                           OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyStart(query, direction, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyPutData(std::string_view data,
+                             OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyPutData(data, std::move(statement_cmd_ctl));
+}
+
+std::size_t Connection::CopyInFinish(OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyInFinish(std::move(statement_cmd_ctl));
+}
+
+bool Connection::CopyGetData(std::string& buffer,
+                             OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyGetData(buffer, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyAbort(CopyDirection direction) {
+  pimpl_->CopyAbort(direction);
+}
+
+void Connection::StreamStart(const Query& query,
+                             const detail::QueryParameters& params,
+                             std::size_t chunk_size,
+                             OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->StreamStart(query, params, chunk_size, std::move(statement_cmd_ctl));
+}
+
+ResultSet Connection::StreamFetch(std::size_t chunk_size,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->StreamFetch(chunk_size, std::move(statement_cmd_ctl));
+}
+
+void Connection::StreamCancel() { pimpl_->StreamCancel(); }
+
+std::vector<Connection::PreparedStatement> Connection::TakeNewlyPrepared() {
+  return pimpl_->TakeNewlyPrepared();
+}
+
+void Connection::PrepareStatements(
+    const std::vector<PreparedStatement>& statements) {
+  pimpl_->PrepareStatements(statements);
+}
+
+void Connection::PipelineSend(const Query& query,
+                              const detail::QueryParameters& params,
+                              OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->PipelineSend(query, params, std::move(statement_cmd_ctl));
+}
+
+void Connection::PipelineFlush(engine::Deadline deadline) {
+  pimpl_->PipelineFlush(deadline);
+}
+
+ResultSet Connection::PipelineWaitResult(engine::Deadline deadline) {
+  return pimpl_->PipelineWaitResult(deadline);
+}
+
 void Connection::CancelAndCleanup(TimeoutDuration timeout) {
   pimpl_->CancelAndCleanup(timeout);
 }
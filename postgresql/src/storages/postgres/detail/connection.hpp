@@ -3,6 +3,8 @@
 #include <atomic>
 #include <chrono>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -48,6 +50,12 @@ class Connection {
                   //!< finished
   };
 
+  /// Direction of a COPY statement
+  enum class CopyDirection {
+    kIn,  //!< COPY FROM STDIN
+    kOut  //!< COPY TO STDOUT
+  };
+
   /// Strong typedef for IDs assigned to prepared statements
   using StatementId =
       USERVER_NAMESPACE::utils::StrongTypedef<struct StatementIdTag,
@@ -90,6 +98,12 @@ class Connection {
     /// Number of duplicate prepared statements errors,
     /// probably caused by timeout while preparing
     Counter duplicate_prepared_statements{0};
+    /// Number of statements found in the prepared statements cache
+    Counter prepared_cache_hit{0};
+    /// Number of statements missing in the prepared statements cache
+    Counter prepared_cache_miss{0};
+    /// Number of prepared statements evicted to fit the cache size limit
+    Counter prepared_cache_evict{0};
 
     /// Current number of prepared statements
     CurrentValue prepared_statements_current{0};
@@ -107,6 +121,14 @@ class Connection {
     SteadyClock::duration sum_query_duration{0};
   };
 
+  /// Statement prepared on the new connections of a pool, see
+  /// ConnectionSettings::prepared_warmup_size
+  struct PreparedStatement {
+    StatementId id{};
+    std::string statement;
+    std::vector<Oid> param_types;
+  };
+
   using SizeGuard =
       USERVER_NAMESPACE::utils::SizeGuard<std::shared_ptr<std::atomic<size_t>>>;
 
@@ -209,7 +231,8 @@ class Connection {
                     const T&... args) {
     detail::StaticQueryParameters<sizeof...(args)> params;
     params.Write(GetUserTypes(), args...);
-    return Execute(query, params, OptionalCommandControl{statement_cmd_ctl});
+    return Execute(query, detail::QueryParameters{params},
+                   OptionalCommandControl{statement_cmd_ctl});
   }
 
   ResultSet Execute(const Query& query, const ParameterStore& store);
@@ -224,6 +247,46 @@ class Connection {
   ResultSet PortalExecute(StatementId, const std::string& portal_name,
                           std::uint32_t n_rows, OptionalCommandControl);
 
+  /// Start a binary COPY, the connection stays busy until the COPY is over
+  /// @throws LogicError if the statement is not a binary COPY of the direction
+  void CopyStart(const Query& query, CopyDirection direction,
+                 OptionalCommandControl);
+  /// Send a chunk of COPY FROM STDIN data
+  void CopyPutData(std::string_view data, OptionalCommandControl);
+  /// Finish COPY FROM STDIN, returns the number of rows copied
+  std::size_t CopyInFinish(OptionalCommandControl);
+  /// Receive a COPY TO STDOUT data message appending it to the buffer
+  /// Returns false and waits for the result of the COPY after the last one
+  bool CopyGetData(std::string& buffer, OptionalCommandControl);
+  /// Abort an unfinished COPY, closes the connection if that fails
+  void CopyAbort(CopyDirection direction);
+
+  /// Start a statement which rows are received in chunks of at most
+  /// chunk_size rows, the connection stays busy until all the rows are
+  /// received
+  void StreamStart(const Query& query, const detail::QueryParameters& params,
+                   std::size_t chunk_size, OptionalCommandControl);
+  /// Receive the next chunk of rows, the last one may be empty
+  ResultSet StreamFetch(std::size_t chunk_size, OptionalCommandControl);
+  /// Cancel an unfinished statement skipping the rest of the rows, closes the
+  /// connection if that fails
+  void StreamCancel();
+
+  /// @name Pipelined execution
+  /// For the connections in the pipeline mode outside of transactions.
+  /// Each statement is sent in a separate segment of the pipeline, so that an
+  /// error fails only its own statement. The connection is closed on network
+  /// errors, the rest of the results are lost then.
+  /// @{
+  /// Send a statement, does not wait for it to be sent
+  void PipelineSend(const Query& query, const detail::QueryParameters& params,
+                    OptionalCommandControl statement_cmd_ctl);
+  /// Send the statements to the server
+  void PipelineFlush(engine::Deadline deadline);
+  /// Wait for the result of the earliest statement that is not received yet
+  ResultSet PipelineWaitResult(engine::Deadline deadline);
+  /// @}
+
   /// Send cancel to the database backend
   /// Try to return connection to idle state discarding all results.
   /// If there is a transaction in progress - roll it back.
@@ -246,6 +309,17 @@ class Connection {
   void SetParameter(const std::string& param, const std::string& value,
                     ParameterScope scope);
 
+  /// @name Prepared statements warmup
+  /// @{
+  /// Statements prepared since the previous call, recorded only if
+  /// ConnectionSettings::prepared_warmup_size is not 0
+  std::vector<PreparedStatement> TakeNewlyPrepared();
+  /// Prepare the statements of the other connections of a pool, the ones
+  /// that fail to prepare are skipped
+  /// @throws ConnectionError if the connection breaks
+  void PrepareStatements(const std::vector<PreparedStatement>& statements);
+  /// @}
+
   /// @brief Reload user types after creating a type
   void ReloadUserTypes();
   const UserTypes& GetUserTypes() const;
@@ -11,6 +11,7 @@
 
 #include <storages/postgres/detail/tracing_tags.hpp>
 #include <storages/postgres/io/pg_type_parsers.hpp>
+#include <userver/storages/postgres/detail/string_hash.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -25,13 +26,29 @@ const char* const kStatementTimeoutParameter = "statement_timeout";
 const std::string kBadCachedPlanErrorMessage =
     "cached plan must not change result type";
 
+// Statements that differ only in whitespace share a prepared statement
 std::size_t QueryHash(const std::string& statement,
                       const QueryParameters& params) {
   auto res = params.TypeHash();
-  boost::hash_combine(res, std::hash<std::string>()(statement));
+  boost::hash_combine(res, utils::QueryTextHash(statement));
   return res;
 }
 
+// Parameters of a statement that is prepared without being executed
+class ParamTypesHolder {
+ public:
+  explicit ParamTypesHolder(const std::vector<Oid>& types) : types_{types} {}
+
+  std::size_t Size() const { return types_.size(); }
+  const char* const* ParamBuffers() const { return nullptr; }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  const int* ParamLengthsBuffer() const { return nullptr; }
+  const int* ParamFormatsBuffer() const { return nullptr; }
+
+ private:
+  const std::vector<Oid>& types_;
+};
+
 class CountExecute {
  public:
   CountExecute(Connection::Statistics& stats) : stats_(stats) {
@@ -131,6 +148,10 @@ ORDER BY c.reltype, a.attnum)~";
 
 const std::string kPingStatement = "SELECT 1 AS ping";
 
+// set_config is local to the implicit transaction of a pipeline segment
+const std::string kSetLocalStatementTimeout =
+    "SELECT set_config('statement_timeout', $1, true)";
+
 void CheckQueryParameters(const std::string& statement,
                           const QueryParameters& params) {
   for (std::size_t i = 1; i <= params.Size(); ++i) {
@@ -471,6 +492,334 @@ ResultSet ConnectionImpl::PortalExecute(
                     count_execute, span, scope, &prepared_info->description);
 }
 
+void ConnectionImpl::CopyStart(const Query& query,
+                               Connection::CopyDirection direction,
+                               OptionalCommandControl statement_cmd_ctl) {
+  if (IsPipelineEnabled()) {
+    throw NotImplemented{"COPY is not supported in pipeline mode"};
+  }
+  CheckBusy();
+  auto deadline = MakeStreamingDeadline(statement_cmd_ctl);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  CheckDeadlineReached(deadline);
+  auto span = MakeQuerySpan(query);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  ++stats_.execute_total;
+  try {
+    conn_wrapper_.SendQuery(query.Statement(), scope);
+    conn_wrapper_.WaitCopyStart(direction == Connection::CopyDirection::kIn
+                                    ? PGRES_COPY_IN
+                                    : PGRES_COPY_OUT,
+                                deadline, scope);
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  } catch (const std::exception&) {
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+}
+
+void ConnectionImpl::CopyPutData(std::string_view data,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  try {
+    conn_wrapper_.PutCopyData(data, MakeStreamingDeadline(statement_cmd_ctl));
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    throw;
+  }
+}
+
+std::size_t ConnectionImpl::CopyInFinish(
+    OptionalCommandControl statement_cmd_ctl) {
+  const auto deadline = MakeStreamingDeadline(statement_cmd_ctl);
+  try {
+    conn_wrapper_.PutCopyEnd(nullptr, deadline);
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    throw;
+  }
+  return WaitCopyResult(deadline);
+}
+
+bool ConnectionImpl::CopyGetData(std::string& buffer,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  const auto deadline = MakeStreamingDeadline(statement_cmd_ctl);
+  try {
+    if (conn_wrapper_.GetCopyData(buffer, deadline)) return true;
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    throw;
+  }
+  WaitCopyResult(deadline);
+  return false;
+}
+
+void ConnectionImpl::CopyAbort(Connection::CopyDirection direction) {
+  if (GetConnectionState() != ConnectionState::kTranActive) {
+    // the COPY is already over, e.g. failed by the server
+    return;
+  }
+  const auto deadline = MakeCurrentDeadline();
+  try {
+    if (direction == Connection::CopyDirection::kIn) {
+      conn_wrapper_.PutCopyEnd("COPY is aborted by the client", deadline);
+    } else {
+      // The server can not be asked to stop sending the data but by
+      // cancelling the statement, the rest of the data has to be skipped
+      auto cancel = conn_wrapper_.Cancel();
+      std::string skipped;
+      while (conn_wrapper_.GetCopyData(skipped, deadline)) skipped.clear();
+      cancel.WaitUntil(deadline);
+    }
+    WaitCopyResult(deadline);
+  } catch (const std::exception& e) {
+    if (GetConnectionState() != ConnectionState::kTranActive) {
+      // the COPY failed as requested
+      LOG_DEBUG() << "COPY is aborted: " << e;
+      return;
+    }
+    LOG_LIMITED_WARNING() << "Failed to abort COPY, closing connection: " << e;
+    Close();
+  }
+}
+
+void ConnectionImpl::StreamStart(const Query& query,
+                                 const QueryParameters& params,
+                                 std::size_t chunk_size,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  if (settings_.ignore_unused_query_params ==
+      ConnectionSettings::kCheckUnused) {
+    CheckQueryParameters(query.Statement(), params);
+  }
+  auto deadline = MakeStreamingDeadline(statement_cmd_ctl);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  CheckDeadlineReached(deadline);
+  auto span = MakeQuerySpan(query);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  ++stats_.execute_total;
+  try {
+    conn_wrapper_.SendQuery(query.Statement(), params, scope);
+    conn_wrapper_.StartRowsStream(chunk_size, deadline);
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  } catch (const std::exception&) {
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+}
+
+ResultSet ConnectionImpl::StreamFetch(
+    std::size_t chunk_size, OptionalCommandControl statement_cmd_ctl) {
+  tracing::Span span{scopes::kQuery};
+  conn_wrapper_.FillSpanTags(span);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  try {
+    auto res = conn_wrapper_.WaitResultChunk(
+        chunk_size, MakeStreamingDeadline(statement_cmd_ctl), scope);
+    if (GetConnectionState() == ConnectionState::kTranActive) {
+      // user types can not be reloaded while the rows are being received
+      res.FillBufferCategories(db_types_);
+    } else if (!res.IsEmpty()) {
+      FillBufferCategories(res);
+    }
+    return res;
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  } catch (const QueryCancelled&) {
+    ++stats_.execute_timeout;
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  } catch (const std::exception&) {
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+}
+
+void ConnectionImpl::StreamCancel() {
+  if (GetConnectionState() != ConnectionState::kTranActive) {
+    // all the rows are already received
+    return;
+  }
+  const auto deadline = MakeCurrentDeadline();
+  try {
+    // The server can not be asked to stop sending the rows but by cancelling
+    // the statement, the rest of the rows has to be skipped
+    auto cancel = conn_wrapper_.Cancel();
+    tracing::ScopeTime scope;
+    try {
+      while (GetConnectionState() == ConnectionState::kTranActive) {
+        conn_wrapper_.WaitResultChunk(1, deadline, scope);
+      }
+    } catch (const QueryCancelled&) {
+      // the statement is cancelled as requested
+    }
+    cancel.WaitUntil(deadline);
+  } catch (const std::exception& e) {
+    if (GetConnectionState() != ConnectionState::kTranActive) {
+      // the statement has failed before being cancelled
+      LOG_DEBUG() << "Streamed statement is over: " << e;
+      return;
+    }
+    LOG_LIMITED_WARNING()
+        << "Failed to cancel a streamed statement, closing connection: " << e;
+    Close();
+  }
+}
+
+void ConnectionImpl::PipelineSend(const Query& query,
+                                  const QueryParameters& params,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  UASSERT_MSG(IsPipelineEnabled(), "Pipeline mode is required");
+  const auto& statement = query.Statement();
+  if (settings_.ignore_unused_query_params ==
+      ConnectionSettings::kCheckUnused) {
+    CheckQueryParameters(statement, params);
+  }
+  if (pipeline_segments_.empty()) {
+    // The maintenance postponed by the previous pipeline needs an idle
+    // connection
+    pipeline_prepare_errors_.clear();
+    if (is_user_types_reload_pending_) {
+      is_user_types_reload_pending_ = false;
+      LoadUserTypes(MakeCurrentDeadline());
+    }
+    DiscardOldPreparedStatements(MakeCurrentDeadline());
+  }
+
+  tracing::ScopeTime scope;
+  PipelineSegment segment{PipelineSegment::Kind::kStatement, statement, {}};
+  try {
+    const PreparedStatementInfo* prepared_info = nullptr;
+    if (settings_.prepared_statements !=
+        ConnectionSettings::kNoPreparedStatements) {
+      const auto query_hash = QueryHash(statement, params);
+      segment.statement_id = Connection::StatementId{query_hash};
+      prepared_info = prepared_.Get(*segment.statement_id);
+      if (prepared_info) {
+        ++stats_.prepared_cache_hit;
+      } else {
+        ++stats_.prepared_cache_miss;
+        if (prepared_.GetSize() >= settings_.max_prepared_cache_size) {
+          const auto* evicted = prepared_.GetLeastUsed();
+          UASSERT(evicted);
+          PipelineSendService("DEALLOCATE " + evicted->statement_name, scope);
+          prepared_.Erase(evicted->id);
+          ++stats_.prepared_cache_evict;
+        }
+        std::string statement_name =
+            "q" + std::to_string(query_hash) + "_" + uuid_;
+        scope.Reset(scopes::kPrepare);
+        conn_wrapper_.SendPrepare(statement_name, statement, params, scope);
+        conn_wrapper_.PipelineSync();
+        pipeline_segments_.push_back({PipelineSegment::Kind::kPrepare,
+                                      statement, segment.statement_id});
+        prepared_.Put(*segment.statement_id,
+                      {*segment.statement_id, statement,
+                       std::move(statement_name), ResultSet{nullptr}});
+        prepared_info = prepared_.Get(*segment.statement_id);
+      }
+    }
+
+    scope.Reset(scopes::kExec);
+    if (statement_cmd_ctl) {
+      const auto timeout =
+          testsuite_pg_ctl_.MakeStatementTimeout(statement_cmd_ctl->statement);
+      if (timeout != current_statement_timeout_) {
+        StaticQueryParameters<1> timeout_params;
+        timeout_params.Write(db_types_, std::to_string(timeout.count()));
+        conn_wrapper_.SendQuery(kSetLocalStatementTimeout,
+                                QueryParameters{timeout_params}, scope);
+      }
+    }
+    if (prepared_info) {
+      conn_wrapper_.SendPreparedQuery(prepared_info->statement_name, params,
+                                      scope);
+    } else {
+      conn_wrapper_.SendQuery(statement, params, scope);
+    }
+    conn_wrapper_.PipelineSync();
+  } catch (const std::exception&) {
+    // The segments sent so far can not be told from the broken one
+    Close();
+    pipeline_segments_.clear();
+    throw;
+  }
+  pipeline_segments_.push_back(std::move(segment));
+}
+
+void ConnectionImpl::PipelineFlush(engine::Deadline deadline) {
+  try {
+    conn_wrapper_.FlushPipeline(deadline);
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    Close();
+    pipeline_segments_.clear();
+    throw;
+  } catch (const std::exception&) {
+    Close();
+    pipeline_segments_.clear();
+    throw;
+  }
+}
+
+ResultSet ConnectionImpl::PipelineWaitResult(engine::Deadline deadline) {
+  tracing::ScopeTime scope;
+  try {
+    while (!pipeline_segments_.empty()) {
+      const auto segment = std::move(pipeline_segments_.front());
+      pipeline_segments_.pop_front();
+      switch (segment.kind) {
+        case PipelineSegment::Kind::kStatement:
+          return PipelineWaitStatement(segment, deadline, scope);
+        case PipelineSegment::Kind::kPrepare:
+          try {
+            conn_wrapper_.WaitPipelineSync(deadline, scope);
+            ++stats_.parse_total;
+          } catch (const std::exception& e) {
+            if (!IsConnected()) throw;
+            // The statement segment fails with InvalidSqlStatementName, the
+            // actual error is reported instead
+            LOG_DEBUG() << "Failed to prepare statement `" << segment.statement
+                        << "`: " << e;
+            prepared_.Erase(*segment.statement_id);
+            pipeline_prepare_errors_.emplace_back(*segment.statement_id,
+                                                  std::current_exception());
+          }
+          break;
+        case PipelineSegment::Kind::kService:
+          try {
+            conn_wrapper_.WaitPipelineSync(deadline, scope);
+          } catch (const std::exception& e) {
+            if (!IsConnected()) throw;
+            LOG_LIMITED_WARNING() << "Statement `" << segment.statement
+                                  << "` failed: " << e;
+          }
+          break;
+      }
+    }
+  } catch (const std::exception&) {
+    if (!IsConnected()) pipeline_segments_.clear();
+    throw;
+  }
+  throw LogicError{"There are no statements in the pipeline"};
+}
+
 void ConnectionImpl::CancelAndCleanup(TimeoutDuration timeout) {
   auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(timeout);
 
@@ -526,6 +875,47 @@ void ConnectionImpl::SetParameter(std::string_view name, std::string_view value,
   SetParameter(name, value, scope, MakeCurrentDeadline());
 }
 
+std::vector<Connection::PreparedStatement>
+ConnectionImpl::TakeNewlyPrepared() {
+  return std::exchange(newly_prepared_, {});
+}
+
+void ConnectionImpl::PrepareStatements(
+    const std::vector<Connection::PreparedStatement>& statements) {
+  // The pipelined connections prepare the statements without waiting for that
+  if (settings_.prepared_statements ==
+          ConnectionSettings::kNoPreparedStatements ||
+      IsPipelineEnabled()) {
+    return;
+  }
+  CheckBusy();
+  tracing::Span span{scopes::kPrepare};
+  auto scope = span.CreateScopeTime();
+  std::size_t prepared_count = 0;
+  for (const auto& prepared : statements) {
+    // The statements of the warmup must not evict each other
+    if (prepared_.GetSize() >= settings_.max_prepared_cache_size) break;
+    ParamTypesHolder param_types{prepared.param_types};
+    const QueryParameters params{param_types};
+    UASSERT(QueryHash(prepared.statement, params) ==
+            prepared.id.GetUnderlying());
+    try {
+      PrepareStatement(prepared.statement, params, MakeCurrentDeadline(), span,
+                       scope);
+      ++prepared_count;
+    } catch (const std::exception& e) {
+      if (!IsConnected()) throw;
+      LOG_LIMITED_WARNING() << "Failed to prepare statement `"
+                            << prepared.statement
+                            << "` on a new connection: " << e;
+    }
+  }
+  // The statements of the other connections are not new to the pool
+  newly_prepared_.clear();
+  LOG_DEBUG() << "Prepared " << prepared_count << " of " << statements.size()
+              << " statements on a new connection";
+}
+
 const UserTypes& ConnectionImpl::GetUserTypes() const { return db_types_; }
 
 void ConnectionImpl::LoadUserTypes() { LoadUserTypes(MakeCurrentDeadline()); }
@@ -573,6 +963,33 @@ engine::Deadline ConnectionImpl::MakeCurrentDeadline() const {
   return testsuite_pg_ctl_.MakeExecuteDeadline(CurrentExecuteTimeout());
 }
 
+engine::Deadline ConnectionImpl::MakeStreamingDeadline(
+    const OptionalCommandControl& statement_cmd_ctl) const {
+  // COPY and streamed results may take long, the network timeout applies to
+  // each network operation of them
+  return testsuite_pg_ctl_.MakeExecuteDeadline(
+      !!statement_cmd_ctl ? statement_cmd_ctl->execute
+                          : CurrentExecuteTimeout());
+}
+
+std::size_t ConnectionImpl::WaitCopyResult(engine::Deadline deadline) {
+  tracing::Span span{scopes::kQuery};
+  conn_wrapper_.FillSpanTags(span);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  try {
+    return conn_wrapper_.WaitResult(deadline, scope).RowsAffected();
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  } catch (const std::exception&) {
+    ++stats_.error_execute_total;
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+}
+
 void ConnectionImpl::SetTransactionCommandControl(CommandControl cmd_ctl) {
   if (!IsInTransaction()) {
     throw NotInTransaction{
@@ -640,13 +1057,16 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
   auto* statement_info = prepared_.Get(query_id);
   if (statement_info) {
     LOG_TRACE() << "Query " << statement << " is already prepared.";
+    ++stats_.prepared_cache_hit;
     return *statement_info;
   } else {
+    ++stats_.prepared_cache_miss;
     if (prepared_.GetSize() >= settings_.max_prepared_cache_size) {
       statement_info = prepared_.GetLeastUsed();
       UASSERT(statement_info);
       DiscardPreparedStatement(*statement_info, deadline);
       prepared_.Erase(statement_info->id);
+      ++stats_.prepared_cache_evict;
     }
     scope.Reset(scopes::kPrepare);
     LOG_TRACE() << "Query " << statement << " is not yet prepared";
@@ -678,6 +1098,13 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
     // Ensure we've got binary format established
     res.GetRowDescription().CheckBinaryFormat(db_types_);
     ++stats_.parse_total;
+    if (newly_prepared_.size() < settings_.prepared_warmup_size) {
+      newly_prepared_.push_back(
+          {query_id,
+           statement,
+           {params.ParamTypesBuffer(),
+            params.ParamTypesBuffer() + params.Size()}});
+    }
     return *statement_info;
   }
 }
@@ -698,6 +1125,67 @@ void ConnectionImpl::DiscardPreparedStatement(const PreparedStatementInfo& info,
   ExecuteCommandNoPrepare("DEALLOCATE " + info.statement_name, deadline);
 }
 
+void ConnectionImpl::PipelineSendService(std::string statement,
+                                         tracing::ScopeTime& scope) {
+  LOG_DEBUG() << "Sending `" << statement << "` in a pipeline";
+  conn_wrapper_.SendQuery(statement, scope);
+  conn_wrapper_.PipelineSync();
+  pipeline_segments_.push_back(
+      {PipelineSegment::Kind::kService, std::move(statement), {}});
+}
+
+ResultSet ConnectionImpl::PipelineWaitStatement(const PipelineSegment& segment,
+                                                engine::Deadline deadline,
+                                                tracing::ScopeTime& scope) {
+  CountExecute count_execute(stats_);
+  try {
+    auto res = conn_wrapper_.WaitPipelineSync(deadline, scope);
+    if (!res.IsEmpty()) {
+      if (pipeline_segments_.empty()) {
+        FillBufferCategories(res);
+      } else {
+        try {
+          res.FillBufferCategories(db_types_);
+        } catch (const UnknownBufferCategory&) {
+          // User types can not be loaded until the pipeline is over
+          is_user_types_reload_pending_ =
+              settings_.user_types != ConnectionSettings::kPredefinedTypesOnly;
+          throw;
+        }
+      }
+    }
+    count_execute.AccountResult(res);
+    return res;
+  } catch (const InvalidSqlStatementName& e) {
+    for (const auto& [statement_id, error] : pipeline_prepare_errors_) {
+      if (statement_id == segment.statement_id) std::rethrow_exception(error);
+    }
+    LOG_LIMITED_ERROR()
+        << "Looks like your pg_bouncer is not in 'session' mode. "
+           "Please switch pg_bouncers's pooling mode to 'session'.";
+    is_discard_prepared_pending_ = true;
+    throw;
+  } catch (const ConnectionTimeoutError& e) {
+    ++stats_.execute_timeout;
+    LOG_LIMITED_WARNING() << "Statement `" << segment.statement
+                          << "` network timeout error: " << e;
+    throw;
+  } catch (const QueryCancelled& e) {
+    ++stats_.execute_timeout;
+    LOG_LIMITED_WARNING() << "Statement `" << segment.statement
+                          << "` was cancelled: " << e;
+    throw;
+  } catch (const FeatureNotSupported& e) {
+    if (e.GetServerMessage().GetPrimary() == kBadCachedPlanErrorMessage) {
+      LOG_LIMITED_WARNING()
+          << "Scheduling prepared statements invalidation due to "
+             "cached plan change";
+      is_discard_prepared_pending_ = true;
+    }
+    throw;
+  }
+}
+
 ResultSet ConnectionImpl::ExecuteCommand(const Query& query,
                                          engine::Deadline deadline) {
   static const QueryParameters kNoParams;
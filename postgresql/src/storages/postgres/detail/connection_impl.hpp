@@ -1,10 +1,14 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
+#include <exception>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <userver/cache/lru_map.hpp>
 #include <userver/engine/deadline.hpp>
@@ -80,12 +84,37 @@ class ConnectionImpl {
                           const std::string& portal_name, std::uint32_t n_rows,
                           OptionalCommandControl statement_cmd_ctl);
 
+  void CopyStart(const Query& query, Connection::CopyDirection direction,
+                 OptionalCommandControl statement_cmd_ctl);
+  void CopyPutData(std::string_view data,
+                   OptionalCommandControl statement_cmd_ctl);
+  std::size_t CopyInFinish(OptionalCommandControl statement_cmd_ctl);
+  bool CopyGetData(std::string& buffer,
+                   OptionalCommandControl statement_cmd_ctl);
+  void CopyAbort(Connection::CopyDirection direction);
+
+  void StreamStart(const Query& query, const detail::QueryParameters& params,
+                   std::size_t chunk_size,
+                   OptionalCommandControl statement_cmd_ctl);
+  ResultSet StreamFetch(std::size_t chunk_size,
+                        OptionalCommandControl statement_cmd_ctl);
+  void StreamCancel();
+
+  void PipelineSend(const Query& query, const detail::QueryParameters& params,
+                    OptionalCommandControl statement_cmd_ctl);
+  void PipelineFlush(engine::Deadline deadline);
+  ResultSet PipelineWaitResult(engine::Deadline deadline);
+
   void CancelAndCleanup(TimeoutDuration timeout);
   bool Cleanup(TimeoutDuration timeout);
 
   void SetParameter(std::string_view name, std::string_view value,
                     Connection::ParameterScope scope);
 
+  std::vector<Connection::PreparedStatement> TakeNewlyPrepared();
+  void PrepareStatements(
+      const std::vector<Connection::PreparedStatement>& statements);
+
   const UserTypes& GetUserTypes() const;
   void LoadUserTypes();
 
@@ -103,6 +132,23 @@ class ConnectionImpl {
     ResultSet description{nullptr};
   };
 
+  /// Statements sent in a pipeline up to a sync, executed by the server in an
+  /// implicit transaction
+  struct PipelineSegment {
+    enum class Kind {
+      /// Statement of a user, has a result
+      kStatement,
+      /// Preparation of a statement of a following kStatement segment
+      kPrepare,
+      /// Statement of the driver itself, the result is discarded
+      kService,
+    };
+
+    Kind kind{Kind::kStatement};
+    std::string statement;
+    std::optional<Connection::StatementId> statement_id;
+  };
+
   using PreparedStatements =
       cache::LruMap<Connection::StatementId, PreparedStatementInfo>;
 
@@ -112,6 +158,9 @@ class ConnectionImpl {
   void CheckDeadlineReached(const engine::Deadline& deadline);
   tracing::Span MakeQuerySpan(const Query& query) const;
   engine::Deadline MakeCurrentDeadline() const;
+  engine::Deadline MakeStreamingDeadline(
+      const OptionalCommandControl& statement_cmd_ctl) const;
+  std::size_t WaitCopyResult(engine::Deadline deadline);
 
   void SetTransactionCommandControl(CommandControl cmd_ctl);
 
@@ -131,6 +180,10 @@ class ConnectionImpl {
   void DiscardOldPreparedStatements(engine::Deadline deadline);
   void DiscardPreparedStatement(const PreparedStatementInfo& info,
                                 engine::Deadline deadline);
+  void PipelineSendService(std::string statement, tracing::ScopeTime& scope);
+  ResultSet PipelineWaitStatement(const PipelineSegment& segment,
+                                  engine::Deadline deadline,
+                                  tracing::ScopeTime& scope);
 
   ResultSet ExecuteCommand(const Query& query, engine::Deadline deadline);
 
@@ -169,10 +222,18 @@ class ConnectionImpl {
   Connection::Statistics stats_;
   PGConnectionWrapper conn_wrapper_;
   PreparedStatements prepared_;
+  /// Statements prepared since the last TakeNewlyPrepared, for the warmup of
+  /// the new connections of the pool
+  std::vector<Connection::PreparedStatement> newly_prepared_;
+  std::deque<PipelineSegment> pipeline_segments_;
+  /// Errors of kPrepare segments of the current pipeline
+  std::vector<std::pair<Connection::StatementId, std::exception_ptr>>
+      pipeline_prepare_errors_;
   UserTypes db_types_;
   bool is_in_recovery_ = true;
   bool is_read_only_ = true;
   bool is_discard_prepared_pending_ = false;
+  bool is_user_types_reload_pending_ = false;
   ConnectionSettings settings_;
 
   CommandControl default_cmd_ctl_{{}, {}};
@@ -0,0 +1,356 @@
+#include <storages/postgres/detail/multiplexer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+#include <libpq-fe.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <storages/postgres/detail/tracing_tags.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+constexpr std::chrono::seconds kMaxIdleDuration{15};
+constexpr std::chrono::seconds kReconnectInterval{1};
+
+/// Copy of the query parameters that does not depend on the memory of the
+/// caller
+class OwnedQueryParameters {
+ public:
+  explicit OwnedQueryParameters(const QueryParameters& params)
+      : types_(params.ParamTypesBuffer(),
+               params.ParamTypesBuffer() + params.Size()),
+        lengths_(params.ParamLengthsBuffer(),
+                 params.ParamLengthsBuffer() + params.Size()),
+        formats_(params.ParamFormatsBuffer(),
+                 params.ParamFormatsBuffer() + params.Size()) {
+    std::size_t data_size = 0;
+    for (std::size_t i = 0; i < params.Size(); ++i) {
+      if (params.ParamBuffers()[i]) data_size += lengths_[i];
+    }
+    // the buffers point into the data, so it must not be reallocated
+    data_.reserve(data_size);
+    buffers_.reserve(params.Size());
+    for (std::size_t i = 0; i < params.Size(); ++i) {
+      const char* buffer = params.ParamBuffers()[i];
+      if (!buffer) {
+        buffers_.push_back(nullptr);
+      } else if (lengths_[i] == 0) {
+        buffers_.push_back(kEmptyBuffer);
+      } else {
+        buffers_.push_back(data_.data() + data_.size());
+        data_.insert(data_.end(), buffer, buffer + lengths_[i]);
+      }
+    }
+  }
+
+  std::size_t Size() const { return types_.size(); }
+  const char* const* ParamBuffers() const { return buffers_.data(); }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  const int* ParamLengthsBuffer() const { return lengths_.data(); }
+  const int* ParamFormatsBuffer() const { return formats_.data(); }
+
+ private:
+  static constexpr const char* kEmptyBuffer = "";
+
+  std::vector<Oid> types_;
+  std::vector<int> lengths_;
+  std::vector<int> formats_;
+  std::vector<const char*> buffers_;
+  std::vector<char> data_;
+};
+
+/// A statement waiting in the queue of a lane, lives on the stack of the
+/// caller, which withdraws it before returning
+struct Request {
+  const Query& query;
+  const ParamsWriter& writer;
+  const OptionalCommandControl& statement_cmd_ctl;
+  engine::Deadline deadline;
+  engine::Promise<ResultSet> promise;
+};
+
+}  // namespace
+
+class Multiplexer::Lane {
+ public:
+  explicit Lane(const ConnectionCallbacks& callbacks)
+      : callbacks_{callbacks},
+        task_{engine::CriticalAsyncNoSpan([this] { Run(); })} {}
+
+  ~Lane() {
+    task_.SyncCancel();
+    if (conn_) callbacks_.drop(std::move(conn_));
+  }
+
+  void Push(Request& request) {
+    {
+      std::lock_guard<engine::Mutex> lock{mutex_};
+      queue_.push_back(&request);
+    }
+    queue_cv_.NotifyOne();
+  }
+
+  /// After the call the lane does not access the request
+  void Withdraw(Request& request) {
+    std::lock_guard<engine::Mutex> lock{mutex_};
+    const auto it = std::find(queue_.begin(), queue_.end(), &request);
+    if (it != queue_.end()) queue_.erase(it);
+  }
+
+ private:
+  struct Statement {
+    engine::Promise<ResultSet> promise;
+    Query query;
+    OwnedQueryParameters params;
+    OptionalCommandControl statement_cmd_ctl;
+    engine::Deadline deadline;
+    bool is_done{false};
+
+    void SetResult(ResultSet&& res) {
+      promise.set_value(std::move(res));
+      is_done = true;
+    }
+
+    void SetError(std::exception_ptr error) {
+      promise.set_exception(std::move(error));
+      is_done = true;
+    }
+  };
+
+  void Run();
+  /// @returns false if there were no requests for a while
+  bool WaitForRequests();
+  bool Connect();
+  std::vector<Statement> TakeBatch();
+  void ExecuteBatch(std::vector<Statement>& batch);
+  void PingIdle();
+  void FailQueued(std::exception_ptr error);
+  void ReleaseConnection();
+
+  const ConnectionCallbacks& callbacks_;
+  engine::Mutex mutex_;
+  engine::ConditionVariable queue_cv_;
+  std::deque<Request*> queue_;
+  std::unique_ptr<Connection> conn_;
+  // must be the last member, the task uses all the others
+  engine::TaskWithResult<void> task_;
+};
+
+void Multiplexer::Lane::Run() {
+  while (!engine::current_task::ShouldCancel()) {
+    if (!WaitForRequests()) {
+      PingIdle();
+      continue;
+    }
+    if (!conn_ && !Connect()) continue;
+    auto batch = TakeBatch();
+    if (!batch.empty()) ExecuteBatch(batch);
+  }
+  FailQueued(std::make_exception_ptr(
+      ConnectionInterrupted{"Multiplexed connection is shutting down"}));
+}
+
+bool Multiplexer::Lane::WaitForRequests() {
+  std::unique_lock<engine::Mutex> lock{mutex_};
+  return queue_cv_.WaitFor(lock, kMaxIdleDuration,
+                           [this] { return !queue_.empty(); });
+}
+
+bool Multiplexer::Lane::Connect() {
+  try {
+    conn_ = callbacks_.connect();
+    return true;
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to establish a multiplexed connection: "
+                          << e;
+    FailQueued(std::current_exception());
+    engine::InterruptibleSleepFor(kReconnectInterval);
+    return false;
+  }
+}
+
+std::vector<Multiplexer::Lane::Statement> Multiplexer::Lane::TakeBatch() {
+  // the parameters are written with the types of the connection that sends
+  // them, the callers keep the arguments while their requests are queued
+  const auto& types = conn_->GetUserTypes();
+  std::vector<Statement> batch;
+  std::lock_guard<engine::Mutex> lock{mutex_};
+  batch.reserve(std::min(queue_.size(), kMaxBatchSize));
+  while (!queue_.empty() && batch.size() < kMaxBatchSize) {
+    auto& request = *queue_.front();
+    queue_.pop_front();
+    if (request.deadline.IsReached()) {
+      request.promise.set_exception(std::make_exception_ptr(
+          ConnectionTimeoutError{"Deadline reached before executing"}));
+      continue;
+    }
+    try {
+      OwnedQueryParameters params{request.writer(types)};
+      batch.push_back({std::move(request.promise), request.query,
+                       std::move(params), request.statement_cmd_ctl,
+                       request.deadline});
+    } catch (const std::exception&) {
+      request.promise.set_exception(std::current_exception());
+    }
+  }
+  return batch;
+}
+
+void Multiplexer::Lane::ExecuteBatch(std::vector<Statement>& batch) {
+  tracing::Span span{scopes::kMultiplexedBatch};
+  span.SetLogLevel(logging::Level::kDebug);
+  span.AddTag("batch_size", batch.size());
+
+  auto deadline = batch.front().deadline;
+  for (const auto& statement : batch) {
+    deadline = std::max(deadline, statement.deadline);
+  }
+
+  conn_->Start(SteadyClock::now());
+  try {
+    conn_->UpdateDefaultCommandControl();
+    std::vector<Statement*> sent;
+    sent.reserve(batch.size());
+    for (auto& statement : batch) {
+      try {
+        conn_->PipelineSend(statement.query, QueryParameters{statement.params},
+                            statement.statement_cmd_ctl);
+        sent.push_back(&statement);
+      } catch (const std::exception&) {
+        if (!conn_->IsConnected()) throw;
+        statement.SetError(std::current_exception());
+      }
+    }
+    if (!sent.empty()) conn_->PipelineFlush(deadline);
+    for (auto* statement : sent) {
+      try {
+        statement->SetResult(conn_->PipelineWaitResult(deadline));
+      } catch (const std::exception&) {
+        if (!conn_->IsConnected()) throw;
+        statement->SetError(std::current_exception());
+      }
+    }
+  } catch (const std::exception& e) {
+    // the results of the statements are lost with the connection
+    LOG_LIMITED_WARNING() << "Multiplexed connection failed: " << e;
+    span.AddTag(tracing::kErrorFlag, true);
+    for (auto& statement : batch) {
+      if (!statement.is_done) statement.SetError(std::current_exception());
+    }
+  }
+  conn_->Finish();
+  ReleaseConnection();
+}
+
+void Multiplexer::Lane::PingIdle() {
+  if (!conn_ || engine::current_task::ShouldCancel() ||
+      conn_->GetIdleDuration() < kMaxIdleDuration) {
+    return;
+  }
+  try {
+    conn_->Ping();
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Exception while pinging a multiplexed "
+                             "connection: "
+                          << e;
+  }
+  ReleaseConnection();
+}
+
+void Multiplexer::Lane::FailQueued(std::exception_ptr error) {
+  std::lock_guard<engine::Mutex> lock{mutex_};
+  for (auto* request : queue_) {
+    request->promise.set_exception(error);
+  }
+  queue_.clear();
+}
+
+void Multiplexer::Lane::ReleaseConnection() {
+  if (!conn_->IsInTransaction()) {
+    callbacks_.account_statistics(conn_->GetStatsAndReset());
+  }
+  if (!conn_->IsIdle()) {
+    callbacks_.drop(std::move(conn_));
+  }
+}
+
+Multiplexer::Multiplexer(std::size_t connections_count,
+                         ConnectionCallbacks callbacks)
+    : callbacks_{std::move(callbacks)} {
+  UASSERT(connections_count > 0);
+  lanes_.reserve(connections_count);
+  for (std::size_t i = 0; i < connections_count; ++i) {
+    lanes_.push_back(std::make_unique<Lane>(callbacks_));
+  }
+}
+
+Multiplexer::~Multiplexer() = default;
+
+bool Multiplexer::IsSupported() {
+#if LIBPQ_HAS_PIPELINING
+  return true;
+#else
+  return false;
+#endif
+}
+
+ResultSet Multiplexer::Execute(const Query& query, const ParamsWriter& writer,
+                               OptionalCommandControl statement_cmd_ctl,
+                               engine::Deadline deadline) {
+  tracing::Span span{scopes::kQuery};
+  query.FillSpanTags(span);
+  if (deadline.IsReached()) {
+    span.AddTag(tracing::kErrorFlag, true);
+    throw ConnectionTimeoutError{"Deadline reached before executing"};
+  }
+
+  auto& lane =
+      *lanes_[next_lane_.fetch_add(1, std::memory_order_relaxed) %
+              lanes_.size()];
+  Request request{query, writer, statement_cmd_ctl, deadline, {}};
+  auto future = request.promise.get_future();
+  lane.Push(request);
+  const auto status = future.wait_until(deadline);
+  if (status != engine::FutureStatus::kReady) {
+    lane.Withdraw(request);
+    span.AddTag(tracing::kErrorFlag, true);
+    if (status == engine::FutureStatus::kCancelled) {
+      throw ConnectionInterrupted{
+          "Task cancelled while waiting for a multiplexed statement"};
+    }
+    LOG_LIMITED_WARNING() << "Statement `" << query.Statement()
+                          << "` timed out in a multiplexed connection";
+    throw ConnectionTimeoutError{
+        "Timed out while waiting for a multiplexed statement"};
+  }
+  try {
+    return future.get();
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
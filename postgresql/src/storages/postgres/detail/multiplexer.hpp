@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/storages/postgres/detail/non_transaction.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Executes the statements of many tasks over a few shared connections
+/// in the pipeline mode.
+///
+/// Each connection is owned by a lane task. The lane takes all the statements
+/// queued since its previous roundtrip, sends them in a single pipeline and
+/// hands the results back to the waiting tasks. Every statement is sent in a
+/// separate segment of the pipeline, so that an error fails only its own
+/// statement.
+class Multiplexer {
+ public:
+  /// The connections of the lanes are created and accounted by the owner
+  struct ConnectionCallbacks {
+    /// Establishes a connection in the pipeline mode
+    std::function<std::unique_ptr<Connection>()> connect;
+    std::function<void(Connection::Statistics)> account_statistics;
+    std::function<void(std::unique_ptr<Connection>)> drop;
+  };
+
+  /// Max number of statements sent in a single pipeline
+  static constexpr std::size_t kMaxBatchSize = 256;
+
+  /// The lanes are started on the current task processor, the connections are
+  /// established lazily
+  Multiplexer(std::size_t connections_count, ConnectionCallbacks callbacks);
+  ~Multiplexer();
+
+  Multiplexer(const Multiplexer&) = delete;
+  Multiplexer& operator=(const Multiplexer&) = delete;
+
+  /// Returns false if libpq is built without the pipeline mode
+  static bool IsSupported();
+
+  /// @throws ConnectionTimeoutError if the result is not received before the
+  /// deadline, the statement may be executed anyway
+  ResultSet Execute(const Query& query, const ParamsWriter& writer,
+                    OptionalCommandControl statement_cmd_ctl,
+                    engine::Deadline deadline);
+
+ private:
+  class Lane;
+
+  const ConnectionCallbacks callbacks_;
+  std::vector<std::unique_ptr<Lane>> lanes_;
+  std::atomic<std::size_t> next_lane_{0};
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <userver/storages/postgres/detail/non_transaction.hpp>
 
 #include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/pool.hpp>
 #include <storages/postgres/detail/statement_timer.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -13,14 +14,31 @@ NonTransaction::NonTransaction(ConnectionPtr&& conn,
   conn_->Start(start_time);
 }
 
+NonTransaction::NonTransaction(
+    std::shared_ptr<ConnectionPool> multiplexing_pool)
+    : conn_{std::unique_ptr<Connection>{}},
+      multiplexing_pool_{std::move(multiplexing_pool)} {
+  UASSERT(multiplexing_pool_);
+}
+
 NonTransaction::NonTransaction(NonTransaction&&) noexcept = default;
-NonTransaction::~NonTransaction() { conn_->Finish(); }
+NonTransaction::~NonTransaction() {
+  if (conn_) conn_->Finish();
+}
 
 NonTransaction& NonTransaction::operator=(NonTransaction&&) noexcept = default;
 
 ResultSet NonTransaction::Execute(OptionalCommandControl statement_cmd_ctl,
                                   const std::string& statement,
                                   const ParameterStore& store) {
+  if (multiplexing_pool_) {
+    return DoExecuteMultiplexed(
+        statement,
+        [&store](const UserTypes&) {
+          return detail::QueryParameters{store.GetInternalData()};
+        },
+        statement_cmd_ctl);
+  }
   return DoExecute(statement, detail::QueryParameters{store.GetInternalData()},
                    statement_cmd_ctl);
 }
@@ -34,6 +52,13 @@ ResultSet NonTransaction::DoExecute(const Query& query,
   return res;
 }
 
+ResultSet NonTransaction::DoExecuteMultiplexed(
+    const Query& query, const ParamsWriter& writer,
+    OptionalCommandControl statement_cmd_ctl) {
+  return multiplexing_pool_->ExecuteMultiplexed(query, writer,
+                                                std::move(statement_cmd_ctl));
+}
+
 const UserTypes& NonTransaction::GetConnectionUserTypes() const {
   return conn_->GetUserTypes();
 }
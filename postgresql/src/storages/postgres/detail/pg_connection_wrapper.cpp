@@ -9,6 +9,9 @@ auto PQXisBusy(PGconn* conn) { return ::PQisBusy(conn); }
 auto PQXgetResult(PGconn* conn) { return ::PQgetResult(conn); }
 #endif
 
+#include <algorithm>
+#include <limits>
+
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/tags.hpp>
@@ -406,6 +409,10 @@ void PGConnectionWrapper::Flush(Deadline deadline) {
     is_syncing_pipeline_ = true;
   }
 #endif
+  FlushOutput(deadline);
+}
+
+void PGConnectionWrapper::FlushOutput(Deadline deadline) {
   while (const int flush_res = PQflush(conn_)) {
     if (flush_res < 0) {
       throw CommandError(PQerrorMessage(conn_));
@@ -478,6 +485,255 @@ ResultSet PGConnectionWrapper::WaitResult(Deadline deadline,
   return MakeResult(std::move(handle));
 }
 
+void PGConnectionWrapper::PipelineSync() {
+#if LIBPQ_HAS_PIPELINING
+  CheckError<CommandError>("PQpipelineSync", PQpipelineSync(conn_));
+  UpdateLastUse();
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+}
+
+void PGConnectionWrapper::FlushPipeline(Deadline deadline) {
+  FlushOutput(deadline);
+}
+
+ResultSet PGConnectionWrapper::WaitPipelineSync(Deadline deadline,
+                                                tracing::ScopeTime& scope) {
+#if LIBPQ_HAS_PIPELINING
+  scope.Reset(scopes::kLibpqWaitResult);
+  auto handle = MakeResultHandle(nullptr);
+  try {
+    FlushOutput(deadline);
+    // libpq returns a null result after the results of each statement, two
+    // of them in a row mean there is no sync to wait for
+    bool is_statement_end = false;
+    while (true) {
+      ConsumeInput(deadline);
+      auto next_handle = MakeResultHandle(PQXgetResult(conn_));
+      if (!next_handle) {
+        if (is_statement_end) {
+          throw ConnectionError{"Pipeline segment ends without a sync"};
+        }
+        is_statement_end = true;
+        continue;
+      }
+      is_statement_end = false;
+      const auto status = PQresultStatus(next_handle.get());
+      if (status == PGRES_PIPELINE_SYNC) break;
+      // the statements after an error of the segment are skipped
+      if (status == PGRES_PIPELINE_ABORTED) continue;
+      handle = std::move(next_handle);
+    }
+  } catch (const std::exception& e) {
+    // the rest of the pipeline is lost
+    PGCW_LOG_LIMITED_WARNING()
+        << "Failed to receive a pipeline segment, closing connection: " << e;
+    Close().Wait();
+    throw;
+  }
+  UpdateLastUse();
+  return MakeResult(std::move(handle));
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+  return ResultSet{nullptr};
+#endif
+}
+
+void PGConnectionWrapper::WaitCopyStart(ExecStatusType expected,
+                                        Deadline deadline,
+                                        tracing::ScopeTime& scope) {
+  UASSERT(expected == PGRES_COPY_IN || expected == PGRES_COPY_OUT);
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  ConsumeInput(deadline);
+  auto handle = MakeResultHandle(PQXgetResult(conn_));
+  const auto status =
+      handle ? PQresultStatus(handle.get()) : PGRES_EMPTY_QUERY;
+  switch (status) {
+    case PGRES_COPY_IN:
+    case PGRES_COPY_OUT:
+      // libpq keeps returning the COPY result until the COPY is over, there
+      // is no way to skip it without the COPY data
+      if (status != expected) {
+        CloseWithError(LogicError{
+            expected == PGRES_COPY_IN
+                ? "COPY FROM STDIN was expected, got COPY TO STDOUT"
+                : "COPY TO STDOUT was expected, got COPY FROM STDIN"});
+      }
+      if (!PQbinaryTuples(handle.get())) {
+        CloseWithError(LogicError{
+            "Only binary COPY is supported, add `(FORMAT binary)` to the "
+            "COPY statement"});
+      }
+      UpdateLastUse();
+      return;
+    case PGRES_COPY_BOTH:
+      MakeResult(std::move(handle));
+      break;
+    default:
+      break;
+  }
+
+  while (auto* pg_res = PQXgetResult(conn_)) {
+    handle = MakeResultHandle(pg_res);
+    ConsumeInput(deadline);
+  }
+  // throws on errors
+  MakeResult(std::move(handle));
+  throw LogicError{"Statement is not a COPY FROM STDIN or COPY TO STDOUT"};
+}
+
+void PGConnectionWrapper::PutCopyData(std::string_view data,
+                                      Deadline deadline) {
+  while (true) {
+    const int res = PQputCopyData(conn_, data.data(), data.size());
+    if (res > 0) break;
+    if (res < 0) {
+      throw CommandError(std::string{"PQputCopyData execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+    // the output buffer of libpq is full
+    FlushOutput(deadline);
+  }
+  // Sends the data right away, so that a fast producer waits for the socket
+  // instead of growing the output buffer of libpq
+  FlushOutput(deadline);
+  UpdateLastUse();
+}
+
+void PGConnectionWrapper::PutCopyEnd(const char* error_message,
+                                     Deadline deadline) {
+  while (true) {
+    const int res = PQputCopyEnd(conn_, error_message);
+    if (res > 0) break;
+    if (res < 0) {
+      throw CommandError(std::string{"PQputCopyEnd execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+    FlushOutput(deadline);
+  }
+  FlushOutput(deadline);
+  UpdateLastUse();
+}
+
+bool PGConnectionWrapper::GetCopyData(std::string& buffer, Deadline deadline) {
+  while (true) {
+    char* data = nullptr;
+    const int res = PQgetCopyData(conn_, &data, /*async=*/1);
+    if (res > 0) {
+      std::unique_ptr<char, decltype(&PQfreemem)> holder{data, &PQfreemem};
+      buffer.append(data, res);
+      return true;
+    }
+    if (res == -1) return false;
+    if (res < -1) {
+      throw CommandError(std::string{"PQgetCopyData execution error: "} +
+                         PQerrorMessage(conn_));
+    }
+
+    // a complete message is not received yet
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while receiving COPY data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while receiving COPY data from PostgreSQL connection "
+             "socket";
+      throw ConnectionTimeoutError("Timed out while receiving COPY data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+  }
+}
+
+void PGConnectionWrapper::StartRowsStream(std::size_t chunk_size,
+                                          Deadline deadline) {
+  UASSERT(chunk_size > 0);
+#if LIBPQ_HAS_CHUNK_MODE
+  CheckError<CommandError>(
+      "PQsetChunkedRowsMode",
+      PQsetChunkedRowsMode(
+          conn_, static_cast<int>(std::min<std::size_t>(
+                     chunk_size, std::numeric_limits<int>::max()))));
+#else
+  CheckError<CommandError>("PQsetSingleRowMode", PQsetSingleRowMode(conn_));
+#endif
+  Flush(deadline);
+}
+
+ResultSet PGConnectionWrapper::WaitResultChunk(std::size_t chunk_size,
+                                               Deadline deadline,
+                                               tracing::ScopeTime& scope) {
+  scope.Reset(scopes::kLibpqWaitResult);
+  const auto make_chunk = [this](ResultHandle&& chunk) {
+    // Reads the rows the server has sent so far without waiting for them,
+    // so that the server keeps sending while the chunk is parsed
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+    return MakeResult(std::move(chunk));
+  };
+
+  auto chunk = MakeResultHandle(nullptr);
+  std::size_t rows = 0;
+  auto handle = MakeResultHandle(nullptr);
+  while (true) {
+    ConsumeInput(deadline);
+    handle = MakeResultHandle(PQXgetResult(conn_));
+    if (!handle) break;
+
+    const auto status = PQresultStatus(handle.get());
+    if (status == PGRES_SINGLE_TUPLE) {
+      if (!chunk) {
+        chunk = MakeResultHandle(
+            PQcopyResult(handle.get(), PG_COPYRES_ATTRS | PG_COPYRES_TUPLES));
+        if (!chunk) throw CommandError{"PQcopyResult failed"};
+      } else {
+        const auto row = static_cast<int>(rows);
+        for (int field = 0; field < PQnfields(handle.get()); ++field) {
+          const bool is_null = PQgetisnull(handle.get(), 0, field);
+          CheckError<CommandError>(
+              "PQsetvalue",
+              PQsetvalue(chunk.get(), row, field,
+                         is_null ? nullptr
+                                 : PQgetvalue(handle.get(), 0, field),
+                         is_null ? -1 : PQgetlength(handle.get(), 0, field)));
+        }
+      }
+      if (++rows < chunk_size) continue;
+      return make_chunk(std::move(chunk));
+    }
+#if LIBPQ_HAS_CHUNK_MODE
+    if (status == PGRES_TUPLES_CHUNK) return make_chunk(std::move(handle));
+#endif
+    // the final result of the statement
+    break;
+  }
+
+  // the statement is over, reads the rest of its results
+  do {
+    ConsumeInput(deadline);
+    while (auto* pg_res = PQXgetResult(conn_)) {
+      auto next_handle = MakeResultHandle(pg_res);
+      ConsumeInput(deadline);
+#if LIBPQ_HAS_PIPELINING
+      if (is_syncing_pipeline_ &&
+          PQresultStatus(next_handle.get()) == PGRES_PIPELINE_SYNC) {
+        is_syncing_pipeline_ = false;
+        continue;
+      }
+#endif
+      if (!handle) handle = std::move(next_handle);
+    }
+  } while (is_syncing_pipeline_);
+  UpdateLastUse();
+
+  // throws the error of the statement
+  auto res = MakeResult(std::move(handle));
+  if (chunk) return MakeResult(std::move(chunk));
+  return res;
+}
+
 void PGConnectionWrapper::DiscardInput(Deadline deadline) {
   Flush(deadline);
   auto handle = MakeResultHandle(nullptr);
@@ -485,6 +741,15 @@ void PGConnectionWrapper::DiscardInput(Deadline deadline) {
   do {
     while (auto* pg_res = PQXgetResult(conn_)) {
       handle = MakeResultHandle(pg_res);
+      switch (PQresultStatus(handle.get())) {
+        case PGRES_COPY_IN:
+        case PGRES_COPY_OUT:
+        case PGRES_COPY_BOTH:
+          // libpq returns the COPY result until the COPY is over
+          CloseWithError(ConnectionError{"Connection is left in COPY state"});
+        default:
+          break;
+      }
       ConsumeInput(deadline);
 #if LIBPQ_HAS_PIPELINING
       if (is_syncing_pipeline_ &&
@@ -518,6 +783,11 @@ ResultSet PGConnectionWrapper::MakeResult(ResultHandle&& handle) {
     case PGRES_TUPLES_OK:
       PGCW_LOG_TRACE() << "Successful completion of a command returning data";
       break;
+#if LIBPQ_HAS_CHUNK_MODE
+    case PGRES_TUPLES_CHUNK:
+      PGCW_LOG_TRACE() << "A chunk of rows of a command returning data";
+      break;
+#endif
     case PGRES_SINGLE_TUPLE:
       PGCW_LOG_LIMITED_ERROR()
           << "libpq was switched to SINGLE_ROW mode, this is not supported.";
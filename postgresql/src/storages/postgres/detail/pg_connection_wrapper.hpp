@@ -100,6 +100,57 @@ class PGConnectionWrapper {
   /// Will return result or throw an exception
   ResultSet WaitResult(Deadline deadline, tracing::ScopeTime&);
 
+  /// @brief Wrapper for PQpipelineSync, ends a segment of the pipeline.
+  ///
+  /// The statements of a segment are executed in an implicit transaction, an
+  /// error aborts only the rest of its segment. Does not wait for the output
+  /// to be sent, see FlushPipeline.
+  ///
+  /// Requires libpq >= 14.
+  void PipelineSync();
+
+  /// @brief Send the buffered pipeline segments to the server
+  void FlushPipeline(Deadline deadline);
+
+  /// @brief Wait for the results of the next segment of the pipeline.
+  /// Will return the result of the last statement of the segment or throw the
+  /// error of the segment.
+  /// The connection is closed if the segment can not be read to its end.
+  ResultSet WaitPipelineSync(Deadline deadline, tracing::ScopeTime&);
+
+  /// @brief Wait for the start of a binary COPY of the expected direction,
+  /// PGRES_COPY_IN or PGRES_COPY_OUT.
+  /// Will throw an exception on errors and for statements that are not COPY.
+  void WaitCopyStart(ExecStatusType expected, Deadline deadline,
+                     tracing::ScopeTime&);
+
+  /// @brief Wrapper for PQputCopyData, waits for the data to be sent to the
+  /// socket
+  void PutCopyData(std::string_view data, Deadline deadline);
+
+  /// @brief Wrapper for PQputCopyEnd, a non-null error message fails the
+  /// COPY. The result of the COPY is then available via WaitResult.
+  void PutCopyEnd(const char* error_message, Deadline deadline);
+
+  /// @brief Wrapper for PQgetCopyData, appends a single COPY data message to
+  /// the buffer
+  /// @returns false when there is no more data, the result of the COPY is
+  /// then available via WaitResult
+  bool GetCopyData(std::string& buffer, Deadline deadline);
+
+  /// @brief Wrapper for PQsetChunkedRowsMode or PQsetSingleRowMode if libpq
+  /// has no chunked mode, must be called right after sending a statement.
+  /// Flushes the statement.
+  void StartRowsStream(std::size_t chunk_size, Deadline deadline);
+
+  /// @brief Wait for the next chunk of at most chunk_size rows of a statement
+  /// started with StartRowsStream.
+  /// The rows of the single row mode are gathered into a single result. The
+  /// last chunk may be empty, the connection is not busy after it.
+  /// Will throw the error of the statement.
+  ResultSet WaitResultChunk(std::size_t chunk_size, Deadline deadline,
+                            tracing::ScopeTime&);
+
   /// Consume input from connection
   void ConsumeInput(Deadline deadline);
   /// Consume all input discarding all result sets
@@ -138,6 +189,10 @@ class PGConnectionWrapper {
 
   void Flush(Deadline deadline);
 
+  /// Sends the output buffer of libpq to the socket, waits for the socket if
+  /// needed
+  void FlushOutput(Deadline deadline);
+
   ResultSet MakeResult(ResultHandle&& handle);
 
   template <typename ExceptionType>
@@ -1,5 +1,6 @@
 #include <storages/postgres/detail/pool.hpp>
 
+#include <storages/postgres/detail/statement_timer.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 
 #include <userver/engine/async.hpp>
@@ -84,9 +85,13 @@ ConnectionPool::ConnectionPool(
       ei_settings_(std::move(ei_settings)),
       cancel_limit_{std::max(std::size_t{1}, settings.max_size / kCancelRatio),
                     {1, kCancelPeriod}},
-      sts_{statement_metrics_settings} {}
+      sts_{statement_metrics_settings},
+      warmup_statements_{std::max(std::size_t{1},
+                                  conn_settings.prepared_warmup_size)} {}
 
 ConnectionPool::~ConnectionPool() {
+  // The lanes use the pool for their connections
+  multiplexer_.reset();
   StopMaintainTask();
   Clear();
 }
@@ -147,6 +152,7 @@ void ConnectionPool::Init(InitMode mode) {
   }
   LOG_INFO() << "Pool initialized";
   StartMaintainTask();
+  StartMultiplexer();
 }
 
 ConnectionPtr ConnectionPool::Acquire(engine::Deadline deadline) {
@@ -176,6 +182,9 @@ void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
   stats_.transaction.execute_timeout += conn_stats.execute_timeout;
   stats_.transaction.duplicate_prepared_statements +=
       conn_stats.duplicate_prepared_statements;
+  stats_.transaction.prepared_cache_hit += conn_stats.prepared_cache_hit;
+  stats_.transaction.prepared_cache_miss += conn_stats.prepared_cache_miss;
+  stats_.transaction.prepared_cache_evict += conn_stats.prepared_cache_evict;
 
   stats_.transaction.total_percentile.GetCurrentCounter().Account(
       std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -199,12 +208,39 @@ void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
           .count());
 }
 
+void ConnectionPool::RememberPreparedStatements(Connection& connection) {
+  if (conn_settings_.prepared_warmup_size == 0) return;
+  auto statements = connection.TakeNewlyPrepared();
+  if (statements.empty()) return;
+  auto warmup_statements = warmup_statements_.Lock();
+  for (auto& statement : statements) {
+    const auto id = statement.id;
+    warmup_statements->Put(id, std::move(statement));
+  }
+}
+
+void ConnectionPool::WarmUpConnection(Connection& connection) {
+  if (conn_settings_.prepared_warmup_size == 0) return;
+  std::vector<Connection::PreparedStatement> statements;
+  {
+    auto warmup_statements = warmup_statements_.Lock();
+    statements.reserve(warmup_statements->GetSize());
+    warmup_statements->VisitAll(
+        [&statements](const Connection::StatementId&,
+                      const Connection::PreparedStatement& statement) {
+          statements.push_back(statement);
+        });
+  }
+  if (!statements.empty()) connection.PrepareStatements(statements);
+}
+
 void ConnectionPool::Release(Connection* connection) {
   UASSERT(connection);
   using DecGuard = USERVER_NAMESPACE::utils::SizeGuard<
       USERVER_NAMESPACE::utils::statistics::RelaxedCounter<uint32_t>>;
   DecGuard dg{stats_.connection.used, DecGuard::DontIncrement{}};
 
+  RememberPreparedStatements(*connection);
   // Grab stats only if connection is not in transaction
   if (!connection->IsInTransaction()) {
     AccountConnectionStats(connection->GetStatsAndReset());
@@ -293,6 +329,9 @@ Transaction ConnectionPool::Begin(const TransactionOptions& options,
 }
 
 NonTransaction ConnectionPool::Start(OptionalCommandControl cmd_ctl) {
+  if (multiplexer_) {
+    return NonTransaction{shared_from_this()};
+  }
   const auto start_time = detail::SteadyClock::now();
   const auto deadline =
       testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
@@ -301,6 +340,28 @@ NonTransaction ConnectionPool::Start(OptionalCommandControl cmd_ctl) {
   return NonTransaction{std::move(conn), start_time};
 }
 
+ConnectionPtr ConnectionPool::AcquireForStream(
+    OptionalCommandControl cmd_ctl) {
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+  auto conn = Acquire(deadline);
+  UASSERT(conn);
+  return conn;
+}
+
+ResultSet ConnectionPool::ExecuteMultiplexed(
+    const Query& query, const ParamsWriter& writer,
+    OptionalCommandControl statement_cmd_ctl) {
+  UASSERT(multiplexer_);
+  const auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(
+      GetExecuteTimeout(statement_cmd_ctl));
+  StatementTimer timer{query, sts_};
+  auto res = multiplexer_->Execute(query, writer, std::move(statement_cmd_ctl),
+                                   deadline);
+  timer.Account();
+  return res;
+}
+
 TimeoutDuration ConnectionPool::GetExecuteTimeout(
     OptionalCommandControl cmd_ctl) const {
   if (cmd_ctl) return cmd_ctl->execute;
@@ -368,6 +429,15 @@ engine::TaskWithResult<bool> ConnectionPool::Connect(
       throw;
     }
     LOG_TRACE() << "PostgreSQL connection created";
+    try {
+      shared_this->WarmUpConnection(*connection);
+    } catch (const ConnectionError& ex) {
+      ++shared_this->stats_.connection.error_total;
+      ++shared_this->stats_.connection.drop_total;
+      LOG_LIMITED_WARNING() << "Connection broke while preparing statements: "
+                            << ex;
+      return false;
+    }
 
     // Clean up the statistics and not account it
     [[maybe_unused]] const auto& stats = connection->GetStatsAndReset();
@@ -377,6 +447,57 @@ engine::TaskWithResult<bool> ConnectionPool::Connect(
   });
 }
 
+std::unique_ptr<Connection> ConnectionPool::ConnectMultiplexed() {
+  auto conn_settings = conn_settings_;
+  conn_settings.pipeline_mode = ConnectionSettings::kPipelineEnabled;
+  const uint32_t conn_id = ++stats_.connection.open_total;
+  Stopwatch st{stats_.connection_percentile};
+  try {
+    auto connection = Connection::Connect(
+        dsn_, resolver_, bg_task_processor_, conn_id, conn_settings,
+        default_cmd_ctls_, testsuite_pg_ctl_, ei_settings_,
+        SharedSizeGuard{size_});
+    // Clean up the statistics and not account it
+    [[maybe_unused]] const auto& stats = connection->GetStatsAndReset();
+    return connection;
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.connection.error_timeout;
+    ++stats_.connection.error_total;
+    ++stats_.connection.drop_total;
+    throw;
+  } catch (const Error&) {
+    ++stats_.connection.error_total;
+    ++stats_.connection.drop_total;
+    throw;
+  }
+}
+
+void ConnectionPool::StartMultiplexer() {
+  if (conn_settings_.multiplexed_connections == 0) return;
+  if (!Multiplexer::IsSupported()) {
+    LOG_WARNING() << "Multiplexed connections require the pipeline mode, "
+                     "which is not supported, falling back";
+    return;
+  }
+  LOG_INFO() << "Multiplexing statements over "
+             << conn_settings_.multiplexed_connections
+             << " PostgreSQL connections to " << DsnCutPassword(dsn_);
+  multiplexer_ = std::make_unique<Multiplexer>(
+      conn_settings_.multiplexed_connections,
+      Multiplexer::ConnectionCallbacks{
+          [this] { return ConnectMultiplexed(); },
+          [this](Connection::Statistics stats) {
+            AccountConnectionStats(stats);
+          },
+          [this](std::unique_ptr<Connection> connection) {
+            if (connection->IsConnected()) {
+              DeleteConnection(connection.release());
+            } else {
+              DeleteBrokenConnection(connection.release());
+            }
+          }});
+}
+
 void ConnectionPool::TryCreateConnectionAsync() {
   SharedSizeGuard sg(size_);
   auto settings = settings_.Read();
@@ -6,7 +6,9 @@
 
 #include <boost/lockfree/queue.hpp>
 
+#include <userver/cache/lru_map.hpp>
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -26,6 +28,7 @@
 #include <userver/storages/postgres/transaction.hpp>
 
 #include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/multiplexer.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 
@@ -67,6 +70,15 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   [[nodiscard]] NonTransaction Start(OptionalCommandControl cmd_ctl = {});
 
+  /// Acquire a connection for a ResultStream, the multiplexed connections
+  /// are never used for that
+  [[nodiscard]] ConnectionPtr AcquireForStream(OptionalCommandControl cmd_ctl);
+
+  /// Execute a statement over a multiplexed connection, see
+  /// ConnectionSettings::multiplexed_connections
+  ResultSet ExecuteMultiplexed(const Query& query, const ParamsWriter& writer,
+                               OptionalCommandControl statement_cmd_ctl);
+
   CommandControl GetDefaultCommandControl() const;
 
   void SetSettings(const PoolSettings& settings);
@@ -87,6 +99,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   TimeoutDuration GetExecuteTimeout(OptionalCommandControl) const;
 
   [[nodiscard]] engine::TaskWithResult<bool> Connect(SharedSizeGuard&&);
+  std::unique_ptr<Connection> ConnectMultiplexed();
+  void StartMultiplexer();
 
   void TryCreateConnectionAsync();
   void CheckMinPoolSizeUnderflow();
@@ -101,6 +115,11 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   void AccountConnectionStats(Connection::Statistics stats);
 
+  /// Remember the statements prepared by the connection for the warmup of the
+  /// new connections, see ConnectionSettings::prepared_warmup_size
+  void RememberPreparedStatements(Connection& connection);
+  void WarmUpConnection(Connection& connection);
+
   Connection* AcquireImmediate();
   void MaintainConnections();
   void StartMaintainTask();
@@ -108,6 +127,9 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   using RecentCounter = USERVER_NAMESPACE::utils::statistics::RecentPeriod<
       USERVER_NAMESPACE::utils::statistics::RelaxedCounter<size_t>, size_t>;
+  using WarmupStatements =
+      USERVER_NAMESPACE::cache::LruMap<Connection::StatementId,
+                                       Connection::PreparedStatement>;
 
   mutable InstanceStatistics stats_;
   Dsn dsn_;
@@ -129,6 +151,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   RecentCounter recent_conn_errors_;
   USERVER_NAMESPACE::utils::TokenBucket cancel_limit_;
   detail::StatementTimingsStorage sts_;
+  std::unique_ptr<Multiplexer> multiplexer_;
+  USERVER_NAMESPACE::concurrent::Variable<WarmupStatements> warmup_statements_;
 };
 
 }  // namespace storages::postgres::detail
@@ -48,6 +48,12 @@ class ResultWrapper {
   bool IsFieldNull(std::size_t row, std::size_t col) const;
   std::size_t GetFieldLength(std::size_t row, std::size_t col) const;
   io::FieldBuffer GetFieldBuffer(std::size_t row, std::size_t col) const;
+  /// Buffers of the fields of the rows [first_row, first_row + count) of the
+  /// column, the format and the buffer category are checked once
+  void GetColumnBuffers(std::size_t col, std::size_t first_row,
+                        std::size_t count, io::FieldBuffer* buffers) const;
+  /// @throws ResultSetError if the column is not in the binary format
+  void CheckBinaryFormat(std::size_t col) const;
   //@}
 
   //@{
@@ -13,6 +13,10 @@ StatementTimer::StatementTimer(const Query& query, const ConnectionPtr& conn)
       sts_{conn.GetStatementTimingsStorage()},
       start_{sts_ != nullptr ? Now() : SteadyClock::time_point{}} {}
 
+StatementTimer::StatementTimer(const Query& query,
+                               const StatementTimingsStorage& sts)
+    : query_{query}, sts_{&sts}, start_{Now()} {}
+
 void StatementTimer::Account() {
   if (sts_ == nullptr || !query_.GetName().has_value()) return;
 
@@ -6,12 +6,71 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::utils {
 
+namespace {
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' ||
+         c == '\v';
+}
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+// The tokens after which the whitespace is significant or the quotes can not
+// be tracked without a tokenizer
+bool StartsVerbatimText(std::string_view statement, std::size_t pos) {
+  const auto c = statement[pos];
+  const auto next = pos + 1 < statement.size() ? statement[pos + 1] : '\0';
+  return c == '\\' || (c == '-' && next == '-') || (c == '/' && next == '*') ||
+         (c == '$' && !IsDigit(next));
+}
+
+}  // namespace
+
 std::size_t StrHash(const char* str, std::size_t len) {
   auto seed = len;
   boost::hash_range(seed, str, str + len);
   return seed;
 }
 
+std::size_t QueryTextHash(std::string_view statement) {
+  std::size_t seed = 0;
+  std::size_t length = 0;
+  const auto hash_char = [&seed, &length](char c) {
+    boost::hash_combine(seed, c);
+    ++length;
+  };
+
+  char quote = '\0';
+  bool pending_space = false;
+  for (std::size_t i = 0; i < statement.size(); ++i) {
+    const auto c = statement[i];
+    if (StartsVerbatimText(statement, i)) {
+      if (pending_space) hash_char(' ');
+      boost::hash_range(seed, statement.begin() + i, statement.end());
+      length += statement.size() - i;
+      break;
+    }
+    if (quote != '\0') {
+      if (c == quote) quote = '\0';
+      hash_char(c);
+      continue;
+    }
+    if (IsSpace(c)) {
+      // leading whitespace is skipped
+      pending_space = length > 0;
+      continue;
+    }
+    if (pending_space) {
+      hash_char(' ');
+      pending_space = false;
+    }
+    if (c == '\'' || c == '"') quote = c;
+    hash_char(c);
+  }
+  boost::hash_combine(seed, length);
+  return seed;
+}
+
 }  // namespace storages::postgres::utils
 
 USERVER_NAMESPACE_END
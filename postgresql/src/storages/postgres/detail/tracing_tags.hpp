@@ -20,6 +20,8 @@ const std::string kPrepare = "pg_prepare";
 const std::string kBind = "pg_bind";
 /// Execute query, driver level
 const std::string kExec = "pg_exec";
+/// Execute a batch of queries of different tasks in a pipeline
+const std::string kMultiplexedBatch = "pg_multiplexed_batch";
 
 // libpq stages
 /// libpq async connect stage
@@ -1,8 +1,11 @@
 #include <benchmark/benchmark.h>
 
 #include <limits>
+#include <tuple>
+#include <vector>
 
 #include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
 
 #include <storages/postgres/util_benchmark.hpp>
 
@@ -53,6 +56,63 @@ BENCHMARK_F(PgConnection, Int64Roundtrip)(benchmark::State& state) {
   });
 }
 
+// Large results take longer than kBenchCmdCtl allows
+constexpr pg::CommandControl kSelectCmdCtl{std::chrono::seconds{30},
+                                           std::chrono::seconds{30}};
+
+pg::ResultSet SelectFixedWidthColumns(pg::detail::Connection& conn,
+                                      std::int64_t rows) {
+  return conn.Execute(kSelectCmdCtl,
+                      "select i::integer, i::bigint, "
+                      "i * 0.5::double precision, "
+                      "'2000-01-01'::timestamp + i * interval '1 second' "
+                      "from generate_series(1, $1) i",
+                      rows);
+}
+
+using FixedWidthRow =
+    std::tuple<std::int32_t, std::int64_t, double, pg::TimePoint>;
+
+struct FixedWidthColumns {
+  std::vector<std::int32_t> ints;
+  std::vector<std::int64_t> bigints;
+  std::vector<double> doubles;
+  std::vector<pg::TimePoint> timestamps;
+};
+
+BENCHMARK_DEFINE_F(PgConnection, FixedWidthAsSetOf)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto res = SelectFixedWidthColumns(GetConnection(), state.range(0));
+    std::vector<FixedWidthRow> rows;
+    for (auto _ : state) {
+      rows.clear();
+      for (auto row : res.AsSetOf<FixedWidthRow>(pg::kRowTag)) {
+        rows.push_back(row);
+      }
+      benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * res.Size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, FixedWidthAsSetOf)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+BENCHMARK_DEFINE_F(PgConnection, FixedWidthToColumns)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto res = SelectFixedWidthColumns(GetConnection(), state.range(0));
+    FixedWidthColumns columns;
+    for (auto _ : state) {
+      res.ToColumns(columns, pg::kRowTag);
+      benchmark::DoNotOptimize(columns);
+    }
+    state.SetItemsProcessed(state.iterations() * res.Size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, FixedWidthToColumns)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
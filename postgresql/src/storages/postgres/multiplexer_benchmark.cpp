@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/postgres/dsn.hpp>
+
+#include <storages/postgres/default_command_controls.hpp>
+#include <storages/postgres/detail/multiplexer.hpp>
+#include <storages/postgres/detail/pool.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+constexpr std::size_t kThreadsCount = 4;
+constexpr std::size_t kMaxPoolSize = 100;
+constexpr int kStatementsPerTask = 100;
+
+// Long enough for a queue of a hundred of statements
+constexpr pg::CommandControl kPoolCmdCtl{std::chrono::seconds{5},
+                                         std::chrono::seconds{5}};
+
+pg::Dsn GetDsnFromEnv() {
+  auto* conn_list_env = std::getenv(kPostgresDsn);
+  if (!conn_list_env) {
+    return pg::Dsn{{}};
+  }
+  auto by_host = pg::SplitByHost(pg::Dsn{conn_list_env});
+  if (by_host.empty()) {
+    return pg::Dsn{{}};
+  }
+  return by_host[0];
+}
+
+/// Runs state.range(0) tasks executing single statements out of transactions
+/// concurrently, reports the number of connections opened by the pool
+void RunConcurrentStatements(benchmark::State& state,
+                             std::size_t multiplexed_connections) {
+  engine::RunStandalone(kThreadsCount, [&] {
+    const auto dsn = GetDsnFromEnv();
+    if (dsn.empty()) {
+      state.SkipWithError("Database not connected");
+      return;
+    }
+    if (multiplexed_connections && !pg::detail::Multiplexer::IsSupported()) {
+      state.SkipWithError("libpq is built without the pipeline mode");
+      return;
+    }
+
+    pg::ConnectionSettings conn_settings{
+        pg::ConnectionSettings::kCachePreparedStatements};
+    conn_settings.multiplexed_connections = multiplexed_connections;
+    auto pool = pg::detail::ConnectionPool::Create(
+        dsn, nullptr, engine::current_task::GetTaskProcessor(), "",
+        pg::InitMode::kAsync, {0, kMaxPoolSize, kMaxPoolSize * 10},
+        conn_settings, {}, pg::DefaultCommandControls(kPoolCmdCtl, {}, {}),
+        {}, {});
+
+    const auto tasks_count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(tasks_count);
+      for (std::size_t i = 0; i < tasks_count; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&pool] {
+          for (int j = 0; j < kStatementsPerTask; ++j) {
+            benchmark::DoNotOptimize(
+                pool->Start().Execute("select $1::integer", j));
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+    }
+    state.SetItemsProcessed(state.iterations() * tasks_count *
+                            kStatementsPerTask);
+    state.counters["connections"] =
+        static_cast<double>(pool->GetStatistics().connection.active);
+  });
+}
+
+void PoolExecute(benchmark::State& state) {
+  RunConcurrentStatements(state, 0);
+}
+BENCHMARK(PoolExecute)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+
+void MultiplexedExecute(benchmark::State& state) {
+  RunConcurrentStatements(state, static_cast<std::size_t>(state.range(1)));
+}
+BENCHMARK(MultiplexedExecute)
+    ->ArgsProduct({benchmark::CreateRange(1, 256, 4), {1, 2, 4}})
+    ->UseRealTime();
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -245,6 +245,28 @@ Row::size_type Row::IndexOfName(const std::string& name) const {
   return res_->IndexOfName(name);
 }
 
+//----------------------------------------------------------------------------
+// Columnar results support
+//----------------------------------------------------------------------------
+namespace detail {
+
+void GetColumnBuffers(const ResultWrapperPtr& res, std::size_t col,
+                      std::size_t first_row, std::size_t count,
+                      io::FieldBuffer* buffers) {
+  res->GetColumnBuffers(col, first_row, count, buffers);
+}
+
+std::string_view GetColumnName(const ResultWrapperPtr& res, std::size_t col) {
+  return res->GetFieldName(col);
+}
+
+const io::TypeBufferCategory& GetColumnTypeBufferCategories(
+    const ResultWrapperPtr& res) {
+  return res->GetTypeBufferCategories();
+}
+
+}  // namespace detail
+
 }  // namespace storages::postgres
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,91 @@
+#include <userver/storages/postgres/result_stream.hpp>
+
+#include <userver/logging/log.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+ResultStream::ResultStream(detail::ConnectionPtr&& conn, std::size_t chunk_size,
+                           OptionalCommandControl statement_cmd_ctl)
+    : conn_{std::move(conn)},
+      chunk_size_{chunk_size},
+      cmd_ctl_{std::move(statement_cmd_ctl)} {
+  UASSERT(conn_);
+  if (chunk_size_ == 0) {
+    throw LogicError{"Chunk size of a result stream must be positive"};
+  }
+  conn_->Start(detail::SteadyClock::now());
+}
+
+ResultStream::ResultStream(ResultStream&&) noexcept = default;
+
+ResultStream& ResultStream::operator=(ResultStream&& rhs) noexcept {
+  if (this != &rhs) {
+    ReleaseConnection();
+    conn_ = std::move(rhs.conn_);
+    chunk_size_ = rhs.chunk_size_;
+    cmd_ctl_ = std::move(rhs.cmd_ctl_);
+    fetched_so_far_ = rhs.fetched_so_far_;
+  }
+  return *this;
+}
+
+ResultStream::~ResultStream() { ReleaseConnection(); }
+
+ResultSet ResultStream::Fetch() {
+  if (!conn_) {
+    throw RuntimeError{"Result stream is done, no more rows to fetch"};
+  }
+  try {
+    auto res = conn_->StreamFetch(chunk_size_, cmd_ctl_);
+    fetched_so_far_ += res.Size();
+    if (conn_->GetState() != ConnectionState::kTranActive) {
+      // all the rows are received, the connection is not needed anymore
+      ReleaseConnection();
+    }
+    return res;
+  } catch (const std::exception&) {
+    ReleaseConnection();
+    throw;
+  }
+}
+
+void ResultStream::DoStart(const Query& query,
+                           const detail::QueryParameters& params) {
+  UASSERT(conn_);
+  try {
+    conn_->StreamStart(query, params, chunk_size_, cmd_ctl_);
+  } catch (const std::exception&) {
+    ReleaseConnection();
+    throw;
+  }
+}
+
+const UserTypes& ResultStream::GetConnectionUserTypes() const {
+  UASSERT(conn_);
+  return conn_->GetUserTypes();
+}
+
+void ResultStream::ReleaseConnection() noexcept {
+  if (!conn_) return;
+
+  try {
+    if (conn_->GetState() == ConnectionState::kTranActive) {
+      LOG_DEBUG() << "Result stream is released before receiving all the "
+                     "rows, cancelling the statement";
+      conn_->StreamCancel();
+    }
+    conn_->Finish();
+  } catch (const std::exception& e) {
+    LOG_LIMITED_ERROR() << "Exception when releasing a result stream: " << e;
+  }
+  conn_ = detail::ConnectionPtr{std::unique_ptr<detail::Connection>{}};
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+// Receiving of large results takes longer than kBenchCmdCtl allows
+constexpr pg::CommandControl kLoadCmdCtl{std::chrono::seconds{30},
+                                         std::chrono::seconds{30}};
+
+constexpr std::size_t kChunkSize = 1'000;
+
+const std::string kSelect =
+    "select i::bigint, 'name ' || i, i * 0.5::double precision "
+    "from generate_series(1, $1) i";
+
+using Row = std::tuple<pg::Bigint, std::string, double>;
+
+// Current resident set size, ru_maxrss of getrusage is the peak of the whole
+// process and does not tell the benchmarks apart
+long CurrentRssKb() {
+  std::ifstream statm{"/proc/self/statm"};
+  long total = 0;
+  long resident = 0;
+  statm >> total >> resident;
+  return resident * (::sysconf(_SC_PAGESIZE) / 1024);
+}
+
+class Measurements {
+ public:
+  Measurements() : rss_base_kb_{CurrentRssKb()} {}
+
+  void Start() { start_ = std::chrono::steady_clock::now(); }
+
+  void FirstRow() {
+    if (first_row_) return;
+    first_row_ = true;
+    first_row_total_ += std::chrono::steady_clock::now() - start_;
+  }
+
+  void SampleRss() {
+    peak_rss_kb_ = std::max(peak_rss_kb_, CurrentRssKb() - rss_base_kb_);
+  }
+
+  void NextIteration() { first_row_ = false; }
+
+  void Report(benchmark::State& state) const {
+    state.counters["first_row_us"] = benchmark::Counter(
+        std::chrono::duration<double, std::micro>(first_row_total_).count(),
+        benchmark::Counter::kAvgIterations);
+    state.counters["peak_rss_kb"] = static_cast<double>(peak_rss_kb_);
+  }
+
+ private:
+  const long rss_base_kb_;
+  long peak_rss_kb_{0};
+  bool first_row_{false};
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::duration first_row_total_{};
+};
+
+void SelectAll(benchmark::State& state, pg::detail::Connection& conn) {
+  const auto rows = state.range(0);
+  Measurements measurements;
+  for (auto _ : state) {
+    measurements.Start();
+    {
+      auto res = conn.Execute(kLoadCmdCtl, kSelect, rows);
+      measurements.FirstRow();
+      auto set = res.AsContainer<std::vector<Row>>(pg::kRowTag);
+      measurements.SampleRss();
+      benchmark::DoNotOptimize(set);
+    }
+    measurements.NextIteration();
+  }
+  measurements.Report(state);
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+void StreamChunks(benchmark::State& state, pg::detail::Connection& conn) {
+  const auto rows = state.range(0);
+  Measurements measurements;
+  for (auto _ : state) {
+    measurements.Start();
+    pg::detail::StaticQueryParameters<1> params;
+    params.Write(conn.GetUserTypes(), rows);
+    conn.StreamStart(kSelect, pg::detail::QueryParameters{params}, kChunkSize,
+                     kLoadCmdCtl);
+    while (conn.GetState() == pg::ConnectionState::kTranActive) {
+      auto res = conn.StreamFetch(kChunkSize, kLoadCmdCtl);
+      measurements.FirstRow();
+      auto set = res.AsContainer<std::vector<Row>>(pg::kRowTag);
+      measurements.SampleRss();
+      benchmark::DoNotOptimize(set);
+    }
+    measurements.NextIteration();
+  }
+  measurements.Report(state);
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+// Streaming goes first as the memory freed by a full result is not
+// necessarily returned to the system
+BENCHMARK_DEFINE_F(PgConnection, StreamChunks)(benchmark::State& state) {
+  RunStandalone(state,
+                [this, &state] { StreamChunks(state, GetConnection()); });
+}
+BENCHMARK_REGISTER_F(PgConnection, StreamChunks)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+BENCHMARK_DEFINE_F(PgConnection, SelectAll)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] { SelectAll(state, GetConnection()); });
+}
+BENCHMARK_REGISTER_F(PgConnection, SelectAll)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
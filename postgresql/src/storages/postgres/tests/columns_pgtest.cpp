@@ -0,0 +1,156 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+// More than a single block of the column decoding
+constexpr int kRowsCount = 1'000;
+
+const std::string kSelectColumns =
+    "select i, i::bigint * 1000000000, i * 0.5::double precision, "
+    "(i * 0.25)::real, 'name ' || i, "
+    "'2000-01-01'::timestamp + i * interval '1 second', "
+    "'2000-01-01'::timestamptz + i * interval '1 second', "
+    "nullif(i % 3, 0)::bigint "
+    "from generate_series(1, $1) i";
+
+/// [Columns]
+struct Columns {
+  std::vector<int> ids;
+  std::vector<pg::Bigint> big_ids;
+  std::vector<double> weights;
+  std::vector<float> ratios;
+  std::vector<std::string> names;
+  std::vector<pg::TimePoint> created;
+  std::vector<pg::TimePointTz> updated;
+  std::vector<std::optional<pg::Bigint>> remainders;
+};
+/// [Columns]
+
+}  // namespace
+
+UTEST_P(PostgreConnection, ColumnsMatchRows) {
+  CheckConnection(conn);
+  auto res = conn->Execute(kSelectColumns, kRowsCount);
+  ASSERT_EQ(kRowsCount, static_cast<int>(res.Size()));
+
+  /// [AsColumns]
+  auto columns = res.AsColumns<Columns>(pg::kRowTag);
+  /// [AsColumns]
+  ASSERT_EQ(res.Size(), columns.ids.size());
+  ASSERT_EQ(res.Size(), columns.remainders.size());
+
+  std::size_t i = 0;
+  for (const auto& row :
+       res.AsSetOf<std::tuple<int, pg::Bigint, double, float, std::string,
+                              pg::TimePoint, pg::TimePointTz,
+                              std::optional<pg::Bigint>>>(pg::kRowTag)) {
+    EXPECT_EQ(std::get<0>(row), columns.ids[i]);
+    EXPECT_EQ(std::get<1>(row), columns.big_ids[i]);
+    EXPECT_EQ(std::get<2>(row), columns.weights[i]);
+    EXPECT_EQ(std::get<3>(row), columns.ratios[i]);
+    EXPECT_EQ(std::get<4>(row), columns.names[i]);
+    EXPECT_EQ(std::get<5>(row), columns.created[i]);
+    EXPECT_EQ(std::get<6>(row), columns.updated[i]);
+    EXPECT_EQ(std::get<7>(row), columns.remainders[i]);
+    ++i;
+  }
+  EXPECT_FALSE(columns.remainders[2].has_value());
+  EXPECT_EQ(pg::Bigint{1}, columns.remainders[0]);
+}
+
+UTEST_P(PostgreConnection, ColumnsTuple) {
+  CheckConnection(conn);
+  auto res = conn->Execute(
+      "select i, 'name ' || i from generate_series(1, $1) i", kRowsCount);
+
+  auto [ids, names] = res.AsColumns<int, std::string>();
+  ASSERT_EQ(res.Size(), ids.size());
+  ASSERT_EQ(res.Size(), names.size());
+  EXPECT_EQ(1, ids.front());
+  EXPECT_EQ(kRowsCount, ids.back());
+  EXPECT_EQ("name 1", names.front());
+
+  // a subset of the leading columns
+  auto [only_ids] = res.AsColumns<pg::Bigint>();
+  EXPECT_EQ(kRowsCount, only_ids.back());
+
+  UEXPECT_THROW((res.AsColumns<int, std::string, int>()),
+                pg::InvalidTupleSizeRequested);
+}
+
+UTEST_P(PostgreConnection, ColumnsReuseStorage) {
+  CheckConnection(conn);
+  std::vector<int> ids;
+  std::vector<std::string> names;
+
+  auto res = conn->Execute(
+      "select i, 'name ' || i from generate_series(1, $1) i", kRowsCount);
+  res.ToColumns(ids, names);
+  EXPECT_EQ(res.Size(), ids.size());
+  const auto* data = ids.data();
+
+  res = conn->Execute("select i, 'name ' || i from generate_series(1, $1) i",
+                      10);
+  res.ToColumns(ids, names);
+  EXPECT_EQ(10u, ids.size());
+  EXPECT_EQ(10u, names.size());
+  EXPECT_EQ(data, ids.data());
+  EXPECT_EQ(10, ids.back());
+
+  res = conn->Execute("select 1 where false");
+  res.ToColumns(ids);
+  EXPECT_TRUE(ids.empty());
+}
+
+UTEST_P(PostgreConnection, ColumnsNulls) {
+  CheckConnection(conn);
+  auto res = conn->Execute(
+      "select nullif(i, 300), nullif(i::text, '300') "
+      "from generate_series(1, 500) i");
+
+  UEXPECT_THROW(res.AsColumns<int>(), pg::FieldValueIsNull);
+  UEXPECT_THROW((res.AsColumns<std::optional<int>, std::string>()),
+                pg::FieldValueIsNull);
+
+  auto [ids, names] =
+      res.AsColumns<std::optional<int>, std::optional<std::string>>();
+  EXPECT_FALSE(ids[299].has_value());
+  EXPECT_FALSE(names[299].has_value());
+  EXPECT_EQ(301, ids[300]);
+  EXPECT_EQ("301", names[300]);
+}
+
+UTEST_P(PostgreConnection, ColumnsConversions) {
+  CheckConnection(conn);
+  auto res = conn->Execute(
+      "select i::smallint, i::integer from generate_series(1, 500) i");
+
+  // narrower columns are parsed value by value
+  auto [small_ids, ids] = res.AsColumns<pg::Bigint, pg::Bigint>();
+  EXPECT_EQ(500, small_ids.back());
+  EXPECT_EQ(500, ids.back());
+
+  res = conn->Execute(
+      "select 'infinity'::timestamp union all select '-infinity'::timestamp");
+  auto [timestamps] = res.AsColumns<pg::TimePoint>();
+  ASSERT_EQ(2u, timestamps.size());
+  EXPECT_EQ(pg::kTimestampPositiveInfinity, timestamps[0]);
+  EXPECT_EQ(pg::kTimestampNegativeInfinity, timestamps[1]);
+
+  res = conn->Execute("select array[1]");
+  UEXPECT_THROW(res.AsColumns<int>(), pg::InvalidParserCategory);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,199 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr pg::Bigint kRowsCount = 10'000;
+
+struct CopyRow {
+  int id{0};
+  std::string name;
+  std::optional<double> weight;
+  std::vector<std::string> tags;
+
+  bool operator==(const CopyRow& rhs) const {
+    return id == rhs.id && name == rhs.name && weight == rhs.weight &&
+           tags == rhs.tags;
+  }
+};
+
+CopyRow MakeRow(int id) {
+  CopyRow row{id, "name " + std::to_string(id), std::nullopt, {}};
+  if (id % 3 != 0) row.weight = id * 0.5;
+  for (int i = 0; i < id % 4; ++i) row.tags.push_back(std::to_string(i));
+  return row;
+}
+
+void CreateTable(pg::detail::ConnectionPtr& conn) {
+  conn->Execute(
+      "create temporary table copy_test(id integer primary key, name text, "
+      "weight double precision, tags text[])");
+}
+
+bool IsPipelineEnabled() {
+  return PostgreConnection::GetParam().pipeline_mode ==
+         pg::ConnectionSettings::kPipelineEnabled;
+}
+
+UTEST_P(PostgreConnection, CopyRoundtrip) {
+  CheckConnection(conn);
+  if (IsPipelineEnabled()) return;
+  CreateTable(conn);
+
+  pg::Transaction trx(std::move(conn), pg::TransactionOptions{});
+  {
+    /// [CopyIn]
+    auto copy = trx.CopyIn(
+        "copy copy_test(id, name, weight, tags) from stdin (format binary)");
+    // a row of columns
+    copy.Write(0, std::string{"name 0"}, std::optional<double>{},
+               std::vector<std::string>{});
+    // a struct, a tuple or a container of them as rows
+    for (int i = 1; i < kRowsCount; ++i) {
+      copy.Write(pg::kRowTag, MakeRow(i));
+    }
+    const auto rows_copied = copy.Finish();
+    /// [CopyIn]
+    EXPECT_EQ(kRowsCount, static_cast<pg::Bigint>(rows_copied));
+  }
+
+  auto res = trx.Execute("select count(*), sum(id) from copy_test");
+  EXPECT_EQ(kRowsCount, res.Front()[0].As<pg::Bigint>());
+  EXPECT_EQ(kRowsCount * (kRowsCount - 1) / 2,
+            res.Front()[1].As<pg::Bigint>());
+
+  {
+    /// [CopyOut]
+    auto copy = trx.CopyOut(
+        "copy (select id, name, weight, tags from copy_test order by id) "
+        "to stdout (format binary)");
+    CopyRow row;
+    while (copy.Read(pg::kRowTag, row)) {
+      EXPECT_EQ(MakeRow(static_cast<int>(copy.RowsRead()) - 1), row);
+    }
+    /// [CopyOut]
+    EXPECT_EQ(kRowsCount, static_cast<pg::Bigint>(copy.RowsRead()));
+    EXPECT_TRUE(copy.Done());
+    EXPECT_FALSE(copy.Read(pg::kRowTag, row));
+  }
+
+  {
+    auto copy = trx.CopyOut(
+        "copy (select id, name from copy_test where id < 10 order by id) "
+        "to stdout (format binary)");
+    int id = 0;
+    std::string name;
+    UEXPECT_THROW(copy.Read(id), pg::FieldTupleMismatch);
+    EXPECT_TRUE(copy.Read(id, name));
+    EXPECT_EQ("name 1", name);
+    while (copy.Read(id, name)) {
+    }
+    EXPECT_EQ(9u, copy.RowsRead());
+  }
+
+  auto rows = trx.CopyOut(
+                     "copy (select id, name, weight, tags from copy_test "
+                     "where id < 100 order by id) to stdout (format binary)")
+                  .AsContainer<std::vector<CopyRow>>(pg::kRowTag);
+  ASSERT_EQ(100u, rows.size());
+  EXPECT_EQ(MakeRow(99), rows.back());
+
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, CopyInAbort) {
+  CheckConnection(conn);
+  if (IsPipelineEnabled()) return;
+  CreateTable(conn);
+
+  pg::Transaction trx(std::move(conn), pg::TransactionOptions{});
+  {
+    auto copy = trx.CopyIn(
+        "copy copy_test(id, name, weight, tags) from stdin (format binary)");
+    copy.WriteRows(std::vector<CopyRow>{MakeRow(1), MakeRow(2)});
+    EXPECT_EQ(2u, copy.RowsWritten());
+    UEXPECT_THROW(trx.Execute("select 1"), pg::ConnectionBusy);
+  }
+  // the COPY is failed with the transaction
+  UEXPECT_THROW(trx.Execute("select 1"), pg::InvalidTransactionState);
+  trx.Rollback();
+}
+
+UTEST_P(PostgreConnection, CopyOutCancel) {
+  CheckConnection(conn);
+  if (IsPipelineEnabled()) return;
+
+  conn->Begin({}, pg::detail::SteadyClock::now());
+  {
+    pg::CopyOutStream copy{
+        conn.get(),
+        "copy (select generate_series(1, 10000000)) to stdout (format binary)"};
+    int value = 0;
+    for (int i = 1; i <= 10; ++i) {
+      ASSERT_TRUE(copy.Read(value));
+      EXPECT_EQ(i, value);
+    }
+  }
+  // the rest of the rows is cancelled
+  EXPECT_EQ(pg::ConnectionState::kTranError, conn->GetState());
+  UEXPECT_NO_THROW(conn->Rollback());
+  EXPECT_TRUE(conn->IsIdle());
+  UEXPECT_NO_THROW(conn->Execute("select 1"));
+}
+
+UTEST_P(PostgreConnection, CopyInServerError) {
+  CheckConnection(conn);
+  if (IsPipelineEnabled()) return;
+  CreateTable(conn);
+
+  pg::Transaction trx(std::move(conn), pg::TransactionOptions{});
+  auto copy = trx.CopyIn(
+      "copy copy_test(id, name, weight, tags) from stdin (format binary)");
+  copy.Write(pg::kRowTag, MakeRow(1));
+  copy.Write(pg::kRowTag, MakeRow(1));
+  UEXPECT_THROW(copy.Finish(), pg::UniqueViolation);
+  UEXPECT_THROW(copy.Finish(), pg::LogicError);
+  trx.Rollback();
+}
+
+UTEST_P(PostgreConnection, CopyInvalidStatements) {
+  CheckConnection(conn);
+  if (IsPipelineEnabled()) {
+    conn->Begin({}, pg::detail::SteadyClock::now());
+    UEXPECT_THROW(pg::CopyInStream(conn.get(), "copy copy_test from stdin"),
+                  pg::NotImplemented);
+    conn->Rollback();
+    return;
+  }
+  CreateTable(conn);
+
+  conn->Begin({}, pg::detail::SteadyClock::now());
+  UEXPECT_THROW(pg::CopyInStream(conn.get(), "select 1"), pg::LogicError);
+  UEXPECT_THROW(pg::CopyOutStream(conn.get(), "select 1"), pg::LogicError);
+  UEXPECT_THROW(pg::CopyInStream(conn.get(), "copy missing from stdin"),
+                pg::AccessRuleViolation);
+  conn->Rollback();
+  EXPECT_TRUE(conn->IsIdle());
+
+  conn->Begin({}, pg::detail::SteadyClock::now());
+  // there is no way to leave the COPY state without the data
+  UEXPECT_THROW(pg::CopyInStream(conn.get(), "copy copy_test from stdin"),
+                pg::LogicError);
+  EXPECT_FALSE(conn->IsConnected());
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
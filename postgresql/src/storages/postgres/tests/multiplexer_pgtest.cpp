@@ -0,0 +1,146 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+#include <storages/postgres/detail/pool.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/parameter_store.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr std::size_t kMultiplexedConnections = 2;
+constexpr int kTasksCount = 100;
+
+class PostgreMultiplexer : public PostgreSQLBase {
+ protected:
+  static std::shared_ptr<pg::detail::ConnectionPool> MakePool(
+      pg::ConnectionSettings conn_settings = kCachePreparedStatements) {
+    conn_settings.multiplexed_connections = kMultiplexedConnections;
+    return pg::detail::ConnectionPool::Create(
+        GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+        pg::InitMode::kAsync, {0, 10, 10}, conn_settings, {},
+        GetTestCmdCtls(), {}, {});
+  }
+
+  static bool IsMultiplexingSupported() {
+    return pg::detail::Multiplexer::IsSupported();
+  }
+};
+
+std::vector<engine::TaskWithResult<int>> StartSelects(
+    const std::shared_ptr<pg::detail::ConnectionPool>& pool) {
+  std::vector<engine::TaskWithResult<int>> tasks;
+  tasks.reserve(kTasksCount);
+  for (int i = 0; i < kTasksCount; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&pool, i] {
+      return pool->Start().Execute("select $1::integer", i).AsSingleRow<int>();
+    }));
+  }
+  return tasks;
+}
+
+}  // namespace
+
+UTEST_F(PostgreMultiplexer, ConcurrentStatements) {
+  if (!IsMultiplexingSupported()) return;
+  auto pool = MakePool();
+
+  auto tasks = StartSelects(pool);
+  for (int i = 0; i < kTasksCount; ++i) {
+    EXPECT_EQ(i, tasks[i].Get());
+  }
+  EXPECT_LE(pool->GetStatistics().connection.active, kMultiplexedConnections);
+}
+
+UTEST_F(PostgreMultiplexer, Parameters) {
+  if (!IsMultiplexingSupported()) return;
+  auto pool = MakePool();
+
+  auto res = pool->Start().Execute(
+      "select $1::text, $2::text, $3::bigint", std::string{"text"},
+      std::optional<std::string>{}, std::string{});
+  ASSERT_EQ(1u, res.Size());
+  EXPECT_EQ("text", res[0][0].As<std::string>());
+  EXPECT_TRUE(res[0][1].IsNull());
+  EXPECT_EQ(0, res[0][2].As<pg::Bigint>());
+
+  pg::ParameterStore store;
+  store.PushBack(42).PushBack(std::string{"store"});
+  res = pool->Start().Execute("select $1::integer, $2::text", store);
+  EXPECT_EQ(42, res[0][0].As<int>());
+  EXPECT_EQ("store", res[0][1].As<std::string>());
+}
+
+UTEST_F(PostgreMultiplexer, ErrorIsolation) {
+  if (!IsMultiplexingSupported()) return;
+  auto pool = MakePool();
+
+  auto tasks = StartSelects(pool);
+  auto division = engine::AsyncNoSpan(
+      [&pool] { pool->Start().Execute("select 1 / $1::integer", 0); });
+  auto syntax = engine::AsyncNoSpan(
+      [&pool] { pool->Start().Execute("selec $1::integer", 1); });
+  auto same_syntax = engine::AsyncNoSpan(
+      [&pool] { pool->Start().Execute("selec $1::integer", 2); });
+
+  for (int i = 0; i < kTasksCount; ++i) {
+    EXPECT_EQ(i, tasks[i].Get());
+  }
+  UEXPECT_THROW(division.Get(), pg::DataException);
+  UEXPECT_THROW(syntax.Get(), pg::SyntaxError);
+  UEXPECT_THROW(same_syntax.Get(), pg::SyntaxError);
+
+  // the connections survive the errors
+  EXPECT_EQ(1, pool->Start().Execute("select 1").AsSingleRow<int>());
+  EXPECT_EQ(0u, pool->GetStatistics().connection.error_total);
+}
+
+UTEST_F(PostgreMultiplexer, StatementTimeout) {
+  if (!IsMultiplexingSupported()) return;
+  auto pool = MakePool();
+
+  const pg::CommandControl cc{std::chrono::seconds{1},
+                              std::chrono::milliseconds{50}};
+  auto sleep = engine::AsyncNoSpan(
+      [&pool, &cc] { pool->Start().Execute(cc, "select pg_sleep(1)"); });
+  auto tasks = StartSelects(pool);
+
+  UEXPECT_THROW(sleep.Get(), pg::QueryCancelled);
+  for (int i = 0; i < kTasksCount; ++i) {
+    EXPECT_EQ(i, tasks[i].Get());
+  }
+  // the statement timeout is local to the statement
+  UEXPECT_NO_THROW(pool->Start().Execute("select pg_sleep(0.1)"));
+}
+
+UTEST_F(PostgreMultiplexer, ExecuteTimeout) {
+  if (!IsMultiplexingSupported()) return;
+  auto pool = MakePool();
+
+  const pg::CommandControl cc{std::chrono::milliseconds{50},
+                              std::chrono::milliseconds{300}};
+  UEXPECT_THROW(pool->Start().Execute(cc, "select pg_sleep(1)"),
+                pg::ConnectionTimeoutError);
+  UEXPECT_NO_THROW(pool->Start().Execute("select 1"));
+}
+
+UTEST_F(PostgreMultiplexer, NoPreparedStatements) {
+  if (!IsMultiplexingSupported()) return;
+  auto pool = MakePool(kNoPreparedStatements);
+
+  auto tasks = StartSelects(pool);
+  for (int i = 0; i < kTasksCount; ++i) {
+    EXPECT_EQ(i, tasks[i].Get());
+  }
+  UEXPECT_THROW(pool->Start().Execute("selec 1"), pg::SyntaxError);
+}
+
+USERVER_NAMESPACE_END
@@ -275,6 +275,76 @@ UTEST_F(PostgrePoolStats, MaxPreparedCacheSize) {
             conn_settings.max_prepared_cache_size);
 }
 
+UTEST_F(PostgrePoolStats, PreparedCacheCounters) {
+  pg::ConnectionSettings conn_settings;
+  conn_settings.max_prepared_cache_size = 5;
+
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+      storages::postgres::InitMode::kAsync, {1, 10, 10}, conn_settings, {},
+      GetTestCmdCtls(), {}, {});
+
+  {
+    auto conn = pool->Acquire(MakeDeadline());
+    CheckConnection(conn);
+    [[maybe_unused]] const auto old_stats = conn->GetStatsAndReset();
+
+    for (size_t i = 0; i < conn_settings.max_prepared_cache_size + 1; ++i) {
+      UEXPECT_NO_THROW(conn->Execute("select " + std::to_string(i)));
+    }
+    // Differs from the last statement in whitespace only
+    UEXPECT_NO_THROW(conn->Execute(
+        " select\n  " +
+        std::to_string(conn_settings.max_prepared_cache_size) + " "));
+
+    const auto stats = conn->GetStatsAndReset();
+    EXPECT_GE(stats.prepared_cache_miss,
+              conn_settings.max_prepared_cache_size + 1);
+    EXPECT_GE(stats.prepared_cache_hit, 1);
+    EXPECT_GE(stats.prepared_cache_evict, 1);
+    EXPECT_EQ(stats.prepared_cache_miss, stats.parse_total);
+  }
+
+  {
+    auto conn = pool->Acquire(MakeDeadline());
+    UEXPECT_NO_THROW(conn->Execute("select 0"));
+  }
+
+  const auto& stats = pool->GetStatistics();
+  EXPECT_GE(stats.transaction.prepared_cache_miss,
+            conn_settings.max_prepared_cache_size + 2);
+  EXPECT_GE(stats.transaction.prepared_cache_hit, 1);
+  EXPECT_GE(stats.transaction.prepared_cache_evict, 2);
+}
+
+UTEST_F(PostgrePoolStats, PreparedWarmup) {
+  pg::ConnectionSettings conn_settings;
+  conn_settings.prepared_warmup_size = 10;
+
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+      storages::postgres::InitMode::kSync, {1, 10, 10}, conn_settings, {},
+      GetTestCmdCtls(), {}, {});
+
+  const std::string statement = "select $1::integer + 1";
+  {
+    auto conn = pool->Acquire(MakeDeadline());
+    UEXPECT_NO_THROW(conn->Execute(statement, 1));
+  }
+
+  // The second connection is created after the statement was prepared
+  auto first = pool->Acquire(MakeDeadline());
+  auto second = pool->Acquire(MakeDeadline());
+  for (auto* conn : {&first, &second}) {
+    CheckConnection(*conn);
+    [[maybe_unused]] const auto old_stats = (*conn)->GetStatsAndReset();
+    UEXPECT_NO_THROW((*conn)->Execute(statement, 1));
+    const auto stats = (*conn)->GetStatsAndReset();
+    EXPECT_EQ(0, stats.prepared_cache_miss);
+    EXPECT_EQ(0, stats.parse_total);
+  }
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
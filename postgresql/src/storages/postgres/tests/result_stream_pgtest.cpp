@@ -0,0 +1,165 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr int kRowsCount = 10'000;
+constexpr std::size_t kChunkSize = 1'000;
+
+// A single connection, so that a leaked busy connection fails the next query
+pg::Cluster CreateCluster(
+    const pg::Dsn& dsn, engine::TaskProcessor& bg_task_processor,
+    pg::ConnectionSettings conn_settings = kCachePreparedStatements) {
+  return pg::Cluster({dsn}, nullptr, bg_task_processor,
+                     {{},
+                      {utest::kMaxTestWaitTime},
+                      {1, 1, 1},
+                      conn_settings,
+                      storages::postgres::InitMode::kAsync,
+                      ""},
+                     {kTestCmdCtl, {}, {}}, {}, {});
+}
+
+void CheckConnectionIsFree(pg::Cluster& cluster) {
+  auto res = cluster.Execute(pg::ClusterHostType::kMaster, "select 1");
+  EXPECT_EQ(1, res.AsSingleRow<int>());
+}
+
+}  // namespace
+
+class PostgreResultStream : public PostgreSQLBase {};
+
+UTEST_F(PostgreResultStream, AllRows) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor());
+
+  std::size_t chunks = 0;
+  long long sum = 0;
+  /// [ResultStream]
+  auto stream = cluster.Stream(pg::ClusterHostType::kMaster, kChunkSize,
+                               "select generate_series(1, $1)", kRowsCount);
+  while (stream) {
+    auto chunk = stream.Fetch();
+    EXPECT_LE(chunk.Size(), kChunkSize);
+    for (auto value : chunk.AsSetOf<int>()) {
+      sum += value;
+    }
+    ++chunks;
+  }
+  /// [ResultStream]
+
+  EXPECT_TRUE(stream.Done());
+  EXPECT_EQ(kRowsCount, static_cast<int>(stream.FetchedSoFar()));
+  EXPECT_EQ(static_cast<long long>(kRowsCount) * (kRowsCount + 1) / 2, sum);
+  EXPECT_GE(chunks, kRowsCount / kChunkSize);
+  UEXPECT_THROW(stream.Fetch(), pg::RuntimeError);
+
+  CheckConnectionIsFree(cluster);
+}
+
+UTEST_F(PostgreResultStream, EmptyResult) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor());
+
+  auto stream = cluster.Stream(pg::ClusterHostType::kMaster, kChunkSize,
+                               "select 1 where false");
+  std::size_t rows = 0;
+  while (stream) {
+    rows += stream.Fetch().Size();
+  }
+  EXPECT_EQ(0u, rows);
+  EXPECT_EQ(0u, stream.FetchedSoFar());
+
+  CheckConnectionIsFree(cluster);
+}
+
+UTEST_F(PostgreResultStream, RowTypes) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor());
+
+  auto stream = cluster.Stream(
+      pg::ClusterHostType::kMaster, 7,
+      "select i, 'name ' || i, nullif(i % 3, 0) "
+      "from generate_series(1, $1) i",
+      100);
+  int expected = 1;
+  while (stream) {
+    auto chunk = stream.Fetch();
+    for (auto [id, name, rem] :
+         chunk.AsSetOf<std::tuple<int, std::string, std::optional<int>>>(
+             pg::kRowTag)) {
+      EXPECT_EQ(expected, id);
+      EXPECT_EQ("name " + std::to_string(expected), name);
+      if (expected % 3 == 0) {
+        EXPECT_FALSE(rem.has_value());
+      } else {
+        EXPECT_EQ(expected % 3, rem);
+      }
+      ++expected;
+    }
+  }
+  EXPECT_EQ(101, expected);
+}
+
+UTEST_F(PostgreResultStream, EarlyDestruction) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor());
+
+  {
+    auto stream = cluster.Stream(pg::ClusterHostType::kMaster, kChunkSize,
+                                 "select generate_series(1, $1)", 10'000'000);
+    auto chunk = stream.Fetch();
+    EXPECT_FALSE(chunk.IsEmpty());
+    EXPECT_FALSE(stream.Done());
+  }
+
+  CheckConnectionIsFree(cluster);
+}
+
+UTEST_F(PostgreResultStream, ServerError) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor());
+
+  auto stream = cluster.Stream(
+      pg::ClusterHostType::kMaster, 10,
+      "select 1 / (100 - i) from generate_series(1, 200) i");
+  const auto fetch_all = [&stream] {
+    while (stream) stream.Fetch();
+  };
+  UEXPECT_THROW(fetch_all(), pg::DataException);
+  EXPECT_TRUE(stream.Done());
+
+  CheckConnectionIsFree(cluster);
+}
+
+UTEST_F(PostgreResultStream, InvalidChunkSize) {
+  auto cluster = CreateCluster(GetDsnFromEnv(), GetTaskProcessor());
+
+  UEXPECT_THROW(
+      cluster.Stream(pg::ClusterHostType::kMaster, 0, "select 1"),
+      pg::LogicError);
+
+  CheckConnectionIsFree(cluster);
+}
+
+UTEST_F(PostgreResultStream, PipelineMode) {
+  auto cluster =
+      CreateCluster(GetDsnFromEnv(), GetTaskProcessor(), kPipelineEnabled);
+
+  auto stream = cluster.Stream(pg::ClusterHostType::kMaster, kChunkSize,
+                               "select generate_series(1, $1)", kRowsCount);
+  while (stream) {
+    stream.Fetch();
+  }
+  EXPECT_EQ(kRowsCount, static_cast<int>(stream.FetchedSoFar()));
+
+  CheckConnectionIsFree(cluster);
+}
+
+USERVER_NAMESPACE_END
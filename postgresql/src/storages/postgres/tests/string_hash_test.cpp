@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <userver/storages/postgres/detail/string_hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+TEST(PostgreQueryTextHash, Whitespace) {
+  const auto hash = pg::utils::QueryTextHash("select a, b from t where c = $1");
+  EXPECT_EQ(hash, pg::utils::QueryTextHash(
+                      "  select a,\n\tb\n  from t\n where c = $1\n"));
+  EXPECT_EQ(hash,
+            pg::utils::QueryTextHash("select  a,  b from t where c = $1 "));
+  EXPECT_NE(hash, pg::utils::QueryTextHash("select a,b from t where c = $1"));
+  EXPECT_NE(hash, pg::utils::QueryTextHash("select a, b from t where c = $2"));
+}
+
+TEST(PostgreQueryTextHash, Quotes) {
+  EXPECT_NE(pg::utils::QueryTextHash("select 'a  b'"),
+            pg::utils::QueryTextHash("select 'a b'"));
+  EXPECT_NE(pg::utils::QueryTextHash(R"(select "a  b")"),
+            pg::utils::QueryTextHash(R"(select "a b")"));
+  EXPECT_EQ(pg::utils::QueryTextHash("select 'a''  b',  1"),
+            pg::utils::QueryTextHash("select 'a''  b', 1"));
+  EXPECT_NE(pg::utils::QueryTextHash("select 'a''  b'"),
+            pg::utils::QueryTextHash("select 'a'' b'"));
+}
+
+TEST(PostgreQueryTextHash, VerbatimText) {
+  // Line comments end at the line end
+  EXPECT_NE(pg::utils::QueryTextHash("select 1 -- a\n, 2"),
+            pg::utils::QueryTextHash("select 1 -- a , 2"));
+  EXPECT_NE(pg::utils::QueryTextHash("select $$a  b$$"),
+            pg::utils::QueryTextHash("select $$a b$$"));
+  EXPECT_NE(pg::utils::QueryTextHash(R"(select E'\'  ')"),
+            pg::utils::QueryTextHash(R"(select E'\' ')"));
+  // Whitespace before the verbatim text is still collapsed
+  EXPECT_EQ(pg::utils::QueryTextHash("select  1 /* a  b */"),
+            pg::utils::QueryTextHash("select 1 /* a  b */"));
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
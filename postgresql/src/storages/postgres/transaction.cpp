@@ -92,6 +92,28 @@ Portal Transaction::MakePortal(const PortalName& portal_name,
                 std::move(statement_cmd_ctl)};
 }
 
+CopyInStream Transaction::CopyIn(OptionalCommandControl statement_cmd_ctl,
+                                 const Query& copy_statement) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy in called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return CopyInStream{conn_.get(), copy_statement,
+                      std::move(statement_cmd_ctl)};
+}
+
+CopyOutStream Transaction::CopyOut(OptionalCommandControl statement_cmd_ctl,
+                                   const Query& copy_statement) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy out called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return CopyOutStream{conn_.get(), copy_statement,
+                       std::move(statement_cmd_ctl)};
+}
+
 void Transaction::SetParameter(const std::string& param_name,
                                const std::string& value) {
   if (!conn_) {
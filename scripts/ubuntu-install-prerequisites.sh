@@ -59,6 +59,7 @@ USERVER_BUILDDEPS=" \
   libyandex-taxi-grpc++-dev \
   libyandex-taxi-jemalloc-dev \
   libyandex-taxi-mongo-c-driver-dev \
+  libzstd-dev \
   postgresql-server-dev-12 \
   yandex-taxi-protobuf-compiler-grpc \
   zlib1g-dev \
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+// Count-min sketch of saturating access counters, estimates how often a key
+// was accessed recently. Used by the TinyLFU admission policy.
+//
+// Increment() may be called concurrently from any number of threads. Racing
+// increments of the same counter may be lost, that only lowers the estimate
+// a bit. Counters of hot keys saturate and are not written to anymore.
+//
+// The counters are halved once per sample period of `10 * capacity`
+// increments, so that the old popularity is eventually forgotten and a
+// resident set of saturated keys does not block the new hot keys forever.
+class FrequencySketch final {
+ public:
+  static constexpr std::uint8_t kMaxFrequency = 15;
+
+  // `capacity` is the number of keys the frequencies are tracked for
+  explicit FrequencySketch(std::size_t capacity);
+
+  void Increment(std::size_t hash) noexcept;
+
+  std::uint8_t Estimate(std::size_t hash) const noexcept;
+
+  std::size_t GetWidth() const noexcept { return width_; }
+
+ private:
+  static constexpr std::size_t kDepth = 4;
+
+  std::size_t GetIndex(std::size_t hash, std::size_t row) const noexcept;
+
+  void Age() noexcept;
+
+  const std::size_t width_;
+  const unsigned index_shift_;
+  const std::size_t sample_size_;
+  std::atomic<std::size_t> increments_{0};
+  std::unique_ptr<std::atomic<std::uint8_t>[]> counters_;
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl::persistent {
+
+// Reference counted base of the nodes shared between the snapshots of the
+// persistent containers.
+//
+// A node that is referenced once may only be reached through the container
+// that is being modified, so it is modified in place. Otherwise, it is copied
+// and the container is switched to the copy ("path copying").
+template <typename Derived>
+class RefCounted {
+ public:
+  bool IsShared() const noexcept {
+    // acquire pairs with the release in intrusive_ptr_release of other
+    // owners, their reads of the node happen before our writes
+    return refs_.load(std::memory_order_acquire) > 1;
+  }
+
+  friend void intrusive_ptr_add_ref(const Derived* node) noexcept {
+    node->refs_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  friend void intrusive_ptr_release(const Derived* node) noexcept {
+    if (node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete node;
+    }
+  }
+
+ protected:
+  RefCounted() = default;
+  RefCounted(const RefCounted&) noexcept {}
+  RefCounted& operator=(const RefCounted&) = delete;
+  ~RefCounted() = default;
+
+ private:
+  mutable std::atomic<std::uint32_t> refs_{0};
+};
+
+// Makes the node referenced only by `node`, copying it if it is shared
+template <typename Node>
+Node& MakeUnique(boost::intrusive_ptr<Node>& node) {
+  if (node->IsShared()) node = new Node(*node);
+  return *node;
+}
+
+}  // namespace utils::impl::persistent
+
+USERVER_NAMESPACE_END
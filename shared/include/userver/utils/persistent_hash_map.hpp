@@ -0,0 +1,608 @@
+#pragma once
+
+/// @file userver/utils/persistent_hash_map.hpp
+/// @brief @copybrief utils::PersistentHashMap
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/impl/persistent_node.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_containers
+///
+/// @brief A hash map with O(1) copying, the copies share the unchanged parts
+/// of the data.
+///
+/// The map is a hash array mapped trie: each level of the tree is indexed by
+/// the next 5 bits of the key hash. A modification copies only the nodes on
+/// the path from the root to the changed element, which makes it
+/// O(log n) both for the time and for the memory, while the rest of the tree
+/// stays shared with the copies that were made before. Nodes that are not
+/// shared are modified in place, so the second change of the same path costs
+/// no allocations.
+///
+/// This makes the map a good fit for the data of the caches with incremental
+/// updates: the copy of the current snapshot is free, the update costs
+/// O(changes * log n) and the old snapshots that are still in use share
+/// most of the memory with the new one.
+///
+/// Unlike std::unordered_map the elements are immutable when accessed through
+/// the iterators and the inserting functions return only whether a new
+/// element was inserted. Iteration order is unspecified.
+///
+/// Distinct copies of a map may be used from different threads concurrently,
+/// the same map object is not thread-safe.
+///
+/// @snippet src/utils/persistent_hash_map_test.cpp  Sample PersistentHashMap
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class PersistentHashMap final {
+  struct Leaf;
+  struct Node;
+  using LeafPtr = boost::intrusive_ptr<Leaf>;
+  using NodePtr = boost::intrusive_ptr<Node>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  PersistentHashMap() = default;
+  explicit PersistentHashMap(const Hash& hash,
+                             const KeyEqual& equal = KeyEqual());
+  PersistentHashMap(std::initializer_list<value_type> init);
+
+  /// O(1), the copy shares all the data with the original
+  PersistentHashMap(const PersistentHashMap&) = default;
+  PersistentHashMap(PersistentHashMap&&) noexcept;
+  PersistentHashMap& operator=(const PersistentHashMap&) = default;
+  PersistentHashMap& operator=(PersistentHashMap&&) noexcept;
+
+  const_iterator begin() const;
+  const_iterator end() const noexcept;
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator find(const Key& key) const;
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+  bool contains(const Key& key) const { return FindValue(key) != nullptr; }
+
+  /// @throws std::out_of_range if there is no such key
+  const Value& at(const Key& key) const;
+
+  /// @returns whether a new element was inserted
+  template <typename V>
+  bool insert_or_assign(const Key& key, V&& value) {
+    return InsertOrAssign(key, std::forward<V>(value));
+  }
+  template <typename V>
+  bool insert_or_assign(Key&& key, V&& value) {
+    return InsertOrAssign(std::move(key), std::forward<V>(value));
+  }
+
+  /// @returns whether a new element was inserted
+  bool insert(const value_type& value);
+  bool insert(value_type&& value);
+
+  /// @returns whether a new element was inserted
+  template <typename... Args>
+  bool try_emplace(const Key& key, Args&&... args) {
+    return TryEmplace(key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  bool try_emplace(Key&& key, Args&&... args) {
+    return TryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+
+  /// @returns the number of erased elements
+  size_type erase(const Key& key);
+
+  void clear() noexcept;
+
+  void swap(PersistentHashMap& other) noexcept;
+
+  /// Element-wise comparison, O(n log n)
+  bool operator==(const PersistentHashMap& other) const;
+  bool operator!=(const PersistentHashMap& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  static constexpr unsigned kBitsPerLevel = 5;
+  static constexpr unsigned kHashBits = sizeof(std::size_t) * 8;
+  static constexpr std::size_t kMaxDepth =
+      (kHashBits + kBitsPerLevel - 1) / kBitsPerLevel + 1;
+
+  using Bitmap = std::uint32_t;
+
+  struct Leaf final : impl::persistent::RefCounted<Leaf> {
+    template <typename K, typename... Args>
+    Leaf(std::size_t hash, K&& key, Args&&... args)
+        : hash(hash),
+          value(std::piecewise_construct,
+                std::forward_as_tuple(std::forward<K>(key)),
+                std::forward_as_tuple(std::forward<Args>(args)...)) {}
+
+    const std::size_t hash;
+    value_type value;
+  };
+
+  // Elements and subtrees are kept in separate arrays ordered by their
+  // hash bits. At the depth where the hash bits are exhausted the node only
+  // holds an unordered list of colliding elements.
+  struct Node final : impl::persistent::RefCounted<Node> {
+    Bitmap leaf_map{0};
+    Bitmap node_map{0};
+    std::vector<LeafPtr> leaves;
+    std::vector<NodePtr> children;
+  };
+
+  static Bitmap Bit(std::size_t hash, unsigned shift) noexcept {
+    return Bitmap{1} << ((hash >> shift) & ((1U << kBitsPerLevel) - 1));
+  }
+
+  static std::size_t Index(Bitmap map, Bitmap bit) noexcept {
+    return __builtin_popcount(map & (bit - 1));
+  }
+
+  bool IsSameKey(const Leaf& leaf, std::size_t hash, const Key& key) const {
+    return leaf.hash == hash && equal_(leaf.value.first, key);
+  }
+
+  const value_type* FindValue(const Key& key) const;
+
+  template <typename K, typename V>
+  bool InsertOrAssign(K&& key, V&& value);
+
+  template <typename K, typename... Args>
+  bool TryEmplace(K&& key, Args&&... args);
+
+  template <typename MakeLeaf, typename OnExisting>
+  bool Upsert(const Key& key, MakeLeaf&& make_leaf, OnExisting&& on_existing);
+
+  static NodePtr MergeLeaves(LeafPtr first, LeafPtr second, unsigned shift);
+
+  void EraseExisting(NodePtr& node, std::size_t hash, unsigned shift,
+                     const Key& key);
+
+  NodePtr root_;
+  size_type size_{0};
+  Hash hash_{};
+  KeyEqual equal_{};
+};
+
+/// @brief Forward iterator over the elements of utils::PersistentHashMap
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+class PersistentHashMap<Key, Value, Hash, KeyEqual>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = PersistentHashMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  const_iterator() = default;
+
+  reference operator*() const {
+    UASSERT(depth_ > 0);
+    const auto& frame = stack_[depth_ - 1];
+    return frame.node->leaves[frame.position]->value;
+  }
+  pointer operator->() const { return &**this; }
+
+  const_iterator& operator++() {
+    UASSERT(depth_ > 0);
+    ++stack_[depth_ - 1].position;
+    Settle();
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator==(const const_iterator& other) const noexcept {
+    if (depth_ != other.depth_) return false;
+    if (depth_ == 0) return true;
+    const auto& frame = stack_[depth_ - 1];
+    const auto& other_frame = other.stack_[depth_ - 1];
+    return frame.node == other_frame.node &&
+           frame.position == other_frame.position;
+  }
+  bool operator!=(const const_iterator& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  friend class PersistentHashMap;
+
+  // positions of a node are its leaves followed by its children
+  struct Frame {
+    const Node* node{nullptr};
+    std::size_t position{0};
+  };
+
+  void Push(const Node* node, std::size_t position) {
+    UASSERT(depth_ < stack_.size());
+    stack_[depth_++] = {node, position};
+  }
+
+  // moves to the nearest leaf at or after the current position
+  void Settle() {
+    while (depth_ > 0) {
+      auto& frame = stack_[depth_ - 1];
+      const auto leaves = frame.node->leaves.size();
+      if (frame.position < leaves) return;
+
+      const auto child = frame.position - leaves;
+      if (child < frame.node->children.size()) {
+        Push(frame.node->children[child].get(), 0);
+        continue;
+      }
+
+      --depth_;
+      if (depth_ > 0) ++stack_[depth_ - 1].position;
+    }
+  }
+
+  std::array<Frame, kMaxDepth> stack_{};
+  std::size_t depth_{0};
+};
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+PersistentHashMap<Key, Value, Hash, KeyEqual>::PersistentHashMap(
+    const Hash& hash, const KeyEqual& equal)
+    : hash_(hash), equal_(equal) {}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+PersistentHashMap<Key, Value, Hash, KeyEqual>::PersistentHashMap(
+    std::initializer_list<value_type> init) {
+  for (const auto& value : init) insert(value);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+PersistentHashMap<Key, Value, Hash, KeyEqual>::PersistentHashMap(
+    PersistentHashMap&& other) noexcept
+    : root_(std::move(other.root_)),
+      size_(std::exchange(other.size_, 0)),
+      hash_(other.hash_),
+      equal_(other.equal_) {}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+PersistentHashMap<Key, Value, Hash, KeyEqual>&
+PersistentHashMap<Key, Value, Hash, KeyEqual>::operator=(
+    PersistentHashMap&& other) noexcept {
+  if (this != &other) {
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+typename PersistentHashMap<Key, Value, Hash, KeyEqual>::const_iterator
+PersistentHashMap<Key, Value, Hash, KeyEqual>::begin() const {
+  const_iterator it;
+  if (root_) {
+    it.Push(root_.get(), 0);
+    it.Settle();
+  }
+  return it;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+typename PersistentHashMap<Key, Value, Hash, KeyEqual>::const_iterator
+PersistentHashMap<Key, Value, Hash, KeyEqual>::end() const noexcept {
+  return {};
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+typename PersistentHashMap<Key, Value, Hash, KeyEqual>::const_iterator
+PersistentHashMap<Key, Value, Hash, KeyEqual>::find(const Key& key) const {
+  const auto hash = hash_(key);
+  const_iterator it;
+  const Node* node = root_.get();
+
+  for (unsigned shift = 0; node; shift += kBitsPerLevel) {
+    if (shift >= kHashBits) {
+      for (std::size_t i = 0; i < node->leaves.size(); ++i) {
+        if (IsSameKey(*node->leaves[i], hash, key)) {
+          it.Push(node, i);
+          return it;
+        }
+      }
+      return end();
+    }
+
+    const auto bit = Bit(hash, shift);
+    if (node->leaf_map & bit) {
+      const auto index = Index(node->leaf_map, bit);
+      if (!IsSameKey(*node->leaves[index], hash, key)) return end();
+      it.Push(node, index);
+      return it;
+    }
+    if (!(node->node_map & bit)) return end();
+
+    const auto index = Index(node->node_map, bit);
+    it.Push(node, node->leaves.size() + index);
+    node = node->children[index].get();
+  }
+  return end();
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+const Value& PersistentHashMap<Key, Value, Hash, KeyEqual>::at(
+    const Key& key) const {
+  const auto* value = FindValue(key);
+  if (!value) throw std::out_of_range("PersistentHashMap::at");
+  return value->second;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+template <typename K, typename V>
+bool PersistentHashMap<Key, Value, Hash, KeyEqual>::InsertOrAssign(
+    K&& key, V&& value) {
+  return Upsert(
+      key,
+      [&](std::size_t hash) {
+        return LeafPtr{new Leaf(hash, std::forward<K>(key),
+                                std::forward<V>(value))};
+      },
+      [&](LeafPtr& leaf) {
+        if (leaf->IsShared()) {
+          leaf = new Leaf(leaf->hash, leaf->value.first,
+                          std::forward<V>(value));
+        } else {
+          leaf->value.second = std::forward<V>(value);
+        }
+      });
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+bool PersistentHashMap<Key, Value, Hash, KeyEqual>::insert(
+    const value_type& value) {
+  return try_emplace(value.first, value.second);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+bool PersistentHashMap<Key, Value, Hash, KeyEqual>::insert(
+    value_type&& value) {
+  return try_emplace(value.first, std::move(value.second));
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+template <typename K, typename... Args>
+bool PersistentHashMap<Key, Value, Hash, KeyEqual>::TryEmplace(
+    K&& key, Args&&... args) {
+  return Upsert(
+      key,
+      [&](std::size_t hash) {
+        return LeafPtr{new Leaf(hash, std::forward<K>(key),
+                                std::forward<Args>(args)...)};
+      },
+      [](LeafPtr&) {});
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+typename PersistentHashMap<Key, Value, Hash, KeyEqual>::size_type
+PersistentHashMap<Key, Value, Hash, KeyEqual>::erase(const Key& key) {
+  // do not copy the path for a missing key
+  if (!FindValue(key)) return 0;
+
+  EraseExisting(root_, hash_(key), 0, key);
+  if (--size_ == 0) root_.reset();
+  return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void PersistentHashMap<Key, Value, Hash, KeyEqual>::clear() noexcept {
+  root_.reset();
+  size_ = 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void PersistentHashMap<Key, Value, Hash, KeyEqual>::swap(
+    PersistentHashMap& other) noexcept {
+  using std::swap;
+  swap(root_, other.root_);
+  swap(size_, other.size_);
+  swap(hash_, other.hash_);
+  swap(equal_, other.equal_);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+bool PersistentHashMap<Key, Value, Hash, KeyEqual>::operator==(
+    const PersistentHashMap& other) const {
+  if (size_ != other.size_) return false;
+  if (root_ == other.root_) return true;
+
+  for (const auto& [key, value] : *this) {
+    const auto* other_value = other.FindValue(key);
+    if (!other_value || !(other_value->second == value)) return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+const typename PersistentHashMap<Key, Value, Hash, KeyEqual>::value_type*
+PersistentHashMap<Key, Value, Hash, KeyEqual>::FindValue(
+    const Key& key) const {
+  const auto hash = hash_(key);
+  const Node* node = root_.get();
+
+  for (unsigned shift = 0; node; shift += kBitsPerLevel) {
+    if (shift >= kHashBits) {
+      for (const auto& leaf : node->leaves) {
+        if (IsSameKey(*leaf, hash, key)) return &leaf->value;
+      }
+      return nullptr;
+    }
+
+    const auto bit = Bit(hash, shift);
+    if (node->leaf_map & bit) {
+      const auto& leaf = *node->leaves[Index(node->leaf_map, bit)];
+      return IsSameKey(leaf, hash, key) ? &leaf.value : nullptr;
+    }
+    if (!(node->node_map & bit)) return nullptr;
+    node = node->children[Index(node->node_map, bit)].get();
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+template <typename MakeLeaf, typename OnExisting>
+bool PersistentHashMap<Key, Value, Hash, KeyEqual>::Upsert(
+    const Key& key, MakeLeaf&& make_leaf, OnExisting&& on_existing) {
+  const auto hash = hash_(key);
+  if (!root_) root_ = new Node();
+
+  NodePtr* node_ptr = &root_;
+  for (unsigned shift = 0;; shift += kBitsPerLevel) {
+    auto& node = impl::persistent::MakeUnique(*node_ptr);
+
+    if (shift >= kHashBits) {
+      for (auto& leaf : node.leaves) {
+        if (IsSameKey(*leaf, hash, key)) {
+          on_existing(leaf);
+          return false;
+        }
+      }
+      node.leaves.push_back(make_leaf(hash));
+      ++size_;
+      return true;
+    }
+
+    const auto bit = Bit(hash, shift);
+    if (node.leaf_map & bit) {
+      const auto index = Index(node.leaf_map, bit);
+      auto& leaf = node.leaves[index];
+      if (IsSameKey(*leaf, hash, key)) {
+        on_existing(leaf);
+        return false;
+      }
+
+      // both elements go one level deeper
+      auto child = MergeLeaves(std::move(leaf), make_leaf(hash),
+                               shift + kBitsPerLevel);
+      node.leaves.erase(node.leaves.begin() + index);
+      node.leaf_map &= ~bit;
+      node.children.insert(
+          node.children.begin() + Index(node.node_map, bit), std::move(child));
+      node.node_map |= bit;
+      ++size_;
+      return true;
+    }
+
+    if (node.node_map & bit) {
+      node_ptr = &node.children[Index(node.node_map, bit)];
+      continue;
+    }
+
+    node.leaves.insert(node.leaves.begin() + Index(node.leaf_map, bit),
+                       make_leaf(hash));
+    node.leaf_map |= bit;
+    ++size_;
+    return true;
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+typename PersistentHashMap<Key, Value, Hash, KeyEqual>::NodePtr
+PersistentHashMap<Key, Value, Hash, KeyEqual>::MergeLeaves(LeafPtr first,
+                                                           LeafPtr second,
+                                                           unsigned shift) {
+  NodePtr node{new Node()};
+  if (shift >= kHashBits) {
+    node->leaves.push_back(std::move(first));
+    node->leaves.push_back(std::move(second));
+    return node;
+  }
+
+  const auto first_bit = Bit(first->hash, shift);
+  const auto second_bit = Bit(second->hash, shift);
+  if (first_bit == second_bit) {
+    node->node_map = first_bit;
+    node->children.push_back(MergeLeaves(std::move(first), std::move(second),
+                                         shift + kBitsPerLevel));
+    return node;
+  }
+
+  node->leaf_map = first_bit | second_bit;
+  if (first_bit > second_bit) std::swap(first, second);
+  node->leaves.push_back(std::move(first));
+  node->leaves.push_back(std::move(second));
+  return node;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void PersistentHashMap<Key, Value, Hash, KeyEqual>::EraseExisting(
+    NodePtr& node_ptr, std::size_t hash, unsigned shift, const Key& key) {
+  auto& node = impl::persistent::MakeUnique(node_ptr);
+
+  if (shift >= kHashBits) {
+    for (auto it = node.leaves.begin(); it != node.leaves.end(); ++it) {
+      if (IsSameKey(**it, hash, key)) {
+        node.leaves.erase(it);
+        return;
+      }
+    }
+    UINVARIANT(false, "Erased key is missing");
+  }
+
+  const auto bit = Bit(hash, shift);
+  if (node.leaf_map & bit) {
+    node.leaves.erase(node.leaves.begin() + Index(node.leaf_map, bit));
+    node.leaf_map &= ~bit;
+    return;
+  }
+
+  UASSERT(node.node_map & bit);
+  const auto child_index = Index(node.node_map, bit);
+  auto& child = node.children[child_index];
+  EraseExisting(child, hash, shift + kBitsPerLevel, key);
+
+  // A subtree with a single element is replaced with the element, this keeps
+  // the tree as shallow as possible
+  if (child->children.empty() && child->leaves.size() == 1) {
+    auto leaf = std::move(child->leaves.front());
+    node.children.erase(node.children.begin() + child_index);
+    node.node_map &= ~bit;
+    node.leaves.insert(node.leaves.begin() + Index(node.leaf_map, bit),
+                       std::move(leaf));
+    node.leaf_map |= bit;
+  }
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,334 @@
+#pragma once
+
+/// @file userver/utils/persistent_vector.hpp
+/// @brief @copybrief utils::PersistentVector
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/impl/persistent_node.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_containers
+///
+/// @brief A vector with O(1) copying, the copies share the unchanged parts
+/// of the data.
+///
+/// The elements are stored in the leaves of a tree with 32 children per
+/// node. push_back(), pop_back() and set() copy only the nodes on the path to
+/// the changed element, that is O(log n) with a very small base, the rest of
+/// the tree stays shared with the previously made copies. Nodes that are not
+/// shared are modified in place.
+///
+/// Element access is O(log n) as well, the iteration is amortized O(1).
+///
+/// Distinct copies of a vector may be used from different threads
+/// concurrently, the same vector object is not thread-safe.
+///
+/// @snippet src/utils/persistent_vector_test.cpp  Sample PersistentVector
+template <typename T>
+class PersistentVector final {
+  struct Node;
+  using NodePtr = boost::intrusive_ptr<Node>;
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = const T&;
+  using const_reference = const T&;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  PersistentVector() = default;
+  PersistentVector(std::initializer_list<T> init);
+
+  /// O(1), the copy shares all the data with the original
+  PersistentVector(const PersistentVector&) = default;
+  PersistentVector(PersistentVector&&) noexcept;
+  PersistentVector& operator=(const PersistentVector&) = default;
+  PersistentVector& operator=(PersistentVector&&) noexcept;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const T& operator[](size_type index) const {
+    UASSERT(index < size_);
+    return GetLeaf(index)[index & kMask];
+  }
+
+  /// @throws std::out_of_range if `index >= size()`
+  const T& at(size_type index) const;
+
+  const T& front() const { return (*this)[0]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  void emplace_back(Args&&... args);
+
+  void pop_back();
+
+  /// Replaces the element, the vector has no mutable element access
+  template <typename U>
+  void set(size_type index, U&& value);
+
+  void clear() noexcept;
+
+  void swap(PersistentVector& other) noexcept;
+
+  bool operator==(const PersistentVector& other) const;
+  bool operator!=(const PersistentVector& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  static constexpr unsigned kBitsPerLevel = 5;
+  static constexpr size_type kWidth = size_type{1} << kBitsPerLevel;
+  static constexpr size_type kMask = kWidth - 1;
+
+  // Inner nodes only have children and the leaves only have values
+  struct Node final : impl::persistent::RefCounted<Node> {
+    std::vector<T> values;
+    std::vector<NodePtr> children;
+  };
+
+  size_type GetCapacity() const noexcept {
+    return size_type{1} << (shift_ + kBitsPerLevel);
+  }
+
+  const std::vector<T>& GetLeaf(size_type index) const;
+  std::vector<T>& GetUniqueLeaf(size_type index);
+
+  // returns whether the subtree became empty
+  bool PopBack(NodePtr& node, unsigned shift);
+
+  NodePtr root_;
+  size_type size_{0};
+  unsigned shift_{0};
+};
+
+/// @brief Forward iterator over the elements of utils::PersistentVector
+template <typename T>
+class PersistentVector<T>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using reference = const T&;
+  using pointer = const T*;
+
+  const_iterator() = default;
+
+  reference operator*() const {
+    UASSERT(leaf_);
+    return (*leaf_)[index_ & kMask];
+  }
+  pointer operator->() const { return &**this; }
+
+  const_iterator& operator++() {
+    ++index_;
+    if ((index_ & kMask) == 0) {
+      leaf_ = index_ < vector_->size() ? &vector_->GetLeaf(index_) : nullptr;
+    }
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator==(const const_iterator& other) const noexcept {
+    return index_ == other.index_;
+  }
+  bool operator!=(const const_iterator& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  friend class PersistentVector;
+
+  const_iterator(const PersistentVector& vector, size_type index)
+      : vector_(&vector),
+        index_(index),
+        leaf_(index < vector.size() ? &vector.GetLeaf(index) : nullptr) {}
+
+  const PersistentVector* vector_{nullptr};
+  size_type index_{0};
+  const std::vector<T>* leaf_{nullptr};
+};
+
+template <typename T>
+PersistentVector<T>::PersistentVector(std::initializer_list<T> init) {
+  for (const auto& value : init) push_back(value);
+}
+
+template <typename T>
+PersistentVector<T>::PersistentVector(PersistentVector&& other) noexcept
+    : root_(std::move(other.root_)),
+      size_(std::exchange(other.size_, 0)),
+      shift_(std::exchange(other.shift_, 0)) {}
+
+template <typename T>
+PersistentVector<T>& PersistentVector<T>::operator=(
+    PersistentVector&& other) noexcept {
+  if (this != &other) {
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    shift_ = std::exchange(other.shift_, 0);
+  }
+  return *this;
+}
+
+template <typename T>
+typename PersistentVector<T>::const_iterator PersistentVector<T>::begin()
+    const {
+  return {*this, 0};
+}
+
+template <typename T>
+typename PersistentVector<T>::const_iterator PersistentVector<T>::end() const {
+  return {*this, size_};
+}
+
+template <typename T>
+const T& PersistentVector<T>::at(size_type index) const {
+  if (index >= size_) throw std::out_of_range("PersistentVector::at");
+  return (*this)[index];
+}
+
+template <typename T>
+template <typename... Args>
+void PersistentVector<T>::emplace_back(Args&&... args) {
+  if (!root_) {
+    root_ = new Node();
+  } else if (size_ == GetCapacity()) {
+    NodePtr new_root{new Node()};
+    new_root->children.push_back(std::move(root_));
+    root_ = std::move(new_root);
+    shift_ += kBitsPerLevel;
+  }
+
+  NodePtr* node_ptr = &root_;
+  for (auto shift = shift_; shift > 0; shift -= kBitsPerLevel) {
+    auto& node = impl::persistent::MakeUnique(*node_ptr);
+    const auto child = (size_ >> shift) & kMask;
+    if (child == node.children.size()) node.children.emplace_back(new Node());
+    node_ptr = &node.children[child];
+  }
+
+  auto& leaf = impl::persistent::MakeUnique(*node_ptr);
+  if (leaf.values.empty()) leaf.values.reserve(kWidth);
+  leaf.values.emplace_back(std::forward<Args>(args)...);
+  ++size_;
+}
+
+template <typename T>
+void PersistentVector<T>::pop_back() {
+  UASSERT(size_ > 0);
+  PopBack(root_, shift_);
+  --size_;
+
+  if (size_ == 0) {
+    clear();
+    return;
+  }
+  while (shift_ > 0 && root_->children.size() == 1) {
+    auto child = std::move(root_->children.front());
+    root_ = std::move(child);
+    shift_ -= kBitsPerLevel;
+  }
+}
+
+template <typename T>
+template <typename U>
+void PersistentVector<T>::set(size_type index, U&& value) {
+  UASSERT(index < size_);
+  GetUniqueLeaf(index)[index & kMask] = std::forward<U>(value);
+}
+
+template <typename T>
+void PersistentVector<T>::clear() noexcept {
+  root_.reset();
+  size_ = 0;
+  shift_ = 0;
+}
+
+template <typename T>
+void PersistentVector<T>::swap(PersistentVector& other) noexcept {
+  using std::swap;
+  swap(root_, other.root_);
+  swap(size_, other.size_);
+  swap(shift_, other.shift_);
+}
+
+template <typename T>
+bool PersistentVector<T>::operator==(const PersistentVector& other) const {
+  if (size_ != other.size_) return false;
+  if (root_ == other.root_) return true;
+
+  auto other_it = other.begin();
+  for (const auto& value : *this) {
+    if (!(value == *other_it)) return false;
+    ++other_it;
+  }
+  return true;
+}
+
+template <typename T>
+const std::vector<T>& PersistentVector<T>::GetLeaf(size_type index) const {
+  const Node* node = root_.get();
+  for (auto shift = shift_; shift > 0; shift -= kBitsPerLevel) {
+    node = node->children[(index >> shift) & kMask].get();
+  }
+  return node->values;
+}
+
+template <typename T>
+std::vector<T>& PersistentVector<T>::GetUniqueLeaf(size_type index) {
+  NodePtr* node_ptr = &root_;
+  for (auto shift = shift_; shift > 0; shift -= kBitsPerLevel) {
+    auto& node = impl::persistent::MakeUnique(*node_ptr);
+    node_ptr = &node.children[(index >> shift) & kMask];
+  }
+  return impl::persistent::MakeUnique(*node_ptr).values;
+}
+
+template <typename T>
+bool PersistentVector<T>::PopBack(NodePtr& node_ptr, unsigned shift) {
+  auto& node = impl::persistent::MakeUnique(node_ptr);
+  if (shift == 0) {
+    node.values.pop_back();
+    return node.values.empty();
+  }
+
+  UASSERT(!node.children.empty());
+  if (PopBack(node.children.back(), shift - kBitsPerLevel)) {
+    node.children.pop_back();
+  }
+  return node.children.empty();
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
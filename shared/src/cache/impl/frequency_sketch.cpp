@@ -0,0 +1,100 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+namespace {
+
+constexpr std::size_t kMinWidth = 16;
+
+// Counters per tracked key in a row, fewer counters make the estimates of the
+// rare keys noisy because of the collisions
+constexpr std::size_t kCountersPerKey = 4;
+
+// Recalculate the counters after `kSampleFactor * capacity` increments
+constexpr std::size_t kSampleFactor = 10;
+
+// Odd multipliers of the independent hash functions of the rows
+constexpr std::uint64_t kRowSeeds[] = {
+    0x9E3779B97F4A7C15ULL,
+    0xC2B2AE3D27D4EB4FULL,
+    0x165667B19E3779F9ULL,
+    0xD6E8FEB86659FD93ULL,
+};
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+  std::size_t result = kMinWidth;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+unsigned Log2(std::size_t power_of_two) {
+  unsigned result = 0;
+  while (power_of_two >>= 1) ++result;
+  return result;
+}
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(std::size_t capacity)
+    : width_(RoundUpToPowerOfTwo(capacity * kCountersPerKey)),
+      index_shift_(64 - Log2(width_)),
+      sample_size_(kSampleFactor * width_ / kCountersPerKey),
+      counters_(new std::atomic<std::uint8_t>[kDepth * width_]) {
+  static_assert(std::size(kRowSeeds) == kDepth);
+  for (std::size_t i = 0; i < kDepth * width_; ++i) {
+    counters_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void FrequencySketch::Increment(std::size_t hash) noexcept {
+  for (std::size_t row = 0; row < kDepth; ++row) {
+    auto& counter = counters_[GetIndex(hash, row)];
+    const auto value = counter.load(std::memory_order_relaxed);
+    if (value < kMaxFrequency) {
+      counter.store(value + 1, std::memory_order_relaxed);
+    }
+  }
+
+  // Reads of the saturated keys are counted too, otherwise the counters of a
+  // read-heavy resident set would never be halved
+  auto increments = increments_.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (increments < sample_size_) return;
+  // a single thread wins the reset, the others go on with their increments
+  if (increments_.compare_exchange_strong(increments, 0,
+                                          std::memory_order_relaxed)) {
+    Age();
+  }
+}
+
+std::uint8_t FrequencySketch::Estimate(std::size_t hash) const noexcept {
+  std::uint8_t result = kMaxFrequency;
+  for (std::size_t row = 0; row < kDepth; ++row) {
+    result = std::min(
+        result,
+        counters_[GetIndex(hash, row)].load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+std::size_t FrequencySketch::GetIndex(std::size_t hash,
+                                      std::size_t row) const noexcept {
+  const auto mixed = (static_cast<std::uint64_t>(hash) + row) * kRowSeeds[row];
+  return row * width_ + static_cast<std::size_t>(mixed >> index_shift_);
+}
+
+void FrequencySketch::Age() noexcept {
+  for (std::size_t i = 0; i < kDepth * width_; ++i) {
+    auto& counter = counters_[i];
+    counter.store(counter.load(std::memory_order_relaxed) / 2,
+                  std::memory_order_relaxed);
+  }
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,68 @@
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+#include <functional>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::size_t Hash(int key) { return std::hash<int>{}(key); }
+
+}  // namespace
+
+TEST(FrequencySketch, Estimate) {
+  cache::impl::FrequencySketch sketch(100);
+  EXPECT_EQ(sketch.GetWidth(), 512);
+  EXPECT_EQ(sketch.Estimate(Hash(1)), 0);
+
+  for (int i = 0; i < 5; ++i) sketch.Increment(Hash(1));
+  sketch.Increment(Hash(2));
+
+  EXPECT_EQ(sketch.Estimate(Hash(1)), 5);
+  EXPECT_EQ(sketch.Estimate(Hash(2)), 1);
+}
+
+TEST(FrequencySketch, Saturates) {
+  cache::impl::FrequencySketch sketch(16);
+  for (int i = 0; i < 100; ++i) sketch.Increment(Hash(42));
+  EXPECT_EQ(sketch.Estimate(Hash(42)),
+            cache::impl::FrequencySketch::kMaxFrequency);
+}
+
+TEST(FrequencySketch, HotKeysStandOut) {
+  constexpr int kHotKeys = 10;
+  cache::impl::FrequencySketch sketch(1000);
+
+  for (int round = 0; round < 10; ++round) {
+    for (int key = 0; key < kHotKeys; ++key) sketch.Increment(Hash(key));
+  }
+  // a scan over one-time keys
+  for (int key = kHotKeys; key < 1000; ++key) sketch.Increment(Hash(key));
+
+  for (int key = 0; key < kHotKeys; ++key) {
+    EXPECT_GE(sketch.Estimate(Hash(key)), 10);
+  }
+
+  int overestimated = 0;
+  for (int key = kHotKeys; key < 1000; ++key) {
+    if (sketch.Estimate(Hash(key)) > 2) ++overestimated;
+  }
+  EXPECT_LT(overestimated, 10);
+}
+
+TEST(FrequencySketch, Aging) {
+  cache::impl::FrequencySketch sketch(16);
+  for (int i = 0; i < 8; ++i) sketch.Increment(Hash(1));
+  EXPECT_EQ(sketch.Estimate(Hash(1)), 8);
+
+  // the sample period is 10 * capacity increments, including the ones of
+  // the saturated counters
+  for (int i = 8; i < 10 * 16; ++i) sketch.Increment(Hash(2));
+  EXPECT_EQ(sketch.Estimate(Hash(1)), 4);
+  EXPECT_EQ(sketch.Estimate(Hash(2)),
+            cache::impl::FrequencySketch::kMaxFrequency / 2);
+}
+
+USERVER_NAMESPACE_END
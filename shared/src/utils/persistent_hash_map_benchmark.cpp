@@ -0,0 +1,74 @@
+#include <userver/utils/persistent_hash_map.hpp>
+
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// An incremental cache update: the new snapshot is a copy of the previous one
+// with a few changed elements
+constexpr int kChangedElements = 100;
+
+template <typename Map>
+Map MakeMap(int size) {
+  Map map;
+  for (int i = 0; i < size; ++i) map.insert_or_assign(i, i);
+  return map;
+}
+
+template <typename Map>
+void IncrementalUpdate(benchmark::State& state) {
+  const auto size = static_cast<int>(state.range(0));
+  auto snapshot = MakeMap<Map>(size);
+
+  int version = 0;
+  for (auto _ : state) {
+    auto next_snapshot = snapshot;
+    ++version;
+    for (int i = 0; i < kChangedElements; ++i) {
+      next_snapshot.insert_or_assign((version * kChangedElements + i) % size,
+                                     version);
+    }
+    snapshot = std::move(next_snapshot);
+    benchmark::DoNotOptimize(snapshot);
+  }
+}
+
+template <typename Map>
+void Find(benchmark::State& state) {
+  const auto size = static_cast<int>(state.range(0));
+  const auto map = MakeMap<Map>(size);
+
+  int key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(key));
+    if (++key == size) key = 0;
+  }
+}
+
+}  // namespace
+
+void std_unordered_map_incremental_update(benchmark::State& state) {
+  IncrementalUpdate<std::unordered_map<int, int>>(state);
+}
+BENCHMARK(std_unordered_map_incremental_update)->Range(1 << 10, 1 << 20);
+
+void persistent_hash_map_incremental_update(benchmark::State& state) {
+  IncrementalUpdate<utils::PersistentHashMap<int, int>>(state);
+}
+BENCHMARK(persistent_hash_map_incremental_update)->Range(1 << 10, 1 << 20);
+
+void std_unordered_map_find(benchmark::State& state) {
+  Find<std::unordered_map<int, int>>(state);
+}
+BENCHMARK(std_unordered_map_find)->Range(1 << 10, 1 << 20);
+
+void persistent_hash_map_find(benchmark::State& state) {
+  Find<utils::PersistentHashMap<int, int>>(state);
+}
+BENCHMARK(persistent_hash_map_find)->Range(1 << 10, 1 << 20);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,197 @@
+#include <userver/utils/persistent_hash_map.hpp>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// All the keys share the hash bits, the map degrades into collision lists
+struct BadHash final {
+  std::size_t operator()(int key) const noexcept { return key % 4; }
+};
+
+// Every key differs only in the highest bits of the hash
+struct HighBitsHash final {
+  std::size_t operator()(int key) const noexcept {
+    return static_cast<std::size_t>(key) << (sizeof(std::size_t) * 8 - 8);
+  }
+};
+
+template <typename Map>
+std::unordered_map<int, int> ToStd(const Map& map) {
+  std::unordered_map<int, int> result;
+  for (const auto& [key, value] : map) {
+    EXPECT_TRUE(result.emplace(key, value).second) << "duplicate key " << key;
+  }
+  return result;
+}
+
+template <typename Map>
+void CheckRandomModifications() {
+  Map map;
+  std::unordered_map<int, int> expected;
+  std::vector<Map> snapshots;
+  std::vector<std::unordered_map<int, int>> expected_snapshots;
+
+  unsigned state = 42;
+  const auto next = [&state] {
+    state = state * 1103515245 + 12345;
+    return static_cast<int>((state >> 8) % 3000);
+  };
+
+  for (int i = 0; i < 20000; ++i) {
+    const auto key = next();
+    if (next() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      const bool inserted = expected.insert_or_assign(key, i).second;
+      EXPECT_EQ(map.insert_or_assign(key, i), inserted);
+    }
+    ASSERT_EQ(map.size(), expected.size());
+
+    if (i % 2000 == 0) {
+      snapshots.push_back(map);
+      expected_snapshots.push_back(expected);
+    }
+  }
+
+  EXPECT_EQ(ToStd(map), expected);
+  for (const auto& [key, value] : expected) {
+    ASSERT_TRUE(map.contains(key));
+    EXPECT_EQ(map.at(key), value);
+    const auto it = map.find(key);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+  }
+
+  // the old snapshots are not affected by the later modifications
+  for (std::size_t i = 0; i < snapshots.size(); ++i) {
+    EXPECT_EQ(snapshots[i].size(), expected_snapshots[i].size());
+    EXPECT_EQ(ToStd(snapshots[i]), expected_snapshots[i]);
+  }
+
+  for (const auto& [key, value] : expected) map.erase(key);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+}  // namespace
+
+TEST(PersistentHashMap, Sample) {
+  /// [Sample PersistentHashMap]
+  utils::PersistentHashMap<std::string, int> data{{"one", 1}, {"two", 2}};
+
+  // the copy is O(1), no elements are copied
+  auto next_data = data;
+  next_data.insert_or_assign("three", 3);
+  next_data.erase("one");
+
+  EXPECT_EQ(data.size(), 2);
+  EXPECT_EQ(data.at("one"), 1);
+  EXPECT_FALSE(data.contains("three"));
+
+  EXPECT_EQ(next_data.size(), 2);
+  EXPECT_EQ(next_data.at("three"), 3);
+  EXPECT_FALSE(next_data.contains("one"));
+  /// [Sample PersistentHashMap]
+}
+
+TEST(PersistentHashMap, Empty) {
+  const utils::PersistentHashMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_THROW(map.at(1), std::out_of_range);
+}
+
+TEST(PersistentHashMap, InsertDoesNotOverwrite) {
+  utils::PersistentHashMap<int, std::string> map;
+  EXPECT_TRUE(map.insert({1, "a"}));
+  EXPECT_FALSE(map.insert({1, "b"}));
+  EXPECT_FALSE(map.try_emplace(1, 3, 'c'));
+  EXPECT_EQ(map.at(1), "a");
+
+  EXPECT_TRUE(map.try_emplace(2, 3, 'c'));
+  EXPECT_EQ(map.at(2), "ccc");
+  EXPECT_FALSE(map.insert_or_assign(1, "d"));
+  EXPECT_EQ(map.at(1), "d");
+  EXPECT_EQ(map.count(1), 1);
+  EXPECT_EQ(map.count(3), 0);
+}
+
+TEST(PersistentHashMap, RandomModifications) {
+  CheckRandomModifications<utils::PersistentHashMap<int, int>>();
+}
+
+TEST(PersistentHashMap, HashCollisions) {
+  CheckRandomModifications<utils::PersistentHashMap<int, int, BadHash>>();
+}
+
+TEST(PersistentHashMap, DeepTree) {
+  CheckRandomModifications<utils::PersistentHashMap<int, int, HighBitsHash>>();
+}
+
+TEST(PersistentHashMap, Equality) {
+  utils::PersistentHashMap<int, int> first{{1, 1}, {2, 2}, {3, 3}};
+  auto second = first;
+  EXPECT_EQ(first, second);
+
+  second.insert_or_assign(2, 20);
+  EXPECT_NE(first, second);
+
+  second.insert_or_assign(2, 2);
+  EXPECT_EQ(first, second);
+
+  second.erase(3);
+  EXPECT_NE(first, second);
+
+  utils::PersistentHashMap<int, int> third{{3, 3}, {2, 2}, {1, 1}};
+  EXPECT_EQ(first, third);
+}
+
+TEST(PersistentHashMap, MoveAndSwap) {
+  utils::PersistentHashMap<int, int> first{{1, 1}};
+  auto second = std::move(first);
+  EXPECT_EQ(second.size(), 1);
+  EXPECT_TRUE(first.empty());  // NOLINT(bugprone-use-after-move)
+
+  first.swap(second);
+  EXPECT_EQ(first.at(1), 1);
+  EXPECT_TRUE(second.empty());
+
+  first.clear();
+  EXPECT_TRUE(first.empty());
+  EXPECT_EQ(first.begin(), first.end());
+}
+
+TEST(PersistentHashMap, ConcurrentReadersOfSnapshots) {
+  utils::PersistentHashMap<int, int> map;
+  for (int i = 0; i < 10000; ++i) map.insert_or_assign(i, i);
+
+  std::vector<std::thread> readers;
+  for (int thread = 0; thread < 4; ++thread) {
+    readers.emplace_back([snapshot = map] {
+      long long sum = 0;
+      for (int round = 0; round < 10; ++round) {
+        for (const auto& [key, value] : snapshot) sum += value - key;
+      }
+      EXPECT_EQ(sum, 0);
+    });
+  }
+
+  for (int i = 0; i < 10000; ++i) map.insert_or_assign(i, i + 1);
+  for (auto& reader : readers) reader.join();
+  EXPECT_EQ(map.at(42), 43);
+}
+
+USERVER_NAMESPACE_END
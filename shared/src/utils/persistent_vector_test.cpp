@@ -0,0 +1,115 @@
+#include <userver/utils/persistent_vector.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename T>
+std::vector<T> ToStd(const utils::PersistentVector<T>& vector) {
+  return {vector.begin(), vector.end()};
+}
+
+}  // namespace
+
+TEST(PersistentVector, Sample) {
+  /// [Sample PersistentVector]
+  utils::PersistentVector<std::string> data{"a", "b"};
+
+  // the copy is O(1), no elements are copied
+  auto next_data = data;
+  next_data.push_back("c");
+  next_data.set(0, "A");
+
+  EXPECT_EQ(data.size(), 2);
+  EXPECT_EQ(data[0], "a");
+
+  EXPECT_EQ(next_data.size(), 3);
+  EXPECT_EQ(next_data[0], "A");
+  EXPECT_EQ(next_data.back(), "c");
+  /// [Sample PersistentVector]
+}
+
+TEST(PersistentVector, Empty) {
+  const utils::PersistentVector<int> vector;
+  EXPECT_TRUE(vector.empty());
+  EXPECT_EQ(vector.begin(), vector.end());
+  EXPECT_THROW(vector.at(0), std::out_of_range);
+}
+
+TEST(PersistentVector, GrowAndShrink) {
+  // crosses the capacity of 1, 2 and 3 levels of the tree
+  constexpr std::size_t kSize = 32 * 32 * 32 + 100;
+
+  utils::PersistentVector<std::size_t> vector;
+  std::vector<utils::PersistentVector<std::size_t>> snapshots;
+  for (std::size_t i = 0; i < kSize; ++i) {
+    vector.push_back(i);
+    if (i % 1000 == 0) snapshots.push_back(vector);
+  }
+  ASSERT_EQ(vector.size(), kSize);
+
+  std::size_t expected = 0;
+  for (const auto value : vector) EXPECT_EQ(value, expected++);
+  EXPECT_EQ(expected, kSize);
+  EXPECT_EQ(vector.front(), 0);
+  EXPECT_EQ(vector.back(), kSize - 1);
+  EXPECT_EQ(vector.at(12345), 12345);
+
+  for (std::size_t i = 0; i < kSize; i += 7) vector.set(i, 0);
+  while (!vector.empty()) {
+    const auto index = vector.size() - 1;
+    EXPECT_EQ(vector.back(), index % 7 == 0 ? 0 : index);
+    vector.pop_back();
+  }
+  EXPECT_EQ(vector.begin(), vector.end());
+
+  for (std::size_t i = 0; i < snapshots.size(); ++i) {
+    const auto& snapshot = snapshots[i];
+    ASSERT_EQ(snapshot.size(), i * 1000 + 1);
+    EXPECT_EQ(snapshot.back(), i * 1000);
+    EXPECT_EQ(snapshot[i * 999], i * 999);
+  }
+}
+
+TEST(PersistentVector, SetDoesNotAffectCopies) {
+  utils::PersistentVector<int> first;
+  for (int i = 0; i < 100; ++i) first.push_back(i);
+
+  auto second = first;
+  second.set(50, -1);
+  second.pop_back();
+  second.push_back(-2);
+
+  EXPECT_EQ(first[50], 50);
+  EXPECT_EQ(first.back(), 99);
+  EXPECT_EQ(second[50], -1);
+  EXPECT_EQ(second.back(), -2);
+  EXPECT_NE(first, second);
+
+  second.set(50, 50);
+  second.set(99, 99);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(ToStd(first), ToStd(second));
+}
+
+TEST(PersistentVector, MoveAndSwap) {
+  utils::PersistentVector<int> first{1, 2, 3};
+  auto second = std::move(first);
+  EXPECT_EQ(ToStd(second), (std::vector<int>{1, 2, 3}));
+  EXPECT_TRUE(first.empty());  // NOLINT(bugprone-use-after-move)
+
+  first.swap(second);
+  EXPECT_EQ(first.size(), 3);
+  EXPECT_TRUE(second.empty());
+
+  first.clear();
+  EXPECT_TRUE(first.empty());
+}
+
+USERVER_NAMESPACE_END